@@ -0,0 +1,45 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef GL_OES_standard_derivatives
+#extension GL_OES_standard_derivatives : enable
+#endif
+
+precision mediump   float;
+uniform   sampler2D m_samp0;
+varying   vec4      m_cord0;
+varying   lowp vec4 m_colour;
+
+// SM_FONTS_DISTANCE_FIELD shader
+// the texture holds the distance to the outline of the glyph, 0.5 being on the outline
+void main ()
+{
+  float distance = texture2D(m_samp0, m_cord0.xy).a;
+#ifdef GL_OES_standard_derivatives
+  // anti-alias over about one pixel on screen whatever size the glyph is drawn at
+  float smoothing = clamp(0.7 * fwidth(distance), 0.01, 0.25);
+#else
+  float smoothing = 0.06;
+#endif
+  gl_FragColor.r   = m_colour.r;
+  gl_FragColor.g   = m_colour.g;
+  gl_FragColor.b   = m_colour.b;
+  gl_FragColor.a   = m_colour.a * smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+}
@@ -968,6 +968,15 @@ std::string CApplicationPlayer::GetRenderVSyncState()
     return "";
 }
 
+bool CApplicationPlayer::GetFrameStats(CVariant &stats, bool reset)
+{
+  std::shared_ptr<IPlayer> player = GetInternal();
+  if (player)
+    return player->GetFrameStats(stats, reset);
+  else
+    return false;
+}
+
 bool CApplicationPlayer::IsExternalPlaying()
 {
   std::shared_ptr<IPlayer> player = GetInternal();
@@ -101,6 +101,7 @@ public:
   void RenderCaptureRelease(unsigned int captureId);
   bool RenderCaptureGetPixels(unsigned int captureId, unsigned int millis, uint8_t *buffer, unsigned int size);
   std::string GetRenderVSyncState();
+  bool GetFrameStats(CVariant &stats, bool reset = false);
   bool IsExternalPlaying();
 
   // proxy calls
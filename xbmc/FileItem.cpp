@@ -85,8 +85,8 @@ CFileItem::CFileItem(const CURL &url, const CAlbum& album)
 {
   Initialize();
 
-  m_strPath = url.Get();
-  URIUtils::AddSlashAtEnd(m_strPath);
+  SetPath(url.Get());
+  AddSlashAtEndOfPath();
   SetFromAlbum(album);
 }
 
@@ -94,8 +94,8 @@ CFileItem::CFileItem(const std::string &path, const CAlbum& album)
 {
   Initialize();
 
-  m_strPath = path;
-  URIUtils::AddSlashAtEnd(m_strPath);
+  SetPath(path);
+  AddSlashAtEndOfPath();
   SetFromAlbum(album);
 }
 
@@ -103,8 +103,8 @@ CFileItem::CFileItem(const CMusicInfoTag& music)
 {
   Initialize();
   SetLabel(music.GetTitle());
-  m_strPath = music.GetURL();
-  m_bIsFolder = URIUtils::HasSlashAtEnd(m_strPath);
+  SetPath(music.GetURL());
+  m_bIsFolder = URIUtils::HasSlashAtEnd(m_path.Get());
   *GetMusicInfoTag() = music;
   FillInDefaultIcon();
   FillInMimeType(false);
@@ -124,7 +124,7 @@ CFileItem::CFileItem(const CEpgInfoTagPtr& tag)
 
   m_bIsFolder = false;
   m_epgInfoTag = tag;
-  m_strPath = tag->Path();
+  SetPath(tag->Path());
   SetLabel(tag->Title());
   m_strLabel2 = tag->Plot();
   m_dateTime = tag->StartAsLocalTime();
@@ -145,7 +145,7 @@ CFileItem::CFileItem(const CPVRChannelPtr& channel)
 
   CEpgInfoTagPtr epgNow(channel->GetEPGNow());
 
-  m_strPath = channel->Path();
+  SetPath(channel->Path());
   m_bIsFolder = false;
   m_pvrChannelInfoTag = channel;
   SetLabel(channel->ChannelName());
@@ -189,7 +189,7 @@ CFileItem::CFileItem(const CPVRRecordingPtr& record)
 
   m_bIsFolder = false;
   m_pvrRecordingInfoTag = record;
-  m_strPath = record->m_strFileNameAndPath;
+  SetPath(record->m_strFileNameAndPath);
   SetLabel(record->m_strTitle);
   m_strLabel2 = record->m_strPlot;
   FillInMimeType(false);
@@ -203,7 +203,7 @@ CFileItem::CFileItem(const CPVRTimerInfoTagPtr& timer)
 
   m_bIsFolder = timer->IsRepeating();
   m_pvrTimerInfoTag = timer;
-  m_strPath = timer->Path();
+  SetPath(timer->Path());
   SetLabel(timer->Title());
   m_strLabel2 = timer->Summary();
   m_dateTime = timer->StartAsLocalTime();
@@ -218,9 +218,9 @@ CFileItem::CFileItem(const CArtist& artist)
 {
   Initialize();
   SetLabel(artist.strArtist);
-  m_strPath = artist.strArtist;
+  SetPath(artist.strArtist);
   m_bIsFolder = true;
-  URIUtils::AddSlashAtEnd(m_strPath);
+  AddSlashAtEndOfPath();
   GetMusicInfoTag()->SetArtist(artist);
   FillInMimeType(false);
 }
@@ -229,9 +229,9 @@ CFileItem::CFileItem(const CGenre& genre)
 {
   Initialize();
   SetLabel(genre.strGenre);
-  m_strPath = genre.strGenre;
+  SetPath(genre.strGenre);
   m_bIsFolder = true;
-  URIUtils::AddSlashAtEnd(m_strPath);
+  AddSlashAtEndOfPath();
   GetMusicInfoTag()->SetGenre(genre.strGenre);
   FillInMimeType(false);
 }
@@ -274,20 +274,20 @@ CFileItem::CFileItem(const char* strLabel)
 CFileItem::CFileItem(const CURL& path, bool bIsFolder)
 {
   Initialize();
-  m_strPath = path.Get();
+  SetPath(path.Get());
   m_bIsFolder = bIsFolder;
-  if (m_bIsFolder && !m_strPath.empty() && !IsFileFolder())
-    URIUtils::AddSlashAtEnd(m_strPath);
+  if (m_bIsFolder && !m_path.Get().empty() && !IsFileFolder())
+    AddSlashAtEndOfPath();
   FillInMimeType(false);
 }
 
 CFileItem::CFileItem(const std::string& strPath, bool bIsFolder)
 {
   Initialize();
-  m_strPath = strPath;
+  SetPath(strPath);
   m_bIsFolder = bIsFolder;
-  if (m_bIsFolder && !m_strPath.empty() && !IsFileFolder())
-    URIUtils::AddSlashAtEnd(m_strPath);
+  if (m_bIsFolder && !m_path.Get().empty() && !IsFileFolder())
+    AddSlashAtEndOfPath();
   FillInMimeType(false);
 }
 
@@ -296,9 +296,9 @@ CFileItem::CFileItem(const CMediaSource& share)
   Initialize();
   m_bIsFolder = true;
   m_bIsShareOrDrive = true;
-  m_strPath = share.strPath;
+  SetPath(share.strPath);
   if (!IsRSS()) // no slash at end for rss feeds
-    URIUtils::AddSlashAtEnd(m_strPath);
+    AddSlashAtEndOfPath();
   std::string label = share.strName;
   if (!share.strStatus.empty())
     label = StringUtils::Format("%s (%s)", share.strName.c_str(), share.strStatus.c_str());
@@ -334,7 +334,7 @@ const CFileItem& CFileItem::operator=(const CFileItem& item)
   CGUIListItem::operator=(item);
   m_bLabelPreformated=item.m_bLabelPreformated;
   FreeMemory();
-  m_strPath = item.GetPath();
+  m_path = item.m_path;
   m_bIsParentFolder = item.m_bIsParentFolder;
   m_iDriveType = item.m_iDriveType;
   m_bIsShareOrDrive = item.m_bIsShareOrDrive;
@@ -442,7 +442,7 @@ void CFileItem::Reset()
 
   m_strDVDLabel.clear();
   m_strTitle.clear();
-  m_strPath.clear();
+  m_path = CParsedURL();
   m_dateTime.Reset();
   m_strLockCode.clear();
   m_mimetype.clear();
@@ -472,7 +472,7 @@ void CFileItem::Archive(CArchive& ar)
   {
     ar << m_bIsParentFolder;
     ar << m_bLabelPreformated;
-    ar << m_strPath;
+    ar << m_path.Get();
     ar << m_bIsShareOrDrive;
     ar << m_iDriveType;
     ar << m_dateTime;
@@ -527,7 +527,9 @@ void CFileItem::Archive(CArchive& ar)
   {
     ar >> m_bIsParentFolder;
     ar >> m_bLabelPreformated;
-    ar >> m_strPath;
+    std::string path;
+    ar >> path;
+    SetPath(path);
     ar >> m_bIsShareOrDrive;
     ar >> m_iDriveType;
     ar >> m_dateTime;
@@ -574,7 +576,7 @@ void CFileItem::Serialize(CVariant& value) const
 {
   //CGUIListItem::Serialize(value["CGUIListItem"]);
 
-  value["strPath"] = m_strPath;
+  value["strPath"] = m_path.Get();
   value["dateTime"] = (m_dateTime.IsValid()) ? m_dateTime.GetAsRFC1123DateTime() : "";
   value["lastmodified"] = m_dateTime.IsValid() ? m_dateTime.GetAsDBDateTime() : "";
   value["size"] = m_dwSize;
@@ -601,7 +603,7 @@ void CFileItem::ToSortable(SortItem &sortable, Field field) const
   switch (field)
   {
     case FieldPath:
-      sortable[FieldPath] = m_strPath;
+      sortable[FieldPath] = m_path.Get();
       break;
     case FieldDate:
       sortable[FieldDate] = (m_dateTime.IsValid()) ? m_dateTime.GetAsDBDateTime() : "";
@@ -663,7 +665,7 @@ void CFileItem::ToSortable(SortItem &sortable, const Fields &fields) const
 
 bool CFileItem::Exists(bool bUseCache /* = true */) const
 {
-  if (m_strPath.empty()
+  if (m_path.Get().empty()
    || IsPath("add")
    || IsInternetStream()
    || IsParentFolder()
@@ -677,7 +679,7 @@ bool CFileItem::Exists(bool bUseCache /* = true */) const
     return dbItem.Exists();
   }
 
-  std::string strPath = m_strPath;
+  std::string strPath = m_path.Get();
 
   if (URIUtils::IsMultiPath(strPath))
     strPath = CMultiPathDirectory::GetFirstPath(strPath);
@@ -711,7 +713,7 @@ bool CFileItem::IsVideo() const
   if (IsPVRRecording())
     return true;
 
-  if (URIUtils::IsDVD(m_strPath))
+  if (URIUtils::IsDVD(m_path.Get()))
     return true;
 
   std::string extension;
@@ -724,7 +726,7 @@ bool CFileItem::IsVideo() const
      return true;
   }
 
-  return URIUtils::HasExtension(m_strPath, g_advancedSettings.m_videoExtensions);
+  return URIUtils::HasExtension(m_path.Get(), g_advancedSettings.m_videoExtensions);
 }
 
 bool CFileItem::IsEPG() const
@@ -770,7 +772,7 @@ bool CFileItem::IsDiscStub() const
     return dbItem.IsDiscStub();
   }
 
-  return URIUtils::HasExtension(m_strPath, g_advancedSettings.m_discStubExtensions);
+  return URIUtils::HasExtension(m_path.Get(), g_advancedSettings.m_discStubExtensions);
 }
 
 bool CFileItem::IsAudio() const
@@ -800,7 +802,7 @@ bool CFileItem::IsAudio() const
      return true;
   }
 
-  return URIUtils::HasExtension(m_strPath, g_advancedSettings.GetMusicExtensions());
+  return URIUtils::HasExtension(m_path.Get(), g_advancedSettings.GetMusicExtensions());
 }
 
 bool CFileItem::IsPicture() const
@@ -817,22 +819,22 @@ bool CFileItem::IsPicture() const
   if (HasVideoInfoTag())
     return false;
 
-  return CUtil::IsPicture(m_strPath);
+  return CUtil::IsPicture(m_path.Get());
 }
 
 bool CFileItem::IsLyrics() const
 {
-  return URIUtils::HasExtension(m_strPath, ".cdg|.lrc");
+  return URIUtils::HasExtension(m_path.Get(), ".cdg|.lrc");
 }
 
 bool CFileItem::IsSubtitle() const
 {
-  return URIUtils::HasExtension(m_strPath, g_advancedSettings.m_subtitlesExtensions);
+  return URIUtils::HasExtension(m_path.Get(), g_advancedSettings.m_subtitlesExtensions);
 }
 
 bool CFileItem::IsCUESheet() const
 {
-  return URIUtils::HasExtension(m_strPath, ".cue");
+  return URIUtils::HasExtension(m_path.Get(), ".cue");
 }
 
 bool CFileItem::IsInternetStream(const bool bStrictCheck /* = false */) const
@@ -840,7 +842,7 @@ bool CFileItem::IsInternetStream(const bool bStrictCheck /* = false */) const
   if (HasProperty("IsHTTPDirectory"))
     return false;
 
-  return URIUtils::IsInternetStream(m_strPath, bStrictCheck);
+  return URIUtils::IsInternetStream(m_path, bStrictCheck);
 }
 
 bool CFileItem::IsFileFolder(EFileFolderType types) const
@@ -885,7 +887,7 @@ bool CFileItem::IsSmartPlayList() const
   if (HasProperty("library.smartplaylist") && GetProperty("library.smartplaylist").asBoolean())
     return true;
 
-  return URIUtils::HasExtension(m_strPath, ".xsp");
+  return URIUtils::HasExtension(m_path.Get(), ".xsp");
 }
 
 bool CFileItem::IsLibraryFolder() const
@@ -893,7 +895,7 @@ bool CFileItem::IsLibraryFolder() const
   if (HasProperty("library.filter") && GetProperty("library.filter").asBoolean())
     return true;
 
-  return URIUtils::IsLibraryFolder(m_strPath);
+  return URIUtils::IsLibraryFolder(m_path);
 }
 
 bool CFileItem::IsPlayList() const
@@ -903,22 +905,22 @@ bool CFileItem::IsPlayList() const
 
 bool CFileItem::IsPythonScript() const
 {
-  return URIUtils::HasExtension(m_strPath, ".py");
+  return URIUtils::HasExtension(m_path.Get(), ".py");
 }
 
 bool CFileItem::IsType(const char *ext) const
 {
-  return URIUtils::HasExtension(m_strPath, ext);
+  return URIUtils::HasExtension(m_path.Get(), ext);
 }
 
 bool CFileItem::IsNFO() const
 {
-  return URIUtils::HasExtension(m_strPath, ".nfo");
+  return URIUtils::HasExtension(m_path.Get(), ".nfo");
 }
 
 bool CFileItem::IsDiscImage() const
 {
-  return URIUtils::HasExtension(m_strPath, ".img|.iso|.nrg");
+  return URIUtils::HasExtension(m_path.Get(), ".img|.iso|.nrg");
 }
 
 bool CFileItem::IsOpticalMediaFile() const
@@ -931,7 +933,7 @@ bool CFileItem::IsOpticalMediaFile() const
 
 bool CFileItem::IsDVDFile(bool bVobs /*= true*/, bool bIfos /*= true*/) const
 {
-  std::string strFileName = URIUtils::GetFileName(m_strPath);
+  std::string strFileName = URIUtils::GetFileName(m_path.Get());
   if (bIfos)
   {
     if (StringUtils::EqualsNoCase(strFileName, "video_ts.ifo"))
@@ -952,44 +954,44 @@ bool CFileItem::IsDVDFile(bool bVobs /*= true*/, bool bIfos /*= true*/) const
 
 bool CFileItem::IsBDFile() const
 {
-  std::string strFileName = URIUtils::GetFileName(m_strPath);
+  std::string strFileName = URIUtils::GetFileName(m_path.Get());
   return (StringUtils::EqualsNoCase(strFileName, "index.bdmv") || StringUtils::EqualsNoCase(strFileName, "MovieObject.bdmv"));
 }
 
 bool CFileItem::IsRAR() const
 {
-  return URIUtils::IsRAR(m_strPath);
+  return URIUtils::IsRAR(m_path.Get());
 }
 
 bool CFileItem::IsAPK() const
 {
-  return URIUtils::IsAPK(m_strPath);
+  return URIUtils::IsAPK(m_path.Get());
 }
 
 bool CFileItem::IsZIP() const
 {
-  return URIUtils::IsZIP(m_strPath);
+  return URIUtils::IsZIP(m_path.Get());
 }
 
 bool CFileItem::IsCBZ() const
 {
-  return URIUtils::HasExtension(m_strPath, ".cbz");
+  return URIUtils::HasExtension(m_path.Get(), ".cbz");
 }
 
 bool CFileItem::IsCBR() const
 {
-  return URIUtils::HasExtension(m_strPath, ".cbr");
+  return URIUtils::HasExtension(m_path.Get(), ".cbr");
 }
 
 bool CFileItem::IsRSS() const
 {
-  return StringUtils::StartsWithNoCase(m_strPath, "rss://") || URIUtils::HasExtension(m_strPath, ".rss")
+  return StringUtils::StartsWithNoCase(m_path.Get(), "rss://") || URIUtils::HasExtension(m_path.Get(), ".rss")
       || m_mimetype == "application/rss+xml";
 }
 
 bool CFileItem::IsAndroidApp() const
 {
-  return URIUtils::IsAndroidApp(m_strPath);
+  return URIUtils::IsAndroidApp(m_path);
 }
 
 bool CFileItem::IsAudioBook() const
@@ -1001,107 +1003,107 @@ bool CFileItem::IsAudioBook() const
 
 bool CFileItem::IsStack() const
 {
-  return URIUtils::IsStack(m_strPath);
+  return URIUtils::IsStack(m_path);
 }
 
 bool CFileItem::IsPlugin() const
 {
-  return URIUtils::IsPlugin(m_strPath);
+  return URIUtils::IsPlugin(m_path);
 }
 
 bool CFileItem::IsScript() const
 {
-  return URIUtils::IsScript(m_strPath);
+  return URIUtils::IsScript(m_path);
 }
 
 bool CFileItem::IsAddonsPath() const
 {
-  return URIUtils::IsAddonsPath(m_strPath);
+  return URIUtils::IsAddonsPath(m_path);
 }
 
 bool CFileItem::IsSourcesPath() const
 {
-  return URIUtils::IsSourcesPath(m_strPath);
+  return URIUtils::IsSourcesPath(m_path);
 }
 
 bool CFileItem::IsMultiPath() const
 {
-  return URIUtils::IsMultiPath(m_strPath);
+  return URIUtils::IsMultiPath(m_path);
 }
 
 bool CFileItem::IsCDDA() const
 {
-  return URIUtils::IsCDDA(m_strPath);
+  return URIUtils::IsCDDA(m_path);
 }
 
 bool CFileItem::IsDVD() const
 {
-  return URIUtils::IsDVD(m_strPath) || m_iDriveType == CMediaSource::SOURCE_TYPE_DVD;
+  return URIUtils::IsDVD(m_path.Get()) || m_iDriveType == CMediaSource::SOURCE_TYPE_DVD;
 }
 
 bool CFileItem::IsOnDVD() const
 {
-  return URIUtils::IsOnDVD(m_strPath) || m_iDriveType == CMediaSource::SOURCE_TYPE_DVD;
+  return URIUtils::IsOnDVD(m_path.Get()) || m_iDriveType == CMediaSource::SOURCE_TYPE_DVD;
 }
 
 bool CFileItem::IsNfs() const
 {
-  return URIUtils::IsNfs(m_strPath);
+  return URIUtils::IsNfs(m_path);
 }
 
 bool CFileItem::IsOnLAN() const
 {
-  return URIUtils::IsOnLAN(m_strPath);
+  return URIUtils::IsOnLAN(m_path);
 }
 
 bool CFileItem::IsISO9660() const
 {
-  return URIUtils::IsISO9660(m_strPath);
+  return URIUtils::IsISO9660(m_path);
 }
 
 bool CFileItem::IsRemote() const
 {
-  return URIUtils::IsRemote(m_strPath);
+  return URIUtils::IsRemote(m_path);
 }
 
 bool CFileItem::IsSmb() const
 {
-  return URIUtils::IsSmb(m_strPath);
+  return URIUtils::IsSmb(m_path);
 }
 
 bool CFileItem::IsURL() const
 {
-  return URIUtils::IsURL(m_strPath);
+  return URIUtils::IsURL(m_path.Get());
 }
 
 bool CFileItem::IsPVR() const
 {
-  return CUtil::IsPVR(m_strPath);
+  return CUtil::IsPVR(m_path.Get());
 }
 
 bool CFileItem::IsLiveTV() const
 {
-  return URIUtils::IsLiveTV(m_strPath);
+  return URIUtils::IsLiveTV(m_path.Get());
 }
 
 bool CFileItem::IsHD() const
 {
-  return URIUtils::IsHD(m_strPath);
+  return URIUtils::IsHD(m_path);
 }
 
 bool CFileItem::IsMusicDb() const
 {
-  return URIUtils::IsMusicDb(m_strPath);
+  return URIUtils::IsMusicDb(m_path);
 }
 
 bool CFileItem::IsVideoDb() const
 {
-  return URIUtils::IsVideoDb(m_strPath);
+  return URIUtils::IsVideoDb(m_path);
 }
 
 bool CFileItem::IsVirtualDirectoryRoot() const
 {
-  return (m_bIsFolder && m_strPath.empty());
+  return (m_bIsFolder && m_path.Get().empty());
 }
 
 bool CFileItem::IsRemovable() const
@@ -1117,7 +1119,7 @@ bool CFileItem::IsReadOnly() const
   if (m_bIsShareOrDrive)
     return true;
 
-  return !CUtil::SupportsWriteFileOperations(m_strPath);
+  return !CUtil::SupportsWriteFileOperations(m_path.Get());
 }
 
 void CFileItem::FillInDefaultIcon()
@@ -1157,7 +1159,7 @@ void CFileItem::FillInDefaultIcon()
         // Live TV Channel
         SetIconImage("DefaultVideo.png");
       }
-      else if ( URIUtils::IsArchive(m_strPath) )
+      else if ( URIUtils::IsArchive(m_path.Get()) )
       { // archive
         SetIconImage("DefaultFile.png");
       }
@@ -1223,9 +1225,9 @@ void CFileItem::FillInDefaultIcon()
   // Set the icon overlays (if applicable)
   if (!HasOverlay())
   {
-    if (URIUtils::IsInRAR(m_strPath))
+    if (URIUtils::IsInRAR(m_path))
       SetOverlayImage(CGUIListItem::ICON_OVERLAY_RAR);
-    else if (URIUtils::IsInZIP(m_strPath))
+    else if (URIUtils::IsInZIP(m_path))
       SetOverlayImage(CGUIListItem::ICON_OVERLAY_ZIP);
   }
 }
@@ -1295,9 +1297,9 @@ void CFileItem::FillInMimeType(bool lookup /*= true*/)
       m_mimetype = "x-directory/normal";
     else if( m_pvrChannelInfoTag )
       m_mimetype = m_pvrChannelInfoTag->InputFormat();
-    else if( StringUtils::StartsWithNoCase(m_strPath, "shout://")
-          || StringUtils::StartsWithNoCase(m_strPath, "http://")
-          || StringUtils::StartsWithNoCase(m_strPath, "https://"))
+    else if( StringUtils::StartsWithNoCase(m_path.Get(), "shout://")
+          || StringUtils::StartsWithNoCase(m_path.Get(), "http://")
+          || StringUtils::StartsWithNoCase(m_path.Get(), "https://"))
     {
       // If lookup is false, bail out early to leave mime type empty
       if (!lookup)
@@ -1328,7 +1330,19 @@ void CFileItem::FillInMimeType(bool lookup /*= true*/)
 
   // change protocol to mms for the following mime-type.  Allows us to create proper FileMMS.
   if( StringUtils::StartsWithNoCase(m_mimetype, "application/vnd.ms.wms-hdr.asfv1") || StringUtils::StartsWithNoCase(m_mimetype, "application/x-mms-framed") )
-    StringUtils::Replace(m_strPath, "http:", "mms:");
+  {
+    std::string path(m_path.Get());
+    StringUtils::Replace(path, "http:", "mms:");
+    SetPath(path);
+  }
+}
+
+void CFileItem::AddSlashAtEndOfPath()
+{
+  std::string path(m_path.Get());
+  URIUtils::AddSlashAtEnd(path);
+  if (path != m_path.Get())
+    SetPath(path);
 }
 
 bool CFileItem::IsSamePath(const CFileItem *item) const
@@ -1336,7 +1350,7 @@ bool CFileItem::IsSamePath(const CFileItem *item) const
   if (!item)
     return false;
 
-  if (item->GetPath() == m_strPath)
+  if (item->GetPath() == m_path.Get())
   {
     if (item->HasProperty("item_start") || HasProperty("item_start"))
       return (item->GetProperty("item_start") == GetProperty("item_start"));
@@ -1429,13 +1443,13 @@ void CFileItem::SetFromVideoInfoTag(const CVideoInfoTag &video)
     SetLabel(video.m_strTitle);
   if (video.m_strFileNameAndPath.empty())
   {
-    m_strPath = video.m_strPath;
-    URIUtils::AddSlashAtEnd(m_strPath);
+    SetPath(video.m_strPath);
+    AddSlashAtEndOfPath();
     m_bIsFolder = true;
   }
   else
   {
-    m_strPath = video.m_strFileNameAndPath;
+    SetPath(video.m_strFileNameAndPath);
     m_bIsFolder = false;
   }
   
@@ -1451,8 +1465,8 @@ void CFileItem::SetFromMusicInfoTag(const MUSIC_INFO::CMusicInfoTag &music)
   if (!music.GetTitle().empty())
     SetLabel(music.GetTitle());
   if (!music.GetURL().empty())
-    m_strPath = music.GetURL();
-  m_bIsFolder = URIUtils::HasSlashAtEnd(m_strPath);
+    SetPath(music.GetURL());
+  m_bIsFolder = URIUtils::HasSlashAtEnd(m_path.Get());
 
   *GetMusicInfoTag() = music;
   FillInDefaultIcon();
@@ -1466,7 +1480,7 @@ void CFileItem::SetFromAlbum(const CAlbum &album)
   m_bIsFolder = true;
   m_strLabel2 = album.GetAlbumArtistString();
   GetMusicInfoTag()->SetAlbum(album);
-  SetArt(album.art);
+  SetArt(ArtMap(album.art));
   m_bIsAlbum = true;
   CMusicDatabase::SetPropertiesFromAlbum(*this,album);
   FillInMimeType(false);
@@ -1477,7 +1491,7 @@ void CFileItem::SetFromSong(const CSong &song)
   if (!song.strTitle.empty())
     SetLabel(song.strTitle);
   if (!song.strFileName.empty())
-    m_strPath = song.strFileName;
+    SetPath(song.strFileName);
   GetMusicInfoTag()->SetSong(song);
   m_lStartOffset = song.iStartOffset;
   m_lStartPartNumber = 1;
@@ -1531,12 +1545,12 @@ std::string CFileItem::GetOpticalMediaPath() const
  */
 void CFileItem::SetURL(const CURL& url)
 {
-  m_strPath = url.Get();
+  SetPath(url.Get());
 }
 
 const CURL CFileItem::GetURL() const
 {
-  CURL url(m_strPath);
+  CURL url(m_path.Get());
   return url;
 }
 
@@ -1547,7 +1561,7 @@ bool CFileItem::IsURL(const CURL& url) const
 
 bool CFileItem::IsPath(const std::string& path, bool ignoreURLOptions /* = false */) const
 {
-  return URIUtils::PathEquals(m_strPath, path, false, ignoreURLOptions);
+  return URIUtils::PathEquals(m_path.Get(), path, false, ignoreURLOptions);
 }
 
 void CFileItem::SetCueDocument(const CCueDocumentPtr& cuePtr)
@@ -2702,13 +2716,13 @@ bool CFileItemList::AlwaysCache() const
 
 std::string CFileItem::GetUserMusicThumb(bool alwaysCheckRemote /* = false */, bool fallbackToFolder /* = false */) const
 {
-  if (m_strPath.empty()
-   || StringUtils::StartsWithNoCase(m_strPath, "newsmartplaylist://")
-   || StringUtils::StartsWithNoCase(m_strPath, "newplaylist://")
+  if (m_path.Get().empty()
+   || StringUtils::StartsWithNoCase(m_path.Get(), "newsmartplaylist://")
+   || StringUtils::StartsWithNoCase(m_path.Get(), "newplaylist://")
    || m_bIsShareOrDrive
    || IsInternetStream()
-   || URIUtils::IsUPnP(m_strPath)
-   || (URIUtils::IsFTP(m_strPath) && !g_advancedSettings.m_bFTPThumbs)
+   || URIUtils::IsUPnP(m_path)
+   || (URIUtils::IsFTP(m_path) && !g_advancedSettings.m_bFTPThumbs)
    || IsPlugin()
    || IsAddonsPath()
    || IsLibraryFolder()
@@ -2724,7 +2738,7 @@ std::string CFileItem::GetUserMusicThumb(bool alwaysCheckRemote /* = false */, b
   // Fall back to folder thumb, if requested
   if (!m_bIsFolder && fallbackToFolder)
   {
-    CFileItem item(URIUtils::GetDirectory(m_strPath), true);
+    CFileItem item(URIUtils::GetDirectory(m_path.Get()), true);
     return item.GetUserMusicThumb(alwaysCheckRemote);
   }
 
@@ -2751,12 +2765,12 @@ std::string CFileItem::GetUserMusicThumb(bool alwaysCheckRemote /* = false */, b
 std::string CFileItem::GetTBNFile() const
 {
   std::string thumbFile;
-  std::string strFile = m_strPath;
+  std::string strFile = m_path.Get();
 
   if (IsStack())
   {
     std::string strPath, strReturn;
-    URIUtils::GetParentPath(m_strPath,strPath);
+    URIUtils::GetParentPath(m_path.Get(),strPath);
     CFileItem item(CStackDirectory::GetFirstStackedFile(strFile),false);
     std::string strTBNFile = item.GetTBNFile();
     strReturn = URIUtils::AddFileToFolder(strPath, URIUtils::GetFileName(strTBNFile));
@@ -2771,7 +2785,7 @@ std::string CFileItem::GetTBNFile() const
     std::string strPath = URIUtils::GetDirectory(strFile);
     std::string strParent;
     URIUtils::GetParentPath(strPath,strParent);
-    strFile = URIUtils::AddFileToFolder(strParent, URIUtils::GetFileName(m_strPath));
+    strFile = URIUtils::AddFileToFolder(strParent, URIUtils::GetFileName(m_path.Get()));
   }
 
   CURL url(strFile);
@@ -2794,13 +2808,13 @@ std::string CFileItem::GetTBNFile() const
 
 bool CFileItem::SkipLocalArt() const
 {
-  return (m_strPath.empty()
-       || StringUtils::StartsWithNoCase(m_strPath, "newsmartplaylist://")
-       || StringUtils::StartsWithNoCase(m_strPath, "newplaylist://")
+  return (m_path.Get().empty()
+       || StringUtils::StartsWithNoCase(m_path.Get(), "newsmartplaylist://")
+       || StringUtils::StartsWithNoCase(m_path.Get(), "newplaylist://")
        || m_bIsShareOrDrive
        || IsInternetStream()
-       || URIUtils::IsUPnP(m_strPath)
-       || (URIUtils::IsFTP(m_strPath) && !g_advancedSettings.m_bFTPThumbs)
+       || URIUtils::IsUPnP(m_path)
+       || (URIUtils::IsFTP(m_path) && !g_advancedSettings.m_bFTPThumbs)
        || IsPlugin()
        || IsAddonsPath()
        || IsLibraryFolder()
@@ -2836,7 +2850,7 @@ std::string CFileItem::GetLocalArt(const std::string &artFile, bool useFolder) c
   if (useFolder && artFile.empty())
     return "";
 
-  std::string strFile = m_strPath;
+  std::string strFile = m_path.Get();
   if (IsStack())
   {
 /*    CFileItem item(CStackDirectory::GetFirstStackedFile(strFile),false);
@@ -2844,7 +2858,7 @@ std::string CFileItem::GetLocalArt(const std::string &artFile, bool useFolder) c
     return localArt;
     */
     std::string strPath;
-    URIUtils::GetParentPath(m_strPath,strPath);
+    URIUtils::GetParentPath(m_path.Get(),strPath);
     strFile = URIUtils::AddFileToFolder(strPath, URIUtils::GetFileName(CStackDirectory::GetStackedTitlePath(strFile)));
   }
 
@@ -2857,7 +2871,7 @@ std::string CFileItem::GetLocalArt(const std::string &artFile, bool useFolder) c
   }
 
   if (IsMultiPath())
-    strFile = CMultiPathDirectory::GetFirstPath(m_strPath);
+    strFile = CMultiPathDirectory::GetFirstPath(m_path.Get());
 
   if (IsOpticalMediaFile())
   { // optical media files should be treated like folders
@@ -2887,17 +2901,17 @@ std::string CFileItem::GetLocalArt(const std::string &artFile, bool useFolder) c
 
 std::string CFileItem::GetFolderThumb(const std::string &folderJPG /* = "folder.jpg" */) const
 {
-  std::string strFolder = m_strPath;
+  std::string strFolder = m_path.Get();
 
   if (IsStack() ||
       URIUtils::IsInRAR(strFolder) ||
       URIUtils::IsInZIP(strFolder))
   {
-    URIUtils::GetParentPath(m_strPath,strFolder);
+    URIUtils::GetParentPath(m_path.Get(),strFolder);
   }
 
   if (IsMultiPath())
-    strFolder = CMultiPathDirectory::GetFirstPath(m_strPath);
+    strFolder = CMultiPathDirectory::GetFirstPath(m_path.Get());
 
   return URIUtils::AddFileToFolder(strFolder, folderJPG);
 }
@@ -2909,9 +2923,9 @@ std::string CFileItem::GetMovieName(bool bUseFolderNames /* = false */) const
 
   if (m_pvrRecordingInfoTag)
     return m_pvrRecordingInfoTag->m_strTitle;
-  else if (CUtil::IsTVRecording(m_strPath))
+  else if (CUtil::IsTVRecording(m_path.Get()))
   {
-    std::string title = CPVRRecording::GetTitleFromURL(m_strPath);
+    std::string title = CPVRRecording::GetTitleFromURL(m_path.Get());
     if (!title.empty())
       return title;
   }
@@ -2928,21 +2942,21 @@ std::string CFileItem::GetMovieName(bool bUseFolderNames /* = false */) const
 
 std::string CFileItem::GetBaseMoviePath(bool bUseFolderNames) const
 {
-  std::string strMovieName = m_strPath;
+  std::string strMovieName = m_path.Get();
 
   if (IsMultiPath())
-    strMovieName = CMultiPathDirectory::GetFirstPath(m_strPath);
+    strMovieName = CMultiPathDirectory::GetFirstPath(m_path.Get());
 
   if (IsOpticalMediaFile())
     return GetLocalMetadataPath();
 
   if (bUseFolderNames &&
-     (!m_bIsFolder || URIUtils::IsInArchive(m_strPath) ||
+     (!m_bIsFolder || URIUtils::IsInArchive(m_path) ||
      (HasVideoInfoTag() && GetVideoInfoTag()->m_iDbId > 0 && !CMediaTypes::IsContainer(GetVideoInfoTag()->m_type))))
   {
     std::string name2(strMovieName);
     URIUtils::GetParentPath(name2,strMovieName);
-    if (URIUtils::IsInArchive(m_strPath))
+    if (URIUtils::IsInArchive(m_path))
     {
       std::string strArchivePath;
       URIUtils::GetParentPath(strMovieName, strArchivePath);
@@ -2964,16 +2978,16 @@ std::string CFileItem::GetLocalFanart() const
   }
 
   std::string strFile2;
-  std::string strFile = m_strPath;
+  std::string strFile = m_path.Get();
   if (IsStack())
   {
     std::string strPath;
-    URIUtils::GetParentPath(m_strPath,strPath);
+    URIUtils::GetParentPath(m_path.Get(),strPath);
     CStackDirectory dir;
     std::string strPath2;
     strPath2 = dir.GetStackedTitlePath(strFile);
     strFile = URIUtils::AddFileToFolder(strPath, URIUtils::GetFileName(strPath2));
-    CFileItem item(dir.GetFirstStackedFile(m_strPath),false);
+    CFileItem item(dir.GetFirstStackedFile(m_path.Get()),false);
     std::string strTBNFile(URIUtils::ReplaceExtension(item.GetTBNFile(), "-fanart"));
     strFile2 = URIUtils::AddFileToFolder(strPath, URIUtils::GetFileName(strTBNFile));
   }
@@ -2982,7 +2996,7 @@ std::string CFileItem::GetLocalFanart() const
     std::string strPath = URIUtils::GetDirectory(strFile);
     std::string strParent;
     URIUtils::GetParentPath(strPath,strParent);
-    strFile = URIUtils::AddFileToFolder(strParent, URIUtils::GetFileName(m_strPath));
+    strFile = URIUtils::AddFileToFolder(strParent, URIUtils::GetFileName(m_path.Get()));
   }
 
   // no local fanart available for these
@@ -2994,7 +3008,7 @@ std::string CFileItem::GetLocalFanart() const
    || IsAddonsPath()
    || IsDVD()
    || (URIUtils::IsFTP(strFile) && !g_advancedSettings.m_bFTPThumbs)
-   || m_strPath.empty())
+   || m_path.Get().empty())
     return "";
 
   std::string strDir = URIUtils::GetDirectory(strFile);
@@ -3023,12 +3037,12 @@ std::string CFileItem::GetLocalFanart() const
   {
     for (int j = 0; j < items.Size(); j++)
     {
-      std::string strCandidate = URIUtils::GetFileName(items[j]->m_strPath);
+      std::string strCandidate = URIUtils::GetFileName(items[j]->GetPath());
       URIUtils::RemoveExtension(strCandidate);
       std::string strFanart = *i;
       URIUtils::RemoveExtension(strFanart);
       if (StringUtils::EqualsNoCase(strCandidate, strFanart))
-        return items[j]->m_strPath;
+        return items[j]->GetPath();
     }
   }
 
@@ -3038,9 +3052,9 @@ std::string CFileItem::GetLocalFanart() const
 std::string CFileItem::GetLocalMetadataPath() const
 {
   if (m_bIsFolder && !IsFileFolder())
-    return m_strPath;
+    return m_path.Get();
 
-  std::string parent(URIUtils::GetParentPath(m_strPath));
+  std::string parent(URIUtils::GetParentPath(m_path.Get()));
   std::string parentFolder(parent);
   URIUtils::RemoveSlashAtEnd(parentFolder);
   parentFolder = URIUtils::GetFileName(parentFolder);
@@ -3064,7 +3078,7 @@ bool CFileItem::LoadMusicTag()
   if (musicDatabase.Open())
   {
     CSong song;
-    if (musicDatabase.GetSongByFileName(m_strPath, song))
+    if (musicDatabase.GetSongByFileName(m_path.Get(), song))
     {
       GetMusicInfoTag()->SetSong(song);
       SetArt("thumb", song.strThumb);
@@ -3073,12 +3087,12 @@ bool CFileItem::LoadMusicTag()
     musicDatabase.Close();
   }
   // load tag from file
-  CLog::Log(LOGDEBUG, "%s: loading tag information for file: %s", __FUNCTION__, m_strPath.c_str());
+  CLog::Log(LOGDEBUG, "%s: loading tag information for file: %s", __FUNCTION__, m_path.Get().c_str());
   CMusicInfoTagLoaderFactory factory;
   std::unique_ptr<IMusicInfoTagLoader> pLoader (factory.CreateLoader(*this));
   if (pLoader.get() != NULL)
   {
-    if (pLoader->Load(m_strPath, *GetMusicInfoTag()))
+    if (pLoader->Load(m_path.Get(), *GetMusicInfoTag()))
       return true;
   }
   // no tag - try some other things
@@ -3099,7 +3113,7 @@ bool CFileItem::LoadMusicTag()
   }
   else
   {
-    std::string fileName = URIUtils::GetFileName(m_strPath);
+    std::string fileName = URIUtils::GetFileName(m_path.Get());
     URIUtils::RemoveExtension(fileName);
     for (unsigned int i = 0; i < g_advancedSettings.m_musicTagsFromFileFilters.size(); i++)
     {
@@ -3201,16 +3215,16 @@ MUSIC_INFO::CMusicInfoTag* CFileItem::GetMusicInfoTag()
 std::string CFileItem::FindTrailer() const
 {
   std::string strFile2;
-  std::string strFile = m_strPath;
+  std::string strFile = m_path.Get();
   if (IsStack())
   {
     std::string strPath;
-    URIUtils::GetParentPath(m_strPath,strPath);
+    URIUtils::GetParentPath(m_path.Get(),strPath);
     CStackDirectory dir;
     std::string strPath2;
     strPath2 = dir.GetStackedTitlePath(strFile);
     strFile = URIUtils::AddFileToFolder(strPath,URIUtils::GetFileName(strPath2));
-    CFileItem item(dir.GetFirstStackedFile(m_strPath),false);
+    CFileItem item(dir.GetFirstStackedFile(m_path.Get()),false);
     std::string strTBNFile(URIUtils::ReplaceExtension(item.GetTBNFile(), "-trailer"));
     strFile2 = URIUtils::AddFileToFolder(strPath,URIUtils::GetFileName(strTBNFile));
   }
@@ -3219,7 +3233,7 @@ std::string CFileItem::FindTrailer() const
     std::string strPath = URIUtils::GetDirectory(strFile);
     std::string strParent;
     URIUtils::GetParentPath(strPath,strParent);
-    strFile = URIUtils::AddFileToFolder(strParent,URIUtils::GetFileName(m_strPath));
+    strFile = URIUtils::AddFileToFolder(strParent,URIUtils::GetFileName(m_path.Get()));
   }
 
   // no local trailer available for these
@@ -3256,13 +3270,13 @@ std::string CFileItem::FindTrailer() const
   std::string strTrailer;
   for (int i = 0; i < items.Size(); i++)
   {
-    std::string strCandidate = items[i]->m_strPath;
+    std::string strCandidate = items[i]->GetPath();
     URIUtils::RemoveExtension(strCandidate);
     if (StringUtils::EqualsNoCase(strCandidate, strFile) ||
         StringUtils::EqualsNoCase(strCandidate, strFile2) ||
         StringUtils::EqualsNoCase(strCandidate, strFile3))
     {
-      strTrailer = items[i]->m_strPath;
+      strTrailer = items[i]->GetPath();
       break;
     }
     else
@@ -3273,7 +3287,7 @@ std::string CFileItem::FindTrailer() const
       {
         if (expr->RegFind(strCandidate) != -1)
         {
-          strTrailer = items[i]->m_strPath;
+          strTrailer = items[i]->GetPath();
           i = items.Size();
           break;
         }
@@ -3297,7 +3311,7 @@ int CFileItem::GetVideoContentType() const
 
   CVideoDatabaseDirectory dir;
   VIDEODATABASEDIRECTORY::CQueryParams params;
-  dir.GetQueryParams(m_strPath, params);
+  dir.GetQueryParams(m_path.Get(), params);
   if (params.GetSetId() != -1 && params.GetMovieId() == -1) // movie set
     return VIDEODB_CONTENT_MOVIE_SETS;
 
@@ -30,6 +30,7 @@
 
 #include "guilib/GUIListItem.h"
 #include "GUIPassword.h"
+#include "ParsedURL.h"
 #include "threads/CriticalSection.h"
 #include "utils/IArchivable.h"
 #include "utils/ISerializable.h"
@@ -124,8 +125,11 @@ public:
   const CURL GetURL() const;
   void SetURL(const CURL& url);
   bool IsURL(const CURL& url) const;
-  const std::string &GetPath() const { return m_strPath; };
-  void SetPath(const std::string &path) { m_strPath = path; };
+  const std::string &GetPath() const { return m_path.Get(); };
+  void SetPath(const std::string &path) { m_path = CParsedURL(path); };
+  /*! \brief the path of the item split into its parts, to be used with the URIUtils checks instead of GetPath()
+   */
+  const CParsedURL &GetParsedPath() const { return m_path; };
   bool IsPath(const std::string& path, bool ignoreURLOptions = false) const;
 
   /*! \brief reset class to it's default values as per construction.
@@ -514,7 +518,11 @@ private:
    */
   void Initialize();
 
-  std::string m_strPath;            ///< complete path to item
+  /*! \brief add a slash to the end of the path of the item (if missing)
+   */
+  void AddSlashAtEndOfPath();
+
+  CParsedURL m_path;                ///< complete path to item, split into its parts once
 
   SortSpecial m_specialSort;
   bool m_bIsParentFolder;
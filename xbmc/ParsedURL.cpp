@@ -0,0 +1,305 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <ctype.h>
+#include <string.h>
+
+#include "ParsedURL.h"
+#include "URL.h"
+#include "utils/StringUtils.h"
+#include "utils/UrlOptions.h"
+
+static const struct
+{
+  const char* name;
+  CParsedURL::Protocol protocol;
+} ProtocolNames[] =
+{
+  { "addons",       CParsedURL::PROTOCOL_ADDONS },
+  { "androidapp",   CParsedURL::PROTOCOL_ANDROIDAPP },
+  { "apk",          CParsedURL::PROTOCOL_APK },
+  { "bluray",       CParsedURL::PROTOCOL_BLURAY },
+  { "cdda",         CParsedURL::PROTOCOL_CDDA },
+  { "dav",          CParsedURL::PROTOCOL_DAV },
+  { "davs",         CParsedURL::PROTOCOL_DAVS },
+  { "dvd",          CParsedURL::PROTOCOL_DVD },
+  { "file",         CParsedURL::PROTOCOL_FILE },
+  { "filereader",   CParsedURL::PROTOCOL_FILEREADER },
+  { "ftp",          CParsedURL::PROTOCOL_FTP },
+  { "ftps",         CParsedURL::PROTOCOL_FTPS },
+  { "http",         CParsedURL::PROTOCOL_HTTP },
+  { "https",        CParsedURL::PROTOCOL_HTTPS },
+  { "image",        CParsedURL::PROTOCOL_IMAGE },
+  { "iso9660",      CParsedURL::PROTOCOL_ISO9660 },
+  { "library",      CParsedURL::PROTOCOL_LIBRARY },
+  { "mms",          CParsedURL::PROTOCOL_MMS },
+  { "mmsh",         CParsedURL::PROTOCOL_MMSH },
+  { "mmst",         CParsedURL::PROTOCOL_MMST },
+  { "multipath",    CParsedURL::PROTOCOL_MULTIPATH },
+  { "musicdb",      CParsedURL::PROTOCOL_MUSICDB },
+  { "musicsearch",  CParsedURL::PROTOCOL_MUSICSEARCH },
+  { "nfs",          CParsedURL::PROTOCOL_NFS },
+  { "plugin",       CParsedURL::PROTOCOL_PLUGIN },
+  { "pvr",          CParsedURL::PROTOCOL_PVR },
+  { "rar",          CParsedURL::PROTOCOL_RAR },
+  { "resource",     CParsedURL::PROTOCOL_RESOURCE },
+  { "rss",          CParsedURL::PROTOCOL_RSS },
+  { "rtmp",         CParsedURL::PROTOCOL_RTMP },
+  { "rtmpe",        CParsedURL::PROTOCOL_RTMPE },
+  { "rtmps",        CParsedURL::PROTOCOL_RTMPS },
+  { "rtmpt",        CParsedURL::PROTOCOL_RTMPT },
+  { "rtmpte",       CParsedURL::PROTOCOL_RTMPTE },
+  { "rtp",          CParsedURL::PROTOCOL_RTP },
+  { "rtsp",         CParsedURL::PROTOCOL_RTSP },
+  { "script",       CParsedURL::PROTOCOL_SCRIPT },
+  { "sdp",          CParsedURL::PROTOCOL_SDP },
+  { "sftp",         CParsedURL::PROTOCOL_SFTP },
+  { "shout",        CParsedURL::PROTOCOL_SHOUT },
+  { "smb",          CParsedURL::PROTOCOL_SMB },
+  { "sources",      CParsedURL::PROTOCOL_SOURCES },
+  { "special",      CParsedURL::PROTOCOL_SPECIAL },
+  { "stack",        CParsedURL::PROTOCOL_STACK },
+  { "tcp",          CParsedURL::PROTOCOL_TCP },
+  { "udf",          CParsedURL::PROTOCOL_UDF },
+  { "udp",          CParsedURL::PROTOCOL_UDP },
+  { "upnp",         CParsedURL::PROTOCOL_UPNP },
+  { "videodb",      CParsedURL::PROTOCOL_VIDEODB },
+  { "virtualpath",  CParsedURL::PROTOCOL_VIRTUALPATH },
+  { "xbt",          CParsedURL::PROTOCOL_XBT },
+  { "zip",          CParsedURL::PROTOCOL_ZIP }
+};
+
+static bool EqualsNoCase(const char* str, size_t length, const char* lowerCase)
+{
+  for (size_t i = 0; i < length; i++)
+  {
+    if (lowerCase[i] == '\0' || tolower(static_cast<unsigned char>(str[i])) != lowerCase[i])
+      return false;
+  }
+  return lowerCase[length] == '\0';
+}
+
+CParsedURL::CParsedURL()
+  : m_protocol(PROTOCOL_NONE),
+    m_protocolLength(0),
+    m_hostStart(0),
+    m_hostEnd(0),
+    m_fileStart(0),
+    m_fileEnd(0),
+    m_optionsStart(0),
+    m_optionsEnd(0),
+    m_requiresFullParse(false)
+{ }
+
+CParsedURL::CParsedURL(const std::string& url)
+  : m_url(url),
+    m_protocol(PROTOCOL_NONE),
+    m_protocolLength(0),
+    m_hostStart(0),
+    m_hostEnd(0),
+    m_fileStart(0),
+    m_fileEnd(0),
+    m_optionsStart(0),
+    m_optionsEnd(0),
+    m_requiresFullParse(false)
+{
+  Parse();
+}
+
+CParsedURL::Protocol CParsedURL::LookupProtocol(const char* protocol, size_t length)
+{
+  for (size_t i = 0; i < sizeof(ProtocolNames) / sizeof(ProtocolNames[0]); i++)
+  {
+    if (EqualsNoCase(protocol, length, ProtocolNames[i].name))
+      return ProtocolNames[i].protocol;
+  }
+
+  return PROTOCOL_OTHER;
+}
+
+void CParsedURL::Parse()
+{
+  // follows CURL::Parse() but only remembers where the parts are
+  const size_t length = m_url.size();
+  if (length == 0 || m_url == "?")
+    return;
+
+  size_t pos = m_url.find("://");
+  if (pos == std::string::npos)
+  {
+    m_fileEnd = length;
+    // CURL checks the file system for archives in local paths
+    // and changes backslashes to slashes
+    m_requiresFullParse = m_url.find(".zip/") != std::string::npos ||
+                          m_url.find(".apk/") != std::string::npos ||
+                          m_url.find('\\') != std::string::npos;
+    return;
+  }
+
+  m_protocol = LookupProtocol(m_url.c_str(), pos);
+  m_protocolLength = pos;
+  pos += 3;
+
+  // virtual protocols only have a file name
+  if (m_protocol == PROTOCOL_STACK || m_protocol == PROTOCOL_VIRTUALPATH ||
+      m_protocol == PROTOCOL_MULTIPATH || m_protocol == PROTOCOL_FILEREADER ||
+      m_protocol == PROTOCOL_SPECIAL || m_protocol == PROTOCOL_RESOURCE)
+  {
+    m_hostStart = m_hostEnd = pos;
+    m_fileStart = pos;
+    m_fileEnd = length;
+    return;
+  }
+
+  // CUtil::ValidatePath() and CURL change backslashes in some cases
+  m_requiresFullParse = m_url.find('\\', pos) != std::string::npos;
+
+  size_t end = length;
+  const char* sep = NULL;
+  const Protocol translated = GetTranslatedProtocol();
+  if (m_protocol == PROTOCOL_RSS || m_protocol == PROTOCOL_RAR || m_protocol == PROTOCOL_APK ||
+      m_protocol == PROTOCOL_XBT || m_protocol == PROTOCOL_ZIP || m_protocol == PROTOCOL_ADDONS ||
+      m_protocol == PROTOCOL_IMAGE || m_protocol == PROTOCOL_VIDEODB || m_protocol == PROTOCOL_MUSICDB ||
+      m_protocol == PROTOCOL_ANDROIDAPP)
+    sep = "?";
+  else if (translated == PROTOCOL_HTTP || translated == PROTOCOL_HTTPS || translated == PROTOCOL_PLUGIN ||
+           translated == PROTOCOL_RTSP)
+    sep = "?;#|";
+  else if (translated == PROTOCOL_FTP || translated == PROTOCOL_FTPS)
+    sep = "?;|";
+
+  if (sep != NULL)
+  {
+    size_t options = m_url.find_first_of(sep, pos);
+    if (options != std::string::npos)
+    {
+      size_t protocolOptions = m_url.find('|', options);
+      m_optionsStart = options;
+      m_optionsEnd = protocolOptions != std::string::npos ? protocolOptions : length;
+      end = options;
+    }
+  }
+
+  size_t slash = m_url.find('/', pos);
+  if (slash >= end)
+    slash = std::string::npos;
+
+  // skip user name and password
+  if (m_protocol != PROTOCOL_ISO9660)
+  {
+    size_t alpha = m_url.find('@', pos);
+    if (alpha != std::string::npos && alpha < end && (slash == std::string::npos || alpha < slash))
+    {
+      pos = alpha + 1;
+      slash = m_url.find('/', alpha);
+      if (slash >= end)
+        slash = std::string::npos;
+    }
+  }
+
+  m_hostStart = pos;
+  m_hostEnd = slash != std::string::npos ? slash : end;
+  if (slash != std::string::npos && end > slash + 1)
+  {
+    m_fileStart = slash + 1;
+    m_fileEnd = end;
+  }
+  else
+    m_fileStart = m_fileEnd = m_hostEnd;
+
+  // these protocols don't have a host name
+  if (m_protocol == PROTOCOL_ISO9660 || m_protocol == PROTOCOL_MUSICDB || m_protocol == PROTOCOL_VIDEODB ||
+      m_protocol == PROTOCOL_SOURCES || m_protocol == PROTOCOL_PVR)
+  {
+    if (m_hostEnd > m_hostStart)
+    {
+      m_fileStart = m_hostStart;
+      m_fileEnd = end;
+    }
+    else
+      m_fileStart = m_fileEnd = m_hostEnd;
+    m_hostEnd = m_hostStart;
+  }
+}
+
+bool CParsedURL::IsProtocol(const char* protocol) const
+{
+  if (m_protocol == PROTOCOL_NONE)
+    return protocol == NULL || *protocol == '\0';
+
+  return protocol != NULL && EqualsNoCase(m_url.c_str(), m_protocolLength, protocol);
+}
+
+std::string CParsedURL::GetProtocolName() const
+{
+  std::string protocol = m_url.substr(0, m_protocolLength);
+  StringUtils::ToLower(protocol);
+  return protocol;
+}
+
+CParsedURL::Protocol CParsedURL::GetTranslatedProtocol() const
+{
+  if (m_protocol == PROTOCOL_SHOUT || m_protocol == PROTOCOL_DAV || m_protocol == PROTOCOL_RSS)
+    return PROTOCOL_HTTP;
+
+  if (m_protocol == PROTOCOL_DAVS)
+    return PROTOCOL_HTTPS;
+
+  return m_protocol;
+}
+
+std::string CParsedURL::GetHostName() const
+{
+  std::string hostName = m_url.substr(m_hostStart, m_hostEnd - m_hostStart);
+
+  // IPv6 addresses are enclosed in []
+  size_t bracket = hostName.rfind(']');
+  if (bracket != std::string::npos && hostName.find('[') == 0)
+    hostName = hostName.substr(1, bracket - 1);
+  else
+  {
+    size_t colon = hostName.rfind(':');
+    if (colon != std::string::npos && colon == hostName.find(':'))
+      hostName.erase(colon);
+  }
+
+  // see URIUtils::HasEncodedHostname()
+  if (m_protocol == PROTOCOL_ZIP || m_protocol == PROTOCOL_RAR || m_protocol == PROTOCOL_APK ||
+      m_protocol == PROTOCOL_BLURAY || m_protocol == PROTOCOL_UDF || m_protocol == PROTOCOL_XBT ||
+      m_protocol == PROTOCOL_MUSICSEARCH || m_protocol == PROTOCOL_IMAGE)
+    hostName = CURL::Decode(hostName);
+
+  return hostName;
+}
+
+std::string CParsedURL::GetFileName() const
+{
+  return m_url.substr(m_fileStart, m_fileEnd - m_fileStart);
+}
+
+std::string CParsedURL::GetOptions() const
+{
+  return m_url.substr(m_optionsStart, m_optionsEnd - m_optionsStart);
+}
+
+CUrlOptions CParsedURL::GetUrlOptions() const
+{
+  return CUrlOptions(GetOptions());
+}
@@ -0,0 +1,162 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+
+class CUrlOptions;
+
+/*!
+ \brief Immutable path or URL which is split into its parts only once.
+
+ Unlike CURL the parts aren't copied out of the path but only remembered as
+ offsets into it and the protocol is mapped to an enum so checking a path
+ doesn't need any allocations. The parts are split the same way CURL::Parse()
+ does except for the cases where CURL accesses the file system or rewrites
+ the path (local paths into .zip/.apk archives and paths with backslashes),
+ see RequiresFullParse().
+ */
+class CParsedURL
+{
+public:
+  enum Protocol
+  {
+    PROTOCOL_NONE = 0, ///< local path without a protocol
+    PROTOCOL_OTHER,    ///< any protocol not listed below
+    PROTOCOL_ADDONS,
+    PROTOCOL_ANDROIDAPP,
+    PROTOCOL_APK,
+    PROTOCOL_BLURAY,
+    PROTOCOL_CDDA,
+    PROTOCOL_DAV,
+    PROTOCOL_DAVS,
+    PROTOCOL_DVD,
+    PROTOCOL_FILE,
+    PROTOCOL_FILEREADER,
+    PROTOCOL_FTP,
+    PROTOCOL_FTPS,
+    PROTOCOL_HTTP,
+    PROTOCOL_HTTPS,
+    PROTOCOL_IMAGE,
+    PROTOCOL_ISO9660,
+    PROTOCOL_LIBRARY,
+    PROTOCOL_MMS,
+    PROTOCOL_MMSH,
+    PROTOCOL_MMST,
+    PROTOCOL_MULTIPATH,
+    PROTOCOL_MUSICDB,
+    PROTOCOL_MUSICSEARCH,
+    PROTOCOL_NFS,
+    PROTOCOL_PLUGIN,
+    PROTOCOL_PVR,
+    PROTOCOL_RAR,
+    PROTOCOL_RESOURCE,
+    PROTOCOL_RSS,
+    PROTOCOL_RTMP,
+    PROTOCOL_RTMPE,
+    PROTOCOL_RTMPS,
+    PROTOCOL_RTMPT,
+    PROTOCOL_RTMPTE,
+    PROTOCOL_RTP,
+    PROTOCOL_RTSP,
+    PROTOCOL_SCRIPT,
+    PROTOCOL_SDP,
+    PROTOCOL_SFTP,
+    PROTOCOL_SHOUT,
+    PROTOCOL_SMB,
+    PROTOCOL_SOURCES,
+    PROTOCOL_SPECIAL,
+    PROTOCOL_STACK,
+    PROTOCOL_TCP,
+    PROTOCOL_UDF,
+    PROTOCOL_UDP,
+    PROTOCOL_UPNP,
+    PROTOCOL_VIDEODB,
+    PROTOCOL_VIRTUALPATH,
+    PROTOCOL_XBT,
+    PROTOCOL_ZIP
+  };
+
+  CParsedURL();
+  explicit CParsedURL(const std::string& url);
+
+  bool operator==(const CParsedURL& rhs) const { return m_url == rhs.m_url; }
+  bool operator!=(const CParsedURL& rhs) const { return m_url != rhs.m_url; }
+
+  /*!
+   \brief The complete path as it has been passed in
+   */
+  const std::string& Get() const { return m_url; }
+  bool IsEmpty() const { return m_url.empty(); }
+
+  Protocol GetProtocol() const { return m_protocol; }
+  bool IsProtocol(Protocol protocol) const { return m_protocol == protocol; }
+  bool IsProtocol(const char* protocol) const;
+
+  /*!
+   \brief The protocol in lower case like CURL::GetProtocol()
+   */
+  std::string GetProtocolName() const;
+
+  /*!
+   \brief The protocol with shout, dav, rss and davs mapped like CURL::GetTranslatedProtocol()
+   */
+  Protocol GetTranslatedProtocol() const;
+
+  bool HasHostName() const { return m_hostEnd > m_hostStart; }
+  /*!
+   \brief The host name without port, URL decoded for protocols carrying a path in the host name
+   */
+  std::string GetHostName() const;
+
+  bool HasFileName() const { return m_fileEnd > m_fileStart; }
+  std::string GetFileName() const;
+
+  bool HasOptions() const { return m_optionsEnd > m_optionsStart; }
+  /*!
+   \brief The options including their leading character like CURL::GetOptions()
+   */
+  std::string GetOptions() const;
+  /*!
+   \brief Decodes the options, only done when asked for
+   */
+  CUrlOptions GetUrlOptions() const;
+
+  /*!
+   \brief Whether CURL would access the file system or rewrite the path
+   to split it so anything beyond the protocol has to be checked with CURL
+   */
+  bool RequiresFullParse() const { return m_requiresFullParse; }
+
+private:
+  void Parse();
+  static Protocol LookupProtocol(const char* protocol, size_t length);
+
+  std::string m_url;
+  Protocol m_protocol;
+  unsigned int m_protocolLength;
+  unsigned int m_hostStart;
+  unsigned int m_hostEnd;
+  unsigned int m_fileStart;
+  unsigned int m_fileEnd;
+  unsigned int m_optionsStart;
+  unsigned int m_optionsEnd;
+  bool m_requiresFullParse;
+};
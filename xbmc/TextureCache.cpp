@@ -28,8 +28,11 @@
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include "URL.h"
 #include "utils/StringUtils.h"
+#include "XBDateTime.h"
+#include <atomic>
 #include <string.h>
 
 using namespace XFILE;
@@ -40,7 +43,7 @@ CTextureCache &CTextureCache::GetInstance()
   return s_cache;
 }
 
-CTextureCache::CTextureCache() : CJobQueue(false, 1, CJob::PRIORITY_LOW_PAUSABLE)
+CTextureCache::CTextureCache() : CJobQueue(false, 1, CJob::PRIORITY_LOW_PAUSABLE), m_indexLoaded(false)
 {
 }
 
@@ -52,14 +55,58 @@ void CTextureCache::Initialize()
 {
   CSingleLock lock(m_databaseSection);
   if (!m_database.IsOpen())
+  {
     m_database.Open();
+    LoadIndex();
+  }
 }
 
 void CTextureCache::Deinitialize()
 {
   CancelJobs();
+
+  // store the uses that didn't make it into a job yet
+  TextureUseCounts useCounts;
+  {
+    CSingleLock lock(m_useCountSection);
+    useCounts.swap(m_useCounts);
+  }
+
   CSingleLock lock(m_databaseSection);
+  if (!useCounts.empty() && m_database.IsOpen())
+    CTextureUseCountJob::StoreUseCounts(m_database, useCounts);
   m_database.Close();
+
+  CExclusiveLock indexLock(m_indexSection);
+  if (m_indexLoaded)
+  {
+    unsigned int hits = m_index.GetHits();
+    unsigned int lookups = hits + m_index.GetMisses();
+    CLog::Log(LOGDEBUG, "%s - %u of %u image lookups were cached (%.1f%%), index of %u images used %u kB", __FUNCTION__,
+              hits, lookups, lookups ? 100.0 * hits / lookups : 0.0,
+              static_cast<unsigned int>(m_index.Size()), static_cast<unsigned int>(m_index.GetMemoryUsage() / 1024));
+  }
+  m_index.Clear();
+  m_indexLoaded = false;
+}
+
+void CTextureCache::LoadIndex()
+{
+  int64_t start = CurrentHostCounter();
+
+  CExclusiveLock lock(m_indexSection);
+  m_index.Clear();
+  m_indexLoaded = m_database.GetCachedTextures(m_index);
+  if (!m_indexLoaded)
+  {
+    m_index.Clear();
+    CLog::Log(LOGWARNING, "%s - unable to index the cached images, looking them up in the database", __FUNCTION__);
+    return;
+  }
+
+  CLog::Log(LOGDEBUG, "%s - indexed %u cached images in %.1f ms using %u kB", __FUNCTION__,
+            static_cast<unsigned int>(m_index.Size()), 1000.0 * (CurrentHostCounter() - start) / CurrentHostFrequency(),
+            static_cast<unsigned int>(m_index.GetMemoryUsage() / 1024));
 }
 
 bool CTextureCache::IsCachedImage(const std::string &url) const
@@ -178,6 +225,94 @@ bool CTextureCache::CacheImage(const std::string &image, CTextureDetails &detail
   return !path.empty();
 }
 
+bool CTextureCache::GetResizedImage(const std::string &image, uint8_t* &result, size_t &result_size)
+{
+  result = NULL;
+  result_size = 0;
+
+  unsigned int width, height;
+  CPictureScalingAlgorithm::Algorithm scalingAlgorithm;
+  std::string additional_info;
+  std::string original = CTextureCacheJob::DecodeImageURL(image, width, height, scalingAlgorithm, additional_info);
+  if (original.empty())
+    return false;
+
+  // every size is cached separately so there has to be a limit
+  if (width > MaxResizedImageSize || height > MaxResizedImageSize)
+  {
+    CLog::Log(LOGDEBUG, "%s - requested size %ux%u of %s is too large", __FUNCTION__, width, height, CURL::GetRedacted(original).c_str());
+    return false;
+  }
+
+  std::string hash = CTextureCacheJob::GetImageHash(original);
+  if (hash.empty())
+    return false;
+
+  // resized images are kept apart from the textures cached for the GUI which are scaled differently
+  std::string url = "resized@" + image;
+  CTextureDetails details;
+  if (GetCachedTexture(url, details) && details.hash == hash)
+  {
+    CFile file;
+    if (file.Open(GetCachedPath(details.file)))
+    {
+      int64_t length = file.GetLength();
+      if (length > 0)
+      {
+        result = new uint8_t[static_cast<size_t>(length)];
+        if (file.Read(result, static_cast<size_t>(length)) == length)
+        {
+          result_size = static_cast<size_t>(length);
+          IncrementUseCount(details);
+          return true;
+        }
+        delete[] result;
+        result = NULL;
+      }
+    }
+  }
+
+  if (!CTextureCacheJob::ResizeTexture(image, result, result_size))
+    return false;
+
+  // there's no way to tell whether the original has changed so don't keep the result
+  if (hash == "BADHASH")
+    return true;
+
+  // the encoder writes either PNG or JPEG, whatever the original was
+  static const uint8_t pngSignature[] = { 0x89, 'P', 'N', 'G' };
+  bool png = result_size >= sizeof(pngSignature) && memcmp(result, pngSignature, sizeof(pngSignature)) == 0;
+
+  details.file = GetCacheFile(url) + (png ? ".png" : ".jpg");
+  details.hash = hash;
+  details.width = details.height = 0;
+  details.updateable = false;
+
+  // write to a temporary file first so concurrent requests never read a partial
+  // image, each request uses its own in case the same image is resized twice at once
+  static std::atomic<unsigned int> tempCounter(0);
+  std::string cachedPath = GetCachedPath(details.file);
+  std::string tempPath = StringUtils::Format("%s.%u.tmp", cachedPath.c_str(), tempCounter++);
+  bool written = false;
+  {
+    CFile file;
+    if (file.OpenForWrite(tempPath, true))
+      written = file.Write(result, result_size) == static_cast<ssize_t>(result_size);
+  }
+  // a stale result of an earlier version of the original may still be around
+  if (written)
+    CFile::Delete(cachedPath);
+  if (written && CFile::Rename(tempPath, cachedPath))
+    AddCachedTexture(url, details);
+  else
+  {
+    CLog::Log(LOGWARNING, "%s - unable to store resized image for %s", __FUNCTION__, CURL::GetRedacted(original).c_str());
+    CFile::Delete(tempPath);
+  }
+
+  return true;
+}
+
 void CTextureCache::ClearCachedImage(const std::string &url, bool deleteSource /*= false */)
 {
   // TODO: This can be removed when the texture cache covers everything.
@@ -208,8 +343,32 @@ bool CTextureCache::ClearCachedImage(int id)
   return false;
 }
 
+bool CTextureCache::InvalidateCachedImage(const std::string &url)
+{
+  CSingleLock lock(m_databaseSection);
+  if (!m_database.IsOpen())
+  { // no skin loaded, so nothing is indexed
+    CTextureDatabase db;
+    return db.Open() && db.InvalidateCachedTexture(url);
+  }
+
+  if (!m_database.InvalidateCachedTexture(url))
+    return false;
+
+  CExclusiveLock indexLock(m_indexSection);
+  if (m_indexLoaded)
+    m_index.SetLastHashCheck(url, CDateTime::GetCurrentDateTime() - CDateTimeSpan(2, 0, 0, 0));
+  return true;
+}
+
 bool CTextureCache::GetCachedTexture(const std::string &url, CTextureDetails &details)
 {
+  {
+    CSharedLock lock(m_indexSection);
+    if (m_indexLoaded)
+      return m_index.Get(url, details);
+  }
+
   CSingleLock lock(m_databaseSection);
   return m_database.GetCachedTexture(url, details);
 }
@@ -217,15 +376,27 @@ bool CTextureCache::GetCachedTexture(const std::string &url, CTextureDetails &de
 bool CTextureCache::AddCachedTexture(const std::string &url, const CTextureDetails &details)
 {
   CSingleLock lock(m_databaseSection);
-  return m_database.AddCachedTexture(url, details);
+  int id = m_database.AddCachedTexture(url, details);
+  if (id < 0)
+    return false;
+
+  CExclusiveLock indexLock(m_indexSection);
+  if (m_indexLoaded)
+  {
+    CTextureDetails indexed(details);
+    indexed.id = id;
+    m_index.Add(url, indexed, details.updateable ? CDateTime::GetCurrentDateTime() : CDateTime());
+  }
+  return true;
 }
 
 void CTextureCache::IncrementUseCount(const CTextureDetails &details)
 {
   static const size_t count_before_update = 100;
   CSingleLock lock(m_useCountSection);
-  m_useCounts.reserve(count_before_update);
-  m_useCounts.push_back(details);
+  std::pair<CTextureDetails, unsigned int> &useCount = m_useCounts[details.id];
+  useCount.first = details;
+  useCount.second++;
   if (m_useCounts.size() >= count_before_update)
   {
     AddJob(new CTextureUseCountJob(m_useCounts));
@@ -236,19 +407,35 @@ void CTextureCache::IncrementUseCount(const CTextureDetails &details)
 bool CTextureCache::SetCachedTextureValid(const std::string &url, bool updateable)
 {
   CSingleLock lock(m_databaseSection);
-  return m_database.SetCachedTextureValid(url, updateable);
+  if (!m_database.SetCachedTextureValid(url, updateable))
+    return false;
+
+  CExclusiveLock indexLock(m_indexSection);
+  if (m_indexLoaded)
+    m_index.SetLastHashCheck(url, updateable ? CDateTime::GetCurrentDateTime() : CDateTime());
+  return true;
 }
 
 bool CTextureCache::ClearCachedTexture(const std::string &url, std::string &cachedURL)
 {
   CSingleLock lock(m_databaseSection);
-  return m_database.ClearCachedTexture(url, cachedURL);
+  if (!m_database.ClearCachedTexture(url, cachedURL))
+    return false;
+
+  CExclusiveLock indexLock(m_indexSection);
+  m_index.Remove(url);
+  return true;
 }
 
 bool CTextureCache::ClearCachedTexture(int id, std::string &cachedURL)
 {
   CSingleLock lock(m_databaseSection);
-  return m_database.ClearCachedTexture(id, cachedURL);
+  if (!m_database.ClearCachedTexture(id, cachedURL))
+    return false;
+
+  CExclusiveLock indexLock(m_indexSection);
+  m_index.Remove(id);
+  return true;
 }
 
 std::string CTextureCache::GetCacheFile(const std::string &url)
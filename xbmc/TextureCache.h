@@ -21,14 +21,18 @@
 #pragma once
 
 #include <set>
+#include <stdint.h>
 #include <string>
 #include <vector>
 #include "utils/JobManager.h"
 #include "TextureDatabase.h"
+#include "TextureIndex.h"
 #include "threads/Event.h"
+#include "threads/SharedSection.h"
 
 class CURL;
 class CBaseTexture;
+class TestTextureCache;
 
 /*!
  \ingroup textures
@@ -102,6 +106,24 @@ public:
    */
   bool CacheImage(const std::string &image, CTextureDetails &details);
 
+  /*! \brief Resize an image, reusing the result of an earlier identical request.
+
+   The resized image is stored in the cache keyed by the url including the
+   transformation options and is reused for as long as the hash of the
+   original image doesn't change.
+
+   \param image url of the image including the transformation options
+   \param result [out] the resized image, to be freed with delete[]
+   \param result_size [out] size of the resized image
+   \return true if the resized image is available, false otherwise or if the
+   requested width or height exceeds MaxResizedImageSize.
+   \sa CTextureCacheJob::ResizeTexture
+   */
+  bool GetResizedImage(const std::string &image, uint8_t* &result, size_t &result_size);
+
+  //! largest width or height accepted by GetResizedImage()
+  static const unsigned int MaxResizedImageSize = 4096;
+
   /*! \brief Check whether an image is in the cache
    Note: If the image url won't normally be cached (eg a skin image) this function will return false.
    \param image url of the image
@@ -122,6 +144,13 @@ public:
    */
   bool ClearCachedImage(int textureID);
 
+  /*! \brief invalidate the cached version of the given image so that it's checked for updates on next use
+   Thread-safe wrapper of CTextureDatabase::InvalidateCachedTexture
+   \param image url of the image
+   \return true if successful, false otherwise.
+   */
+  bool InvalidateCachedImage(const std::string &image);
+
   /*! \brief retrieve a cache file (relative to the cache path) to associate with the given image, excluding extension
    Use GetCachedPath(GetCacheFile(url)+extension) for the full path to the file.
    \param url location of the image
@@ -158,6 +187,8 @@ public:
   bool Export(const std::string &image, const std::string &destination, bool overwrite);
   bool Export(const std::string &image, const std::string &destination); // TODO: BACKWARD COMPATIBILITY FOR MUSIC THUMBS
 private:
+  friend class ::TestTextureCache;
+
   // private construction, and no assignements; use the provided singleton methods
   CTextureCache();
   CTextureCache(const CTextureCache&);
@@ -179,8 +210,8 @@ private:
    */
   std::string GetCachedImage(const std::string &image, CTextureDetails &details, bool trackUsage = false);
 
-  /*! \brief Get an image from the database
-   Thread-safe wrapper of CTextureDatabase::GetCachedTexture
+  /*! \brief Get an image from the index of cached images
+   Falls back to CTextureDatabase::GetCachedTexture if the index couldn't be loaded.
    \param image url of the original image
    \param details [out] texture details from the database (if available)
    \return true if we have a cached version of this image, false otherwise.
@@ -197,8 +228,8 @@ private:
   bool ClearCachedTexture(int textureID, std::string &cacheFile);
 
   /*! \brief Increment the use count of a texture
-   Stores locally before calling CTextureDatabase::IncrementUseCount via a CUseCountJob
-   \sa CUseCountJob, CTextureDatabase::IncrementUseCount
+   Sums up the uses of each texture locally before calling CTextureDatabase::IncrementUseCount via a CTextureUseCountJob
+   \sa CTextureUseCountJob, CTextureDatabase::IncrementUseCount
    */
   void IncrementUseCount(const CTextureDetails &details);
 
@@ -221,12 +252,20 @@ private:
    */
   void OnCachingComplete(bool success, CTextureCacheJob *job);
 
+  /*! \brief Load the index of cached images from the database
+   Needs m_databaseSection to be locked.
+   */
+  void LoadIndex();
+
   CCriticalSection m_databaseSection;
   CTextureDatabase m_database;
+  CSharedSection   m_indexSection;    ///< locked after m_databaseSection when both are needed
+  CTextureIndex    m_index;           ///< the cached images of m_database
+  bool             m_indexLoaded;
   std::set<std::string> m_processinglist; ///< currently processing list to avoid 2 jobs being processed at once
   CCriticalSection     m_processingSection;
   CEvent               m_completeEvent; ///< Set whenever a job has finished
-  std::vector<CTextureDetails> m_useCounts; ///< Use count tracking
+  TextureUseCounts             m_useCounts; ///< Use count tracking
   CCriticalSection             m_useCountSection;
 };
 
@@ -37,6 +37,7 @@
 #include "cores/omxplayer/OMXImage.h"
 #endif
 
+#include <algorithm>
 #include <string.h>
 
 CTextureCacheJob::CTextureCacheJob(const std::string &url, const std::string &oldHash):
@@ -105,7 +106,12 @@ bool CTextureCacheJob::CacheTexture(CBaseTexture **out_texture)
     return true;
   }
 #endif
-  CBaseTexture *texture = LoadImage(image, width, height, additional_info, true);
+  // decode large images straight to the size they are cached at, which
+  // depends on the size of the original image
+  unsigned int maxHeight = std::max(g_advancedSettings.m_imageRes, g_advancedSettings.m_fanartRes);
+  unsigned int maxWidth = maxHeight * 16 / 9;
+  CBaseTexture *texture = LoadImage(image, width ? std::min(width, maxWidth) : maxWidth,
+                                    height ? std::min(height, maxHeight) : maxHeight, additional_info, true, true);
   if (texture)
   {
     if (texture->HasAlpha())
@@ -194,13 +200,16 @@ std::string CTextureCacheJob::DecodeImageURL(const std::string &url, unsigned in
   return image;
 }
 
-CBaseTexture *CTextureCacheJob::LoadImage(const std::string &image, unsigned int width, unsigned int height, const std::string &additional_info, bool requirePixels)
+CBaseTexture *CTextureCacheJob::LoadImage(const std::string &image, unsigned int width, unsigned int height, const std::string &additional_info,
+                                          bool requirePixels, bool limitToCacheSize)
 {
+  CBaseTexture::LimitSizeFunc limitSize = limitToCacheSize ? CPicture::LimitCacheSize : NULL;
+
   if (additional_info == "music")
   { // special case for embedded music images
     MUSIC_INFO::EmbeddedArt art;
     if (CMusicThumbLoader::GetEmbeddedThumb(image, art))
-      return CBaseTexture::LoadFromFileInMemory(&art.data[0], art.size, art.mime, width, height);
+      return CBaseTexture::LoadFromFileInMemory(&art.data[0], art.size, art.mime, width, height, limitSize);
   }
 
   // Validate file URL to see if it is an image
@@ -210,7 +219,7 @@ CBaseTexture *CTextureCacheJob::LoadImage(const std::string &image, unsigned int
       && !StringUtils::StartsWithNoCase(file.GetMimeType(), "image/") && !StringUtils::EqualsNoCase(file.GetMimeType(), "application/octet-stream")) // ignore non-pictures
     return NULL;
 
-  CBaseTexture *texture = CBaseTexture::LoadFromFile(image, width, height, requirePixels, file.GetMimeType());
+  CBaseTexture *texture = CBaseTexture::LoadFromFile(image, width, height, requirePixels, file.GetMimeType(), limitSize);
   if (!texture)
     return NULL;
 
@@ -283,7 +292,7 @@ bool CTextureDDSJob::DoWork()
   return false;
 }
 
-CTextureUseCountJob::CTextureUseCountJob(const std::vector<CTextureDetails> &textures) : m_textures(textures)
+CTextureUseCountJob::CTextureUseCountJob(const TextureUseCounts &textures) : m_textures(textures)
 {
 }
 
@@ -302,11 +311,14 @@ bool CTextureUseCountJob::DoWork()
 {
   CTextureDatabase db;
   if (db.Open())
-  {
-    db.BeginTransaction();
-    for (std::vector<CTextureDetails>::const_iterator i = m_textures.begin(); i != m_textures.end(); ++i)
-      db.IncrementUseCount(*i);
-    db.CommitTransaction();
-  }
+    StoreUseCounts(db, m_textures);
   return true;
 }
+
+void CTextureUseCountJob::StoreUseCounts(CTextureDatabase &db, const TextureUseCounts &textures)
+{
+  db.BeginTransaction();
+  for (TextureUseCounts::const_iterator i = textures.begin(); i != textures.end(); ++i)
+    db.IncrementUseCount(i->second.first, i->second.second);
+  db.CommitTransaction();
+}
@@ -20,14 +20,17 @@
 
 #pragma once
 
+#include <map>
 #include <stdint.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "pictures/PictureScalingAlgorithm.h"
 #include "utils/Job.h"
 
 class CBaseTexture;
+class CTextureDatabase;
 
 /*!
  \ingroup textures
@@ -81,10 +84,6 @@ public:
 
   static bool ResizeTexture(const std::string &url, uint8_t* &result, size_t &result_size);
 
-  std::string m_url;
-  std::string m_oldHash;
-  CTextureDetails m_details;
-private:
   /*! \brief retrieve a hash for the given image
    Combines the size, ctime and mtime of the image file into a "unique" hash
    \param url location of the image
@@ -92,15 +91,6 @@ private:
    */
   static std::string GetImageHash(const std::string &url);
 
-  /*! \brief Check whether a given URL represents an image that can be updated
-   We currently don't check http:// and https:// URLs for updates, under the assumption that
-   a image URL is much more likely to be static and the actual image at the URL is unlikely
-   to change, so no point checking all the time.
-   \param url the url to check
-   \return true if the image given by the URL should be checked for updates, false otehrwise
-   */
-  bool UpdateableURL(const std::string &url) const;
-
   /*! \brief Decode an image URL to the underlying image, width, height and orientation
    \param url wrapped URL of the image
    \param width width derived from URL
@@ -111,6 +101,19 @@ private:
    */
   static std::string DecodeImageURL(const std::string &url, unsigned int &width, unsigned int &height, CPictureScalingAlgorithm::Algorithm& scalingAlgorithm, std::string &additional_info);
 
+  std::string m_url;
+  std::string m_oldHash;
+  CTextureDetails m_details;
+private:
+  /*! \brief Check whether a given URL represents an image that can be updated
+   We currently don't check http:// and https:// URLs for updates, under the assumption that
+   a image URL is much more likely to be static and the actual image at the URL is unlikely
+   to change, so no point checking all the time.
+   \param url the url to check
+   \return true if the image given by the URL should be checked for updates, false otehrwise
+   */
+  bool UpdateableURL(const std::string &url) const;
+
   /*! \brief Load an image at a given target size and orientation.
 
    Doesn't necessarily load the image at the desired size - the loader *may* decide to load it slightly larger
@@ -120,9 +123,11 @@ private:
    \param width the desired maximum width.
    \param height the desired maximum height.
    \param additional_info extra info for loading, such as whether to flip horizontally.
+   \param limitToCacheSize whether to load the image no larger than it is cached at, see CPicture::LimitCacheSize.
    \return a pointer to a CBaseTexture object, NULL if failed.
    */
-  static CBaseTexture *LoadImage(const std::string &image, unsigned int width, unsigned int height, const std::string &additional_info, bool requirePixels = false);
+  static CBaseTexture *LoadImage(const std::string &image, unsigned int width, unsigned int height, const std::string &additional_info,
+                                 bool requirePixels = false, bool limitToCacheSize = false);
 
   std::string    m_cachePath;
 };
@@ -141,17 +146,28 @@ public:
   std::string m_original;
 };
 
+/*!
+ \brief Uses of textures that haven't been stored yet, keyed by texture id
+ */
+typedef std::map<int, std::pair<CTextureDetails, unsigned int> > TextureUseCounts;
+
 /* \brief Job class for storing the use count of textures
  */
 class CTextureUseCountJob : public CJob
 {
 public:
-  CTextureUseCountJob(const std::vector<CTextureDetails> &textures);
+  CTextureUseCountJob(const TextureUseCounts &textures);
 
   virtual const char* GetType() const { return "usecount"; };
   virtual bool operator==(const CJob *job) const;
   virtual bool DoWork();
 
+  /*! \brief Store the use counts of textures in the texture database
+   \param db the open texture database
+   \param textures the use counts to store
+   */
+  static void StoreUseCounts(CTextureDatabase &db, const TextureUseCounts &textures);
+
 private:
-  std::vector<CTextureDetails> m_textures;
+  TextureUseCounts m_textures;
 };
@@ -19,6 +19,7 @@
  */
 
 #include "TextureDatabase.h"
+#include "TextureIndex.h"
 #include "utils/log.h"
 #include "XBDateTime.h"
 #include "dbwrappers/dataset.h"
@@ -245,9 +246,9 @@ void CTextureDatabase::UpdateTables(int version)
   }
 }
 
-bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
+bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details, unsigned int count /* = 1 */)
 {
-  std::string sql = PrepareSQL("UPDATE sizes SET usecount=usecount+1, lastusetime=CURRENT_TIMESTAMP WHERE idtexture=%u AND width=%u AND height=%u", details.id, details.width, details.height);
+  std::string sql = PrepareSQL("UPDATE sizes SET usecount=usecount+%u, lastusetime=CURRENT_TIMESTAMP WHERE idtexture=%u AND width=%u AND height=%u", count, details.id, details.width, details.height);
   return ExecuteQuery(sql);
 }
 
@@ -282,6 +283,38 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
   return false;
 }
 
+bool CTextureDatabase::GetCachedTextures(CTextureIndex &index)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    std::string sql = "SELECT url, id, cachedurl, lasthashcheck, imagehash, width, height FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1)";
+    m_pDS->query(sql);
+    while (!m_pDS->eof())
+    {
+      CTextureDetails details;
+      details.id = m_pDS->fv(1).get_asInt();
+      details.file = m_pDS->fv(2).get_asString();
+      CDateTime lastCheck;
+      lastCheck.SetFromDBDateTime(m_pDS->fv(3).get_asString());
+      details.hash = m_pDS->fv(4).get_asString();
+      details.width = m_pDS->fv(5).get_asInt();
+      details.height = m_pDS->fv(6).get_asInt();
+      index.Add(m_pDS->fv(0).get_asString(), details, lastCheck);
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed", __FUNCTION__);
+  }
+  return false;
+}
+
 bool CTextureDatabase::GetTextures(CVariant &items, const Filter &filter)
 {
   try
@@ -335,12 +368,12 @@ bool CTextureDatabase::SetCachedTextureValid(const std::string &url, bool update
   return ExecuteQuery(sql);
 }
 
-bool CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDetails &details)
+int CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDetails &details)
 {
   try
   {
-    if (NULL == m_pDB.get()) return false;
-    if (NULL == m_pDS.get()) return false;
+    if (NULL == m_pDB.get()) return -1;
+    if (NULL == m_pDS.get()) return -1;
 
     std::string sql = PrepareSQL("DELETE FROM texture WHERE url='%s'", url.c_str());
     m_pDS->exec(sql);
@@ -353,12 +386,13 @@ bool CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDe
     // set the size information
     sql = PrepareSQL("INSERT INTO sizes (idtexture, size, usecount, lastusetime, width, height) VALUES(%u, 1, 1, CURRENT_TIMESTAMP, %u, %u)", textureID, details.width, details.height);
     m_pDS->exec(sql);
+    return textureID;
   }
   catch (...)
   {
     CLog::Log(LOGERROR, "%s failed on url '%s'", __FUNCTION__, url.c_str());
   }
-  return true;
+  return -1;
 }
 
 bool CTextureDatabase::ClearCachedTexture(const std::string &url, std::string &cacheFile)
@@ -24,6 +24,7 @@
 #include "TextureCacheJob.h"
 #include "dbwrappers/DatabaseQuery.h"
 
+class CTextureIndex;
 class CVariant;
 
 class CTextureRule : public CDatabaseQueryRule
@@ -72,11 +73,24 @@ public:
   virtual bool Open();
 
   bool GetCachedTexture(const std::string &originalURL, CTextureDetails &details);
-  bool AddCachedTexture(const std::string &originalURL, const CTextureDetails &details);
+
+  /*! \brief Get all cached textures
+   \param index [out] index to add the cached textures to
+   \return true if the textures were retrieved, false otherwise
+   \sa GetCachedTexture
+   */
+  bool GetCachedTextures(CTextureIndex &index);
+
+  /*! \brief Add a cached texture, replacing an earlier version
+   \param originalURL url of the original image
+   \param details details of the cached image
+   \return the database id of the texture or -1 if it couldn't be added
+   */
+  int AddCachedTexture(const std::string &originalURL, const CTextureDetails &details);
   bool SetCachedTextureValid(const std::string &originalURL, bool updateable);
   bool ClearCachedTexture(const std::string &originalURL, std::string &cacheFile);
   bool ClearCachedTexture(int textureID, std::string &cacheFile);
-  bool IncrementUseCount(const CTextureDetails &details);
+  bool IncrementUseCount(const CTextureDetails &details, unsigned int count = 1);
 
   /*! \brief Invalidate a previously cached texture
    Invalidates the texture hash, and sets the texture update time to the current time so that
@@ -0,0 +1,125 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TextureIndex.h"
+#include "XBDateTime.h"
+
+// images are checked for updates once a day
+#define HASH_CHECK_INTERVAL (24 * 60 * 60)
+
+CTextureIndex::CTextureIndex() : m_hits(0), m_misses(0)
+{
+}
+
+time_t CTextureIndex::ToTime(const CDateTime &time)
+{
+  time_t result = 0;
+  if (time.IsValid())
+    time.GetAsTime(result);
+  return result;
+}
+
+void CTextureIndex::Add(const std::string &url, const CTextureDetails &details, const CDateTime &lastHashCheck)
+{
+  Entry &entry = m_entries[url];
+  entry.id = details.id;
+  entry.width = details.width;
+  entry.height = details.height;
+  entry.lastHashCheck = ToTime(lastHashCheck);
+  entry.file = details.file;
+  entry.hash = details.hash;
+}
+
+bool CTextureIndex::Get(const std::string &url, CTextureDetails &details) const
+{
+  EntryMap::const_iterator it = m_entries.find(url);
+  if (it == m_entries.end())
+  {
+    m_misses++;
+    return false;
+  }
+  m_hits++;
+
+  const Entry &entry = it->second;
+  details.id = entry.id;
+  details.file = entry.file;
+  details.width = entry.width;
+  details.height = entry.height;
+  if (entry.lastHashCheck != 0 &&
+      entry.lastHashCheck + HASH_CHECK_INTERVAL < ToTime(CDateTime::GetCurrentDateTime()))
+    details.hash = entry.hash;
+  return true;
+}
+
+bool CTextureIndex::SetLastHashCheck(const std::string &url, const CDateTime &lastHashCheck)
+{
+  EntryMap::iterator it = m_entries.find(url);
+  if (it == m_entries.end())
+    return false;
+
+  it->second.lastHashCheck = ToTime(lastHashCheck);
+  return true;
+}
+
+bool CTextureIndex::Remove(const std::string &url)
+{
+  return m_entries.erase(url) > 0;
+}
+
+bool CTextureIndex::Remove(int id)
+{
+  for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+  {
+    if (it->second.id == id)
+    {
+      m_entries.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void CTextureIndex::Clear()
+{
+  m_entries.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
+
+size_t CTextureIndex::GetHeapSize(const std::string &str)
+{
+  // short strings are stored inside the string object
+  const char *data = str.data();
+  if (data >= reinterpret_cast<const char*>(&str) && data < reinterpret_cast<const char*>(&str + 1))
+    return 0;
+  return str.capacity() + 1;
+}
+
+size_t CTextureIndex::GetMemoryUsage() const
+{
+  // every entry is a node holding the next pointer and the hash of the key
+  size_t usage = sizeof(*this) + m_entries.bucket_count() * sizeof(void*);
+  for (EntryMap::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+  {
+    usage += sizeof(EntryMap::value_type) + sizeof(void*) + sizeof(size_t);
+    usage += GetHeapSize(it->first) + GetHeapSize(it->second.file) + GetHeapSize(it->second.hash);
+  }
+  return usage;
+}
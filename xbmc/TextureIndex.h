@@ -0,0 +1,112 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <string>
+#include <time.h>
+#include <unordered_map>
+
+#include "TextureCacheJob.h"
+
+class CDateTime;
+
+/*!
+ \ingroup textures
+ \brief In-memory copy of the cached textures of the texture database.
+
+ Maps the url of each cached image to the details of its cached version so
+ that looking up an image doesn't need a database query. The index is not
+ synchronized, apart from its hit counters, and needs to be locked by the
+ owner.
+
+ \sa CTextureCache, CTextureDatabase::GetCachedTextures
+ */
+class CTextureIndex
+{
+public:
+  CTextureIndex();
+
+  /*! \brief Add a cached image to the index, replacing an earlier version
+   \param url url of the original image
+   \param details details of the cached image
+   \param lastHashCheck time the hash of the image was last checked, invalid if the image isn't checked for updates
+   */
+  void Add(const std::string &url, const CTextureDetails &details, const CDateTime &lastHashCheck);
+
+  /*! \brief Get the details of a cached image
+   The hash of the image is only returned if it is due to be checked, like
+   CTextureDatabase::GetCachedTexture does.
+   \param url url of the original image
+   \param details [out] details of the cached image
+   \return true if the image is cached, false otherwise
+   */
+  bool Get(const std::string &url, CTextureDetails &details) const;
+
+  /*! \brief Set the time the hash of a cached image was last checked
+   \param url url of the original image
+   \param lastHashCheck time of the check, invalid if the image isn't checked for updates
+   \return true if the image is cached, false otherwise
+   */
+  bool SetLastHashCheck(const std::string &url, const CDateTime &lastHashCheck);
+
+  /*! \brief Remove a cached image from the index
+   \param url url of the original image
+   \return true if the image was cached, false otherwise
+   */
+  bool Remove(const std::string &url);
+
+  /*! \brief Remove the cached image with the given database id. Walks the whole index.
+   \param id database id of the image
+   \return true if the image was cached, false otherwise
+   */
+  bool Remove(int id);
+
+  void Clear();
+
+  size_t Size() const { return m_entries.size(); }
+
+  /*! \brief Estimate the memory used by the index, including the strings it stores
+   \return memory usage in bytes
+   */
+  size_t GetMemoryUsage() const;
+
+  unsigned int GetHits() const { return m_hits; }
+  unsigned int GetMisses() const { return m_misses; }
+
+private:
+  struct Entry
+  {
+    int          id;
+    unsigned int width;
+    unsigned int height;
+    time_t       lastHashCheck; ///< 0 if the image isn't checked for updates
+    std::string  file;
+    std::string  hash;
+  };
+  typedef std::unordered_map<std::string, Entry> EntryMap;
+
+  static time_t ToTime(const CDateTime &time);
+  static size_t GetHeapSize(const std::string &str);
+
+  EntryMap m_entries;
+  mutable std::atomic<unsigned int> m_hits;
+  mutable std::atomic<unsigned int> m_misses;
+};
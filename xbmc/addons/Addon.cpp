@@ -688,6 +688,10 @@ void OnDisabled(const std::string& id)
 
   if (CAddonMgr::GetInstance().GetAddon(id, addon, ADDON_CONTEXT_ITEM, false))
     CContextMenuManager::GetInstance().Unregister(std::static_pointer_cast<CContextMenuAddon>(addon));
+
+#ifdef HAS_PYTHON
+  g_pythonParser.ClearInterpreters(id);
+#endif
 }
 
 void OnPreInstall(const AddonPtr& addon)
@@ -701,6 +705,10 @@ void OnPreInstall(const AddonPtr& addon)
   if (CAddonMgr::GetInstance().GetAddon(addon->ID(), localAddon, ADDON_CONTEXT_ITEM))
     CContextMenuManager::GetInstance().Unregister(std::static_pointer_cast<CContextMenuAddon>(localAddon));
 
+#ifdef HAS_PYTHON
+  g_pythonParser.ClearInterpreters(addon->ID());
+#endif
+
   //Fallback to the pre-install callback in the addon.
   //BUG: If primary extension point have changed we're calling the wrong method.
   addon->OnPreInstall();
@@ -730,6 +738,10 @@ void OnPreUnInstall(const AddonPtr& addon)
   if (CAddonMgr::GetInstance().GetAddon(addon->ID(), localAddon, ADDON_CONTEXT_ITEM))
     CContextMenuManager::GetInstance().Unregister(std::static_pointer_cast<CContextMenuAddon>(localAddon));
 
+#ifdef HAS_PYTHON
+  g_pythonParser.ClearInterpreters(addon->ID());
+#endif
+
   addon->OnPreUnInstall();
 }
 
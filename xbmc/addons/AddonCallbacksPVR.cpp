@@ -31,6 +31,7 @@
 #include "pvr/channels/PVRChannelGroupsContainer.h"
 #include "pvr/channels/PVRChannelGroupInternal.h"
 #include "pvr/addons/PVRClient.h"
+#include "pvr/addons/PVRClientFetches.h"
 #include "pvr/recordings/PVRRecordings.h"
 #include "pvr/timers/PVRTimers.h"
 #include "pvr/timers/PVRTimerInfoTag.h"
@@ -90,6 +91,13 @@ void CAddonCallbacksPVR::PVRTransferChannelGroup(void *addonData, const ADDON_HA
     return;
   }
 
+  /* collected to be transferred later on, see CPVRTransferBuffer */
+  if (handle->dataIdentifier == CPVRTransferBuffer::HANDLE_IDENTIFIER && group)
+  {
+    static_cast<CPVRTransferBuffer *>(handle->dataAddress)->Add(addonData, *group);
+    return;
+  }
+
   CPVRChannelGroups *xbmcGroups = static_cast<CPVRChannelGroups *>(handle->dataAddress);
   if (!group || !xbmcGroups)
   {
@@ -115,6 +123,12 @@ void CAddonCallbacksPVR::PVRTransferChannelGroupMember(void *addonData, const AD
     CLog::Log(LOGERROR, "PVR - %s - invalid handler data", __FUNCTION__);
     return;
   }
+
+  if (handle->dataIdentifier == CPVRTransferBuffer::HANDLE_IDENTIFIER && member)
+  {
+    static_cast<CPVRTransferBuffer *>(handle->dataAddress)->Add(addonData, *member);
+    return;
+  }
   
   CPVRClient *client      = GetPVRClient(addonData);
   CPVRChannelGroup *group = static_cast<CPVRChannelGroup *>(handle->dataAddress);
@@ -163,6 +177,12 @@ void CAddonCallbacksPVR::PVRTransferChannelEntry(void *addonData, const ADDON_HA
     return;
   }
 
+  if (handle->dataIdentifier == CPVRTransferBuffer::HANDLE_IDENTIFIER && channel)
+  {
+    static_cast<CPVRTransferBuffer *>(handle->dataAddress)->Add(addonData, *channel);
+    return;
+  }
+
   CPVRClient *client                     = GetPVRClient(addonData);
   CPVRChannelGroupInternal *xbmcChannels = static_cast<CPVRChannelGroupInternal *>(handle->dataAddress);
   if (!channel || !client || !xbmcChannels)
@@ -184,6 +204,12 @@ void CAddonCallbacksPVR::PVRTransferRecordingEntry(void *addonData, const ADDON_
     return;
   }
 
+  if (handle->dataIdentifier == CPVRTransferBuffer::HANDLE_IDENTIFIER && recording)
+  {
+    static_cast<CPVRTransferBuffer *>(handle->dataAddress)->Add(addonData, *recording);
+    return;
+  }
+
   CPVRClient *client             = GetPVRClient(addonData);
   CPVRRecordings *xbmcRecordings = static_cast<CPVRRecordings *>(handle->dataAddress);
   if (!recording || !client || !xbmcRecordings)
@@ -205,6 +231,12 @@ void CAddonCallbacksPVR::PVRTransferTimerEntry(void *addonData, const ADDON_HAND
     return;
   }
 
+  if (handle->dataIdentifier == CPVRTransferBuffer::HANDLE_IDENTIFIER && timer)
+  {
+    static_cast<CPVRTransferBuffer *>(handle->dataAddress)->Add(addonData, *timer);
+    return;
+  }
+
   CPVRClient *client     = GetPVRClient(addonData);
   CPVRTimers *xbmcTimers = static_cast<CPVRTimers *>(handle->dataAddress);
   if (!timer || !client || !xbmcTimers)
@@ -29,17 +29,23 @@ namespace ADDON
 {
 
 CPluginSource::CPluginSource(const AddonProps &props)
-  : CAddon(props)
+  : CAddon(props),
+    m_reentrant(false)
 {
   std::string provides;
   InfoMap::const_iterator i = Props().extrainfo.find("provides");
   if (i != Props().extrainfo.end())
     provides = i->second;
   SetProvides(provides);
+
+  i = Props().extrainfo.find("reentrant");
+  if (i != Props().extrainfo.end())
+    m_reentrant = i->second == "true";
 }
 
 CPluginSource::CPluginSource(const cp_extension_t *ext)
-  : CAddon(ext)
+  : CAddon(ext),
+    m_reentrant(false)
 {
   std::string provides;
   if (ext)
@@ -47,6 +53,10 @@ CPluginSource::CPluginSource(const cp_extension_t *ext)
     provides = CAddonMgr::GetInstance().GetExtValue(ext->configuration, "provides");
     if (!provides.empty())
       Props().extrainfo.insert(make_pair("provides", provides));
+
+    m_reentrant = CAddonMgr::GetInstance().GetExtValue(ext->configuration, "@reentrant") == "true";
+    if (m_reentrant)
+      Props().extrainfo.insert(std::make_pair("reentrant", "true"));
   }
   SetProvides(provides);
 }
@@ -46,6 +46,12 @@ public:
     return m_providedContent.size() > 1;
   }
 
+  /*! \brief Whether the plugin can be run repeatedly in the same interpreter
+   Reentrant plugins don't rely on a fresh interpreter for every invocation
+   so their interpreter (including the imported modules) can be kept warm.
+   */
+  bool IsReentrant() const { return m_reentrant; }
+
   static Content Translate(const std::string &content);
 private:
   /*! \brief Set the provided content for this plugin
@@ -54,6 +60,7 @@ private:
    */
   void SetProvides(const std::string &content);
   std::set<Content> m_providedContent;
+  bool m_reentrant;
 };
 
 } /*namespace ADDON*/
@@ -38,7 +38,7 @@
 #include "filesystem/ZipFile.h"
 #include "messaging/helpers/DialogHelper.h"
 #include "settings/Settings.h"
-#include "TextureDatabase.h"
+#include "TextureCache.h"
 #include "URL.h"
 #include "utils/JobManager.h"
 #include "utils/log.h"
@@ -256,25 +256,18 @@ bool CRepositoryUpdateJob::DoWork()
   }
 
   //Invalidate art.
+  for (const auto& addon : addons)
   {
-    CTextureDatabase textureDB;
-    textureDB.Open();
-    textureDB.BeginMultipleExecute();
-
-    for (const auto& addon : addons)
+    AddonPtr oldAddon;
+    if (database.GetAddon(addon->ID(), oldAddon) && addon->Version() > oldAddon->Version())
     {
-      AddonPtr oldAddon;
-      if (database.GetAddon(addon->ID(), oldAddon) && addon->Version() > oldAddon->Version())
-      {
-        if (!addon->Props().icon.empty() || !addon->Props().fanart.empty())
-          CLog::Log(LOGDEBUG, "CRepository: invalidating cached art for '%s'", addon->ID().c_str());
-        if (!addon->Props().icon.empty())
-          textureDB.InvalidateCachedTexture(addon->Props().icon);
-        if (!addon->Props().fanart.empty())
-          textureDB.InvalidateCachedTexture(addon->Props().fanart);
-      }
+      if (!addon->Props().icon.empty() || !addon->Props().fanart.empty())
+        CLog::Log(LOGDEBUG, "CRepository: invalidating cached art for '%s'", addon->ID().c_str());
+      if (!addon->Props().icon.empty())
+        CTextureCache::GetInstance().InvalidateCachedImage(addon->Props().icon);
+      if (!addon->Props().fanart.empty())
+        CTextureCache::GetInstance().InvalidateCachedImage(addon->Props().fanart);
     }
-    textureDB.CommitMultipleExecute();
   }
 
   database.AddRepository(m_repo->ID(), addons, newChecksum, m_repo->Version());
@@ -36,6 +36,7 @@ struct TextCacheStruct_t;
 class TiXmlElement;
 class CStreamDetails;
 class CAction;
+class CVariant;
 
 namespace PVR
 {
@@ -429,6 +430,14 @@ public:
 
   virtual std::string GetRenderVSyncState() { return ""; };
 
+  /*!
+   \brief Get decode, queue and presentation timing and drop counters of the video stream.
+   \param stats filled with the statistics.
+   \param reset start collecting anew after reading.
+   \return false if the player doesn't collect frame statistics.
+   */
+  virtual bool GetFrameStats(CVariant &stats, bool reset = false) { return false; };
+
   std::string m_name;
   std::string m_type;
 
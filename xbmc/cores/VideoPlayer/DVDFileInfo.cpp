@@ -18,10 +18,12 @@
  *
  */
 
-#include <string>
+#include <algorithm>
 #include <cstdlib>
+#include <string>
 #include "threads/SystemClock.h"
 #include "DVDFileInfo.h"
+#include "DVDMediaProbe.h"
 #include "FileItem.h"
 #include "settings/AdvancedSettings.h"
 #include "pictures/Picture.h"
@@ -94,12 +96,122 @@ int DegreeToOrientation(int degrees)
   }
 }
 
+// Stores the total time of a probe when it returns, on the error paths too
+class CProbeTimer
+{
+public:
+  explicit CProbeTimer(MediaProbeTiming *timing)
+    : m_timing(timing), m_start(XbmcThreads::SystemClockMillis()) {}
+  ~CProbeTimer() { Stop(); }
+
+  unsigned int GetStart() const { return m_start; }
+  unsigned int Stop()
+  {
+    unsigned int elapsed = XbmcThreads::SystemClockMillis() - m_start;
+    if (m_timing)
+      m_timing->total = elapsed;
+    return elapsed;
+  }
+
+private:
+  MediaProbeTiming *m_timing;
+  unsigned int m_start;
+};
+
+// Get the time in ms of the keyframe at or before the given time from the seek
+// index of the container, -1 if the demuxer has no index for the stream
+static int GetIndexedKeyframeTime(CDVDDemux *pDemuxer, int nVideoStream, int time)
+{
+  CDVDDemuxFFmpeg *pDemuxFFmpeg = dynamic_cast<CDVDDemuxFFmpeg*>(pDemuxer);
+  CDemuxStream *pStream = pDemuxer->GetStream(nVideoStream);
+  if (!pDemuxFFmpeg || !pDemuxFFmpeg->m_pFormatContext || !pStream || !pStream->pPrivate)
+    return -1;
+
+  AVStream *st = static_cast<AVStream*>(pStream->pPrivate);
+  if (st->nb_index_entries <= 0 || st->time_base.num <= 0 || st->time_base.den <= 0)
+    return -1;
+
+  AVRational timeBase = { 1, AV_TIME_BASE };
+  AVRational msec = { 1, 1000 };
+  int64_t start = pDemuxFFmpeg->m_pFormatContext->start_time;
+  if (start == (int64_t)AV_NOPTS_VALUE)
+    start = 0;
+  int64_t timestamp = av_rescale_q((int64_t)time * (AV_TIME_BASE / 1000) + start, timeBase, st->time_base);
+  int index = av_index_search_timestamp(st, timestamp, AVSEEK_FLAG_BACKWARD);
+  if (index < 0)
+    return -1;
+
+  // round up so that a backward seek to the result lands on this keyframe
+  int64_t keyframe = av_rescale_q_rnd(st->index_entries[index].timestamp, st->time_base, timeBase, AV_ROUND_UP) - start;
+  return (int)av_rescale_q_rnd(std::max(keyframe, (int64_t)0), timeBase, msec, AV_ROUND_UP);
+}
+
+// Read and decode packets of the given stream until a picture is returned
+static bool DecodePicture(CDVDDemux *pDemuxer, CDVDVideoCodec *pVideoCodec, int nVideoStream,
+                          DVDVideoPicture &picture, int &packetsTried)
+{
+  int iDecoderState = VC_ERROR;
+
+  memset(&picture, 0, sizeof(picture));
+
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  int abort_index = pDemuxer->GetNrOfStreams() * 160;
+  do
+  {
+    DemuxPacket* pPacket = pDemuxer->Read();
+    packetsTried++;
+
+    if (!pPacket)
+      break;
+
+    if (pPacket->iStreamId != nVideoStream)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    iDecoderState = pVideoCodec->Decode(pPacket->pData, pPacket->iSize, pPacket->dts, pPacket->pts);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+
+    if (iDecoderState & VC_ERROR)
+      break;
+
+    if (iDecoderState & VC_PICTURE)
+    {
+      memset(&picture, 0, sizeof(DVDVideoPicture));
+      if (pVideoCodec->GetPicture(&picture))
+      {
+        if(!(picture.iFlags & DVP_FLAG_DROPPED))
+          break;
+      }
+    }
+
+  } while (abort_index--);
+
+  return (iDecoderState & VC_PICTURE) && !(picture.iFlags & DVP_FLAG_DROPPED);
+}
+
 bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
                                 CTextureDetails &details,
-                                CStreamDetails *pStreamDetails, int pos)
+                                CStreamDetails *pStreamDetails, int pos,
+                                CDVDMediaProbeContext *context,
+                                MediaProbeTiming *timing)
 {
   std::string redactPath = CURL::GetRedacted(strPath);
-  unsigned int nTime = XbmcThreads::SystemClockMillis();
+  MediaProbeTiming localTiming;
+  if (!timing)
+    timing = &localTiming;
+  CProbeTimer timer(timing);
+  unsigned int nStepTime = timer.GetStart();
+
+  // without a context from the caller use a temporary one for this file only
+  std::unique_ptr<CDVDMediaProbeContext> localContext;
+  if (!context)
+  {
+    localContext.reset(new CDVDMediaProbeContext());
+    context = localContext.get();
+  }
+
   CFileItem item(strPath, false);
   CDVDInputStream *pInputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
   if (!pInputStream)
@@ -151,6 +263,8 @@ bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
     return false;
   }
 
+  timing->open = XbmcThreads::SystemClockMillis() - nStepTime;
+
   if (pStreamDetails)
   {
     DemuxerToStreamDetails(pInputStream, pDemuxer, *pStreamDetails, strPath);
@@ -203,107 +317,86 @@ bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
 
   if (nVideoStream != -1)
   {
-    CDVDVideoCodec *pVideoCodec;
-
     CDVDStreamInfo hint(*pDemuxer->GetStream(nVideoStream), true);
     hint.software = true;
 
-    if (hint.codec == AV_CODEC_ID_MPEG2VIDEO || hint.codec == AV_CODEC_ID_MPEG1VIDEO)
-    {
-      // libmpeg2 is not thread safe so use ffmepg for mpeg2/mpeg1 thumb extraction
-      CDVDCodecOptions dvdOptions;
-      pVideoCodec = CDVDFactoryCodec::OpenCodec(new CDVDVideoCodecFFmpeg(), hint, dvdOptions);
-    }
-    else
-    {
-      pVideoCodec = CDVDFactoryCodec::CreateVideoCodec( hint );
-    }
-
+    // keyframe-only ffmpeg decoder, owned by the context
+    CDVDVideoCodec *pVideoCodec = context->GetVideoCodec(hint);
     if (pVideoCodec)
     {
       int nTotalLen = pDemuxer->GetStreamLength();
       int nSeekTo = (pos==-1?nTotalLen / 3:pos);
 
-      CLog::Log(LOGDEBUG,"%s - seeking to pos %dms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
-      if (pDemuxer->SeekTime(nSeekTo, true))
+      // seek straight to a keyframe from the index of the container where it
+      // has one. Otherwise only seek when the container knows its length,
+      // else we'd have the demuxer scan the file and are better off decoding
+      // from the start
+      bool bSeekOk = true;
+      nStepTime = XbmcThreads::SystemClockMillis();
+      int nKeyframe = (nTotalLen > 0 || pos != -1) ? GetIndexedKeyframeTime(pDemuxer, nVideoStream, nSeekTo) : -1;
+      if (nKeyframe >= 0)
       {
-        int iDecoderState = VC_ERROR;
-        DVDVideoPicture picture;
+        CLog::Log(LOGDEBUG,"%s - seeking to indexed keyframe at %dms for pos %dms (total: %dms) in %s", __FUNCTION__, nKeyframe, nSeekTo, nTotalLen, redactPath.c_str());
+        nSeekTo = nKeyframe;
+        bSeekOk = pDemuxer->SeekTime(nSeekTo, true);
+      }
+      else if (nTotalLen > 0 || pos != -1)
+      {
+        CLog::Log(LOGDEBUG,"%s - seeking to pos %dms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
+        bSeekOk = pDemuxer->SeekTime(nSeekTo, true);
+      }
+      timing->seek = XbmcThreads::SystemClockMillis() - nStepTime;
 
-        memset(&picture, 0, sizeof(picture));
+      if (bSeekOk)
+      {
+        DVDVideoPicture picture;
 
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
+        nStepTime = XbmcThreads::SystemClockMillis();
+        bool bPicture = DecodePicture(pDemuxer, pVideoCodec, nVideoStream, picture, packetsTried);
+        if (!bPicture && pDemuxer->SeekTime(nSeekTo, true))
         {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
-
-          if (!pPacket)
-            break;
-
-          if (pPacket->iStreamId != nVideoStream)
-          {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
-
-          iDecoderState = pVideoCodec->Decode(pPacket->pData, pPacket->iSize, pPacket->dts, pPacket->pts);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-
-          if (iDecoderState & VC_ERROR)
-            break;
-
-          if (iDecoderState & VC_PICTURE)
-          {
-            memset(&picture, 0, sizeof(DVDVideoPicture));
-            if (pVideoCodec->GetPicture(&picture))
-            {
-              if(!(picture.iFlags & DVP_FLAG_DROPPED))
-                break;
-            }
-          }
-
-        } while (abort_index--);
+          // some streams (e.g. broadcast h264) only carry recovery points,
+          // retry without skipping non-key frames
+          CLog::Log(LOGDEBUG,"%s - no keyframe found in %s, decoding all frames", __FUNCTION__, redactPath.c_str());
+          context->DecodeAllFrames();
+          bPicture = DecodePicture(pDemuxer, pVideoCodec, nVideoStream, picture, packetsTried);
+        }
+        timing->decode = XbmcThreads::SystemClockMillis() - nStepTime;
 
-        if (iDecoderState & VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
+        if (bPicture)
         {
+          nStepTime = XbmcThreads::SystemClockMillis();
+          unsigned int nWidth = g_advancedSettings.GetThumbSize();
+          double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+          if(hint.forced_aspect && hint.aspect != 0)
+            aspect = hint.aspect;
+          unsigned int nHeight = (unsigned int)((double)g_advancedSettings.GetThumbSize() / aspect);
+
+          struct SwsContext *scaler = context->GetScaler(picture.iWidth, picture.iHeight, nWidth, nHeight);
+          if (scaler)
           {
-            unsigned int nWidth = g_advancedSettings.GetThumbSize();
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)g_advancedSettings.GetThumbSize() / aspect);
-
             uint8_t *pOutBuf = new uint8_t[nWidth * nHeight * 4];
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *src[] = { picture.data[0], picture.data[1], picture.data[2], 0 };
-              int     srcStride[] = { picture.iLineSize[0], picture.iLineSize[1], picture.iLineSize[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int     dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
+            uint8_t *src[] = { picture.data[0], picture.data[1], picture.data[2], 0 };
+            int     srcStride[] = { picture.iLineSize[0], picture.iLineSize[1], picture.iLineSize[2], 0 };
+            uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
+            int     dstStride[] = { (int)nWidth*4, 0, 0, 0 };
+            int orientation = DegreeToOrientation(hint.orientation);
+            sws_scale(scaler, src, srcStride, 0, picture.iHeight, dst, dstStride);
+
+            details.width = nWidth;
+            details.height = nHeight;
+            CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
+            bOk = true;
 
             delete [] pOutBuf;
           }
+          timing->scale = XbmcThreads::SystemClockMillis() - nStepTime;
         }
         else
         {
           CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
         }
       }
-      delete pVideoCodec;
     }
   }
 
@@ -319,8 +412,8 @@ bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
       file.Close();
   }
 
-  unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
-  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, redactPath.c_str(), packetsTried);
+  timing->packets = packetsTried;
+  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, timer.Stop(), redactPath.c_str(), packetsTried);
   return bOk;
 }
 
@@ -328,11 +421,13 @@ bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
  * \brief Open the item pointed to by pItem and extact streamdetails
  * \return true if the stream details have changed
  */
-bool CDVDFileInfo::GetFileStreamDetails(CFileItem *pItem)
+bool CDVDFileInfo::GetFileStreamDetails(CFileItem *pItem, MediaProbeTiming *timing)
 {
   if (!pItem)
     return false;
 
+  CProbeTimer timer(timing);
+
   std::string strFileNameAndPath;
   if (pItem->HasVideoInfoTag())
     strFileNameAndPath = pItem->GetVideoInfoTag()->m_strFileNameAndPath;
@@ -362,6 +457,9 @@ bool CDVDFileInfo::GetFileStreamDetails(CFileItem *pItem)
   }
 
   CDVDDemux *pDemuxer = CDVDFactoryDemuxer::CreateDemuxer(pInputStream, true);
+  if (timing)
+    timing->open = XbmcThreads::SystemClockMillis() - timer.GetStart();
+
   if (pDemuxer)
   {
     bool retVal = DemuxerToStreamDetails(pInputStream, pDemuxer, pItem->GetVideoInfoTag()->m_streamDetails, strFileNameAndPath);
@@ -28,18 +28,23 @@ class CDVDDemux;
 class CStreamDetails;
 class CStreamDetailSubtitle;
 class CDVDInputStream;
+class CDVDMediaProbeContext;
 class CTextureDetails;
+struct MediaProbeTiming;
 
 class CDVDFileInfo
 {
 public:
   // Extract a thumbnail immage from the media at strPath, optionally populating a streamdetails class with the data
+  // If a context is given its decoder and scaler are reused, else temporary ones are created
   static bool ExtractThumb(const std::string &strPath,
                            CTextureDetails &details,
-                           CStreamDetails *pStreamDetails, int pos=-1);
+                           CStreamDetails *pStreamDetails, int pos=-1,
+                           CDVDMediaProbeContext *context = NULL,
+                           MediaProbeTiming *timing = NULL);
 
   // Probe the files streams and store the info in the VideoInfoTag
-  static bool GetFileStreamDetails(CFileItem *pItem);
+  static bool GetFileStreamDetails(CFileItem *pItem, MediaProbeTiming *timing = NULL);
   static bool DemuxerToStreamDetails(CDVDInputStream* pInputStream, CDVDDemux *pDemux, CStreamDetails &details, const std::string &path = "");
 
   /** \brief Probe the file's internal and external streams and store the info in the StreamDetails parameter.
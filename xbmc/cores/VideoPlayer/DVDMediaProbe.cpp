@@ -0,0 +1,227 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DVDMediaProbe.h"
+
+#include <algorithm>
+
+#include "DVDFileInfo.h"
+#include "DVDCodecs/DVDCodecs.h"
+#include "DVDCodecs/DVDFactoryCodec.h"
+#include "DVDCodecs/Video/DVDVideoCodecFFmpeg.h"
+#include "FileItem.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "URL.h"
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+
+extern "C" {
+#include "libswscale/swscale.h"
+}
+
+#define MEDIAPROBE_MAX_WORKERS 4
+
+CDVDMediaProbeContext::CDVDMediaProbeContext() :
+  m_codec(NULL),
+  m_codecReusable(false),
+  m_scaler(NULL)
+{
+}
+
+CDVDMediaProbeContext::~CDVDMediaProbeContext()
+{
+  Reset();
+}
+
+CDVDVideoCodec* CDVDMediaProbeContext::GetVideoCodec(CDVDStreamInfo &hint)
+{
+  if (m_codec && m_codecReusable && m_codecHint.Equal(hint, true))
+  {
+    m_codec->Reset();
+    return m_codec;
+  }
+
+  if (m_codec)
+  {
+    m_codec->Dispose();
+    delete m_codec;
+    m_codec = NULL;
+  }
+
+  // always use ffmpeg, libmpeg2 and hardware decoders are not thread safe
+  // and we only ever want the few keyframes around the extraction point
+  CDVDCodecOptions options;
+  options.m_keys.push_back(CDVDCodecOption("skip_frame", "nokey"));
+  m_codec = CDVDFactoryCodec::OpenCodec(new CDVDVideoCodecFFmpeg(), hint, options);
+  m_codecHint = hint;
+  m_codecReusable = true;
+  return m_codec;
+}
+
+void CDVDMediaProbeContext::DecodeAllFrames()
+{
+  if (!m_codec)
+    return;
+
+  m_codec->SetDropState(false);
+  m_codec->Reset();
+  m_codecReusable = false;
+}
+
+SwsContext* CDVDMediaProbeContext::GetScaler(int srcWidth, int srcHeight, int dstWidth, int dstHeight)
+{
+  // returns the passed in context if the parameters are unchanged
+  m_scaler = sws_getCachedContext(m_scaler, srcWidth, srcHeight, AV_PIX_FMT_YUV420P,
+                                  dstWidth, dstHeight, AV_PIX_FMT_BGRA,
+                                  SWS_FAST_BILINEAR, NULL, NULL, NULL);
+  return m_scaler;
+}
+
+void CDVDMediaProbeContext::Reset()
+{
+  if (m_codec)
+  {
+    m_codec->Dispose();
+    delete m_codec;
+    m_codec = NULL;
+  }
+  m_codecReusable = false;
+
+  if (m_scaler)
+  {
+    sws_freeContext(m_scaler);
+    m_scaler = NULL;
+  }
+}
+
+CDVDMediaProbe::CDVDMediaProbe() :
+  m_users(0),
+  m_probed(0),
+  m_failed(0),
+  m_totalTime(0)
+{
+}
+
+CDVDMediaProbe::~CDVDMediaProbe()
+{
+  for (std::vector<CDVDMediaProbeContext*>::iterator it = m_idle.begin(); it != m_idle.end(); ++it)
+    delete *it;
+}
+
+CDVDMediaProbe& CDVDMediaProbe::GetInstance()
+{
+  static CDVDMediaProbe sMediaProbe;
+  return sMediaProbe;
+}
+
+unsigned int CDVDMediaProbe::GetMaxWorkers() const
+{
+  int cpus = g_cpuInfo.getCPUCount();
+  return std::max(1, std::min(cpus, MEDIAPROBE_MAX_WORKERS));
+}
+
+CDVDMediaProbeContext* CDVDMediaProbe::AcquireContext()
+{
+  CSingleLock lock(m_critSection);
+  if (!m_idle.empty())
+  {
+    CDVDMediaProbeContext *context = m_idle.back();
+    m_idle.pop_back();
+    return context;
+  }
+  return new CDVDMediaProbeContext();
+}
+
+void CDVDMediaProbe::ReleaseContext(CDVDMediaProbeContext *context)
+{
+  if (!context)
+    return;
+
+  CSingleLock lock(m_critSection);
+  // nobody is going to reuse it, or we already hold as many
+  // decoders as we can use in parallel
+  if (m_users == 0 || m_idle.size() >= GetMaxWorkers())
+  {
+    lock.Leave();
+    delete context;
+    return;
+  }
+  m_idle.push_back(context);
+}
+
+void CDVDMediaProbe::AddUser()
+{
+  CSingleLock lock(m_critSection);
+  m_users++;
+}
+
+void CDVDMediaProbe::RemoveUser()
+{
+  std::vector<CDVDMediaProbeContext*> idle;
+  {
+    CSingleLock lock(m_critSection);
+    if (m_users > 0)
+      m_users--;
+    if (m_users > 0)
+      return;
+
+    idle.swap(m_idle);
+    if (m_probed > 0)
+      CLog::Log(LOGDEBUG, "CDVDMediaProbe: %u files probed (%u failed), average %u ms per file",
+                m_probed, m_failed, (unsigned int)(m_totalTime / m_probed));
+  }
+
+  for (std::vector<CDVDMediaProbeContext*>::iterator it = idle.begin(); it != idle.end(); ++it)
+    delete *it;
+}
+
+bool CDVDMediaProbe::ExtractThumb(const std::string &path, CTextureDetails &details, CStreamDetails *streamDetails, int pos)
+{
+  MediaProbeTiming timing;
+  CDVDMediaProbeContext *context = AcquireContext();
+  bool result = CDVDFileInfo::ExtractThumb(path, details, streamDetails, pos, context, &timing);
+  ReleaseContext(context);
+
+  AddTiming(path, timing, result);
+  return result;
+}
+
+bool CDVDMediaProbe::GetFileStreamDetails(CFileItem *item)
+{
+  MediaProbeTiming timing;
+  bool result = CDVDFileInfo::GetFileStreamDetails(item, &timing);
+
+  AddTiming(item ? item->GetPath() : "", timing, result);
+  return result;
+}
+
+void CDVDMediaProbe::AddTiming(const std::string &path, const MediaProbeTiming &timing, bool success)
+{
+  CLog::Log(LOGDEBUG, "CDVDMediaProbe: %s in %u ms (open %u, seek %u, decode %u, scale %u, %d packets) for %s",
+            success ? "probed" : "failed", timing.total, timing.open, timing.seek,
+            timing.decode, timing.scale, timing.packets, CURL::GetRedacted(path).c_str());
+
+  CSingleLock lock(m_critSection);
+  m_probed++;
+  if (!success)
+    m_failed++;
+  m_totalTime += timing.total;
+}
@@ -0,0 +1,182 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "DVDStreamInfo.h"
+#include "threads/CriticalSection.h"
+
+class CDVDVideoCodec;
+class CFileItem;
+class CStreamDetails;
+class CTextureDetails;
+struct SwsContext;
+
+/*!
+ \brief Timing breakdown of a single probe, all values in milliseconds.
+ */
+struct MediaProbeTiming
+{
+  MediaProbeTiming() : open(0), seek(0), decode(0), scale(0), total(0), packets(0) {}
+
+  unsigned int open;   ///< creating and opening input stream and demuxer
+  unsigned int seek;   ///< seeking to the extraction point
+  unsigned int decode; ///< reading packets until a picture is available
+  unsigned int scale;  ///< scaling and writing the thumb
+  unsigned int total;
+  int packets;         ///< number of packets read from the demuxer
+};
+
+/*!
+ \brief Decoder and scaler state kept between probes.
+
+ Files in a listing mostly share codec and frame size, so the software video
+ decoder is flushed and reused when the stream hints match, and the swscale
+ context is recycled via sws_getCachedContext. Decoders are opened in
+ keyframe-only mode.
+
+ A context is not thread safe and must only be used by one probe at a time,
+ see CDVDMediaProbe::AcquireContext().
+ */
+class CDVDMediaProbeContext
+{
+public:
+  CDVDMediaProbeContext();
+  ~CDVDMediaProbeContext();
+
+  /*!
+   \brief Get a keyframe-only software decoder for the given stream.
+   \param hint the stream to decode.
+   \return the decoder, owned by the context. NULL if it could not be opened.
+   */
+  CDVDVideoCodec* GetVideoCodec(CDVDStreamInfo &hint);
+
+  /*!
+   \brief Switch the current decoder to decode all frames.
+
+   Used as fallback for streams without flagged keyframes. The decoder is
+   closed after the probe instead of being reused.
+   */
+  void DecodeAllFrames();
+
+  /*!
+   \brief Get a scaler converting yuv420p pictures to BGRA of the given size.
+   \return the scaler, owned by the context. NULL on failure.
+   */
+  SwsContext* GetScaler(int srcWidth, int srcHeight, int dstWidth, int dstHeight);
+
+  /*!
+   \brief Free decoder and scaler.
+   */
+  void Reset();
+
+private:
+  CDVDMediaProbeContext(const CDVDMediaProbeContext&);
+  CDVDMediaProbeContext& operator=(const CDVDMediaProbeContext&);
+
+  CDVDVideoCodec *m_codec;
+  CDVDStreamInfo m_codecHint;
+  bool m_codecReusable;
+  SwsContext *m_scaler;
+};
+
+/*!
+ \brief Media probe service used for thumb and stream details extraction.
+
+ Keeps a pool of CDVDMediaProbeContext instances so that concurrent probes
+ each get their own decoder and scaler, and these survive from one file to
+ the next. Every probe is timed; the breakdown is logged per file and
+ accumulated for the lifetime of the service.
+ */
+class CDVDMediaProbe
+{
+  friend class TestDVDMediaProbe;
+
+public:
+  static CDVDMediaProbe& GetInstance();
+
+  /*!
+   \brief Number of probes that may usefully run in parallel.
+   */
+  unsigned int GetMaxWorkers() const;
+
+  /*!
+   \brief Take a context from the pool, creating one if none is idle.
+   \sa ReleaseContext
+   */
+  CDVDMediaProbeContext* AcquireContext();
+
+  /*!
+   \brief Return a context to the pool.
+
+   The context is freed instead if the pool has no users or already holds
+   as many contexts as can be used in parallel.
+   \sa AcquireContext
+   */
+  void ReleaseContext(CDVDMediaProbeContext *context);
+
+  /*!
+   \brief Register a user of the pool, e.g. a thumb loader with pending extractions.
+
+   Idle contexts are kept for reuse as long as the pool has users.
+   \sa RemoveUser
+   */
+  void AddUser();
+
+  /*!
+   \brief Unregister a user of the pool.
+
+   Once the last user is gone the decoders and scalers of the idle contexts
+   are freed. Contexts of probes still running are freed when released.
+   \sa AddUser
+   */
+  void RemoveUser();
+
+  /*!
+   \brief Extract a thumb using a pooled context.
+   \sa CDVDFileInfo::ExtractThumb
+   */
+  bool ExtractThumb(const std::string &path, CTextureDetails &details, CStreamDetails *streamDetails, int pos = -1);
+
+  /*!
+   \brief Extract stream details, timing the probe.
+   \sa CDVDFileInfo::GetFileStreamDetails
+   */
+  bool GetFileStreamDetails(CFileItem *item);
+
+private:
+  CDVDMediaProbe();
+  ~CDVDMediaProbe();
+  CDVDMediaProbe(const CDVDMediaProbe&);
+  CDVDMediaProbe& operator=(const CDVDMediaProbe&);
+
+  void AddTiming(const std::string &path, const MediaProbeTiming &timing, bool success);
+
+  CCriticalSection m_critSection;
+  std::vector<CDVDMediaProbeContext*> m_idle;
+  unsigned int m_users;         ///< number of users keeping idle contexts around
+  unsigned int m_probed;
+  unsigned int m_failed;
+  uint64_t m_totalTime;
+};
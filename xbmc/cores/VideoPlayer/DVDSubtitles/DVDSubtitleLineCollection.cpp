@@ -19,16 +19,15 @@
  */
 
 #include "DVDSubtitleLineCollection.h"
-#include <stddef.h>
+
+#include <algorithm>
 
 
 CDVDSubtitleLineCollection::CDVDSubtitleLineCollection()
 {
-  m_pHead = NULL;
-  m_pCurrent = NULL;
-  m_pTail = NULL;
-
-  m_iSize = 0;
+  m_current = 0;
+  m_sorted = true;
+  m_seek = true;
 }
 
 CDVDSubtitleLineCollection::~CDVDSubtitleLineCollection()
@@ -38,85 +37,77 @@ CDVDSubtitleLineCollection::~CDVDSubtitleLineCollection()
 
 void CDVDSubtitleLineCollection::Add(CDVDOverlay* pOverlay)
 {
-  ListElement* pElement = new ListElement;
-  pElement->pOverlay = pOverlay;
-  pElement->pNext = NULL;
+  if (!m_overlays.empty() && pOverlay->iPTSStartTime < m_overlays.back()->iPTSStartTime)
+    m_sorted = false;
 
-  if (!m_pHead)
-  {
-    m_pHead = m_pTail = pElement;
-    m_pCurrent = m_pHead;
-  }
-  else
+  m_overlays.push_back(pOverlay);
+}
+
+void CDVDSubtitleLineCollection::Sort()
+{
+  if (!m_sorted)
   {
-    m_pTail->pNext = pElement;
-    m_pTail = pElement;
+    // keep file order for cues starting at the same time
+    std::stable_sort(m_overlays.begin(), m_overlays.end(),
+      [](const CDVDOverlay* a, const CDVDOverlay* b) { return a->iPTSStartTime < b->iPTSStartTime; });
+    m_sorted = true;
   }
-
-  m_iSize++;
+  BuildIndex();
 }
 
-void CDVDSubtitleLineCollection::Sort()
+void CDVDSubtitleLineCollection::BuildIndex()
 {
-  if (!m_pHead || !m_pHead->pNext)
-    return;
-  
-  for (ListElement* p1 = m_pHead; p1->pNext != NULL; p1 = p1->pNext)
+  m_maxStopTime.resize(m_overlays.size());
+
+  double maxStopTime = 0.0;
+  for (size_t i = 0; i < m_overlays.size(); i++)
   {
-    for (ListElement* p2 = p1->pNext; p2 != NULL; p2 = p2->pNext)
-    {
-      if (p1->pOverlay->iPTSStartTime > p2->pOverlay->iPTSStartTime)
-      {
-        CDVDOverlay* temp = p1->pOverlay;
-        p1->pOverlay = p2->pOverlay;
-        p2->pOverlay = temp;
-      }
-    }
+    maxStopTime = std::max(maxStopTime, m_overlays[i]->iPTSStopTime);
+    m_maxStopTime[i] = maxStopTime;
   }
+  m_seek = true;
 }
 
 CDVDOverlay* CDVDSubtitleLineCollection::Get(double iPts)
 {
-  CDVDOverlay* pOverlay = NULL;
+  if (!m_sorted || m_maxStopTime.size() != m_overlays.size())
+    Sort();
 
-  if (m_pCurrent)
+  // everything before the first entry whose running maximum stop time
+  // reaches iPts has ended already
+  if (m_seek)
   {
-    while (m_pCurrent && m_pCurrent->pOverlay->iPTSStopTime < iPts)
-    {
-      m_pCurrent = m_pCurrent->pNext;
-    }
-
-    if (m_pCurrent)
-    {
-      pOverlay = m_pCurrent->pOverlay;
-
-      // advance to the next overlay
-      m_pCurrent = m_pCurrent->pNext;
-    }
+    m_current = std::lower_bound(m_maxStopTime.begin(), m_maxStopTime.end(), iPts) - m_maxStopTime.begin();
+    m_seek = false;
   }
-  return pOverlay;
+  else if (m_current < m_maxStopTime.size() && m_maxStopTime[m_current] < iPts)
+    m_current = std::lower_bound(m_maxStopTime.begin() + m_current, m_maxStopTime.end(), iPts) - m_maxStopTime.begin();
+
+  // skip short cues that ended while an earlier, overlapping one is still shown
+  while (m_current < m_overlays.size() && m_overlays[m_current]->iPTSStopTime < iPts)
+    m_current++;
+
+  if (m_current >= m_overlays.size())
+    return NULL;
+
+  // advance to the next overlay
+  return m_overlays[m_current++];
 }
 
 void CDVDSubtitleLineCollection::Reset()
 {
-  m_pCurrent = m_pHead;
+  m_current = 0;
+  m_seek = true;
 }
 
 void CDVDSubtitleLineCollection::Clear()
 {
-  ListElement* pElement = NULL;
-
-  while (m_pHead)
-  {
-    pElement = m_pHead;
-    m_pHead = pElement->pNext;
-
-    pElement->pOverlay->Release();
-    delete pElement;
-  }
-
-  m_pTail    = NULL;
-  m_pHead    = NULL;
-  m_pCurrent = NULL;
-  m_iSize    = 0;
+  for (std::vector<CDVDOverlay*>::iterator it = m_overlays.begin(); it != m_overlays.end(); ++it)
+    (*it)->Release();
+
+  m_overlays.clear();
+  m_maxStopTime.clear();
+  m_current = 0;
+  m_sorted = true;
+  m_seek = true;
 }
@@ -22,39 +22,34 @@
 
 #include "../DVDCodecs/Overlay/DVDOverlay.h"
 
-typedef struct stListElement
-{
-  CDVDOverlay* pOverlay;
-  struct stListElement* pNext;
-
-} ListElement;
+#include <stddef.h>
+#include <vector>
 
+// Overlays are kept in an array sorted by start time. Lookups by pts use a
+// binary search over the running maximum of the stop times, which stays
+// monotonic when cues overlap, so seeking doesn't rescan from the start.
 class CDVDSubtitleLineCollection
 {
 public:
   CDVDSubtitleLineCollection();
   virtual ~CDVDSubtitleLineCollection();
 
-  //void Lock()   { EnterCriticalSection(&m_critSection); }
-  //void Unlock() { LeaveCriticalSection(&m_critSection); }
-
   void Add(CDVDOverlay* pSubtitle);
   void Sort();
 
-  CDVDOverlay* Get(double iPts = 0LL); // get the first overlay in this fifo
+  CDVDOverlay* Get(double iPts = 0LL); // get the next overlay that has not ended at iPts
 
   void Reset();
 
-  void Remove();
   void Clear();
-  int GetSize() { return m_iSize; }
+  int GetSize() { return (int)m_overlays.size(); }
 
 private:
-  ListElement* m_pHead;
-  ListElement* m_pCurrent;
-  ListElement* m_pTail;
+  void BuildIndex();
 
-  int m_iSize;
-  //CRITICAL_SECTION m_critSection;
+  std::vector<CDVDOverlay*> m_overlays;
+  std::vector<double> m_maxStopTime; // latest stop time of overlays [0, i]
+  size_t m_current;
+  bool m_sorted;
+  bool m_seek;
 };
-
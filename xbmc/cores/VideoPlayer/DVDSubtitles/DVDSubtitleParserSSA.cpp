@@ -40,7 +40,10 @@ bool CDVDSubtitleParserSSA::Open(CDVDStreamInfo &hints)
   if (!CDVDSubtitleParserText::Open())
     return false;
 
-  std::string buffer = m_pStream->m_stringstream.str();
+  std::string buffer;
+  if (!m_pStream->ReadRemaining(buffer))
+    return false;
+
   if(!m_libass->CreateTrack((char*) buffer.c_str(), buffer.length()))
     return false;
 
@@ -18,6 +18,7 @@
  *
  */
 
+#include <algorithm>
 #include <cstring>
 
 #include "DVDSubtitleStream.h"
@@ -28,10 +29,17 @@
 #include "utils/CharsetDetection.h"
 #include "filesystem/File.h"
 #include "utils/log.h"
+#include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 
+static const size_t chunksize = 64 * 1024;
 
 CDVDSubtitleStream::CDVDSubtitleStream()
+  : m_bomSize(0)
+  , m_bufferPos(0)
+  , m_bufferOffset(0)
+  , m_keepBuffer(false)
+  , m_eof(true)
 {
 }
 
@@ -41,72 +49,73 @@ CDVDSubtitleStream::~CDVDSubtitleStream()
 
 bool CDVDSubtitleStream::Open(const std::string& strFile)
 {
-  CDVDInputStream* pInputStream;
-  CFileItem item(strFile, false);
-  item.SetContentLookup(false);
-  pInputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
-  if (pInputStream && pInputStream->Open())
-  {
-    // prepare buffer
-    size_t totalread = 0;
-    XUTILS::auto_buffer buf(1024);
+  m_filename = strFile;
+  m_keepBuffer = false;
+  if (!OpenInputStream())
+    return false;
 
-    if (URIUtils::HasExtension(strFile, ".sub") && IsIncompatible(pInputStream, buf, &totalread))
-    {
-      CLog::Log(LOGDEBUG, "%s: file %s seems to be a vob sub"
-        "file without an idx file, skipping it", __FUNCTION__, CURL::GetRedacted(pInputStream->GetFileName()).c_str());
-      buf.clear();
-      delete pInputStream;
-      return false;
-    }
-
-    static const size_t chunksize = 64 * 1024;
-
-    int read;
-    do
-    {
-      if (totalread == buf.size())
-        buf.resize(buf.size() + chunksize);
+  // prepare buffer
+  size_t totalread = 0;
+  XUTILS::auto_buffer buf(1024);
 
-      read = pInputStream->Read((uint8_t*)buf.get() + totalread, buf.size() - totalread);
-      if (read > 0)
-        totalread += read;
-    } while (read > 0);
-
-    delete pInputStream;
-    if (!totalread)
-      return false;
+  if (URIUtils::HasExtension(strFile, ".sub") && IsIncompatible(m_pInputStream.get(), buf, &totalread))
+  {
+    CLog::Log(LOGDEBUG, "%s: file %s seems to be a vob sub"
+      "file without an idx file, skipping it", __FUNCTION__, CURL::GetRedacted(m_pInputStream->GetFileName()).c_str());
+    m_pInputStream.reset();
+    return false;
+  }
 
-    std::string tmpStr(buf.get(), totalread);
-    buf.clear();
+  m_pending.assign(buf.get(), totalread);
+  buf.clear();
+  m_buffer.clear();
+  m_bufferPos = 0;
+  m_bufferOffset = 0;
+  m_eof = false;
 
-    std::string enc(CCharsetDetection::GetBomEncoding(tmpStr));
-    if (enc == "UTF-8" || (enc.empty() && CUtf8Utils::isValidUtf8(tmpStr)))
-      m_stringstream << tmpStr;
-    else if (!enc.empty())
-    {
-      std::string converted;
-      g_charsetConverter.ToUtf8(enc, tmpStr, converted);
-      if (converted.empty())
-        return false;
+  // the charset is detected from the first chunk only, so that the file
+  // isn't decoded with different charsets
+  ReadChunk();
+  m_encoding = CCharsetDetection::GetBomEncoding(m_pending);
+  m_bomSize = 0;
+  if (m_encoding == "UTF-8")
+  {
+    m_bomSize = 3;
+    m_pending.erase(0, m_bomSize);
+  }
+  else if (m_encoding.empty())
+  {
+    // ignore a multi-byte character cut off at the end of the chunk
+    size_t end = m_eof ? std::string::npos : m_pending.rfind('\n');
+    if (CUtf8Utils::isValidUtf8(end == std::string::npos ? m_pending : m_pending.substr(0, end + 1)))
+      m_encoding = "UTF-8";
+  }
+  else if (StringUtils::StartsWith(m_encoding, "UTF-"))
+  {
+    // UTF-7/16/32 can't be split at line ends, convert the whole file
+    while (ReadChunk())
+      ;
+    m_keepBuffer = true;
 
-      m_stringstream << converted;
-    }
-    else
-    {
-      std::string converted;
-      g_charsetConverter.subtitleCharsetToUtf8(tmpStr, converted);
-      if (converted.empty())
-        return false;
+    g_charsetConverter.ToUtf8(m_encoding, m_pending, m_buffer);
+    m_pending.clear();
+    return !m_buffer.empty();
+  }
 
-      m_stringstream << converted;
-    }
+  return FillBuffer();
+}
 
-    return true;
+bool CDVDSubtitleStream::OpenInputStream()
+{
+  CFileItem item(m_filename, false);
+  item.SetContentLookup(false);
+  m_pInputStream.reset(CDVDFactoryInputStream::CreateInputStream(NULL, item));
+  if (!m_pInputStream || !m_pInputStream->Open())
+  {
+    m_pInputStream.reset();
+    return false;
   }
-
-  delete pInputStream;
-  return false;
+  return true;
 }
 
 bool CDVDSubtitleStream::IsIncompatible(CDVDInputStream* pInputStream, XUTILS::auto_buffer& buf, size_t* bytesRead)
@@ -136,39 +145,189 @@ bool CDVDSubtitleStream::IsIncompatible(CDVDInputStream* pInputStream, XUTILS::a
   return false;
 }
 
-int CDVDSubtitleStream::Read(char* buf, int buf_size)
+bool CDVDSubtitleStream::ReadChunk()
 {
-  return (int)m_stringstream.readsome(buf, buf_size);
+  if (m_eof || !m_pInputStream)
+  {
+    m_eof = true;
+    return false;
+  }
+
+  size_t size = m_pending.size();
+  m_pending.resize(size + chunksize);
+  int read = m_pInputStream->Read((uint8_t*)&m_pending[size], chunksize);
+  m_pending.resize(size + std::max(read, 0));
+
+  if (read <= 0)
+  {
+    // everything has been read, don't keep the file open while playing
+    m_eof = true;
+    m_pInputStream.reset();
+  }
+  return read > 0;
 }
 
-long CDVDSubtitleStream::Seek(long offset, int whence)
+bool CDVDSubtitleStream::FillBuffer()
 {
-  switch (whence)
+  while (!m_eof || !m_pending.empty())
   {
-    case SEEK_CUR:
-    {
-      m_stringstream.seekg(offset, std::ios::cur);
-      break;
-    }
-    case SEEK_END:
+    // convert complete lines only, unless there is nothing more to come
+    size_t end = m_pending.rfind('\n');
+    if (end == std::string::npos && !m_eof)
     {
-      m_stringstream.seekg(offset, std::ios::end);
-      break;
-    }
-    case SEEK_SET:
-    {
-      m_stringstream.seekg(offset, std::ios::beg);
-      break;
+      ReadChunk();
+      continue;
     }
+    end = (end == std::string::npos || m_eof) ? m_pending.size() : end + 1;
+
+    std::string chunk(m_pending, 0, end);
+    m_pending.erase(0, end);
+    if (AppendConverted(chunk))
+      return true;
   }
-  return (int)m_stringstream.tellg();
+  return false;
 }
 
-char* CDVDSubtitleStream::ReadLine(char* buf, int iLen)
+bool CDVDSubtitleStream::AppendConverted(const std::string& chunk)
 {
-  if (m_stringstream.getline(buf, iLen))
-    return buf;
+  if (chunk.empty())
+    return false;
+
+  if (m_encoding == "UTF-8")
+  {
+    m_buffer.append(chunk);
+    return true;
+  }
+
+  std::string converted;
+  if (!m_encoding.empty())
+    g_charsetConverter.ToUtf8(m_encoding, chunk, converted);
   else
+    g_charsetConverter.subtitleCharsetToUtf8(chunk, converted);
+
+  if (converted.empty())
+  {
+    CLog::Log(LOGWARNING, "%s: failed to convert %u bytes of subtitle text", __FUNCTION__, (unsigned int)chunk.size());
+    return false;
+  }
+
+  m_buffer.append(converted);
+  return true;
+}
+
+bool CDVDSubtitleStream::Rewind()
+{
+  if (m_bufferOffset == 0)
+  {
+    m_bufferPos = 0;
+    return true;
+  }
+
+  // the start of the file has been dropped already, read it again
+  if (!m_pInputStream && !OpenInputStream())
+    return false;
+  if (m_pInputStream->Seek(m_bomSize, SEEK_SET) != (int64_t)m_bomSize)
+    return false;
+
+  m_pending.clear();
+  m_buffer.clear();
+  m_bufferPos = 0;
+  m_bufferOffset = 0;
+  m_eof = false;
+  FillBuffer();
+  return true;
+}
+
+long CDVDSubtitleStream::Seek(long offset, int whence)
+{
+  int64_t target;
+  switch (whence)
+  {
+  case SEEK_SET:
+    target = offset;
+    break;
+  case SEEK_CUR:
+    target = (int64_t)(m_bufferOffset + m_bufferPos) + offset;
+    break;
+  case SEEK_END:
+    while (FillBuffer())
+      ;
+    target = (int64_t)(m_bufferOffset + m_buffer.size()) + offset;
+    break;
+  default:
+    return -1;
+  }
+
+  if (target < 0)
+    return -1;
+
+  if ((size_t)target < m_bufferOffset && !Rewind())
+    return -1;
+
+  while ((size_t)target > m_bufferOffset + m_buffer.size())
+  {
+    if (!FillBuffer())
+      return -1;
+  }
+
+  m_bufferPos = (size_t)target - m_bufferOffset;
+  return (long)target;
+}
+
+char* CDVDSubtitleStream::ReadLine(char* buf, int iLen)
+{
+  if (iLen <= 0)
     return NULL;
+
+  // drop what has been read, the whole file is kept only if it's small
+  if (!m_keepBuffer && m_bufferPos >= chunksize)
+  {
+    m_buffer.erase(0, m_bufferPos);
+    m_bufferOffset += m_bufferPos;
+    m_bufferPos = 0;
+  }
+
+  size_t searchPos = m_bufferPos;
+  size_t end;
+  while ((end = m_buffer.find('\n', searchPos)) == std::string::npos)
+  {
+    searchPos = m_buffer.size();
+    if (!FillBuffer())
+      break;
+  }
+
+  if (end == std::string::npos)
+  {
+    if (m_bufferPos >= m_buffer.size())
+      return NULL;
+    end = m_buffer.size();
+  }
+
+  size_t len = std::min(end - m_bufferPos, (size_t)iLen - 1);
+  memcpy(buf, m_buffer.c_str() + m_bufferPos, len);
+  buf[len] = '\0';
+
+  m_bufferPos = std::min(end + 1, m_buffer.size());
+  return buf;
 }
 
+bool CDVDSubtitleStream::ReadRemaining(std::string& text)
+{
+  while (FillBuffer())
+    ;
+
+  if (m_bufferPos == 0)
+  {
+    // hand over the buffer instead of copying it
+    text.swap(m_buffer);
+    m_buffer.clear();
+    m_bufferOffset += text.size();
+  }
+  else
+  {
+    text.assign(m_buffer, m_bufferPos, std::string::npos);
+    m_bufferPos = m_buffer.size();
+  }
+
+  return !text.empty();
+}
@@ -24,12 +24,21 @@
 
 #include "utils/auto_buffer.h"
 
+#include <memory>
 #include <string>
-#include <sstream>
 
 class CDVDInputStream;
+class TestDVDSubtitleStream;
 
 // buffered class for subtitle reading
+//
+// The file is read and converted to UTF-8 in chunks as lines are requested,
+// so only a small window of the file is held in memory. Chunks are cut at
+// line ends, which is safe for UTF-8 and the ASCII compatible legacy
+// charsets. The charset is detected once from the first chunk and used for
+// the whole file. Files with an UTF-16/32 BOM are converted at once on open.
+// The file is closed once it has been read to the end and only opened again
+// when seeking back before the buffered text.
 
 class CDVDSubtitleStream
 {
@@ -45,12 +54,43 @@ public:
    */
   bool IsIncompatible(CDVDInputStream* pInputStream, XUTILS::auto_buffer& buf, size_t* bytesRead);
 
-  int Read(char* buf, int buf_size);
+  /** \brief Seek in the converted text.
+   *  \note Seeking backwards before the text still buffered reads the file
+   *         again from the start, SEEK_END reads the whole file.
+   *  \return the new position, -1 on failure.
+   */
   long Seek(long offset, int whence);
 
+  /** \brief Read the next line, without line terminator.
+   *         Lines longer than the buffer are truncated.
+   *  \return pBuffer, NULL at end of file.
+   */
   char* ReadLine(char* pBuffer, int iLen);
-  //wchar* ReadLineW(wchar* pBuffer, int iLen) { return NULL; };
 
-  std::stringstream m_stringstream;
-};
+  /** \brief Read everything from the current position to the end of the file.
+   *  \param[out] text the converted text.
+   *  \return false if nothing could be read.
+   */
+  bool ReadRemaining(std::string& text);
 
+private:
+  friend class ::TestDVDSubtitleStream;
+
+  bool OpenInputStream();
+  bool ReadChunk();
+  bool FillBuffer();
+  bool AppendConverted(const std::string& chunk);
+
+  bool Rewind();
+
+  std::unique_ptr<CDVDInputStream> m_pInputStream;
+  std::string m_filename;
+  std::string m_encoding;     ///< encoding from the BOM or detected, empty for the subtitle charset
+  size_t m_bomSize;           ///< size of the skipped UTF-8 BOM
+  std::string m_pending;      ///< raw bytes not yet converted (incomplete line)
+  std::string m_buffer;       ///< converted text
+  size_t m_bufferPos;         ///< read position in m_buffer
+  size_t m_bufferOffset;      ///< position of m_buffer in the converted text
+  bool m_keepBuffer;          ///< the whole file was converted on open, it can't be read again in chunks
+  bool m_eof;
+};
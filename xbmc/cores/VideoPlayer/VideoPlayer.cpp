@@ -3098,6 +3098,12 @@ void CVideoPlayer::GetVideoInfo(std::string& strVideoInfo)
     strVideoInfo = StringUtils::Format("D(%s)", m_State.demux_video.c_str());
   }
   strVideoInfo += StringUtils::Format("\nP(%s)", m_VideoPlayerVideo->GetPlayerInfo().c_str());
+
+  std::string renderInfo = m_renderManager.GetDebugInfo();
+  if (!renderInfo.empty())
+    strVideoInfo += StringUtils::Format("\nR(%s)", renderInfo.c_str());
+
+  strVideoInfo += StringUtils::Format("\nF(%s)", m_renderManager.GetFrameStats().GetSummary().c_str());
 }
 
 void CVideoPlayer::GetGeneralInfo(std::string& strGeneralInfo)
@@ -4969,6 +4975,18 @@ std::string CVideoPlayer::GetRenderVSyncState()
   return m_renderManager.GetVSyncState();
 }
 
+bool CVideoPlayer::GetFrameStats(CVariant &stats, bool reset)
+{
+  if (!HasVideo())
+    return false;
+
+  CFrameStats &frameStats = m_renderManager.GetFrameStats();
+  frameStats.Serialize(stats);
+  if (reset)
+    frameStats.Reset();
+  return true;
+}
+
 void CVideoPlayer::VideoParamsChange()
 {
   m_messenger.Put(new CDVDMsg(CDVDMsg::PLAYER_AVCHANGE));
@@ -334,6 +334,7 @@ public:
   virtual bool RenderCaptureGetPixels(unsigned int captureId, unsigned int millis, uint8_t *buffer, unsigned int size);
 
   virtual std::string GetRenderVSyncState();
+  virtual bool GetFrameStats(CVariant &stats, bool reset = false);
 
   // IDispResource interface
   virtual void OnLostDisplay();
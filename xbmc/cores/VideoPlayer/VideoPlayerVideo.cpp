@@ -40,6 +40,7 @@
 #include <numeric>
 #include <iterator>
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 
 using namespace RenderManager;
 
@@ -241,6 +242,11 @@ void CVideoPlayerVideo::OnStartup()
   m_FlipTimePts = 0.0;
 }
 
+static double HostCounterToMs(int64_t ticks)
+{
+  return (double)ticks * 1000.0 / CurrentHostFrequency();
+}
+
 void CVideoPlayerVideo::Process()
 {
   CLog::Log(LOGNOTICE, "running thread: video_thread");
@@ -454,6 +460,7 @@ void CVideoPlayerVideo::Process()
       {
         m_iDroppedFrames++;
         iDropped++;
+        m_renderManager.GetFrameStats().AddDrop(FRAME_DROP_SYNC);
       }
 
       if (m_messageQueue.GetDataSize() == 0
@@ -474,7 +481,9 @@ void CVideoPlayerVideo::Process()
       // decoder still needs to provide an empty image structure, with correct flags
       m_pVideoCodec->SetDropState(bRequestDrop);
 
+      int64_t decodeStart = CurrentHostCounter();
       int iDecoderState = m_pVideoCodec->Decode(pPacket->pData, pPacket->iSize, pPacket->dts, pPacket->pts);
+      m_renderManager.GetFrameStats().AddDecodeTime(HostCounterToMs(CurrentHostCounter() - decodeStart));
 
       // buffer packets so we can recover should decoder flush for some reason
       if(m_pVideoCodec->GetConvergeCount() > 0)
@@ -505,7 +514,9 @@ void CVideoPlayerVideo::Process()
           break;
 
         // the decoder didn't need more data, flush the remaning buffer
+        decodeStart = CurrentHostCounter();
         iDecoderState = m_pVideoCodec->Decode(NULL, 0, DVD_NOPTS_VALUE, DVD_NOPTS_VALUE);
+        m_renderManager.GetFrameStats().AddDecodeTime(HostCounterToMs(CurrentHostCounter() - decodeStart));
       }
     }
 
@@ -671,6 +682,7 @@ bool CVideoPlayerVideo::ProcessDecoderOutput(int &decoderState, double &frametim
     if (ret & EOS_DROPPED)
     {
       m_iDroppedFrames++;
+      m_renderManager.GetFrameStats().AddDrop(FRAME_DROP_SYNC);
     }
   }
 
@@ -876,10 +888,12 @@ int CVideoPlayerVideo::OutputPicture(const DVDVideoPicture* src, double pts)
       {
         Sleep(50);
       }
+      m_renderManager.GetFrameStats().AddDrop(FRAME_DROP_SPEED);
       return result | EOS_DROPPED;
     }
     else if (pts_org < iPlayingClock)
     {
+      m_renderManager.GetFrameStats().AddDrop(FRAME_DROP_SPEED);
       return result | EOS_DROPPED;
     }
 
@@ -900,6 +914,7 @@ int CVideoPlayerVideo::OutputPicture(const DVDVideoPicture* src, double pts)
     if (diff < mindiff)
     {
       m_droppingStats.AddOutputDropGain(pts, 1/m_fFrameRate);
+      m_renderManager.GetFrameStats().AddDrop(FRAME_DROP_SPEED);
       return result | EOS_DROPPED;
     }
   }
@@ -912,6 +927,7 @@ int CVideoPlayerVideo::OutputPicture(const DVDVideoPicture* src, double pts)
   if ((pPicture->iFlags & DVP_FLAG_DROPPED))
   {
     m_droppingStats.AddOutputDropGain(pts, 1/m_fFrameRate);
+    m_renderManager.GetFrameStats().AddDrop(FRAME_DROP_DECODER);
     CLog::Log(LOGDEBUG,"%s - dropped in output", __FUNCTION__);
     return result | EOS_DROPPED;
   }
@@ -935,6 +951,7 @@ int CVideoPlayerVideo::OutputPicture(const DVDVideoPicture* src, double pts)
   if (buffer < 0)
   {
     m_droppingStats.AddOutputDropGain(pts, 1/m_fFrameRate);
+    m_renderManager.GetFrameStats().AddDrop(FRAME_DROP_NOBUFFER);
     return EOS_DROPPED;
   }
 
@@ -953,6 +970,7 @@ int CVideoPlayerVideo::OutputPicture(const DVDVideoPicture* src, double pts)
   if (index < 0)
   {
     m_droppingStats.AddOutputDropGain(pts, 1/m_fFrameRate);
+    m_renderManager.GetFrameStats().AddDrop(FRAME_DROP_NOBUFFER);
     return EOS_DROPPED;
   }
 
@@ -20,6 +20,7 @@
  *
  */
 
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -94,6 +95,8 @@ public:
   virtual bool IsGuiLayer() { return true; }
   // Render info, can be called before configure
   virtual CRenderInfo GetRenderInfo() { return CRenderInfo(); }
+  // Renderer statistics for the codec info overlay, empty if there are none
+  virtual std::string GetDebugInfo() { return ""; }
   virtual void Update() = 0;
   virtual void RenderUpdate(bool clear, unsigned int flags = 0, unsigned int alpha = 255) = 0;
   virtual bool RenderCapture(CRenderCapture* capture) = 0;
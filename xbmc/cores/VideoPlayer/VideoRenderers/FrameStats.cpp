@@ -0,0 +1,141 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FrameStats.h"
+
+#include <string.h>
+
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+
+// upper bounds of the buckets in ms, the last bucket takes everything above
+static const double BucketBounds[CFrameHistogram::BUCKETS - 1] = { 1, 2, 4, 8, 16, 33, 50, 100, 250 };
+
+static const char* DropNames[FRAME_DROP_MAX] = { "decoder", "sync", "speed", "nobuffer", "late", "flush" };
+
+void CFrameHistogram::Add(double ms)
+{
+  if (ms < 0.0)
+    ms = 0.0;
+
+  int bucket = 0;
+  while (bucket < BUCKETS - 1 && ms > BucketBounds[bucket])
+    bucket++;
+
+  m_buckets[bucket]++;
+  m_count++;
+  m_sum += ms;
+  if (ms > m_max)
+    m_max = ms;
+}
+
+void CFrameHistogram::Reset()
+{
+  memset(m_buckets, 0, sizeof(m_buckets));
+  m_count = 0;
+  m_sum = 0.0;
+  m_max = 0.0;
+}
+
+void CFrameHistogram::Serialize(CVariant &value) const
+{
+  value["count"] = m_count;
+  value["average"] = GetAverage();
+  value["max"] = m_max;
+  value["bounds"] = CVariant(CVariant::VariantTypeArray);
+  value["buckets"] = CVariant(CVariant::VariantTypeArray);
+  for (int i = 0; i < BUCKETS; i++)
+  {
+    if (i < BUCKETS - 1)
+      value["bounds"].push_back(BucketBounds[i]);
+    value["buckets"].push_back(m_buckets[i]);
+  }
+}
+
+CFrameStats::CFrameStats()
+{
+  memset(m_drops, 0, sizeof(m_drops));
+}
+
+void CFrameStats::AddDecodeTime(double ms)
+{
+  CSingleLock lock(m_critSection);
+  m_decodeTime.Add(ms);
+}
+
+void CFrameStats::AddQueueWait(double ms)
+{
+  CSingleLock lock(m_critSection);
+  m_queueWait.Add(ms);
+}
+
+void CFrameStats::AddPresentLateness(double ms)
+{
+  CSingleLock lock(m_critSection);
+  m_presentLateness.Add(ms);
+}
+
+void CFrameStats::AddDrop(EFRAMEDROP reason, unsigned int count)
+{
+  if (reason < 0 || reason >= FRAME_DROP_MAX)
+    return;
+
+  CSingleLock lock(m_critSection);
+  m_drops[reason] += count;
+}
+
+void CFrameStats::Reset()
+{
+  CSingleLock lock(m_critSection);
+  m_decodeTime.Reset();
+  m_queueWait.Reset();
+  m_presentLateness.Reset();
+  memset(m_drops, 0, sizeof(m_drops));
+}
+
+std::string CFrameStats::GetSummary() const
+{
+  CSingleLock lock(m_critSection);
+  return StringUtils::Format("dec:%.1f/%.1fms queue:%.1f/%.1fms late:%.1f/%.1fms drop:%u/%u/%u/%u/%u/%u",
+                             m_decodeTime.GetAverage(), m_decodeTime.GetMax(),
+                             m_queueWait.GetAverage(), m_queueWait.GetMax(),
+                             m_presentLateness.GetAverage(), m_presentLateness.GetMax(),
+                             m_drops[FRAME_DROP_DECODER], m_drops[FRAME_DROP_SYNC],
+                             m_drops[FRAME_DROP_SPEED], m_drops[FRAME_DROP_NOBUFFER],
+                             m_drops[FRAME_DROP_LATE], m_drops[FRAME_DROP_FLUSH]);
+}
+
+void CFrameStats::Serialize(CVariant &value) const
+{
+  CSingleLock lock(m_critSection);
+  value["frames"] = m_queueWait.GetCount();
+  m_decodeTime.Serialize(value["decodetime"]);
+  m_queueWait.Serialize(value["queuewait"]);
+  m_presentLateness.Serialize(value["presentlateness"]);
+
+  unsigned int total = 0;
+  for (int i = 0; i < FRAME_DROP_MAX; i++)
+  {
+    value["drops"][DropNames[i]] = m_drops[i];
+    total += m_drops[i];
+  }
+  value["drops"]["total"] = total;
+}
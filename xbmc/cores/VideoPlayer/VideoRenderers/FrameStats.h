@@ -0,0 +1,99 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "threads/CriticalSection.h"
+
+class CVariant;
+
+enum EFRAMEDROP
+{
+  FRAME_DROP_DECODER = 0, ///< decoder was asked to skip the frame
+  FRAME_DROP_SYNC,        ///< player dropped to catch up with the clock
+  FRAME_DROP_SPEED,       ///< not shown during fast forward or rewind
+  FRAME_DROP_NOBUFFER,    ///< no render buffer became free in time
+  FRAME_DROP_LATE,        ///< skipped in the render queue, a later frame was due
+  FRAME_DROP_FLUSH,       ///< discarded from the render queue on flush
+  FRAME_DROP_MAX
+};
+
+/*!
+ \brief Histogram of durations in milliseconds with fixed, roughly doubling buckets.
+ */
+class CFrameHistogram
+{
+public:
+  static const int BUCKETS = 10;
+
+  CFrameHistogram() { Reset(); }
+
+  void Add(double ms);
+  void Reset();
+
+  unsigned int GetCount() const { return m_count; }
+  double GetAverage() const { return m_count ? m_sum / m_count : 0.0; }
+  double GetMax() const { return m_max; }
+
+  void Serialize(CVariant &value) const;
+
+private:
+  unsigned int m_buckets[BUCKETS];
+  unsigned int m_count;
+  double m_sum;
+  double m_max;
+};
+
+/*!
+ \brief Timing of video frames from decode to presentation.
+
+ Collects the time spent in the decoder per packet, the time frames wait in
+ the render queue, how late they are when picked for presentation, and the
+ number of frames dropped per reason. Written by the video player and render
+ threads, read by the codec info overlay and JSON-RPC.
+ */
+class CFrameStats
+{
+public:
+  CFrameStats();
+
+  void AddDecodeTime(double ms);
+  void AddQueueWait(double ms);
+  void AddPresentLateness(double ms);
+  void AddDrop(EFRAMEDROP reason, unsigned int count = 1);
+  void Reset();
+
+  /*!
+   \brief One line summary for the codec info overlay.
+   */
+  std::string GetSummary() const;
+
+  void Serialize(CVariant &value) const;
+
+private:
+  CCriticalSection m_critSection;
+  CFrameHistogram m_decodeTime;
+  CFrameHistogram m_queueWait;
+  CFrameHistogram m_presentLateness;
+  unsigned int m_drops[FRAME_DROP_MAX];
+};
@@ -141,7 +141,6 @@ CLinuxRendererGL::CLinuxRendererGL()
 
   m_rgbBuffer = NULL;
   m_rgbBufferSize = 0;
-  m_context = NULL;
   m_rgbPbo = 0;
   m_fbo.width = 0.0;
   m_fbo.height = 0.0;
@@ -174,11 +173,7 @@ CLinuxRendererGL::~CLinuxRendererGL()
     m_rgbBuffer = NULL;
   }
 
-  if (m_context)
-  {
-    sws_freeContext(m_context);
-    m_context = NULL;
-  }
+  m_rgbConverter.Dispose();
 
   if (m_pYUVShader)
   {
@@ -1008,11 +1003,7 @@ void CLinuxRendererGL::UnInit()
   }
   m_rgbBufferSize = 0;
 
-  if (m_context)
-  {
-    sws_freeContext(m_context);
-    m_context = NULL;
-  }
+  m_rgbConverter.Dispose();
 
   // YV12 textures
   for (int i = 0; i < NUM_BUFFERS; ++i)
@@ -2475,14 +2466,9 @@ void CLinuxRendererGL::ToRGBFrame(YV12Image* im, unsigned flipIndexPlane, unsign
     m_rgbBuffer = (BYTE*)glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB) + PBO_OFFSET;
   }
 
-  m_context = sws_getCachedContext(m_context,
-                                                 im->width, im->height, (AVPixelFormat)srcFormat,
-                                                 im->width, im->height, (AVPixelFormat)AV_PIX_FMT_BGRA,
-                                                 SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-  uint8_t *dst[]       = { m_rgbBuffer, 0, 0, 0 };
-  int      dstStride[] = { (int)m_sourceWidth * 4, 0, 0, 0 };
-  sws_scale(m_context, src, srcStride, 0, im->height, dst, dstStride);
+  m_rgbConverter.BeginFrame();
+  m_rgbConverter.Convert(src, srcStride, srcFormat, im->width, im->height, m_rgbBuffer, (int)m_sourceWidth * 4);
+  m_rgbConverter.EndFrame();
 
   if (m_rgbPbo)
   {
@@ -2555,18 +2541,16 @@ void CLinuxRendererGL::ToRGBFields(YV12Image* im, unsigned flipIndexPlaneTop, un
     m_rgbBuffer = (BYTE*)glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB) + PBO_OFFSET;
   }
 
-  m_context = sws_getCachedContext(m_context,
-                                                 im->width, im->height >> 1, (AVPixelFormat)srcFormat,
-                                                 im->width, im->height >> 1, (AVPixelFormat)AV_PIX_FMT_BGRA,
-                                                 SWS_FAST_BILINEAR, NULL, NULL, NULL);
-  uint8_t *dstTop[]    = { m_rgbBuffer, 0, 0, 0 };
-  uint8_t *dstBot[]    = { m_rgbBuffer + m_sourceWidth * m_sourceHeight * 2, 0, 0, 0 };
-  int      dstStride[] = { (int)m_sourceWidth * 4, 0, 0, 0 };
+  uint8_t *dstTop    = m_rgbBuffer;
+  uint8_t *dstBot    = m_rgbBuffer + m_sourceWidth * m_sourceHeight * 2;
+  int      dstStride = (int)m_sourceWidth * 4;
 
   //convert each YUV field to an RGB field, the top field is placed at the top of the rgb buffer
   //the bottom field is placed at the bottom of the rgb buffer
-  sws_scale(m_context, srcTop, srcStrideTop, 0, im->height >> 1, dstTop, dstStride);
-  sws_scale(m_context, srcBot, srcStrideBot, 0, im->height >> 1, dstBot, dstStride);
+  m_rgbConverter.BeginFrame();
+  m_rgbConverter.Convert(srcTop, srcStrideTop, srcFormat, im->width, im->height >> 1, dstTop, dstStride);
+  m_rgbConverter.Convert(srcBot, srcStrideBot, srcFormat, im->width, im->height >> 1, dstBot, dstStride);
+  m_rgbConverter.EndFrame();
 
   if (m_rgbPbo)
   {
@@ -2923,4 +2907,11 @@ CRenderInfo CLinuxRendererGL::GetRenderInfo()
   return info;
 }
 
+std::string CLinuxRendererGL::GetDebugInfo()
+{
+  if (m_renderMethod & RENDER_SW)
+    return m_rgbConverter.GetInfo();
+  return "";
+}
+
 #endif
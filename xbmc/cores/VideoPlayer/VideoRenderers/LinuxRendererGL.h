@@ -32,6 +32,7 @@
 #include "RenderFormats.h"
 #include "guilib/GraphicContext.h"
 #include "BaseRenderer.h"
+#include "SlicedConverter.h"
 
 #include "threads/Event.h"
 
@@ -132,6 +133,7 @@ public:
   virtual bool RenderCapture(CRenderCapture* capture);
   virtual EINTERLACEMETHOD AutoInterlaceMethod();
   virtual CRenderInfo GetRenderInfo();
+  virtual std::string GetDebugInfo();
 
   // Feature support
   virtual bool SupportsMultiPassRendering();
@@ -274,7 +276,7 @@ protected:
   BYTE              *m_rgbBuffer;  // if software scale is used, this will hold the result image
   unsigned int       m_rgbBufferSize;
   GLuint             m_rgbPbo;
-  struct SwsContext *m_context;
+  CSlicedConverter   m_rgbConverter;
 
   void BindPbo(YUVBUFFER& buff);
   void UnBindPbo(YUVBUFFER& buff);
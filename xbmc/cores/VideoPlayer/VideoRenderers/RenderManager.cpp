@@ -26,6 +26,7 @@
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 
 #include "Application.h"
 #include "messaging/ApplicationMessenger.h"
@@ -140,6 +141,9 @@ CRenderManager::CRenderManager(CDVDClock &clock, IRenderMsg *player) : m_dvdCloc
   m_renderedOverlay = false;
   m_captureWaitCounter = 0;
   m_playerPort = player;
+  // read for every frame
+  m_adjustRefreshRate = CSettings::GetInstance().GetIntHandle(CSettings::SETTING_VIDEOPLAYER_ADJUSTREFRESHRATE);
+  m_vsync = CSettings::GetInstance().GetIntHandle(CSettings::SETTING_VIDEOSCREEN_VSYNC);
 }
 
 CRenderManager::~CRenderManager()
@@ -257,7 +261,7 @@ bool CRenderManager::Configure(DVDVideoPicture& picture, float fps, unsigned fla
   {
     float config_framerate = fps;
     float render_framerate = g_graphicsContext.GetFPS();
-    if (CSettings::GetInstance().GetInt(CSettings::SETTING_VIDEOPLAYER_ADJUSTREFRESHRATE) == ADJUST_REFRESHRATE_OFF)
+    if (m_adjustRefreshRate.Get() == ADJUST_REFRESHRATE_OFF)
       render_framerate = config_framerate;
     bool changerefresh = (fps != 0) &&
                          (m_fps == 0.0 || fmod(m_fps, fps) != 0.0) &&
@@ -565,6 +569,7 @@ void CRenderManager::PreInit()
   m_QueueSize   = 2;
   m_QueueSkip   = 0;
   m_presentstep = PRESENT_IDLE;
+  m_frameStats.Reset();
   m_format = RENDER_FMT_NONE;
 }
 
@@ -981,6 +986,7 @@ void CRenderManager::FlipPage(volatile bool& bStop, double timestamp /* = 0LL*/,
   m.presentfield  = sync;
   m.presentmethod = presentmethod;
   m.pts           = pts;
+  m.queuetime     = CurrentHostCounter();
   requeue(m_queued, m_free);
 
   /* signal to any waiters to check state */
@@ -999,7 +1005,7 @@ RESOLUTION CRenderManager::GetResolution()
   if (m_renderState == STATE_UNCONFIGURED)
     return res;
 
-  if (CSettings::GetInstance().GetInt(CSettings::SETTING_VIDEOPLAYER_ADJUSTREFRESHRATE) != ADJUST_REFRESHRATE_OFF)
+  if (m_adjustRefreshRate.Get() != ADJUST_REFRESHRATE_OFF)
     res = CResolutionUtils::ChooseBestResolution(m_fps, m_width, CONF_FLAGS_STEREO_MODE_MASK(m_flags));
 
   return res;
@@ -1009,7 +1015,7 @@ float CRenderManager::GetMaximumFPS()
 {
   float fps;
 
-  if (CSettings::GetInstance().GetInt(CSettings::SETTING_VIDEOSCREEN_VSYNC) != VSYNC_DISABLED)
+  if (m_vsync.Get() != VSYNC_DISABLED)
   {
     fps = (float)g_VideoReferenceClock.GetRefreshRate();
     if (fps <= 0) fps = g_graphicsContext.GetFPS();
@@ -1151,7 +1157,7 @@ void CRenderManager::UpdateResolution()
   {
     if (g_graphicsContext.IsFullScreenVideo() && g_graphicsContext.IsFullScreenRoot())
     {
-      if (CSettings::GetInstance().GetInt(CSettings::SETTING_VIDEOPLAYER_ADJUSTREFRESHRATE) != ADJUST_REFRESHRATE_OFF && m_fps > 0.0f)
+      if (m_adjustRefreshRate.Get() != ADJUST_REFRESHRATE_OFF && m_fps > 0.0f)
       {
         RESOLUTION res = CResolutionUtils::ChooseBestResolution(m_fps, m_width, CONF_FLAGS_STEREO_MODE_MASK(m_flags));
         g_graphicsContext.SetVideoResolution(res);
@@ -1175,6 +1181,14 @@ void CRenderManager::TriggerUpdateResolution(float fps, int width, int flags)
 }
 
 // Get renderer info, can be called before configure
+std::string CRenderManager::GetDebugInfo()
+{
+  CSingleLock lock(m_statelock);
+  if (!m_pRenderer)
+    return "";
+  return m_pRenderer->GetDebugInfo();
+}
+
 CRenderInfo CRenderManager::GetRenderInfo()
 {
   CSingleLock lock(m_statelock);
@@ -1414,8 +1428,12 @@ void CRenderManager::PrepareNextRender()
     {
       requeue(m_discard, m_queued);
       m_QueueSkip++;
+      m_frameStats.AddDrop(FRAME_DROP_LATE);
     }
 
+    m_frameStats.AddQueueWait((double)(CurrentHostCounter() - m_Queue[idx].queuetime) * 1000.0 / CurrentHostFrequency());
+    m_frameStats.AddPresentLateness((clocktime - m_Queue[idx].timestamp) * 1000.0);
+
     m_presentstep   = PRESENT_FLIP;
     m_discard.push_back(m_presentsource);
     m_presentsource = idx;
@@ -1430,6 +1448,7 @@ void CRenderManager::DiscardBuffer()
 {
   CSingleLock lock2(m_presentlock);
 
+  m_frameStats.AddDrop(FRAME_DROP_FLUSH, m_queued.size());
   while(!m_queued.empty())
     requeue(m_discard, m_queued);
 
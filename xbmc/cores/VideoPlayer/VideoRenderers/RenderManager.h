@@ -28,7 +28,9 @@
 #include "guilib/Resolution.h"
 #include "threads/CriticalSection.h"
 #include "settings/VideoSettings.h"
+#include "settings/lib/SettingHandle.h"
 #include "OverlayRenderer.h"
+#include "FrameStats.h"
 #include <deque>
 #include <map>
 #include "PlatformDefs.h"
@@ -95,10 +97,12 @@ public:
   bool Supports(ESCALINGMETHOD method);
   EINTERLACEMETHOD AutoInterlaceMethod(EINTERLACEMETHOD mInt);
 
-  static float GetMaximumFPS();
+  float GetMaximumFPS();
   double GetDisplayLatency() { return m_displayLatency; }
   int GetSkippedFrames()  { return m_QueueSkip; }
+  CFrameStats& GetFrameStats() { return m_frameStats; }
   std::string GetVSyncState();
+  std::string GetDebugInfo();
 
   // Functions called from mplayer
   /**
@@ -219,6 +223,7 @@ protected:
   {
     double         pts;
     double         timestamp;
+    int64_t        queuetime; // host counter when the frame was queued
     EFIELDSYNC     presentfield;
     EPRESENTMETHOD presentmethod;
   } m_Queue[NUM_BUFFERS];
@@ -237,6 +242,7 @@ protected:
 
   double m_sleeptime;
   double m_presentpts;
+  CFrameStats m_frameStats;
   double m_presentcorr;
   double m_presenterr;
   double m_errorbuff[ERRORBUFFSIZE];
@@ -248,6 +254,8 @@ protected:
   double m_clock_framefinish;
   CDVDClock &m_dvdClock;
   IRenderMsg *m_playerPort;
+  CSettingHandle<int> m_adjustRefreshRate;
+  CSettingHandle<int> m_vsync;
 
   void RenderCapture(CRenderCapture* capture);
   void RemoveCaptures();
@@ -0,0 +1,324 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SlicedConverter.h"
+
+#include <algorithm>
+
+#include "utils/CPUInfo.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+extern "C" {
+#include "libavutil/pixdesc.h"
+#include "libswscale/swscale.h"
+}
+
+#define SLICES_MAX       8
+// below this a slice isn't worth waking up a thread for
+#define SLICE_MIN_HEIGHT 64
+
+/* BT.601 limited range to RGB in 6 bit fixed point, matching the default
+   swscale conversion */
+#define YUV_Y  75 // 1.164
+#define YUV_RV 102 // 1.596
+#define YUV_GU 25 // 0.391
+#define YUV_GV 52 // 0.813
+#define YUV_BU 129 // 2.018
+
+static inline uint8_t Clamp(int value)
+{
+  return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+static inline void StorePixel(uint8_t *dst, int y, int u, int v)
+{
+  int luma = (y - 16) * YUV_Y + 32;
+  u -= 128;
+  v -= 128;
+  dst[0] = Clamp((luma + YUV_BU * u) >> 6);
+  dst[1] = Clamp((luma - YUV_GU * u - YUV_GV * v) >> 6);
+  dst[2] = Clamp((luma + YUV_RV * v) >> 6);
+  dst[3] = 0xFF;
+}
+
+#if defined(__SSE2__)
+/* converts 16 pixels, u and v hold 8 chroma samples as 16 bit minus 128 */
+static inline void StoreBGRA16(uint8_t *dst, __m128i y, __m128i u, __m128i v)
+{
+  const __m128i zero = _mm_setzero_si128();
+
+  __m128i rc = _mm_mullo_epi16(v, _mm_set1_epi16(YUV_RV));
+  __m128i gc = _mm_add_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(YUV_GU)),
+                             _mm_mullo_epi16(v, _mm_set1_epi16(YUV_GV)));
+  __m128i bc = _mm_mullo_epi16(u, _mm_set1_epi16(YUV_BU));
+
+  __m128i yLo = _mm_sub_epi16(_mm_unpacklo_epi8(y, zero), _mm_set1_epi16(16));
+  __m128i yHi = _mm_sub_epi16(_mm_unpackhi_epi8(y, zero), _mm_set1_epi16(16));
+  yLo = _mm_add_epi16(_mm_mullo_epi16(yLo, _mm_set1_epi16(YUV_Y)), _mm_set1_epi16(32));
+  yHi = _mm_add_epi16(_mm_mullo_epi16(yHi, _mm_set1_epi16(YUV_Y)), _mm_set1_epi16(32));
+
+  // every chroma sample covers two pixels, saturation only hits values out of range anyway
+  __m128i r = _mm_packus_epi16(_mm_srai_epi16(_mm_adds_epi16(yLo, _mm_unpacklo_epi16(rc, rc)), 6),
+                               _mm_srai_epi16(_mm_adds_epi16(yHi, _mm_unpackhi_epi16(rc, rc)), 6));
+  __m128i g = _mm_packus_epi16(_mm_srai_epi16(_mm_subs_epi16(yLo, _mm_unpacklo_epi16(gc, gc)), 6),
+                               _mm_srai_epi16(_mm_subs_epi16(yHi, _mm_unpackhi_epi16(gc, gc)), 6));
+  __m128i b = _mm_packus_epi16(_mm_srai_epi16(_mm_adds_epi16(yLo, _mm_unpacklo_epi16(bc, bc)), 6),
+                               _mm_srai_epi16(_mm_adds_epi16(yHi, _mm_unpackhi_epi16(bc, bc)), 6));
+  __m128i a = _mm_set1_epi8((char)0xFF);
+
+  __m128i bgLo = _mm_unpacklo_epi8(b, g);
+  __m128i bgHi = _mm_unpackhi_epi8(b, g);
+  __m128i raLo = _mm_unpacklo_epi8(r, a);
+  __m128i raHi = _mm_unpackhi_epi8(r, a);
+  _mm_storeu_si128((__m128i*)(dst +  0), _mm_unpacklo_epi16(bgLo, raLo));
+  _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(bgLo, raLo));
+  _mm_storeu_si128((__m128i*)(dst + 32), _mm_unpacklo_epi16(bgHi, raHi));
+  _mm_storeu_si128((__m128i*)(dst + 48), _mm_unpackhi_epi16(bgHi, raHi));
+}
+#endif
+
+CSlicedConverter::CWorker::CWorker(CSlicedConverter &owner, unsigned int slice) :
+  CThread("SlicedConverter"),
+  m_owner(owner),
+  m_slice(slice)
+{
+}
+
+void CSlicedConverter::CWorker::Process()
+{
+  while (!m_bStop)
+  {
+    if (AbortableWait(m_start) != WAIT_SIGNALED)
+      break;
+    m_owner.ConvertSlice(m_slice);
+    m_done.Set();
+  }
+  // never leave the render thread waiting
+  m_done.Set();
+}
+
+CSlicedConverter::CSlicedConverter() :
+  m_job(),
+  m_maxSlices(1),
+  m_simdSupported(false),
+  m_frameStart(0),
+  m_frameTime(0.0),
+  m_averageTime(0.0)
+{
+  m_maxSlices = std::max(1, std::min(g_cpuInfo.getCPUCount(), SLICES_MAX));
+#if defined(__SSE2__)
+  m_simdSupported = (g_cpuInfo.GetCPUFeatures() & CPU_FEATURE_SSE2) != 0;
+#endif
+}
+
+CSlicedConverter::~CSlicedConverter()
+{
+  Dispose();
+}
+
+void CSlicedConverter::Dispose()
+{
+  for (std::vector<CWorker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+  {
+    (*it)->StopThread();
+    delete *it;
+  }
+  m_workers.clear();
+
+  for (std::vector<SwsContext*>::iterator it = m_contexts.begin(); it != m_contexts.end(); ++it)
+  {
+    if (*it)
+      sws_freeContext(*it);
+  }
+  m_contexts.clear();
+  m_sliceStart.clear();
+}
+
+void CSlicedConverter::SetupSlices(int height)
+{
+  if (!m_sliceStart.empty() && m_sliceStart.back() == height)
+    return;
+
+  unsigned int slices = std::max(1U, std::min(m_maxSlices, (unsigned int)(height / SLICE_MIN_HEIGHT)));
+
+  // slice boundaries on even rows, so 4:2:0 chroma rows are never split
+  m_sliceStart.clear();
+  for (unsigned int i = 0; i < slices; i++)
+    m_sliceStart.push_back((int)((int64_t)height * i / slices) & ~1);
+  m_sliceStart.push_back(height);
+
+  // contexts depend on the slice height, free the ones we have
+  for (std::vector<SwsContext*>::iterator it = m_contexts.begin(); it != m_contexts.end(); ++it)
+  {
+    if (*it)
+      sws_freeContext(*it);
+  }
+  m_contexts.assign(slices, NULL);
+
+  while (m_workers.size() + 1 < slices)
+  {
+    CWorker *worker = new CWorker(*this, m_workers.size() + 1);
+    worker->Create();
+    m_workers.push_back(worker);
+  }
+
+  CLog::Log(LOGDEBUG, "CSlicedConverter: converting %d lines in %u slices%s", height, slices,
+            m_simdSupported ? ", sse2" : "");
+}
+
+bool CSlicedConverter::Convert(uint8_t *src[4], int srcStride[4], int srcFormat, int width, int height, uint8_t *dst, int dstStride)
+{
+  const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get((AVPixelFormat)srcFormat);
+  if (!desc || !dst || width <= 0 || height <= 0)
+    return false;
+
+  for (int i = 0; i < 4; i++)
+  {
+    m_job.src[i]       = src[i];
+    m_job.srcStride[i] = srcStride[i];
+  }
+  m_job.srcFormat    = srcFormat;
+  m_job.width        = width;
+  m_job.height       = height;
+  m_job.dst          = dst;
+  m_job.dstStride    = dstStride;
+  m_job.chromaShiftH = desc->log2_chroma_h;
+  m_job.simd         = m_simdSupported && width >= 16 &&
+                       (srcFormat == AV_PIX_FMT_YUV420P || srcFormat == AV_PIX_FMT_NV12);
+
+  SetupSlices(height);
+
+  unsigned int slices = m_sliceStart.size() - 1;
+  for (unsigned int i = 1; i < slices; i++)
+    m_workers[i - 1]->Start();
+
+  ConvertSlice(0);
+
+  for (unsigned int i = 1; i < slices; i++)
+    m_workers[i - 1]->WaitDone();
+
+  return true;
+}
+
+void CSlicedConverter::ConvertSlice(unsigned int slice)
+{
+  int rowStart = m_sliceStart[slice];
+  int rowEnd   = m_sliceStart[slice + 1];
+  if (rowEnd <= rowStart)
+    return;
+
+  if (m_job.simd && ConvertSliceSIMD(rowStart, rowEnd))
+    return;
+
+  m_contexts[slice] = sws_getCachedContext(m_contexts[slice],
+                                           m_job.width, rowEnd - rowStart, (AVPixelFormat)m_job.srcFormat,
+                                           m_job.width, rowEnd - rowStart, AV_PIX_FMT_BGRA,
+                                           SWS_FAST_BILINEAR, NULL, NULL, NULL);
+  if (!m_contexts[slice])
+    return;
+
+  // the slice is converted as a picture of its own
+  uint8_t *src[4] = {};
+  for (int i = 0; i < 4; i++)
+  {
+    if (!m_job.src[i])
+      continue;
+    int row = (i == 1 || i == 2) ? rowStart >> m_job.chromaShiftH : rowStart;
+    src[i] = m_job.src[i] + row * m_job.srcStride[i];
+  }
+  uint8_t *dst[] = { m_job.dst + rowStart * m_job.dstStride, 0, 0, 0 };
+  int dstStride[] = { m_job.dstStride, 0, 0, 0 };
+  sws_scale(m_contexts[slice], src, m_job.srcStride, 0, rowEnd - rowStart, dst, dstStride);
+}
+
+bool CSlicedConverter::ConvertSliceSIMD(int rowStart, int rowEnd)
+{
+#if defined(__SSE2__)
+  const bool nv12 = m_job.srcFormat == AV_PIX_FMT_NV12;
+  const int width = m_job.width;
+  const int vectorWidth = width & ~15;
+  const __m128i bias = _mm_set1_epi16(128);
+
+  for (int row = rowStart; row < rowEnd; row++)
+  {
+    const uint8_t *y = m_job.src[0] + row * m_job.srcStride[0];
+    const uint8_t *u = m_job.src[1] + (row >> 1) * m_job.srcStride[1];
+    const uint8_t *v = nv12 ? u + 1 : m_job.src[2] + (row >> 1) * m_job.srcStride[2];
+    uint8_t *dst = m_job.dst + row * m_job.dstStride;
+
+    int x = 0;
+    if (nv12)
+    {
+      for (; x < vectorWidth; x += 16)
+      {
+        __m128i uv = _mm_loadu_si128((const __m128i*)(u + x));
+        __m128i cu = _mm_sub_epi16(_mm_and_si128(uv, _mm_set1_epi16(0xFF)), bias);
+        __m128i cv = _mm_sub_epi16(_mm_srli_epi16(uv, 8), bias);
+        StoreBGRA16(dst + x * 4, _mm_loadu_si128((const __m128i*)(y + x)), cu, cv);
+      }
+      for (; x < width; x++)
+        StorePixel(dst + x * 4, y[x], u[x & ~1], v[x & ~1]);
+    }
+    else
+    {
+      const __m128i zero = _mm_setzero_si128();
+      for (; x < vectorWidth; x += 16)
+      {
+        __m128i cu = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(u + x / 2)), zero), bias);
+        __m128i cv = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(v + x / 2)), zero), bias);
+        StoreBGRA16(dst + x * 4, _mm_loadu_si128((const __m128i*)(y + x)), cu, cv);
+      }
+      for (; x < width; x++)
+        StorePixel(dst + x * 4, y[x], u[x / 2], v[x / 2]);
+    }
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CSlicedConverter::BeginFrame()
+{
+  m_frameStart = CurrentHostCounter();
+}
+
+void CSlicedConverter::EndFrame()
+{
+  m_frameTime = (double)(CurrentHostCounter() - m_frameStart) * 1000.0 / CurrentHostFrequency();
+  if (m_averageTime == 0.0)
+    m_averageTime = m_frameTime;
+  else
+    m_averageTime += (m_frameTime - m_averageTime) * 0.1;
+}
+
+std::string CSlicedConverter::GetInfo() const
+{
+  unsigned int slices = m_sliceStart.empty() ? 0 : m_sliceStart.size() - 1;
+  return StringUtils::Format("yuv2rgb:%.2fms avg:%.2fms slices:%u%s",
+                             m_frameTime, m_averageTime, slices,
+                             m_job.simd && slices ? " sse2" : "");
+}
@@ -0,0 +1,123 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+struct SwsContext;
+
+/*!
+ \brief Software YUV to BGRA conversion split into horizontal slices.
+
+ Used by the software render path. The picture is cut into one slice per
+ core, the calling thread converts the first slice and a set of worker
+ threads the others. 8 bit 4:2:0 pictures (yuv420p, nv12) use an SSE2 kernel
+ when available, everything else goes through one swscale context per slice.
+
+ Not thread safe, Convert() is meant to be called from the render thread only.
+ */
+class CSlicedConverter
+{
+public:
+  CSlicedConverter();
+  ~CSlicedConverter();
+
+  /*!
+   \brief Convert a picture to BGRA of the same size.
+   \param src source planes.
+   \param srcStride source line sizes in bytes.
+   \param srcFormat source AVPixelFormat.
+   \param width width of the picture.
+   \param height height of the picture.
+   \param dst destination buffer.
+   \param dstStride destination line size in bytes.
+   \return false if the conversion could not be set up.
+   */
+  bool Convert(uint8_t *src[4], int srcStride[4], int srcFormat, int width, int height, uint8_t *dst, int dstStride);
+
+  /*!
+   \brief Mark the start of a frame, conversions until EndFrame() are timed together.
+   */
+  void BeginFrame();
+  void EndFrame();
+
+  /*!
+   \brief Conversion statistics for the codec info overlay.
+   */
+  std::string GetInfo() const;
+
+  /*!
+   \brief Stop the workers and free the swscale contexts.
+   */
+  void Dispose();
+
+private:
+  CSlicedConverter(const CSlicedConverter&);
+  CSlicedConverter& operator=(const CSlicedConverter&);
+
+  class CWorker : public CThread
+  {
+  public:
+    CWorker(CSlicedConverter &owner, unsigned int slice);
+    void Start() { m_done.Reset(); m_start.Set(); }
+    void WaitDone() { m_done.Wait(); }
+  protected:
+    virtual void Process();
+  private:
+    CSlicedConverter &m_owner;
+    unsigned int m_slice;
+    CEvent m_start;
+    CEvent m_done;
+  };
+
+  void SetupSlices(int height);
+  void ConvertSlice(unsigned int slice);
+  bool ConvertSliceSIMD(int rowStart, int rowEnd);
+
+  struct Job
+  {
+    uint8_t *src[4];
+    int srcStride[4];
+    int srcFormat;
+    int width;
+    int height;
+    uint8_t *dst;
+    int dstStride;
+    int chromaShiftH;
+    bool simd;
+  };
+
+  Job m_job;
+  unsigned int m_maxSlices;
+  std::vector<int> m_sliceStart;          ///< first row of each slice, plus the picture height
+  std::vector<SwsContext*> m_contexts;    ///< per slice swscale contexts
+  std::vector<CWorker*> m_workers;        ///< worker for slice i + 1
+  bool m_simdSupported;
+
+  int64_t m_frameStart;
+  double m_frameTime;                     ///< last frame, ms
+  double m_averageTime;                   ///< smoothed, ms
+};
@@ -0,0 +1,95 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <vector>
+
+#include "cores/VideoPlayer/DVDMediaProbe.h"
+
+#include "gtest/gtest.h"
+
+class TestDVDMediaProbe : public testing::Test
+{
+protected:
+  size_t GetIdleCount() const
+  {
+    return m_probe.m_idle.size();
+  }
+
+  // a probe of its own rather than the shared instance
+  CDVDMediaProbe m_probe;
+};
+
+TEST_F(TestDVDMediaProbe, ReuseContext)
+{
+  m_probe.AddUser();
+
+  CDVDMediaProbeContext *context = m_probe.AcquireContext();
+  ASSERT_TRUE(context != NULL);
+  m_probe.ReleaseContext(context);
+  EXPECT_EQ(1u, GetIdleCount());
+
+  // the next probe gets the same context
+  EXPECT_EQ(context, m_probe.AcquireContext());
+  EXPECT_EQ(0u, GetIdleCount());
+  m_probe.ReleaseContext(context);
+
+  m_probe.RemoveUser();
+  EXPECT_EQ(0u, GetIdleCount());
+}
+
+TEST_F(TestDVDMediaProbe, KeepMaxWorkers)
+{
+  m_probe.AddUser();
+
+  std::vector<CDVDMediaProbeContext*> contexts;
+  for (unsigned int i = 0; i < m_probe.GetMaxWorkers() + 1; i++)
+    contexts.push_back(m_probe.AcquireContext());
+  for (std::vector<CDVDMediaProbeContext*>::iterator it = contexts.begin(); it != contexts.end(); ++it)
+    m_probe.ReleaseContext(*it);
+  EXPECT_EQ(m_probe.GetMaxWorkers(), GetIdleCount());
+
+  m_probe.RemoveUser();
+  EXPECT_EQ(0u, GetIdleCount());
+}
+
+TEST_F(TestDVDMediaProbe, ReleaseWithLastUser)
+{
+  // two loaders extracting at the same time
+  m_probe.AddUser();
+  m_probe.AddUser();
+
+  m_probe.ReleaseContext(m_probe.AcquireContext());
+  EXPECT_EQ(1u, GetIdleCount());
+
+  // one loader is done, the other one still reuses the context
+  m_probe.RemoveUser();
+  EXPECT_EQ(1u, GetIdleCount());
+  CDVDMediaProbeContext *context = m_probe.AcquireContext();
+  EXPECT_EQ(0u, GetIdleCount());
+
+  // the last loader is done while its probe is still running
+  m_probe.RemoveUser();
+  m_probe.ReleaseContext(context);
+  EXPECT_EQ(0u, GetIdleCount());
+
+  // without users contexts aren't kept at all
+  m_probe.ReleaseContext(m_probe.AcquireContext());
+  EXPECT_EQ(0u, GetIdleCount());
+}
@@ -0,0 +1,137 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <vector>
+
+#include "cores/VideoPlayer/DVDSubtitles/DVDSubtitleLineCollection.h"
+
+#include "gtest/gtest.h"
+
+class TestDVDSubtitleLineCollection : public testing::Test
+{
+protected:
+  CDVDOverlay* Add(double start, double stop)
+  {
+    CDVDOverlay* overlay = new CDVDOverlay(DVDOVERLAY_TYPE_TEXT);
+    overlay->iPTSStartTime = start;
+    overlay->iPTSStopTime = stop;
+    m_collection.Add(overlay);
+    return overlay;
+  }
+
+  // the cue shown first at pts after a seek
+  CDVDOverlay* Seek(double pts)
+  {
+    m_collection.Reset();
+    return m_collection.Get(pts);
+  }
+
+  CDVDSubtitleLineCollection m_collection;
+};
+
+TEST_F(TestDVDSubtitleLineCollection, Boundaries)
+{
+  CDVDOverlay* first = Add(1000.0, 2000.0);
+  CDVDOverlay* second = Add(3000.0, 4000.0);
+
+  // cues that haven't started yet are returned ahead of time
+  EXPECT_EQ(first, Seek(0.0));
+  EXPECT_EQ(first, Seek(1000.0));
+  // a cue is still returned at its stop time, but not after it
+  EXPECT_EQ(first, Seek(2000.0));
+  EXPECT_EQ(second, Seek(2000.5));
+  EXPECT_EQ(second, Seek(3000.0));
+  EXPECT_EQ(second, Seek(4000.0));
+  EXPECT_TRUE(Seek(4000.5) == NULL);
+
+  // each cue is returned once
+  EXPECT_EQ(first, Seek(1500.0));
+  EXPECT_EQ(second, m_collection.Get(1500.0));
+  EXPECT_TRUE(m_collection.Get(1500.0) == NULL);
+}
+
+TEST_F(TestDVDSubtitleLineCollection, Empty)
+{
+  EXPECT_TRUE(Seek(0.0) == NULL);
+  EXPECT_TRUE(Seek(1000.0) == NULL);
+  EXPECT_EQ(0, m_collection.GetSize());
+}
+
+TEST_F(TestDVDSubtitleLineCollection, OverlappingCues)
+{
+  CDVDOverlay* song = Add(0.0, 10000.0);
+  Add(1000.0, 2000.0);
+  CDVDOverlay* line = Add(3000.0, 4000.0);
+  CDVDOverlay* last = Add(5000.0, 12000.0);
+
+  // the long cue is still shown, the short one ended before it
+  EXPECT_EQ(song, Seek(3500.0));
+  EXPECT_EQ(line, m_collection.Get(3500.0));
+  EXPECT_EQ(last, m_collection.Get(3500.0));
+  EXPECT_TRUE(m_collection.Get(3500.0) == NULL);
+
+  // only the long cues are left
+  EXPECT_EQ(song, Seek(9000.0));
+  EXPECT_EQ(last, m_collection.Get(9000.0));
+
+  EXPECT_EQ(last, Seek(11000.0));
+  EXPECT_TRUE(m_collection.Get(11000.0) == NULL);
+}
+
+TEST_F(TestDVDSubtitleLineCollection, UnsortedCues)
+{
+  CDVDOverlay* third = Add(5000.0, 6000.0);
+  CDVDOverlay* first = Add(1000.0, 2000.0);
+  CDVDOverlay* second = Add(3000.0, 4000.0);
+  // cues starting at the same time keep the order of the file
+  CDVDOverlay* fourth = Add(5000.0, 5500.0);
+
+  EXPECT_EQ(first, Seek(0.0));
+  EXPECT_EQ(second, m_collection.Get(0.0));
+  EXPECT_EQ(third, m_collection.Get(0.0));
+  EXPECT_EQ(fourth, m_collection.Get(0.0));
+  EXPECT_TRUE(m_collection.Get(0.0) == NULL);
+}
+
+TEST_F(TestDVDSubtitleLineCollection, Seek)
+{
+  std::vector<CDVDOverlay*> cues;
+  for (int i = 0; i < 100; i++)
+    cues.push_back(Add(i * 1000.0, i * 1000.0 + 500.0));
+
+  // playing without seeks skips the cues that ended in between
+  EXPECT_EQ(cues[0], Seek(0.0));
+  EXPECT_EQ(cues[10], m_collection.Get(10000.0));
+  EXPECT_EQ(cues[51], m_collection.Get(50600.0));
+
+  // seeking back finds the earlier cues again
+  EXPECT_EQ(cues[20], Seek(20500.0));
+  EXPECT_EQ(cues[21], m_collection.Get(20500.0));
+  EXPECT_EQ(cues[5], Seek(4600.0));
+
+  // seeking forward
+  EXPECT_EQ(cues[90], Seek(90000.0));
+  EXPECT_EQ(cues[99], Seek(99500.0));
+  EXPECT_TRUE(Seek(100000.0) == NULL);
+
+  // cues added after a lookup are found as well
+  CDVDOverlay* cue = Add(100000.0, 101000.0);
+  EXPECT_EQ(cue, Seek(100000.0));
+}
@@ -0,0 +1,137 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+
+#include "cores/VideoPlayer/DVDSubtitles/DVDSubtitleStream.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+#include "utils/StringUtils.h"
+
+#include "gtest/gtest.h"
+
+class TestDVDSubtitleStream : public testing::Test
+{
+protected:
+  TestDVDSubtitleStream()
+    : m_file(NULL)
+  { }
+
+  ~TestDVDSubtitleStream()
+  {
+    XBMC_DELETETEMPFILE(m_file);
+  }
+
+  // writes numbered lines, enough to need several chunks
+  bool CreateFile(int lines)
+  {
+    m_file = XBMC_CREATETEMPFILE(".srt");
+    if (!m_file)
+      return false;
+
+    std::string text;
+    for (int i = 0; i < lines; i++)
+      text += StringUtils::Format("line %d\n", i);
+    bool written = m_file->Write(text.c_str(), text.size()) == (ssize_t)text.size();
+    m_file->Close();
+    return written;
+  }
+
+  std::string GetPath() const
+  {
+    return XBMC_TEMPFILEPATH(m_file);
+  }
+
+  bool IsFileOpen() const
+  {
+    return m_stream.m_pInputStream != nullptr;
+  }
+
+  std::string ReadLine()
+  {
+    char line[256];
+    return m_stream.ReadLine(line, sizeof(line)) ? line : "<eof>";
+  }
+
+  XFILE::CFile* m_file;
+  CDVDSubtitleStream m_stream;
+};
+
+TEST_F(TestDVDSubtitleStream, CloseAtEnd)
+{
+  const int lines = 20000;
+  ASSERT_TRUE(CreateFile(lines));
+  ASSERT_TRUE(m_stream.Open(GetPath()));
+  EXPECT_TRUE(IsFileOpen());
+
+  for (int i = 0; i < lines; i++)
+    ASSERT_EQ(StringUtils::Format("line %d", i), ReadLine());
+  EXPECT_EQ("<eof>", ReadLine());
+
+  // the file isn't kept open once it has been read
+  EXPECT_FALSE(IsFileOpen());
+}
+
+TEST_F(TestDVDSubtitleStream, SeekAfterEnd)
+{
+  const int lines = 20000;
+  ASSERT_TRUE(CreateFile(lines));
+  ASSERT_TRUE(m_stream.Open(GetPath()));
+
+  while (ReadLine() != "<eof>")
+    ;
+  ASSERT_FALSE(IsFileOpen());
+
+  // seeking back before the buffered text opens the file again
+  EXPECT_EQ(0, m_stream.Seek(0, SEEK_SET));
+  EXPECT_EQ("line 0", ReadLine());
+  EXPECT_EQ("line 1", ReadLine());
+
+  long pos = m_stream.Seek(0, SEEK_CUR);
+  EXPECT_EQ((long)(std::string("line 0\nline 1\n").size()), pos);
+  EXPECT_EQ("line 2", ReadLine());
+  EXPECT_EQ(pos, m_stream.Seek(pos, SEEK_SET));
+  EXPECT_EQ("line 2", ReadLine());
+
+  // the last line and its line end
+  std::string last = StringUtils::Format("line %d", lines - 1);
+  pos = m_stream.Seek(-(long)last.size() - 1, SEEK_END);
+  EXPECT_EQ(pos, m_stream.Seek(0, SEEK_CUR));
+  EXPECT_FALSE(IsFileOpen());
+  EXPECT_EQ(last, ReadLine());
+  EXPECT_EQ("<eof>", ReadLine());
+}
+
+TEST_F(TestDVDSubtitleStream, SmallFile)
+{
+  ASSERT_TRUE(CreateFile(3));
+  ASSERT_TRUE(m_stream.Open(GetPath()));
+
+  EXPECT_EQ("line 0", ReadLine());
+  std::string text;
+  EXPECT_TRUE(m_stream.ReadRemaining(text));
+  EXPECT_EQ("line 1\nline 2\n", text);
+  EXPECT_FALSE(IsFileOpen());
+
+  // small files are kept in memory, seeking back doesn't open them again
+  EXPECT_EQ(0, m_stream.Seek(0, SEEK_SET));
+  EXPECT_FALSE(IsFileOpen());
+  EXPECT_EQ("line 0", ReadLine());
+}
@@ -18,6 +18,8 @@
  *
  */
 
+#include <map>
+
 #include "Database.h"
 #include "settings/AdvancedSettings.h"
 #include "filesystem/SpecialProtocol.h"
@@ -41,6 +43,7 @@
 using namespace dbiplus;
 
 #define MAX_COMPRESS_COUNT 20
+#define MAX_CHANGELOG_ENTRIES 50000
 
 void CDatabase::Filter::AppendField(const std::string &strField)
 {
@@ -299,6 +302,24 @@ bool CDatabase::CommitInsertQueries()
   return bReturn;
 }
 
+std::unique_ptr<dbiplus::Statement> CDatabase::PrepareStatement(const std::string &strQuery)
+{
+  std::unique_ptr<dbiplus::Statement> statement;
+
+  try
+  {
+    if (NULL != m_pDB.get())
+      statement.reset(m_pDB->prepare_statement(strQuery));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to prepare query '%s'",
+        __FUNCTION__, strQuery.c_str());
+  }
+
+  return statement;
+}
+
 bool CDatabase::Open()
 {
   DatabaseSettings db_fallback;
@@ -747,3 +768,94 @@ bool CDatabase::BuildSQL(const std::string &strBaseDir, const std::string &strQu
 
   return BuildSQL(strQuery, filter, strSQL);
 }
+
+int CDatabase::GetLibraryRevision()
+{
+  std::string revision = GetSingleValue("SELECT MAX(idChange) FROM changelog", m_pDS);
+  if (revision.empty())
+    return -1;
+
+  return (int)strtol(revision.c_str(), NULL, 10);
+}
+
+bool CDatabase::GetLibraryChanges(int revision, const std::string &mediaType, std::vector<int> &added, std::vector<int> &changed, std::vector<int> &removed)
+{
+  // the changes since revisions before the oldest entry
+  // have been removed or happened before it was created
+  std::string oldest = GetSingleValue("SELECT MIN(idChange) FROM changelog", m_pDS);
+  if (oldest.empty() || revision < (int)strtol(oldest.c_str(), NULL, 10))
+    return false;
+
+  try
+  {
+    if (!m_pDB.get() || !m_pDS.get())
+      return false;
+
+    std::string sql = PrepareSQL("SELECT media_id, changeType FROM changelog WHERE idChange > %i AND media_type = '%s' ORDER BY idChange",
+                                 revision, mediaType.c_str());
+    if (!m_pDS->query(sql))
+      return false;
+
+    // the first and the last change of every item
+    std::map<int, std::pair<std::string, std::string> > changes;
+    while (!m_pDS->eof())
+    {
+      int id = m_pDS->fv(0).get_asInt();
+      std::string change = m_pDS->fv(1).get_asString();
+
+      std::map<int, std::pair<std::string, std::string> >::iterator it = changes.find(id);
+      if (it == changes.end())
+        changes.insert(std::make_pair(id, std::make_pair(change, change)));
+      else
+        it->second.second = change;
+
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    for (std::map<int, std::pair<std::string, std::string> >::const_iterator it = changes.begin(); it != changes.end(); ++it)
+    {
+      if (it->second.second == "removed")
+      {
+        // items added and removed after the revision never existed for the client
+        if (it->second.first != "added")
+          removed.push_back(it->first);
+      }
+      else if (it->second.first == "added")
+        added.push_back(it->first);
+      else
+        changed.push_back(it->first);
+    }
+
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed for revision %i", __FUNCTION__, revision);
+  }
+  return false;
+}
+
+void CDatabase::CreateChangelogTable()
+{
+  CLog::Log(LOGINFO, "create changelog table");
+  m_pDS->exec("CREATE TABLE changelog (idChange INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, changeType TEXT)");
+  m_pDS->exec("INSERT INTO changelog (media_id, media_type, changeType) VALUES (0, '', 'created')");
+}
+
+void CDatabase::CreateChangelogTriggers(const std::string &table, const std::string &idColumn, const std::string &mediaType)
+{
+  m_pDS->exec(PrepareSQL("CREATE TRIGGER changelog_%s_insert AFTER INSERT ON %s FOR EACH ROW BEGIN "
+                         "INSERT INTO changelog (media_id, media_type, changeType) VALUES (new.%s, '%s', 'added'); "
+                         "END", table.c_str(), table.c_str(), idColumn.c_str(), mediaType.c_str()));
+  m_pDS->exec(PrepareSQL("CREATE TRIGGER changelog_%s_update AFTER UPDATE ON %s FOR EACH ROW BEGIN "
+                         "INSERT INTO changelog (media_id, media_type, changeType) VALUES (new.%s, '%s', 'changed'); "
+                         "END", table.c_str(), table.c_str(), idColumn.c_str(), mediaType.c_str()));
+}
+
+void CDatabase::CleanChangelog()
+{
+  int revision = GetLibraryRevision();
+  if (revision > MAX_CHANGELOG_ENTRIES)
+    ExecuteQuery(PrepareSQL("DELETE FROM changelog WHERE idChange <= %i", revision - MAX_CHANGELOG_ENTRIES));
+}
@@ -23,6 +23,7 @@
 namespace dbiplus {
   class Database;
   class Dataset;
+  class Statement;
 }
 
 #include <memory>
@@ -157,6 +158,40 @@ public:
    */
   bool CommitInsertQueries();
 
+  /*!
+   * @brief Prepare a statement that is executed many times with different values.
+   * @param strQuery The statement with '?' placeholders for the values.
+   * @return The statement or an empty pointer if it couldn't be prepared. It has to be
+   *         destroyed before the database is closed.
+   */
+  std::unique_ptr<dbiplus::Statement> PrepareStatement(const std::string &strQuery);
+
+  /*!
+   * @brief Get the current revision of a library keeping a changelog table.
+   *        The revision changes whenever an item of the library is added,
+   *        changed or removed.
+   * @return The revision or -1 if it couldn't be retrieved.
+   * @sa GetLibraryChanges
+   */
+  int GetLibraryRevision();
+
+  /*!
+   * @brief Get the items of a media type added, changed or removed after the given revision.
+   * @param revision The revision returned by GetLibraryRevision() before.
+   * @param mediaType The media type of the items (eg "movie").
+   * @param added The items added after the revision.
+   * @param changed The items changed after the revision.
+   * @param removed The items removed after the revision.
+   * @return True if the changes were retrieved, false if they aren't available (anymore).
+   */
+  bool GetLibraryChanges(int revision, const std::string &mediaType, std::vector<int> &added, std::vector<int> &changed, std::vector<int> &removed);
+
+  /*!
+   * @brief Remove the oldest entries of the changelog table.
+   *        Called at the end of every scan and clean of the library.
+   */
+  void CleanChangelog();
+
   virtual bool GetFilter(CDbUrl &dbUrl, Filter &filter, SortDescription &sorting) { return true; }
   virtual bool BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl);
   virtual bool BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl, SortDescription &sorting);
@@ -204,6 +239,17 @@ protected:
 
   bool BuildSQL(const std::string &strQuery, const Filter &filter, std::string &strSQL);
 
+  /*! \brief Create the changelog table used to determine the library revision.
+   The changes before its creation are not available.
+   */
+  void CreateChangelogTable();
+
+  /*! \brief Create the triggers logging the items of a table added or changed.
+   Removed items have to be logged by the delete trigger of the table as
+   not all databases support multiple triggers for the same event.
+   */
+  void CreateChangelogTriggers(const std::string &table, const std::string &idColumn, const std::string &mediaType);
+
   bool m_sqlite; ///< \brief whether we use sqlite (defaults to true)
 
   std::unique_ptr<dbiplus::Database> m_pDB;
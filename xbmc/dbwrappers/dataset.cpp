@@ -30,6 +30,8 @@
 #include "utils/log.h"
 #include <cstring>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 #ifndef __GNUC__
 #pragma warning (disable:4800)
@@ -82,6 +84,56 @@ std::string Database::prepare(const char *format, ...)
   return result;
 }
 
+namespace {
+/* formats the bound values into the statement text for databases without prepared statements */
+class FormattedStatement : public Statement {
+public:
+  FormattedStatement(Database &db, const std::string &sql) : db(db), ds(db.CreateDataset()) {
+    size_t start = 0, pos;
+    while ((pos = sql.find('?', start)) != std::string::npos) {
+      parts.push_back(sql.substr(start, pos - start));
+      start = pos + 1;
+    }
+    parts.push_back(sql.substr(start));
+    values.resize(parts.size() - 1, "NULL");
+  }
+
+  virtual void bind(int index, int64_t value) {
+    set(index, db.prepare("%lld", static_cast<long long>(value)));
+  }
+
+  virtual void bind(int index, const std::string &value) {
+    set(index, db.prepare("'%s'", value.c_str()));
+  }
+
+  virtual void exec() {
+    std::string sql(parts[0]);
+    for (unsigned int i = 0; i < values.size(); i++)
+      sql += values[i] + parts[i + 1];
+    ds->exec(sql);
+  }
+
+  virtual int64_t lastinsertid() { return ds->lastinsertid(); }
+
+private:
+  void set(int index, const std::string &value) {
+    if (index < 1 || index > (int)values.size())
+      throw DbErrors("Bind index %d out of range", index);
+    values[index - 1] = value;
+  }
+
+  Database &db;
+  std::unique_ptr<Dataset> ds;
+  std::vector<std::string> parts;
+  std::vector<std::string> values;
+};
+}
+
+Statement *Database::prepare_statement(const std::string &sql)
+{
+  return new FormattedStatement(*this, sql);
+}
+
 //************* Dataset implementation ***************
 
 Dataset::Dataset():
@@ -55,6 +55,25 @@ class Dataset;		// forward declaration of class Dataset
 #define DB_UNEXPECTED		7	// This shouldn't ever happen
 #define DB_UNEXPECTED_RESULT   -1       //For integer functions
 
+/******************* Class Statement definition *******************
+
+   a statement that is parsed once and executed many times with
+   different values bound to its '?' placeholders
+
+******************************************************************/
+class Statement  {
+public:
+/* destructor */
+  virtual ~Statement() {}
+/* binds a value to the placeholder at index, the first one is 1 */
+  virtual void bind(int index, int64_t value) = 0;
+  virtual void bind(int index, const std::string &value) = 0;
+/* executes the statement with the bound values, throws DbErrors on failure */
+  virtual void exec() = 0;
+/* last inserted id */
+  virtual int64_t lastinsertid() = 0;
+};
+
 /******************* Class Database definition ********************
 
    represents  connection with database server;
@@ -162,6 +181,13 @@ public:
    */
   virtual std::string vprepare(const char *format, va_list args) = 0;
 
+  /*! \brief Prepare a statement that is executed many times with different values.
+   \param sql - statement with '?' placeholders for the values, it must not contain other question marks.
+   \return statement owned by the caller, it must be deleted before the database is disconnected.
+   The default implementation formats the values into the statement with vprepare() on every execution.
+   */
+  virtual Statement *prepare_statement(const std::string &sql);
+
   virtual bool in_transaction() {return false;};
 
 };
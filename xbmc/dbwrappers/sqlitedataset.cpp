@@ -449,6 +449,61 @@ std::string SqliteDatabase::vprepare(const char *format, va_list args)
 }
 
 
+namespace {
+class SqliteStatement : public Statement {
+public:
+  SqliteStatement(SqliteDatabase &db, sqlite3_stmt *stmt, const std::string &sql) : db(db), stmt(stmt), sql(sql) {}
+
+  virtual ~SqliteStatement() {
+    sqlite3_finalize(stmt);
+  }
+
+  virtual void bind(int index, int64_t value) {
+    check(sqlite3_bind_int64(stmt, index, value));
+  }
+
+  virtual void bind(int index, const std::string &value) {
+    check(sqlite3_bind_text(stmt, index, value.c_str(), value.size(), SQLITE_TRANSIENT));
+  }
+
+  virtual void exec() {
+    int res = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    if (res != SQLITE_DONE && res != SQLITE_ROW)
+      check(res);
+  }
+
+  virtual int64_t lastinsertid() {
+    return sqlite3_last_insert_rowid(db.getHandle());
+  }
+
+private:
+  void check(int res) {
+    if (db.setErr(res, sql.c_str()) != SQLITE_OK)
+      throw DbErrors(db.getErrorMsg());
+  }
+
+  SqliteDatabase &db;
+  sqlite3_stmt *stmt;
+  std::string sql;
+};
+}
+
+Statement *SqliteDatabase::prepare_statement(const std::string &sql)
+{
+  if (!active) throw DbErrors("No Database Connection");
+
+  sqlite3_stmt *stmt = NULL;
+  if (setErr(sqlite3_prepare_v2(conn, sql.c_str(), -1, &stmt, NULL), sql.c_str()) != SQLITE_OK)
+  {
+    sqlite3_finalize(stmt);
+    throw DbErrors(getErrorMsg());
+  }
+
+  return new SqliteStatement(*this, stmt, sql);
+}
+
+
 //************* SqliteDataset implementation ***************
 
 SqliteDataset::SqliteDataset():Dataset() {
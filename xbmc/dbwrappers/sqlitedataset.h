@@ -94,6 +94,9 @@ public:
 /* virtual methods for formatting */
   virtual std::string vprepare(const char *format, va_list args);
 
+/* prepared statements, parsed by sqlite once */
+  virtual Statement *prepare_statement(const std::string &sql);
+
   bool in_transaction() {return _in_transaction;}; 	
 
 };
@@ -0,0 +1,183 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <string>
+
+#include "dbwrappers/dataset.h"
+#include "epg/EpgDatabase.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+using namespace dbiplus;
+
+// the EPG database with its real schema, created in special://temp
+class CTestEpgDatabase : public EPG::CEpgDatabase
+{
+public:
+  virtual bool Open()
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    settings.name = "TestSqliteDataset";
+    return Update(settings);
+  }
+
+  void Delete()
+  {
+    std::string file = URIUtils::AddFileToFolder(m_pDB->getHostName(), m_pDB->getDatabase());
+    Close();
+    XFILE::CFile::Delete(file);
+  }
+
+  Database &GetDB()
+  {
+    return *m_pDB;
+  }
+};
+
+class TestSqliteDataset : public testing::Test
+{
+protected:
+  TestSqliteDataset()
+  {
+    m_database.Open();
+  }
+
+  ~TestSqliteDataset()
+  {
+    m_database.Delete();
+  }
+
+  std::string Get(const std::string &strQuery)
+  {
+    return m_database.GetSingleValue(strQuery);
+  }
+
+  CTestEpgDatabase m_database;
+};
+
+TEST_F(TestSqliteDataset, Statement)
+{
+  ASSERT_TRUE(m_database.IsOpen());
+  Database &db = m_database.GetDB();
+
+  std::unique_ptr<Statement> insert(db.prepare_statement("INSERT INTO epgtags (idEpg, iStartTime, sTitle, sPlot) VALUES (?, ?, ?, ?)"));
+  ASSERT_TRUE(insert.get() != NULL);
+
+  insert->bind(1, 1);
+  insert->bind(2, 1000);
+  insert->bind(3, "Tom's \"show\"");
+  insert->bind(4, "");
+  insert->exec();
+  EXPECT_EQ(1, insert->lastinsertid());
+
+  // values are kept until they're bound again
+  insert->bind(2, 2000);
+  insert->exec();
+  EXPECT_EQ(2, insert->lastinsertid());
+
+  EXPECT_EQ("2", Get("SELECT COUNT(*) FROM epgtags"));
+  EXPECT_EQ("Tom's \"show\"", Get("SELECT sTitle FROM epgtags WHERE iStartTime = 2000"));
+
+  // constraint violations and bad placeholders throw
+  EXPECT_THROW(insert->exec(), DbErrors);
+  EXPECT_THROW(insert->bind(5, 1), DbErrors);
+  EXPECT_THROW(db.prepare_statement("INSERT INTO missing VALUES (?)"), DbErrors);
+
+  // the statement still works after an error
+  insert->bind(2, 3000);
+  insert->exec();
+  EXPECT_EQ("3", Get("SELECT COUNT(*) FROM epgtags"));
+}
+
+TEST_F(TestSqliteDataset, FormattedStatement)
+{
+  ASSERT_TRUE(m_database.IsOpen());
+  Database &db = m_database.GetDB();
+
+  // the statement of databases without prepared statements
+  std::unique_ptr<Statement> insert(db.Database::prepare_statement("INSERT INTO epgtags (idEpg, iStartTime, sTitle, sPlot) VALUES (?, ?, ?, ?)"));
+  ASSERT_TRUE(insert.get() != NULL);
+
+  insert->bind(1, 1);
+  insert->bind(2, 1000);
+  insert->bind(3, "Tom's \"show\"");
+  insert->exec();
+  EXPECT_EQ(1, insert->lastinsertid());
+
+  EXPECT_EQ("Tom's \"show\"", Get("SELECT sTitle FROM epgtags WHERE iStartTime = 1000"));
+  // unbound values are NULL
+  EXPECT_EQ("1", Get("SELECT COUNT(*) FROM epgtags WHERE sPlot IS NULL"));
+
+  EXPECT_THROW(insert->bind(0, 1), DbErrors);
+  EXPECT_THROW(insert->bind(5, 1), DbErrors);
+}
+
+// only runs with --gtest_also_run_disabled_tests
+TEST_F(TestSqliteDataset, DISABLED_Benchmark)
+{
+  // an update of the guide of 20 channels with 100 shows each
+  const int iChannels = 20;
+  const int iShows = 100;
+  const std::string strPlot(400, 'x');
+  ASSERT_TRUE(m_database.IsOpen());
+
+  int64_t start = CurrentHostCounter();
+  for (int iChannel = 0; iChannel < iChannels; iChannel++)
+  {
+    for (int iShow = 0; iShow < iShows; iShow++)
+      m_database.QueueInsertQuery(m_database.PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, sTitle, sPlot) VALUES (%i, %i, '%s', '%s')",
+                                                        iChannel, iShow * 1800, StringUtils::Format("Show %d", iShow).c_str(), strPlot.c_str()));
+  }
+  EXPECT_TRUE(m_database.CommitInsertQueries());
+  int64_t queued = CurrentHostCounter() - start;
+  EXPECT_EQ(StringUtils::Format("%d", iChannels * iShows), Get("SELECT COUNT(*) FROM epgtags"));
+
+  start = CurrentHostCounter();
+  std::unique_ptr<Statement> replace(m_database.PrepareStatement("REPLACE INTO epgtags (idEpg, iStartTime, sTitle, sPlot) VALUES (?, ?, ?, ?)"));
+  ASSERT_TRUE(replace.get() != NULL);
+  m_database.BeginTransaction();
+  for (int iChannel = 0; iChannel < iChannels; iChannel++)
+  {
+    for (int iShow = 0; iShow < iShows; iShow++)
+    {
+      replace->bind(1, iChannel);
+      replace->bind(2, iShow * 1800);
+      replace->bind(3, StringUtils::Format("Show %d", iShow));
+      replace->bind(4, strPlot);
+      replace->exec();
+    }
+  }
+  EXPECT_TRUE(m_database.CommitTransaction());
+  int64_t prepared = CurrentHostCounter() - start;
+  EXPECT_EQ(StringUtils::Format("%d", iChannels * iShows), Get("SELECT COUNT(*) FROM epgtags"));
+
+  CLog::Log(LOGNOTICE, "TestSqliteDataset: %d rows, queued queries: %.1f ms, prepared statement: %.1f ms",
+            iChannels * iShows, 1000.0 * queued / CurrentHostFrequency(), 1000.0 * prepared / CurrentHostFrequency());
+}
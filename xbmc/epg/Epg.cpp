@@ -328,11 +328,14 @@ bool CEpg::UpdateEntry(const CEpgInfoTag &tag, bool bUpdateDatabase /* = false *
     bNewTag = true;
   }
 
+  /* only write tags that aren't in the database like this yet */
+  bool bPersist = bNewTag || infoTag->BroadcastId() <= 0 || infoTag->DiffersInDatabase(tag);
+
   infoTag->Update(tag, bNewTag);
   infoTag->SetEpg(this);
   infoTag->SetPVRChannel(m_pvrChannel);
 
-  if (bUpdateDatabase)
+  if (bUpdateDatabase && bPersist)
     m_changedTags.insert(make_pair(infoTag->UniqueBroadcastID(), infoTag));
 
   return true;
@@ -526,6 +529,7 @@ bool CEpg::Persist(void)
     return false;
   }
 
+  bool bReturn;
   {
     CSingleLock lock(m_critSection);
     if (m_iEpgID <= 0 || m_bChanged)
@@ -535,11 +539,7 @@ bool CEpg::Persist(void)
         m_iEpgID = iId;
     }
 
-    for (std::map<int, CEpgInfoTagPtr>::iterator it = m_deletedTags.begin(); it != m_deletedTags.end(); ++it)
-      database->Delete(*it->second);
-
-    for (std::map<int, CEpgInfoTagPtr>::iterator it = m_changedTags.begin(); it != m_changedTags.end(); ++it)
-      it->second->Persist(false);
+    bReturn = database->PersistTags(m_changedTags, m_deletedTags);
 
     if (m_bUpdateLastScanTime)
       database->PersistLastEpgScanTime(m_iEpgID, true);
@@ -551,7 +551,7 @@ bool CEpg::Persist(void)
     m_bUpdateLastScanTime = false;
   }
 
-  return database->CommitInsertQueries();
+  return database->CommitInsertQueries() && bReturn;
 }
 
 CDateTime CEpg::GetFirstDate(void) const
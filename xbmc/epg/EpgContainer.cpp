@@ -36,6 +36,7 @@
 #include "settings/Settings.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 
 
 using namespace EPG;
@@ -293,15 +294,22 @@ bool CEpgContainer::PersistAll(void)
   auto copy = m_epgs;
   m_critSection.unlock();
 
+  int64_t start = CurrentHostCounter();
+  unsigned int iPersisted = 0;
   for (EPGMAP::const_iterator it = copy.begin(); it != copy.end() && !m_bStop; ++it)
   {
     CEpgPtr epg = it->second;
     if (epg && epg->NeedsSave())
     {
       bReturn &= epg->Persist();
+      iPersisted++;
     }
   }
 
+  if (iPersisted > 0)
+    CLog::Log(LOGDEBUG, "EPG - %s - persisted %u of %u tables in %.1f ms", __FUNCTION__,
+              iPersisted, static_cast<unsigned int>(copy.size()), 1000.0 * (CurrentHostCounter() - start) / CurrentHostFrequency());
+
   return bReturn;
 }
 
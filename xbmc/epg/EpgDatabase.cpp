@@ -19,6 +19,8 @@
  */
 
 #include <cstdlib>
+#include <utility>
+#include <vector>
 
 #include "system.h"
 #include "addons/include/xbmc_pvr_types.h"
@@ -405,6 +407,125 @@ int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true *
   return iReturn;
 }
 
+#define EPGTAGS_COLUMNS "idEpg, iStartTime, iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, " \
+    "sWriter, iYear, sIMDBNumber, sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, " \
+    "iStarRating, bNotify, iSeriesId, iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid"
+#define EPGTAGS_VALUES "?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?"
+#define EPGTAGS_COLUMN_COUNT 26
+
+/* binds the values in the order of EPGTAGS_COLUMNS */
+void CEpgDatabase::BindTag(dbiplus::Statement &statement, const CEpgInfoTag &tag)
+{
+  time_t iStartTime, iEndTime, iFirstAired;
+  tag.StartAsUTC().GetAsTime(iStartTime);
+  tag.EndAsUTC().GetAsTime(iEndTime);
+  tag.FirstAiredAsUTC().GetAsTime(iFirstAired);
+
+  /* Only store the genre string when needed */
+  std::string strGenre = (tag.GenreType() == EPG_GENRE_USE_STRING) ? StringUtils::Join(tag.Genre(), g_advancedSettings.m_videoItemSeparator) : "";
+
+  int i = 0;
+  statement.bind(++i, tag.EpgID());
+  statement.bind(++i, static_cast<int64_t>(iStartTime));
+  statement.bind(++i, static_cast<int64_t>(iEndTime));
+  statement.bind(++i, tag.Title(true));
+  statement.bind(++i, tag.PlotOutline(true));
+  statement.bind(++i, tag.Plot(true));
+  statement.bind(++i, tag.OriginalTitle(true));
+  statement.bind(++i, tag.Cast());
+  statement.bind(++i, tag.Director());
+  statement.bind(++i, tag.Writer());
+  statement.bind(++i, tag.Year());
+  statement.bind(++i, tag.IMDBNumber());
+  statement.bind(++i, tag.Icon());
+  statement.bind(++i, tag.GenreType());
+  statement.bind(++i, tag.GenreSubType());
+  statement.bind(++i, strGenre);
+  statement.bind(++i, static_cast<int64_t>(iFirstAired));
+  statement.bind(++i, tag.ParentalRating());
+  statement.bind(++i, tag.StarRating());
+  statement.bind(++i, tag.Notify());
+  statement.bind(++i, tag.SeriesNumber());
+  statement.bind(++i, tag.EpisodeNumber());
+  statement.bind(++i, tag.EpisodePart());
+  statement.bind(++i, tag.EpisodeName());
+  statement.bind(++i, tag.Flags());
+  statement.bind(++i, tag.UniqueBroadcastID());
+}
+
+bool CEpgDatabase::PersistTags(const std::map<int, CEpgInfoTagPtr> &changed, const std::map<int, CEpgInfoTagPtr> &deleted)
+{
+  if (changed.empty() && deleted.empty())
+    return true;
+
+  /* the statements are parsed once and only get new values for every tag */
+  std::unique_ptr<dbiplus::Statement> insertTag(PrepareStatement("REPLACE INTO epgtags (" EPGTAGS_COLUMNS ") VALUES (" EPGTAGS_VALUES ");"));
+  std::unique_ptr<dbiplus::Statement> replaceTag(PrepareStatement("REPLACE INTO epgtags (" EPGTAGS_COLUMNS ", idBroadcast) VALUES (" EPGTAGS_VALUES ", ?);"));
+  std::unique_ptr<dbiplus::Statement> deleteTag(PrepareStatement("DELETE FROM epgtags WHERE idBroadcast = ?;"));
+  if (!insertTag || !replaceTag || !deleteTag)
+    return false;
+
+  bool bReturn(true);
+  std::vector<std::pair<CEpgInfoTagPtr, int> > newIds;
+
+  BeginTransaction();
+  try
+  {
+    for (std::map<int, CEpgInfoTagPtr>::const_iterator it = deleted.begin(); it != deleted.end(); ++it)
+    {
+      /* tag without a database ID was not persisted */
+      if (it->second->BroadcastId() <= 0)
+        continue;
+
+      deleteTag->bind(1, it->second->BroadcastId());
+      deleteTag->exec();
+    }
+
+    for (std::map<int, CEpgInfoTagPtr>::const_iterator it = changed.begin(); it != changed.end(); ++it)
+    {
+      const CEpgInfoTag &tag = *it->second;
+      if (tag.EpgID() <= 0)
+      {
+        CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag.Title(true).c_str());
+        bReturn = false;
+        continue;
+      }
+
+      if (tag.BroadcastId() > 0)
+      {
+        BindTag(*replaceTag, tag);
+        replaceTag->bind(EPGTAGS_COLUMN_COUNT + 1, tag.BroadcastId());
+        replaceTag->exec();
+      }
+      else
+      {
+        BindTag(*insertTag, tag);
+        insertTag->exec();
+        newIds.push_back(std::make_pair(it->second, static_cast<int>(insertTag->lastinsertid())));
+      }
+    }
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to persist the tags of table %d", __FUNCTION__,
+              changed.empty() ? deleted.begin()->second->EpgID() : changed.begin()->second->EpgID());
+    RollbackTransaction();
+    return false;
+  }
+
+  if (!CommitTransaction())
+    return false;
+
+  /* the tags get their database ID once it's certain they were written */
+  for (std::vector<std::pair<CEpgInfoTagPtr, int> >::const_iterator it = newIds.begin(); it != newIds.end(); ++it)
+  {
+    if (it->second > 0)
+      it->first->m_iBroadcastId = it->second;
+  }
+
+  return bReturn;
+}
+
 int CEpgDatabase::GetLastEPGId(void)
 {
   std::string strQuery = PrepareSQL("SELECT MAX(idEpg) FROM epg");
@@ -144,6 +144,14 @@ namespace EPG
      */
     virtual int Persist(const CEpgInfoTag &tag, bool bSingleUpdate = true);
 
+    /*!
+     * @brief Persist and delete tags of an EPG table in a single transaction.
+     * @param changed The tags to persist. Tags that were not persisted before get their database ID.
+     * @param deleted The tags to delete.
+     * @return True if all tags were persisted and deleted successfully, false otherwise.
+     */
+    bool PersistTags(const std::map<int, CEpgInfoTagPtr> &changed, const std::map<int, CEpgInfoTagPtr> &deleted);
+
     /*!
      * @return Last EPG id in the database
      */
@@ -168,5 +176,13 @@ namespace EPG
      */
     virtual void UpdateTables(int version);
     virtual int GetMinSchemaVersion() const { return 4; }
+
+  private:
+    /*!
+     * @brief Bind the values of a tag to a statement persisting it.
+     * @param statement The statement.
+     * @param tag The tag.
+     */
+    static void BindTag(dbiplus::Statement &statement, const CEpgInfoTag &tag);
   };
 }
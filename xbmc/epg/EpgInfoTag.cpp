@@ -670,6 +670,36 @@ bool CEpgInfoTag::Update(const CEpgInfoTag &tag, bool bUpdateBroadcastId /* = tr
   return bChanged;
 }
 
+bool CEpgInfoTag::DiffersInDatabase(const CEpgInfoTag &tag) const
+{
+  /* the columns of CEpgDatabase::Persist, the genre string is only stored when it's used */
+  return m_strTitle           != tag.m_strTitle ||
+         m_strPlotOutline     != tag.m_strPlotOutline ||
+         m_strPlot            != tag.m_strPlot ||
+         m_strOriginalTitle   != tag.m_strOriginalTitle ||
+         m_strCast            != tag.m_strCast ||
+         m_strDirector        != tag.m_strDirector ||
+         m_strWriter          != tag.m_strWriter ||
+         m_iYear              != tag.m_iYear ||
+         m_strIMDBNumber      != tag.m_strIMDBNumber ||
+         m_strIconPath        != tag.m_strIconPath ||
+         m_startTime          != tag.m_startTime ||
+         m_endTime            != tag.m_endTime ||
+         m_iGenreType         != tag.m_iGenreType ||
+         m_iGenreSubType      != tag.m_iGenreSubType ||
+         (m_iGenreType == EPG_GENRE_USE_STRING && m_genre != tag.m_genre) ||
+         m_firstAired         != tag.m_firstAired ||
+         m_iParentalRating    != tag.m_iParentalRating ||
+         m_iStarRating        != tag.m_iStarRating ||
+         m_bNotify            != tag.m_bNotify ||
+         m_iSeriesNumber      != tag.m_iSeriesNumber ||
+         m_iEpisodeNumber     != tag.m_iEpisodeNumber ||
+         m_iEpisodePart       != tag.m_iEpisodePart ||
+         m_strEpisodeName     != tag.m_strEpisodeName ||
+         m_iFlags             != tag.m_iFlags ||
+         m_iUniqueBroadcastID != tag.m_iUniqueBroadcastID;
+}
+
 bool CEpgInfoTag::Persist(bool bSingleUpdate /* = true */)
 {
   bool bReturn = false;
@@ -403,6 +403,13 @@ namespace EPG
      */
     bool Update(const CEpgInfoTag &tag, bool bUpdateBroadcastId = true);
 
+    /*!
+     * @brief Check whether the values stored in the database differ from the ones of the given tag.
+     * @param tag The tag to compare with.
+     * @return True if persisting the given tag would change the database entry of this tag, false otherwise.
+     */
+    bool DiffersInDatabase(const CEpgInfoTag &tag) const;
+
     /*!
      * @brief status function to extract IsSeries boolean from EPG iFlags bitfield
      */
@@ -217,7 +217,7 @@ bool CDirectory::GetDirectory(const CURL& url, CFileItemList &items, const CHint
 
       // cache the directory, if necessary
       if (!(hints.flags & DIR_FLAG_BYPASS_CACHE))
-        g_directoryCache.SetDirectory(realURL.Get(), items, pDirectory->GetCacheType(url));
+        g_directoryCache.SetDirectory(realURL.Get(), items, pDirectory->GetCacheType(url), pDirectory->GetCacheLifetime(url));
     }
 
     // now filter for allowed files
@@ -28,18 +28,23 @@
 #include "climits"
 
 #include <algorithm>
+#include <cstring>
 
 // Maximum number of directories to keep in our cache
 #define MAX_CACHED_DIRS 50
 
 using namespace XFILE;
 
-CDirectoryCache::CDir::CDir(DIR_CACHE_TYPE cacheType)
+CDirectoryCache::CDir::CDir(DIR_CACHE_TYPE cacheType, unsigned int lifetime)
 {
   m_cacheType = cacheType;
   m_lastAccess = 0;
   m_Items = new CFileItemList;
   m_Items->SetFastLookup(true);
+  if (lifetime > 0)
+    m_expires.Set(lifetime * 1000);
+  else
+    m_expires.SetInfinite();
 }
 
 CDirectoryCache::CDir::~CDir()
@@ -55,6 +60,8 @@ void CDirectoryCache::CDir::SetLastAccess(unsigned int &accessCounter)
 CDirectoryCache::CDirectoryCache(void)
 {
   m_accessCounter = 0;
+  m_directoryHits = 0;
+  m_directoryMisses = 0;
 #ifdef _DEBUG
   m_cacheHits = 0;
   m_cacheMisses = 0;
@@ -69,11 +76,15 @@ bool CDirectoryCache::GetDirectory(const std::string& strPath, CFileItemList &it
 {
   CSingleLock lock (m_cs);
 
-  // Get rid of any URL options, else the compare may be wrong
-  std::string storedPath = CURL(strPath).GetWithoutOptions();
-  URIUtils::RemoveSlashAtEnd(storedPath);
+  std::string storedPath = GetStoredPath(strPath);
+
+  iCache i = m_cache.find(storedPath);
+  if (i != m_cache.end() && i->second->IsExpired())
+  {
+    Delete(i);
+    i = m_cache.end();
+  }
 
-  ciCache i = m_cache.find(storedPath);
   if (i != m_cache.end())
   {
     CDir* dir = i->second;
@@ -82,16 +93,18 @@ bool CDirectoryCache::GetDirectory(const std::string& strPath, CFileItemList &it
     {
       items.Copy(*dir->m_Items);
       dir->SetLastAccess(m_accessCounter);
+      m_directoryHits++;
 #ifdef _DEBUG
       m_cacheHits+=items.Size();
 #endif
       return true;
     }
   }
+  m_directoryMisses++;
   return false;
 }
 
-void CDirectoryCache::SetDirectory(const std::string& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType)
+void CDirectoryCache::SetDirectory(const std::string& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType, unsigned int lifetime /* = 0 */)
 {
   if (cacheType == DIR_CACHE_NEVER)
     return; // nothing to do
@@ -109,15 +122,13 @@ void CDirectoryCache::SetDirectory(const std::string& strPath, const CFileItemLi
   // this is the best solution for now.
   CSingleLock lock (m_cs);
 
-  // Get rid of any URL options, else the compare may be wrong
-  std::string storedPath = CURL(strPath).GetWithoutOptions();
-  URIUtils::RemoveSlashAtEnd(storedPath);
+  std::string storedPath = GetStoredPath(strPath);
 
   ClearDirectory(storedPath);
 
   CheckIfFull();
 
-  CDir* dir = new CDir(cacheType);
+  CDir* dir = new CDir(cacheType, lifetime);
   dir->m_Items->Copy(items);
   dir->SetLastAccess(m_accessCounter);
   m_cache.insert(std::pair<std::string, CDir*>(storedPath, dir));
@@ -135,9 +146,7 @@ void CDirectoryCache::ClearDirectory(const std::string& strPath)
 {
   CSingleLock lock (m_cs);
 
-  // Get rid of any URL options, else the compare may be wrong
-  std::string storedPath = CURL(strPath).GetWithoutOptions();
-  URIUtils::RemoveSlashAtEnd(storedPath);
+  std::string storedPath = GetStoredPath(strPath);
 
   iCache i = m_cache.find(storedPath);
   if (i != m_cache.end())
@@ -155,7 +164,10 @@ void CDirectoryCache::ClearSubPaths(const std::string& strPath)
   iCache i = m_cache.begin();
   while (i != m_cache.end())
   {
-    if (StringUtils::StartsWith(i->first, storedPath))
+    // the path has to end where the stored one does, so clearing
+    // plugin://plugin.video.foo/ keeps plugin://plugin.video.foo.bar/
+    if (StringUtils::StartsWith(i->first, storedPath) &&
+        (i->first.size() == storedPath.size() || strchr("/\\?", i->first[storedPath.size()]) != NULL))
       Delete(i++);
     else
       i++;
@@ -208,6 +220,13 @@ bool CDirectoryCache::FileExists(const std::string& strFile, bool& bInCache)
   return false;
 }
 
+void CDirectoryCache::GetStats(unsigned int &hits, unsigned int &misses) const
+{
+  CSingleLock lock (m_cs);
+  hits = m_directoryHits;
+  misses = m_directoryMisses;
+}
+
 void CDirectoryCache::Clear()
 {
   // this routine clears everything
@@ -249,20 +268,39 @@ void CDirectoryCache::CheckIfFull()
   // find the last accessed folder, and remove if the number of cached folders is too many
   iCache lastAccessed = m_cache.end();
   unsigned int numCached = 0;
-  for (iCache i = m_cache.begin(); i != m_cache.end(); i++)
+  for (iCache i = m_cache.begin(); i != m_cache.end();)
   {
-    // ensure dirs that are always cached aren't cleared
-    if (i->second->m_cacheType != DIR_CACHE_ALWAYS)
+    // get rid of expired dirs first
+    if (i->second->IsExpired())
+    {
+      Delete(i++);
+      continue;
+    }
+
+    // ensure dirs that are always cached aren't cleared unless they expire anyway
+    if (i->second->m_cacheType != DIR_CACHE_ALWAYS || i->second->CanExpire())
     {
       if (lastAccessed == m_cache.end() || i->second->GetLastAccess() < lastAccessed->second->GetLastAccess())
         lastAccessed = i;
       numCached++;
     }
+    ++i;
   }
   if (lastAccessed != m_cache.end() && numCached >= MAX_CACHED_DIRS)
     Delete(lastAccessed);
 }
 
+std::string CDirectoryCache::GetStoredPath(const std::string& strPath)
+{
+  // Get rid of any URL options, else the compare may be wrong.
+  // The options of plugin paths are passed to the plugin so they
+  // identify different directories.
+  CURL url(strPath);
+  std::string storedPath = url.IsProtocol("plugin") ? url.Get() : url.GetWithoutOptions();
+  URIUtils::RemoveSlashAtEnd(storedPath);
+  return storedPath;
+}
+
 void CDirectoryCache::Delete(iCache it)
 {
   CDir* dir = it->second;
@@ -275,6 +313,7 @@ void CDirectoryCache::PrintStats() const
 {
   CSingleLock lock (m_cs);
   CLog::Log(LOGDEBUG, "%s - total of %u cache hits, and %u cache misses", __FUNCTION__, m_cacheHits, m_cacheMisses);
+  CLog::Log(LOGDEBUG, "%s - total of %u directory hits, and %u directory misses", __FUNCTION__, m_directoryHits, m_directoryMisses);
   // run through and find the oldest and the number of items cached
   unsigned int oldest = UINT_MAX;
   unsigned int numItems = 0;
@@ -22,6 +22,7 @@
 #include "IDirectory.h"
 #include "Directory.h"
 #include "threads/CriticalSection.h"
+#include "threads/SystemClock.h"
 
 #include <map>
 #include <set>
@@ -35,14 +36,17 @@ namespace XFILE
     class CDir
     {
     public:
-      CDir(DIR_CACHE_TYPE cacheType);
+      CDir(DIR_CACHE_TYPE cacheType, unsigned int lifetime);
       virtual ~CDir();
 
       void SetLastAccess(unsigned int &accessCounter);
       unsigned int GetLastAccess() const { return m_lastAccess; };
+      bool IsExpired() const { return m_expires.IsTimePast(); }
+      bool CanExpire() const { return !m_expires.IsInfinite(); }
 
       CFileItemList* m_Items;
       DIR_CACHE_TYPE m_cacheType;
+      XbmcThreads::EndTime m_expires;
     private:
       unsigned int m_lastAccess;
     };
@@ -50,13 +54,25 @@ namespace XFILE
     CDirectoryCache(void);
     virtual ~CDirectoryCache(void);
     bool GetDirectory(const std::string& strPath, CFileItemList &items, bool retrieveAll = false);
-    void SetDirectory(const std::string& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType);
+    /*!
+     \brief Caches a copy of the given items
+     \param strPath Path of the directory
+     \param items Items of the directory
+     \param cacheType How the directory is cached
+     \param lifetime Seconds after which the cached directory is discarded (0 to keep it until it's cleared)
+     */
+    void SetDirectory(const std::string& strPath, const CFileItemList &items, DIR_CACHE_TYPE cacheType, unsigned int lifetime = 0);
     void ClearDirectory(const std::string& strPath);
     void ClearFile(const std::string& strFile);
     void ClearSubPaths(const std::string& strPath);
     void Clear();
     void AddFile(const std::string& strFile);
     bool FileExists(const std::string& strPath, bool& bInCache);
+
+    /*!
+     \brief Number of directory lookups served from and missed by the cache
+     */
+    void GetStats(unsigned int &hits, unsigned int &misses) const;
 #ifdef _DEBUG
     void PrintStats() const;
 #endif
@@ -64,6 +80,7 @@ namespace XFILE
     void InitCache(std::set<std::string>& dirs);
     void ClearCache(std::set<std::string>& dirs);
     void CheckIfFull();
+    static std::string GetStoredPath(const std::string& strPath);
 
     std::map<std::string, CDir*> m_cache;
     typedef std::map<std::string, CDir*>::iterator iCache;
@@ -73,6 +90,8 @@ namespace XFILE
     CCriticalSection m_cs;
 
     unsigned int m_accessCounter;
+    unsigned int m_directoryHits;
+    unsigned int m_directoryMisses;
 
 #ifdef _DEBUG
     unsigned int m_cacheHits;
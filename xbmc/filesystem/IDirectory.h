@@ -120,6 +120,13 @@ public:
   */
   virtual DIR_CACHE_TYPE GetCacheType(const CURL& url) const { return DIR_CACHE_ONCE; };
 
+  /*!
+  \brief How long a directory cached with DIR_CACHE_ALWAYS stays valid
+  \param url Directory at hand.
+  \return Returns the lifetime in seconds or 0 if it stays valid until it's cleared.
+  */
+  virtual unsigned int GetCacheLifetime(const CURL& url) const { return 0; };
+
   void SetMask(const std::string& strMask);
   void SetFlags(int flags);
 
@@ -18,6 +18,7 @@
  *
  */
 
+#include <algorithm>
 
 #include "threads/SystemClock.h"
 #include "system.h"
@@ -38,6 +39,9 @@
 #include "Application.h"
 #include "URL.h"
 
+// seconds a plugin listing is kept in the directory cache unless the plugin says otherwise
+#define PLUGIN_CACHE_DEFAULT_LIFETIME 120
+
 using namespace XFILE;
 using namespace ADDON;
 using namespace KODI::MESSAGING;
@@ -50,6 +54,7 @@ CPluginDirectory::CPluginDirectory()
   : m_cancelled(false)
   , m_success(false)
   , m_totalItems(0)
+  , m_cacheLifetime(-1)
 {
   m_listItems = new CFileItemList;
   m_fileResult = new CFileItem;
@@ -117,6 +122,7 @@ bool CPluginDirectory::StartScript(const std::string& strPath, bool retrievingDi
   m_cancelled = false;
   m_success = false;
   m_totalItems = 0;
+  m_cacheLifetime = -1;
 
   // setup our parameters to send the script
   std::string strHandle = StringUtils::Format("%i", handle);
@@ -207,6 +213,11 @@ void CPluginDirectory::EndOfDirectory(int handle, bool success, bool replaceList
   dir->m_success = success;
   dir->m_listItems->SetReplaceListing(replaceListing);
 
+  // unless the plugin asked for something else only cache listings which may be cached
+  // to disc and don't replace the current listing as the others tend to be dynamic
+  if (dir->m_cacheLifetime < 0)
+    dir->m_cacheLifetime = cacheToDisc && !replaceListing ? PLUGIN_CACHE_DEFAULT_LIFETIME : 0;
+
   if (!dir->m_listItems->HasSortDetails())
     dir->m_listItems->AddSortMethod(SortByNone, 552, LABEL_MASKS("%L", "%D"));
 
@@ -571,6 +582,24 @@ void CPluginDirectory::SetSetting(int handle, const std::string &strID, const st
     dir->m_addon->UpdateSetting(strID, value);
 }
 
+void CPluginDirectory::SetCacheLifetime(int handle, int seconds)
+{
+  CSingleLock lock(m_handleLock);
+  CPluginDirectory *dir = dirFromHandle(handle);
+  if (dir)
+    dir->m_cacheLifetime = std::max(seconds, 0);
+}
+
+DIR_CACHE_TYPE CPluginDirectory::GetCacheType(const CURL& url) const
+{
+  return m_cacheLifetime > 0 ? DIR_CACHE_ALWAYS : DIR_CACHE_ONCE;
+}
+
+unsigned int CPluginDirectory::GetCacheLifetime(const CURL& url) const
+{
+  return m_cacheLifetime > 0 ? m_cacheLifetime : 0;
+}
+
 void CPluginDirectory::SetContent(int handle, const std::string &strContent)
 {
   CSingleLock lock(m_handleLock);
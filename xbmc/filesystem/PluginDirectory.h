@@ -47,6 +47,8 @@ public:
   virtual bool Exists(const CURL& url) { return true; }
   virtual float GetProgress() const;
   virtual void CancelDirectory();
+  virtual DIR_CACHE_TYPE GetCacheType(const CURL& url) const;
+  virtual unsigned int GetCacheLifetime(const CURL& url) const;
   static bool RunScriptWithParams(const std::string& strPath);
   static bool GetPluginResult(const std::string& strPath, CFileItem &resultItem);
 
@@ -61,6 +63,7 @@ public:
   static void SetProperty(int handle, const std::string &strProperty, const std::string &strValue);
   static void SetResolvedUrl(int handle, bool success, const CFileItem* resultItem);
   static void SetLabel2(int handle, const std::string& ident);
+  static void SetCacheLifetime(int handle, int seconds);
 
 private:
   ADDON::AddonPtr m_addon;
@@ -81,5 +84,6 @@ private:
   bool          m_cancelled;    // set to true when we are cancelled
   bool          m_success;      // set by script in EndOfDirectory
   int    m_totalItems;   // set by script in AddDirectoryItem
+  int    m_cacheLifetime; // seconds the listing may be cached, set by script in SetCacheLifetime or EndOfDirectory
 };
 }
@@ -0,0 +1,93 @@
+/*
+ *      Copyright (C) 2005-2013 Team XBMC
+ *      http://xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "filesystem/DirectoryCache.h"
+#include "FileItem.h"
+#include "threads/Thread.h"
+
+#include "gtest/gtest.h"
+
+static void AddItems(CFileItemList &items, const std::string &path, int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    CFileItemPtr item(new CFileItem(path + "?item=" + std::to_string(i), true));
+    items.Add(item);
+  }
+}
+
+TEST(TestDirectoryCache, PluginOptionsAreKept)
+{
+  XFILE::CDirectoryCache cache;
+  CFileItemList movies, shows, result;
+  AddItems(movies, "plugin://plugin.video.test/", 3);
+  AddItems(shows, "plugin://plugin.video.test/", 5);
+
+  cache.SetDirectory("plugin://plugin.video.test/?mode=movies", movies, XFILE::DIR_CACHE_ALWAYS);
+  cache.SetDirectory("plugin://plugin.video.test/?mode=shows", shows, XFILE::DIR_CACHE_ALWAYS);
+
+  EXPECT_TRUE(cache.GetDirectory("plugin://plugin.video.test/?mode=movies", result));
+  EXPECT_EQ(3, result.Size());
+  result.Clear();
+  EXPECT_TRUE(cache.GetDirectory("plugin://plugin.video.test/?mode=shows", result));
+  EXPECT_EQ(5, result.Size());
+  result.Clear();
+  EXPECT_FALSE(cache.GetDirectory("plugin://plugin.video.test/", result));
+
+  cache.ClearDirectory("plugin://plugin.video.test/?mode=movies");
+  EXPECT_FALSE(cache.GetDirectory("plugin://plugin.video.test/?mode=movies", result));
+  EXPECT_TRUE(cache.GetDirectory("plugin://plugin.video.test/?mode=shows", result));
+
+  unsigned int hits, misses;
+  cache.GetStats(hits, misses);
+  EXPECT_EQ(3U, hits);
+  EXPECT_EQ(2U, misses);
+}
+
+TEST(TestDirectoryCache, Lifetime)
+{
+  XFILE::CDirectoryCache cache;
+  CFileItemList items, result;
+  AddItems(items, "plugin://plugin.video.test/", 2);
+
+  cache.SetDirectory("plugin://plugin.video.test/?mode=live", items, XFILE::DIR_CACHE_ALWAYS, 1);
+  EXPECT_TRUE(cache.GetDirectory("plugin://plugin.video.test/?mode=live", result));
+
+  XbmcThreads::ThreadSleep(1100);
+  result.Clear();
+  EXPECT_FALSE(cache.GetDirectory("plugin://plugin.video.test/?mode=live", result));
+  EXPECT_EQ(0, result.Size());
+}
+
+TEST(TestDirectoryCache, ClearSubPathsOfPlugin)
+{
+  XFILE::CDirectoryCache cache;
+  CFileItemList items, result;
+  AddItems(items, "plugin://plugin.video.test/", 2);
+
+  cache.SetDirectory("plugin://plugin.video.test/", items, XFILE::DIR_CACHE_ALWAYS);
+  cache.SetDirectory("plugin://plugin.video.test/?mode=movies", items, XFILE::DIR_CACHE_ALWAYS);
+  cache.SetDirectory("plugin://plugin.video.test.extra/?mode=movies", items, XFILE::DIR_CACHE_ALWAYS);
+
+  cache.ClearSubPaths("plugin://plugin.video.test/");
+  EXPECT_FALSE(cache.GetDirectory("plugin://plugin.video.test/", result));
+  EXPECT_FALSE(cache.GetDirectory("plugin://plugin.video.test/?mode=movies", result));
+  EXPECT_TRUE(cache.GetDirectory("plugin://plugin.video.test.extra/?mode=movies", result));
+}
@@ -198,7 +198,25 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
 
   AVCodecContext* codec_ctx = fctx->streams[0]->codec;
   AVCodec* codec = avcodec_find_decoder(codec_ctx->codec_id);
-  if (avcodec_open2(codec_ctx, codec, NULL) < 0)
+
+  // jpegs can be scaled down by 1/2, 1/4 or 1/8 in the DCT domain while
+  // decoding, which saves most of the work for large photos and fanart
+  unsigned int originalWidth = 0;
+  unsigned int originalHeight = 0;
+  int lowres = 0;
+  if (codec && codec->id == AV_CODEC_ID_MJPEG && GetJpegDimensions(buffer, bufSize, originalWidth, originalHeight))
+  {
+    unsigned int targetWidth, targetHeight;
+    FitSize(originalWidth, originalHeight, width, height, targetWidth, targetHeight);
+    lowres = GetLowres(originalWidth, originalHeight, targetWidth, targetHeight, av_codec_get_max_lowres(codec));
+  }
+
+  AVDictionary* options = nullptr;
+  if (lowres > 0)
+    av_dict_set_int(&options, "lowres", lowres, 0);
+  int opened = avcodec_open2(codec_ctx, codec, &options);
+  av_dict_free(&options);
+  if (opened < 0)
   {
     avformat_close_input(&fctx);
     FreeIOCtx(ioctx);
@@ -208,8 +226,21 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
   AVPacket pkt;
   AVFrame* frame = av_frame_alloc();
   av_read_frame(fctx, &pkt);
-  int frame_decoded;
+  int frame_decoded = 0;
   int ret = avcodec_decode_video2(codec_ctx, frame, &frame_decoded, &pkt);
+  if ((ret < 0 || frame_decoded == 0) && lowres > 0)
+  {
+    // not every jpeg can be scaled while decoding, e.g. ones with unusual
+    // chroma subsampling, those are decoded at full size instead
+    CLog::Log(LOGDEBUG, "Could not decode jpeg at lowres %d, decoding at full size", lowres);
+    lowres = 0;
+    avcodec_close(codec_ctx);
+    av_dict_set_int(&options, "lowres", 0, 0);
+    opened = avcodec_open2(codec_ctx, codec, &options);
+    av_dict_free(&options);
+    if (opened >= 0)
+      ret = avcodec_decode_video2(codec_ctx, frame, &frame_decoded, &pkt);
+  }
   if (ret < 0)
     CLog::Log(LOGDEBUG, "Error [%d] while decoding frame: %s\n", ret, strerror(AVERROR(ret)));
 
@@ -220,10 +251,19 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
 
     if (m_pFrame)
     {
-      m_height = m_pFrame->height;
-      m_width = m_pFrame->width;
-      m_originalWidth = m_width;
-      m_originalHeight = m_height;
+      if (lowres > 0)
+      {
+        m_originalWidth = originalWidth;
+        m_originalHeight = originalHeight;
+      }
+      else
+      {
+        m_originalWidth = m_pFrame->width;
+        m_originalHeight = m_pFrame->height;
+      }
+      // report the size the image is decoded at, so that the caller doesn't
+      // allocate a buffer for the full image
+      FitSize(m_originalWidth, m_originalHeight, width, height, m_width, m_height);
 
       const AVPixFmtDescriptor* pixDescriptor = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(m_pFrame->format));
       if (pixDescriptor && ((pixDescriptor->flags & (AV_PIX_FMT_FLAG_ALPHA | AV_PIX_FMT_FLAG_PAL)) != 0))
@@ -282,6 +322,63 @@ AVPixelFormat CFFmpegImage::ConvertFormats(AVFrame* frame)
   }
 }
 
+bool CFFmpegImage::GetJpegDimensions(const uint8_t* buffer, size_t bufSize, unsigned int &width, unsigned int &height)
+{
+  if (bufSize < 4 || buffer[0] != 0xFF || buffer[1] != 0xD8)
+    return false;
+
+  // walk the marker segments following the start of image up to the start of frame
+  size_t pos = 2;
+  while (pos + 4 <= bufSize)
+  {
+    if (buffer[pos] != 0xFF)
+      return false;
+
+    uint8_t marker = buffer[pos + 1];
+    if (marker == 0xFF)
+    { // fill byte
+      pos++;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8))
+    { // markers without a segment
+      pos += 2;
+      continue;
+    }
+    // SOF0 - SOF15 apart from DHT, JPG and DAC
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+    {
+      if (pos + 9 > bufSize)
+        return false;
+      height = (buffer[pos + 5] << 8) | buffer[pos + 6];
+      width = (buffer[pos + 7] << 8) | buffer[pos + 8];
+      return width > 0 && height > 0;
+    }
+    // no start of frame before the first scan or the end of the image
+    if (marker == 0xDA || marker == 0xD9)
+      return false;
+
+    size_t length = (buffer[pos + 2] << 8) | buffer[pos + 3];
+    if (length < 2)
+      return false;
+    pos += 2 + length;
+  }
+  return false;
+}
+
+int CFFmpegImage::GetLowres(unsigned int width, unsigned int height, unsigned int targetWidth, unsigned int targetHeight, int maxLowres)
+{
+  if (targetWidth == 0 || targetHeight == 0)
+    return 0;
+
+  int lowres = 0;
+  while (lowres < maxLowres &&
+         (width >> (lowres + 1)) >= targetWidth &&
+         (height >> (lowres + 1)) >= targetHeight)
+    lowres++;
+  return lowres;
+}
+
 void CFFmpegImage::FreeIOCtx(AVIOContext* ioctx)
 {
   av_free(ioctx->buffer);
@@ -339,22 +436,11 @@ bool CFFmpegImage::Decode(unsigned char * const pixels, unsigned int width, unsi
   AVColorRange range = av_frame_get_color_range(m_pFrame);
   AVPixelFormat pixFormat = ConvertFormats(m_pFrame);
 
-  // assumption quadratic maximums e.g. 2048x2048
-  float ratio = m_width / (float) m_height;
-  unsigned int nHeight = m_originalHeight;
-  unsigned int nWidth = m_originalWidth;
-  if (nHeight > height)
-  {
-    nHeight = height;
-    nWidth = (unsigned int) (nHeight * ratio + 0.5f);
-  }
-  if (nWidth > width)
-  {
-    nWidth = width;
-    nHeight = (unsigned int) (nWidth / ratio + 0.5f);
-  }
+  // the frame may already be scaled down by the decoder, the rest is done here
+  unsigned int nWidth, nHeight;
+  FitSize(m_width, m_height, width, height, nWidth, nHeight);
 
-  struct SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat,
+  struct SwsContext* context = sws_getContext(m_pFrame->width, m_pFrame->height, pixFormat,
     nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
 
   if (range == AVCOL_RANGE_JPEG)
@@ -367,7 +453,7 @@ bool CFFmpegImage::Decode(unsigned char * const pixels, unsigned int width, unsi
     sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
   }
 
-  sws_scale(context, m_pFrame->data, m_pFrame->linesize, 0, m_originalHeight,
+  sws_scale(context, m_pFrame->data, m_pFrame->linesize, 0, m_pFrame->height,
     pictureRGB->data, pictureRGB->linesize);
   sws_freeContext(context);
 
@@ -48,6 +48,23 @@ public:
                                           unsigned char* &bufferout,
                                           unsigned int &bufferoutSize);
   virtual void ReleaseThumbnailBuffer();
+
+  /*!
+   \brief Read the dimensions of a jpeg from its start of frame marker without decoding it
+   \return true if the dimensions were found
+   */
+  static bool GetJpegDimensions(const uint8_t* buffer, size_t bufSize, unsigned int &width, unsigned int &height);
+  /*!
+   \brief Get the power of two a jpeg can be scaled down by while decoding (at most 1/8)
+   without getting smaller than the given size
+   \param width width of the image
+   \param height height of the image
+   \param targetWidth smallest width the image may be decoded at, 0 if not limited
+   \param targetHeight smallest height the image may be decoded at, 0 if not limited
+   \param maxLowres highest reduction the decoder supports
+   \return image is decoded at 1/2^lowres of its size
+   */
+  static int GetLowres(unsigned int width, unsigned int height, unsigned int targetWidth, unsigned int targetHeight, int maxLowres);
 private:
   static void FreeIOCtx(AVIOContext* ioctx);
   static AVPixelFormat ConvertFormats(AVFrame* frame);
@@ -0,0 +1,387 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "GUIFontGlyphAtlas.h"
+#include "GUIFont.h"
+#include "GUIFontTTF.h"
+#include "TextureManager.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <map>
+
+// stuff for freetype
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+#include FT_STROKER_H
+
+#define CHARS_PER_TEXTURE_LINE 20       // number of characters to fit into a row of the atlas
+
+#define DISTANCE_FIELD_SIZE   32.0f     // size in pixels the distance fields are rendered with
+#define DISTANCE_FIELD_SPREAD 4         // pixels around the outline covered by the distance field
+
+#define DISTANCE_INFINITE     1e20f
+
+static const unsigned int spacing_between_glyphs = 1;
+
+static CCriticalSection s_sharedAtlasesSection;
+
+CGUIFontGlyphAtlas::CGUIFontGlyphAtlas(const std::string& fontFile, float size, bool distanceField, bool border, unsigned int maxTextureSize)
+  : m_fontFile(fontFile),
+    m_size(size),
+    m_distanceField(distanceField),
+    m_border(border),
+    m_maxTextureSize(maxTextureSize),
+    m_face(NULL),
+    m_stroker(NULL),
+    m_width(0),
+    m_height(0),
+    m_shelfX(0),
+    m_shelfY(0),
+    m_shelfHeight(0),
+    m_dirtyY1(0),
+    m_dirtyY2(0),
+    m_hwTexture(0),
+    m_hwTextureHeight(0),
+    m_generation(0),
+    m_misses(0)
+{
+}
+
+CGUIFontGlyphAtlas::~CGUIFontGlyphAtlas()
+{
+  if (m_stroker)
+    CGUIFontTTFBase::ReleaseStroker(m_stroker);
+  if (m_face)
+    CGUIFontTTFBase::ReleaseFace(m_face);
+  if (m_hwTexture)
+    g_TextureManager.ReleaseHwTexture(m_hwTexture);
+}
+
+std::shared_ptr<CGUIFontGlyphAtlas> CGUIFontGlyphAtlas::GetSharedAtlas(const std::string& fontFile, bool border, unsigned int maxTextureSize)
+{
+  static std::map<std::string, std::weak_ptr<CGUIFontGlyphAtlas> > atlases;
+
+  CSingleLock lock(s_sharedAtlasesSection);
+  std::string key = border ? fontFile + "|border" : fontFile;
+  std::shared_ptr<CGUIFontGlyphAtlas> atlas = atlases[key].lock();
+  if (atlas)
+    return atlas;
+
+  atlas.reset(new CGUIFontGlyphAtlas(fontFile, DISTANCE_FIELD_SIZE, true, border, maxTextureSize));
+  if (!atlas->Load())
+    return std::shared_ptr<CGUIFontGlyphAtlas>();
+
+  // drop the entries of atlases which are gone
+  for (std::map<std::string, std::weak_ptr<CGUIFontGlyphAtlas> >::iterator it = atlases.begin(); it != atlases.end(); )
+  {
+    if (it->second.expired())
+      atlases.erase(it++);
+    else
+      ++it;
+  }
+  atlases[key] = atlas;
+  return atlas;
+}
+
+bool CGUIFontGlyphAtlas::Load()
+{
+  m_face = CGUIFontTTFBase::LoadFace(m_fontFile, m_size, 1.0f, m_fontFileInMemory);
+  if (!m_face)
+    return false;
+
+  if (m_border)
+    m_stroker = CGUIFontTTFBase::CreateStroker(CGUIFontTTFBase::GetBorderStrength(m_face));
+
+  unsigned int padding = m_distanceField ? 2 * DISTANCE_FIELD_SPREAD : 0;
+  m_width = 64;
+  while (m_width < (m_size + padding) * CHARS_PER_TEXTURE_LINE && m_width < m_maxTextureSize)
+    m_width *= 2;
+  m_width = std::min(m_width, m_maxTextureSize);
+
+  return true;
+}
+
+const CGUIFontGlyphAtlas::Glyph* CGUIFontGlyphAtlas::GetGlyph(uint32_t letterAndStyle)
+{
+  std::unordered_map<uint32_t, Glyph>::const_iterator it = m_glyphs.find(letterAndStyle);
+  if (it != m_glyphs.end())
+    return &it->second;
+
+  Glyph glyph;
+  if (!RenderGlyph(letterAndStyle, glyph))
+    return NULL;
+
+  m_misses++;
+  return &(m_glyphs[letterAndStyle] = glyph);
+}
+
+void CGUIFontGlyphAtlas::Reset()
+{
+  CLog::Log(LOGDEBUG, "%s: clearing glyph atlas of %s with %u glyphs", __FUNCTION__, m_fontFile.c_str(), static_cast<unsigned int>(m_glyphs.size()));
+  m_glyphs.clear();
+  std::fill(m_pixels.begin(), m_pixels.end(), 0);
+  m_shelfX = m_shelfY = m_shelfHeight = 0;
+  MarkDirty(0, m_height);
+  m_generation++;
+}
+
+bool CGUIFontGlyphAtlas::GetDirtyRows(unsigned int& y1, unsigned int& y2) const
+{
+  if (m_dirtyY2 <= m_dirtyY1)
+    return false;
+
+  y1 = m_dirtyY1;
+  y2 = m_dirtyY2;
+  return true;
+}
+
+void CGUIFontGlyphAtlas::MarkDirty(unsigned int y1, unsigned int y2)
+{
+  if (m_dirtyY2 <= m_dirtyY1)
+  {
+    m_dirtyY1 = y1;
+    m_dirtyY2 = y2;
+  }
+  else
+  {
+    m_dirtyY1 = std::min(m_dirtyY1, y1);
+    m_dirtyY2 = std::max(m_dirtyY2, y2);
+  }
+}
+
+bool CGUIFontGlyphAtlas::Reserve(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y)
+{
+  if (width > m_width)
+    return false;
+
+  if (m_shelfX + width > m_width)
+  { // no space left in this row - start a new one
+    m_shelfY += m_shelfHeight + spacing_between_glyphs;
+    m_shelfX = 0;
+    m_shelfHeight = 0;
+  }
+
+  if (m_shelfY + height > m_height)
+  {
+    unsigned int newHeight = m_height ? m_height : 64;
+    while (newHeight < m_shelfY + height)
+      newHeight *= 2;
+    if (newHeight > m_maxTextureSize)
+    {
+      CLog::Log(LOGDEBUG, "%s: glyph atlas of %s is too large (%u > %u pixels high)", __FUNCTION__, m_fontFile.c_str(), newHeight, m_maxTextureSize);
+      return false;
+    }
+    // the width stays the same so the rows in use don't move
+    m_pixels.resize(m_width * newHeight, 0);
+    m_height = newHeight;
+  }
+
+  x = m_shelfX;
+  y = m_shelfY;
+  m_shelfX += width + spacing_between_glyphs;
+  m_shelfHeight = std::max(m_shelfHeight, height);
+  return true;
+}
+
+bool CGUIFontGlyphAtlas::RenderGlyph(uint32_t letterAndStyle, Glyph& glyph)
+{
+  wchar_t letter = (wchar_t)(letterAndStyle & 0xffff);
+  uint32_t style = letterAndStyle >> 16;
+  memset(&glyph, 0, sizeof(glyph));
+
+  // glyphs which can't be rendered are remembered as empty ones
+  if (FT_Load_Glyph(m_face, FT_Get_Char_Index(m_face, letter), FT_LOAD_TARGET_LIGHT))
+  {
+    CLog::Log(LOGDEBUG, "%s Failed to load glyph %x", __FUNCTION__, letter);
+    return true;
+  }
+  // make bold if applicable
+  if (style & FONT_STYLE_BOLD)
+    CGUIFontTTFBase::EmboldenGlyph(m_face->glyph);
+  // and italics if applicable
+  if (style & FONT_STYLE_ITALICS)
+    CGUIFontTTFBase::ObliqueGlyph(m_face->glyph);
+  // and light if applicable
+  if (style & FONT_STYLE_LIGHT)
+    CGUIFontTTFBase::LightenGlyph(m_face->glyph);
+
+  glyph.advance = m_face->glyph->advance.x / 64.0f;
+
+  FT_Glyph ftGlyph = NULL;
+  if (FT_Get_Glyph(m_face->glyph, &ftGlyph))
+  {
+    CLog::Log(LOGDEBUG, "%s Failed to get glyph %x", __FUNCTION__, letter);
+    return true;
+  }
+  if (m_stroker)
+    FT_Glyph_StrokeBorder(&ftGlyph, m_stroker, 0, 1);
+  if (FT_Glyph_To_Bitmap(&ftGlyph, FT_RENDER_MODE_NORMAL, NULL, 1))
+  {
+    CLog::Log(LOGDEBUG, "%s Failed to render glyph %x to a bitmap", __FUNCTION__, letter);
+    FT_Done_Glyph(ftGlyph);
+    return true;
+  }
+
+  FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)ftGlyph;
+  const FT_Bitmap& bitmap = bitGlyph->bitmap;
+  if (bitmap.width == 0 || bitmap.rows == 0)
+  {
+    FT_Done_Glyph(ftGlyph);
+    return true;
+  }
+
+  unsigned int padding = m_distanceField ? DISTANCE_FIELD_SPREAD : 0;
+  glyph.width = bitmap.width + 2 * padding;
+  glyph.height = bitmap.rows + 2 * padding;
+  glyph.bearingX = (float)bitGlyph->left - padding;
+  glyph.bearingY = (float)bitGlyph->top + padding;
+
+  if (!Reserve(glyph.width, glyph.height, glyph.x, glyph.y))
+  {
+    FT_Done_Glyph(ftGlyph);
+    return false;
+  }
+
+  // rows of bitmaps with a negative pitch are stored from the bottom up
+  const unsigned char* top = bitmap.buffer;
+  if (bitmap.pitch < 0)
+    top -= static_cast<ptrdiff_t>(bitmap.rows - 1) * bitmap.pitch;
+
+  unsigned char* target = &m_pixels[glyph.y * m_width + glyph.x];
+  if (m_distanceField)
+    GenerateDistanceField(top, bitmap.width, bitmap.rows, bitmap.pitch, padding, target, m_width);
+  else
+  {
+    const unsigned char* source = top;
+    for (unsigned int y = 0; y < bitmap.rows; y++)
+    {
+      memcpy(target, source, bitmap.width);
+      source += bitmap.pitch;
+      target += m_width;
+    }
+  }
+  MarkDirty(glyph.y, glyph.y + glyph.height);
+
+  FT_Done_Glyph(ftGlyph);
+  return true;
+}
+
+/*
+ Squared euclidean distance transform of a sampled function in one dimension,
+ see Felzenszwalb & Huttenlocher, "Distance Transforms of Sampled Functions".
+ */
+static void DistanceTransform(float* f, unsigned int n, unsigned int stride, float* d, unsigned int* v, float* z)
+{
+  unsigned int k = 0;
+  v[0] = 0;
+  z[0] = -DISTANCE_INFINITE;
+  z[1] = DISTANCE_INFINITE;
+  for (unsigned int q = 1; q < n; q++)
+  {
+    float fq = f[q * stride] + (float)(q * q);
+    float s = (fq - f[v[k] * stride] - (float)(v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+    while (s <= z[k])
+    {
+      k--;
+      s = (fq - f[v[k] * stride] - (float)(v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = DISTANCE_INFINITE;
+  }
+
+  k = 0;
+  for (unsigned int q = 0; q < n; q++)
+  {
+    while (z[k + 1] < q)
+      k++;
+    float delta = (float)q - v[k];
+    d[q] = delta * delta + f[v[k] * stride];
+  }
+  for (unsigned int q = 0; q < n; q++)
+    f[q * stride] = d[q];
+}
+
+static void DistanceTransform(std::vector<float>& grid, unsigned int width, unsigned int height)
+{
+  unsigned int size = std::max(width, height);
+  std::vector<float> d(size);
+  std::vector<unsigned int> v(size);
+  std::vector<float> z(size + 1);
+
+  for (unsigned int x = 0; x < width; x++)
+    DistanceTransform(&grid[x], height, width, &d[0], &v[0], &z[0]);
+  for (unsigned int y = 0; y < height; y++)
+    DistanceTransform(&grid[y * width], width, 1, &d[0], &v[0], &z[0]);
+}
+
+void CGUIFontGlyphAtlas::GenerateDistanceField(const unsigned char* src, unsigned int width, unsigned int height, int pitch,
+                                               unsigned int spread, unsigned char* dst, unsigned int dstPitch)
+{
+  const unsigned int fieldWidth = width + 2 * spread;
+  const unsigned int fieldHeight = height + 2 * spread;
+
+  // squared distances to the nearest pixel inside (outer) and outside (inner) of the glyph,
+  // anti-aliased edge pixels get the distance of the outline within the pixel
+  std::vector<float> outer(fieldWidth * fieldHeight, DISTANCE_INFINITE);
+  std::vector<float> inner(fieldWidth * fieldHeight, 0.0f);
+  for (unsigned int y = 0; y < height; y++)
+  {
+    const unsigned char* row = src + static_cast<ptrdiff_t>(y) * pitch;
+    for (unsigned int x = 0; x < width; x++)
+    {
+      unsigned int i = (y + spread) * fieldWidth + x + spread;
+      if (row[x] == 255)
+      {
+        outer[i] = 0.0f;
+        inner[i] = DISTANCE_INFINITE;
+      }
+      else if (row[x] > 0)
+      {
+        float edge = 0.5f - row[x] / 255.0f;
+        outer[i] = edge > 0.0f ? edge * edge : 0.0f;
+        inner[i] = edge < 0.0f ? edge * edge : 0.0f;
+      }
+    }
+  }
+
+  DistanceTransform(outer, fieldWidth, fieldHeight);
+  DistanceTransform(inner, fieldWidth, fieldHeight);
+
+  // 0.5 on the outline, growing towards the inside of the glyph
+  for (unsigned int y = 0; y < fieldHeight; y++)
+  {
+    for (unsigned int x = 0; x < fieldWidth; x++)
+    {
+      unsigned int i = y * fieldWidth + x;
+      float distance = sqrtf(outer[i]) - sqrtf(inner[i]);
+      float value = 0.5f - distance / (2.0f * spread);
+      dst[y * dstPitch + x] = (unsigned char)(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+  }
+}
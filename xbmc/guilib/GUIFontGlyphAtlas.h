@@ -0,0 +1,172 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/auto_buffer.h"
+
+struct FT_FaceRec_;
+struct FT_StrokerRec_;
+typedef struct FT_FaceRec_ *FT_Face;
+typedef struct FT_StrokerRec_ *FT_Stroker;
+
+/*!
+ \ingroup textures
+ \brief Glyphs of a font face rendered once into an 8 bit alpha texture.
+
+ With a distance field the texture doesn't hold the coverage of the glyphs
+ but the distance of each pixel to the outline (0.5 on the outline, larger
+ inside the glyph) so the glyphs can be drawn at any size with a shader
+ thresholding the interpolated distance. One such atlas is shared between
+ all sizes and aspects of a font file, see GetSharedAtlas().
+
+ Without a distance field the atlas is a plain glyph cache for a single size.
+
+ The atlas only holds the pixels, uploading them is up to the renderer (see
+ GetDirtyRows() and SetHardwareTexture()). Access has to be serialized by
+ the caller, the fonts use the graphics context lock for this.
+ */
+class CGUIFontGlyphAtlas
+{
+public:
+  struct Glyph
+  {
+    float bearingX;       ///< left edge of the bitmap relative to the pen position
+    float bearingY;       ///< top edge of the bitmap above the base line
+    float advance;        ///< horizontal advance of the pen position
+    unsigned int x, y;    ///< top left corner of the bitmap in the atlas
+    unsigned int width;   ///< width of the bitmap in the atlas
+    unsigned int height;  ///< height of the bitmap in the atlas
+  };
+
+  /*!
+   \brief Create an atlas for a font file
+   \param fontFile path of the font file
+   \param size size in pixels the glyphs are rendered with
+   \param distanceField whether to store distance fields instead of coverage
+   \param border whether to render the outline of the glyphs (bordered fonts)
+   \param maxTextureSize the maximum width and height of the texture
+   */
+  CGUIFontGlyphAtlas(const std::string& fontFile, float size, bool distanceField, bool border, unsigned int maxTextureSize);
+  ~CGUIFontGlyphAtlas();
+
+  /*!
+   \brief Get the distance field atlas of a font file, shared by all fonts using the file
+   \return the atlas or an empty pointer if the font can't be loaded
+   */
+  static std::shared_ptr<CGUIFontGlyphAtlas> GetSharedAtlas(const std::string& fontFile, bool border, unsigned int maxTextureSize);
+
+  bool Load();
+
+  /*!
+   \brief Get a glyph, rendering it into the atlas if it isn't in there yet
+   \param letterAndStyle the character in the lower 16 bits and the FONT_STYLE_* flags above
+   \return the glyph or NULL if it can't be rendered or the atlas is full, see Reset()
+   */
+  const Glyph* GetGlyph(uint32_t letterAndStyle);
+
+  /*!
+   \brief Drop all glyphs to make room for new ones
+   Increments the generation so fonts sharing the atlas know their glyphs are gone.
+   */
+  void Reset();
+
+  float GetSize() const { return m_size; }
+  bool IsDistanceField() const { return m_distanceField; }
+  unsigned int GetGeneration() const { return m_generation; }
+
+  unsigned int GetWidth() const { return m_width; }
+  unsigned int GetHeight() const { return m_height; }
+  const unsigned char* GetPixels() const { return m_pixels.empty() ? NULL : &m_pixels[0]; }
+
+  /*!
+   \brief Get the rows changed since the last call to ClearDirtyRows()
+   \return false if nothing changed
+   */
+  bool GetDirtyRows(unsigned int& y1, unsigned int& y2) const;
+  void ClearDirtyRows() { m_dirtyY1 = m_dirtyY2 = 0; }
+
+  /*!
+   \brief The texture the renderer uploaded the atlas to, released with the atlas
+   */
+  unsigned int GetHardwareTexture() const { return m_hwTexture; }
+  unsigned int GetHardwareTextureHeight() const { return m_hwTextureHeight; }
+  void SetHardwareTexture(unsigned int texture, unsigned int height) { m_hwTexture = texture; m_hwTextureHeight = height; }
+
+  /*!
+   \brief Number of glyphs which had to be rendered as they weren't in the atlas
+   */
+  unsigned int GetMisses() const { return m_misses; }
+  unsigned int GetGlyphCount() const { return m_glyphs.size(); }
+  size_t GetMemoryUsage() const { return m_pixels.size(); }
+
+  /*!
+   \brief Convert an 8 bit coverage bitmap to a distance field
+   \param src the top row of the coverage bitmap
+   \param width width of the bitmap
+   \param height height of the bitmap
+   \param pitch bytes from one row to the one below, negative for bitmaps stored bottom up
+   \param spread distance in pixels mapped to the full range, the bitmap is padded by it on every side
+   \param dst the distance field of (width + 2 * spread) x (height + 2 * spread) pixels
+   \param dstPitch bytes per row of the distance field
+   */
+  static void GenerateDistanceField(const unsigned char* src, unsigned int width, unsigned int height, int pitch,
+                                    unsigned int spread, unsigned char* dst, unsigned int dstPitch);
+
+private:
+  CGUIFontGlyphAtlas(const CGUIFontGlyphAtlas&);
+  CGUIFontGlyphAtlas& operator=(const CGUIFontGlyphAtlas&);
+
+  bool RenderGlyph(uint32_t letterAndStyle, Glyph& glyph);
+  bool Reserve(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y);
+  void MarkDirty(unsigned int y1, unsigned int y2);
+
+  std::string m_fontFile;
+  float m_size;
+  bool m_distanceField;
+  bool m_border;
+  unsigned int m_maxTextureSize;
+
+  FT_Face m_face;
+  FT_Stroker m_stroker;
+  XUTILS::auto_buffer m_fontFileInMemory;
+
+  std::unordered_map<uint32_t, Glyph> m_glyphs;
+  std::vector<unsigned char> m_pixels;
+  unsigned int m_width;
+  unsigned int m_height;
+
+  // shelf packing: glyphs are put next to each other in rows of the height of the largest glyph
+  unsigned int m_shelfX;
+  unsigned int m_shelfY;
+  unsigned int m_shelfHeight;
+
+  unsigned int m_dirtyY1;
+  unsigned int m_dirtyY2;
+  unsigned int m_hwTexture;
+  unsigned int m_hwTextureHeight;
+  unsigned int m_generation;
+  unsigned int m_misses;
+};
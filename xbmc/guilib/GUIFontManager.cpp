@@ -183,6 +183,8 @@ bool GUIFontManager::OnMessage(CGUIMessage &message)
   if (message.GetParam1() == GUI_MSG_RENDERER_RESET)
   { // our device has been reset - we have to reload our ttf fonts, and send
     // a message to controls that we have done so
+    for (std::vector<CGUIFontTTFBase*>::iterator it = m_vecFontFiles.begin(); it != m_vecFontFiles.end(); ++it)
+      (*it)->ResetAtlasTexture();
     ReloadTTFFonts();
     g_windowManager.SendMessage(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_WINDOW_RESIZE);
     m_canReload = true;
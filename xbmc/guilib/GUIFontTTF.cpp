@@ -20,10 +20,12 @@
 
 #include "GUIFont.h"
 #include "GUIFontTTF.h"
+#include "GUIFontGlyphAtlas.h"
 #include "GUIFontManager.h"
 #include "Texture.h"
 #include "GraphicContext.h"
 #include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
 #include "utils/MathUtils.h"
 #include "utils/log.h"
 #include "windowing/WindowingFactory.h"
@@ -49,7 +51,6 @@
 #endif
 
 #define CHARS_PER_TEXTURE_LINE 20 // number of characters to cache per texture line
-#define CHAR_CHUNK    64      // 64 chars allocated at a time (1024 bytes)
 
 
 class CFreeTypeLibrary
@@ -153,8 +154,6 @@ XBMC_GLOBAL_REF(CFreeTypeLibrary, g_freeTypeLibrary); // our freetype library
 CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache(*this), m_dynamicCache(*this)
 {
   m_texture = NULL;
-  m_char = NULL;
-  m_maxChars = 0;
   m_nestedBeginCount = 0;
 
   m_vertex.reserve(4*1024);
@@ -166,7 +165,8 @@ CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache
   m_referenceCount = 0;
   m_originX = m_originY = 0.0f;
   m_cellBaseLine = m_cellHeight = 0;
-  m_numChars = 0;
+  m_atlasGeneration = 0;
+  m_aspect = 1.0f;
   m_posX = m_posY = 0;
   m_textureHeight = m_textureWidth = 0;
   m_textureScaleX = m_textureScaleY = 0.0;
@@ -196,40 +196,52 @@ void CGUIFontTTFBase::RemoveReference()
 
 void CGUIFontTTFBase::ClearCharacterCache()
 {
+  m_char.clear();
+  memset(m_charquick, 0, sizeof(m_charquick));
+
+  if (m_atlas)
+  {
+    // make room in the shared atlas, the other fonts using it notice the new generation
+    m_atlas->Reset();
+    m_atlasGeneration = m_atlas->GetGeneration();
+    m_staticCache.Flush();
+    m_dynamicCache.Flush();
+    return;
+  }
+
   delete(m_texture);
 
   DeleteHardwareTexture();
 
   m_texture = NULL;
-  delete[] m_char;
-  m_char = new Character[CHAR_CHUNK];
-  memset(m_charquick, 0, sizeof(m_charquick));
-  m_numChars = 0;
-  m_maxChars = CHAR_CHUNK;
   // set the posX and posY so that our texture will be created on first character write.
   m_posX = m_textureWidth;
   m_posY = -(int)GetTextureLineHeight();
   m_textureHeight = 0;
 }
 
+void CGUIFontTTFBase::ResetAtlasTexture()
+{
+  if (m_atlas)
+    DeleteHardwareTexture();
+}
+
 void CGUIFontTTFBase::Clear()
 {
   delete(m_texture);
   m_texture = NULL;
-  delete[] m_char;
+  m_char.clear();
   memset(m_charquick, 0, sizeof(m_charquick));
-  m_char = NULL;
-  m_maxChars = 0;
-  m_numChars = 0;
+  m_atlas.reset();
   m_posX = 0;
   m_posY = 0;
   m_nestedBeginCount = 0;
 
   if (m_face)
-    g_freeTypeLibrary.ReleaseFont(m_face);
+    ReleaseFace(m_face);
   m_face = NULL;
   if (m_stroker)
-    g_freeTypeLibrary.ReleaseStroker(m_stroker);
+    ReleaseStroker(m_stroker);
   m_stroker = NULL;
 
   m_vertexTrans.clear();
@@ -243,10 +255,11 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 {
   // we now know that this object is unique - only the GUIFont objects are non-unique, so no need
   // for reference tracking these fonts
-  m_face = g_freeTypeLibrary.GetFont(strFilename, height, aspect, m_fontFileInMemory);
+  m_face = LoadFace(strFilename, height, aspect, m_fontFileInMemory);
 
   if (!m_face)
     return false;
+  m_aspect = aspect;
 
   /*
    the values used are described below
@@ -275,16 +288,12 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
      add on the strength of any border - the non-bordered font needs
      aligning with the bordered font by utilising GetTextBaseLine()
      */
-    FT_Pos strength = FT_MulFix( m_face->units_per_EM, m_face->size->metrics.y_scale) / 12;
-    if (strength < 128)
-      strength = 128;
+    FT_Pos strength = GetBorderStrength(m_face);
 
     cellDescender -= strength;
     cellAscender  += strength;
 
-    m_stroker = g_freeTypeLibrary.GetStroker();
-    if (m_stroker)
-      FT_Stroker_Set(m_stroker, strength, FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+    m_stroker = CreateStroker(strength);
   }
 
   // scale to pixel sizing, rounding so that maximal extent is obtained
@@ -299,11 +308,8 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 
   delete(m_texture);
   m_texture = NULL;
-  delete[] m_char;
-  m_char = NULL;
-
-  m_maxChars = 0;
-  m_numChars = 0;
+  m_char.clear();
+  memset(m_charquick, 0, sizeof(m_charquick));
 
   m_strFilename = strFilename;
 
@@ -320,6 +326,19 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
   m_posX = m_textureWidth;
   m_posY = -(int)GetTextureLineHeight();
 
+  // render the glyphs once for all sizes of this font if possible
+  m_atlas.reset();
+  if (g_advancedSettings.m_guiFontDistanceField && SupportsDistanceField())
+  {
+    m_atlas = CGUIFontGlyphAtlas::GetSharedAtlas(strFilename, border, g_Windowing.GetMaxTextureSize());
+    if (m_atlas)
+    {
+      m_atlasGeneration = m_atlas->GetGeneration();
+      m_textureWidth = m_textureHeight = 0;
+      UpdateAtlas();
+    }
+  }
+
   // cache the ellipses width
   Character *ellipse = GetCharacter(L'.');
   if (ellipse) m_ellipsesWidth = ellipse->advance;
@@ -329,7 +348,7 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 
 void CGUIFontTTFBase::Begin()
 {
-  if (m_nestedBeginCount == 0 && m_texture != NULL && FirstBegin())
+  if (m_nestedBeginCount == 0 && (m_texture != NULL || (m_atlas && m_atlas->GetHeight() > 0)) && FirstBegin())
   {
     m_vertexTrans.clear();
     m_vertex.clear();
@@ -352,6 +371,7 @@ void CGUIFontTTFBase::End()
 void CGUIFontTTFBase::DrawTextInternal(float x, float y, const vecColors &colors, const vecText &text, uint32_t alignment, float maxPixelWidth, bool scrolling)
 {
   Begin();
+  UpdateAtlas();
 
   uint32_t rawAlignment = alignment;
   bool dirtyCache(false);
@@ -564,7 +584,7 @@ float CGUIFontTTFBase::GetTextWidthInternal(vecText::const_iterator start, vecTe
       // and not advance distance - this makes sure that italic text isn't
       // choped on the end (as render width is larger than advance then).
       if (start == end)
-        width += std::max(c->right - c->left + c->offsetX, c->advance);
+        width += std::max(c->width + c->offsetX, c->advance);
       else
         width += c->advance;
     }
@@ -618,49 +638,21 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   // letters are stored based on style and letter
   character_t ch = (style << 16) | letter;
 
-  int low = 0;
-  int high = m_numChars - 1;
-  while (low <= high)
-  {
-    int mid = (low + high) >> 1;
-    if (ch > m_char[mid].letterAndStyle)
-      low = mid + 1;
-    else if (ch < m_char[mid].letterAndStyle)
-      high = mid - 1;
-    else
-      return &m_char[mid];
-  }
-  // if we get to here, then low is where we should insert the new character
-
-  // increase the size of the buffer if we need it
-  if (m_numChars >= m_maxChars)
-  { // need to increase the size of the buffer
-    Character *newTable = new Character[m_maxChars + CHAR_CHUNK];
-    if (m_char)
-    {
-      memcpy(newTable, m_char, low * sizeof(Character));
-      memcpy(newTable + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
-      delete[] m_char;
-    }
-    m_char = newTable;
-    m_maxChars += CHAR_CHUNK;
+  std::unordered_map<character_t, Character>::iterator it = m_char.find(ch);
+  if (it != m_char.end())
+    return &it->second;
 
-  }
-  else
-  { // just move the data along as necessary
-    memmove(m_char + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
-  }
   // render the character to our texture
   // must End() as we can't render text to our texture during a Begin(), End() block
+  Character character;
   unsigned int nestedBeginCount = m_nestedBeginCount;
   m_nestedBeginCount = 1;
   if (nestedBeginCount) End();
-  if (!CacheCharacter(letter, style, m_char + low))
+  if (!CacheCharacter(letter, style, &character))
   { // unable to cache character - try clearing them all out and starting over
-    CLog::Log(LOGDEBUG, "%s: Unable to cache character.  Clearing character cache of %i characters", __FUNCTION__, m_numChars);
+    CLog::Log(LOGDEBUG, "%s: Unable to cache character.  Clearing character cache of %u characters", __FUNCTION__, static_cast<unsigned int>(m_char.size()));
     ClearCharacterCache();
-    low = 0;
-    if (!CacheCharacter(letter, style, m_char + low))
+    if (!CacheCharacter(letter, style, &character))
     {
       CLog::Log(LOGERROR, "%s: Unable to cache character (out of memory?)", __FUNCTION__);
       if (nestedBeginCount) Begin();
@@ -671,22 +663,19 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   if (nestedBeginCount) Begin();
   m_nestedBeginCount = nestedBeginCount;
 
-  // fixup quick access
-  memset(m_charquick, 0, sizeof(m_charquick));
-  for(int i=0;i<m_numChars;i++)
-  {
-    if ((m_char[i].letterAndStyle & 0xffff) < 255)
-    {
-      character_t ch = ((m_char[i].letterAndStyle & 0xffff0000) >> 8) | (m_char[i].letterAndStyle & 0xff);
-      m_charquick[ch] = m_char+i;
-    }
-  }
+  // the elements of the map don't move when it grows so they can be pointed to
+  Character *result = &(m_char[ch] = character);
+  if (letter < 255)
+    m_charquick[(style << 8) | letter] = result;
 
-  return m_char + low;
+  return result;
 }
 
 bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
 {
+  if (m_atlas)
+    return CacheCharacterFromAtlas(letter, style, ch);
+
   int glyph_index = FT_Get_Char_Index( m_face, letter );
 
   FT_Glyph glyph = NULL;
@@ -774,6 +763,8 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
   ch->top = isEmptyGlyph ? 0 : ((float)m_posY + ch->offsetY);
   ch->right = ch->left + bitmap.width;
   ch->bottom = ch->top + bitmap.rows;
+  ch->width = (float)bitmap.width;
+  ch->height = (float)bitmap.rows;
   ch->advance = (float)MathUtils::round_int( (float)m_face->glyph->advance.x / 64 );
 
   // we need only render if we actually have some pixels
@@ -788,7 +779,6 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
   
     m_posX += spacing_between_characters_in_texture + (unsigned short)std::max(ch->right - ch->left + ch->offsetX, ch->advance);
   }
-  m_numChars++;
 
   // free the glyph
   FT_Done_Glyph(glyph);
@@ -796,12 +786,64 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
   return true;
 }
 
+bool CGUIFontTTFBase::CacheCharacterFromAtlas(wchar_t letter, uint32_t style, Character *ch)
+{
+  const CGUIFontGlyphAtlas::Glyph *glyph = m_atlas->GetGlyph((style << 16) | letter);
+  if (!glyph)
+    return false;
+
+  // the atlas may have grown, changing the texture coordinates
+  UpdateAtlas();
+
+  // the glyph is scaled from the size of the atlas to ours
+  const float scaleY = m_height / m_atlas->GetSize();
+  const float scaleX = scaleY * m_aspect;
+
+  ch->letterAndStyle = (style << 16) | letter;
+  ch->offsetX = (short)MathUtils::round_int(glyph->bearingX * scaleX);
+  ch->offsetY = (short)m_cellBaseLine - (short)MathUtils::round_int(glyph->bearingY * scaleY);
+  ch->left = (float)glyph->x;
+  ch->top = (float)glyph->y;
+  ch->right = ch->left + glyph->width;
+  ch->bottom = ch->top + glyph->height;
+  ch->width = glyph->width * scaleX;
+  ch->height = glyph->height * scaleY;
+  ch->advance = (float)MathUtils::round_int(glyph->advance * scaleX);
+
+  return true;
+}
+
+void CGUIFontTTFBase::UpdateAtlas()
+{
+  if (!m_atlas)
+    return;
+
+  if (m_atlasGeneration != m_atlas->GetGeneration())
+  { // another font made room in the atlas, our characters are gone
+    m_char.clear();
+    memset(m_charquick, 0, sizeof(m_charquick));
+    m_atlasGeneration = m_atlas->GetGeneration();
+    m_staticCache.Flush();
+    m_dynamicCache.Flush();
+  }
+
+  if (m_textureWidth != m_atlas->GetWidth() || m_textureHeight != m_atlas->GetHeight())
+  { // texture coordinates are relative to the size of the atlas
+    m_textureWidth = m_atlas->GetWidth();
+    m_textureHeight = m_atlas->GetHeight();
+    m_textureScaleX = m_textureWidth ? 1.0f / m_textureWidth : 0.0f;
+    m_textureScaleY = m_textureHeight ? 1.0f / m_textureHeight : 0.0f;
+    m_staticCache.Flush();
+    m_dynamicCache.Flush();
+  }
+}
+
 void CGUIFontTTFBase::RenderCharacter(float posX, float posY, const Character *ch, color_t color, bool roundX, std::vector<SVertex> &vertices)
 {
   // actual image width isn't same as the character width as that is
   // just baseline width and height should include the descent
-  const float width = ch->right - ch->left;
-  const float height = ch->bottom - ch->top;
+  const float width = ch->width;
+  const float height = ch->height;
   
   // return early if nothing to render
   if (width == 0 || height == 0)
@@ -944,6 +986,37 @@ void CGUIFontTTFBase::RenderCharacter(float posX, float posY, const Character *c
 #endif
 }
 
+FT_Face CGUIFontTTFBase::LoadFace(const std::string &filename, float size, float aspect, XUTILS::auto_buffer& memoryBuf)
+{
+  return g_freeTypeLibrary.GetFont(filename, size, aspect, memoryBuf);
+}
+
+void CGUIFontTTFBase::ReleaseFace(FT_Face face)
+{
+  g_freeTypeLibrary.ReleaseFont(face);
+}
+
+long CGUIFontTTFBase::GetBorderStrength(FT_Face face)
+{
+  FT_Pos strength = FT_MulFix( face->units_per_EM, face->size->metrics.y_scale) / 12;
+  if (strength < 128)
+    strength = 128;
+  return strength;
+}
+
+FT_Stroker CGUIFontTTFBase::CreateStroker(long strength)
+{
+  FT_Stroker stroker = g_freeTypeLibrary.GetStroker();
+  if (stroker)
+    FT_Stroker_Set(stroker, strength, FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+  return stroker;
+}
+
+void CGUIFontTTFBase::ReleaseStroker(FT_Stroker stroker)
+{
+  g_freeTypeLibrary.ReleaseStroker(stroker);
+}
+
 // Oblique code - original taken from freetype2 (ftsynth.c)
 void CGUIFontTTFBase::ObliqueGlyph(FT_GlyphSlot slot)
 {
@@ -974,8 +1047,8 @@ void CGUIFontTTFBase::EmboldenGlyph(FT_GlyphSlot slot)
     return;
 
   /* some reasonable strength */
-  FT_Pos strength = FT_MulFix( m_face->units_per_EM,
-                    m_face->size->metrics.y_scale ) / 24;
+  FT_Pos strength = FT_MulFix( slot->face->units_per_EM,
+                    slot->face->size->metrics.y_scale ) / 24;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox( &slot->outline, &bbox_before );
@@ -1007,8 +1080,8 @@ void CGUIFontTTFBase::LightenGlyph(FT_GlyphSlot slot)
     return;
 
   /* some reasonable strength */
-  FT_Pos strength = FT_MulFix(m_face->units_per_EM,
-                              m_face->size->metrics.y_scale) / -48;
+  FT_Pos strength = FT_MulFix(slot->face->units_per_EM,
+                              slot->face->size->metrics.y_scale) / -48;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox(&slot->outline, &bbox_before);
@@ -27,8 +27,10 @@
  *
  */
 
+#include <memory>
 #include <string>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 #include "utils/auto_buffer.h"
@@ -44,6 +46,7 @@ using namespace DirectX::PackedVector;
 
 // forward definition
 class CBaseTexture;
+class CGUIFontGlyphAtlas;
 
 struct FT_FaceRec_;
 struct FT_LibraryRec_;
@@ -85,6 +88,7 @@ struct SVertex
 class CGUIFontTTFBase
 {
   friend class CGUIFont;
+  friend class CGUIFontGlyphAtlas;
 
 public:
 
@@ -103,11 +107,17 @@ public:
 
   const std::string& GetFileName() const { return m_strFileName; };
 
+  /*! \brief Drop the texture of the shared glyph atlas after the renderer was reset.
+   The atlas keeps its glyphs and is uploaded again by the next font drawing from it.
+   */
+  void ResetAtlasTexture();
+
 protected:
   struct Character
   {
     short offsetX, offsetY;
-    float left, top, right, bottom;
+    float left, top, right, bottom;   // position in the texture
+    float width, height;              // size on screen, differs from the texture for distance fields
     float advance;
     character_t letterAndStyle;
   };
@@ -130,6 +140,8 @@ protected:
   // Stuff for pre-rendering for speed
   inline Character *GetCharacter(character_t letter);
   bool CacheCharacter(wchar_t letter, uint32_t style, Character *ch);
+  bool CacheCharacterFromAtlas(wchar_t letter, uint32_t style, Character *ch);
+  void UpdateAtlas();
   void RenderCharacter(float posX, float posY, const Character *ch, color_t color, bool roundX, std::vector<SVertex> &vertices);
   void ClearCharacterCache();
 
@@ -137,9 +149,20 @@ protected:
   virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
   virtual void DeleteHardwareTexture() = 0;
 
+  /*! \brief whether the renderer can draw glyphs from a distance field atlas
+   */
+  virtual bool SupportsDistanceField() const { return false; }
+
+  // freetype faces and strokers
+  static FT_Face LoadFace(const std::string &filename, float size, float aspect, XUTILS::auto_buffer& memoryBuf);
+  static void ReleaseFace(FT_Face face);
+  static long GetBorderStrength(FT_Face face);
+  static FT_Stroker CreateStroker(long strength);
+  static void ReleaseStroker(FT_Stroker stroker);
+
   // modifying glyphs
-  void EmboldenGlyph(FT_GlyphSlot slot);
-  void LightenGlyph(FT_GlyphSlot slot);
+  static void EmboldenGlyph(FT_GlyphSlot slot);
+  static void LightenGlyph(FT_GlyphSlot slot);
   static void ObliqueGlyph(FT_GlyphSlot slot);
 
   CBaseTexture* m_texture;        // texture that holds our rendered characters (8bit alpha only)
@@ -157,10 +180,12 @@ protected:
 
   color_t m_color;
 
-  Character *m_char;                 // our characters
+  std::unordered_map<character_t, Character> m_char; // our characters, by style and letter
   Character *m_charquick[256*7];     // ascii chars (7 styles) here
-  int m_maxChars;                    // size of character array (can be incremented)
-  int m_numChars;                    // the current number of cached characters
+
+  std::shared_ptr<CGUIFontGlyphAtlas> m_atlas; // distance field atlas shared with the other sizes of the font
+  unsigned int m_atlasGeneration;    // generation of the atlas our characters were taken from
+  float m_aspect;
 
   float m_ellipsesWidth;               // this is used every character (width of '.')
 
@@ -21,6 +21,7 @@
 #include "system.h"
 #include "GUIFont.h"
 #include "GUIFontTTFGL.h"
+#include "GUIFontGlyphAtlas.h"
 #include "GUIFontManager.h"
 #include "Texture.h"
 #include "TextureManager.h"
@@ -57,6 +58,9 @@ CGUIFontTTFGL::~CGUIFontTTFGL(void)
 
 bool CGUIFontTTFGL::FirstBegin()
 {
+  if (m_atlas)
+    UpdateAtlasTexture();
+
   if (m_textureStatus == TEXTURE_REALLOCATED)
   {
     if (glIsTexture(m_nTexture))
@@ -163,7 +167,7 @@ void CGUIFontTTFGL::LastEnd()
   glDisable(GL_TEXTURE_2D);
 #else
   // GLES 2.0 version.
-  g_Windowing.EnableGUIShader(SM_FONTS);
+  g_Windowing.EnableGUIShader(m_atlas ? SM_FONTS_DISTANCE_FIELD : SM_FONTS);
 
   CreateStaticVertexBuffers();
 
@@ -388,8 +392,55 @@ bool CGUIFontTTFGL::CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1,
 }
 
 
+void CGUIFontTTFGL::UpdateAtlasTexture()
+{
+  // the texture of the atlas is shared by all fonts using it, whoever draws first uploads the changes
+  GLuint texture = m_atlas->GetHardwareTexture();
+  if (texture == 0 || m_atlas->GetHardwareTextureHeight() != m_atlas->GetHeight())
+  {
+    if (texture != 0)
+      g_TextureManager.ReleaseHwTexture(texture);
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, m_atlas->GetWidth(), m_atlas->GetHeight(), 0,
+        GL_ALPHA, GL_UNSIGNED_BYTE, m_atlas->GetPixels());
+    VerifyGLState();
+
+    m_atlas->SetHardwareTexture(texture, m_atlas->GetHeight());
+    m_atlas->ClearDirtyRows();
+  }
+  else
+  {
+    unsigned int y1, y2;
+    if (m_atlas->GetDirtyRows(y1, y2))
+    {
+      glBindTexture(GL_TEXTURE_2D, texture);
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y1, m_atlas->GetWidth(), y2 - y1, GL_ALPHA, GL_UNSIGNED_BYTE,
+          m_atlas->GetPixels() + y1 * m_atlas->GetWidth());
+      m_atlas->ClearDirtyRows();
+    }
+  }
+
+  m_nTexture = texture;
+  m_textureStatus = TEXTURE_READY;
+}
+
 void CGUIFontTTFGL::DeleteHardwareTexture()
 {
+  if (m_atlas)
+  {
+    // the texture belongs to the atlas, without it the next font drawing uploads the whole atlas again
+    GLuint texture = m_atlas->GetHardwareTexture();
+    if (texture != 0 && glIsTexture(texture))
+      g_TextureManager.ReleaseHwTexture(texture);
+    m_atlas->SetHardwareTexture(0, 0);
+    m_textureStatus = TEXTURE_VOID;
+    return;
+  }
+
   if (m_textureStatus != TEXTURE_VOID)
   {
     if (glIsTexture(m_nTexture))
@@ -56,6 +56,9 @@ protected:
   virtual CBaseTexture* ReallocTexture(unsigned int& newHeight);
   virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2);
   virtual void DeleteHardwareTexture();
+#if HAS_GLES
+  virtual bool SupportsDistanceField() const { return true; }
+#endif
 
 #if HAS_GLES
 #define ELEMENT_ARRAY_MAX_CHAR_INDEX (1000)
@@ -64,6 +67,8 @@ protected:
 #endif
 
 private:
+  void UpdateAtlasTexture();
+
   unsigned int m_updateY1;
   unsigned int m_updateY2;
   
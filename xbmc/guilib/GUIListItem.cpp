@@ -25,14 +25,8 @@
 #include "GUIListItemLayout.h"
 #include "utils/Archive.h"
 #include "utils/CharsetConverter.h"
-#include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
-bool CGUIListItem::icompare::operator()(const std::string &s1, const std::string &s2) const
-{
-  return StringUtils::CompareNoCase(s1, s2) < 0;
-}
-
 CGUIListItem::CGUIListItem(const CGUIListItem& item)
 {
   m_layout = NULL;
@@ -44,6 +38,7 @@ CGUIListItem::CGUIListItem(const CGUIListItem& item)
 CGUIListItem::CGUIListItem(void)
 {
   m_bIsFolder = false;
+  m_sortLabelIsLabel = false;
   m_bSelected = false;
   m_overlayIcon = ICON_OVERLAY_NONE;
   m_layout = NULL;
@@ -54,7 +49,7 @@ CGUIListItem::CGUIListItem(const std::string& strLabel):
   m_strLabel(strLabel)
 {
   m_bIsFolder = false;
-  SetSortLabel(strLabel);
+  m_sortLabelIsLabel = true;
   m_bSelected = false;
   m_overlayIcon = ICON_OVERLAY_NONE;
   m_layout = NULL;
@@ -70,9 +65,15 @@ void CGUIListItem::SetLabel(const std::string& strLabel)
 {
   if (m_strLabel == strLabel)
     return;
+  // the sort label sticks to the first non-empty label
+  if (m_sortLabelIsLabel && !m_strLabel.empty())
+  {
+    m_sortLabel = m_strLabel;
+    m_sortLabelIsLabel = false;
+  }
   m_strLabel = strLabel;
-  if (m_sortLabel.empty())
-    SetSortLabel(strLabel);
+  if (!m_sortLabelIsLabel && m_sortLabel.empty())
+    m_sortLabelIsLabel = true;
   SetInvalid();
 }
 
@@ -97,18 +98,23 @@ const std::string& CGUIListItem::GetLabel2() const
 
 void CGUIListItem::SetSortLabel(const std::string &label)
 {
-  g_charsetConverter.utf8ToW(label, m_sortLabel, false);
+  m_sortLabel = label;
+  m_sortLabelIsLabel = false;
   // no need to invalidate - this is never shown in the UI
 }
 
 void CGUIListItem::SetSortLabel(const std::wstring &label)
 {
-  m_sortLabel = label;
+  std::string utf8Label;
+  g_charsetConverter.wToUTF8(label, utf8Label);
+  SetSortLabel(utf8Label);
 }
 
-const std::wstring& CGUIListItem::GetSortLabel() const
+std::wstring CGUIListItem::GetSortLabel() const
 {
-  return m_sortLabel;
+  std::wstring sortLabel;
+  g_charsetConverter.utf8ToW(m_sortLabelIsLabel ? m_strLabel : m_sortLabel, sortLabel, false);
+  return sortLabel;
 }
 
 void CGUIListItem::SetArt(const std::string &type, const std::string &url)
@@ -238,6 +244,7 @@ CGUIListItem& CGUIListItem::operator =(const CGUIListItem& item)
   m_strLabel2 = item.m_strLabel2;
   m_strLabel = item.m_strLabel;
   m_sortLabel = item.m_sortLabel;
+  m_sortLabelIsLabel = item.m_sortLabelIsLabel;
   FreeMemory();
   m_bSelected = item.m_bSelected;
   m_strIcon = item.m_strIcon;
@@ -257,14 +264,14 @@ void CGUIListItem::Archive(CArchive &ar)
     ar << m_bIsFolder;
     ar << m_strLabel;
     ar << m_strLabel2;
-    ar << m_sortLabel;
+    ar << GetSortLabel();
     ar << m_strIcon;
     ar << m_bSelected;
     ar << m_overlayIcon;
     ar << (int)m_mapProperties.size();
     for (PropertyMap::const_iterator it = m_mapProperties.begin(); it != m_mapProperties.end(); ++it)
     {
-      ar << it->first;
+      ar << CAtomTable::GetString(it->first);
       ar << it->second;
     }
     ar << (int)m_art.size();
@@ -285,7 +292,14 @@ void CGUIListItem::Archive(CArchive &ar)
     ar >> m_bIsFolder;
     ar >> m_strLabel;
     ar >> m_strLabel2;
-    ar >> m_sortLabel;
+    std::wstring sortLabel;
+    ar >> sortLabel;
+    SetSortLabel(sortLabel);
+    if (m_sortLabel == m_strLabel)
+    {
+      m_sortLabel.clear();
+      m_sortLabelIsLabel = true;
+    }
     ar >> m_strIcon;
     ar >> m_bSelected;
 
@@ -311,6 +325,7 @@ void CGUIListItem::Archive(CArchive &ar)
       ar >> value;
       m_art.insert(make_pair(key, value));
     }
+    m_art.shrink_to_fit();
     ar >> mapSize;
     for (int i = 0; i < mapSize; i++)
     {
@@ -327,13 +342,13 @@ void CGUIListItem::Serialize(CVariant &value)
   value["isFolder"] = m_bIsFolder;
   value["strLabel"] = m_strLabel;
   value["strLabel2"] = m_strLabel2;
-  value["sortLabel"] = m_sortLabel;
+  value["sortLabel"] = GetSortLabel();
   value["strIcon"] = m_strIcon;
   value["selected"] = m_bSelected;
 
   for (PropertyMap::const_iterator it = m_mapProperties.begin(); it != m_mapProperties.end(); ++it)
   {
-    value["properties"][it->first] = it->second;
+    value["properties"][CAtomTable::GetString(it->first)] = it->second;
   }
   for (ArtMap::const_iterator it = m_art.begin(); it != m_art.end(); ++it)
     value["art"][it->first] = it->second;
@@ -393,10 +408,15 @@ void CGUIListItem::SetInvalid()
 
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  SetPropertyValue(CAtomTable::Intern(strKey), value);
+}
+
+void CGUIListItem::SetPropertyValue(CAtomTable::Atom key, const CVariant &value)
+{
+  PropertyMap::iterator iter = m_mapProperties.find(key);
   if (iter == m_mapProperties.end())
   {
-    m_mapProperties.insert(make_pair(strKey, value));
+    m_mapProperties.insert(std::make_pair(key, value));
     SetInvalid();
   }
   else if (iter->second != value)
@@ -408,7 +428,8 @@ void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 
 CVariant CGUIListItem::GetProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  // keys that were never interned can't be set on any item
+  PropertyMap::const_iterator iter = m_mapProperties.find(CAtomTable::Find(strKey));
   if (iter == m_mapProperties.end())
     return CVariant(CVariant::VariantTypeNull);
 
@@ -417,7 +438,7 @@ CVariant CGUIListItem::GetProperty(const std::string &strKey) const
 
 bool CGUIListItem::HasProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::const_iterator iter = m_mapProperties.find(CAtomTable::Find(strKey));
   if (iter == m_mapProperties.end())
     return false;
 
@@ -426,7 +447,7 @@ bool CGUIListItem::HasProperty(const std::string &strKey) const
 
 void CGUIListItem::ClearProperty(const std::string &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::iterator iter = m_mapProperties.find(CAtomTable::Find(strKey));
   if (iter != m_mapProperties.end())
   {
     m_mapProperties.erase(iter);
@@ -460,5 +481,5 @@ void CGUIListItem::IncrementProperty(const std::string &strKey, double dVal)
 void CGUIListItem::AppendProperties(const CGUIListItem &item)
 {
   for (PropertyMap::const_iterator i = item.m_mapProperties.begin(); i != item.m_mapProperties.end(); ++i)
-    SetProperty(i->first, i->second);
+    SetPropertyValue(i->first, i->second);
 }
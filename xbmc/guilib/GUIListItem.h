@@ -31,10 +31,13 @@
 #include <map>
 #include <string>
 
+#include "utils/AtomTable.h"
+#include "utils/FlatMap.h"
+#include "utils/Variant.h"
+
 //  Forward
 class CGUIListItemLayout;
 class CArchive;
-class CVariant;
 
 /*!
  \ingroup controls
@@ -43,7 +46,7 @@ class CVariant;
 class CGUIListItem
 {
 public:
-  typedef std::map<std::string, std::string> ArtMap;
+  typedef CFlatMap<std::string, std::string> ArtMap;
 
   enum GUIIconOverlay { ICON_OVERLAY_NONE = 0,
                         ICON_OVERLAY_RAR,
@@ -126,7 +129,13 @@ public:
 
   void SetSortLabel(const std::string &label);
   void SetSortLabel(const std::wstring &label);
-  const std::wstring &GetSortLabel() const;
+
+  /*! \brief Get the label used for sorting.
+   Sort labels are stored as UTF-8 and converted on request, as they are
+   only needed by the few callers comparing or indexing characters.
+   \return the sort label, the label if no sort label was set.
+   */
+  std::wstring GetSortLabel() const;
 
   void Select(bool bOnOff);
   bool IsSelected() const;
@@ -179,15 +188,16 @@ protected:
   CGUIListItemLayout *m_focusedLayout;
   bool m_bSelected;     // item is selected or not
 
-  struct icompare
-  {
-    bool operator()(const std::string &s1, const std::string &s2) const;
-  };
-
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
+  /*! Properties keyed by interned, case insensitive name.
+   \sa CAtomTable
+   */
+  typedef CFlatMap<CAtomTable::Atom, CVariant> PropertyMap;
   PropertyMap m_mapProperties;
 private:
-  std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
+  void SetPropertyValue(CAtomTable::Atom key, const CVariant &value);
+
+  std::string m_sortLabel;     // text for sorting, UTF-8
+  bool m_sortLabelIsLabel;     // m_sortLabel not materialized, sort by m_strLabel
   std::string m_strLabel;      // text of column1
 
   ArtMap m_art;
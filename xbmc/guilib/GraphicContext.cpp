@@ -920,7 +920,10 @@ void CGraphicContext::UpdateCameraPosition(const CPoint &camera, const float &fa
     RESOLUTION_INFO res = GetResInfo();
     RESOLUTION_INFO desktop = GetResInfo(RES_DESKTOP);
     float scaleRes = (static_cast<float>(res.iWidth) / static_cast<float>(desktop.iWidth));
-    float scaleX = static_cast<float>(CSettings::GetInstance().GetInt(CSettings::SETTING_LOOKANDFEEL_STEREOSTRENGTH)) * scaleRes;
+    // the graphics context exists before the settings, resolve the handle on first use
+    if (!m_stereoStrength.IsValid())
+      m_stereoStrength = CSettings::GetInstance().GetIntHandle(CSettings::SETTING_LOOKANDFEEL_STEREOSTRENGTH);
+    float scaleX = static_cast<float>(m_stereoStrength.Get()) * scaleRes;
     stereoFactor = factor * (m_stereoView == RENDER_STEREO_VIEW_LEFT ? scaleX : -scaleX);
   }
   g_Windowing.SetCameraPosition(camera, m_iScreenWidth, m_iScreenHeight, stereoFactor);
@@ -45,6 +45,7 @@
 #include "utils/GlobalsHandling.h"
 #include "DirtyRegion.h"
 #include "settings/lib/ISettingCallback.h"
+#include "settings/lib/SettingHandle.h"
 #include "rendering/RenderSystem.h"
 
 enum VIEW_TYPE { VIEW_TYPE_NONE = 0,
@@ -279,6 +280,7 @@ private:
   RENDER_STEREO_VIEW m_stereoView;
   RENDER_STEREO_MODE m_stereoMode;
   RENDER_STEREO_MODE m_nextStereoMode;
+  CSettingHandle<int> m_stereoStrength;
 
   CRect m_scissors;
 };
@@ -175,7 +175,8 @@ void CBaseTexture::ClampToEdge()
   }
 }
 
-CBaseTexture *CBaseTexture::LoadFromFile(const std::string& texturePath, unsigned int idealWidth, unsigned int idealHeight, bool requirePixels, const std::string& strMimeType)
+CBaseTexture *CBaseTexture::LoadFromFile(const std::string& texturePath, unsigned int idealWidth, unsigned int idealHeight, bool requirePixels,
+                                         const std::string& strMimeType, LimitSizeFunc limitSize)
 {
 #if defined(TARGET_ANDROID)
   CURL url(texturePath);
@@ -200,22 +201,24 @@ CBaseTexture *CBaseTexture::LoadFromFile(const std::string& texturePath, unsigne
   }
 #endif
   CTexture *texture = new CTexture();
-  if (texture->LoadFromFileInternal(texturePath, idealWidth, idealHeight, requirePixels, strMimeType))
+  if (texture->LoadFromFileInternal(texturePath, idealWidth, idealHeight, requirePixels, strMimeType, limitSize))
     return texture;
   delete texture;
   return NULL;
 }
 
-CBaseTexture *CBaseTexture::LoadFromFileInMemory(unsigned char *buffer, size_t bufferSize, const std::string &mimeType, unsigned int idealWidth, unsigned int idealHeight)
+CBaseTexture *CBaseTexture::LoadFromFileInMemory(unsigned char *buffer, size_t bufferSize, const std::string &mimeType, unsigned int idealWidth, unsigned int idealHeight,
+                                                 LimitSizeFunc limitSize)
 {
   CTexture *texture = new CTexture();
-  if (texture->LoadFromFileInMem(buffer, bufferSize, mimeType, idealWidth, idealHeight))
+  if (texture->LoadFromFileInMem(buffer, bufferSize, mimeType, idealWidth, idealHeight, limitSize))
     return texture;
   delete texture;
   return NULL;
 }
 
-bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned int maxWidth, unsigned int maxHeight, bool requirePixels, const std::string& strMimeType)
+bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned int maxWidth, unsigned int maxHeight, bool requirePixels,
+                                        const std::string& strMimeType, LimitSizeFunc limitSize)
 {
   if (URIUtils::HasExtension(texturePath, ".dds"))
   { // special case for DDS images
@@ -265,7 +268,7 @@ bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned
   else
     pImage = ImageFactory::CreateLoaderFromMimeType(strMimeType);
 
-  if (!LoadIImage(pImage, (unsigned char *)buf.get(), buf.size(), width, height))
+  if (!LoadIImage(pImage, (unsigned char *)buf.get(), buf.size(), width, height, limitSize))
   {
     CLog::Log(LOGDEBUG, "%s - Load of %s failed.", __FUNCTION__, CURL::GetRedacted(texturePath).c_str());
     delete pImage;
@@ -276,7 +279,8 @@ bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned
   return true;
 }
 
-bool CBaseTexture::LoadFromFileInMem(unsigned char* buffer, size_t size, const std::string& mimeType, unsigned int maxWidth, unsigned int maxHeight)
+bool CBaseTexture::LoadFromFileInMem(unsigned char* buffer, size_t size, const std::string& mimeType, unsigned int maxWidth, unsigned int maxHeight,
+                                     LimitSizeFunc limitSize)
 {
   if (!buffer || !size)
     return false;
@@ -285,7 +289,7 @@ bool CBaseTexture::LoadFromFileInMem(unsigned char* buffer, size_t size, const s
   unsigned int height = maxHeight ? std::min(maxHeight, g_Windowing.GetMaxTextureSize()) : g_Windowing.GetMaxTextureSize();
 
   IImage* pImage = ImageFactory::CreateLoaderFromMimeType(mimeType);
-  if(!LoadIImage(pImage, buffer, size, width, height))
+  if(!LoadIImage(pImage, buffer, size, width, height, limitSize))
   {
     delete pImage;
     return false;
@@ -294,22 +298,34 @@ bool CBaseTexture::LoadFromFileInMem(unsigned char* buffer, size_t size, const s
   return true;
 }
 
-bool CBaseTexture::LoadIImage(IImage *pImage, unsigned char* buffer, unsigned int bufSize, unsigned int width, unsigned int height)
+bool CBaseTexture::LoadIImage(IImage *pImage, unsigned char* buffer, unsigned int bufSize, unsigned int width, unsigned int height,
+                              LimitSizeFunc limitSize)
 {
   if(pImage != NULL && pImage->LoadImageFromMemory(buffer, bufSize, width, height))
   {
-    if (pImage->Width() > 0 && pImage->Height() > 0)
+    unsigned int imageWidth = pImage->Width();
+    unsigned int imageHeight = pImage->Height();
+    // a decoder that scaled the image down scales it straight to the limited size,
+    // others are left at the size they load the image at
+    if (limitSize && (imageWidth < pImage->originalWidth() || imageHeight < pImage->originalHeight()))
     {
-      Allocate(pImage->Width(), pImage->Height(), XB_FMT_A8R8G8B8);
-      if (pImage->Decode(m_pixels, GetTextureWidth(), GetRows(), GetPitch(), XB_FMT_A8R8G8B8))
+      unsigned int maxWidth = imageWidth;
+      unsigned int maxHeight = imageHeight;
+      limitSize(pImage->originalWidth(), pImage->originalHeight(), maxWidth, maxHeight);
+      IImage::FitSize(pImage->Width(), pImage->Height(), maxWidth, maxHeight, imageWidth, imageHeight);
+    }
+    if (imageWidth > 0 && imageHeight > 0)
+    {
+      Allocate(imageWidth, imageHeight, XB_FMT_A8R8G8B8);
+      if (pImage->Decode(m_pixels, imageWidth, GetRows(imageHeight), GetPitch(), XB_FMT_A8R8G8B8))
       {
         if (pImage->Orientation())
           m_orientation = pImage->Orientation() - 1;
         m_hasAlpha = pImage->hasAlpha();
         m_originalWidth = pImage->originalWidth();
         m_originalHeight = pImage->originalHeight();
-        m_imageWidth = pImage->Width();
-        m_imageHeight = pImage->Height();
+        m_imageWidth = imageWidth;
+        m_imageHeight = imageHeight;
         ClampToEdge();
         return true;
       }
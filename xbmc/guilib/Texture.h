@@ -45,6 +45,14 @@ public:
 
   virtual ~CBaseTexture();
 
+  /*! \brief Function limiting the size an image is loaded at once its original size is known
+   \param originalWidth width of the original image
+   \param originalHeight height of the original image
+   \param maxWidth [in/out] maximum width to load the image at
+   \param maxHeight [in/out] maximum height to load the image at
+   */
+  typedef void (*LimitSizeFunc)(unsigned int originalWidth, unsigned int originalHeight, unsigned int &maxWidth, unsigned int &maxHeight);
+
   /*! \brief Load a texture from a file
    Loads a texture from a file, restricting in size if needed based on maxHeight and maxWidth.
    Note that these are the ideal size to load at - the returned texture may be smaller or larger than these.
@@ -52,10 +60,11 @@ public:
    \param idealWidth the ideal width of the texture (defaults to 0, no ideal width).
    \param idealHeight the ideal height of the texture (defaults to 0, no ideal height).
    \param strMimeType mimetype of the given texture if available (defaults to empty)
+   \param limitSize further limits the size from the original size of the image, for decoders that scale it anyway (defaults to NULL)
    \return a CBaseTexture pointer to the created texture - NULL if the texture failed to load.
    */
   static CBaseTexture *LoadFromFile(const std::string& texturePath, unsigned int idealWidth = 0, unsigned int idealHeight = 0,
-                                    bool requirePixels = false, const std::string& strMimeType = "");
+                                    bool requirePixels = false, const std::string& strMimeType = "", LimitSizeFunc limitSize = NULL);
 
   /*! \brief Load a texture from a file in memory
    Loads a texture from a file in memory, restricting in size if needed based on maxHeight and maxWidth.
@@ -65,10 +74,11 @@ public:
    \param mimeType the mime type of the file in buffer.
    \param idealWidth the ideal width of the texture (defaults to 0, no ideal width).
    \param idealHeight the ideal height of the texture (defaults to 0, no ideal height).
+   \param limitSize further limits the size from the original size of the image, for decoders that scale it anyway (defaults to NULL)
    \return a CBaseTexture pointer to the created texture - NULL if the texture failed to load.
    */
   static CBaseTexture *LoadFromFileInMemory(unsigned char* buffer, size_t bufferSize, const std::string& mimeType,
-                                            unsigned int idealWidth = 0, unsigned int idealHeight = 0);
+                                            unsigned int idealWidth = 0, unsigned int idealHeight = 0, LimitSizeFunc limitSize = NULL);
 
   bool LoadFromMemory(unsigned int width, unsigned int height, unsigned int pitch, unsigned int format, bool hasAlpha, unsigned char* pixels);
   bool LoadPaletted(unsigned int width, unsigned int height, unsigned int pitch, unsigned int format, const unsigned char *pixels, const COLOR *palette);
@@ -108,9 +118,11 @@ private:
 
 protected:
   bool LoadFromFileInMem(unsigned char* buffer, size_t size, const std::string& mimeType,
-                         unsigned int maxWidth, unsigned int maxHeight);
-  bool LoadFromFileInternal(const std::string& texturePath, unsigned int maxWidth, unsigned int maxHeight, bool requirePixels, const std::string& strMimeType = "");
-  bool LoadIImage(IImage* pImage, unsigned char* buffer, unsigned int bufSize, unsigned int width, unsigned int height);
+                         unsigned int maxWidth, unsigned int maxHeight, LimitSizeFunc limitSize = NULL);
+  bool LoadFromFileInternal(const std::string& texturePath, unsigned int maxWidth, unsigned int maxHeight, bool requirePixels,
+                            const std::string& strMimeType = "", LimitSizeFunc limitSize = NULL);
+  bool LoadIImage(IImage* pImage, unsigned char* buffer, unsigned int bufSize, unsigned int width, unsigned int height,
+                  LimitSizeFunc limitSize = NULL);
   // helpers for computation of texture parameters for compressed textures
   unsigned int GetPitch(unsigned int width) const;
   unsigned int GetRows(unsigned int height) const;
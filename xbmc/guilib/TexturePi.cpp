@@ -110,7 +110,8 @@ void CPiTexture::Update(unsigned int width, unsigned int height, unsigned int pi
   CGLTexture::Update(width, height, pitch, format, pixels, loadToGPU);
 }
 
-bool CPiTexture::LoadFromFileInternal(const std::string& texturePath, unsigned int maxWidth, unsigned int maxHeight, bool requirePixels, const std::string& strMimeType)
+bool CPiTexture::LoadFromFileInternal(const std::string& texturePath, unsigned int maxWidth, unsigned int maxHeight, bool requirePixels,
+                                      const std::string& strMimeType, LimitSizeFunc limitSize)
 {
   if (URIUtils::HasExtension(texturePath, ".jpg|.tbn"))
   {
@@ -145,7 +146,7 @@ bool CPiTexture::LoadFromFileInternal(const std::string& texturePath, unsigned i
       }
     }
   }
-  return CGLTexture::LoadFromFileInternal(texturePath, maxWidth, maxHeight, requirePixels);
+  return CGLTexture::LoadFromFileInternal(texturePath, maxWidth, maxHeight, requirePixels, strMimeType, limitSize);
 }
 
 #endif
@@ -34,6 +34,8 @@ public:
    \param width The ideal width of the texture
    \param height The ideal height of the texture
    \return true if the image could be loaded
+   \remarks Width() and Height() may already be scaled down to fit the ideal size afterwards, in which
+   case Decode only needs a buffer of that size
    */
   virtual bool LoadImageFromMemory(unsigned char* buffer, unsigned int bufSize, unsigned int width, unsigned int height)=0;
   /*!
@@ -73,6 +75,33 @@ public:
   unsigned int Orientation() const        { return m_orientation; }
   bool hasAlpha() const                   { return m_hasAlpha; }
 
+  /*!
+   \brief Fit an image into the given maximum size keeping its aspect ratio
+   \param maxWidth maximum width, 0 if not limited
+   \param maxHeight maximum height, 0 if not limited
+   */
+  static void FitSize(unsigned int width, unsigned int height, unsigned int maxWidth, unsigned int maxHeight,
+                      unsigned int &outWidth, unsigned int &outHeight)
+  {
+    outWidth = width;
+    outHeight = height;
+    if (width == 0 || height == 0)
+      return;
+
+    // assumption quadratic maximums e.g. 2048x2048
+    float ratio = width / (float) height;
+    if (maxHeight > 0 && outHeight > maxHeight)
+    {
+      outHeight = maxHeight;
+      outWidth = (unsigned int) (outHeight * ratio + 0.5f);
+    }
+    if (maxWidth > 0 && outWidth > maxWidth)
+    {
+      outWidth = maxWidth;
+      outHeight = (unsigned int) (outWidth / ratio + 0.5f);
+    }
+  }
+
 protected:
 
   unsigned int m_width;
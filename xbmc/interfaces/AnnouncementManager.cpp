@@ -20,7 +20,9 @@
 
 #include "AnnouncementManager.h"
 #include "threads/SingleLock.h"
+#include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 #include "utils/log.h"
 #include "utils/Variant.h"
 #include "utils/StringUtils.h"
@@ -35,7 +37,80 @@
 
 using namespace ANNOUNCEMENT;
 
+const unsigned int CAnnouncementManager::MaxQueuedAnnouncements;
+
+/*!
+ \brief Key identifying announcements of which only the latest one matters.
+ \return the key or an empty string if the announcement must not be coalesced
+ */
+static std::string GetCoalescingKey(AnnouncementFlag flag, const char *message, const CVariant &data)
+{
+  if (flag == Player && strcmp(message, "OnSeek") == 0)
+    return StringUtils::Format("Player.OnSeek.%" PRId64, data["player"]["playerid"].asInteger(-1));
+
+  if (flag == Application && strcmp(message, "OnVolumeChanged") == 0)
+    return "Application.OnVolumeChanged";
+
+  // library updates can only be coalesced for the same item
+  if ((flag == VideoLibrary || flag == AudioLibrary) && strcmp(message, "OnUpdate") == 0 &&
+      data["item"].isMember("id") && data["item"].isMember("type"))
+    return StringUtils::Format("%s.OnUpdate.%s.%" PRId64 "%s%s", AnnouncementFlagToString(flag),
+                               data["item"]["type"].asString().c_str(), data["item"]["id"].asInteger(),
+                               data["added"].asBoolean() ? ".added" : "",
+                               data["transaction"].asBoolean() ? ".transaction" : "");
+
+  return "";
+}
+
+/*!
+ \brief Announcements the announcers must have handled before the sender continues.
+ */
+static bool IsUrgent(AnnouncementFlag flag, const char *message)
+{
+  return flag == System && (strcmp(message, "OnQuit") == 0 || strcmp(message, "OnSleep") == 0);
+}
+
+/*!
+ \brief Keep what only a replaced announcement reported, e.g. the playcount of a library update.
+ */
+static std::shared_ptr<const CVariant> MergeData(const CVariant &replaced, const std::shared_ptr<const CVariant> &data)
+{
+  if (!replaced.isObject() || !data->isObject())
+    return data;
+
+  std::shared_ptr<CVariant> merged;
+  for (CVariant::const_iterator_map it = replaced.begin_map(); it != replaced.end_map(); ++it)
+  {
+    if (data->isMember(it->first))
+      continue;
+
+    if (!merged)
+      merged.reset(new CVariant(*data));
+    (*merged)[it->first] = it->second;
+  }
+
+  if (!merged)
+    return data;
+  return merged;
+}
+
+CAnnouncementManager::AnnouncerQueue::AnnouncerQueue(IAnnouncer *listener, bool sync)
+  : announcer(listener),
+    synchronous(sync),
+    removed(false)
+{
+  statistics.announcer = listener;
+  statistics.synchronous = sync;
+  statistics.queued = 0;
+  statistics.peakQueued = 0;
+  statistics.dispatched = 0;
+  statistics.coalesced = 0;
+  statistics.dropped = 0;
+}
+
 CAnnouncementManager::CAnnouncementManager()
+  : CThread("Announcement"),
+    m_nextQueue(0)
 { }
 
 CAnnouncementManager::~CAnnouncementManager()
@@ -51,17 +126,35 @@ CAnnouncementManager& CAnnouncementManager::GetInstance()
 
 void CAnnouncementManager::Deinitialize()
 {
+  // m_bStop is checked with m_critSection held so setting it before
+  // notifying the dispatcher can't get lost, the dispatcher delivers
+  // everything still pending before it exits
+  StopThread(false);
+  {
+    CSingleLock lock (m_critSection);
+    m_announcementAvailable.notifyAll();
+  }
+  StopThread(true);
+
+  // in case the dispatcher wasn't running
+  DispatchPending();
+
   CSingleLock lock (m_critSection);
+  for (std::vector<AnnouncerQueuePtr>::iterator it = m_announcers.begin(); it != m_announcers.end(); ++it)
+    (*it)->removed = true;
   m_announcers.clear();
 }
 
-void CAnnouncementManager::AddAnnouncer(IAnnouncer *listener)
+void CAnnouncementManager::AddAnnouncer(IAnnouncer *listener, bool synchronous /* = false */)
 {
   if (!listener)
     return;
 
   CSingleLock lock (m_critSection);
-  m_announcers.push_back(listener);
+  m_announcers.push_back(AnnouncerQueuePtr(new AnnouncerQueue(listener, synchronous)));
+
+  if (!synchronous && !IsRunning())
+    Create();
 }
 
 void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
@@ -69,15 +162,34 @@ void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
   if (!listener)
     return;
 
-  CSingleLock lock (m_critSection);
-  for (unsigned int i = 0; i < m_announcers.size(); i++)
+  AnnouncerQueuePtr queue;
   {
-    if (m_announcers[i] == listener)
+    CSingleLock lock (m_critSection);
+    for (std::vector<AnnouncerQueuePtr>::iterator it = m_announcers.begin(); it != m_announcers.end(); ++it)
     {
-      m_announcers.erase(m_announcers.begin() + i);
-      return;
+      if ((*it)->announcer == listener)
+      {
+        queue = *it;
+        queue->removed = true;
+        queue->statistics.dropped += queue->pending.size();
+        queue->statistics.queued = 0;
+        queue->pending.clear();
+        m_announcers.erase(it);
+        break;
+      }
     }
   }
+
+  if (!queue)
+    return;
+
+  const AnnouncerStatistics &stats = queue->statistics;
+  CLog::Log(LOGDEBUG, "CAnnouncementManager - removed announcer %p: %u dispatched, %u coalesced, %u dropped, at most %u queued",
+            static_cast<const void*>(listener), stats.dispatched, stats.coalesced, stats.dropped, stats.peakQueued);
+
+  // wait for an announcement which is currently being handled by the announcer
+  // (unless this is called by the announcer itself which holds the lock already)
+  CSingleLock lock(queue->synchronous ? m_syncSection : queue->dispatchSection);
 }
 
 void CAnnouncementManager::Announce(AnnouncementFlag flag, const char *sender, const char *message)
@@ -90,12 +202,219 @@ void CAnnouncementManager::Announce(AnnouncementFlag flag, const char *sender, c
 {
   CLog::Log(LOGDEBUG, "CAnnouncementManager - Announcement: %s from %s", message, sender);
 
+  bool urgent = IsUrgent(flag, message);
+  std::vector<IAnnouncer *> synchronousAnnouncers;
+  std::vector<AnnouncerQueuePtr> urgentQueues;
+  {
+    CSingleLock lock (m_critSection);
+
+    Announcement announcement;
+    for (std::vector<AnnouncerQueuePtr>::iterator it = m_announcers.begin(); it != m_announcers.end(); ++it)
+    {
+      if ((*it)->synchronous)
+      {
+        synchronousAnnouncers.push_back((*it)->announcer);
+        continue;
+      }
+
+      if (urgent)
+      {
+        urgentQueues.push_back(*it);
+        continue;
+      }
+
+      // all queues share the same copy of the data
+      if (!announcement.data)
+      {
+        announcement.flag = flag;
+        announcement.sender = sender;
+        announcement.message = message;
+        announcement.data.reset(new CVariant(data));
+        announcement.coalescingKey = GetCoalescingKey(flag, message, data);
+      }
+
+      Enqueue(**it, announcement);
+    }
+
+    if (announcement.data)
+      m_announcementAvailable.notify();
+  }
+
+  // queued announcers get what is still pending for them first
+  for (std::vector<AnnouncerQueuePtr>::const_iterator it = urgentQueues.begin(); it != urgentQueues.end(); ++it)
+  {
+    AnnouncerQueue &queue = **it;
+    CSingleLock dispatchLock (queue.dispatchSection);
+    while (DispatchNext(queue))
+      ;
+
+    {
+      CSingleLock lock (m_critSection);
+      if (queue.removed)
+        continue;
+      queue.statistics.dispatched++;
+    }
+
+    queue.announcer->Announce(flag, sender, message, data);
+  }
+
+  if (synchronousAnnouncers.empty())
+    return;
+
+  // Announcers may be removed or even remove themselves during execution of IAnnouncer::Announce()!
+  CSingleLock lock (m_syncSection);
+  for (std::vector<IAnnouncer *>::const_iterator it = synchronousAnnouncers.begin(); it != synchronousAnnouncers.end(); ++it)
+  {
+    {
+      // skip announcers which have been removed by one of the previous ones
+      CSingleLock announcersLock (m_critSection);
+      bool registered = false;
+      for (std::vector<AnnouncerQueuePtr>::iterator queue = m_announcers.begin(); queue != m_announcers.end() && !registered; ++queue)
+      {
+        if ((*queue)->announcer == *it)
+        {
+          (*queue)->statistics.dispatched++;
+          registered = true;
+        }
+      }
+      if (!registered)
+        continue;
+    }
+
+    (*it)->Announce(flag, sender, message, data);
+  }
+}
+
+void CAnnouncementManager::Enqueue(AnnouncerQueue &queue, const Announcement &announcement)
+{
+  AnnouncerStatistics &stats = queue.statistics;
+
+  // replace a pending announcement of the same kind, the new one is moved to
+  // the end so the announcer still sees the latest state last
+  if (!announcement.coalescingKey.empty())
+  {
+    for (std::deque<Announcement>::iterator it = queue.pending.begin(); it != queue.pending.end(); ++it)
+    {
+      if (it->coalescingKey == announcement.coalescingKey)
+      {
+        Announcement merged = announcement;
+        merged.data = MergeData(*it->data, announcement.data);
+        queue.pending.erase(it);
+        stats.coalesced++;
+        Push(queue, merged);
+        return;
+      }
+    }
+  }
+
+  Push(queue, announcement);
+}
+
+void CAnnouncementManager::Push(AnnouncerQueue &queue, const Announcement &announcement)
+{
+  AnnouncerStatistics &stats = queue.statistics;
+
+  if (queue.pending.size() >= MaxQueuedAnnouncements)
+  {
+    if (stats.dropped == 0)
+      CLog::Log(LOGWARNING, "CAnnouncementManager - announcer %p can't keep up, dropping announcements",
+                static_cast<const void*>(queue.announcer));
+
+    queue.pending.pop_front();
+    stats.dropped++;
+  }
+
+  queue.pending.push_back(announcement);
+  stats.queued = queue.pending.size();
+  if (stats.queued > stats.peakQueued)
+    stats.peakQueued = stats.queued;
+}
+
+CAnnouncementManager::AnnouncerQueuePtr CAnnouncementManager::GetNextQueue()
+{
+  // take turns between the announcers so a busy one doesn't starve the others
+  for (size_t i = 0; i < m_announcers.size(); i++)
+  {
+    size_t index = (m_nextQueue + i) % m_announcers.size();
+    if (!m_announcers[index]->pending.empty())
+    {
+      m_nextQueue = index + 1;
+      return m_announcers[index];
+    }
+  }
+
+  return AnnouncerQueuePtr();
+}
+
+bool CAnnouncementManager::DispatchNext(AnnouncerQueue &queue)
+{
+  Announcement announcement;
+  {
+    CSingleLock lock (m_critSection);
+    if (queue.removed || queue.pending.empty())
+      return false;
+
+    announcement = queue.pending.front();
+    queue.pending.pop_front();
+    queue.statistics.queued = queue.pending.size();
+    queue.statistics.dispatched++;
+  }
+
+  queue.announcer->Announce(announcement.flag, announcement.sender.c_str(), announcement.message.c_str(), *announcement.data);
+  return true;
+}
+
+void CAnnouncementManager::DispatchPending()
+{
+  CSingleLock lock (m_critSection);
+  AnnouncerQueuePtr queue;
+  while ((queue = GetNextQueue()))
+  {
+    lock.Leave();
+    {
+      CSingleLock dispatchLock (queue->dispatchSection);
+      DispatchNext(*queue);
+    }
+    lock.Enter();
+  }
+}
+
+void CAnnouncementManager::Process()
+{
+  CSingleLock lock (m_critSection);
+  while (true)
+  {
+    AnnouncerQueuePtr queue = GetNextQueue();
+    if (!queue)
+    {
+      // everything pending has been delivered
+      if (m_bStop)
+        break;
+
+      m_announcementAvailable.wait(lock);
+      continue;
+    }
+
+    // the queue's own lock keeps its announcements in order and only makes
+    // RemoveAnnouncer() of that announcer wait while it is being called
+    lock.Leave();
+    {
+      CSingleLock dispatchLock (queue->dispatchSection);
+      DispatchNext(*queue);
+    }
+    lock.Enter();
+  }
+}
+
+std::vector<AnnouncerStatistics> CAnnouncementManager::GetStatistics() const
+{
   CSingleLock lock (m_critSection);
 
-  // Make a copy of announers. They may be removed or even remove themselves during execution of IAnnouncer::Announce()!
-  std::vector<IAnnouncer *> announcers(m_announcers); 
-  for (unsigned int i = 0; i < announcers.size(); i++)
-    announcers[i]->Announce(flag, sender, message, data);
+  std::vector<AnnouncerStatistics> statistics;
+  for (std::vector<AnnouncerQueuePtr>::const_iterator it = m_announcers.begin(); it != m_announcers.end(); ++it)
+    statistics.push_back((*it)->statistics);
+
+  return statistics;
 }
 
 void CAnnouncementManager::Announce(AnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item)
@@ -18,39 +18,136 @@
  *  <http://www.gnu.org/licenses/>.
  *
  */
+#include <deque>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "IAnnouncer.h"
 #include "FileItem.h"
+#include "threads/Condition.h"
 #include "threads/CriticalSection.h"
+#include "threads/Thread.h"
 #include "utils/GlobalsHandling.h"
 
 class CVariant;
 
 namespace ANNOUNCEMENT
 {
-  class CAnnouncementManager
+  /*!
+   \brief Counters of the announcements handed to a single announcer.
+   */
+  struct AnnouncerStatistics
+  {
+    const IAnnouncer *announcer;
+    bool synchronous;
+    unsigned int queued;      ///< announcements waiting to be dispatched
+    unsigned int peakQueued;  ///< maximum number of announcements waiting at once
+    unsigned int dispatched;  ///< announcements passed to the announcer
+    unsigned int coalesced;   ///< announcements replaced by a newer one of the same kind
+    unsigned int dropped;     ///< announcements discarded because the queue was full
+  };
+
+  /*!
+   \brief Distributes announcements to the registered announcers.
+
+   Announcements are queued per announcer and dispatched on a dedicated
+   thread so the sender never waits for an announcer serializing JSON or
+   writing to sockets. Frequent announcements which only report the latest
+   state (seeking, volume changes, library updates of the same item) replace
+   a still pending one of the same kind. If an announcer can't keep up its
+   oldest pending announcements are dropped once the queue is full.
+
+   Announcers which have to act before the sender continues can still be
+   registered as synchronous. System.OnQuit and System.OnSleep are passed to
+   all announcers before Announce() returns, after everything still pending
+   for them.
+   */
+  class CAnnouncementManager : private CThread
   {
   public:
     virtual ~CAnnouncementManager();
 
     static CAnnouncementManager& GetInstance();
 
+    /*!
+     \brief Deliver the pending announcements and unregister all announcers.
+     */
     void Deinitialize();
 
-    void AddAnnouncer(IAnnouncer *listener);
+    /*!
+     \brief Register an announcer.
+     \param listener the announcer to add
+     \param synchronous whether announcements are passed to the announcer on
+     the thread sending them instead of being queued
+     */
+    void AddAnnouncer(IAnnouncer *listener, bool synchronous = false);
+
+    /*!
+     \brief Unregister an announcer, pending announcements are discarded.
+
+     If the announcer is handling an announcement on another thread this
+     waits for it to finish.
+     */
     void RemoveAnnouncer(IAnnouncer *listener);
 
     void Announce(AnnouncementFlag flag, const char *sender, const char *message);
     void Announce(AnnouncementFlag flag, const char *sender, const char *message, CVariant &data);
     void Announce(AnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item);
     void Announce(AnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item, CVariant &data);
+
+    std::vector<AnnouncerStatistics> GetStatistics() const;
+
+    //! maximum number of announcements waiting for a single announcer
+    static const unsigned int MaxQueuedAnnouncements = 1024;
+
+  protected:
+    virtual void Process();
+
   private:
     CAnnouncementManager();
     CAnnouncementManager(const CAnnouncementManager&);
     CAnnouncementManager const& operator=(CAnnouncementManager const&);
 
-    CCriticalSection m_critSection;
-    std::vector<IAnnouncer *> m_announcers;
+    struct Announcement
+    {
+      AnnouncementFlag flag;
+      std::string sender;
+      std::string message;
+      std::shared_ptr<const CVariant> data;
+      std::string coalescingKey;
+    };
+
+    struct AnnouncerQueue
+    {
+      explicit AnnouncerQueue(IAnnouncer *listener, bool sync);
+
+      IAnnouncer *announcer;
+      bool synchronous;
+      bool removed;
+      std::deque<Announcement> pending;
+      AnnouncerStatistics statistics;
+      CCriticalSection dispatchSection; ///< held while an announcement is passed to the announcer
+    };
+    typedef std::shared_ptr<AnnouncerQueue> AnnouncerQueuePtr;
+
+    void Enqueue(AnnouncerQueue &queue, const Announcement &announcement);
+    void Push(AnnouncerQueue &queue, const Announcement &announcement);
+    AnnouncerQueuePtr GetNextQueue();
+
+    /*!
+     \brief Pass the oldest pending announcement to the announcer.
+     The caller must hold the dispatchSection of the queue.
+     \return false if nothing was pending or the announcer has been removed.
+     */
+    bool DispatchNext(AnnouncerQueue &queue);
+    void DispatchPending();
+
+    mutable CCriticalSection m_critSection;
+    XbmcThreads::ConditionVariable m_announcementAvailable;
+    std::vector<AnnouncerQueuePtr> m_announcers;
+    size_t m_nextQueue;
+
+    CCriticalSection m_syncSection;     ///< held while synchronous announcers are called
   };
 }
@@ -137,6 +137,9 @@ JSONRPC_STATUS CAudioLibrary::GetAlbums(const std::string &method, ITransportLay
   if (!musicdatabase.Open())
     return InternalError;
 
+  if (HandleLibraryRevision(musicdatabase, MediaTypeAlbum, parameterObject, result))
+    return OK;
+
   CMusicDbUrl musicUrl;
   if (!musicUrl.FromString("musicdb://albums/"))
     return InternalError;
@@ -387,6 +387,43 @@ void CFileItemHandler::HandleFileItem(const char *ID, bool allowFile, const char
   }
 }
 
+bool CFileItemHandler::HandleLibraryRevision(CDatabase &database, const std::string &mediaType, const CVariant &parameterObject, CVariant &result)
+{
+  int revision = database.GetLibraryRevision();
+  if (revision < 0)
+    return false;
+
+  result["revision"] = revision;
+
+  const CVariant &ifNoneMatch = parameterObject["ifnonematch"];
+  if (ifNoneMatch.isInteger() && ifNoneMatch.asInteger() == revision)
+  {
+    result["unchanged"] = true;
+    return true;
+  }
+
+  const CVariant &since = parameterObject["since"];
+  if (!since.isInteger() || since.asInteger() > revision)
+    return false;
+
+  std::vector<int> added, changed, removed;
+  if (!database.GetLibraryChanges((int)since.asInteger(), mediaType, added, changed, removed))
+    return false;
+
+  CVariant &changes = result["changes"];
+  changes["added"] = CVariant(CVariant::VariantTypeArray);
+  for (std::vector<int>::const_iterator it = added.begin(); it != added.end(); ++it)
+    changes["added"].push_back(*it);
+  changes["changed"] = CVariant(CVariant::VariantTypeArray);
+  for (std::vector<int>::const_iterator it = changed.begin(); it != changed.end(); ++it)
+    changes["changed"].push_back(*it);
+  changes["removed"] = CVariant(CVariant::VariantTypeArray);
+  for (std::vector<int>::const_iterator it = removed.begin(); it != removed.end(); ++it)
+    changes["removed"].push_back(*it);
+
+  return true;
+}
+
 bool CFileItemHandler::FillFileItemList(const CVariant &parameterObject, CFileItemList &list)
 {
   CAudioLibrary::FillFileItemList(parameterObject, list);
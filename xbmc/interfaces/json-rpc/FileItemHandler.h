@@ -25,6 +25,7 @@
 #include "JSONUtils.h"
 #include "FileItem.h"
 
+class CDatabase;
 class CThumbLoader;
 class CVariant;
 
@@ -40,6 +41,21 @@ namespace JSONRPC
     static void HandleFileItem(const char *ID, bool allowFile, const char *resultname, CFileItemPtr item, const CVariant &parameterObject, const std::set<std::string> &validFields, CVariant &result, bool append = true, CThumbLoader *thumbLoader = NULL);
 
     static bool FillFileItemList(const CVariant &parameterObject, CFileItemList &list);
+
+    /*!
+     \brief Handles the "ifnonematch" and "since" parameters of a library listing
+     \param database Opened database of the library
+     \param mediaType Media type of the listed items
+     \param parameterObject Parameters of the request
+     \param result Result receiving the current revision of the library
+     \return True if the result is complete and the items don't have to be listed
+
+     The result is complete if the revision passed as "ifnonematch" is still the
+     current one or if the items changed since the revision passed as "since"
+     are available. Must be called before listing the items so a change made
+     while listing them is never missed by a client.
+     */
+    static bool HandleLibraryRevision(CDatabase &database, const std::string &mediaType, const CVariant &parameterObject, CVariant &result);
   private:
     static void Sort(CFileItemList &items, const CVariant& parameterObject);
     static bool GetField(const std::string &field, const CVariant &info, const CFileItemPtr &item, CVariant &result, bool &fetchedArt, CThumbLoader *thumbLoader = NULL);
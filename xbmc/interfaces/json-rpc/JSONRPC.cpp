@@ -19,6 +19,9 @@
  */
 
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 
 #include "JSONRPC.h"
 #include "ServiceDescription.h"
@@ -27,18 +30,51 @@
 #include "dbwrappers/DatabaseQuery.h"
 #include "input/ButtonTranslator.h"
 #include "interfaces/AnnouncementManager.h"
+#include "network/RequestWorkerPool.h"
 #include "playlists/SmartPlayList.h"
 #include "settings/AdvancedSettings.h"
+#include "threads/Event.h"
+#include "utils/CPUInfo.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/Variant.h"
 #include "TextureDatabase.h"
 
 using namespace ANNOUNCEMENT;
 using namespace JSONRPC;
 
+#define BATCH_MAX_WORKERS 8
+#define BATCH_MAX_QUEUED  256
+
 bool CJSONRPC::m_initialized = false;
 
+// helps the calling threads with the read-only calls of batch requests
+static CRequestWorkerPool batchWorkers("JSONRPCBatch", BATCH_MAX_QUEUED);
+
+struct CJSONRPC::BatchExecution
+{
+  struct Call
+  {
+    explicit Call(const CVariant *request) : request(request), hasResponse(false) { }
+
+    const CVariant *request;
+    CVariant response;
+    bool hasResponse;
+  };
+
+  BatchExecution(ITransportLayer *transport, IClient *client)
+    : transport(transport), client(client), next(0), executed(0), finished(true)
+  { }
+
+  ITransportLayer *transport;
+  IClient *client;
+  std::vector<Call> calls;
+  std::atomic<unsigned int> next;
+  std::atomic<unsigned int> executed;
+  CEvent finished;
+};
+
 void CJSONRPC::Initialize()
 {
   if (m_initialized)
@@ -109,13 +145,16 @@ void CJSONRPC::Initialize()
 
   for (unsigned int index = 0; index < size; index++)
     CJSONServiceDescription::AddNotification(JSONRPC_SERVICE_NOTIFICATIONS[index]);
-  
+
+  batchWorkers.Start(std::max(2, std::min(g_cpuInfo.getCPUCount(), BATCH_MAX_WORKERS)));
+
   m_initialized = true;
   CLog::Log(LOGINFO, "JSONRPC v%s: Successfully initialized", CJSONServiceDescription::GetVersion());
 }
 
 void CJSONRPC::Cleanup()
 {
+  batchWorkers.Stop();
   CJSONServiceDescription::Cleanup();
   m_initialized = false;
 }
@@ -253,17 +292,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
         hasResponse = true;
       }
       else
-      {
-        for (CVariant::const_iterator_array itr = inputroot.begin_array(); itr != inputroot.end_array(); itr++)
-        {
-          CVariant response;
-          if (HandleMethodCall(*itr, response, transport, client))
-          {
-            outputroot.append(response);
-            hasResponse = true;
-          }
-        }
-      }
+        hasResponse = HandleBatchCall(inputroot, outputroot, transport, client);
     }
     else
       hasResponse = HandleMethodCall(inputroot, outputroot, transport, client);
@@ -311,6 +340,89 @@ bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITr
   return !isNotification;
 }
 
+bool CJSONRPC::HandleBatchCall(const CVariant& batch, CVariant& responses, ITransportLayer *transport, IClient *client)
+{
+  bool hasResponse = false;
+  unsigned int concurrent = 0;
+  int64_t start = CurrentHostCounter();
+
+  CVariant::const_iterator_array itr = batch.begin_array();
+  while (itr != batch.end_array())
+  {
+    // read-only calls don't depend on each other so they can be executed in any order
+    std::shared_ptr<BatchExecution> execution(new BatchExecution(transport, client));
+    for (; itr != batch.end_array() && IsReadOnlyCall(*itr); ++itr)
+      execution->calls.push_back(BatchExecution::Call(&*itr));
+
+    if (!execution->calls.empty())
+    {
+      // the calling thread takes part as well so the batch doesn't stall if
+      // the workers are busy with other requests
+      unsigned int helpers = std::min(static_cast<unsigned int>(execution->calls.size()) - 1, batchWorkers.GetWorkerCount());
+      for (unsigned int i = 0; i < helpers; i++)
+      {
+        if (!batchWorkers.Submit(std::bind(&CJSONRPC::ExecuteBatch, execution)))
+          break;
+      }
+      ExecuteBatch(execution);
+      execution->finished.Wait();
+
+      if (execution->calls.size() > 1)
+        concurrent += execution->calls.size();
+
+      for (std::vector<BatchExecution::Call>::iterator call = execution->calls.begin(); call != execution->calls.end(); ++call)
+      {
+        if (call->hasResponse)
+        {
+          responses.append(call->response);
+          hasResponse = true;
+        }
+      }
+    }
+
+    // any other call may change data used by the following calls
+    if (itr != batch.end_array())
+    {
+      CVariant response;
+      if (HandleMethodCall(*itr, response, transport, client))
+      {
+        responses.append(response);
+        hasResponse = true;
+      }
+      ++itr;
+    }
+  }
+
+  if (g_advancedSettings.CanLogComponent(LOGJSONRPC))
+    CLog::Log(LOGDEBUG, "JSONRPC: Batch of %u calls (%u executed concurrently) took %.1f ms",
+              (unsigned int)batch.size(), concurrent, 1000.0 * (CurrentHostCounter() - start) / CurrentHostFrequency());
+
+  return hasResponse;
+}
+
+bool CJSONRPC::IsReadOnlyCall(const CVariant& request)
+{
+  if (!IsProperJSONRPC(request))
+    return false;
+
+  std::string methodName = request["method"].asString();
+  StringUtils::ToLower(methodName);
+  return CJSONServiceDescription::IsReadOnlyMethod(methodName);
+}
+
+void CJSONRPC::ExecuteBatch(std::shared_ptr<BatchExecution> execution)
+{
+  unsigned int index;
+  while ((index = execution->next++) < execution->calls.size())
+  {
+    BatchExecution::Call &call = execution->calls[index];
+    call.hasResponse = HandleMethodCall(*call.request, call.response, execution->transport, execution->client);
+
+    if (++execution->executed == execution->calls.size())
+      execution->finished.Set();
+  }
+}
+
 inline bool CJSONRPC::IsProperJSONRPC(const CVariant& inputroot)
 {
   return inputroot.isObject() && inputroot.isMember("jsonrpc") && inputroot["jsonrpc"].isString() && inputroot["jsonrpc"] == CVariant("2.0") && inputroot.isMember("method") && inputroot["method"].isString() && (!inputroot.isMember("params") || inputroot["params"].isArray() || inputroot["params"].isObject());
@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <stdio.h>
 #include <string>
 
@@ -75,6 +76,19 @@ namespace JSONRPC
   private:
     static void setup();
     static bool HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client);
+
+    /*!
+     \brief Handles the calls of a batch request
+
+     Consecutive calls of read-only methods are executed concurrently while
+     any other call is executed on its own once all preceding calls are done.
+     The responses are added in the order of the calls.
+     */
+    static bool HandleBatchCall(const CVariant& batch, CVariant& responses, ITransportLayer *transport, IClient *client);
+    static bool IsReadOnlyCall(const CVariant& request);
+
+    struct BatchExecution;
+    static void ExecuteBatch(std::shared_ptr<BatchExecution> execution);
     static inline bool IsProperJSONRPC(const CVariant& inputroot);
 
     inline static void BuildResponse(const CVariant& request, JSONRPC_STATUS code, const CVariant& result, CVariant& response);
@@ -0,0 +1,336 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+
+#include "JSONSchemaValidator.h"
+#include "JSONServiceDescription.h"
+
+using namespace JSONRPC;
+
+CJSONSchemaValidator::Node::Node()
+  : type(AnyValue),
+    optional(false),
+    minItems(0),
+    maxItems(0),
+    uniqueItems(false),
+    hasAdditionalProperties(false),
+    additionalProperties(-1),
+    minimum(0.0),
+    maximum(0.0),
+    exclusiveMinimum(false),
+    exclusiveMaximum(false),
+    divisibleBy(0),
+    minLength(0),
+    maxLength(-1)
+{ }
+
+CJSONSchemaValidator::CJSONSchemaValidator(const std::vector<JSONSchemaTypeDefinitionPtr> &parameters)
+{
+  CompiledNodes compiled;
+  compile(parameters, m_parameters, compiled);
+}
+
+bool CJSONSchemaValidator::Validate(const CVariant &requestParameters, CVariant &outputParameters) const
+{
+  unsigned int handled = 0;
+  for (unsigned int position = 0; position < m_parameters.size(); position++)
+  {
+    const Node &parameter = m_nodes[m_parameters[position]];
+
+    // same lookup as CJSONUtils::ParameterExists() and GetParameter()
+    // but without copying the value of the parameter
+    const CVariant *value = NULL;
+    if (requestParameters.isObject() && requestParameters.isMember(parameter.name))
+      value = &requestParameters[parameter.name];
+    else if (requestParameters.isArray() && requestParameters.size() > position)
+      value = &requestParameters[position];
+
+    if (value != NULL)
+    {
+      if (!validate(m_parameters[position], *value, outputParameters[parameter.name]))
+        return false;
+
+      handled++;
+    }
+    else if (parameter.optional)
+      outputParameters[parameter.name] = parameter.defaultValue;
+    else
+      return false;
+  }
+
+  return handled >= requestParameters.size();
+}
+
+void CJSONSchemaValidator::compile(const std::vector<JSONSchemaTypeDefinitionPtr> &definitions, std::vector<int> &nodes, CompiledNodes &compiled)
+{
+  nodes.reserve(definitions.size());
+  for (std::vector<JSONSchemaTypeDefinitionPtr>::const_iterator definition = definitions.begin(); definition != definitions.end(); ++definition)
+    nodes.push_back(compile(*definition, compiled));
+}
+
+int CJSONSchemaValidator::compile(const JSONSchemaTypeDefinitionPtr &definition, CompiledNodes &compiled)
+{
+  // type definitions may reference themselves (directly or indirectly)
+  CompiledNodes::const_iterator it = compiled.find(definition.get());
+  if (it != compiled.end())
+    return it->second;
+
+  // resolve the referenced type like JSONSchemaTypeDefinition::Check() would
+  if (definition->referencedType != NULL && !definition->referencedTypeSet)
+    definition->Set(definition->referencedType);
+
+  int index = m_nodes.size();
+  compiled.insert(std::make_pair(definition.get(), index));
+  m_nodes.push_back(Node());
+  m_nodes[index].name = definition->name;
+
+  // the nodes may be reallocated while compiling the
+  // referenced definitions so the new node is only
+  // filled in once all of them have been compiled
+  Node node;
+  node.name = definition->name;
+  node.type = definition->type;
+  node.optional = definition->optional;
+  node.defaultValue = definition->defaultValue;
+  node.minItems = definition->minItems;
+  node.maxItems = definition->maxItems;
+  node.uniqueItems = definition->uniqueItems;
+  node.hasAdditionalProperties = definition->hasAdditionalProperties;
+  node.enums = definition->enums;
+  node.minimum = definition->minimum;
+  node.maximum = definition->maximum;
+  node.exclusiveMinimum = definition->exclusiveMinimum;
+  node.exclusiveMaximum = definition->exclusiveMaximum;
+  node.divisibleBy = definition->divisibleBy;
+  node.minLength = definition->minLength;
+  node.maxLength = definition->maxLength;
+
+  compile(definition->unionTypes, node.unionTypes, compiled);
+  compile(definition->extends, node.extends, compiled);
+  compile(definition->items, node.items, compiled);
+  compile(definition->additionalItems, node.additionalItems, compiled);
+
+  for (JSONSchemaTypeDefinition::CJsonSchemaPropertiesMap::JSONSchemaPropertiesIterator property = definition->properties.begin();
+       property != definition->properties.end(); ++property)
+  {
+    node.properties.push_back(compile(property->second, compiled));
+    node.propertyKeys.push_back(property->first);
+  }
+
+  if (definition->additionalProperties != NULL)
+    node.additionalProperties = compile(definition->additionalProperties, compiled);
+
+  // the properties are stored by their lowercase name but looked
+  // up by their actual name so sort them the way CVariant sorts
+  // the members of an object to match them in a single pass
+  std::sort(node.properties.begin(), node.properties.end(),
+    [this](int lhs, int rhs) { return m_nodes[lhs].name < m_nodes[rhs].name; });
+
+  m_nodes[index] = node;
+  return index;
+}
+
+bool CJSONSchemaValidator::validate(int index, const CVariant &value, CVariant &outputValue) const
+{
+  const Node &node = m_nodes[index];
+
+  if (!IsType(value, node.type))
+    return false;
+  else if (value.isNull() && !HasType(node.type, NullValue))
+    return false;
+
+  if (!node.unionTypes.empty())
+  {
+    bool ok = false;
+    for (std::vector<int>::const_iterator unionType = node.unionTypes.begin(); unionType != node.unionTypes.end(); ++unionType)
+    {
+      CVariant testOutput = outputValue;
+      if (validate(*unionType, value, testOutput))
+      {
+        ok = true;
+        outputValue = testOutput;
+        break;
+      }
+    }
+
+    if (!ok)
+      return false;
+  }
+
+  for (std::vector<int>::const_iterator extends = node.extends.begin(); extends != node.extends.end(); ++extends)
+  {
+    if (!validate(*extends, value, outputValue))
+      return false;
+  }
+
+  if (HasType(node.type, ArrayValue) && value.isArray())
+    return validateArray(node, value, outputValue);
+
+  if (HasType(node.type, ObjectValue) && value.isObject())
+    return validateObject(node, value, outputValue);
+
+  if (!node.enums.empty() && std::find(node.enums.begin(), node.enums.end(), value) == node.enums.end())
+    return false;
+
+  if ((HasType(node.type, NumberValue) && value.isDouble()) || (HasType(node.type, IntegerValue) && value.isInteger()))
+  {
+    double numberValue;
+    if (value.isDouble())
+      numberValue = value.asDouble();
+    else
+      numberValue = (double)value.asInteger();
+
+    if ((node.exclusiveMinimum && numberValue <= node.minimum) || (!node.exclusiveMinimum && numberValue < node.minimum) ||
+        (node.exclusiveMaximum && numberValue >= node.maximum) || (!node.exclusiveMaximum && numberValue > node.maximum))
+      return false;
+
+    if (HasType(node.type, IntegerValue) && node.divisibleBy > 0 && ((int)numberValue % node.divisibleBy) != 0)
+      return false;
+  }
+
+  if (HasType(node.type, StringValue) && value.isString())
+  {
+    int size = value.size();
+    if (size < node.minLength || (node.maxLength >= 0 && size > node.maxLength))
+      return false;
+  }
+
+  outputValue = value;
+  return true;
+}
+
+bool CJSONSchemaValidator::validateArray(const Node &node, const CVariant &value, CVariant &outputValue) const
+{
+  outputValue = CVariant(CVariant::VariantTypeArray);
+  if ((node.minItems > 0 && value.size() < node.minItems) || (node.maxItems > 0 && value.size() > node.maxItems))
+    return false;
+
+  if (node.items.empty())
+    outputValue = value;
+  else if (node.items.size() == 1)
+  {
+    for (unsigned int arrayIndex = 0; arrayIndex < value.size(); arrayIndex++)
+    {
+      CVariant temp;
+      bool ok = validate(node.items.front(), value[arrayIndex], temp);
+      outputValue.push_back(temp);
+      if (!ok)
+        return false;
+    }
+  }
+  // tuple typing
+  else
+  {
+    if (value.size() < node.items.size() || (value.size() != node.items.size() && node.additionalItems.empty()))
+      return false;
+
+    unsigned int arrayIndex;
+    for (arrayIndex = 0; arrayIndex < std::min(node.items.size(), (size_t)value.size()); arrayIndex++)
+    {
+      if (!validate(node.items[arrayIndex], value[arrayIndex], outputValue[arrayIndex]))
+        return false;
+    }
+
+    if (!node.additionalItems.empty())
+    {
+      for (; arrayIndex < value.size(); arrayIndex++)
+      {
+        bool ok = false;
+        for (std::vector<int>::const_iterator additionalItem = node.additionalItems.begin(); additionalItem != node.additionalItems.end(); ++additionalItem)
+        {
+          if (validate(*additionalItem, value[arrayIndex], outputValue[arrayIndex]))
+          {
+            ok = true;
+            break;
+          }
+        }
+
+        if (!ok)
+          return false;
+      }
+    }
+  }
+
+  if (node.uniqueItems)
+  {
+    for (unsigned int checkingIndex = 0; checkingIndex < outputValue.size(); checkingIndex++)
+    {
+      for (unsigned int checkedIndex = checkingIndex + 1; checkedIndex < outputValue.size(); checkedIndex++)
+      {
+        if (outputValue[checkingIndex] == outputValue[checkedIndex])
+          return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool CJSONSchemaValidator::validateObject(const Node &node, const CVariant &value, CVariant &outputValue) const
+{
+  unsigned int handled = 0;
+  CVariant::const_iterator_map membersEnd = value.end_map();
+  CVariant::const_iterator_map member = value.begin_map();
+  for (std::vector<int>::const_iterator property = node.properties.begin(); property != node.properties.end(); ++property)
+  {
+    const Node &propertyNode = m_nodes[*property];
+
+    // both the properties and the members are sorted by their name
+    while (member != membersEnd && member->first < propertyNode.name)
+      ++member;
+
+    if (member != membersEnd && member->first == propertyNode.name)
+    {
+      if (!validate(*property, member->second, outputValue[propertyNode.name]))
+        return false;
+
+      handled++;
+    }
+    else if (propertyNode.optional)
+      outputValue[propertyNode.name] = propertyNode.defaultValue;
+    else
+      return false;
+  }
+
+  if (handled < value.size())
+  {
+    if (!node.hasAdditionalProperties || node.additionalProperties < 0)
+      return false;
+
+    const Node &additionalProperties = m_nodes[node.additionalProperties];
+    std::vector<std::string>::const_iterator propertyKey = node.propertyKeys.begin();
+    for (member = value.begin_map(); member != membersEnd; ++member)
+    {
+      // skip the members matching the key of a property
+      while (propertyKey != node.propertyKeys.end() && *propertyKey < member->first)
+        ++propertyKey;
+      if (propertyKey != node.propertyKeys.end() && *propertyKey == member->first)
+        continue;
+
+      if (additionalProperties.type == AnyValue)
+        outputValue[member->first] = member->second;
+      else if (!validate(node.additionalProperties, member->second, outputValue[member->first]))
+        return false;
+    }
+  }
+
+  return true;
+}
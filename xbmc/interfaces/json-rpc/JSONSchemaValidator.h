@@ -0,0 +1,120 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "JSONUtils.h"
+#include "utils/Variant.h"
+
+namespace JSONRPC
+{
+  class JSONSchemaTypeDefinition;
+  typedef std::shared_ptr<JSONSchemaTypeDefinition> JSONSchemaTypeDefinitionPtr;
+
+  /*!
+   \ingroup jsonrpc
+   \brief Validator for the parameters of a json rpc
+   method compiled from its json schema definitions.
+
+   The type definitions are flattened into a list of nodes
+   referencing each other by index with all references to
+   other types resolved. The properties of an object are
+   kept in the same order as the members of a CVariant so
+   they can be matched in a single pass.
+
+   Validating doesn't collect any details about invalid
+   values. If validation fails JSONSchemaTypeDefinition::Check()
+   has to be used to describe the error.
+   */
+  class CJSONSchemaValidator : protected CJSONUtils
+  {
+  public:
+    /*!
+     \brief Compiles the given parameter definitions of a method
+     */
+    explicit CJSONSchemaValidator(const std::vector<JSONSchemaTypeDefinitionPtr> &parameters);
+
+    /*!
+     \brief Checks the given parameters of a method call
+     \param requestParameters Parameters from the request
+     \param outputParameters Parameters completed with the default values of missing optional parameters and properties
+     \return True if the parameters are valid otherwise false
+
+     Behaves like checking every parameter with JSONSchemaTypeDefinition::Check().
+     */
+    bool Validate(const CVariant &requestParameters, CVariant &outputParameters) const;
+
+    /*!
+     \brief Number of compiled type definitions
+     */
+    size_t GetNodeCount() const { return m_nodes.size(); }
+
+  private:
+    struct Node
+    {
+      Node();
+
+      std::string name;
+      JSONSchemaType type;
+      bool optional;
+      CVariant defaultValue;
+
+      std::vector<int> unionTypes;
+      std::vector<int> extends;
+
+      std::vector<int> items;
+      std::vector<int> additionalItems;
+      unsigned int minItems;
+      unsigned int maxItems;
+      bool uniqueItems;
+
+      // sorted by name
+      std::vector<int> properties;
+      // keys of the properties in the type definition (sorted)
+      std::vector<std::string> propertyKeys;
+      bool hasAdditionalProperties;
+      int additionalProperties;
+
+      std::vector<CVariant> enums;
+      double minimum;
+      double maximum;
+      bool exclusiveMinimum;
+      bool exclusiveMaximum;
+      unsigned int divisibleBy;
+      int minLength;
+      int maxLength;
+    };
+
+    typedef std::map<const JSONSchemaTypeDefinition*, int> CompiledNodes;
+
+    int compile(const JSONSchemaTypeDefinitionPtr &definition, CompiledNodes &compiled);
+    void compile(const std::vector<JSONSchemaTypeDefinitionPtr> &definitions, std::vector<int> &nodes, CompiledNodes &compiled);
+    bool validate(int node, const CVariant &value, CVariant &outputValue) const;
+    bool validateArray(const Node &node, const CVariant &value, CVariant &outputValue) const;
+    bool validateObject(const Node &node, const CVariant &value, CVariant &outputValue) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<int> m_parameters;
+  };
+}
@@ -20,6 +20,7 @@
 
 #include "ServiceDescription.h"
 #include "JSONServiceDescription.h"
+#include "JSONSchemaValidator.h"
 #include "utils/log.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/StringUtils.h"
@@ -63,6 +64,7 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "Player.GetPlayers",                            CPlayerOperations::GetPlayers },
   { "Player.GetProperties",                         CPlayerOperations::GetProperties },
   { "Player.GetItem",                               CPlayerOperations::GetItem },
+  { "Player.GetFrameStats",                         CPlayerOperations::GetFrameStats },
 
   { "Player.PlayPause",                             CPlayerOperations::PlayPause },
   { "Player.Stop",                                  CPlayerOperations::Stop },
@@ -1222,6 +1224,7 @@ JsonRpcMethod::JsonRpcMethod()
     method(NULL),
     transportneed(Response),
     permission(ReadData),
+    readonly(false),
     description(),
     parameters(),
     returns(new JSONSchemaTypeDefinition())
@@ -1252,6 +1255,8 @@ bool JsonRpcMethod::Parse(const CVariant &value)
   else
     permission = StringToPermission(value.isMember("permission") ? value["permission"].asString() : "");
 
+  readonly = value.isMember("readonly") && value["readonly"].isBoolean() && value["readonly"].asBoolean();
+
   description = GetString(value["description"], "");
 
   // Check whether there are parameters defined
@@ -1303,34 +1308,18 @@ JSONRPC_STATUS JsonRpcMethod::Check(const CVariant &requestParameters, ITranspor
     {
       methodCall = method;
 
-      // Count the number of actually handled (present)
-      // parameters
-      unsigned int handled = 0;
-      CVariant errorData = CVariant(CVariant::VariantTypeObject);
-      errorData["method"] = name;
-
-      // Loop through all the parameters to check
-      for (unsigned int i = 0; i < parameters.size(); i++)
+      if (validator)
       {
-        // Evaluate the current parameter
-        JSONRPC_STATUS status = checkParameter(requestParameters, parameters.at(i), i, outputParameters, handled, errorData);
-        if (status != OK)
-        {
-          // Return the error data object in the outputParameters reference
-          outputParameters = errorData;
-          return status;
-        }
-      }
+        if (validator->Validate(requestParameters, outputParameters))
+          return OK;
 
-      // Check if there were unnecessary parameters
-      if (handled < requestParameters.size())
-      {
-        errorData["message"] = "Too many parameters";
-        outputParameters = errorData;
-        return InvalidParams;
+        // the compiled validator doesn't tell what's wrong
+        // with the parameters so check them again to get
+        // the details of the error
+        outputParameters = CVariant();
       }
 
-      return OK;
+      return CheckParameters(requestParameters, outputParameters);
     }
     else
       return BadPermission;
@@ -1339,6 +1328,38 @@ JSONRPC_STATUS JsonRpcMethod::Check(const CVariant &requestParameters, ITranspor
   return MethodNotFound;
 }
 
+JSONRPC_STATUS JsonRpcMethod::CheckParameters(const CVariant &requestParameters, CVariant &outputParameters) const
+{
+  // Count the number of actually handled (present)
+  // parameters
+  unsigned int handled = 0;
+  CVariant errorData = CVariant(CVariant::VariantTypeObject);
+  errorData["method"] = name;
+
+  // Loop through all the parameters to check
+  for (unsigned int i = 0; i < parameters.size(); i++)
+  {
+    // Evaluate the current parameter
+    JSONRPC_STATUS status = checkParameter(requestParameters, parameters.at(i), i, outputParameters, handled, errorData);
+    if (status != OK)
+    {
+      // Return the error data object in the outputParameters reference
+      outputParameters = errorData;
+      return status;
+    }
+  }
+
+  // Check if there were unnecessary parameters
+  if (handled < requestParameters.size())
+  {
+    errorData["message"] = "Too many parameters";
+    outputParameters = errorData;
+    return InvalidParams;
+  }
+
+  return OK;
+}
+
 bool JsonRpcMethod::parseParameter(const CVariant &value, JSONSchemaTypeDefinitionPtr parameter)
 {
   parameter->name = GetString(value["name"], "");
@@ -1518,6 +1539,10 @@ bool CJSONServiceDescription::addMethod(const std::string &jsonMethod, MethodCal
     return false;
   }
 
+  // compile the parameter definitions once instead of
+  // interpreting them on every call of the method
+  newMethod.validator = std::make_shared<CJSONSchemaValidator>(newMethod.parameters);
+
   m_actionMap.add(newMethod);
 
   return true;
@@ -1862,6 +1887,9 @@ JSONRPC_STATUS CJSONServiceDescription::Print(CVariant &result, ITransportLayer
         currentMethod["permission"] = permissions[0];
       else
         currentMethod["permission"] = permissions;
+
+      if (methodIterator->second.readonly)
+        currentMethod["readonly"] = true;
     }
 
     currentMethod["params"] = CVariant(CVariant::VariantTypeArray);
@@ -1895,6 +1923,21 @@ JSONRPC_STATUS CJSONServiceDescription::CheckCall(const char* const method, cons
   return MethodNotFound;
 }
 
+bool CJSONServiceDescription::IsReadOnlyMethod(const std::string &method)
+{
+  CJsonRpcMethodMap::JsonRpcMethodIterator iter = m_actionMap.find(method);
+  return iter != m_actionMap.end() && iter->second.readonly;
+}
+
+const JsonRpcMethod* CJSONServiceDescription::GetMethod(const std::string &method)
+{
+  CJsonRpcMethodMap::JsonRpcMethodIterator iter = m_actionMap.find(method);
+  if (iter == m_actionMap.end())
+    return NULL;
+
+  return &iter->second;
+}
+
 JSONSchemaTypeDefinitionPtr CJSONServiceDescription::GetType(const std::string &identification)
 {
   std::map<std::string, JSONSchemaTypeDefinitionPtr>::iterator iter = m_types.find(identification);
@@ -31,6 +31,7 @@ namespace JSONRPC
 {
   class JSONSchemaTypeDefinition;
   typedef std::shared_ptr<JSONSchemaTypeDefinition> JSONSchemaTypeDefinitionPtr;
+  class CJSONSchemaValidator;
 
   /*! 
    \ingroup jsonrpc
@@ -240,6 +241,14 @@ namespace JSONRPC
   
     bool Parse(const CVariant &value);
     JSONRPC_STATUS Check(const CVariant &requestParameters, ITransportLayer *transport, IClient *client, bool notification, MethodCall &methodCall, CVariant &outputParameters) const;
+    /*!
+     \brief Checks the given parameters against the type definitions
+     of the parameters without using the compiled validator
+     \param requestParameters Parameters from the request
+     \param outputParameters Cleaned up parameter list or the error data
+     \return OK if the parameters are valid otherwise InvalidParams
+     */
+    JSONRPC_STATUS CheckParameters(const CVariant &requestParameters, CVariant &outputParameters) const;
     
     std::string missingReference;    
     
@@ -262,6 +271,12 @@ namespace JSONRPC
      to execute the method
      */
     OperationPermission permission;
+    /*!
+     \brief Whether the method only reads data and
+     can be executed concurrently with other read-only
+     methods of the same batch request
+     */
+    bool readonly;
     /*!
      \brief Description of the method
      */
@@ -274,6 +289,11 @@ namespace JSONRPC
      \brief Definition of the return value
      */
     JSONSchemaTypeDefinitionPtr returns;
+    /*!
+     \brief Validator compiled from the definitions
+     of the parameters once the method has been parsed
+     */
+    std::shared_ptr<CJSONSchemaValidator> validator;
   
   private:
     bool parseParameter(const CVariant &value, JSONSchemaTypeDefinitionPtr parameter);
@@ -390,6 +410,20 @@ namespace JSONRPC
      given parameters from the request against the json schema description for the given method.
      */
     static JSONRPC_STATUS CheckCall(const char* method, const CVariant &requestParameters, ITransportLayer *transport, IClient *client, bool notification, MethodCall &methodCall, CVariant &outputParameters);
+
+    /*!
+     \brief Checks whether the given method is marked as read-only
+     \param method Name of the method (in lower case)
+     \return True if the method exists and only reads data otherwise false
+     */
+    static bool IsReadOnlyMethod(const std::string &method);
+
+    /*!
+     \brief Gets the definition of the given method
+     \param method Name of the method (in lower case)
+     \return Definition of the method or NULL if it doesn't exist
+     */
+    static const JsonRpcMethod* GetMethod(const std::string &method);
     
     static JSONSchemaTypeDefinitionPtr GetType(const std::string &identification);
 
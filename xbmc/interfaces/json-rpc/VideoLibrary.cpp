@@ -38,6 +38,9 @@ JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLay
   if (!videodatabase.Open())
     return InternalError;
 
+  if (HandleLibraryRevision(videodatabase, MediaTypeMovie, parameterObject, result))
+    return OK;
+
   SortDescription sorting;
   ParseLimits(parameterObject, sorting.limitStart, sorting.limitEnd);
   if (!ParseSorting(parameterObject, sorting.sortBy, sorting.sortOrder, sorting.sortAttributes))
@@ -148,6 +151,9 @@ JSONRPC_STATUS CVideoLibrary::GetTVShows(const std::string &method, ITransportLa
   if (!videodatabase.Open())
     return InternalError;
 
+  if (HandleLibraryRevision(videodatabase, MediaTypeTvShow, parameterObject, result))
+    return OK;
+
   SortDescription sorting;
   ParseLimits(parameterObject, sorting.limitStart, sorting.limitEnd);
   if (!ParseSorting(parameterObject, sorting.sortBy, sorting.sortOrder, sorting.sortAttributes))
@@ -0,0 +1,150 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "interfaces/json-rpc/FileItemHandler.h"
+#include "media/MediaType.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/URIUtils.h"
+#include "utils/Variant.h"
+#include "video/VideoDatabase.h"
+
+#include "gtest/gtest.h"
+
+using namespace JSONRPC;
+
+// the video database with its real schema, created in special://temp
+class CTestVideoDatabase : public CVideoDatabase
+{
+public:
+  virtual bool Open()
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    settings.name = "TestFileItemHandler";
+    return Update(settings);
+  }
+
+  void Delete()
+  {
+    std::string file = URIUtils::AddFileToFolder(m_pDB->getHostName(), m_pDB->getDatabase());
+    Close();
+    XFILE::CFile::Delete(file);
+  }
+};
+
+class CTestFileItemHandler : public CFileItemHandler
+{
+public:
+  using CFileItemHandler::HandleLibraryRevision;
+};
+
+class TestFileItemHandler : public testing::Test
+{
+protected:
+  TestFileItemHandler()
+  {
+    m_database.Open();
+  }
+
+  ~TestFileItemHandler()
+  {
+    m_database.Delete();
+  }
+
+  int AddMovie(const std::string &file)
+  {
+    return m_database.AddMovie(URIUtils::AddFileToFolder("/movies/", file));
+  }
+
+  bool GetMovies(const CVariant &parameters, CVariant &result)
+  {
+    result = CVariant(CVariant::VariantTypeObject);
+    return CTestFileItemHandler::HandleLibraryRevision(m_database, MediaTypeMovie, parameters, result);
+  }
+
+  CTestVideoDatabase m_database;
+};
+
+TEST_F(TestFileItemHandler, LibraryRevision)
+{
+  ASSERT_TRUE(m_database.IsOpen());
+
+  int first = AddMovie("first.mkv");
+  int second = AddMovie("second.mkv");
+  ASSERT_GE(first, 0);
+  ASSERT_GE(second, 0);
+
+  // a plain listing only reports the revision
+  CVariant parameters(CVariant::VariantTypeObject);
+  CVariant result;
+  EXPECT_FALSE(GetMovies(parameters, result));
+  ASSERT_TRUE(result["revision"].isInteger());
+  int64_t revision = result["revision"].asInteger();
+
+  parameters["ifnonematch"] = revision;
+  EXPECT_TRUE(GetMovies(parameters, result));
+  EXPECT_TRUE(result["unchanged"].asBoolean());
+  EXPECT_EQ(revision, result["revision"].asInteger());
+
+  // change one movie, remove the other and add two, one of which is gone again
+  m_database.UpdateMovieTitle(first, "First");
+  m_database.DeleteMovie(second);
+  int third = AddMovie("third.mkv");
+  int fourth = AddMovie("fourth.mkv");
+  m_database.DeleteMovie(fourth);
+
+  EXPECT_FALSE(GetMovies(parameters, result));
+  EXPECT_FALSE(result.isMember("unchanged"));
+  EXPECT_GT(result["revision"].asInteger(), revision);
+
+  parameters = CVariant(CVariant::VariantTypeObject);
+  parameters["since"] = revision;
+  EXPECT_TRUE(GetMovies(parameters, result));
+  const CVariant &changes = result["changes"];
+  ASSERT_EQ(1u, changes["added"].size());
+  EXPECT_EQ(third, changes["added"][0].asInteger());
+  ASSERT_EQ(1u, changes["changed"].size());
+  EXPECT_EQ(first, changes["changed"][0].asInteger());
+  ASSERT_EQ(1u, changes["removed"].size());
+  EXPECT_EQ(second, changes["removed"][0].asInteger());
+
+  // nothing changed since the current revision
+  parameters["since"] = result["revision"];
+  EXPECT_TRUE(GetMovies(parameters, result));
+  EXPECT_TRUE(result["changes"]["added"].empty());
+  EXPECT_TRUE(result["changes"]["changed"].empty());
+  EXPECT_TRUE(result["changes"]["removed"].empty());
+
+  // revisions from the future and changes no longer logged need a listing
+  parameters["since"] = result["revision"].asInteger() + 1;
+  EXPECT_FALSE(GetMovies(parameters, result));
+  EXPECT_FALSE(result.isMember("changes"));
+
+  ASSERT_TRUE(m_database.ExecuteQuery(m_database.PrepareSQL("DELETE FROM changelog WHERE idChange <= %i", (int)revision)));
+  parameters["since"] = revision - 1;
+  EXPECT_FALSE(GetMovies(parameters, result));
+  EXPECT_FALSE(result.isMember("changes"));
+}
@@ -0,0 +1,198 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+
+#include <gtest/gtest.h>
+#include "interfaces/json-rpc/JSONRPC.h"
+#include "interfaces/json-rpc/JSONSchemaValidator.h"
+#include "interfaces/json-rpc/JSONServiceDescription.h"
+#include "utils/log.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/TimeUtils.h"
+#include "utils/Variant.h"
+
+#define BENCHMARK_ITERATIONS  10000
+
+using namespace JSONRPC;
+
+typedef struct
+{
+  const char *method;
+  const char *parameters;
+  bool valid;
+} ValidatorTestCall;
+
+static const ValidatorTestCall validatorTestCalls[] =
+{
+  { "videolibrary.getmovies", "{ \"properties\": [ \"title\", \"year\", \"rating\", \"art\", \"file\" ], \"limits\": { \"start\": 0, \"end\": 50 }, \"sort\": { \"method\": \"title\", \"order\": \"ascending\", \"ignorearticle\": true } }", true },
+  { "videolibrary.getmovies", "{ \"filter\": { \"and\": [ { \"field\": \"genre\", \"operator\": \"is\", \"value\": \"Drama\" }, { \"field\": \"year\", \"operator\": \"greaterthan\", \"value\": \"2000\" } ] } }", true },
+  { "videolibrary.getmovies", "{}", true },
+  { "videolibrary.getmovies", "[ [ \"title\" ], { \"start\": 10 } ]", true },
+  { "videolibrary.getmovies", "{ \"properties\": [ \"title\", \"title\" ] }", false },
+  { "videolibrary.getmovies", "{ \"properties\": [ \"unknown\" ] }", false },
+  { "videolibrary.getmovies", "{ \"limits\": { \"start\": -1 } }", false },
+  { "videolibrary.getmovies", "{ \"unknown\": true }", false },
+  { "videolibrary.getmovies", "{ \"properties\": [ \"title\" ], \"ifnonematch\": 42, \"since\": 40 }", true },
+  { "videolibrary.getmovies", "{ \"since\": -1 }", false },
+  { "videolibrary.getmoviedetails", "{ \"movieid\": 1, \"properties\": [ \"cast\", \"streamdetails\" ] }", true },
+  { "videolibrary.getmoviedetails", "{ \"properties\": [ \"cast\" ] }", false },
+  { "audiolibrary.getsongs", "{ \"properties\": [ \"title\", \"artist\", \"album\", \"duration\" ], \"limits\": { \"start\": 0, \"end\": 100 }, \"sort\": { \"method\": \"track\" } }", true },
+  { "audiolibrary.getsongs", "{ \"filter\": { \"artistid\": 5 } }", true },
+  { "audiolibrary.getalbums", "{ \"properties\": [ \"title\", \"thumbnail\" ], \"filter\": { \"genre\": \"Rock\" } }", true },
+  { "player.getproperties", "{ \"playerid\": 1, \"properties\": [ \"time\", \"totaltime\", \"percentage\", \"speed\" ] }", true },
+  { "player.getproperties", "{ \"playerid\": \"1\", \"properties\": [ \"time\" ] }", false },
+  { "player.getitem", "{ \"playerid\": 1, \"properties\": [ \"title\", \"album\", \"artist\", \"thumbnail\" ] }", true },
+  { "player.open", "{ \"item\": { \"file\": \"/tmp/movie.mkv\" }, \"options\": { \"resume\": true } }", true },
+  { "player.seek", "{ \"playerid\": 1, \"value\": { \"percentage\": 50.5 } }", true },
+  { "player.seek", "{ \"playerid\": 1, \"value\": true }", false },
+  { "files.getdirectory", "{ \"directory\": \"/tmp\", \"media\": \"video\", \"properties\": [ \"size\", \"lastmodified\" ], \"sort\": { \"method\": \"label\" } }", true },
+  { "jsonrpc.ping", "{}", true },
+  { "jsonrpc.ping", "[ 1 ]", false },
+  { "application.setvolume", "{ \"volume\": 50 }", true },
+  { "application.setvolume", "{ \"volume\": \"increment\" }", true },
+  { "application.setvolume", "{ \"volume\": 101 }", false }
+};
+
+class TestJSONSchemaValidator : public testing::Test
+{
+protected:
+  virtual void SetUp()
+  {
+    CJSONRPC::Initialize();
+  }
+
+  virtual void TearDown()
+  {
+    CJSONRPC::Cleanup();
+  }
+
+  static CVariant GetParameters(const ValidatorTestCall &call)
+  {
+    return CJSONVariantParser::Parse(reinterpret_cast<const unsigned char*>(call.parameters), strlen(call.parameters));
+  }
+
+  // CVariant doesn't consider two null values to be equal
+  static bool AreEqual(const CVariant &lhs, const CVariant &rhs)
+  {
+    if (lhs.isNull() || rhs.isNull())
+      return lhs.isNull() && rhs.isNull();
+
+    if (lhs.isArray() && rhs.isArray())
+    {
+      if (lhs.size() != rhs.size())
+        return false;
+      for (unsigned int index = 0; index < lhs.size(); index++)
+      {
+        if (!AreEqual(lhs[index], rhs[index]))
+          return false;
+      }
+      return true;
+    }
+
+    if (lhs.isObject() && rhs.isObject())
+    {
+      if (lhs.size() != rhs.size())
+        return false;
+      for (CVariant::const_iterator_map member = lhs.begin_map(); member != lhs.end_map(); ++member)
+      {
+        if (!rhs.isMember(member->first) || !AreEqual(member->second, rhs[member->first]))
+          return false;
+      }
+      return true;
+    }
+
+    return lhs == rhs;
+  }
+};
+
+TEST_F(TestJSONSchemaValidator, CompiledMatchesInterpreted)
+{
+  for (size_t i = 0; i < sizeof(validatorTestCalls) / sizeof(ValidatorTestCall); i++)
+  {
+    const ValidatorTestCall &call = validatorTestCalls[i];
+    const JsonRpcMethod *method = CJSONServiceDescription::GetMethod(call.method);
+    ASSERT_TRUE(method != NULL) << call.method;
+    ASSERT_TRUE(method->validator != NULL) << call.method;
+
+    CVariant parameters = GetParameters(call);
+    CVariant compiledOutput, interpretedOutput;
+    bool valid = method->validator->Validate(parameters, compiledOutput);
+    JSONRPC_STATUS status = method->CheckParameters(parameters, interpretedOutput);
+
+    EXPECT_EQ(call.valid, valid) << call.method << " " << call.parameters;
+    EXPECT_EQ(call.valid, status == OK) << call.method << " " << call.parameters;
+    if (valid)
+    {
+      EXPECT_TRUE(AreEqual(compiledOutput, interpretedOutput)) << call.method << " " << call.parameters;
+    }
+  }
+}
+
+TEST_F(TestJSONSchemaValidator, InvalidCallReportsErrorDetails)
+{
+  const JsonRpcMethod *method = CJSONServiceDescription::GetMethod("videolibrary.getmovies");
+  ASSERT_TRUE(method != NULL);
+
+  const char *request = "{ \"properties\": [ \"unknown\" ] }";
+  CVariant parameters = CJSONVariantParser::Parse(reinterpret_cast<const unsigned char*>(request), strlen(request));
+  CVariant output;
+  EXPECT_FALSE(method->validator->Validate(parameters, output));
+
+  // the details of the error are provided by the interpreted check
+  output = CVariant();
+  EXPECT_EQ(InvalidParams, method->CheckParameters(parameters, output));
+  EXPECT_STREQ("VideoLibrary.GetMovies", output["method"].asString().c_str());
+  EXPECT_TRUE(output["stack"]["message"].isString());
+}
+
+TEST_F(TestJSONSchemaValidator, Benchmark)
+{
+  for (size_t i = 0; i < sizeof(validatorTestCalls) / sizeof(ValidatorTestCall); i++)
+  {
+    const ValidatorTestCall &call = validatorTestCalls[i];
+    if (!call.valid)
+      continue;
+
+    const JsonRpcMethod *method = CJSONServiceDescription::GetMethod(call.method);
+    ASSERT_TRUE(method != NULL);
+    CVariant parameters = GetParameters(call);
+
+    int64_t start = CurrentHostCounter();
+    for (unsigned int iteration = 0; iteration < BENCHMARK_ITERATIONS; iteration++)
+    {
+      CVariant output;
+      method->CheckParameters(parameters, output);
+    }
+    int64_t interpreted = CurrentHostCounter() - start;
+
+    start = CurrentHostCounter();
+    for (unsigned int iteration = 0; iteration < BENCHMARK_ITERATIONS; iteration++)
+    {
+      CVariant output;
+      method->validator->Validate(parameters, output);
+    }
+    int64_t compiled = CurrentHostCounter() - start;
+
+    CLog::Log(LOGNOTICE, "TestJSONSchemaValidator: %s interpreted %.2f us, compiled %.2f us per call",
+              call.method, 1000000.0 * interpreted / CurrentHostFrequency() / BENCHMARK_ITERATIONS,
+              1000000.0 * compiled / CurrentHostFrequency() / BENCHMARK_ITERATIONS);
+  }
+}
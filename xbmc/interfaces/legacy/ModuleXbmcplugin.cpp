@@ -98,6 +98,11 @@ namespace XBMCAddon
       XFILE::CPluginDirectory::SetContent(handle, content);
     }
 
+    void setCacheLifetime(int handle, int seconds)
+    {
+      XFILE::CPluginDirectory::SetCacheLifetime(handle, seconds);
+    }
+
     void setPluginCategory(int handle, const String& category)
     {
       XFILE::CPluginDirectory::SetProperty(handle, "plugincategory", category);
@@ -190,6 +190,20 @@ namespace XBMCAddon
      */
     void setProperty(int handle, const char* key, const String& value);
 
+    /**
+     * setCacheLifetime(handle, seconds) -- Sets how long the listing may be served from Kodi's directory cache.
+     * 
+     * handle      : integer - handle the plugin was started with.\n
+     * seconds     : integer - number of seconds the listing stays valid, 0 to never cache it.
+     * 
+     * *Note, If not set listings which may be cached to disc are cached for a short while.
+     *        Container.Refresh always fetches the listing again.
+     * 
+     * example:
+     *   - xbmcplugin.setCacheLifetime(int(sys.argv[1]), 3600)
+     */
+    void setCacheLifetime(int handle, int seconds);
+
     SWIG_CONSTANT(int,SORT_METHOD_NONE);
     SWIG_CONSTANT(int,SORT_METHOD_LABEL);
     SWIG_CONSTANT(int,SORT_METHOD_LABEL_IGNORE_THE);
@@ -26,11 +26,14 @@
 #include <Python.h>
 #include <osdefs.h>
 
+#include <algorithm>
+
 #include "system.h"
 #include "PythonInvoker.h"
 #include "Application.h"
 #include "messaging/ApplicationMessenger.h"
 #include "addons/AddonManager.h"
+#include "addons/PluginSource.h"
 #include "dialogs/GUIDialogKaiToast.h"
 #include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
@@ -48,6 +51,7 @@
 #endif // defined(TARGET_WINDOWS)
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/URIUtils.h"
 #ifdef TARGET_POSIX
 #include "linux/XTimeUtils.h"
@@ -160,9 +164,25 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
 
   CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): start processing", GetId(), m_sourceFile.c_str());
 
+  int64_t startTime = CurrentHostCounter();
+
+  // reentrant add-ons are run in a warm interpreter if there is one left from a previous run
+  bool reusable = canReuseInterpreter();
+  PyInterpreterState* interp = NULL;
+  if (reusable)
+    interp = static_cast<PyInterpreterState*>(g_pythonParser.AcquireInterpreter(m_addon->ID(), m_addon->Version().asString()));
+  bool warm = interp != NULL;
+
   // get the global lock
   PyEval_AcquireLock();
-  PyThreadState* state = Py_NewInterpreter();
+  PyThreadState* state;
+  if (warm)
+  {
+    // thread states belong to the thread that created them
+    state = PyThreadState_New(interp);
+  }
+  else
+    state = Py_NewInterpreter();
   if (state == NULL)
   {
     PyEval_ReleaseLock();
@@ -172,10 +192,22 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
   // swap in my thread state
   PyThreadState_Swap(state);
 
-  XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> languageHook(new XBMCAddon::Python::PythonLanguageHook(state->interp));
-  languageHook->RegisterMe();
+  XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> languageHook;
+  if (warm)
+    languageHook = XBMCAddon::Python::PythonLanguageHook::GetIfExists(state->interp);
+  else
+  {
+    languageHook = new XBMCAddon::Python::PythonLanguageHook(state->interp);
+    languageHook->RegisterMe();
+  }
+
+  int64_t setupTime = CurrentHostCounter();
 
-  onInitialization();
+  // the modules of a warm interpreter are already initialized
+  if (warm)
+    onReinitialization();
+  else
+    onInitialization();
   setState(InvokerStateInitialized);
 
   std::string realFilename(CSpecialProtocol::TranslatePath(m_sourceFile));
@@ -247,6 +279,8 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
   PyObject* module = PyImport_AddModule((char*)"__main__");
   PyObject* moduleDict = PyModule_GetDict(module);
 
+  int64_t importTime = CurrentHostCounter();
+
   // when we are done initing we store thread state so we can be aborted
   PyThreadState_Swap(NULL);
   PyEval_ReleaseLock();
@@ -292,6 +326,7 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
         Py_DECREF(f);
         setState(InvokerStateRunning);
         XBMCAddon::Python::PyContext pycontext; // this is a guard class that marks this callstack as being in a python context
+        importTime = CurrentHostCounter();
         executeScript(fp, nativeFilename, module, moduleDict);
       }
       else
@@ -311,6 +346,8 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
     }
   }
 
+  int64_t scriptTime = CurrentHostCounter();
+
   bool systemExitThrown = false;
   InvokerState stateToSet;
   if (!failed && !PyErr_Occurred())
@@ -410,18 +447,49 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
       PyRun_SimpleString(GC_SCRIPT) == -1)
     CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to run the gc to clean up after running prior to shutting down the Interpreter", GetId(), m_sourceFile.c_str());
 
-  Py_EndInterpreter(state);
+  // only keep interpreters of scripts which ran through without being stopped
+  bool pooled = false;
+  if (reusable && !m_stop && stateToSet == InvokerStateDone)
+  {
+    // only the interpreter is kept, the next run creates a thread state on its own thread
+    PyErr_Clear();
+    interp = state->interp;
+    PyThreadState_Clear(state);
+    PyThreadState_Swap(NULL);
+    PyThreadState_Delete(state);
+    PyEval_ReleaseLock();
+
+    pooled = g_pythonParser.ReleaseInterpreter(m_addon->ID(), m_addon->Version().asString(), interp);
+    if (!pooled)
+    {
+      PyEval_AcquireLock();
+      state = PyThreadState_New(interp);
+      PyThreadState_Swap(state);
+    }
+  }
+
+  if (!pooled)
+  {
+    Py_EndInterpreter(state);
 
-  // If we still have objects left around, produce an error message detailing what's been left behind
-  if (languageHook->HasRegisteredAddonClasses())
-    CLog::Log(LOGWARNING, "CPythonInvoker(%d, %s): the python script \"%s\" has left several "
-      "classes in memory that we couldn't clean up. The classes include: %s",
-      GetId(), m_sourceFile.c_str(), m_sourceFile.c_str(), getListOfAddonClassesAsString(languageHook).c_str());
+    // If we still have objects left around, produce an error message detailing what's been left behind
+    if (languageHook->HasRegisteredAddonClasses())
+      CLog::Log(LOGWARNING, "CPythonInvoker(%d, %s): the python script \"%s\" has left several "
+        "classes in memory that we couldn't clean up. The classes include: %s",
+        GetId(), m_sourceFile.c_str(), m_sourceFile.c_str(), getListOfAddonClassesAsString(languageHook).c_str());
 
-  // unregister the language hook
-  languageHook->UnregisterMe();
+    // unregister the language hook
+    languageHook->UnregisterMe();
 
-  PyEval_ReleaseLock();
+    PyEval_ReleaseLock();
+  }
+
+  int64_t endTime = CurrentHostCounter();
+  double frequency = CurrentHostFrequency() / 1000.0;
+  CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): %s interpreter, setup %.1f ms, import %.1f ms, script %.1f ms, teardown %.1f ms",
+            GetId(), m_sourceFile.c_str(), warm ? "warm" : (pooled ? "new (pooled)" : "new"),
+            (setupTime - startTime) / frequency, (importTime - setupTime) / frequency,
+            (scriptTime - importTime) / frequency, (endTime - scriptTime) / frequency);
 
   setState(stateToSet);
 
@@ -560,6 +628,28 @@ void CPythonInvoker::onInitialization()
   }
 }
 
+void CPythonInvoker::onReinitialization()
+{
+  XBMC_TRACE;
+  PyObject *m = PyImport_AddModule((char*)"xbmc");
+  if (m == NULL || PyObject_SetAttrString(m, (char*)"abortRequested", Py_False))
+    CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to reset abortRequested", GetId(), m_sourceFile.c_str());
+
+  // start with an empty __main__ module, imported modules are kept
+  PyObject *mainDict = PyModule_GetDict(PyImport_AddModule((char*)"__main__"));
+  PyDict_Clear(mainDict);
+  PyDict_SetItemString(mainDict, "__builtins__", PyEval_GetBuiltins());
+  PyObject *name = PyString_FromString("__main__");
+  PyDict_SetItemString(mainDict, "__name__", name);
+  Py_DECREF(name);
+}
+
+bool CPythonInvoker::canReuseInterpreter() const
+{
+  std::shared_ptr<ADDON::CPluginSource> plugin = std::dynamic_pointer_cast<ADDON::CPluginSource>(m_addon);
+  return plugin && plugin->IsReentrant();
+}
+
 void CPythonInvoker::onPythonModuleInitialization(void* moduleDict)
 {
   if (m_addon.get() == NULL || moduleDict == NULL)
@@ -668,6 +758,11 @@ void CPythonInvoker::addNativePath(const std::string& path)
   if (path.empty())
     return;
 
+  // the sys.path of a warm interpreter already contains the paths of its previous run
+  std::vector<std::string> paths = StringUtils::Split(m_pythonPath, std::string(1, PY_PATH_SEP));
+  if (std::find(paths.begin(), paths.end(), path) != paths.end())
+    return;
+
   if (!m_pythonPath.empty())
     m_pythonPath += PY_PATH_SEP;
 
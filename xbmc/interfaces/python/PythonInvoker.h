@@ -49,6 +49,8 @@ protected:
   virtual std::map<std::string, PythonModuleInitialization> getModules() const;
   virtual const char* getInitializationScript() const;
   virtual void onInitialization();
+  // called instead of onInitialization() when a warm interpreter of a reentrant add-on is reused
+  virtual void onReinitialization();
   // actually a PyObject* but don't wanna draw Python.h include into the header
   virtual void onPythonModuleInitialization(void* moduleDict);
   virtual void onDeinitialization();
@@ -68,6 +70,8 @@ private:
   void addPath(const std::string& path); // add path in UTF-8 encoding
   void addNativePath(const std::string& path); // add path in system/Python encoding
   void getAddonModuleDeps(const ADDON::AddonPtr& addon, std::set<std::string>& paths);
+  // whether the interpreter of the add-on may be pooled and reused
+  bool canReuseInterpreter() const;
 
   std::string m_pythonPath;
   void *m_threadState;
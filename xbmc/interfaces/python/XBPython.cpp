@@ -48,8 +48,14 @@
 #include "interfaces/legacy/Monitor.h"
 #include "interfaces/legacy/AddonUtils.h"
 #include "interfaces/python/AddonPythonInvoker.h"
+#include "interfaces/python/LanguageHook.h"
 #include "interfaces/python/PythonInvoker.h"
 
+// maximum number of idle interpreters kept per reentrant add-on
+#define PYTHON_POOL_MAX_INTERPRETERS  2
+// time without any running scripts after which pooled interpreters are ended
+#define PYTHON_POOL_IDLE_TIMEOUT      300000 // ms
+
 using namespace ANNOUNCEMENT;
 
 XBPython::XBPython()
@@ -446,6 +452,22 @@ void XBPython::UnloadExtensionLibs()
   m_extensions.clear();
 }
 
+// Always called with the GIL held
+static void EndPooledInterpreters(const XBPython::InterpreterPool &interpreters)
+{
+  for (XBPython::InterpreterPool::const_iterator it = interpreters.begin(); it != interpreters.end(); ++it)
+  {
+    // a pooled interpreter has no thread state left, ending it needs one on this thread
+    PyInterpreterState* interp = (PyInterpreterState*)it->second.second;
+    PyThreadState* state = PyThreadState_New(interp);
+    PyThreadState_Swap(state);
+
+    XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> languageHook(XBMCAddon::Python::PythonLanguageHook::GetIfExists(interp));
+    Py_EndInterpreter(state);
+    languageHook->UnregisterMe();
+  }
+}
+
 // Always called with the lock held on m_critSection
 void XBPython::Finalize()
 {
@@ -459,9 +481,14 @@ void XBPython::Finalize()
     m_bInitialized    = false;
     PyThreadState* curTs = (PyThreadState*)m_mainThreadState;
     m_mainThreadState = NULL; // clear the main thread state before releasing the lock
+    InterpreterPool interpreters;
+    interpreters.swap(m_interpreterPool);
     {
       CSingleExit exit(m_critSection);
       PyEval_AcquireLock();
+
+      // the sub interpreters have to be ended before the main one
+      EndPooledInterpreters(interpreters);
       PyThreadState_Swap(curTs);
 
       Py_Finalize();
@@ -525,13 +552,79 @@ void XBPython::Process()
     tmpvec.clear(); // boost releases the XBPyThreads which, if deleted, calls OnScriptFinalized
 
     CSingleLock l2(m_critSection);
-    if(m_iDllScriptCounter == 0 && (XbmcThreads::SystemClockMillis() - m_endtime) > 10000 )
+    unsigned int idleTime = XbmcThreads::SystemClockMillis() - m_endtime;
+    // keep python loaded a while longer for warm interpreters of reentrant add-ons
+    if (m_iDllScriptCounter == 0 && idleTime > 10000 &&
+        (m_interpreterPool.empty() || idleTime > PYTHON_POOL_IDLE_TIMEOUT))
     {
       Finalize();
     }
   }
 }
 
+void* XBPython::AcquireInterpreter(const std::string &addonId, const std::string &version)
+{
+  CSingleLock lock(m_critSection);
+  std::pair<InterpreterPool::iterator, InterpreterPool::iterator> range = m_interpreterPool.equal_range(addonId);
+  for (InterpreterPool::iterator it = range.first; it != range.second; ++it)
+  {
+    if (it->second.first == version)
+    {
+      void* interpreter = it->second.second;
+      m_interpreterPool.erase(it);
+      return interpreter;
+    }
+  }
+
+  return NULL;
+}
+
+bool XBPython::ReleaseInterpreter(const std::string &addonId, const std::string &version, void *interpreter)
+{
+  CSingleLock lock(m_critSection);
+  if (!m_bInitialized || interpreter == NULL)
+    return false;
+
+  unsigned int count = 0;
+  std::pair<InterpreterPool::iterator, InterpreterPool::iterator> range = m_interpreterPool.equal_range(addonId);
+  for (InterpreterPool::iterator it = range.first; it != range.second; ++it)
+  {
+    if (it->second.first == version)
+      count++;
+  }
+  if (count >= PYTHON_POOL_MAX_INTERPRETERS)
+    return false;
+
+  m_interpreterPool.insert(std::make_pair(addonId, std::make_pair(version, interpreter)));
+  return true;
+}
+
+void XBPython::ClearInterpreters(const std::string &addonId)
+{
+  InterpreterPool interpreters;
+  {
+    CSingleLock lock(m_critSection);
+    std::pair<InterpreterPool::iterator, InterpreterPool::iterator> range = m_interpreterPool.equal_range(addonId);
+    if (range.first == range.second)
+      return;
+
+    interpreters.insert(range.first, range.second);
+    m_interpreterPool.erase(range.first, range.second);
+
+    // keep python from being finalized until the interpreters are ended
+    m_iDllScriptCounter++;
+  }
+
+  CLog::Log(LOGDEBUG, "XBPython: ending %u idle interpreters of %s", (unsigned int)interpreters.size(), addonId.c_str());
+  PyEval_AcquireLock();
+  EndPooledInterpreters(interpreters);
+  PyThreadState_Swap(NULL);
+  PyEval_ReleaseLock();
+
+  CSingleLock lock(m_critSection);
+  m_iDllScriptCounter--;
+}
+
 bool XBPython::OnScriptInitialized(ILanguageInvoker *invoker)
 {
   if (invoker == NULL)
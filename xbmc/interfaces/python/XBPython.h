@@ -27,7 +27,9 @@
 #include "interfaces/IAnnouncer.h"
 #include "interfaces/generic/ILanguageInvocationHandler.h"
 
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 class CPythonInvoker;
@@ -107,6 +109,29 @@ public:
   void UnregisterExtensionLib(LibraryLoader *pLib);
   void UnloadExtensionLibs();
 
+  // add-on id to the add-on version and the interpreter (PyInterpreterState*)
+  typedef std::multimap<std::string, std::pair<std::string, void*> > InterpreterPool;
+
+  /*! \brief Takes an idle interpreter of a reentrant add-on out of the pool
+   \param addonId Identifier of the add-on the interpreter was created for
+   \param version Version of the add-on the interpreter was created for
+   \return The interpreter (PyInterpreterState*) or NULL if there is none
+   */
+  void* AcquireInterpreter(const std::string &addonId, const std::string &version);
+
+  /*! \brief Puts the interpreter of a reentrant add-on back into the pool
+   \param addonId Identifier of the add-on the interpreter was created for
+   \param version Version of the add-on the interpreter was created for
+   \param interpreter The interpreter (PyInterpreterState*) without any thread states left
+   \return False if the pool is full and the caller has to end the interpreter
+   */
+  bool ReleaseInterpreter(const std::string &addonId, const std::string &version, void *interpreter);
+
+  /*! \brief Ends the idle interpreters of an add-on which is disabled or uninstalled
+   \param addonId Identifier of the add-on
+   */
+  void ClearInterpreters(const std::string &addonId);
+
 private:
   void Finalize();
 
@@ -131,6 +156,9 @@ private:
   // in order to finalize and unload the python library, need to save all the extension libraries that are
   // loaded by it and unload them first (not done by finalize)
   PythonExtensionLibraries m_extensions;
+
+  // idle interpreters of reentrant add-ons by add-on id, kept alive between invocations
+  InterpreterPool m_interpreterPool;
 };
 
 extern XBPython g_pythonParser;
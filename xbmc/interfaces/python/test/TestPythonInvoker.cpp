@@ -0,0 +1,194 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "addons/PluginSource.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "interfaces/python/PythonInvoker.h"
+#include "interfaces/python/XBPython.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+#include "utils/auto_buffer.h"
+#include "utils/FileUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+#define TEST_ADDON_ID   "plugin.test.pythoninvoker"
+#define TEST_ADDON_PATH "special://temp/pythoninvoker/"
+
+// counts its runs in the interpreter and records the run and the thread it ran on
+static const char *TEST_SCRIPT =
+  "import sys, thread\n"
+  "runs = getattr(sys, 'pythoninvoker_runs', 0) + 1\n"
+  "sys.pythoninvoker_runs = runs\n"
+  "f = open(sys.argv[1], 'a')\n"
+  "f.write('%d %d\\n' % (runs, thread.get_ident()))\n"
+  "f.close()\n";
+
+class CRunScriptThread : public CThread
+{
+public:
+  CRunScriptThread(const ADDON::AddonPtr &addon, int id, const std::string &script, const std::string &output)
+    : CThread("RunScript"),
+      m_addon(addon),
+      m_id(id),
+      m_script(script),
+      m_output(output),
+      m_result(false),
+      m_state(InvokerStateUninitialized)
+  { }
+
+  bool WaitUntilDone() { return m_done.WaitMSec(10000); }
+  bool GetResult() const { return m_result; }
+  InvokerState GetState() const { return m_state; }
+
+  void Exit()
+  {
+    m_exit.Set();
+    StopThread(true);
+  }
+
+protected:
+  virtual void Process()
+  {
+    CPythonInvoker invoker(&g_pythonParser);
+    invoker.SetId(m_id);
+    invoker.SetAddon(m_addon);
+
+    std::vector<std::string> arguments;
+    arguments.push_back(m_script);
+    arguments.push_back(m_output);
+    m_result = invoker.Execute(m_script, arguments);
+    m_state = invoker.GetState();
+    m_done.Set();
+
+    // stay alive so that the next thread can't get the same thread id
+    m_exit.Wait();
+  }
+
+private:
+  ADDON::AddonPtr m_addon;
+  int m_id;
+  std::string m_script;
+  std::string m_output;
+  bool m_result;
+  InvokerState m_state;
+  CEvent m_done;
+  CEvent m_exit;
+};
+
+class TestPythonInvoker : public testing::Test
+{
+protected:
+  virtual void SetUp()
+  {
+    XFILE::CDirectory::Create(TEST_ADDON_PATH);
+    m_script = URIUtils::AddFileToFolder(TEST_ADDON_PATH, "default.py");
+    m_output = URIUtils::AddFileToFolder(TEST_ADDON_PATH, "runs.txt");
+
+    XFILE::CFile file;
+    ASSERT_TRUE(file.OpenForWrite(m_script, true));
+    ASSERT_EQ((ssize_t)strlen(TEST_SCRIPT), file.Write(TEST_SCRIPT, strlen(TEST_SCRIPT)));
+    file.Close();
+
+    ADDON::AddonProps props(TEST_ADDON_ID, ADDON::ADDON_PLUGIN, "1.0.0", "");
+    props.path = TEST_ADDON_PATH;
+    props.extrainfo.insert(std::make_pair("reentrant", "true"));
+    m_addon.reset(new ADDON::CPluginSource(props));
+  }
+
+  virtual void TearDown()
+  {
+    g_pythonParser.ClearInterpreters(TEST_ADDON_ID);
+    CFileUtils::DeleteItem(TEST_ADDON_PATH, true);
+  }
+
+  static bool Run(CRunScriptThread &thread)
+  {
+    thread.Create();
+    if (!thread.WaitUntilDone())
+      return false;
+    return thread.GetResult() && thread.GetState() == InvokerStateDone;
+  }
+
+  std::vector<std::string> GetRuns()
+  {
+    XUTILS::auto_buffer buffer;
+    XFILE::CFile file;
+    if (file.LoadFile(m_output, buffer) <= 0)
+      return std::vector<std::string>();
+
+    std::string output(buffer.get(), buffer.size());
+    StringUtils::TrimRight(output);
+    return StringUtils::Split(output, "\n");
+  }
+
+  ADDON::AddonPtr m_addon;
+  std::string m_script;
+  std::string m_output;
+};
+
+TEST_F(TestPythonInvoker, PooledInterpreterRunsOnDifferentThreads)
+{
+  CRunScriptThread thread1(m_addon, 1, m_script, m_output);
+  CRunScriptThread thread2(m_addon, 2, m_script, m_output);
+  EXPECT_TRUE(Run(thread1));
+  EXPECT_TRUE(Run(thread2));
+  thread1.Exit();
+  thread2.Exit();
+
+  std::vector<std::string> runs = GetRuns();
+  ASSERT_EQ(2U, runs.size());
+
+  // the second run counted on from the first one so it got the pooled interpreter
+  std::vector<std::string> first = StringUtils::Split(runs[0], " ");
+  std::vector<std::string> second = StringUtils::Split(runs[1], " ");
+  ASSERT_EQ(2U, first.size());
+  ASSERT_EQ(2U, second.size());
+  EXPECT_EQ("1", first[0]);
+  EXPECT_EQ("2", second[0]);
+
+  // and python saw the thread it actually ran on
+  EXPECT_NE(first[1], second[1]);
+}
+
+TEST_F(TestPythonInvoker, ClearedInterpreterIsNotReused)
+{
+  CRunScriptThread thread1(m_addon, 1, m_script, m_output);
+  EXPECT_TRUE(Run(thread1));
+  thread1.Exit();
+
+  g_pythonParser.ClearInterpreters(TEST_ADDON_ID);
+
+  CRunScriptThread thread2(m_addon, 2, m_script, m_output);
+  EXPECT_TRUE(Run(thread2));
+  thread2.Exit();
+
+  std::vector<std::string> runs = GetRuns();
+  ASSERT_EQ(2U, runs.size());
+  EXPECT_TRUE(StringUtils::StartsWith(runs[0], "1 "));
+  EXPECT_TRUE(StringUtils::StartsWith(runs[1], "1 "));
+}
@@ -0,0 +1,421 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "interfaces/AnnouncementManager.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "threads/Thread.h"
+#include "utils/Variant.h"
+
+using namespace ANNOUNCEMENT;
+
+#define WAIT_TIMEOUT_MS 5000
+
+class CTestAnnouncer : public IAnnouncer
+{
+public:
+  CTestAnnouncer()
+    : m_blockNext(false),
+      m_threadId(0)
+  { }
+
+  virtual void Announce(AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
+  {
+    bool block;
+    {
+      CSingleLock lock(m_critSection);
+      block = m_blockNext;
+      m_blockNext = false;
+    }
+
+    if (block)
+    {
+      m_blocking.Set();
+      m_release.Wait();
+    }
+
+    CSingleLock lock(m_critSection);
+    m_messages.push_back(message);
+    m_data.push_back(data);
+    m_threadId = CThread::GetCurrentThreadId();
+    m_received.Set();
+  }
+
+  // block the announcer in the next announcement until Release() is called
+  void BlockNext()
+  {
+    CSingleLock lock(m_critSection);
+    m_blockNext = true;
+  }
+
+  bool WaitUntilBlocking() { return m_blocking.WaitMSec(WAIT_TIMEOUT_MS); }
+  void Release() { m_release.Set(); }
+
+  bool WaitForMessages(size_t count)
+  {
+    XbmcThreads::EndTime timeout(WAIT_TIMEOUT_MS);
+    while (GetMessages().size() < count)
+    {
+      if (timeout.IsTimePast())
+        return false;
+      m_received.WaitMSec(timeout.MillisLeft());
+    }
+    return true;
+  }
+
+  std::vector<std::string> GetMessages()
+  {
+    CSingleLock lock(m_critSection);
+    return m_messages;
+  }
+
+  std::vector<CVariant> GetData()
+  {
+    CSingleLock lock(m_critSection);
+    return m_data;
+  }
+
+  ThreadIdentifier GetThreadId()
+  {
+    CSingleLock lock(m_critSection);
+    return m_threadId;
+  }
+
+private:
+  CCriticalSection m_critSection;
+  bool m_blockNext;
+  CEvent m_blocking;
+  CEvent m_release;
+  CEvent m_received;
+  std::vector<std::string> m_messages;
+  std::vector<CVariant> m_data;
+  ThreadIdentifier m_threadId;
+};
+
+class CRemoveAnnouncerThread : public CThread
+{
+public:
+  explicit CRemoveAnnouncerThread(IAnnouncer &announcer)
+    : CThread("RemoveAnnouncer"),
+      m_announcer(announcer)
+  { }
+
+protected:
+  virtual void Process()
+  {
+    CAnnouncementManager::GetInstance().RemoveAnnouncer(&m_announcer);
+  }
+
+private:
+  IAnnouncer &m_announcer;
+};
+
+// removes another announcer from a different thread while handling an announcement
+class CRemovingAnnouncer : public IAnnouncer
+{
+public:
+  explicit CRemovingAnnouncer(IAnnouncer &other)
+    : m_other(other),
+      m_removed(false)
+  { }
+
+  virtual void Announce(AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
+  {
+    CRemoveAnnouncerThread remover(m_other);
+    remover.Create();
+    bool removed = remover.WaitForThreadExit(WAIT_TIMEOUT_MS);
+
+    CSingleLock lock(m_critSection);
+    m_removed = removed;
+    m_done.Set();
+  }
+
+  bool WaitUntilDone() { return m_done.WaitMSec(WAIT_TIMEOUT_MS); }
+
+  bool HasRemoved()
+  {
+    CSingleLock lock(m_critSection);
+    return m_removed;
+  }
+
+private:
+  IAnnouncer &m_other;
+  CCriticalSection m_critSection;
+  CEvent m_done;
+  bool m_removed;
+};
+
+static bool GetStatistics(const IAnnouncer *announcer, AnnouncerStatistics &statistics)
+{
+  std::vector<AnnouncerStatistics> all = CAnnouncementManager::GetInstance().GetStatistics();
+  for (std::vector<AnnouncerStatistics>::const_iterator it = all.begin(); it != all.end(); ++it)
+  {
+    if (it->announcer == announcer)
+    {
+      statistics = *it;
+      return true;
+    }
+  }
+  return false;
+}
+
+TEST(TestAnnouncementManager, QueuedAnnouncerIsCalledOnAnotherThread)
+{
+  CTestAnnouncer announcer;
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer);
+
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnTest");
+  ASSERT_TRUE(announcer.WaitForMessages(1));
+  EXPECT_EQ("OnTest", announcer.GetMessages().front());
+  EXPECT_NE(CThread::GetCurrentThreadId(), announcer.GetThreadId());
+
+  CAnnouncementManager::GetInstance().RemoveAnnouncer(&announcer);
+}
+
+TEST(TestAnnouncementManager, SynchronousAnnouncerIsCalledImmediately)
+{
+  CTestAnnouncer announcer;
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer, true);
+
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnTest");
+  ASSERT_EQ(1U, announcer.GetMessages().size());
+  EXPECT_EQ(CThread::GetCurrentThreadId(), announcer.GetThreadId());
+
+  CAnnouncementManager::GetInstance().RemoveAnnouncer(&announcer);
+}
+
+TEST(TestAnnouncementManager, CoalescesVolumeChanges)
+{
+  CTestAnnouncer announcer;
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer);
+
+  announcer.BlockNext();
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnBlock");
+  ASSERT_TRUE(announcer.WaitUntilBlocking());
+
+  for (int volume = 1; volume <= 10; volume++)
+  {
+    CVariant data(CVariant::VariantTypeObject);
+    data["volume"] = volume;
+    CAnnouncementManager::GetInstance().Announce(Application, "test", "OnVolumeChanged", data);
+  }
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnTest");
+
+  announcer.Release();
+  ASSERT_TRUE(announcer.WaitForMessages(3));
+
+  std::vector<std::string> messages = announcer.GetMessages();
+  ASSERT_EQ(3U, messages.size());
+  EXPECT_EQ("OnBlock", messages[0]);
+  EXPECT_EQ("OnVolumeChanged", messages[1]);
+  EXPECT_EQ("OnTest", messages[2]);
+  EXPECT_EQ(10, announcer.GetData()[1]["volume"].asInteger());
+
+  AnnouncerStatistics statistics;
+  ASSERT_TRUE(GetStatistics(&announcer, statistics));
+  EXPECT_EQ(9U, statistics.coalesced);
+  EXPECT_EQ(0U, statistics.dropped);
+  EXPECT_EQ(3U, statistics.dispatched);
+
+  CAnnouncementManager::GetInstance().RemoveAnnouncer(&announcer);
+}
+
+TEST(TestAnnouncementManager, DoesNotCoalesceUpdatesOfDifferentItems)
+{
+  CTestAnnouncer announcer;
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer);
+
+  announcer.BlockNext();
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnBlock");
+  ASSERT_TRUE(announcer.WaitUntilBlocking());
+
+  for (int id = 1; id <= 3; id++)
+  {
+    CVariant data(CVariant::VariantTypeObject);
+    data["item"]["type"] = "movie";
+    data["item"]["id"] = id;
+    CAnnouncementManager::GetInstance().Announce(VideoLibrary, "test", "OnUpdate", data);
+    CAnnouncementManager::GetInstance().Announce(VideoLibrary, "test", "OnUpdate", data);
+  }
+
+  announcer.Release();
+  ASSERT_TRUE(announcer.WaitForMessages(4));
+
+  AnnouncerStatistics statistics;
+  ASSERT_TRUE(GetStatistics(&announcer, statistics));
+  EXPECT_EQ(3U, statistics.coalesced);
+  EXPECT_EQ(4U, announcer.GetMessages().size());
+
+  CAnnouncementManager::GetInstance().RemoveAnnouncer(&announcer);
+}
+
+TEST(TestAnnouncementManager, DropsOldestAnnouncementsOfSlowAnnouncer)
+{
+  CTestAnnouncer announcer;
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer);
+
+  announcer.BlockNext();
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnBlock");
+  ASSERT_TRUE(announcer.WaitUntilBlocking());
+
+  const unsigned int overflow = 10;
+  for (unsigned int i = 0; i < CAnnouncementManager::MaxQueuedAnnouncements + overflow; i++)
+    CAnnouncementManager::GetInstance().Announce(Other, "test", i < overflow ? "OnDropped" : "OnTest");
+
+  AnnouncerStatistics statistics;
+  ASSERT_TRUE(GetStatistics(&announcer, statistics));
+  EXPECT_EQ(CAnnouncementManager::MaxQueuedAnnouncements, statistics.queued);
+  EXPECT_EQ(CAnnouncementManager::MaxQueuedAnnouncements, statistics.peakQueued);
+  EXPECT_EQ(overflow, statistics.dropped);
+
+  announcer.Release();
+  ASSERT_TRUE(announcer.WaitForMessages(CAnnouncementManager::MaxQueuedAnnouncements + 1));
+
+  std::vector<std::string> messages = announcer.GetMessages();
+  for (std::vector<std::string>::const_iterator it = messages.begin(); it != messages.end(); ++it)
+    EXPECT_NE("OnDropped", *it);
+
+  CAnnouncementManager::GetInstance().RemoveAnnouncer(&announcer);
+}
+
+TEST(TestAnnouncementManager, RemovedAnnouncerIsNotCalled)
+{
+  CTestAnnouncer announcer;
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer);
+
+  announcer.BlockNext();
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnBlock");
+  ASSERT_TRUE(announcer.WaitUntilBlocking());
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnTest");
+
+  // removing the announcer waits for the announcement being handled
+  CRemoveAnnouncerThread remover(announcer);
+  remover.Create();
+
+  AnnouncerStatistics statistics;
+  XbmcThreads::EndTime timeout(WAIT_TIMEOUT_MS);
+  while (GetStatistics(&announcer, statistics) && !timeout.IsTimePast())
+    XbmcThreads::ThreadSleep(1);
+  EXPECT_FALSE(remover.WaitForThreadExit(10));
+
+  announcer.Release();
+  ASSERT_TRUE(remover.WaitForThreadExit(WAIT_TIMEOUT_MS));
+
+  std::vector<std::string> messages = announcer.GetMessages();
+  ASSERT_EQ(1U, messages.size());
+  EXPECT_EQ("OnBlock", messages.front());
+}
+
+TEST(TestAnnouncementManager, CoalescedUpdateKeepsPlaycount)
+{
+  CTestAnnouncer announcer;
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer);
+
+  announcer.BlockNext();
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnBlock");
+  ASSERT_TRUE(announcer.WaitUntilBlocking());
+
+  CVariant watched(CVariant::VariantTypeObject);
+  watched["item"]["type"] = "movie";
+  watched["item"]["id"] = 1;
+  watched["playcount"] = 1;
+  CAnnouncementManager::GetInstance().Announce(VideoLibrary, "test", "OnUpdate", watched);
+
+  CVariant updated(CVariant::VariantTypeObject);
+  updated["item"]["type"] = "movie";
+  updated["item"]["id"] = 1;
+  CAnnouncementManager::GetInstance().Announce(VideoLibrary, "test", "OnUpdate", updated);
+
+  announcer.Release();
+  ASSERT_TRUE(announcer.WaitForMessages(2));
+
+  std::vector<CVariant> data = announcer.GetData();
+  ASSERT_EQ(2U, data.size());
+  EXPECT_EQ(1, data[1]["item"]["id"].asInteger());
+  EXPECT_EQ(1, data[1]["playcount"].asInteger());
+
+  CAnnouncementManager::GetInstance().RemoveAnnouncer(&announcer);
+}
+
+TEST(TestAnnouncementManager, OnQuitIsDispatchedImmediately)
+{
+  CTestAnnouncer announcer;
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer);
+
+  announcer.BlockNext();
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnBlock");
+  ASSERT_TRUE(announcer.WaitUntilBlocking());
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnTest");
+  announcer.Release();
+
+  // pending announcements are delivered first, OnQuit before Announce() returns
+  CAnnouncementManager::GetInstance().Announce(System, "test", "OnQuit");
+
+  std::vector<std::string> messages = announcer.GetMessages();
+  ASSERT_EQ(3U, messages.size());
+  EXPECT_EQ("OnBlock", messages[0]);
+  EXPECT_EQ("OnTest", messages[1]);
+  EXPECT_EQ("OnQuit", messages[2]);
+  EXPECT_EQ(CThread::GetCurrentThreadId(), announcer.GetThreadId());
+
+  CAnnouncementManager::GetInstance().RemoveAnnouncer(&announcer);
+}
+
+TEST(TestAnnouncementManager, DeinitializeDeliversPendingAnnouncements)
+{
+  CTestAnnouncer announcer;
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer);
+
+  announcer.BlockNext();
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnBlock");
+  ASSERT_TRUE(announcer.WaitUntilBlocking());
+  for (int i = 0; i < 3; i++)
+    CAnnouncementManager::GetInstance().Announce(Other, "test", "OnTest");
+  announcer.Release();
+
+  CAnnouncementManager::GetInstance().Deinitialize();
+  EXPECT_EQ(4U, announcer.GetMessages().size());
+
+  AnnouncerStatistics statistics;
+  EXPECT_FALSE(GetStatistics(&announcer, statistics));
+}
+
+TEST(TestAnnouncementManager, AnnouncerCanWaitForRemovalOfAnother)
+{
+  CTestAnnouncer other;
+  CRemovingAnnouncer announcer(other);
+  CAnnouncementManager::GetInstance().AddAnnouncer(&other);
+  CAnnouncementManager::GetInstance().AddAnnouncer(&announcer);
+
+  CAnnouncementManager::GetInstance().Announce(Other, "test", "OnTest");
+  ASSERT_TRUE(announcer.WaitUntilDone());
+  EXPECT_TRUE(announcer.HasRemoved());
+
+  AnnouncerStatistics statistics;
+  EXPECT_FALSE(GetStatistics(&other, statistics));
+
+  CAnnouncementManager::GetInstance().RemoveAnnouncer(&announcer);
+}
@@ -192,6 +192,8 @@ void CMusicDatabase::CreateTables()
 
   CLog::Log(LOGINFO, "create cue table");
   m_pDS->exec("CREATE TABLE cue (idPath integer, strFileName text, strCuesheet text)");
+
+  CreateChangelogTable();
 }
 
 void CMusicDatabase::CreateAnalytics()
@@ -244,22 +246,36 @@ void CMusicDatabase::CreateAnalytics()
               "  DELETE FROM album_genre WHERE album_genre.idAlbum = old.idAlbum;"
               "  DELETE FROM albuminfosong WHERE albuminfosong.idAlbumInfo=old.idAlbum;"
               "  DELETE FROM art WHERE media_id=old.idAlbum AND media_type='album';"
+              "  INSERT INTO changelog (media_id, media_type, changeType) VALUES (old.idAlbum, 'album', 'removed');"
               " END");
   m_pDS->exec("CREATE TRIGGER tgrDeleteArtist AFTER delete ON artist FOR EACH ROW BEGIN"
               "  DELETE FROM album_artist WHERE album_artist.idArtist = old.idArtist;"
               "  DELETE FROM song_artist WHERE song_artist.idArtist = old.idArtist;"
               "  DELETE FROM discography WHERE discography.idArtist = old.idArtist;"
               "  DELETE FROM art WHERE media_id=old.idArtist AND media_type='artist';"
+              "  INSERT INTO changelog (media_id, media_type, changeType) VALUES (old.idArtist, 'artist', 'removed');"
               " END");
   m_pDS->exec("CREATE TRIGGER tgrDeleteSong AFTER delete ON song FOR EACH ROW BEGIN"
               "  DELETE FROM song_artist WHERE song_artist.idSong = old.idSong;"
               "  DELETE FROM song_genre WHERE song_genre.idSong = old.idSong;"
               "  DELETE FROM art WHERE media_id=old.idSong AND media_type='song';"
+              "  INSERT INTO changelog (media_id, media_type, changeType) VALUES (old.idSong, 'song', 'removed');"
               " END");
   m_pDS->exec("CREATE TRIGGER tgrDeletePath AFTER delete ON path FOR EACH ROW BEGIN"
               "  DELETE FROM cue WHERE cue.idPath = old.idPath;"
               " END");
 
+  // changes of the items and their artwork are logged to determine the library revision
+  CreateChangelogTriggers("album", "idAlbum", MediaTypeAlbum);
+  CreateChangelogTriggers("artist", "idArtist", MediaTypeArtist);
+  CreateChangelogTriggers("song", "idSong", MediaTypeSong);
+  m_pDS->exec("CREATE TRIGGER tgrChangelogArtInsert AFTER insert ON art FOR EACH ROW BEGIN"
+              "  INSERT INTO changelog (media_id, media_type, changeType) VALUES (new.media_id, new.media_type, 'changed');"
+              " END");
+  m_pDS->exec("CREATE TRIGGER tgrChangelogArtUpdate AFTER update ON art FOR EACH ROW BEGIN"
+              "  INSERT INTO changelog (media_id, media_type, changeType) VALUES (new.media_id, new.media_type, 'changed');"
+              " END");
+
   // we create views last to ensure all indexes are rolled in
   CreateViews();
 }
@@ -3037,6 +3053,8 @@ int CMusicDatabase::Cleanup(bool bShowProgress /* = true */)
     ret = ERROR_REORG_ROLE;
     goto error;
   }
+  CleanChangelog();
+
   // commit transaction
   if (pDlgProgress)
   {
@@ -4660,11 +4678,13 @@ void CMusicDatabase::UpdateTables(int version)
                 " albumID integer default 0,"
                 " dateAdded varchar (20) default NULL)");
   }
+  if (version < 61)
+    CreateChangelogTable();
 }
 
 int CMusicDatabase::GetSchemaVersion() const
 {
-  return 60;
+  return 61;
 }
 
 unsigned int CMusicDatabase::GetSongIDs(const Filter &filter, std::vector<std::pair<int,int> > &songIDs)
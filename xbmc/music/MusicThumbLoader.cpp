@@ -198,7 +198,7 @@ bool CMusicThumbLoader::FillLibraryArt(CFileItem &item)
     m_musicDatabase->Open();
     std::map<std::string, std::string> artwork;
     if (m_musicDatabase->GetArtForItem(tag.GetDatabaseId(), tag.GetType(), artwork))
-      item.SetArt(artwork);
+      item.SetArt(CGUIListItem::ArtMap(artwork));
     else if (tag.GetType() == MediaTypeSong)
     { // no art for the song, try the album
       ArtCache::const_iterator i = m_albumArt.find(tag.GetAlbumId());
@@ -209,7 +209,7 @@ bool CMusicThumbLoader::FillLibraryArt(CFileItem &item)
       }
       if (i != m_albumArt.end())
       {
-        item.AppendArt(i->second, MediaTypeAlbum);
+        item.AppendArt(CGUIListItem::ArtMap(i->second), MediaTypeAlbum);
         for (std::map<std::string, std::string>::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
           item.SetArtFallback(j->first, "album." + j->first);
       }
@@ -241,6 +241,7 @@ void CMusicInfoScanner::Process()
       }
     }
 
+    m_musicDatabase.CleanChangelog();
   }
   catch (...)
   {
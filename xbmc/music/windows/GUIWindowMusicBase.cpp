@@ -1333,17 +1333,17 @@ bool CGUIWindowMusicBase::GetDirectory(const std::string &strDirectory, CFileIte
     {
       std::map<std::string, std::string> artistArt;
       if (m_musicdatabase.GetArtistArtForItem(params.GetAlbumId(), MediaTypeAlbum, artistArt))
-        items.AppendArt(artistArt, MediaTypeArtist);
+        items.AppendArt(CGUIListItem::ArtMap(artistArt), MediaTypeArtist);
 
       std::map<std::string, std::string> albumArt;
       if (m_musicdatabase.GetArtForItem(params.GetAlbumId(), MediaTypeAlbum, albumArt))
-        items.AppendArt(albumArt, MediaTypeAlbum);
+        items.AppendArt(CGUIListItem::ArtMap(albumArt), MediaTypeAlbum);
     }
     if (params.GetArtistId() > 0)
     {
       std::map<std::string, std::string> artistArt;
       if (m_musicdatabase.GetArtForItem(params.GetArtistId(), "artist", artistArt))
-        items.AppendArt(artistArt, MediaTypeArtist);
+        items.AppendArt(CGUIListItem::ArtMap(artistArt), MediaTypeArtist);
     }
 
     // add in the "New Playlist" item if we're in the playlists folder
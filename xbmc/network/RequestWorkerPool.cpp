@@ -0,0 +1,139 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RequestWorkerPool.h"
+
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+
+CRequestWorkerPool::CWorker::CWorker(CRequestWorkerPool &pool, const std::string &name)
+  : CThread(name.c_str()),
+    m_pool(pool)
+{
+}
+
+void CRequestWorkerPool::CWorker::Process()
+{
+  Task task;
+  while (m_pool.GetTask(task))
+  {
+    task();
+    task = nullptr;
+  }
+}
+
+CRequestWorkerPool::CRequestWorkerPool(const std::string &name, unsigned int maxQueued)
+  : m_name(name),
+    m_workerCount(0),
+    m_maxQueued(maxQueued),
+    m_running(false),
+    m_executed(0),
+    m_rejected(0),
+    m_peakQueued(0)
+{
+}
+
+CRequestWorkerPool::~CRequestWorkerPool()
+{
+  Stop();
+}
+
+void CRequestWorkerPool::Start(unsigned int workers)
+{
+  CSingleLock lock(m_critSection);
+  if (m_running)
+    return;
+
+  m_running = true;
+  m_workerCount = workers > 0 ? workers : 1;
+  m_executed = 0;
+  m_rejected = 0;
+  m_peakQueued = 0;
+  for (unsigned int i = 0; i < m_workerCount; i++)
+  {
+    CWorker *worker = new CWorker(*this, StringUtils::Format("%s-%u", m_name.c_str(), i));
+    worker->Create();
+    m_workers.push_back(worker);
+  }
+}
+
+void CRequestWorkerPool::Stop()
+{
+  std::vector<CWorker*> workers;
+  {
+    CSingleLock lock(m_critSection);
+    if (!m_running)
+      return;
+
+    // the workers run what is left in the queue before they exit
+    m_running = false;
+    workers.swap(m_workers);
+    m_taskAvailable.notifyAll();
+  }
+
+  for (std::vector<CWorker*>::iterator it = workers.begin(); it != workers.end(); ++it)
+  {
+    (*it)->StopThread(true);
+    delete *it;
+  }
+
+  CSingleLock lock(m_critSection);
+  CLog::Log(LOGDEBUG, "CRequestWorkerPool[%s]: %u requests handled by %u workers, %u rejected, at most %u queued",
+            m_name.c_str(), m_executed, m_workerCount, m_rejected, m_peakQueued);
+}
+
+bool CRequestWorkerPool::IsRunning() const
+{
+  CSingleLock lock(m_critSection);
+  return m_running;
+}
+
+bool CRequestWorkerPool::Submit(const Task &task)
+{
+  CSingleLock lock(m_critSection);
+  if (!m_running || m_tasks.size() >= m_maxQueued)
+  {
+    m_rejected++;
+    return false;
+  }
+
+  m_tasks.push_back(task);
+  if (m_tasks.size() > m_peakQueued)
+    m_peakQueued = m_tasks.size();
+  m_taskAvailable.notify();
+  return true;
+}
+
+bool CRequestWorkerPool::GetTask(Task &task)
+{
+  CSingleLock lock(m_critSection);
+  while (m_tasks.empty())
+  {
+    if (!m_running)
+      return false;
+    m_taskAvailable.wait(lock);
+  }
+
+  task = m_tasks.front();
+  m_tasks.pop_front();
+  m_executed++;
+  return true;
+}
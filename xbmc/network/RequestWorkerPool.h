@@ -0,0 +1,102 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+/*!
+ \brief Fixed set of threads running requests handed over by a network server.
+
+ Unlike CJobManager the number of threads doesn't grow with the load and the
+ workers aren't shared with other subsystems, so a burst of slow requests
+ can't delay thumbnail extraction or library jobs and vice versa. The queue is
+ bounded, Submit() fails once it is full so the server can answer with an
+ error instead of piling up work.
+ */
+class CRequestWorkerPool
+{
+public:
+  typedef std::function<void()> Task;
+
+  /*!
+   \param name name of the worker threads.
+   \param maxQueued maximum number of tasks waiting for a worker.
+   */
+  CRequestWorkerPool(const std::string &name, unsigned int maxQueued);
+  ~CRequestWorkerPool();
+
+  /*!
+   \brief Start the given number of worker threads.
+   */
+  void Start(unsigned int workers);
+
+  /*!
+   \brief Run the remaining queued tasks and stop the workers.
+   */
+  void Stop();
+
+  bool IsRunning() const;
+
+  /*!
+   \brief Queue a task for one of the workers.
+   \return false if the pool isn't running or the queue is full, the task
+   won't be run in that case.
+   */
+  bool Submit(const Task &task);
+
+  unsigned int GetWorkerCount() const { return m_workerCount; }
+
+private:
+  CRequestWorkerPool(const CRequestWorkerPool&);
+  CRequestWorkerPool& operator=(const CRequestWorkerPool&);
+
+  class CWorker : public CThread
+  {
+  public:
+    CWorker(CRequestWorkerPool &pool, const std::string &name);
+  protected:
+    virtual void Process();
+  private:
+    CRequestWorkerPool &m_pool;
+  };
+
+  bool GetTask(Task &task);
+
+  std::string m_name;
+  unsigned int m_workerCount;
+  unsigned int m_maxQueued;
+
+  CCriticalSection m_critSection;
+  XbmcThreads::ConditionVariable m_taskAvailable;
+  std::deque<Task> m_tasks;
+  std::vector<CWorker*> m_workers;
+  bool m_running;
+
+  unsigned int m_executed;
+  unsigned int m_rejected;
+  unsigned int m_peakQueued;
+};
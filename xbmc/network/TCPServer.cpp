@@ -24,8 +24,11 @@
 #include <memory.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <algorithm>
+#include <functional>
 
 #include "settings/AdvancedSettings.h"
+#include "utils/CPUInfo.h"
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "interfaces/AnnouncementManager.h"
 #include "utils/log.h"
@@ -56,7 +59,20 @@ static const bdaddr_t bt_bdaddr_local = {{0, 0, 0, 0xff, 0xff, 0xff}};
 using namespace JSONRPC;
 using namespace ANNOUNCEMENT;
 
-#define RECEIVEBUFFER 1024
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+#include <sys/epoll.h>
+#define TCPSERVER_USE_EPOLL
+#endif
+
+// report connections closed by the client as send errors instead of raising SIGPIPE
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define RECEIVEBUFFER 16384
+#define MAX_EPOLL_EVENTS 64
+#define MAX_QUEUED_REQUESTS 1024
+#define MAX_REQUEST_WORKERS 8
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
@@ -95,11 +111,14 @@ bool CTCPServer::IsRunning()
   return ((CThread*)ServerInstance)->IsRunning();
 }
 
-CTCPServer::CTCPServer(int port, bool nonlocal) : CThread("TCPServer")
+CTCPServer::CTCPServer(int port, bool nonlocal)
+  : CThread("TCPServer"),
+    m_workerPool("TCPServerWorker", MAX_QUEUED_REQUESTS)
 {
   m_port = port;
   m_nonlocal = nonlocal;
   m_sdpd = NULL;
+  m_epoll = -1;
 }
 
 void CTCPServer::Process()
@@ -108,110 +127,230 @@ void CTCPServer::Process()
 
   while (!m_bStop)
   {
-    SOCKET          max_fd = 0;
-    fd_set          rfds;
-    struct timeval  to     = {1, 0};
-    FD_ZERO(&rfds);
+    std::vector<SOCKET> readable;
+    if (!WaitForSockets(readable, 1000))
+    {
+      CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
+      Sleep(1000);
+      Initialize();
+      continue;
+    }
+
+    for (std::vector<SOCKET>::const_iterator socket = readable.begin(); socket != readable.end(); ++socket)
+    {
+      if (std::find(m_servers.begin(), m_servers.end(), *socket) == m_servers.end())
+        ReadConnection(*socket);
+      else if (!AcceptConnection(*socket))
+      {
+        Sleep(1000);
+        Initialize();
+        break;
+      }
+    }
+  }
+
+  Deinitialize();
+}
+
+bool CTCPServer::WaitForSockets(std::vector<SOCKET> &readable, int timeoutMs)
+{
+#ifdef TCPSERVER_USE_EPOLL
+  struct epoll_event events[MAX_EPOLL_EVENTS];
+  int res = epoll_wait(m_epoll, events, MAX_EPOLL_EVENTS, timeoutMs);
+  if (res < 0)
+    return errno == EINTR;
+
+  for (int i = 0; i < res; i++)
+    readable.push_back(events[i].data.fd);
+
+  return true;
+#else
+  SOCKET          max_fd = 0;
+  fd_set          rfds;
+  struct timeval  to     = {timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+  FD_ZERO(&rfds);
+
+  for (std::vector<SOCKET>::iterator it = m_servers.begin(); it != m_servers.end(); ++it)
+  {
+    FD_SET(*it, &rfds);
+    if ((intptr_t)*it > (intptr_t)max_fd)
+      max_fd = *it;
+  }
+
+  for (std::map<SOCKET, CTCPClientPtr>::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+  {
+    FD_SET(it->first, &rfds);
+    if ((intptr_t)it->first > (intptr_t)max_fd)
+      max_fd = it->first;
+  }
+
+  int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
+  if (res < 0)
+    return false;
+
+  if (res > 0)
+  {
+    for (std::map<SOCKET, CTCPClientPtr>::iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+    {
+      if (FD_ISSET(it->first, &rfds))
+        readable.push_back(it->first);
+    }
 
     for (std::vector<SOCKET>::iterator it = m_servers.begin(); it != m_servers.end(); ++it)
     {
-      FD_SET(*it, &rfds);
-      if ((intptr_t)*it > (intptr_t)max_fd)
-        max_fd = *it;
+      if (FD_ISSET(*it, &rfds))
+        readable.push_back(*it);
     }
+  }
+
+  return true;
+#endif
+}
+
+void CTCPServer::AddSocket(SOCKET socket)
+{
+#ifdef TCPSERVER_USE_EPOLL
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = socket;
+  if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, socket, &event) < 0)
+    CLog::Log(LOGERROR, "JSONRPC Server: Failed to watch socket %d: %d", (int)socket, errno);
+#endif
+}
+
+void CTCPServer::RemoveSocket(SOCKET socket)
+{
+#ifdef TCPSERVER_USE_EPOLL
+  struct epoll_event event = {};
+  epoll_ctl(m_epoll, EPOLL_CTL_DEL, socket, &event);
+#endif
+}
+
+bool CTCPServer::AcceptConnection(SOCKET server)
+{
+  CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
+  CTCPClientPtr newconnection(new CTCPClient());
+  newconnection->m_socket = accept(server, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
+
+  if (newconnection->m_socket == INVALID_SOCKET)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: %d", errno);
+    return EBADF != errno;
+  }
 
-    for (unsigned int i = 0; i < m_connections.size(); i++)
+  CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
+  {
+    CSingleLock lock(m_connectionsSection);
+    m_connections[newconnection->m_socket] = newconnection;
+  }
+  AddSocket(newconnection->m_socket);
+
+  return true;
+}
+
+void CTCPServer::ReadConnection(SOCKET socket)
+{
+  std::map<SOCKET, CTCPClientPtr>::iterator it = m_connections.find(socket);
+  if (it == m_connections.end())
+    return;
+
+  CTCPClientPtr client = it->second;
+  char buffer[RECEIVEBUFFER];
+  int nread = recv(socket, buffer, RECEIVEBUFFER, 0);
+  bool close = false;
+  if (nread > 0)
+  {
+    std::string response;
+    if (client->IsNew())
     {
-      FD_SET(m_connections[i]->m_socket, &rfds);
-      if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
-        max_fd = m_connections[i]->m_socket;
+      CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
+
+      if (!response.empty())
+        client->Send(response.c_str(), response.size());
+
+      if (websocket != NULL)
+      {
+        // Replace the CTCPClient with a CWebSocketClient
+        CTCPClientPtr websocketClient(new CWebSocketClient(websocket, *client));
+        CSingleLock lock(m_connectionsSection);
+        it->second = websocketClient;
+        client = websocketClient;
+      }
     }
 
-    int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
-    if (res < 0)
+    if (response.size() <= 0)
+      client->PushBuffer(this, buffer, nread);
+
+    close = client->Closing();
+  }
+  else
+    close = true;
+
+  if (close)
+  {
+    CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+    RemoveSocket(socket);
     {
-      CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
-      Sleep(1000);
-      Initialize();
+      CSingleLock lock(m_connectionsSection);
+      m_connections.erase(it);
     }
-    else if (res > 0)
+    // requests of the client still being executed keep it alive, their
+    // responses are dropped once the socket is closed
+    client->Disconnect();
+  }
+}
+
+void CTCPServer::QueueRequest(CTCPClient *client, const std::string &request)
+{
+  CTCPClientPtr connection = client->shared_from_this();
+  {
+    CSingleLock lock(connection->m_requestSection);
+    connection->m_requests.push_back(request);
+
+    // a worker is already busy with this client and will pick the request up
+    if (connection->m_executing)
+      return;
+    connection->m_executing = true;
+  }
+
+  // run the request on the I/O thread if the workers can't keep up
+  if (!m_workerPool.Submit(std::bind(&CTCPServer::ExecuteRequests, this, connection)))
+    ExecuteRequests(connection);
+}
+
+void CTCPServer::ExecuteRequests(CTCPClientPtr client)
+{
+  while (true)
+  {
+    std::string request;
     {
-      for (int i = m_connections.size() - 1; i >= 0; i--)
+      CSingleLock lock(client->m_requestSection);
+      if (client->m_requests.empty())
       {
-        int socket = m_connections[i]->m_socket;
-        if (FD_ISSET(socket, &rfds))
-        {
-          char buffer[RECEIVEBUFFER] = {};
-          int  nread = 0;
-          nread = recv(socket, (char*)&buffer, RECEIVEBUFFER, 0);
-          bool close = false;
-          if (nread > 0)
-          {
-            std::string response;
-            if (m_connections[i]->IsNew())
-            {
-              CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
-
-              if (!response.empty())
-                m_connections[i]->Send(response.c_str(), response.size());
-
-              if (websocket != NULL)
-              {
-                // Replace the CTCPClient with a CWebSocketClient
-                CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *(m_connections[i]));
-                delete m_connections[i];
-                m_connections.erase(m_connections.begin() + i);
-                m_connections.insert(m_connections.begin() + i, websocketClient);
-              }
-            }
-
-            if (response.size() <= 0)
-              m_connections[i]->PushBuffer(this, buffer, nread);
-
-            close = m_connections[i]->Closing();
-          }
-          else
-            close = true;
-
-          if (close)
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
-            m_connections[i]->Disconnect();
-            delete m_connections[i];
-            m_connections.erase(m_connections.begin() + i);
-          }
-        }
+        client->m_executing = false;
+        return;
       }
+      request.swap(client->m_requests.front());
+      client->m_requests.pop_front();
+    }
+
+    std::string response = CJSONRPC::MethodCall(request, this, client.get());
+    if (!response.empty())
+      client->Send(response.c_str(), response.size());
 
-      for (std::vector<SOCKET>::iterator it = m_servers.begin(); it != m_servers.end(); ++it)
+    {
+      CSingleLock lock(client->m_requestSection);
+      if (client->m_requests.empty())
       {
-        if (FD_ISSET(*it, &rfds))
-        {
-          CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
-          CTCPClient *newconnection = new CTCPClient();
-          newconnection->m_socket = accept(*it, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
-
-          if (newconnection->m_socket == INVALID_SOCKET)
-          {
-            CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: %d", errno);
-            if (EBADF == errno)
-            {
-              Sleep(1000);
-              Initialize();
-              break;
-            }
-          }
-          else
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
-            m_connections.push_back(newconnection);
-          }
-        }
+        client->m_executing = false;
+        return;
       }
     }
-  }
 
-  Deinitialize();
+    // give the other clients a turn before running the next pipelined request
+    if (m_workerPool.Submit(std::bind(&CTCPServer::ExecuteRequests, this, client)))
+      return;
+  }
 }
 
 bool CTCPServer::PrepareDownload(const char *path, CVariant &details, std::string &protocol)
@@ -233,15 +372,22 @@ void CTCPServer::Announce(AnnouncementFlag flag, const char *sender, const char
 {
   std::string str = IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, g_advancedSettings.m_jsonOutputCompact);
 
-  for (unsigned int i = 0; i < m_connections.size(); i++)
+  std::vector<CTCPClientPtr> connections;
+  {
+    CSingleLock lock(m_connectionsSection);
+    for (std::map<SOCKET, CTCPClientPtr>::const_iterator it = m_connections.begin(); it != m_connections.end(); ++it)
+      connections.push_back(it->second);
+  }
+
+  for (std::vector<CTCPClientPtr>::const_iterator it = connections.begin(); it != connections.end(); ++it)
   {
     {
-      CSingleLock lock (m_connections[i]->m_critSection);
-      if ((m_connections[i]->GetAnnouncementFlags() & flag) == 0)
+      CSingleLock lock ((*it)->m_critSection);
+      if (((*it)->GetAnnouncementFlags() & flag) == 0)
         continue;
     }
 
-    m_connections[i]->Send(str.c_str(), str.size());
+    (*it)->Send(str.c_str(), str.size());
   }
 }
 
@@ -256,6 +402,20 @@ bool CTCPServer::Initialize()
 
   if (started)
   {
+#ifdef TCPSERVER_USE_EPOLL
+    m_epoll = epoll_create(1);
+    if (m_epoll < 0)
+    {
+      CLog::Log(LOGERROR, "JSONRPC Server: Failed to create epoll instance: %d", errno);
+      Deinitialize();
+      return false;
+    }
+#endif
+    for (std::vector<SOCKET>::const_iterator it = m_servers.begin(); it != m_servers.end(); ++it)
+      AddSocket(*it);
+
+    m_workerPool.Start(std::max(2, std::min(g_cpuInfo.getCPUCount(), MAX_REQUEST_WORKERS)));
+
     CAnnouncementManager::GetInstance().AddAnnouncer(this);
     CLog::Log(LOGINFO, "JSONRPC Server: Successfully initialized");
     return true;
@@ -450,7 +610,8 @@ bool CTCPServer::InitializeTCP()
 
   Deinitialize();
 
-  if ((fd = CreateTCPServerSocket(m_port, !m_nonlocal, 10, "JSONRPC")) == INVALID_SOCKET)
+  // a burst of clients connecting at once shouldn't have their SYNs dropped
+  if ((fd = CreateTCPServerSocket(m_port, !m_nonlocal, SOMAXCONN, "JSONRPC")) == INVALID_SOCKET)
     return false;
 
   m_servers.push_back(fd);
@@ -459,19 +620,29 @@ bool CTCPServer::InitializeTCP()
 
 void CTCPServer::Deinitialize()
 {
-  for (unsigned int i = 0; i < m_connections.size(); i++)
+  // let the workers finish the requests already received
+  m_workerPool.Stop();
+
+  std::map<SOCKET, CTCPClientPtr> connections;
   {
-    m_connections[i]->Disconnect();
-    delete m_connections[i];
+    CSingleLock lock(m_connectionsSection);
+    connections.swap(m_connections);
   }
 
-  m_connections.clear();
+  for (std::map<SOCKET, CTCPClientPtr>::iterator it = connections.begin(); it != connections.end(); ++it)
+    it->second->Disconnect();
 
   for (unsigned int i = 0; i < m_servers.size(); i++)
     closesocket(m_servers[i]);
 
   m_servers.clear();
 
+#ifdef TCPSERVER_USE_EPOLL
+  if (m_epoll >= 0)
+    close(m_epoll);
+  m_epoll = -1;
+#endif
+
 #ifdef HAVE_LIBBLUETOOTH
   if (m_sdpd)
     sdp_close((sdp_session_t*)m_sdpd);
@@ -490,6 +661,7 @@ CTCPServer::CTCPClient::CTCPClient()
   m_endBrackets = 0;
   m_beginChar = 0;
   m_endChar = 0;
+  m_executing = false;
 
   m_addrlen = sizeof(m_cliaddr);
 }
@@ -527,7 +699,11 @@ void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
   do
   {
     CSingleLock lock (m_critSection);
-    sent += send(m_socket, data + sent, size - sent, 0);
+    int ret = send(m_socket, data + sent, size - sent, MSG_NOSIGNAL);
+    // the client went away, possibly while a worker was still executing its request
+    if (ret <= 0)
+      break;
+    sent += ret;
   } while (sent < size);
 }
 
@@ -559,8 +735,7 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
         m_endBrackets++;
       if (m_beginBrackets > 0 && m_endBrackets > 0 && m_beginBrackets == m_endBrackets)
       {
-        std::string line = CJSONRPC::MethodCall(m_buffer, host, this);
-        Send(line.c_str(), line.size());
+        host->QueueRequest(this, m_buffer);
         m_beginChar = m_beginBrackets = m_endBrackets = 0;
         m_buffer.clear();
       }
@@ -570,9 +745,9 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
 
 void CTCPServer::CTCPClient::Disconnect()
 {
+  CSingleLock lock (m_critSection);
   if (m_socket > 0)
   {
-    CSingleLock lock (m_critSection);
     shutdown(m_socket, SHUT_RDWR);
     closesocket(m_socket);
     m_socket = INVALID_SOCKET;
@@ -626,6 +801,9 @@ CTCPServer::CWebSocketClient& CTCPServer::CWebSocketClient::operator=(const CWeb
 
 void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
 {
+  // responses and announcements are sent from different threads, keep the
+  // frames of a message together
+  CSingleLock lock(m_critSection);
   const CWebSocketMessage *msg = m_websocket->Send(WebSocketTextFrame, data, size);
   if (msg == NULL || !msg->IsComplete())
     return;
@@ -667,6 +845,7 @@ void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buff
 
 void CTCPServer::CWebSocketClient::Disconnect()
 {
+  CSingleLock lock (m_critSection);
   if (m_socket > 0)
   {
     if (m_websocket->GetState() != WebSocketStateClosed && m_websocket->GetState() != WebSocketStateNotConnected)
@@ -19,6 +19,10 @@
  *
  */
 
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 #include <sys/socket.h>
 
@@ -26,6 +30,7 @@
 #include "interfaces/json-rpc/IClient.h"
 #include "interfaces/json-rpc/IJSONRPCAnnouncer.h"
 #include "interfaces/json-rpc/ITransportLayer.h"
+#include "network/RequestWorkerPool.h"
 #include "threads/CriticalSection.h"
 #include "threads/Thread.h"
 #include "websocket/WebSocket.h"
@@ -55,7 +60,13 @@ namespace JSONRPC
     bool InitializeTCP();
     void Deinitialize();
 
-    class CTCPClient : public IClient
+    bool WaitForSockets(std::vector<SOCKET> &readable, int timeoutMs);
+    void AddSocket(SOCKET socket);
+    void RemoveSocket(SOCKET socket);
+    bool AcceptConnection(SOCKET server);
+    void ReadConnection(SOCKET socket);
+
+    class CTCPClient : public IClient, public std::enable_shared_from_this<CTCPClient>
     {
     public:
       CTCPClient();
@@ -81,6 +92,11 @@ namespace JSONRPC
       socklen_t        m_addrlen;
       CCriticalSection m_critSection;
 
+      // complete requests waiting to be executed, in the order they were received
+      std::deque<std::string> m_requests;
+      bool             m_executing;
+      CCriticalSection m_requestSection;
+
     protected:
       void Copy(const CTCPClient& client);
     private:
@@ -111,11 +127,26 @@ namespace JSONRPC
       CWebSocket *m_websocket;
     };
 
-    std::vector<CTCPClient*> m_connections;
+    typedef std::shared_ptr<CTCPClient> CTCPClientPtr;
+
+    /*!
+     \brief Queue a complete request received from a client.
+
+     Requests are executed on the worker pool so a slow method doesn't hold
+     up other clients. Requests of the same client are executed one after
+     another so the responses are sent in the order of the requests.
+     */
+    void QueueRequest(CTCPClient *client, const std::string &request);
+    void ExecuteRequests(CTCPClientPtr client);
+
+    std::map<SOCKET, CTCPClientPtr> m_connections;
+    CCriticalSection m_connectionsSection;
     std::vector<SOCKET> m_servers;
     int m_port;
     bool m_nonlocal;
     void* m_sdpd;
+    int m_epoll; ///< epoll instance used to wait for the sockets (Linux only)
+    CRequestWorkerPool m_workerPool;
 
     static CTCPServer *ServerInstance;
   };
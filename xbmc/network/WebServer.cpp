@@ -25,10 +25,20 @@
 #include "WebServer.h"
 
 #ifdef HAS_WEB_SERVER
+#ifndef TARGET_WINDOWS
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "filesystem/File.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
@@ -37,6 +47,7 @@
 #include "URL.h"
 #include "Util.h"
 #include "utils/Base64.h"
+#include "utils/CPUInfo.h"
 #include "utils/log.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
@@ -56,6 +67,28 @@
 
 #define MAX_POST_BUFFER_SIZE 2048
 
+#if (MHD_VERSION >= 0x00095200)
+// requests are read and answered by a few I/O threads (epoll based on Linux),
+// request handlers that may block run on a separate pool of workers while the
+// connection is suspended
+#define WEBSERVER_ASYNC_HANDLERS
+#endif
+
+#if !defined(TARGET_WINDOWS) && (MHD_VERSION >= 0x00094400)
+// local files are handed to libmicrohttpd as file descriptors so it can use sendfile()
+#define WEBSERVER_USE_SENDFILE
+#endif
+
+// block sizes for file responses read through the VFS
+#define WEBSERVER_MIN_BLOCK_SIZE      4096
+#define WEBSERVER_LOCAL_BLOCK_SIZE    (64 * 1024)
+#define WEBSERVER_REMOTE_BLOCK_SIZE   (256 * 1024)
+#define WEBSERVER_MAX_BLOCK_SIZE      (1024 * 1024)
+
+#define WEBSERVER_IO_THREADS    4
+#define WEBSERVER_MAX_WORKERS   8
+#define WEBSERVER_MAX_QUEUED    256
+
 #define PAGE_FILE_NOT_FOUND "<html><head><title>File not found</title></head><body>File not found</body></html>"
 #define NOT_SUPPORTED       "<html><head><title>Not Supported</title></head><body>The method you are trying to use is not supported by this server</body></html>"
 
@@ -70,6 +103,12 @@ typedef struct ConnectionHandler
   std::shared_ptr<IHTTPRequestHandler> requestHandler;
   struct MHD_PostProcessor *postprocessor;
   int errorStatus;
+  // response created by PrepareRequest()/PrepareResponse() and not queued yet
+  struct MHD_Response *response;
+  int responseStatus;
+  bool finalizeResponse;
+  // the request is being handled on a worker thread and the connection is suspended
+  bool asyncPending;
 
   ConnectionHandler(const std::string& uri)
     : fullUri(uri)
@@ -77,6 +116,10 @@ typedef struct ConnectionHandler
     , postprocessor(nullptr)
     , requestHandler(nullptr)
     , errorStatus(MHD_HTTP_OK)
+    , response(nullptr)
+    , responseStatus(MHD_HTTP_OK)
+    , finalizeResponse(false)
+    , asyncPending(false)
   { }
 } ConnectionHandler;
 
@@ -90,6 +133,21 @@ typedef struct {
   bool boundaryWritten;
   std::string contentType;
   uint64_t writePosition;
+  uint64_t totalLength;
+  // with a worker pool the file is read ahead by the workers and the I/O
+  // thread only passes on data that is already buffered
+  CRequestWorkerPool *workerPool;
+  struct MHD_Connection *connection;
+  size_t blockSize;
+  CCriticalSection dataLock;
+  std::vector<char> data;      // block being sent
+  size_t dataOffset;
+  std::vector<char> nextData;  // block read ahead
+  uint64_t readLength;         // number of bytes read ahead so far
+  bool reading;
+  bool readFailed;
+  bool suspended;
+  bool released;
 } HttpFileDownloadContext;
 
 std::vector<IHTTPRequestHandler *> CWebServer::m_requestHandlers;
@@ -99,8 +157,8 @@ CWebServer::CWebServer()
     m_daemon_ip4(nullptr),
     m_running(false),
     m_needcredentials(false),
-    m_Credentials64Encoded("eGJtYzp4Ym1j") // xbmc:xbmc
-
+    m_Credentials64Encoded("eGJtYzp4Ym1j"), // xbmc:xbmc
+    m_workerPool("WebServerWorker", WEBSERVER_MAX_QUEUED)
 { }
 
 HTTPMethod CWebServer::GetMethod(const char *method)
@@ -241,109 +299,30 @@ int CWebServer::AnswerToConnection(void *cls, struct MHD_Connection *connection,
   }
 #endif
 
+  // the request has been handled on a worker thread and the connection was resumed
+  if (conHandler->asyncPending)
+  {
+    conHandler->asyncPending = false;
+    return SendPreparedResponse(connection, *conHandler);
+  }
+
   if (!IsAuthenticated(server, connection)) 
     return AskForAuthentication(connection);
 
   // check if this is the first call to AnswerToConnection for this request
   if (isNewRequest)
   {
-    // parse the Range header and store it in the request object
-    CHttpRanges ranges;
-    bool ranged = ranges.Parse(GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_RANGE));
-
     // look for a IHTTPRequestHandler which can take care of the current request
     for (std::vector<IHTTPRequestHandler *>::const_iterator it = m_requestHandlers.begin(); it != m_requestHandlers.end(); ++it)
     {
       IHTTPRequestHandler *requestHandler = *it;
       if (requestHandler->CanHandleRequest(request))
       {
-        // we found a matching IHTTPRequestHandler so let's get a new instance for this request
-        std::shared_ptr<IHTTPRequestHandler> handler(requestHandler->Create(request));
-
-        // if we got a GET request we need to check if it should be cached
-        if (methodType == GET)
-        {
-          if (handler->CanBeCached())
-          {
-            bool cacheable = true;
-
-            // handle Cache-Control
-            std::string cacheControl = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_CACHE_CONTROL);
-            if (!cacheControl.empty())
-            {
-              std::vector<std::string> cacheControls = StringUtils::Split(cacheControl, ",");
-              for (std::vector<std::string>::const_iterator it = cacheControls.begin(); it != cacheControls.end(); ++it)
-              {
-                std::string control = *it;
-                control = StringUtils::Trim(control);
-
-                // handle no-cache
-                if (control.compare(HEADER_VALUE_NO_CACHE) == 0)
-                  cacheable = false;
-              }
-            }
-
-            if (cacheable)
-            {
-              // handle Pragma (but only if "Cache-Control: no-cache" hasn't been set)
-              std::string pragma = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_PRAGMA);
-              if (pragma.compare(HEADER_VALUE_NO_CACHE) == 0)
-                cacheable = false;
-            }
-
-            CDateTime lastModified;
-            if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
-            {
-              // handle If-Modified-Since or If-Unmodified-Since
-              std::string ifModifiedSince = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
-              std::string ifUnmodifiedSince = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_UNMODIFIED_SINCE);
-
-              CDateTime ifModifiedSinceDate;
-              CDateTime ifUnmodifiedSinceDate;
-              // handle If-Modified-Since (but only if the response is cacheable)
-              if (cacheable &&
-                ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
-                lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
-              {
-                struct MHD_Response *response = MHD_create_response_from_data(0, nullptr, MHD_NO, MHD_NO);
-                if (response == nullptr)
-                {
-                  CLog::Log(LOGERROR, "CWebServer: failed to create a HTTP 304 response");
-                  return MHD_NO;
-                }
-
-                return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
-              }
-              // handle If-Unmodified-Since
-              else if (ifUnmodifiedSinceDate.SetFromRFC1123DateTime(ifUnmodifiedSince) &&
-                lastModified.GetAsUTCDateTime() > ifUnmodifiedSinceDate)
-                return SendErrorResponse(connection, MHD_HTTP_PRECONDITION_FAILED, methodType);
-            }
-
-            // handle If-Range header but only if the Range header is present
-            if (ranged && lastModified.IsValid())
-            {
-              std::string ifRange = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_RANGE);
-              if (!ifRange.empty() && lastModified.IsValid())
-              {
-                CDateTime ifRangeDate;
-                ifRangeDate.SetFromRFC1123DateTime(ifRange);
-
-                // check if the last modification is newer than the If-Range date
-                // if so we have to server the whole file instead
-                if (lastModified.GetAsUTCDateTime() > ifRangeDate)
-                  ranges.Clear();
-              }
-            }
-
-            // pass the requested ranges on to the request handler
-            handler->SetRequestRanged(!ranges.IsEmpty());
-          }
-        }
         // if we got a POST request we need to take care of the POST data
-        else if (methodType == POST)
+        if (methodType == POST)
         {
-          conHandler->requestHandler = handler;
+          // we found a matching IHTTPRequestHandler so let's get a new instance for this request
+          conHandler->requestHandler.reset(requestHandler->Create(request));
 
           // get the content-type of the POST data
           std::string contentType = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_CONTENT_TYPE);
@@ -372,7 +351,21 @@ int CWebServer::AnswerToConnection(void *cls, struct MHD_Connection *connection,
           return MHD_YES;
         }
 
-        return HandleRequest(handler);
+        // creating the request handler may already access the filesystem so
+        // everything up to the response is done on a worker thread if possible
+        if (requestHandler->CanHandleAsynchronously())
+        {
+          ConnectionHandler *pendingHandler = conHandler.get();
+          if (server->HandleAsynchronously(connection, *pendingHandler,
+                                           [requestHandler, request, pendingHandler]() { PrepareRequest(requestHandler, request, *pendingHandler); }))
+          {
+            *con_cls = conHandler.release();
+            return MHD_YES;
+          }
+        }
+
+        PrepareRequest(requestHandler, request, *conHandler);
+        return SendPreparedResponse(connection, *conHandler);
       }
     }
   }
@@ -423,13 +416,28 @@ int CWebServer::AnswerToConnection(void *cls, struct MHD_Connection *connection,
       else
       {
         if (conHandler->postprocessor != nullptr)
+        {
           MHD_destroy_post_processor(conHandler->postprocessor);
+          conHandler->postprocessor = nullptr;
+        }
 
         // check if something went wrong while handling the POST data
         if (conHandler->errorStatus != MHD_HTTP_OK)
           return SendErrorResponse(connection, conHandler->errorStatus, methodType);
 
-        return HandleRequest(conHandler->requestHandler);
+        if (conHandler->requestHandler->CanHandleAsynchronously())
+        {
+          ConnectionHandler *pendingHandler = conHandler.get();
+          if (server->HandleAsynchronously(connection, *pendingHandler,
+                                           [pendingHandler]() { PrepareResponse(*pendingHandler); }))
+          {
+            *con_cls = conHandler.release();
+            return MHD_YES;
+          }
+        }
+
+        PrepareResponse(*conHandler);
+        return SendPreparedResponse(connection, *conHandler);
       }
     }
     // it's unusual to get more than one call to AnswerToConnection for none-POST requests, but let's handle it anyway
@@ -439,7 +447,11 @@ int CWebServer::AnswerToConnection(void *cls, struct MHD_Connection *connection,
       {
         IHTTPRequestHandler *requestHandler = *it;
         if (requestHandler->CanHandleRequest(request))
-          return HandleRequest(std::shared_ptr<IHTTPRequestHandler>(requestHandler->Create(request)));
+        {
+          conHandler->requestHandler.reset(requestHandler->Create(request));
+          PrepareResponse(*conHandler);
+          return SendPreparedResponse(connection, *conHandler);
+        }
       }
     }
   }
@@ -473,17 +485,133 @@ int CWebServer::HandlePostField(void *cls, enum MHD_ValueKind kind, const char *
   return MHD_YES;
 }
 
-int CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>& handler)
+void CWebServer::PrepareRequest(IHTTPRequestHandler *requestHandler, const HTTPRequest &request, ConnectionHandler &conHandler)
+{
+  struct MHD_Connection *connection = request.connection;
+
+  // parse the Range header and store it in the request object
+  CHttpRanges ranges;
+  bool ranged = ranges.Parse(GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_RANGE));
+
+  // we found a matching IHTTPRequestHandler so let's get a new instance for this request
+  std::shared_ptr<IHTTPRequestHandler> handler(requestHandler->Create(request));
+  conHandler.requestHandler = handler;
+
+  // if we got a GET request we need to check if it should be cached
+  if (request.method == GET)
+  {
+    if (handler->CanBeCached())
+    {
+      bool cacheable = true;
+
+      // handle Cache-Control
+      std::string cacheControl = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_CACHE_CONTROL);
+      if (!cacheControl.empty())
+      {
+        std::vector<std::string> cacheControls = StringUtils::Split(cacheControl, ",");
+        for (std::vector<std::string>::const_iterator it = cacheControls.begin(); it != cacheControls.end(); ++it)
+        {
+          std::string control = *it;
+          control = StringUtils::Trim(control);
+
+          // handle no-cache
+          if (control.compare(HEADER_VALUE_NO_CACHE) == 0)
+            cacheable = false;
+        }
+      }
+
+      if (cacheable)
+      {
+        // handle Pragma (but only if "Cache-Control: no-cache" hasn't been set)
+        std::string pragma = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_PRAGMA);
+        if (pragma.compare(HEADER_VALUE_NO_CACHE) == 0)
+          cacheable = false;
+      }
+
+      // handle If-None-Match (but only if the response is cacheable)
+      // if present it takes precedence over If-Modified-Since
+      bool ignoreIfModifiedSince = false;
+      std::string etag;
+      if (cacheable && handler->GetETag(etag) && !etag.empty())
+      {
+        std::string ifNoneMatch = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_NONE_MATCH);
+        if (!ifNoneMatch.empty())
+        {
+          if (MatchesETag(ifNoneMatch, etag))
+          {
+            PrepareNotModifiedResponse(conHandler);
+            return;
+          }
+
+          ignoreIfModifiedSince = true;
+        }
+      }
+
+      CDateTime lastModified;
+      if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
+      {
+        // handle If-Modified-Since or If-Unmodified-Since
+        std::string ifModifiedSince = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
+        std::string ifUnmodifiedSince = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_UNMODIFIED_SINCE);
+
+        CDateTime ifModifiedSinceDate;
+        CDateTime ifUnmodifiedSinceDate;
+        // handle If-Modified-Since (but only if the response is cacheable)
+        if (cacheable && !ignoreIfModifiedSince &&
+          ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
+          lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
+        {
+          PrepareNotModifiedResponse(conHandler);
+          return;
+        }
+        // handle If-Unmodified-Since
+        else if (ifUnmodifiedSinceDate.SetFromRFC1123DateTime(ifUnmodifiedSince) &&
+          lastModified.GetAsUTCDateTime() > ifUnmodifiedSinceDate)
+        {
+          PrepareErrorResponse(conHandler, MHD_HTTP_PRECONDITION_FAILED);
+          return;
+        }
+      }
+
+      // handle If-Range header but only if the Range header is present
+      if (ranged && lastModified.IsValid())
+      {
+        std::string ifRange = GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_RANGE);
+        if (!ifRange.empty() && lastModified.IsValid())
+        {
+          CDateTime ifRangeDate;
+          ifRangeDate.SetFromRFC1123DateTime(ifRange);
+
+          // check if the last modification is newer than the If-Range date
+          // if so we have to server the whole file instead
+          if (lastModified.GetAsUTCDateTime() > ifRangeDate)
+            ranges.Clear();
+        }
+      }
+
+      // pass the requested ranges on to the request handler
+      handler->SetRequestRanged(!ranges.IsEmpty());
+    }
+  }
+
+  PrepareResponse(conHandler);
+}
+
+void CWebServer::PrepareResponse(ConnectionHandler &conHandler)
 {
+  const std::shared_ptr<IHTTPRequestHandler> &handler = conHandler.requestHandler;
+  conHandler.response = nullptr;
+  conHandler.finalizeResponse = false;
   if (handler == nullptr)
-    return MHD_NO;
+    return;
 
   HTTPRequest request = handler->GetRequest();
   int ret = handler->HandleRequest();
   if (ret == MHD_NO)
   {
     CLog::Log(LOGERROR, "CWebServer: failed to handle HTTP request for %s", request.pathUrl.c_str());
-    return SendErrorResponse(request.connection, MHD_HTTP_INTERNAL_SERVER_ERROR, request.method);
+    PrepareErrorResponse(conHandler, MHD_HTTP_INTERNAL_SERVER_ERROR);
+    return;
   }
 
   const HTTPResponseDetails &responseDetails = handler->GetResponseDetails();
@@ -492,7 +620,7 @@ int CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>& handle
   {
     case HTTPNone:
       CLog::Log(LOGERROR, "CWebServer: HTTP request handler didn't process %s", request.pathUrl.c_str());
-      return MHD_NO;
+      return;
 
     case HTTPRedirect:
       ret = CreateRedirect(request.connection, handler->GetRedirectUrl(), response);
@@ -515,16 +643,104 @@ int CWebServer::HandleRequest(const std::shared_ptr<IHTTPRequestHandler>& handle
 
     default:
       CLog::Log(LOGERROR, "CWebServer: internal error while HTTP request handler processed %s", request.pathUrl.c_str());
-      return SendErrorResponse(request.connection, MHD_HTTP_INTERNAL_SERVER_ERROR, request.method);
+      PrepareErrorResponse(conHandler, MHD_HTTP_INTERNAL_SERVER_ERROR);
+      return;
   }
 
   if (ret == MHD_NO)
   {
     CLog::Log(LOGERROR, "CWebServer: failed to create HTTP response for %s", request.pathUrl.c_str());
-    return SendErrorResponse(request.connection, MHD_HTTP_INTERNAL_SERVER_ERROR, request.method);
+    PrepareErrorResponse(conHandler, MHD_HTTP_INTERNAL_SERVER_ERROR);
+    return;
   }
 
-  return FinalizeRequest(handler, responseDetails.status, response);
+  conHandler.response = response;
+  conHandler.responseStatus = responseDetails.status;
+  conHandler.finalizeResponse = true;
+}
+
+void CWebServer::PrepareNotModifiedResponse(ConnectionHandler &conHandler)
+{
+  conHandler.response = MHD_create_response_from_data(0, nullptr, MHD_NO, MHD_NO);
+  if (conHandler.response == nullptr)
+    CLog::Log(LOGERROR, "CWebServer: failed to create a HTTP 304 response");
+
+  conHandler.responseStatus = MHD_HTTP_NOT_MODIFIED;
+  conHandler.finalizeResponse = true;
+}
+
+bool CWebServer::MatchesETag(const std::string &condition, const std::string &etag)
+{
+  std::vector<std::string> etags = StringUtils::Split(condition, ",");
+  for (std::vector<std::string>::iterator it = etags.begin(); it != etags.end(); ++it)
+  {
+    std::string candidate = StringUtils::Trim(*it);
+    if (candidate == "*")
+      return true;
+
+    // If-None-Match uses the weak comparison so ignore the W/ prefix
+    if (StringUtils::StartsWith(candidate, "W/"))
+      candidate.erase(0, 2);
+
+    if (candidate == etag)
+      return true;
+  }
+
+  return false;
+}
+
+void CWebServer::PrepareErrorResponse(ConnectionHandler &conHandler, int errorType)
+{
+  const HTTPRequest &request = conHandler.requestHandler->GetRequest();
+
+  conHandler.response = nullptr;
+  conHandler.responseStatus = errorType;
+  conHandler.finalizeResponse = false;
+  CreateErrorResponse(request.connection, errorType, request.method, conHandler.response);
+}
+
+int CWebServer::SendPreparedResponse(struct MHD_Connection *connection, ConnectionHandler &conHandler)
+{
+  struct MHD_Response *response = conHandler.response;
+  conHandler.response = nullptr;
+  if (response == nullptr)
+    return MHD_NO;
+
+  if (conHandler.finalizeResponse)
+    return FinalizeRequest(conHandler.requestHandler, conHandler.responseStatus, response);
+
+#ifdef WEBSERVER_DEBUG
+  CLog::Log(LOGDEBUG, "webserver [OUT] HTTP %d", conHandler.responseStatus);
+#endif
+
+  int ret = MHD_queue_response(connection, conHandler.responseStatus, response);
+  MHD_destroy_response(response);
+
+  return ret;
+}
+
+bool CWebServer::HandleAsynchronously(struct MHD_Connection *connection, ConnectionHandler &conHandler, const std::function<void()> &prepare)
+{
+#ifdef WEBSERVER_ASYNC_HANDLERS
+  if (!m_workerPool.IsRunning())
+    return false;
+
+  // suspend first so the worker can't resume the connection before it is suspended.
+  // libmicrohttpd calls AnswerToConnection() again once it has been resumed.
+  conHandler.asyncPending = true;
+  MHD_suspend_connection(connection);
+
+  if (!m_workerPool.Submit([connection, prepare]() { prepare(); MHD_resume_connection(connection); }))
+  {
+    // all workers are busy and the queue is full, handle the request on this thread
+    prepare();
+    MHD_resume_connection(connection);
+  }
+
+  return true;
+#else
+  return false;
+#endif
 }
 
 int CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& handler, int responseStatus, struct MHD_Response *response)
@@ -544,6 +760,11 @@ int CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& hand
   if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
     handler->AddResponseHeader(MHD_HTTP_HEADER_LAST_MODIFIED, lastModified.GetAsRFC1123DateTime());
 
+  // if the request handler has set an entity tag and it hasn't been set as a header, add it
+  std::string etag;
+  if (handler->CanBeCached() && handler->GetETag(etag) && !etag.empty())
+    handler->AddResponseHeader(MHD_HTTP_HEADER_ETAG, etag);
+
   // check if the request handler has set Cache-Control and add it if not
   if (!handler->HasResponseHeader(MHD_HTTP_HEADER_CACHE_CONTROL))
   {
@@ -766,19 +987,27 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
 
   const HTTPRequest &request = handler->GetRequest();
   const HTTPResponseDetails &responseDetails = handler->GetResponseDetails();
-  HttpResponseRanges responseRanges = handler->GetResponseData();
 
-  std::shared_ptr<XFILE::CFile> file = std::make_shared<XFILE::CFile>();
+  std::shared_ptr<XFILE::CFile> file;
   std::string filePath = handler->GetResponseFile();
+  uint64_t fileLength = 0;
 
-  if (!file->Open(filePath, READ_NO_CACHE))
+  // local files are passed on to libmicrohttpd as a file descriptor, everything else is read through the VFS
+  int fd = OpenLocalFile(filePath, fileLength);
+  if (fd < 0)
   {
-    CLog::Log(LOGERROR, "WebServer: Failed to open %s", filePath.c_str());
-    return SendErrorResponse(request.connection, MHD_HTTP_NOT_FOUND, request.method);
+    file = std::make_shared<XFILE::CFile>();
+    if (!file->Open(filePath, READ_NO_CACHE))
+    {
+      CLog::Log(LOGERROR, "WebServer: Failed to open %s", filePath.c_str());
+      handler->SetResponseStatus(MHD_HTTP_NOT_FOUND);
+      return CreateErrorResponse(request.connection, MHD_HTTP_NOT_FOUND, request.method, response);
+    }
+
+    fileLength = static_cast<uint64_t>(file->GetLength());
   }
 
   bool ranged = false;
-  uint64_t fileLength = static_cast<uint64_t>(file->GetLength());
 
   // get the MIME type for the Content-Type header
   std::string mimeType = responseDetails.contentType;
@@ -789,28 +1018,32 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
     mimeType = CreateMimeTypeFromExtension(ext.c_str());
   }
 
-  if (request.method != HEAD)
+  if (request.method != HEAD && fileLength > 0)
   {
     uint64_t totalLength = 0;
-    std::unique_ptr<HttpFileDownloadContext> context(new HttpFileDownloadContext());
-    context->file = file;
-    context->contentType = mimeType;
-    context->boundaryWritten = false;
-    context->writePosition = 0;
+    CHttpRanges ranges;
 
     if (handler->IsRequestRanged())
     {
       if (!request.ranges.IsEmpty())
-        context->ranges = request.ranges;
-      else
-        GetRequestedRanges(request.connection, fileLength, context->ranges);
+        ranges = request.ranges;
+      // none of the requested ranges lies within the file
+      else if (!GetRequestedRanges(request.connection, fileLength, ranges))
+      {
+        if (fd >= 0)
+          close(fd);
+
+        handler->SetResponseStatus(MHD_HTTP_REQUESTED_RANGE_NOT_SATISFIABLE);
+        handler->AddResponseHeader(MHD_HTTP_HEADER_CONTENT_RANGE, StringUtils::Format("bytes */%" PRIu64, fileLength));
+        return CreateErrorResponse(request.connection, MHD_HTTP_REQUESTED_RANGE_NOT_SATISFIABLE, request.method, response);
+      }
     }
 
     uint64_t firstPosition = 0;
     uint64_t lastPosition = 0;
     // if there are no ranges, add the whole range
-    if (context->ranges.IsEmpty())
-      context->ranges.Add(CHttpRange(0, fileLength - 1));
+    if (ranges.IsEmpty())
+      ranges.Add(CHttpRange(0, fileLength - 1));
     else
     {
       handler->SetResponseStatus(MHD_HTTP_PARTIAL_CONTENT);
@@ -818,56 +1051,112 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
       // we need to remember that we are ranged because the range length might change and won't be reliable anymore for length comparisons
       ranged = true;
 
-      context->ranges.GetFirstPosition(firstPosition);
-      context->ranges.GetLastPosition(lastPosition);
+      ranges.GetFirstPosition(firstPosition);
+      ranges.GetLastPosition(lastPosition);
     }
 
-    // remember the total number of ranges
-    context->rangeCountTotal = context->ranges.Size();
-    // remember the total length
-    totalLength = context->ranges.GetLength();
-
-    // adjust the MIME type and range length in case of multiple ranges which requires multipart boundaries
-    if (context->rangeCountTotal > 1)
+#ifdef WEBSERVER_USE_SENDFILE
+    // a single range of a local file is sent straight from the file descriptor without passing through our buffers
+    if (fd >= 0 && ranges.Size() == 1)
     {
-      context->boundary = HttpRangeUtils::GenerateMultipartBoundary();
-      mimeType = HttpRangeUtils::GenerateMultipartBoundaryContentType(context->boundary);
+      response = MHD_create_response_from_fd_at_offset64(ranges.GetLength(), fd, firstPosition);
+      if (response == nullptr)
+      {
+        close(fd);
+        CLog::Log(LOGERROR, "CWebServer: failed to create a HTTP response for %s to be sent from %s", request.pathUrl.c_str(), filePath.c_str());
+        return MHD_NO;
+      }
+    }
+    else
+#endif
+    {
+      // multipart responses need our boundaries between the ranges so they are read through the VFS
+      if (fd >= 0)
+      {
+        close(fd);
+        fd = -1;
 
-      // build part of the boundary with the optional Content-Type header
-      // "--<boundary>\r\nContent-Type: <content-type>\r\n
-      context->boundaryWithHeader = HttpRangeUtils::GenerateMultipartBoundaryWithHeader(context->boundary, context->contentType);
-      context->boundaryEnd = HttpRangeUtils::GenerateMultipartBoundaryEnd(context->boundary);
+        file = std::make_shared<XFILE::CFile>();
+        if (!file->Open(filePath, READ_NO_CACHE))
+        {
+          CLog::Log(LOGERROR, "WebServer: Failed to open %s", filePath.c_str());
+          handler->SetResponseStatus(MHD_HTTP_NOT_FOUND);
+          return CreateErrorResponse(request.connection, MHD_HTTP_NOT_FOUND, request.method, response);
+        }
+      }
 
-      // for every range, we need to add a boundary with header
-      for (HttpRanges::const_iterator range = context->ranges.Begin(); range != context->ranges.End(); ++range)
+      std::unique_ptr<HttpFileDownloadContext> context(new HttpFileDownloadContext());
+      context->file = file;
+      context->ranges = ranges;
+      context->contentType = mimeType;
+      context->boundaryWritten = false;
+      context->writePosition = 0;
+      context->workerPool = nullptr;
+      context->connection = nullptr;
+      context->dataOffset = 0;
+      context->readLength = 0;
+      context->reading = false;
+      context->readFailed = false;
+      context->suspended = false;
+      context->released = false;
+
+      // remember the total number of ranges
+      context->rangeCountTotal = context->ranges.Size();
+      // remember the total length
+      totalLength = context->ranges.GetLength();
+
+      // adjust the MIME type and range length in case of multiple ranges which requires multipart boundaries
+      if (context->rangeCountTotal > 1)
       {
-        // we need to temporarily add the Content-Range header to the boundary to be able to determine the length
-        std::string completeBoundaryWithHeader = HttpRangeUtils::GenerateMultipartBoundaryWithHeader(context->boundaryWithHeader, &*range);
-        totalLength += completeBoundaryWithHeader.size();
+        context->boundary = HttpRangeUtils::GenerateMultipartBoundary();
+        mimeType = HttpRangeUtils::GenerateMultipartBoundaryContentType(context->boundary);
 
-        // add a newline before any new multipart boundary
-        if (range != context->ranges.Begin())
-          totalLength += strlen(HEADER_NEWLINE);
+        // build part of the boundary with the optional Content-Type header
+        // "--<boundary>\r\nContent-Type: <content-type>\r\n
+        context->boundaryWithHeader = HttpRangeUtils::GenerateMultipartBoundaryWithHeader(context->boundary, context->contentType);
+        context->boundaryEnd = HttpRangeUtils::GenerateMultipartBoundaryEnd(context->boundary);
+
+        // for every range, we need to add a boundary with header
+        for (HttpRanges::const_iterator range = context->ranges.Begin(); range != context->ranges.End(); ++range)
+        {
+          // we need to temporarily add the Content-Range header to the boundary to be able to determine the length
+          std::string completeBoundaryWithHeader = HttpRangeUtils::GenerateMultipartBoundaryWithHeader(context->boundaryWithHeader, &*range);
+          totalLength += completeBoundaryWithHeader.size();
+
+          // add a newline before any new multipart boundary
+          if (range != context->ranges.Begin())
+            totalLength += strlen(HEADER_NEWLINE);
+        }
+        // and at the very end a special end-boundary "\r\n--<boundary>--"
+        totalLength += context->boundaryEnd.size();
       }
-      // and at the very end a special end-boundary "\r\n--<boundary>--"
-      totalLength += context->boundaryEnd.size();
-    }
 
-    // set the initial write position
-    context->ranges.GetFirstPosition(context->writePosition);
+      // set the initial write position
+      context->ranges.GetFirstPosition(context->writePosition);
 
-    // create the response object
-    response = MHD_create_response_from_callback(totalLength, 2048,
-                                                  &CWebServer::ContentReaderCallback,
-                                                  context.get(),
-                                                  &CWebServer::ContentReaderFreeCallback);
-    if (response == nullptr)
-    {
-      CLog::Log(LOGERROR, "CWebServer: failed to create a HTTP response for %s to be filled from %s", request.pathUrl.c_str(), filePath.c_str());
-      return MHD_NO;
-    }
+      context->totalLength = totalLength;
+#ifdef WEBSERVER_ASYNC_HANDLERS
+      if (request.webserver != nullptr && request.webserver->m_workerPool.IsRunning())
+      {
+        context->workerPool = &request.webserver->m_workerPool;
+        context->connection = request.connection;
+      }
+#endif
+      context->blockSize = GetDownloadBlockSize(*file, filePath, totalLength, context->workerPool != nullptr);
+
+      // create the response object
+      response = MHD_create_response_from_callback(totalLength, context->blockSize,
+                                                    &CWebServer::ContentReaderCallback,
+                                                    context.get(),
+                                                    &CWebServer::ContentReaderFreeCallback);
+      if (response == nullptr)
+      {
+        CLog::Log(LOGERROR, "CWebServer: failed to create a HTTP response for %s to be filled from %s", request.pathUrl.c_str(), filePath.c_str());
+        return MHD_NO;
+      }
 
-    context.release(); // ownership was passed to mhd
+      context.release(); // ownership was passed to mhd
+    }
 
     // add Content-Range header
     if (ranged)
@@ -875,6 +1164,9 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
   }
   else
   {
+    if (fd >= 0)
+      close(fd);
+
     response = MHD_create_response_from_data(0, nullptr, MHD_NO, MHD_NO);
     if (response == nullptr)
     {
@@ -892,6 +1184,59 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
   return MHD_YES;
 }
 
+int CWebServer::OpenLocalFile(const std::string &path, uint64_t &length)
+{
+#ifdef WEBSERVER_USE_SENDFILE
+  // paths with a protocol (including special://) are left to the VFS
+  if (!CURL(path).GetProtocol().empty())
+    return -1;
+
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return -1;
+
+  struct stat statBuffer;
+  if (fstat(fd, &statBuffer) != 0 || !S_ISREG(statBuffer.st_mode))
+  {
+    close(fd);
+    return -1;
+  }
+
+  length = static_cast<uint64_t>(statBuffer.st_size);
+  return fd;
+#else
+  return -1;
+#endif
+}
+
+size_t CWebServer::GetDownloadBlockSize(XFILE::CFile &file, const std::string &path, uint64_t totalLength, bool readAhead)
+{
+  // every block is one callback and one read from the file, reads from
+  // network filesystems are expensive so they get larger blocks
+  size_t blockSize = WEBSERVER_LOCAL_BLOCK_SIZE;
+  size_t maxBlockSize = WEBSERVER_LOCAL_BLOCK_SIZE;
+
+  // large reads would hold up all other connections of the I/O thread, they
+  // are only used when the workers read ahead
+  if (readAhead)
+  {
+    if (URIUtils::IsRemote(path))
+      blockSize = WEBSERVER_REMOTE_BLOCK_SIZE;
+    maxBlockSize = WEBSERVER_MAX_BLOCK_SIZE;
+  }
+
+  // follow the read size preferred by the filesystem
+  int chunkSize = file.GetChunkSize();
+  if (chunkSize > 0)
+    blockSize = std::min(std::max(blockSize, static_cast<size_t>(chunkSize)), maxBlockSize);
+
+  // no need for a buffer larger than the response but leave room for multipart boundaries
+  if (totalLength < blockSize)
+    blockSize = std::max(static_cast<size_t>(totalLength), static_cast<size_t>(WEBSERVER_MIN_BLOCK_SIZE));
+
+  return blockSize;
+}
+
 int CWebServer::CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response)
 {
   size_t payloadSize = 0;
@@ -967,28 +1312,15 @@ void* CWebServer::UriRequestLogger(void *cls, const char *uri)
   return new ConnectionHandler(uri);
 }
 
-#if (MHD_VERSION >= 0x00090200)
-ssize_t CWebServer::ContentReaderCallback(void *cls, uint64_t pos, char *buf, size_t max)
-#elif (MHD_VERSION >= 0x00040001)
-int CWebServer::ContentReaderCallback(void *cls, uint64_t pos, char *buf, int max)
-#else   //libmicrohttpd < 0.4.0
-int CWebServer::ContentReaderCallback(void *cls, size_t pos, char *buf, int max)
-#endif
+// fills buf with the next part of the response, returns 0 if the next multipart boundary doesn't fit
+static ssize_t ReadContent(HttpFileDownloadContext *context, char *buf, size_t max)
 {
-  HttpFileDownloadContext *context = (HttpFileDownloadContext *)cls;
-  if (context == nullptr || context->file == nullptr)
-    return -1;
-
-#ifdef WEBSERVER_DEBUG
-  CLog::Log(LOGDEBUG, "webserver [OUT] write maximum %d bytes from %" PRIu64 " (%" PRIu64 ")", max, context->writePosition, pos);
-#endif
-
   // check if we need to add the end-boundary
   if (context->rangeCountTotal > 1 && context->ranges.IsEmpty())
   {
     // put together the end-boundary
     std::string endBoundary = HttpRangeUtils::GenerateMultipartBoundaryEnd(context->boundary);
-    if ((unsigned int)max != endBoundary.size())
+    if (max != endBoundary.size())
       return -1;
 
     // copy the boundary into the buffer
@@ -1007,19 +1339,26 @@ int CWebServer::ContentReaderCallback(void *cls, size_t pos, char *buf, int max)
 
   if (context->rangeCountTotal > 1 && !context->boundaryWritten)
   {
+    // put together the boundary for the current range
+    std::string boundary = HttpRangeUtils::GenerateMultipartBoundaryWithHeader(context->boundaryWithHeader, &range);
+
     // add a newline before any new multipart boundary
+    size_t newlineLength = 0;
     if (context->rangeCountTotal > context->ranges.Size())
+      newlineLength = strlen(HEADER_NEWLINE);
+
+    // the boundary and at least one byte of the range must fit
+    if (maximum <= newlineLength + boundary.size())
+      return 0;
+
+    if (newlineLength > 0)
     {
-      size_t newlineLength = strlen(HEADER_NEWLINE);
       memcpy(buf, HEADER_NEWLINE, newlineLength);
       buf += newlineLength;
       written += newlineLength;
       maximum -= newlineLength;
     }
 
-    // put together the boundary for the current range
-    std::string boundary = HttpRangeUtils::GenerateMultipartBoundaryWithHeader(context->boundaryWithHeader, &range);
-
     // copy the boundary into the buffer
     memcpy(buf, boundary.c_str(), boundary.size());
     // advance the buffer position
@@ -1066,9 +1405,141 @@ int CWebServer::ContentReaderCallback(void *cls, size_t pos, char *buf, int max)
   return written;
 }
 
+#ifdef WEBSERVER_ASYNC_HANDLERS
+// runs on a worker thread and reads the next block of the response while the
+// I/O thread is sending the previous one
+static void ReadAhead(HttpFileDownloadContext *context)
+{
+  // the file, the ranges and the boundaries are only used by the one reading
+  std::vector<char> data(static_cast<size_t>(std::min(static_cast<uint64_t>(context->blockSize), context->totalLength - context->readLength)));
+  size_t length = 0;
+  while (length < data.size())
+  {
+    ssize_t res = ReadContent(context, &data[length], data.size() - length);
+    if (res <= 0)
+      break;
+    length += res;
+  }
+  data.resize(length);
+
+  bool release;
+  {
+    CSingleLock lock(context->dataLock);
+    context->nextData.swap(data);
+    context->readLength += length;
+    context->readFailed = length == 0;
+    context->reading = false;
+    release = context->released;
+
+    if (context->suspended)
+    {
+      context->suspended = false;
+      MHD_resume_connection(context->connection);
+    }
+  }
+
+  // the response has been destroyed while we were reading
+  if (release)
+    delete context;
+}
+
+// called with dataLock held
+static void StartReadAhead(HttpFileDownloadContext *context)
+{
+  context->reading = true;
+  if (!context->workerPool->Submit([context]() { ReadAhead(context); }))
+  {
+    // all workers are busy and the queue is full, read on this thread
+    ReadAhead(context);
+  }
+}
+
+// passes on data read by the workers, suspends the connection until the next block is available
+static ssize_t SendReadAheadData(HttpFileDownloadContext *context, char *buf, size_t max)
+{
+  CSingleLock lock(context->dataLock);
+  while (true)
+  {
+    if (context->dataOffset < context->data.size())
+    {
+      size_t length = std::min(max, context->data.size() - context->dataOffset);
+      memcpy(buf, &context->data[context->dataOffset], length);
+      context->dataOffset += length;
+
+      if (!context->reading && context->nextData.empty() && !context->readFailed &&
+          context->readLength < context->totalLength)
+        StartReadAhead(context);
+
+      return length;
+    }
+
+    if (!context->nextData.empty())
+    {
+      context->data.swap(context->nextData);
+      context->nextData.clear();
+      context->dataOffset = 0;
+      continue;
+    }
+
+    if (context->readFailed || context->readLength >= context->totalLength)
+      return -1;
+
+    if (!context->reading)
+    {
+      StartReadAhead(context);
+      continue;
+    }
+
+    // libmicrohttpd calls us again once the worker has resumed the connection
+    context->suspended = true;
+    MHD_suspend_connection(context->connection);
+    return 0;
+  }
+}
+#endif
+
+#if (MHD_VERSION >= 0x00090200)
+ssize_t CWebServer::ContentReaderCallback(void *cls, uint64_t pos, char *buf, size_t max)
+#elif (MHD_VERSION >= 0x00040001)
+int CWebServer::ContentReaderCallback(void *cls, uint64_t pos, char *buf, int max)
+#else   //libmicrohttpd < 0.4.0
+int CWebServer::ContentReaderCallback(void *cls, size_t pos, char *buf, int max)
+#endif
+{
+  HttpFileDownloadContext *context = (HttpFileDownloadContext *)cls;
+  if (context == nullptr || context->file == nullptr)
+    return -1;
+
+#ifdef WEBSERVER_DEBUG
+  CLog::Log(LOGDEBUG, "webserver [OUT] write maximum %d bytes from %" PRIu64 " (%" PRIu64 ")", max, context->writePosition, pos);
+#endif
+
+#ifdef WEBSERVER_ASYNC_HANDLERS
+  // reads through the VFS may block so they are left to the workers
+  if (context->workerPool != nullptr)
+    return SendReadAheadData(context, buf, static_cast<size_t>(max));
+#endif
+
+  return ReadContent(context, buf, static_cast<size_t>(max));
+}
+
 void CWebServer::ContentReaderFreeCallback(void *cls)
 {
   HttpFileDownloadContext *context = (HttpFileDownloadContext *)cls;
+
+#ifdef WEBSERVER_ASYNC_HANDLERS
+  if (context != nullptr)
+  {
+    // a worker still reading ahead deletes the context once it's done
+    CSingleLock lock(context->dataLock);
+    if (context->reading)
+    {
+      context->released = true;
+      return;
+    }
+  }
+#endif
+
   delete context;
 
 #ifdef WEBSERVER_DEBUG
@@ -1114,7 +1585,14 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 #endif
 
   return MHD_start_daemon(flags |
-#if (MHD_VERSION >= 0x00040002) && (MHD_VERSION < 0x00090B01)
+#if defined(WEBSERVER_ASYNC_HANDLERS)
+                          // a fixed number of I/O threads each serving many connections, blocking
+                          // request handlers are moved to the worker pool
+                          MHD_USE_SELECT_INTERNALLY | MHD_USE_SUSPEND_RESUME
+#if defined(TARGET_LINUX)
+                          | MHD_USE_EPOLL_LINUX_ONLY
+#endif
+#elif (MHD_VERSION >= 0x00040002) && (MHD_VERSION < 0x00090B01)
                           // use main thread for each connection, can only handle one request at a
                           // time [unless you set the thread pool size]
                           MHD_USE_SELECT_INTERNALLY
@@ -1134,8 +1612,8 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
                           &CWebServer::AnswerToConnection,
                           this,
 
-#if (MHD_VERSION >= 0x00040002) && (MHD_VERSION < 0x00090B01)
-                          MHD_OPTION_THREAD_POOL_SIZE, 4,
+#if defined(WEBSERVER_ASYNC_HANDLERS) || ((MHD_VERSION >= 0x00040002) && (MHD_VERSION < 0x00090B01))
+                          MHD_OPTION_THREAD_POOL_SIZE, WEBSERVER_IO_THREADS,
 #endif
                           MHD_OPTION_CONNECTION_LIMIT, 512,
                           MHD_OPTION_CONNECTION_TIMEOUT, timeout,
@@ -1151,6 +1629,11 @@ bool CWebServer::Start(int port, const std::string &username, const std::string
   SetCredentials(username, password);
   if (!m_running)
   {
+#if defined(WEBSERVER_ASYNC_HANDLERS)
+    // must be running before the first request can come in
+    m_workerPool.Start(std::max(2, std::min(g_cpuInfo.getCPUCount(), WEBSERVER_MAX_WORKERS)));
+#endif
+
     int v6testSock;
     if ((v6testSock = socket(AF_INET6, SOCK_STREAM, 0)) >= 0)
     {
@@ -1164,7 +1647,10 @@ bool CWebServer::Start(int port, const std::string &username, const std::string
     if (m_running)
       CLog::Log(LOGNOTICE, "WebServer: Started the webserver");
     else
+    {
+      m_workerPool.Stop();
       CLog::Log(LOGERROR, "WebServer: Failed to start the webserver");
+    }
   }
 
   return m_running;
@@ -1174,6 +1660,10 @@ bool CWebServer::Stop()
 {
   if (m_running)
   {
+    // finish the requests still running on the workers, libmicrohttpd can't
+    // be stopped while connections are suspended
+    m_workerPool.Stop();
+
     if (m_daemon_ip6 != nullptr)
       MHD_stop_daemon(m_daemon_ip6);
 
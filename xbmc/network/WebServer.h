@@ -22,11 +22,13 @@
 #include "system.h"
 
 #ifdef HAS_WEB_SERVER
+#include <functional>
 #include <memory>
 #include <vector>
 
 #include "interfaces/json-rpc/ITransportLayer.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
+#include "network/RequestWorkerPool.h"
 #include "threads/CriticalSection.h"
 
 namespace XFILE
@@ -35,6 +37,7 @@ namespace XFILE
 }
 class CDateTime;
 class CVariant;
+struct ConnectionHandler;
 
 class CWebServer : public JSONRPC::ITransportLayer
 {
@@ -96,7 +99,13 @@ private:
                              const char *transfer_encoding, const char *data, uint64_t off,
                              unsigned int size);
 #endif
-  static int HandleRequest(const std::shared_ptr<IHTTPRequestHandler>& handler);
+  static void PrepareRequest(IHTTPRequestHandler *requestHandler, const HTTPRequest &request, ConnectionHandler &conHandler);
+  static void PrepareResponse(ConnectionHandler &conHandler);
+  static void PrepareNotModifiedResponse(ConnectionHandler &conHandler);
+  static void PrepareErrorResponse(ConnectionHandler &conHandler, int errorType);
+  static bool MatchesETag(const std::string &condition, const std::string &etag);
+  static int SendPreparedResponse(struct MHD_Connection *connection, ConnectionHandler &conHandler);
+  bool HandleAsynchronously(struct MHD_Connection *connection, ConnectionHandler &conHandler, const std::function<void()> &prepare);
   static int FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& handler, int responseStatus, struct MHD_Response *response);
 
   static int CreateMemoryDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response);
@@ -104,6 +113,8 @@ private:
 
   static int CreateRedirect(struct MHD_Connection *connection, const std::string &strURL, struct MHD_Response *&response);
   static int CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHandler>& handler, struct MHD_Response *&response);
+  static int OpenLocalFile(const std::string &path, uint64_t &length);
+  static size_t GetDownloadBlockSize(XFILE::CFile &file, const std::string &path, uint64_t totalLength, bool readAhead);
   static int CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response);
   static int CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response);
 
@@ -124,6 +135,7 @@ private:
   bool m_needcredentials;
   std::string m_Credentials64Encoded;
   CCriticalSection m_critSection;
+  CRequestWorkerPool m_workerPool;
   static std::vector<IHTTPRequestHandler *> m_requestHandlers;
 };
 #endif
@@ -33,6 +33,7 @@ public:
   virtual bool CanHandleRequest(const HTTPRequest &request);
 
   virtual int GetPriority() const { return 5; }
+  virtual bool CanHandleAsynchronously() const { return true; }
 
 protected:
   explicit CHTTPImageHandler(const HTTPRequest &request);
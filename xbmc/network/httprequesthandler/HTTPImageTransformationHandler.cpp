@@ -21,6 +21,7 @@
 #include <map>
 
 #include "HTTPImageTransformationHandler.h"
+#include "TextureCache.h"
 #include "TextureCacheJob.h"
 #include "URL.h"
 #include "filesystem/ImageFile.h"
@@ -38,6 +39,7 @@ static const std::string ImageBasePath = "/image/";
 CHTTPImageTransformationHandler::CHTTPImageTransformationHandler()
   : m_url(),
     m_lastModified(),
+    m_etag(),
     m_buffer(NULL),
     m_responseData()
 { }
@@ -46,6 +48,7 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   : IHTTPRequestHandler(request),
     m_url(),
     m_lastModified(),
+    m_etag(),
     m_buffer(NULL),
     m_responseData()
 {
@@ -76,6 +79,19 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
 
   // TODO: determine the maximum age
 
+  // the entity tag is based on the original image so it changes whenever the
+  // cached result of the transformation would have to be recreated
+  unsigned int width, height;
+  CPictureScalingAlgorithm::Algorithm scalingAlgorithm;
+  std::string additionalInfo;
+  std::string originalImage = CTextureCacheJob::DecodeImageURL(m_url, width, height, scalingAlgorithm, additionalInfo);
+  if (!originalImage.empty())
+  {
+    std::string hash = CTextureCacheJob::GetImageHash(originalImage);
+    if (!hash.empty() && hash != "BADHASH")
+      m_etag = "\"" + hash + "\"";
+  }
+
   // determine the last modified date
   struct __stat64 statBuffer;
   if (imageFile.Stat(pathToUrl, &statBuffer) != 0)
@@ -97,7 +113,7 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
 CHTTPImageTransformationHandler::~CHTTPImageTransformationHandler()
 {
   m_responseData.clear();
-  delete m_buffer;
+  delete[] m_buffer;
   m_buffer = NULL;
 }
 
@@ -133,6 +149,22 @@ int CHTTPImageTransformationHandler::HandleRequest()
   std::map<std::string, std::string> options;
   CWebServer::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
 
+  // the width and height must be numbers within the limits of the cache
+  const char *sizeOptions[] = { TRANSFORMATION_OPTION_WIDTH, TRANSFORMATION_OPTION_HEIGHT };
+  for (size_t i = 0; i < sizeof(sizeOptions) / sizeof(sizeOptions[0]); i++)
+  {
+    std::map<std::string, std::string>::const_iterator size = options.find(sizeOptions[i]);
+    if (size != options.end() &&
+        (!StringUtils::IsNaturalNumber(size->second) ||
+         strtoul(size->second.c_str(), NULL, 10) > CTextureCache::MaxResizedImageSize))
+    {
+      m_response.status = MHD_HTTP_BAD_REQUEST;
+      m_response.type = HTTPError;
+
+      return MHD_YES;
+    }
+  }
+
   std::vector<std::string> urlOptions;
   std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
   if (option != options.end())
@@ -153,9 +185,9 @@ int CHTTPImageTransformationHandler::HandleRequest()
     imagePath += StringUtils::Join(urlOptions, "&");
   }
 
-  // resize the image into the local buffer
+  // resize the image into the local buffer unless it has been resized before
   size_t bufferSize;
-  if (!CTextureCacheJob::ResizeTexture(imagePath, m_buffer, bufferSize))
+  if (!CTextureCache::GetInstance().GetResizedImage(imagePath, m_buffer, bufferSize))
   {
     m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
     m_response.type = HTTPError;
@@ -187,3 +219,12 @@ bool CHTTPImageTransformationHandler::GetLastModifiedDate(CDateTime &lastModifie
   lastModified = m_lastModified;
   return true;
 }
+
+bool CHTTPImageTransformationHandler::GetETag(std::string &etag) const
+{
+  if (m_etag.empty())
+    return false;
+
+  etag = m_etag;
+  return true;
+}
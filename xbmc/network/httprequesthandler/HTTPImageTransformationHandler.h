@@ -39,11 +39,13 @@ public:
   virtual bool CanHandleRanges() const { return true; }
   virtual bool CanBeCached() const { return true; }
   virtual bool GetLastModifiedDate(CDateTime &lastModified) const;
+  virtual bool GetETag(std::string &etag) const;
 
   virtual HttpResponseRanges GetResponseData() const { return m_responseData; }
 
   // priority must be higher than the one of CHTTPImageHandler
   virtual int GetPriority() const { return 6; }
+  virtual bool CanHandleAsynchronously() const { return true; }
 
 protected:
   explicit CHTTPImageTransformationHandler(const HTTPRequest &request);
@@ -51,6 +53,7 @@ protected:
 private:
   std::string m_url;
   CDateTime m_lastModified;
+  std::string m_etag;
 
   uint8_t* m_buffer;
   HttpResponseRanges m_responseData;
@@ -38,6 +38,7 @@ public:
   virtual HttpResponseRanges GetResponseData() const;
 
   virtual int GetPriority() const { return 5; }
+  virtual bool CanHandleAsynchronously() const { return true; }
 
 protected:
   explicit CHTTPJsonRpcHandler(const HTTPRequest &request)
@@ -124,6 +124,16 @@ public:
    */
   virtual int HandleRequest() = 0;
 
+  /*!
+   * \brief Whether the HTTP request handler may be created and run on one of
+   * the webserver's worker threads.
+   *
+   * \details Handlers which may block, e.g. by accessing the filesystem or
+   * decoding images, should return true so they don't hold up other
+   * connections served by the same I/O thread.
+   */
+  virtual bool CanHandleAsynchronously() const { return false; }
+
   /*!
    * \brief Whether the HTTP response could also be provided in ranges.
    */
@@ -147,7 +157,14 @@ public:
   * \details This is only used if the response can be cached.
   */
   virtual bool GetLastModifiedDate(CDateTime &lastModified) const { return false; }
- 
+
+  /*!
+  * \brief Returns the entity tag (including the quotes) identifying the response data.
+  *
+  * \details This is only used if the response can be cached.
+  */
+  virtual bool GetETag(std::string &etag) const { return false; }
+
   /*!
    * \brief Returns the ranges with raw data belonging to the response.
    *
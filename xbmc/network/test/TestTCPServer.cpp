@@ -0,0 +1,229 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <gtest/gtest.h>
+#include "system.h"
+#include "interfaces/json-rpc/JSONRPC.h"
+#include "network/TCPServer.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/Variant.h"
+
+#define TCPSERVER_PORT          23457
+
+#define LOADTEST_CLIENTS        200
+#define LOADTEST_REQUESTS       50
+#define PIPELINED_REQUESTS      100
+
+// minimal JSON-RPC client talking to the server over a plain socket
+class CTestTCPClient
+{
+public:
+  CTestTCPClient()
+    : m_socket(INVALID_SOCKET)
+  { }
+  ~CTestTCPClient() { Close(); }
+
+  bool Connect()
+  {
+    m_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_socket == INVALID_SOCKET)
+      return false;
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(TCPSERVER_PORT);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    return connect(m_socket, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+  }
+
+  void Close()
+  {
+    if (m_socket != INVALID_SOCKET)
+      closesocket(m_socket);
+    m_socket = INVALID_SOCKET;
+  }
+
+  bool Send(const std::string &data)
+  {
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+      int ret = send(m_socket, data.c_str() + sent, data.size() - sent, 0);
+      if (ret <= 0)
+        return false;
+      sent += ret;
+    }
+    return true;
+  }
+
+  // reads the next complete JSON object sent by the server
+  bool Receive(CVariant &response)
+  {
+    while (true)
+    {
+      int depth = 0;
+      for (size_t i = 0; i < m_buffer.size(); i++)
+      {
+        if (m_buffer[i] == '{')
+          depth++;
+        else if (m_buffer[i] == '}' && --depth == 0)
+        {
+          std::string object = m_buffer.substr(0, i + 1);
+          m_buffer.erase(0, i + 1);
+          response = CJSONVariantParser::Parse(reinterpret_cast<const unsigned char*>(object.c_str()), object.size());
+          return true;
+        }
+      }
+
+      char buffer[4096];
+      int ret = recv(m_socket, buffer, sizeof(buffer), 0);
+      if (ret <= 0)
+        return false;
+      m_buffer.append(buffer, ret);
+    }
+  }
+
+  static std::string GetPing(unsigned int id)
+  {
+    return StringUtils::Format("{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Ping\", \"id\": %u }", id);
+  }
+
+private:
+  SOCKET m_socket;
+  std::string m_buffer;
+};
+
+// issues requests one after another on its own connection and records how long each one took
+class CLoadTestClient : public CThread
+{
+public:
+  explicit CLoadTestClient(unsigned int requests)
+    : CThread("TCPServerLoadTestClient"),
+      m_requests(requests),
+      m_failures(0)
+  { }
+
+  bool Connect() { return m_client.Connect(); }
+  const std::vector<double>& GetLatencies() const { return m_latencies; }
+  unsigned int GetFailures() const { return m_failures; }
+
+protected:
+  virtual void Process()
+  {
+    for (unsigned int i = 0; i < m_requests; i++)
+    {
+      CVariant response;
+      int64_t start = CurrentHostCounter();
+      bool success = m_client.Send(CTestTCPClient::GetPing(i)) && m_client.Receive(response);
+      m_latencies.push_back(1000.0 * (CurrentHostCounter() - start) / CurrentHostFrequency());
+
+      if (!success || response["id"].asUnsignedInteger() != i || response["result"].asString() != "pong")
+        m_failures++;
+    }
+  }
+
+private:
+  CTestTCPClient m_client;
+  unsigned int m_requests;
+  unsigned int m_failures;
+  std::vector<double> m_latencies;
+};
+
+class TestTCPServer : public testing::Test
+{
+protected:
+  virtual void SetUp()
+  {
+    JSONRPC::CJSONRPC::Initialize();
+    ASSERT_TRUE(JSONRPC::CTCPServer::StartServer(TCPSERVER_PORT, false));
+  }
+
+  virtual void TearDown()
+  {
+    JSONRPC::CTCPServer::StopServer(true);
+    JSONRPC::CJSONRPC::Cleanup();
+  }
+};
+
+TEST_F(TestTCPServer, PipelinedRequestsAreAnsweredInOrder)
+{
+  CTestTCPClient client;
+  ASSERT_TRUE(client.Connect());
+
+  // send all requests at once so they are executed while others are still queued
+  std::string requests;
+  for (unsigned int i = 0; i < PIPELINED_REQUESTS; i++)
+    requests += CTestTCPClient::GetPing(i);
+  ASSERT_TRUE(client.Send(requests));
+
+  for (unsigned int i = 0; i < PIPELINED_REQUESTS; i++)
+  {
+    CVariant response;
+    ASSERT_TRUE(client.Receive(response));
+    EXPECT_EQ(i, response["id"].asUnsignedInteger());
+    EXPECT_STREQ("pong", response["result"].asString().c_str());
+  }
+}
+
+TEST_F(TestTCPServer, ConcurrentClients)
+{
+  std::vector<CLoadTestClient*> loadTestClients;
+  for (unsigned int i = 0; i < LOADTEST_CLIENTS; i++)
+  {
+    CLoadTestClient *client = new CLoadTestClient(LOADTEST_REQUESTS);
+    EXPECT_TRUE(client->Connect());
+    loadTestClients.push_back(client);
+  }
+
+  int64_t start = CurrentHostCounter();
+  for (std::vector<CLoadTestClient*>::iterator client = loadTestClients.begin(); client != loadTestClients.end(); ++client)
+    (*client)->Create();
+
+  std::vector<double> latencies;
+  unsigned int failures = 0;
+  for (std::vector<CLoadTestClient*>::iterator client = loadTestClients.begin(); client != loadTestClients.end(); ++client)
+  {
+    EXPECT_TRUE((*client)->WaitForThreadExit(60000));
+    latencies.insert(latencies.end(), (*client)->GetLatencies().begin(), (*client)->GetLatencies().end());
+    failures += (*client)->GetFailures();
+    delete *client;
+  }
+  double elapsed = (double)(CurrentHostCounter() - start) / CurrentHostFrequency();
+
+  ASSERT_FALSE(latencies.empty());
+  std::sort(latencies.begin(), latencies.end());
+  double p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+
+  CLog::Log(LOGNOTICE, "TestTCPServer: %u clients, %u requests, %.0f requests/s, median %.2f ms, p99 %.2f ms",
+            LOADTEST_CLIENTS, (unsigned int)latencies.size(), latencies.size() / elapsed,
+            latencies[latencies.size() / 2], p99);
+
+  EXPECT_EQ(0U, failures);
+}
@@ -18,20 +18,27 @@
  *
  */
 
+#include <algorithm>
 #include <errno.h>
+#include <inttypes.h>
 #include <stdlib.h>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "system.h"
 #include "URL.h"
 #include "filesystem/CurlFile.h"
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "network/WebServer.h"
 #include "settings/MediaSourceSettings.h"
 #include "test/TestUtils.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 
@@ -47,6 +54,77 @@ using namespace XFILE;
 #define TEST_FILES_HTML         TEST_FILES_DATA ".html"
 #define TEST_FILES_RANGES       TEST_FILES_DATA "-ranges.txt"
 
+#define LOADTEST_REQUESTS       500
+
+#define THROUGHPUT_FILE         "special://temp/webserver-throughput.bin"
+#define THROUGHPUT_FILE_SIZE    (64 * 1024 * 1024)
+#define THROUGHPUT_RUNS         3
+
+// issues requests one after another and records how long each one took
+class CLoadTestClient : public CThread
+{
+public:
+  CLoadTestClient(const std::string& fileUrl, const std::string& jsonRpcUrl, unsigned int requests)
+    : CThread("WebServerLoadTestClient"),
+      m_fileUrl(fileUrl),
+      m_jsonRpcUrl(jsonRpcUrl),
+      m_requests(requests),
+      m_failures(0)
+  { }
+
+  const std::vector<double>& GetLatencies() const { return m_latencies; }
+  unsigned int GetFailures() const { return m_failures; }
+
+protected:
+  virtual void Process()
+  {
+    for (unsigned int i = 0; i < m_requests && !m_bStop; i++)
+    {
+      std::string result;
+      CCurlFile curl;
+      int64_t start = CurrentHostCounter();
+      bool success;
+      // alternate between a file and a JSON-RPC request
+      if (i % 2 == 0)
+        success = curl.Get(m_fileUrl, result);
+      else
+      {
+        curl.SetMimeType("application/json");
+        success = curl.Post(m_jsonRpcUrl, "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Ping\", \"id\": 1 }", result);
+      }
+      m_latencies.push_back(1000.0 * (CurrentHostCounter() - start) / CurrentHostFrequency());
+
+      if (!success || result.empty())
+        m_failures++;
+    }
+  }
+
+private:
+  std::string m_fileUrl;
+  std::string m_jsonRpcUrl;
+  unsigned int m_requests;
+  unsigned int m_failures;
+  std::vector<double> m_latencies;
+};
+
+// removes the throughput test file and its share, also when an assertion fails
+class CThroughputTestCleanup
+{
+public:
+  CThroughputTestCleanup(const CMediaSource& source)
+    : m_source(source)
+  { }
+
+  ~CThroughputTestCleanup()
+  {
+    CMediaSourceSettings::GetInstance().DeleteSource("videos", m_source.strName, m_source.strPath);
+    CFile::Delete(THROUGHPUT_FILE);
+  }
+
+private:
+  CMediaSource m_source;
+};
+
 class TestWebServer : public testing::Test
 {
 protected:
@@ -330,6 +408,86 @@ protected:
     return StringUtils::Format("bytes=%u-%u", start, end);
   }
 
+  void RunLoadTest(unsigned int clients)
+  {
+    std::vector<CLoadTestClient*> loadTestClients;
+    unsigned int requestsPerClient = std::max(10U, LOADTEST_REQUESTS / clients);
+    for (unsigned int i = 0; i < clients; i++)
+      loadTestClients.push_back(new CLoadTestClient(GetUrlOfTestFile(TEST_FILES_HTML), GetUrl(TEST_URL_JSONRPC), requestsPerClient));
+
+    int64_t start = CurrentHostCounter();
+    for (std::vector<CLoadTestClient*>::iterator client = loadTestClients.begin(); client != loadTestClients.end(); ++client)
+      (*client)->Create();
+
+    std::vector<double> latencies;
+    unsigned int failures = 0;
+    for (std::vector<CLoadTestClient*>::iterator client = loadTestClients.begin(); client != loadTestClients.end(); ++client)
+    {
+      // a client that doesn't finish in time is stopped before it's deleted
+      if (!(*client)->WaitForThreadExit(60000))
+      {
+        ADD_FAILURE() << "load test client didn't finish in time";
+        (*client)->StopThread(true);
+      }
+      latencies.insert(latencies.end(), (*client)->GetLatencies().begin(), (*client)->GetLatencies().end());
+      failures += (*client)->GetFailures();
+      delete *client;
+    }
+    double elapsed = (double)(CurrentHostCounter() - start) / CurrentHostFrequency();
+
+    ASSERT_FALSE(latencies.empty());
+    std::sort(latencies.begin(), latencies.end());
+    double p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+
+    CLog::Log(LOGNOTICE, "TestWebServer: %u clients, %u requests, %.0f requests/s, median %.2f ms, p99 %.2f ms",
+              clients, (unsigned int)latencies.size(), latencies.size() / elapsed,
+              latencies[latencies.size() / 2], p99);
+
+    EXPECT_EQ(0U, failures);
+  }
+
+  bool CreateThroughputTestFile(const std::string& path, size_t size)
+  {
+    CFile file;
+    if (!file.OpenForWrite(path, true))
+      return false;
+
+    std::vector<char> block(1024 * 1024, 'x');
+    for (size_t written = 0; written < size; written += block.size())
+    {
+      if (file.Write(block.data(), block.size()) != static_cast<ssize_t>(block.size()))
+        return false;
+    }
+
+    return true;
+  }
+
+  void RunThroughputTest(const std::string& description, const std::string& path, uint64_t expectedSize)
+  {
+    std::string url = GetUrl(URIUtils::AddFileToFolder("vfs", CURL::Encode(path)));
+    std::vector<char> buffer(256 * 1024);
+
+    int64_t start = CurrentHostCounter();
+    for (unsigned int run = 0; run < THROUGHPUT_RUNS; run++)
+    {
+      CCurlFile curl;
+      ASSERT_TRUE(curl.Open(CURL(url)));
+
+      uint64_t received = 0;
+      ssize_t read;
+      while ((read = curl.Read(buffer.data(), buffer.size())) > 0)
+        received += read;
+      curl.Close();
+
+      ASSERT_EQ(expectedSize, received);
+    }
+    double elapsed = (double)(CurrentHostCounter() - start) / CurrentHostFrequency();
+
+    CLog::Log(LOGNOTICE, "TestWebServer: %s file, %u x %" PRIu64 " bytes, %.1f MB/s",
+              description.c_str(), THROUGHPUT_RUNS, expectedSize,
+              THROUGHPUT_RUNS * expectedSize / elapsed / (1024 * 1024));
+  }
+
   CWebServer webserver;
   std::string baseUrl;
   std::string sourcePath;
@@ -394,6 +552,101 @@ TEST_F(TestWebServer, CanGetJsonRpcResponse)
   JSONRPC::CJSONRPC::Cleanup();
 }
 
+TEST_F(TestWebServer, CanGetJsonRpcBatchResponseInOrder)
+{
+  JSONRPC::CJSONRPC::Initialize();
+
+  // read-only calls around a call with side effects and a notification
+  std::string batch = "[ "
+    "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Ping\", \"id\": 1 }, "
+    "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Version\", \"id\": 2 }, "
+    "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.NotifyAll\", \"params\": { \"sender\": \"test\", \"message\": \"batch\" }, \"id\": 3 }, "
+    "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Permission\", \"id\": 4 }, "
+    "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Ping\" }, "
+    "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Ping\", \"id\": 5 }, "
+    "{ \"jsonrpc\": \"2.0\", \"method\": \"JSONRPC.Ping\", \"id\": 6 } ]";
+
+  std::string result;
+  CCurlFile curl;
+  curl.SetMimeType("application/json");
+  ASSERT_TRUE(curl.Post(GetUrl(TEST_URL_JSONRPC), batch, result));
+  ASSERT_FALSE(result.empty());
+
+  CVariant resultObj = CJSONVariantParser::Parse(reinterpret_cast<const unsigned char*>(result.c_str()), result.size());
+  ASSERT_TRUE(resultObj.isArray());
+  // the notification doesn't get a response
+  ASSERT_EQ(6U, resultObj.size());
+  for (unsigned int i = 0; i < resultObj.size(); i++)
+  {
+    EXPECT_EQ(i + 1, resultObj[i]["id"].asUnsignedInteger());
+    EXPECT_TRUE(resultObj[i].isMember("result"));
+  }
+  EXPECT_STREQ("pong", resultObj[0]["result"].asString().c_str());
+  EXPECT_STREQ("OK", resultObj[2]["result"].asString().c_str());
+
+  JSONRPC::CJSONRPC::Cleanup();
+}
+
+TEST_F(TestWebServer, LoadTest)
+{
+  JSONRPC::CJSONRPC::Initialize();
+
+  RunLoadTest(1);
+  RunLoadTest(10);
+  RunLoadTest(100);
+
+  JSONRPC::CJSONRPC::Cleanup();
+}
+
+// writes a 64MB file, so it only runs with --gtest_also_run_disabled_tests
+TEST_F(TestWebServer, DISABLED_FileThroughput)
+{
+  // the translated path is served straight from the file descriptor while
+  // the special:// path has to go through the VFS
+  std::string localPath = CSpecialProtocol::TranslatePath(THROUGHPUT_FILE);
+  CMediaSource source;
+  source.strName = "WebServer Throughput Share";
+  source.strPath = URIUtils::GetDirectory(THROUGHPUT_FILE);
+  source.vecPaths.push_back(source.strPath);
+  source.vecPaths.push_back(URIUtils::GetDirectory(localPath));
+  source.m_allowSharing = true;
+  source.m_iDriveType = CMediaSource::SOURCE_TYPE_LOCAL;
+  source.m_iLockMode = LOCK_MODE_EVERYONE;
+  source.m_ignore = true;
+
+  CThroughputTestCleanup cleanup(source);
+  ASSERT_TRUE(CreateThroughputTestFile(THROUGHPUT_FILE, THROUGHPUT_FILE_SIZE));
+  ASSERT_TRUE(CMediaSourceSettings::GetInstance().AddShare("videos", source));
+
+  RunThroughputTest("local", localPath, THROUGHPUT_FILE_SIZE);
+  RunThroughputTest("vfs", THROUGHPUT_FILE, THROUGHPUT_FILE_SIZE);
+}
+
+TEST_F(TestWebServer, CanNotGetUnsatisfiableRange)
+{
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader("Range", "bytes=100-200");
+  ASSERT_FALSE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+}
+
+TEST_F(TestWebServer, CanGetSatisfiableRangesOfPartlyUnsatisfiableRange)
+{
+  const std::string rangedFileContent = TEST_FILES_DATA_RANGES;
+  const std::string range = "bytes=0-5,100-200";
+
+  CHttpRanges ranges;
+  ASSERT_TRUE(ranges.Parse(range, rangedFileContent.size()));
+  ASSERT_EQ(1, ranges.Size());
+
+  // only the satisfiable range is returned
+  std::string result;
+  CCurlFile curl;
+  curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, range);
+  ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
+  CheckRangesTestFileResponse(curl, result, ranges);
+}
+
 TEST_F(TestWebServer, CanNotHeadNonExistingFile)
 {
   CCurlFile curl;
@@ -29,8 +29,10 @@
 #include "interfaces/AnnouncementManager.h"
 #include "filesystem/Directory.h"
 #include "filesystem/MusicDatabaseDirectory.h"
+#include "filesystem/MusicDatabaseDirectory/QueryParams.h"
 #include "filesystem/SpecialProtocol.h"
 #include "filesystem/VideoDatabaseDirectory.h"
+#include "filesystem/VideoDatabaseDirectory/QueryParams.h"
 #include "guilib/WindowIDs.h"
 #include "music/tags/MusicInfoTag.h"
 #include "settings/AdvancedSettings.h"
@@ -43,6 +45,7 @@
 #include "utils/Variant.h"
 #include "Util.h"
 #include "music/MusicDatabase.h"
+#include "music/MusicDbUrl.h"
 #include "video/VideoDatabase.h"
 #include "guilib/GUIWindowManager.h"
 #include "GUIUserMessages.h"
@@ -50,6 +53,9 @@
 
 NPT_SET_LOCAL_LOGGER("xbmc.upnp.server")
 
+// number of containers listed from the libraries kept in memory
+#define UPNP_MAX_CACHED_CONTAINERS 8
+
 using namespace ANNOUNCEMENT;
 using namespace XFILE;
 
@@ -71,7 +77,9 @@ const char* video_containers[] = { "library://video/movies/titles.xml/", "librar
 CUPnPServer::CUPnPServer(const char* friendly_name, const char* uuid /*= NULL*/, int port /*= 0*/) :
     PLT_MediaConnect(friendly_name, false, uuid, port),
     PLT_FileMediaConnectDelegate("/", "/"),
-    m_scanning(g_application.IsMusicScanning() || g_application.IsVideoScanning())
+    m_scanning(g_application.IsMusicScanning() || g_application.IsVideoScanning()),
+    m_MusicUpdateID(0),
+    m_VideoUpdateID(0)
 {
 }
 
@@ -150,9 +158,28 @@ CUPnPServer::UpdateContainer(const std::string& id)
     if (itr != m_UpdateIDs.end())
         count = ++itr->second.second;
     m_UpdateIDs[id] = std::make_pair(true, count);
+    InvalidateContainers(id);
     PropagateUpdates();
 }
 
+/*----------------------------------------------------------------------
+|   CUPnPServer::InvalidateContainers
+|
+|   Updating a container also affects the containers listing the same
+|   items in a different way (eg by genre or artist) so all cached
+|   containers of the library are invalidated. Containers outside of the
+|   libraries aren't cached.
++---------------------------------------------------------------------*/
+void
+CUPnPServer::InvalidateContainers(const std::string& id)
+{
+    NPT_AutoLock lock(m_ContainersMutex);
+    if (URIUtils::IsMusicDb(id))
+        ++m_MusicUpdateID;
+    else if (URIUtils::IsVideoDb(id))
+        ++m_VideoUpdateID;
+}
+
 /*----------------------------------------------------------------------
 |   CUPnPServer::PropagateUpdates
 +---------------------------------------------------------------------*/
@@ -431,6 +458,10 @@ CUPnPServer::Announce(AnnouncementFlag flag, const char *sender, const char *mes
         }
     }
     else {
+        // removed items can't always be mapped to their containers anymore
+        if (!strcmp(message, "OnRemove"))
+            InvalidateContainers(flag == AudioLibrary ? "musicdb://" : "videodb://");
+
         // handle both updates & removals
         if (!data["item"].isNull()) {
             item_id = (int)data["item"]["id"].asInteger();
@@ -633,7 +664,6 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
                                     const char*                   sort_criteria,
                                     const PLT_HttpRequestContext& context)
 {
-    CFileItemList items;
     NPT_String    parent_id = TranslateWMPObjectId(object_id);
 
     CLog::Log(LOGINFO, "UPnP: Received Browse DirectChildren request for object '%s', with sort criteria %s", object_id, sort_criteria);
@@ -643,8 +673,213 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
         return NPT_FAILURE;
     }
 
+    NPT_UInt32    max_count = GetMaxReturnedCount(requested_count);
+    NPT_Cardinal  total;
+    CFileItemList items;
     items.SetPath(std::string(parent_id));
 
+    // library listings are sorted and limited to the requested page by
+    // the database so only the items of that page have to be retrieved
+    if (GetLibraryPage((const char*)parent_id, starting_index, max_count, sort_criteria, items)) {
+        total = (NPT_Cardinal)items.GetProperty("total").asUnsignedInteger();
+    } else {
+        std::shared_ptr<CFileItemList> container = GetContainer((const char*)parent_id, sort_criteria);
+        items.Clear();
+        items.SetPath(container->GetPath());
+
+        // building the response modifies the items so the items of the page
+        // are copied as the container may be shared with other requests
+        NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)container->Size());
+        for (unsigned long i = starting_index; i < stop_index; ++i)
+            items.Add(CFileItemPtr(new CFileItem(*container->Get(i))));
+        total = container->Size();
+    }
+
+    // Don't pass parent_id if action is Search not BrowseDirectChildren, as
+    // we want the engine to determine the best parent id, not necessarily the one
+    // passed
+    NPT_String action_name = action->GetActionDesc().GetName();
+    return BuildPageResponse(
+        action,
+        items,
+        total,
+        filter,
+        context,
+        (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars());
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetLibraryPage
+|
+|   return true if the page was retrieved from the music or video library
++---------------------------------------------------------------------*/
+bool
+CUPnPServer::GetLibraryPage(const std::string& path,
+                            NPT_UInt32         starting_index,
+                            NPT_UInt32         count,
+                            const char*        sort_criteria,
+                            CFileItemList&     items)
+{
+    // the database can only sort by a single criteria
+    SortDescription sorting;
+    std::vector<std::string> criteria = StringUtils::Split(sort_criteria ? sort_criteria : "", ",");
+    for (std::vector<std::string>::const_iterator itr = criteria.begin(); itr != criteria.end(); ++itr) {
+        SortDescription criterion;
+        if (!GetSortDescription(*itr, criterion))
+            continue;
+        if (sorting.sortBy != SortByNone)
+            return false;
+        sorting = criterion;
+    }
+
+    if (sorting.sortBy == SortByNone && !GetDefaultSortDescription(items, sorting))
+        return false;
+
+    // the sorting is done by the query itself so the database only has
+    // to retrieve the items of the requested page
+    SortDescription limits;
+    limits.limitStart = starting_index;
+    limits.limitEnd   = starting_index + count;
+
+    bool result;
+    if (URIUtils::IsMusicDb(path)) {
+        using namespace MUSICDATABASEDIRECTORY;
+
+        NODE_TYPE type = CMusicDatabaseDirectory::GetDirectoryChildType(path);
+        if (type != NODE_TYPE_ARTIST && type != NODE_TYPE_ALBUM && type != NODE_TYPE_SONG)
+            return false;
+
+        CDatabase::Filter filter;
+        if (!SortUtils::GetOrderClause(sorting, type == NODE_TYPE_ARTIST ? MediaTypeArtist :
+                                                type == NODE_TYPE_ALBUM ? MediaTypeAlbum : MediaTypeSong, filter.order))
+            return false;
+
+        CMusicDatabase database;
+        if (!database.Open())
+            return false;
+
+        if (type == NODE_TYPE_ARTIST) {
+            CMusicDbUrl musicUrl;
+            if (!musicUrl.FromString(path))
+                return false;
+            if (!musicUrl.HasOption("albumartistsonly"))
+                musicUrl.AddOption("albumartistsonly", !CSettings::GetInstance().GetBool(CSettings::SETTING_MUSICLIBRARY_SHOWCOMPILATIONARTISTS));
+            result = database.GetArtistsByWhere(musicUrl.ToString(), filter, items, limits);
+        }
+        else if (type == NODE_TYPE_ALBUM)
+            result = database.GetAlbumsByWhere(path, filter, items, limits);
+        else
+            result = database.GetSongsByWhere(path, filter, items, limits);
+    }
+    else if (URIUtils::IsVideoDb(path)) {
+        using namespace VIDEODATABASEDIRECTORY;
+
+        NODE_TYPE type = CVideoDatabaseDirectory::GetDirectoryChildType(path);
+        if (type != NODE_TYPE_TITLE_MOVIES && type != NODE_TYPE_TITLE_TVSHOWS &&
+            type != NODE_TYPE_EPISODES && type != NODE_TYPE_TITLE_MUSICVIDEOS)
+            return false;
+
+        CDatabase::Filter filter;
+        if (!SortUtils::GetOrderClause(sorting, type == NODE_TYPE_TITLE_MOVIES ? MediaTypeMovie :
+                                                type == NODE_TYPE_TITLE_TVSHOWS ? MediaTypeTvShow :
+                                                type == NODE_TYPE_EPISODES ? MediaTypeEpisode : MediaTypeMusicVideo, filter.order))
+            return false;
+
+        CVideoDatabase database;
+        if (!database.Open())
+            return false;
+
+        if (type == NODE_TYPE_TITLE_MOVIES)
+            result = database.GetMoviesByWhere(path, filter, items, limits);
+        else if (type == NODE_TYPE_TITLE_TVSHOWS) {
+            if (!CSettings::GetInstance().GetBool(CSettings::SETTING_VIDEOLIBRARY_SHOWEMPTYTVSHOWS))
+                filter.AppendWhere("totalCount IS NOT NULL AND totalCount > 0");
+            result = database.GetTvShowsByWhere(path, filter, items, limits);
+        }
+        else if (type == NODE_TYPE_EPISODES)
+            result = database.GetEpisodesByWhere(path, filter, items, false, limits);
+        else
+            result = database.GetMusicVideosByWhere(path, filter, items, true, limits);
+    }
+    else
+        return false;
+
+    if (!result) {
+        items.Clear();
+        return false;
+    }
+
+    CLog::Log(LOGDEBUG, "UPnP: Retrieved %d items starting @ %d out of %d from the library for '%s'",
+        items.Size(), starting_index, (int)items.GetProperty("total").asInteger(), path.c_str());
+    return true;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetContainer
+|
+|   Containers of the libraries are kept in memory until the library is
+|   updated so browsing them page by page doesn't list them every time.
++---------------------------------------------------------------------*/
+std::shared_ptr<CFileItemList>
+CUPnPServer::GetContainer(const std::string& path, const char* sort_criteria)
+{
+    std::string key = path + "|" + (sort_criteria ? sort_criteria : "");
+
+    bool cacheable = true;
+    unsigned long update_id = 0;
+    if (StringUtils::StartsWith(path, "musicdb://")) {
+        NPT_AutoLock lock(m_ContainersMutex);
+        update_id = m_MusicUpdateID;
+    }
+    else if (URIUtils::IsVideoDb(path) || StringUtils::StartsWithNoCase(path, "library://video/")) {
+        NPT_AutoLock lock(m_ContainersMutex);
+        update_id = m_VideoUpdateID;
+    }
+    else
+        cacheable = false;
+
+    if (cacheable) {
+        NPT_AutoLock lock(m_ContainersMutex);
+        std::map<std::string, CachedContainer>::iterator itr = m_Containers.find(key);
+        if (itr != m_Containers.end()) {
+            if (itr->second.update_id == update_id) {
+                itr->second.last_used = XbmcThreads::SystemClockMillis();
+                return itr->second.items;
+            }
+            m_Containers.erase(itr);
+        }
+    }
+
+    std::shared_ptr<CFileItemList> items(new CFileItemList(path));
+    LoadContainer(path, *items);
+    SortItems(*items, sort_criteria);
+
+    if (cacheable) {
+        NPT_AutoLock lock(m_ContainersMutex);
+        if (m_Containers.size() >= UPNP_MAX_CACHED_CONTAINERS) {
+            std::map<std::string, CachedContainer>::iterator oldest = m_Containers.begin();
+            for (std::map<std::string, CachedContainer>::iterator itr = m_Containers.begin(); itr != m_Containers.end(); ++itr) {
+                if (itr->second.last_used < oldest->second.last_used)
+                    oldest = itr;
+            }
+            m_Containers.erase(oldest);
+        }
+
+        CachedContainer& container = m_Containers[key];
+        container.items     = items;
+        container.update_id = update_id;
+        container.last_used = XbmcThreads::SystemClockMillis();
+    }
+
+    return items;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::LoadContainer
++---------------------------------------------------------------------*/
+void
+CUPnPServer::LoadContainer(const std::string& path, CFileItemList& items)
+{
     // guard against loading while saving to the same cache file
     // as CArchive currently performs no locking itself
     bool load;
@@ -656,7 +891,7 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
         // cache anything that takes more than a second to retrieve
         unsigned int time = XbmcThreads::SystemClockMillis();
 
-        if (parent_id.StartsWith("virtualpath://upnproot")) {
+        if (StringUtils::StartsWith(path, "virtualpath://upnproot")) {
             CFileItemPtr item;
 
             // music library
@@ -680,7 +915,7 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
                                   + g_advancedSettings.m_videoExtensions + "|"
                                   + g_advancedSettings.GetMusicExtensions() + "|"
                                   + g_advancedSettings.m_discStubExtensions;
-            CDirectory::GetDirectory((const char*)parent_id, items, supported);
+            CDirectory::GetDirectory(path, items, supported);
             DefaultSortItems(items);
         }
 
@@ -706,19 +941,14 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
       }
     }
 
-    // Don't pass parent_id if action is Search not BrowseDirectChildren, as
-    // we want the engine to determine the best parent id, not necessarily the one
-    // passed
-    NPT_String action_name = action->GetActionDesc().GetName();
-    return BuildResponse(
-        action,
-        items,
-        filter,
-        starting_index,
-        requested_count,
-        sort_criteria,
-        context,
-        (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars());
+    // this isn't pretty but needed to properly hide the addons node from clients
+    if (StringUtils::StartsWith(items.GetPath(), "library")) {
+        for (int i=0; i<items.Size(); i++) {
+            if (StringUtils::StartsWith(items[i]->GetPath(), "addons") ||
+                StringUtils::EndsWith(items[i]->GetPath(), "/addons.xml/"))
+                items.Remove(i--);
+        }
+    }
 }
 
 /*----------------------------------------------------------------------
@@ -734,13 +964,35 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
                            const PLT_HttpRequestContext& context,
                            const char*                   parent_id /* = NULL */)
 {
-    NPT_COMPILER_UNUSED(sort_criteria);
-
     CLog::Log(LOGDEBUG, "Building UPnP response with filter '%s', starting @ %d with %d requested",
         (const char*)filter,
         starting_index,
         requested_count);
 
+    SortItems(items, sort_criteria);
+
+    // won't return more than UPNP_MAX_RETURNED_ITEMS items at a time to keep things smooth
+    NPT_UInt32 max_count  = GetMaxReturnedCount(requested_count);
+    NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)items.Size()); // don't return more than we can
+
+    CFileItemList page(items.GetPath());
+    for (unsigned long i=starting_index; i<stop_index; ++i)
+        page.Add(items[i]);
+
+    return BuildPageResponse(action, page, items.Size(), filter, context, parent_id);
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::BuildPageResponse
++---------------------------------------------------------------------*/
+NPT_Result
+CUPnPServer::BuildPageResponse(PLT_ActionReference&          action,
+                               CFileItemList&                items,
+                               NPT_Cardinal                  total,
+                               const char*                   filter,
+                               const PLT_HttpRequestContext& context,
+                               const char*                   parent_id /* = NULL */)
+{
     // we will reuse this ThumbLoader for all items
     NPT_Reference<CThumbLoader> thumb_loader;
 
@@ -759,25 +1011,10 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
         thumb_loader->OnLoaderStart();
     }
 
-    // this isn't pretty but needed to properly hide the addons node from clients
-    if (StringUtils::StartsWith(items.GetPath(), "library")) {
-        for (int i=0; i<items.Size(); i++) {
-            if (StringUtils::StartsWith(items[i]->GetPath(), "addons") ||
-                StringUtils::EndsWith(items[i]->GetPath(), "/addons.xml/"))
-                items.Remove(i);
-        }
-    }
-
-    // won't return more than UPNP_MAX_RETURNED_ITEMS items at a time to keep things smooth
-    // 0 requested means as many as possible
-    NPT_UInt32 max_count  = (requested_count == 0)?m_MaxReturnedItems:std::min((unsigned long)requested_count, (unsigned long)m_MaxReturnedItems);
-    NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)items.Size()); // don't return more than we can
-
     NPT_Cardinal count = 0;
-    NPT_Cardinal total = items.Size();
     NPT_String didl = didl_header;
     PLT_MediaObjectReference object;
-    for (unsigned long i=starting_index; i<stop_index; ++i) {
+    for (int i=0; i<items.Size(); ++i) {
         object = Build(items[i], true, context, thumb_loader, parent_id);
         if (object.IsNull()) {
             // don't tell the client this item ever existed
@@ -1227,7 +1464,7 @@ CUPnPServer::ServeFile(const NPT_HttpRequest&              request,
 bool
 CUPnPServer::SortItems(CFileItemList& items, const char* sort_criteria)
 {
-  std::string criteria(sort_criteria);
+  std::string criteria(sort_criteria ? sort_criteria : "");
   if (criteria.empty()) {
     return false;
   }
@@ -1236,55 +1473,8 @@ CUPnPServer::SortItems(CFileItemList& items, const char* sort_criteria)
   std::vector<std::string> tokens = StringUtils::Split(criteria, ",");
   for (std::vector<std::string>::reverse_iterator itr = tokens.rbegin(); itr != tokens.rend(); ++itr) {
     SortDescription sorting;
-    /* Platinum guarantees 1st char is - or + */
-    sorting.sortOrder = StringUtils::StartsWith(*itr, "+") ? SortOrderAscending : SortOrderDescending;
-    std::string method = itr->substr(1);
-
-    /* resource specific */
-    if (StringUtils::EqualsNoCase(method, "res@duration"))
-      sorting.sortBy = SortByTime;
-    else if (StringUtils::EqualsNoCase(method, "res@size"))
-      sorting.sortBy = SortBySize;
-    else if (StringUtils::EqualsNoCase(method, "res@bitrate"))
-      sorting.sortBy = SortByBitrate;
-
-    /* dc: */
-    else if (StringUtils::EqualsNoCase(method, "dc:date"))
-      sorting.sortBy = SortByDate;
-    else if (StringUtils::EqualsNoCase(method, "dc:title"))
-    {
-      sorting.sortBy = SortByTitle;
-      sorting.sortAttributes = SortAttributeIgnoreArticle;
-    }
-
-    /* upnp: */
-    else if (StringUtils::EqualsNoCase(method, "upnp:album"))
-      sorting.sortBy = SortByAlbum;
-    else if (StringUtils::EqualsNoCase(method, "upnp:artist") ||
-             StringUtils::EqualsNoCase(method, "upnp:albumArtist"))
-      sorting.sortBy = SortByArtist;
-    else if (StringUtils::EqualsNoCase(method, "upnp:episodeNumber"))
-      sorting.sortBy = SortByEpisodeNumber;
-    else if (StringUtils::EqualsNoCase(method, "upnp:episodeCount"))
-      sorting.sortBy = SortByNumberOfEpisodes;
-    else if (StringUtils::EqualsNoCase(method, "upnp:episodeSeason"))
-      sorting.sortBy = SortBySeason;
-    else if (StringUtils::EqualsNoCase(method, "upnp:genre"))
-      sorting.sortBy = SortByGenre;
-    else if (StringUtils::EqualsNoCase(method, "upnp:originalTrackNumber"))
-      sorting.sortBy = SortByTrackNumber;
-    else if(StringUtils::EqualsNoCase(method, "upnp:rating"))
-      sorting.sortBy = SortByMPAA;
-    else if (StringUtils::EqualsNoCase(method, "xbmc:rating"))
-      sorting.sortBy = SortByRating;
-    else if (StringUtils::EqualsNoCase(method, "xbmc:dateadded"))
-      sorting.sortBy = SortByDateAdded;
-    else if (StringUtils::EqualsNoCase(method, "xbmc:votes"))
-      sorting.sortBy = SortByVotes;
-    else {
-      CLog::Log(LOGINFO, "UPnP: unsupported sort criteria '%s' passed", method.c_str());
+    if (!GetSortDescription(*itr, sorting))
       continue; // needed so unidentified sort methods don't re-sort by label
-    }
 
     CLog::Log(LOGINFO, "UPnP: Sorting by method %d, order %d, attributes %d", sorting.sortBy, sorting.sortOrder, sorting.sortAttributes);
     items.Sort(sorting);
@@ -1294,16 +1484,99 @@ CUPnPServer::SortItems(CFileItemList& items, const char* sort_criteria)
   return sorted;
 }
 
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetSortDescription
+|
+|   return true if the sort criterion (eg "+dc:title") is supported
++---------------------------------------------------------------------*/
+bool
+CUPnPServer::GetSortDescription(const std::string& criterion, SortDescription& sorting)
+{
+  if (criterion.empty())
+    return false;
+
+  /* Platinum guarantees 1st char is - or + */
+  sorting.sortOrder = StringUtils::StartsWith(criterion, "+") ? SortOrderAscending : SortOrderDescending;
+  std::string method = criterion.substr(1);
+
+  /* resource specific */
+  if (StringUtils::EqualsNoCase(method, "res@duration"))
+    sorting.sortBy = SortByTime;
+  else if (StringUtils::EqualsNoCase(method, "res@size"))
+    sorting.sortBy = SortBySize;
+  else if (StringUtils::EqualsNoCase(method, "res@bitrate"))
+    sorting.sortBy = SortByBitrate;
+
+  /* dc: */
+  else if (StringUtils::EqualsNoCase(method, "dc:date"))
+    sorting.sortBy = SortByDate;
+  else if (StringUtils::EqualsNoCase(method, "dc:title"))
+  {
+    sorting.sortBy = SortByTitle;
+    sorting.sortAttributes = SortAttributeIgnoreArticle;
+  }
+
+  /* upnp: */
+  else if (StringUtils::EqualsNoCase(method, "upnp:album"))
+    sorting.sortBy = SortByAlbum;
+  else if (StringUtils::EqualsNoCase(method, "upnp:artist") ||
+           StringUtils::EqualsNoCase(method, "upnp:albumArtist"))
+    sorting.sortBy = SortByArtist;
+  else if (StringUtils::EqualsNoCase(method, "upnp:episodeNumber"))
+    sorting.sortBy = SortByEpisodeNumber;
+  else if (StringUtils::EqualsNoCase(method, "upnp:episodeCount"))
+    sorting.sortBy = SortByNumberOfEpisodes;
+  else if (StringUtils::EqualsNoCase(method, "upnp:episodeSeason"))
+    sorting.sortBy = SortBySeason;
+  else if (StringUtils::EqualsNoCase(method, "upnp:genre"))
+    sorting.sortBy = SortByGenre;
+  else if (StringUtils::EqualsNoCase(method, "upnp:originalTrackNumber"))
+    sorting.sortBy = SortByTrackNumber;
+  else if(StringUtils::EqualsNoCase(method, "upnp:rating"))
+    sorting.sortBy = SortByMPAA;
+  else if (StringUtils::EqualsNoCase(method, "xbmc:rating"))
+    sorting.sortBy = SortByRating;
+  else if (StringUtils::EqualsNoCase(method, "xbmc:dateadded"))
+    sorting.sortBy = SortByDateAdded;
+  else if (StringUtils::EqualsNoCase(method, "xbmc:votes"))
+    sorting.sortBy = SortByVotes;
+  else {
+    CLog::Log(LOGINFO, "UPnP: unsupported sort criteria '%s' passed", method.c_str());
+    return false;
+  }
+
+  return true;
+}
+
 void
 CUPnPServer::DefaultSortItems(CFileItemList& items)
 {
-  CGUIViewState* viewState = CGUIViewState::GetViewState(items.IsVideoDb() ? WINDOW_VIDEO_NAV : -1, items);
-  if (viewState)
-  {
-    SortDescription sorting = viewState->GetSortMethod();
+  SortDescription sorting;
+  if (GetDefaultSortDescription(items, sorting))
     items.Sort(sorting.sortBy, sorting.sortOrder, sorting.sortAttributes);
-    delete viewState;
-  }
+}
+
+bool
+CUPnPServer::GetDefaultSortDescription(const CFileItemList& items, SortDescription& sorting)
+{
+  CGUIViewState* viewState = CGUIViewState::GetViewState(items.IsVideoDb() ? WINDOW_VIDEO_NAV : -1, items);
+  if (!viewState)
+    return false;
+
+  sorting = viewState->GetSortMethod();
+  delete viewState;
+  return true;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetMaxReturnedCount
+|
+|   0 requested means as many as possible
++---------------------------------------------------------------------*/
+NPT_UInt32
+CUPnPServer::GetMaxReturnedCount(NPT_UInt32 requested_count)
+{
+  return (requested_count == 0)?m_MaxReturnedItems:std::min((unsigned long)requested_count, (unsigned long)m_MaxReturnedItems);
 }
 
 NPT_Result
@@ -18,6 +18,9 @@
  *
  */
 #pragma once
+#include <map>
+#include <memory>
+#include <string>
 #include <utility>
 #include <Platinum/Source/Devices/MediaConnect/PltMediaConnect.h>
 
@@ -26,8 +29,10 @@
 
 class CVariant;
 class CThumbLoader;
+struct SortDescription;
 class PLT_MediaObject;
 class PLT_HttpRequestContext;
+class TestUPnPServer;
 
 namespace UPNP
 {
@@ -36,6 +41,8 @@ class CUPnPServer : public PLT_MediaConnect,
                     public PLT_FileMediaConnectDelegate,
                     public ANNOUNCEMENT::IAnnouncer
 {
+    friend class ::TestUPnPServer;
+
 public:
     CUPnPServer(const char* friendly_name, const char* uuid = NULL, int port = 0);
     ~CUPnPServer();
@@ -107,8 +114,17 @@ public:
 private:
     void OnScanCompleted(int type);
     void UpdateContainer(const std::string& id);
+    void InvalidateContainers(const std::string& id);
     void PropagateUpdates();
 
+    bool GetLibraryPage(const std::string& path,
+                        NPT_UInt32         starting_index,
+                        NPT_UInt32         count,
+                        const char*        sort_criteria,
+                        CFileItemList&     items);
+    std::shared_ptr<CFileItemList> GetContainer(const std::string& path, const char* sort_criteria);
+    void LoadContainer(const std::string& path, CFileItemList& items);
+
     PLT_MediaObject* Build(CFileItemPtr                  item,
                            bool                          with_count,
                            const PLT_HttpRequestContext& context,
@@ -122,10 +138,19 @@ private:
                                    const char*                   sort_criteria,
                                    const PLT_HttpRequestContext& context,
                                    const char*                   parent_id /* = NULL */);
+    NPT_Result       BuildPageResponse(PLT_ActionReference&          action,
+                                       CFileItemList&                items,
+                                       NPT_Cardinal                  total,
+                                       const char*                   filter,
+                                       const PLT_HttpRequestContext& context,
+                                       const char*                   parent_id /* = NULL */);
 
     // class methods
     static bool SortItems(CFileItemList& items, const char* sort_criteria);
+    static bool GetSortDescription(const std::string& criterion, SortDescription& sorting);
     static void DefaultSortItems(CFileItemList& items);
+    static bool GetDefaultSortDescription(const CFileItemList& items, SortDescription& sorting);
+    static NPT_UInt32 GetMaxReturnedCount(NPT_UInt32 requested_count);
     static NPT_String GetParentFolder(NPT_String file_path) {
         int index = file_path.ReverseFind("\\");
         if (index == -1) return "";
@@ -140,6 +165,18 @@ private:
 
     std::map<std::string, std::pair<bool, unsigned long> > m_UpdateIDs;
     bool m_scanning;
+
+    // containers listed from the libraries, dropped once one of the
+    // containers of their library has been updated
+    struct CachedContainer {
+        std::shared_ptr<CFileItemList> items;
+        unsigned long                  update_id;
+        unsigned int                   last_used;
+    };
+    NPT_Mutex                               m_ContainersMutex;
+    std::map<std::string, CachedContainer>  m_Containers;
+    unsigned long                           m_MusicUpdateID;
+    unsigned long                           m_VideoUpdateID;
 public:
     // class members
     static NPT_UInt32 m_MaxReturnedItems;
@@ -0,0 +1,94 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <string>
+
+#include "FileItem.h"
+#include "network/upnp/UPnPServer.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+using namespace UPNP;
+
+class TestUPnPServer : public testing::Test
+{
+protected:
+  TestUPnPServer()
+    : m_server("TestUPnPServer")
+  { }
+
+  // caches a container as if it had been listed before
+  std::shared_ptr<CFileItemList> AddContainer(const std::string &path)
+  {
+    std::shared_ptr<CFileItemList> items(new CFileItemList(path));
+    CUPnPServer::CachedContainer &container = m_server.m_Containers[path + "|"];
+    container.items = items;
+    container.update_id = URIUtils::IsMusicDb(path) ? m_server.m_MusicUpdateID : m_server.m_VideoUpdateID;
+    container.last_used = 0;
+    return items;
+  }
+
+  std::shared_ptr<CFileItemList> GetContainer(const std::string &path)
+  {
+    return m_server.GetContainer(path, NULL);
+  }
+
+  void InvalidateContainers(const std::string &id)
+  {
+    m_server.InvalidateContainers(id);
+  }
+
+  unsigned long GetMusicUpdateID() const { return m_server.m_MusicUpdateID; }
+  unsigned long GetVideoUpdateID() const { return m_server.m_VideoUpdateID; }
+
+  CUPnPServer m_server;
+};
+
+TEST_F(TestUPnPServer, InvalidateContainers)
+{
+  std::shared_ptr<CFileItemList> artists = AddContainer("musicdb://artists/");
+  std::shared_ptr<CFileItemList> movies = AddContainer("videodb://movies/titles/");
+  EXPECT_EQ(artists, GetContainer("musicdb://artists/"));
+  EXPECT_EQ(movies, GetContainer("videodb://movies/titles/"));
+
+  // containers outside of the libraries don't affect the cached ones
+  InvalidateContainers("upnp://00000000-0000-0000-0000-000000000000/");
+  InvalidateContainers("special://profile/playlists/video/");
+  EXPECT_EQ(0u, GetMusicUpdateID());
+  EXPECT_EQ(0u, GetVideoUpdateID());
+  EXPECT_EQ(artists, GetContainer("musicdb://artists/"));
+  EXPECT_EQ(movies, GetContainer("videodb://movies/titles/"));
+
+  // updating one library keeps the containers of the other
+  InvalidateContainers("musicdb://songs/");
+  EXPECT_EQ(1u, GetMusicUpdateID());
+  EXPECT_EQ(0u, GetVideoUpdateID());
+  EXPECT_EQ(movies, GetContainer("videodb://movies/titles/"));
+
+  InvalidateContainers("videodb://recentlyaddedmovies/");
+  EXPECT_EQ(1u, GetMusicUpdateID());
+  EXPECT_EQ(1u, GetVideoUpdateID());
+
+  // containers cached after the update are served again
+  artists = AddContainer("musicdb://artists/");
+  EXPECT_EQ(artists, GetContainer("musicdb://artists/"));
+}
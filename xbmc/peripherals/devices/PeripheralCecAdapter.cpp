@@ -369,7 +369,8 @@ void CPeripheralCecAdapter::Process(void)
     m_bActiveSourceBeforeStandby = false;
   }
 
-  CAnnouncementManager::GetInstance().AddAnnouncer(this);
+  // devices have to be put to standby before the system goes to sleep or quits
+  CAnnouncementManager::GetInstance().AddAnnouncer(this, true);
 
   m_queryThread = new CPeripheralCecAdapterUpdateThread(this, &m_configuration);
   m_queryThread->Create(false);
@@ -206,8 +206,20 @@ bool CPicture::ResizeTexture(const std::string &image, uint8_t *pixels, uint32_t
 bool CPicture::CacheTexture(CBaseTexture *texture, uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
   CPictureScalingAlgorithm::Algorithm scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
 {
-  return CacheTexture(texture->GetPixels(), texture->GetWidth(), texture->GetHeight(), texture->GetPitch(),
-                      texture->GetOrientation(), dest_width, dest_height, dest, scalingAlgorithm);
+  // if no max width or height is specified, don't resize
+  if (dest_width == 0)
+    dest_width = texture->GetWidth();
+  if (dest_height == 0)
+    dest_height = texture->GetHeight();
+
+  // the texture may have been scaled down while loading, so decide on the
+  // size from the original image
+  unsigned int original_width = texture->GetOriginalWidth() ? texture->GetOriginalWidth() : texture->GetWidth();
+  unsigned int original_height = texture->GetOriginalHeight() ? texture->GetOriginalHeight() : texture->GetHeight();
+  LimitCacheSize(original_width, original_height, dest_width, dest_height);
+
+  return CacheTextureAtSize(texture->GetPixels(), texture->GetWidth(), texture->GetHeight(), texture->GetPitch(),
+                            texture->GetOrientation(), dest_width, dest_height, dest, scalingAlgorithm);
 }
 
 bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, uint32_t pitch, int orientation,
@@ -219,21 +231,33 @@ bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, ui
     dest_width = width;
   if (dest_height == 0)
     dest_height = height;
-  if (scalingAlgorithm == CPictureScalingAlgorithm::NoAlgorithm)
-    scalingAlgorithm = g_advancedSettings.m_imageScalingAlgorithm;
 
-  uint32_t max_height = g_advancedSettings.m_imageRes;
+  LimitCacheSize(width, height, dest_width, dest_height);
+
+  return CacheTextureAtSize(pixels, width, height, pitch, orientation, dest_width, dest_height, dest, scalingAlgorithm);
+}
+
+void CPicture::LimitCacheSize(unsigned int width, unsigned int height, unsigned int &max_width, unsigned int &max_height)
+{
+  unsigned int cache_height = g_advancedSettings.m_imageRes;
   if (g_advancedSettings.m_fanartRes > g_advancedSettings.m_imageRes)
   { // 16x9 images larger than the fanart res use that rather than the image res
     if (fabsf((float)width / (float)height / (16.0f/9.0f) - 1.0f) <= 0.01f && height >= g_advancedSettings.m_fanartRes)
     {
-      max_height = g_advancedSettings.m_fanartRes;
+      cache_height = g_advancedSettings.m_fanartRes;
     }
   }
-  uint32_t max_width = max_height * 16/9;
 
-  dest_height = std::min(dest_height, max_height);
-  dest_width  = std::min(dest_width, max_width);
+  max_height = std::min(max_height, cache_height);
+  max_width  = std::min(max_width, cache_height * 16/9);
+}
+
+bool CPicture::CacheTextureAtSize(uint8_t *pixels, uint32_t width, uint32_t height, uint32_t pitch, int orientation,
+  uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
+  CPictureScalingAlgorithm::Algorithm scalingAlgorithm)
+{
+  if (scalingAlgorithm == CPictureScalingAlgorithm::NoAlgorithm)
+    scalingAlgorithm = g_advancedSettings.m_imageScalingAlgorithm;
 
   if (width > dest_width || height > dest_height || orientation)
   {
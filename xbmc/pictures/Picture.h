@@ -59,7 +59,19 @@ public:
     uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
     CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm);
 
+  /*! \brief Limit a size to the largest size an image is cached at
+   Images are cached at imageres, 16:9 images of at least fanartres at fanartres.
+   \param width width of the original image
+   \param height height of the original image
+   \param max_width [in/out] maximum width, reduced to the largest width the image is cached at
+   \param max_height [in/out] maximum height, reduced to the largest height the image is cached at
+   */
+  static void LimitCacheSize(unsigned int width, unsigned int height, unsigned int &max_width, unsigned int &max_height);
+
 private:
+  static bool CacheTextureAtSize(uint8_t *pixels, uint32_t width, uint32_t height, uint32_t pitch, int orientation,
+    uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
+    CPictureScalingAlgorithm::Algorithm scalingAlgorithm);
   static void GetScale(unsigned int width, unsigned int height, unsigned int &out_width, unsigned int &out_height);
   static bool ScaleImage(uint8_t *in_pixels, unsigned int in_width, unsigned int in_height, unsigned int in_pitch,
                          uint8_t *out_pixels, unsigned int out_width, unsigned int out_height, unsigned int out_pitch,
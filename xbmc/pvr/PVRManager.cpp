@@ -40,6 +40,7 @@
 #include "messaging/helpers/DialogHelper.h"
 #include "music/tags/MusicInfoTag.h"
 #include "network/Network.h"
+#include "pvr/addons/PVRClientFetches.h"
 #include "pvr/addons/PVRClients.h"
 #include "pvr/channels/PVRChannel.h"
 #include "pvr/channels/PVRChannelGroupInternal.h"
@@ -658,13 +659,18 @@ bool CPVRManager::Load(void)
   if (!m_channelGroups->Load() || !IsInitialising())
     return false;
 
-  /* get timers from the backends */
+  /* get timers and recordings from the backends at once */
   ShowProgressDialog(g_localizeStrings.Get(19237), 50); // Loading timers from clients
-  m_timers->Load();
-
-  /* get recordings from the backend */
-  ShowProgressDialog(g_localizeStrings.Get(19238), 75); // Loading recordings from clients
-  m_recordings->Load();
+  CPVRClientFetches fetches(m_addons->GetFetchWorkers());
+  fetches.Add(PVR_INVALID_CLIENT_ID, "timers", [this]() {
+    m_timers->Load();
+    return PVR_ERROR_NO_ERROR;
+  });
+  fetches.Add(PVR_INVALID_CLIENT_ID, "recordings", [this]() {
+    m_recordings->Load();
+    return PVR_ERROR_NO_ERROR;
+  });
+  fetches.Execute();
 
   if (!IsInitialising())
     return false;
@@ -29,6 +29,7 @@
 #include "utils/Variant.h"
 
 #include "pvr/PVRManager.h"
+#include "pvr/addons/PVRClientFetches.h"
 #include "pvr/addons/PVRClients.h"
 #include "pvr/channels/PVRChannelGroupsContainer.h"
 #include "pvr/recordings/PVRRecordings.h"
@@ -798,7 +799,7 @@ int CPVRClient::GetChannelGroupsAmount(void)
   return iReturn;
 }
 
-PVR_ERROR CPVRClient::GetChannelGroups(CPVRChannelGroups *groups)
+PVR_ERROR CPVRClient::GetChannelGroups(CPVRChannelGroups *groups, CPVRTransferBuffer *buffer /* = NULL */)
 {
   if (!m_bReadyToUse)
     return PVR_ERROR_SERVER_ERROR;
@@ -812,6 +813,9 @@ PVR_ERROR CPVRClient::GetChannelGroups(CPVRChannelGroups *groups)
     ADDON_HANDLE_STRUCT handle;
     handle.callerAddress = this;
     handle.dataAddress = groups;
+    handle.dataIdentifier = 0;
+    if (buffer)
+      buffer->SetupHandle(handle);
     retVal = m_pStruct->GetChannelGroups(&handle, groups->IsRadio());
 
     LogError(retVal, __FUNCTION__);
@@ -824,7 +828,7 @@ PVR_ERROR CPVRClient::GetChannelGroups(CPVRChannelGroups *groups)
   return retVal;
 }
 
-PVR_ERROR CPVRClient::GetChannelGroupMembers(CPVRChannelGroup *group)
+PVR_ERROR CPVRClient::GetChannelGroupMembers(CPVRChannelGroup *group, CPVRTransferBuffer *buffer /* = NULL */)
 {
   if (!m_bReadyToUse)
     return PVR_ERROR_SERVER_ERROR;
@@ -838,6 +842,9 @@ PVR_ERROR CPVRClient::GetChannelGroupMembers(CPVRChannelGroup *group)
     ADDON_HANDLE_STRUCT handle;
     handle.callerAddress = this;
     handle.dataAddress = group;
+    handle.dataIdentifier = 0;
+    if (buffer)
+      buffer->SetupHandle(handle);
 
     PVR_CHANNEL_GROUP tag;
     WriteClientGroupInfo(*group, tag);
@@ -868,7 +875,7 @@ int CPVRClient::GetChannelsAmount(void)
   return iReturn;
 }
 
-PVR_ERROR CPVRClient::GetChannels(CPVRChannelGroup &channels, bool radio)
+PVR_ERROR CPVRClient::GetChannels(CPVRChannelGroup &channels, bool radio, CPVRTransferBuffer *buffer /* = NULL */)
 {
   if (!m_bReadyToUse)
     return PVR_ERROR_SERVER_ERROR;
@@ -884,6 +891,9 @@ PVR_ERROR CPVRClient::GetChannels(CPVRChannelGroup &channels, bool radio)
     ADDON_HANDLE_STRUCT handle;
     handle.callerAddress = this;
     handle.dataAddress = (CPVRChannelGroup*) &channels;
+    handle.dataIdentifier = 0;
+    if (buffer)
+      buffer->SetupHandle(handle);
     retVal = m_pStruct->GetChannels(&handle, radio);
 
     LogError(retVal, __FUNCTION__);
@@ -915,7 +925,7 @@ int CPVRClient::GetRecordingsAmount(bool deleted)
   return iReturn;
 }
 
-PVR_ERROR CPVRClient::GetRecordings(CPVRRecordings *results, bool deleted)
+PVR_ERROR CPVRClient::GetRecordings(CPVRRecordings *results, bool deleted, CPVRTransferBuffer *buffer /* = NULL */)
 {
   if (!m_bReadyToUse)
     return PVR_ERROR_SERVER_ERROR;
@@ -929,6 +939,9 @@ PVR_ERROR CPVRClient::GetRecordings(CPVRRecordings *results, bool deleted)
     ADDON_HANDLE_STRUCT handle;
     handle.callerAddress = this;
     handle.dataAddress = (CPVRRecordings*) results;
+    handle.dataIdentifier = 0;
+    if (buffer)
+      buffer->SetupHandle(handle);
     retVal = m_pStruct->GetRecordings(&handle, deleted);
 
     LogError(retVal, __FUNCTION__);
@@ -1167,7 +1180,7 @@ int CPVRClient::GetTimersAmount(void)
   return iReturn;
 }
 
-PVR_ERROR CPVRClient::GetTimers(CPVRTimers *results)
+PVR_ERROR CPVRClient::GetTimers(CPVRTimers *results, CPVRTransferBuffer *buffer /* = NULL */)
 {
   if (!m_bReadyToUse)
     return PVR_ERROR_SERVER_ERROR;
@@ -1181,6 +1194,9 @@ PVR_ERROR CPVRClient::GetTimers(CPVRTimers *results)
     ADDON_HANDLE_STRUCT handle;
     handle.callerAddress = this;
     handle.dataAddress = (CPVRTimers*) results;
+    handle.dataIdentifier = 0;
+    if (buffer)
+      buffer->SetupHandle(handle);
     retVal = m_pStruct->GetTimers(&handle);
 
     LogError(retVal, __FUNCTION__);
@@ -38,6 +38,7 @@ namespace PVR
   class CPVRChannelGroupInternal;
   class CPVRChannelGroups;
   class CPVRTimers;
+  class CPVRTransferBuffer;
   class CPVRTimerInfoTag;
   class CPVRRecordings;
   class CPVREpgContainer;
@@ -235,16 +236,18 @@ namespace PVR
     /*!
      * @brief Request the list of all channel groups from the backend.
      * @param groups The groups container to get the groups for.
+     * @param buffer Collect the transferred entries in this buffer instead of adding them to the container, or NULL.
      * @return PVR_ERROR_NO_ERROR if the list has been fetched successfully.
      */
-    PVR_ERROR GetChannelGroups(CPVRChannelGroups *groups);
+    PVR_ERROR GetChannelGroups(CPVRChannelGroups *groups, CPVRTransferBuffer *buffer = NULL);
 
     /*!
      * @brief Request the list of all group members from the backend.
      * @param groups The group to get the members for.
+     * @param buffer Collect the transferred entries in this buffer instead of adding them to the container, or NULL.
      * @return PVR_ERROR_NO_ERROR if the list has been fetched successfully.
      */
-    PVR_ERROR GetChannelGroupMembers(CPVRChannelGroup *group);
+    PVR_ERROR GetChannelGroupMembers(CPVRChannelGroup *group, CPVRTransferBuffer *buffer = NULL);
 
     //@}
     /** @name PVR channel methods */
@@ -259,9 +262,10 @@ namespace PVR
      * @brief Request the list of all channels from the backend.
      * @param channels The channel group to add the channels to.
      * @param bRadio True to get the radio channels, false to get the TV channels.
+     * @param buffer Collect the transferred entries in this buffer instead of adding them to the container, or NULL.
      * @return PVR_ERROR_NO_ERROR if the list has been fetched successfully.
      */
-    PVR_ERROR GetChannels(CPVRChannelGroup &channels, bool bRadio);
+    PVR_ERROR GetChannels(CPVRChannelGroup &channels, bool bRadio, CPVRTransferBuffer *buffer = NULL);
 
     //@}
     /** @name PVR recording methods */
@@ -277,9 +281,10 @@ namespace PVR
      * @brief Request the list of all recordings from the backend.
      * @param results The container to add the recordings to.
      * @param deleted if set return deleted recording
+     * @param buffer Collect the transferred entries in this buffer instead of adding them to the container, or NULL.
      * @return PVR_ERROR_NO_ERROR if the list has been fetched successfully.
      */
-    PVR_ERROR GetRecordings(CPVRRecordings *results, bool deleted);
+    PVR_ERROR GetRecordings(CPVRRecordings *results, bool deleted, CPVRTransferBuffer *buffer = NULL);
 
     /*!
      * @brief Delete a recording on the backend.
@@ -350,9 +355,10 @@ namespace PVR
     /*!
      * @brief Request the list of all timers from the backend.
      * @param results The container to store the result in.
+     * @param buffer Collect the transferred entries in this buffer instead of adding them to the container, or NULL.
      * @return PVR_ERROR_NO_ERROR if the list has been fetched successfully.
      */
-    PVR_ERROR GetTimers(CPVRTimers *results);
+    PVR_ERROR GetTimers(CPVRTimers *results, CPVRTransferBuffer *buffer = NULL);
 
     /*!
      * @brief Add a timer on the backend.
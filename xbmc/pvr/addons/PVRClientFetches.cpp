@@ -0,0 +1,204 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "PVRClientFetches.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "PVRClient.h"
+#include "addons/AddonCallbacksPVR.h"
+#include "network/RequestWorkerPool.h"
+#include "threads/Event.h"
+#include "utils/log.h"
+#include "utils/TimeUtils.h"
+
+using namespace PVR;
+
+const int CPVRTransferBuffer::HANDLE_IDENTIFIER;
+
+CPVRTransferBuffer::CPVRTransferBuffer(void *target) :
+    m_target(target),
+    m_addonData(NULL)
+{
+}
+
+void CPVRTransferBuffer::SetupHandle(ADDON_HANDLE_STRUCT &handle)
+{
+  handle.dataAddress = this;
+  handle.dataIdentifier = HANDLE_IDENTIFIER;
+}
+
+void CPVRTransferBuffer::Add(void *addonData, const PVR_CHANNEL_GROUP &entry)
+{
+  m_addonData = addonData;
+  m_groups.push_back(entry);
+}
+
+void CPVRTransferBuffer::Add(void *addonData, const PVR_CHANNEL_GROUP_MEMBER &entry)
+{
+  m_addonData = addonData;
+  m_members.push_back(entry);
+}
+
+void CPVRTransferBuffer::Add(void *addonData, const PVR_CHANNEL &entry)
+{
+  m_addonData = addonData;
+  m_channels.push_back(entry);
+}
+
+void CPVRTransferBuffer::Add(void *addonData, const PVR_RECORDING &entry)
+{
+  m_addonData = addonData;
+  m_recordings.push_back(entry);
+}
+
+void CPVRTransferBuffer::Add(void *addonData, const PVR_TIMER &entry)
+{
+  m_addonData = addonData;
+  m_timers.push_back(entry);
+}
+
+void CPVRTransferBuffer::Transfer(void)
+{
+  ADDON_HANDLE_STRUCT handle;
+  handle.callerAddress = NULL;
+  handle.dataAddress = m_target;
+  handle.dataIdentifier = 0;
+
+  /* an add-on transfers a single kind of entries per request */
+  for (std::vector<PVR_CHANNEL_GROUP>::const_iterator it = m_groups.begin(); it != m_groups.end(); ++it)
+    ADDON::CAddonCallbacksPVR::PVRTransferChannelGroup(m_addonData, &handle, &*it);
+  for (std::vector<PVR_CHANNEL_GROUP_MEMBER>::const_iterator it = m_members.begin(); it != m_members.end(); ++it)
+    ADDON::CAddonCallbacksPVR::PVRTransferChannelGroupMember(m_addonData, &handle, &*it);
+  for (std::vector<PVR_CHANNEL>::const_iterator it = m_channels.begin(); it != m_channels.end(); ++it)
+    ADDON::CAddonCallbacksPVR::PVRTransferChannelEntry(m_addonData, &handle, &*it);
+  for (std::vector<PVR_RECORDING>::const_iterator it = m_recordings.begin(); it != m_recordings.end(); ++it)
+    ADDON::CAddonCallbacksPVR::PVRTransferRecordingEntry(m_addonData, &handle, &*it);
+  for (std::vector<PVR_TIMER>::const_iterator it = m_timers.begin(); it != m_timers.end(); ++it)
+    ADDON::CAddonCallbacksPVR::PVRTransferTimerEntry(m_addonData, &handle, &*it);
+
+  m_groups.clear();
+  m_members.clear();
+  m_channels.clear();
+  m_recordings.clear();
+  m_timers.clear();
+}
+
+size_t CPVRTransferBuffer::Size(void) const
+{
+  return m_groups.size() + m_members.size() + m_channels.size() + m_recordings.size() + m_timers.size();
+}
+
+struct CPVRClientFetches::Execution
+{
+  Execution(const std::vector<Fetch> &fetches, const std::vector<Timing> &timings)
+    : fetches(fetches), timings(timings), next(0), executed(0), finished(true)
+  { }
+
+  std::vector<Fetch>        fetches;
+  std::vector<Timing>       timings;
+  std::atomic<unsigned int> next;
+  std::atomic<unsigned int> executed;
+  CEvent                    finished;
+};
+
+CPVRClientFetches::CPVRClientFetches(CRequestWorkerPool &workers) :
+    m_workers(workers),
+    m_fDuration(0.0)
+{
+}
+
+void CPVRClientFetches::Add(int iClientId, const std::string &strKind, const Fetch &fetch, const Merge &merge /* = Merge() */)
+{
+  Timing timing;
+  timing.iClientId = iClientId;
+  timing.strKind = strKind;
+  timing.error = PVR_ERROR_NO_ERROR;
+  timing.fDuration = 0.0;
+
+  m_fetches.push_back(fetch);
+  m_merges.push_back(merge);
+  m_pending.push_back(timing);
+}
+
+void CPVRClientFetches::Run(const std::shared_ptr<Execution> &execution)
+{
+  const unsigned int size = execution->fetches.size();
+  unsigned int index;
+  while ((index = execution->next++) < size)
+  {
+    Timing &timing = execution->timings[index];
+    int64_t start = CurrentHostCounter();
+    timing.error = execution->fetches[index]();
+    timing.fDuration = 1000.0 * (CurrentHostCounter() - start) / CurrentHostFrequency();
+
+    if (++execution->executed == size)
+      execution->finished.Set();
+  }
+}
+
+PVR_ERROR CPVRClientFetches::Execute(void)
+{
+  PVR_ERROR error(PVR_ERROR_NO_ERROR);
+  m_timings.clear();
+  m_fDuration = 0.0;
+  if (m_fetches.empty())
+    return error;
+
+  int64_t start = CurrentHostCounter();
+  std::shared_ptr<Execution> execution(new Execution(m_fetches, m_pending));
+
+  /* the calling thread fetches as well, so the fetches get done even if the workers are busy */
+  unsigned int helpers = std::min(static_cast<unsigned int>(m_fetches.size()) - 1, m_workers.GetWorkerCount());
+  for (unsigned int i = 0; i < helpers; i++)
+  {
+    if (!m_workers.Submit(std::bind(&CPVRClientFetches::Run, execution)))
+      break;
+  }
+  Run(execution);
+  execution->finished.Wait();
+
+  m_timings = execution->timings;
+  m_fDuration = 1000.0 * (CurrentHostCounter() - start) / CurrentHostFrequency();
+
+  for (unsigned int i = 0; i < m_timings.size(); i++)
+  {
+    const Timing &timing = m_timings[i];
+    if (timing.error != PVR_ERROR_NOT_IMPLEMENTED &&
+        timing.error != PVR_ERROR_NO_ERROR)
+    {
+      CLog::Log(LOGERROR, "PVR - %s - cannot get %s from client '%d': %s", __FUNCTION__, timing.strKind.c_str(), timing.iClientId, CPVRClient::ToString(timing.error));
+      error = timing.error;
+    }
+    else
+      CLog::Log(LOGDEBUG, "PVR - %s - got %s from client '%d' in %.1f ms", __FUNCTION__, timing.strKind.c_str(), timing.iClientId, timing.fDuration);
+
+    if (m_merges[i])
+      m_merges[i]();
+  }
+
+  CLog::Log(LOGDEBUG, "PVR - %s - %u fetches took %.1f ms", __FUNCTION__, static_cast<unsigned int>(m_timings.size()), m_fDuration);
+
+  m_fetches.clear();
+  m_merges.clear();
+  m_pending.clear();
+  return error;
+}
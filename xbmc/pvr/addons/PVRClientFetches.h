@@ -0,0 +1,151 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "addons/include/xbmc_pvr_types.h"
+
+class CRequestWorkerPool;
+
+namespace PVR
+{
+  /*!
+   * @brief Collects the entries an add-on transfers while it is being asked for its data.
+   *
+   * The add-on callbacks add the entries to the buffer instead of the container when the
+   * handle passed to the add-on is set up with SetupHandle(). Transfer() hands them to the
+   * container later on, exactly as if the add-on had transferred them at that time.
+   */
+  class CPVRTransferBuffer
+  {
+  public:
+    /*!
+     * @brief Marks handles of which the data address is a transfer buffer.
+     */
+    static const int HANDLE_IDENTIFIER = 0x50565242;
+
+    /*!
+     * @param target The container the entries are transferred to.
+     */
+    explicit CPVRTransferBuffer(void *target);
+
+    /*!
+     * @brief Set up an add-on handle to collect the entries in this buffer.
+     */
+    void SetupHandle(ADDON_HANDLE_STRUCT &handle);
+
+    void Add(void *addonData, const PVR_CHANNEL_GROUP &entry);
+    void Add(void *addonData, const PVR_CHANNEL_GROUP_MEMBER &entry);
+    void Add(void *addonData, const PVR_CHANNEL &entry);
+    void Add(void *addonData, const PVR_RECORDING &entry);
+    void Add(void *addonData, const PVR_TIMER &entry);
+
+    /*!
+     * @brief Transfer the collected entries to the container in the order they were added.
+     */
+    void Transfer(void);
+
+    /*!
+     * @return The number of collected entries.
+     */
+    size_t Size(void) const;
+
+  private:
+    void                                  *m_target;
+    void                                  *m_addonData;
+    std::vector<PVR_CHANNEL_GROUP>        m_groups;
+    std::vector<PVR_CHANNEL_GROUP_MEMBER> m_members;
+    std::vector<PVR_CHANNEL>              m_channels;
+    std::vector<PVR_RECORDING>            m_recordings;
+    std::vector<PVR_TIMER>                m_timers;
+  };
+
+  /*!
+   * @brief Fetches data from several PVR clients at once.
+   *
+   * Every fetch is added with a merge step. Execute() runs the fetches on a worker pool
+   * and the calling thread, then runs the merge steps on the calling thread in the order
+   * the fetches were added. Fetches must not touch data shared with other fetches, the
+   * merge steps are where the results end up in the shared containers, so the merged
+   * data doesn't depend on which backend answered first.
+   */
+  class CPVRClientFetches
+  {
+  public:
+    typedef std::function<PVR_ERROR(void)> Fetch;
+    typedef std::function<void(void)>      Merge;
+
+    struct Timing
+    {
+      int         iClientId;
+      std::string strKind;
+      PVR_ERROR   error;
+      double      fDuration; /*!< milliseconds the fetch took */
+    };
+
+    /*!
+     * @param workers The pool helping with the fetches. If it isn't running or busy the
+     * calling thread does all of the work.
+     */
+    explicit CPVRClientFetches(CRequestWorkerPool &workers);
+
+    /*!
+     * @brief Add a fetch.
+     * @param iClientId The client the data is fetched from.
+     * @param strKind The kind of data fetched, used for logging.
+     * @param fetch Fetches the data.
+     * @param merge Adds the fetched data to the shared containers.
+     */
+    void Add(int iClientId, const std::string &strKind, const Fetch &fetch, const Merge &merge = Merge());
+
+    /*!
+     * @brief Run all added fetches and merge their results.
+     * @return PVR_ERROR_NO_ERROR if all fetches succeeded or weren't implemented by the
+     * client, the error of the last failed fetch otherwise.
+     */
+    PVR_ERROR Execute(void);
+
+    /*!
+     * @return The timings of the fetches of the last call to Execute() in the order they were added.
+     */
+    const std::vector<Timing> &GetTimings(void) const { return m_timings; }
+
+    /*!
+     * @return Milliseconds the last call to Execute() took.
+     */
+    double GetDuration(void) const { return m_fDuration; }
+
+  private:
+    struct Execution;
+
+    static void Run(const std::shared_ptr<Execution> &execution);
+
+    CRequestWorkerPool  &m_workers;
+    std::vector<Fetch>  m_fetches;
+    std::vector<Merge>  m_merges;
+    std::vector<Timing> m_pending;
+    std::vector<Timing> m_timings;
+    double              m_fDuration;
+  };
+}
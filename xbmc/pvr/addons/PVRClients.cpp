@@ -31,6 +31,7 @@
 #include "guilib/GUIWindowManager.h"
 #include "GUIUserMessages.h"
 #include "messaging/ApplicationMessenger.h"
+#include "pvr/addons/PVRClientFetches.h"
 #include "pvr/channels/PVRChannelGroupInternal.h"
 #include "pvr/channels/PVRChannelGroups.h"
 #include "pvr/PVRManager.h"
@@ -48,6 +49,10 @@ using namespace KODI::MESSAGING;
 #define PVR_CLIENT_AVAHI_SCAN_ITERATIONS   (20)
 /** sleep time in milliseconds when no auto-configured add-ons were found */
 #define PVR_CLIENT_AVAHI_SLEEP_TIME_MS     (250)
+/** number of threads fetching data from the clients, next to the thread asking for it */
+#define PVR_CLIENT_FETCH_WORKERS           (3)
+/** maximum number of fetches waiting for a thread */
+#define PVR_CLIENT_FETCH_MAX_QUEUED        (64)
 
 CPVRClients::CPVRClients(void) :
     CThread("PVRClient"),
@@ -57,7 +62,8 @@ CPVRClients::CPVRClients(void) :
     m_bIsPlayingLiveTV(false),
     m_bIsPlayingRecording(false),
     m_bNoAddonWarningDisplayed(false),
-    m_bRestartManagerOnAddonDisabled(false)
+    m_bRestartManagerOnAddonDisabled(false),
+    m_fetchWorkers("PVRClientFetch", PVR_CLIENT_FETCH_MAX_QUEUED)
 {
 }
 
@@ -80,6 +86,8 @@ void CPVRClients::Start(void)
 {
   Stop();
 
+  m_fetchWorkers.Start(PVR_CLIENT_FETCH_WORKERS);
+
   Create();
   SetPriority(-1);
 }
@@ -87,6 +95,7 @@ void CPVRClients::Start(void)
 void CPVRClients::Stop(void)
 {
   StopThread();
+  m_fetchWorkers.Stop();
 }
 
 bool CPVRClients::IsConnectedClient(int iClientId) const
@@ -461,23 +470,11 @@ bool CPVRClients::HasTimerSupport(int iClientId)
 
 PVR_ERROR CPVRClients::GetTimers(CPVRTimers *timers)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetConnectedClients(clients);
-
-  /* get the timer list from each client */
-  for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
-  {
-    PVR_ERROR currentError = (*itrClients).second->GetTimers(timers);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      CLog::Log(LOGERROR, "PVR - %s - cannot get timers from client '%d': %s",__FUNCTION__, (*itrClients).first, CPVRClient::ToString(currentError));
-      error = currentError;
-    }
-  }
-
-  return error;
+  CPVRClientFetches fetches(m_fetchWorkers);
+  AddFetches(fetches, "timers", timers, [timers](const PVR_CLIENT &client, CPVRTransferBuffer *buffer) {
+    return client->GetTimers(timers, buffer);
+  });
+  return fetches.Execute();
 }
 
 PVR_ERROR CPVRClients::AddTimer(const CPVRTimerInfoTag &timer)
@@ -576,22 +573,23 @@ PVR_ERROR CPVRClients::GetTimerTypes(CPVRTimerTypes& results, int iClientId) con
 
 PVR_ERROR CPVRClients::GetRecordings(CPVRRecordings *recordings, bool deleted)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetConnectedClients(clients);
-
-  for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
-  {
-    PVR_ERROR currentError = (*itrClients).second->GetRecordings(recordings, deleted);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      CLog::Log(LOGERROR, "PVR - %s - cannot get recordings from client '%d': %s",__FUNCTION__, (*itrClients).first, CPVRClient::ToString(currentError));
-      error = currentError;
-    }
-  }
+  CPVRClientFetches fetches(m_fetchWorkers);
+  AddFetches(fetches, deleted ? "deleted recordings" : "recordings", recordings, [recordings, deleted](const PVR_CLIENT &client, CPVRTransferBuffer *buffer) {
+    return client->GetRecordings(recordings, deleted, buffer);
+  });
+  return fetches.Execute();
+}
 
-  return error;
+PVR_ERROR CPVRClients::GetRecordings(CPVRRecordings *recordings)
+{
+  CPVRClientFetches fetches(m_fetchWorkers);
+  AddFetches(fetches, "recordings", recordings, [recordings](const PVR_CLIENT &client, CPVRTransferBuffer *buffer) {
+    return client->GetRecordings(recordings, false, buffer);
+  });
+  AddFetches(fetches, "deleted recordings", recordings, [recordings](const PVR_CLIENT &client, CPVRTransferBuffer *buffer) {
+    return client->GetRecordings(recordings, true, buffer);
+  });
+  return fetches.Execute();
 }
 
 PVR_ERROR CPVRClients::RenameRecording(const CPVRRecording &recording)
@@ -797,64 +795,45 @@ PVR_ERROR CPVRClients::GetEPGForChannel(const CPVRChannelPtr &channel, CEpg *epg
 
 PVR_ERROR CPVRClients::GetChannels(CPVRChannelGroupInternal *group)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetConnectedClients(clients);
-
-  /* get the channel list from each client */
-  for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
-  {
-    PVR_ERROR currentError = (*itrClients).second->GetChannels(*group, group->IsRadio());
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      error = currentError;
-      CLog::Log(LOGERROR, "PVR - %s - cannot get channels from client '%d': %s",__FUNCTION__, (*itrClients).first, CPVRClient::ToString(error));
-    }
-  }
-
-  return error;
+  CPVRClientFetches fetches(m_fetchWorkers);
+  AddFetches(fetches, "channels", group, [group](const PVR_CLIENT &client, CPVRTransferBuffer *buffer) {
+    return client->GetChannels(*group, group->IsRadio(), buffer);
+  });
+  return fetches.Execute();
 }
 
 PVR_ERROR CPVRClients::GetChannelGroups(CPVRChannelGroups *groups)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetConnectedClients(clients);
-
-  for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
-  {
-    PVR_ERROR currentError = (*itrClients).second->GetChannelGroups(groups);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      error = currentError;
-      CLog::Log(LOGERROR, "PVR - %s - cannot get groups from client '%d': %s",__FUNCTION__, (*itrClients).first, CPVRClient::ToString(error));
-    }
-  }
-
-  return error;
+  CPVRClientFetches fetches(m_fetchWorkers);
+  AddFetches(fetches, "groups", groups, [groups](const PVR_CLIENT &client, CPVRTransferBuffer *buffer) {
+    return client->GetChannelGroups(groups, buffer);
+  });
+  return fetches.Execute();
 }
 
 PVR_ERROR CPVRClients::GetChannelGroupMembers(CPVRChannelGroup *group)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
+  CPVRClientFetches fetches(m_fetchWorkers);
+  AddFetches(fetches, "group members", group, [group](const PVR_CLIENT &client, CPVRTransferBuffer *buffer) {
+    return client->GetChannelGroupMembers(group, buffer);
+  });
+  return fetches.Execute();
+}
+
+void CPVRClients::AddFetches(CPVRClientFetches &fetches, const std::string &strKind, void *target, const ClientFetch &fetch) const
+{
   PVR_CLIENTMAP clients;
   GetConnectedClients(clients);
 
-  /* get the member list from each client */
+  /* the clients transfer their data to buffers which are added to the container in the order of the clients */
   for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
   {
-    PVR_ERROR currentError = (*itrClients).second->GetChannelGroupMembers(group);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      error = currentError;
-      CLog::Log(LOGERROR, "PVR - %s - cannot get group members from client '%d': %s",__FUNCTION__, (*itrClients).first, CPVRClient::ToString(error));
-    }
+    PVR_CLIENT client(itrClients->second);
+    std::shared_ptr<CPVRTransferBuffer> buffer(new CPVRTransferBuffer(target));
+    fetches.Add(itrClients->first, strKind,
+                std::bind(fetch, client, buffer.get()),
+                std::bind(&CPVRTransferBuffer::Transfer, buffer));
   }
-
-  return error;
 }
 
 bool CPVRClients::HasMenuHooks(int iClientID, PVR_MENUHOOK_CAT cat)
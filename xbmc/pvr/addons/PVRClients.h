@@ -20,6 +20,7 @@
  */
 
 #include "addons/AddonDatabase.h"
+#include "network/RequestWorkerPool.h"
 #include "threads/CriticalSection.h"
 #include "threads/Thread.h"
 #include "utils/Observer.h"
@@ -30,6 +31,7 @@
 #include "PVRClient.h"
 
 #include <deque>
+#include <functional>
 #include <vector>
 
 namespace EPG
@@ -39,7 +41,9 @@ namespace EPG
 
 namespace PVR
 {
+  class CPVRClientFetches;
   class CPVRGUIInfo;
+  class CPVRTransferBuffer;
 
   typedef std::shared_ptr<CPVRClient> PVR_CLIENT;
   typedef std::map< int, PVR_CLIENT >                 PVR_CLIENTMAP;
@@ -434,6 +438,13 @@ namespace PVR
      */
     PVR_ERROR GetRecordings(CPVRRecordings *recordings, bool deleted);
 
+    /*!
+     * @brief Get all recordings and deleted recordings from clients
+     * @param recordings Store the recordings in this container.
+     * @return PVR_ERROR_NO_ERROR if the recordings have been fetched successfully.
+     */
+    PVR_ERROR GetRecordings(CPVRRecordings *recordings);
+
     /*!
      * @brief Rename a recordings on the backend.
      * @param recording The recordings to rename.
@@ -680,7 +691,23 @@ namespace PVR
 
     bool IsRealTimeStream() const;
 
+    /*!
+     * @brief The pool fetching data from several clients at once, see CPVRClientFetches.
+     */
+    CRequestWorkerPool &GetFetchWorkers(void) { return m_fetchWorkers; }
+
   private:
+    typedef std::function<PVR_ERROR(const PVR_CLIENT &client, CPVRTransferBuffer *buffer)> ClientFetch;
+
+    /*!
+     * @brief Add a fetch for every connected client.
+     * @param fetches The fetches to add to.
+     * @param strKind The kind of data fetched, used for logging.
+     * @param target The container the data is transferred to.
+     * @param fetch Fetches the data of a client, transferring it to the buffer.
+     */
+    void AddFetches(CPVRClientFetches &fetches, const std::string &strKind, void *target, const ClientFetch &fetch) const;
+
     /*!
      * @brief Update add-ons from the AddonManager
      * @return True when updated, false otherwise
@@ -770,5 +797,6 @@ namespace PVR
     std::map<int, time_t> m_connectionAttempts;       /*!< last connection attempt per add-on */
     bool                  m_bRestartManagerOnAddonDisabled; /*!< true to restart the manager when an add-on is enabled/disabled */
     std::map<std::string, int> m_addonNameIds; /*!< map add-on names to IDs */
+    CRequestWorkerPool    m_fetchWorkers;             /*!< fetches the data of several clients at once */
   };
 }
@@ -31,6 +31,7 @@
 #include "pvr/addons/PVRClients.h"
 
 #include "PVRRecording.h"
+#include "PVRRecordings.h"
 
 using namespace PVR;
 using namespace EPG;
@@ -251,6 +252,9 @@ bool CPVRRecording::SetPlayCount(int count)
 {
   PVR_ERROR error;
   m_playCount = count;
+  if (g_PVRRecordings)
+    g_PVRRecordings->OnPlayCountChanged(*this);
+
   if (g_PVRClients->SupportsRecordingPlayCount(m_iClientId) &&
       !g_PVRClients->SetRecordingPlayCount(*this, count, &error))
   {
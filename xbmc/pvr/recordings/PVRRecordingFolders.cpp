@@ -0,0 +1,193 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "PVRRecordingFolders.h"
+
+#include "utils/StringUtils.h"
+
+using namespace PVR;
+
+CPVRRecordingFolders::CPVRRecordingFolders(void)
+{
+  m_root.parent = NULL;
+  m_root.iUnwatched = 0;
+}
+
+CPVRRecordingFolders::~CPVRRecordingFolders(void)
+{
+  Clear();
+}
+
+void CPVRRecordingFolders::Split(const std::string &strDirectory, std::vector<std::string> &names)
+{
+  /* empty names, like the ones around leading and trailing slashes, aren't folders */
+  size_t iStart = 0;
+  while (iStart < strDirectory.size())
+  {
+    size_t iEnd = strDirectory.find('/', iStart);
+    if (iEnd == std::string::npos)
+      iEnd = strDirectory.size();
+    if (iEnd > iStart)
+      names.push_back(strDirectory.substr(iStart, iEnd - iStart));
+    iStart = iEnd + 1;
+  }
+}
+
+const CPVRRecordingFolders::Node *CPVRRecordingFolders::Find(const std::string &strDirectory) const
+{
+  std::vector<std::string> names;
+  Split(strDirectory, names);
+
+  const Node *node = &m_root;
+  for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+  {
+    std::string strKey(*it);
+    StringUtils::ToLower(strKey);
+    NODEMAP::const_iterator child = node->children.find(strKey);
+    if (child == node->children.end())
+      return NULL;
+    node = child->second;
+  }
+
+  return node;
+}
+
+CPVRRecordingFolders::Node *CPVRRecordingFolders::Create(const std::string &strDirectory)
+{
+  std::vector<std::string> names;
+  Split(strDirectory, names);
+
+  Node *node = &m_root;
+  for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+  {
+    std::string strKey(*it);
+    StringUtils::ToLower(strKey);
+    NODEMAP::iterator child = node->children.find(strKey);
+    if (child == node->children.end())
+    {
+      Node *newNode = new Node;
+      newNode->parent = node;
+      newNode->strKey = strKey;
+      newNode->strName = *it;
+      newNode->iUnwatched = 0;
+      child = node->children.insert(std::make_pair(strKey, newNode)).first;
+    }
+    node = child->second;
+  }
+
+  return node;
+}
+
+void CPVRRecordingFolders::Delete(Node *node)
+{
+  for (NODEMAP::iterator it = node->children.begin(); it != node->children.end(); ++it)
+    Delete(it->second);
+  delete node;
+}
+
+void CPVRRecordingFolders::Add(unsigned int iId, const std::string &strDirectory, const CDateTime &time, bool bUnwatched)
+{
+  Remove(iId);
+
+  Entry entry;
+  entry.node = Create(strDirectory);
+  entry.time = time;
+  entry.bUnwatched = bUnwatched;
+  m_entries.insert(std::make_pair(iId, entry));
+
+  entry.node->recordings.insert(iId);
+  for (Node *node = entry.node; node; node = node->parent)
+  {
+    node->times.insert(time);
+    if (bUnwatched)
+      node->iUnwatched++;
+  }
+}
+
+void CPVRRecordingFolders::Remove(unsigned int iId)
+{
+  std::map<unsigned int, Entry>::iterator it = m_entries.find(iId);
+  if (it == m_entries.end())
+    return;
+
+  const Entry &entry = it->second;
+  entry.node->recordings.erase(iId);
+
+  Node *node = entry.node;
+  while (node)
+  {
+    node->times.erase(node->times.find(entry.time));
+    if (entry.bUnwatched)
+      node->iUnwatched--;
+
+    Node *parent = node->parent;
+    /* folders without recordings below them are gone */
+    if (parent && node->times.empty())
+    {
+      parent->children.erase(node->strKey);
+      Delete(node);
+    }
+    node = parent;
+  }
+
+  m_entries.erase(it);
+}
+
+void CPVRRecordingFolders::Clear(void)
+{
+  for (NODEMAP::iterator it = m_root.children.begin(); it != m_root.children.end(); ++it)
+    Delete(it->second);
+  m_root.children.clear();
+  m_root.recordings.clear();
+  m_root.times.clear();
+  m_root.iUnwatched = 0;
+  m_entries.clear();
+}
+
+bool CPVRRecordingFolders::GetSubFolders(const std::string &strDirectory, std::vector<Folder> &folders) const
+{
+  const Node *node = Find(strDirectory);
+  if (!node)
+    return false;
+
+  folders.reserve(folders.size() + node->children.size());
+  for (NODEMAP::const_iterator it = node->children.begin(); it != node->children.end(); ++it)
+  {
+    const Node *child = it->second;
+    Folder folder;
+    folder.strName = child->strName;
+    folder.iRecordings = child->times.size();
+    folder.iUnwatched = child->iUnwatched;
+    folder.newest = *child->times.rbegin();
+    folders.push_back(folder);
+  }
+
+  return true;
+}
+
+bool CPVRRecordingFolders::GetRecordings(const std::string &strDirectory, std::vector<unsigned int> &ids) const
+{
+  const Node *node = Find(strDirectory);
+  if (!node)
+    return false;
+
+  ids.insert(ids.end(), node->recordings.begin(), node->recordings.end());
+  return true;
+}
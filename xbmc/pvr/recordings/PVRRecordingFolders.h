@@ -0,0 +1,127 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "XBDateTime.h"
+
+namespace PVR
+{
+  /*!
+   * @brief Tree of the directories of the active recordings.
+   *
+   * Every folder knows its sub folders, the recordings directly in it and the number,
+   * the newest recording time and the number of unwatched recordings of all recordings
+   * below it. Folder names are matched case-insensitively, the name shown for a folder
+   * is the one of the first recording added to it.
+   */
+  class CPVRRecordingFolders
+  {
+  public:
+    struct Folder
+    {
+      std::string  strName;
+      unsigned int iRecordings; /*!< recordings in the folder and its sub folders */
+      unsigned int iUnwatched;  /*!< unwatched recordings in the folder and its sub folders */
+      CDateTime    newest;      /*!< time of the newest recording in the folder and its sub folders */
+    };
+
+    CPVRRecordingFolders(void);
+    virtual ~CPVRRecordingFolders(void);
+
+    /*!
+     * @brief Add a recording or update it if it was added before.
+     * @param iId The unique id of the recording.
+     * @param strDirectory The directory of the recording, sub folders separated by '/'.
+     * @param time The recording time.
+     * @param bUnwatched True if the recording wasn't watched yet.
+     */
+    void Add(unsigned int iId, const std::string &strDirectory, const CDateTime &time, bool bUnwatched);
+
+    /*!
+     * @brief Remove a recording.
+     * @param iId The unique id of the recording.
+     */
+    void Remove(unsigned int iId);
+
+    /*!
+     * @brief Remove all recordings and folders.
+     */
+    void Clear(void);
+
+    /*!
+     * @brief Get the direct sub folders of a folder.
+     * @param strDirectory The folder.
+     * @param folders The sub folders in the order of their names.
+     * @return False if there is no such folder.
+     */
+    bool GetSubFolders(const std::string &strDirectory, std::vector<Folder> &folders) const;
+
+    /*!
+     * @brief Get the recordings directly in a folder.
+     * @param strDirectory The folder.
+     * @param ids The ids of the recordings.
+     * @return False if there is no such folder.
+     */
+    bool GetRecordings(const std::string &strDirectory, std::vector<unsigned int> &ids) const;
+
+    /*!
+     * @return The number of recordings.
+     */
+    size_t Size(void) const { return m_entries.size(); }
+
+  private:
+    CPVRRecordingFolders(const CPVRRecordingFolders &) = delete;
+    CPVRRecordingFolders &operator=(const CPVRRecordingFolders &) = delete;
+
+    struct Node;
+    typedef std::map<std::string, Node*> NODEMAP;
+
+    struct Node
+    {
+      Node                   *parent;
+      std::string            strKey;
+      std::string            strName;
+      NODEMAP                children;
+      std::set<unsigned int> recordings;
+      std::multiset<CDateTime> times;
+      unsigned int           iUnwatched;
+    };
+
+    struct Entry
+    {
+      Node      *node;
+      CDateTime time;
+      bool      bUnwatched;
+    };
+
+    const Node *Find(const std::string &strDirectory) const;
+    Node *Create(const std::string &strDirectory);
+    static void Split(const std::string &strDirectory, std::vector<std::string> &names);
+    static void Delete(Node *node);
+
+    Node                          m_root;
+    std::map<unsigned int, Entry> m_entries;
+  };
+}
@@ -21,6 +21,7 @@
 #include "PVRRecordings.h"
 
 #include <utility>
+#include <vector>
 
 #include "epg/EpgContainer.h"
 #include "FileItem.h"
@@ -54,8 +55,7 @@ void CPVRRecordings::UpdateFromClients(void)
 {
   CSingleLock lock(m_critSection);
   Clear();
-  g_PVRClients->GetRecordings(this, false);
-  g_PVRClients->GetRecordings(this, true);
+  g_PVRClients->GetRecordings(this);
 }
 
 std::string CPVRRecordings::TrimSlashes(const std::string &strOrig) const
@@ -69,31 +69,6 @@ std::string CPVRRecordings::TrimSlashes(const std::string &strOrig) const
   return strReturn;
 }
 
-const std::string CPVRRecordings::GetDirectoryFromPath(const std::string &strPath, const std::string &strBase) const
-{
-  std::string strReturn;
-  std::string strUsePath = TrimSlashes(strPath);
-  std::string strUseBase = TrimSlashes(strBase);
-
-  /* strip the base or return an empty value if it doesn't fit or match */
-  if (!strUseBase.empty())
-  {
-    /* adding "/" to make sure that base matches the complete folder name and not only parts of it */
-    if (strUsePath.size() <= strUseBase.size() || !StringUtils::StartsWith(strUsePath, strUseBase + "/"))
-      return strReturn;
-    strUsePath.erase(0, strUseBase.size());
-  }
-
-  /* check for more occurences */
-  size_t iDelimiter = strUsePath.find('/');
-  if (iDelimiter != std::string::npos && iDelimiter > 0)
-    strReturn = strUsePath.substr(0, iDelimiter);
-  else
-    strReturn = strUsePath;
-
-  return TrimSlashes(strReturn);
-}
-
 bool CPVRRecordings::IsDirectoryMember(const std::string &strDirectory, const std::string &strEntryDirectory) const
 {
   std::string strUseDirectory = TrimSlashes(strDirectory);
@@ -107,56 +82,38 @@ bool CPVRRecordings::IsDirectoryMember(const std::string &strDirectory, const st
 
 void CPVRRecordings::GetSubDirectories(const std::string &strBase, CFileItemList *results)
 {
-  // Only active recordings are fetched to provide sub directories.
+  // Only active recordings are in the folders.
   // Not applicable for deleted view which is supposed to be flattened.
   std::string strUseBase = TrimSlashes(strBase);
-  std::set<CFileItemPtr> unwatchedFolders;
+  std::vector<CPVRRecordingFolders::Folder> folders;
+  m_folders.GetSubFolders(strUseBase, folders);
 
-  for (PVR_RECORDINGMAP_CITR it = m_recordings.begin(); it != m_recordings.end(); it++)
+  for (std::vector<CPVRRecordingFolders::Folder>::const_iterator it = folders.begin(); it != folders.end(); ++it)
   {
-    CPVRRecordingPtr current = it->second;
-    if (current->IsDeleted())
-      continue;
-    const std::string strCurrent = GetDirectoryFromPath(current->m_strDirectory, strUseBase);
-    if (strCurrent.empty())
-      continue;
-
     std::string strFilePath;
     if(strUseBase.empty())
-      strFilePath = StringUtils::Format("pvr://" PVR_RECORDING_BASE_PATH "/" PVR_RECORDING_ACTIVE_PATH "/%s/", strCurrent.c_str());
+      strFilePath = StringUtils::Format("pvr://" PVR_RECORDING_BASE_PATH "/" PVR_RECORDING_ACTIVE_PATH "/%s/", it->strName.c_str());
     else
-      strFilePath = StringUtils::Format("pvr://" PVR_RECORDING_BASE_PATH "/" PVR_RECORDING_ACTIVE_PATH "/%s/%s/", strUseBase.c_str(), strCurrent.c_str());
-
-    CFileItemPtr pFileItem;
-    if (m_database.IsOpen())
-      current->UpdateMetadata(m_database);
-
-    if (!results->Contains(strFilePath))
-    {
-      pFileItem.reset(new CFileItem(strCurrent, true));
-      pFileItem->SetPath(strFilePath);
-      pFileItem->SetLabel(strCurrent);
-      pFileItem->SetLabelPreformated(true);
-      pFileItem->m_dateTime = current->RecordingTimeAsLocalTime();
+      strFilePath = StringUtils::Format("pvr://" PVR_RECORDING_BASE_PATH "/" PVR_RECORDING_ACTIVE_PATH "/%s/%s/", strUseBase.c_str(), it->strName.c_str());
 
-      // Assume all folders are watched, we'll change the overlay later
-      pFileItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_WATCHED, false);
-      results->Add(pFileItem);
-    }
-    else
-    {
-      pFileItem=results->Get(strFilePath);
-      if (pFileItem->m_dateTime<current->RecordingTimeAsLocalTime())
-        pFileItem->m_dateTime  = current->RecordingTimeAsLocalTime();
-    }
+    CFileItemPtr pFileItem(new CFileItem(it->strName, true));
+    pFileItem->SetPath(strFilePath);
+    pFileItem->SetLabel(it->strName);
+    pFileItem->SetLabelPreformated(true);
+    pFileItem->m_dateTime = it->newest;
 
-    if (current->m_playCount == 0)
-      unwatchedFolders.insert(pFileItem);
+    // Folders containing unwatched entries don't get the watched overlay
+    pFileItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_WATCHED, it->iUnwatched > 0);
+    results->Add(pFileItem);
   }
+}
 
-  // Remove the watched overlay from folders containing unwatched entries
-  for (std::set<CFileItemPtr>::iterator it = unwatchedFolders.begin(); it != unwatchedFolders.end(); ++it)
-    (*it)->SetOverlayImage(CGUIListItem::ICON_OVERLAY_WATCHED, true);
+void CPVRRecordings::UpdateFolders(const CPVRRecordingPtr &recording)
+{
+  if (recording->IsDeleted())
+    m_folders.Remove(recording->m_iRecordingId);
+  else
+    m_folders.Add(recording->m_iRecordingId, recording->m_strDirectory, recording->RecordingTimeAsLocalTime(), recording->m_playCount == 0);
 }
 
 int CPVRRecordings::Load(void)
@@ -360,13 +317,28 @@ bool CPVRRecordings::GetDirectory(const std::string& strPath, CFileItemList &ite
       GetSubDirectories(strDirectoryPath, &items);
 
     // get all files of the currrent directory or recursively all files starting at the current directory if in flatten mode
-    for (PVR_RECORDINGMAP_CITR it = m_recordings.begin(); it != m_recordings.end(); it++)
+    std::vector<CPVRRecordingPtr> recordings;
+    if (!bDeleted && m_bGroupItems)
     {
-      CPVRRecordingPtr current = it->second;
+      std::vector<unsigned int> ids;
+      m_folders.GetRecordings(TrimSlashes(strDirectoryPath), ids);
+      recordings.reserve(ids.size());
+      for (std::vector<unsigned int>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+        recordings.push_back(m_recordingsById[*it]);
+    }
+    else
+    {
+      for (PVR_RECORDINGMAP_CITR it = m_recordings.begin(); it != m_recordings.end(); it++)
+      {
+        // skip items that are not members of the target directory
+        if (IsDirectoryMember(strDirectoryPath, it->second->m_strDirectory) && it->second->IsDeleted() == bDeleted)
+          recordings.push_back(it->second);
+      }
+    }
 
-      // skip items that are not members of the target directory
-      if (!IsDirectoryMember(strDirectoryPath, current->m_strDirectory) || current->IsDeleted() != bDeleted)
-        continue;
+    for (std::vector<CPVRRecordingPtr>::const_iterator it = recordings.begin(); it != recordings.end(); ++it)
+    {
+      CPVRRecordingPtr current = *it;
 
       if (m_database.IsOpen())
         current->UpdateMetadata(m_database);
@@ -428,11 +400,9 @@ CFileItemPtr CPVRRecordings::GetById(unsigned int iId) const
 {
   CFileItemPtr item;
   CSingleLock lock(m_critSection);
-  for (PVR_RECORDINGMAP_CITR it = m_recordings.begin(); it != m_recordings.end(); it++)
-  {
-    if (iId == it->second->m_iRecordingId)
-      item = CFileItemPtr(new CFileItem(it->second));
-  }
+  std::map<unsigned int, CPVRRecordingPtr>::const_iterator it = m_recordingsById.find(iId);
+  if (it != m_recordingsById.end())
+    item = CFileItemPtr(new CFileItem(it->second));
 
   return item;
 }
@@ -482,6 +452,8 @@ void CPVRRecordings::Clear()
   CSingleLock lock(m_critSection);
   m_bHasDeleted = false;
   m_recordings.clear();
+  m_recordingsById.clear();
+  m_folders.Clear();
 }
 
 void CPVRRecordings::UpdateFromClient(const CPVRRecordingPtr &tag)
@@ -508,7 +480,21 @@ void CPVRRecordings::UpdateFromClient(const CPVRRecordingPtr &tag)
     }
     newTag->m_iRecordingId = ++m_iLastId;
     m_recordings.insert(std::make_pair(CPVRRecordingUid(newTag->m_iClientId, newTag->m_strRecordingId), newTag));
+    m_recordingsById.insert(std::make_pair(newTag->m_iRecordingId, newTag));
   }
+
+  // the watched state of the folders needs the play count from the database
+  if (m_database.IsOpen())
+    newTag->UpdateMetadata(m_database);
+  UpdateFolders(newTag);
+}
+
+void CPVRRecordings::OnPlayCountChanged(const CPVRRecording &recording)
+{
+  CSingleLock lock(m_critSection);
+  PVR_RECORDINGMAP_CITR it = m_recordings.find(CPVRRecordingUid(recording.m_iClientId, recording.m_strRecordingId));
+  if (it != m_recordings.end() && it->second.get() == &recording)
+    UpdateFolders(it->second);
 }
 
 void CPVRRecordings::UpdateEpgTags(void)
@@ -24,6 +24,7 @@
 #include "video/VideoDatabase.h"
 
 #include "PVRRecording.h"
+#include "PVRRecordingFolders.h"
 
 #define PVR_ALL_RECORDINGS_PATH_EXTENSION "-1"
 
@@ -39,6 +40,8 @@ namespace PVR
     CCriticalSection             m_critSection;
     bool                         m_bIsUpdating;
     PVR_RECORDINGMAP             m_recordings;
+    std::map<unsigned int, CPVRRecordingPtr> m_recordingsById;
+    CPVRRecordingFolders         m_folders;
     unsigned int                 m_iLastId;
     bool                         m_bGroupItems;
     CVideoDatabase               m_database;
@@ -46,10 +49,15 @@ namespace PVR
 
     virtual void UpdateFromClients(void);
     virtual std::string TrimSlashes(const std::string &strOrig) const;
-    virtual const std::string GetDirectoryFromPath(const std::string &strPath, const std::string &strBase) const;
     virtual bool IsDirectoryMember(const std::string &strDirectory, const std::string &strEntryDirectory) const;
     virtual void GetSubDirectories(const std::string &strBase, CFileItemList *results);
 
+    /**
+     * @brief add a recording to the folders or move it to the folder it is in now
+     * @param recording the recording
+     */
+    void UpdateFolders(const CPVRRecordingPtr &recording);
+
     /**
      * @brief recursively deletes all recordings in the specified directory
      * @param item the directory
@@ -88,6 +96,12 @@ namespace PVR
     bool RenameRecording(CFileItem &item, std::string &strNewName);
     bool SetRecordingsPlayCount(const CFileItemPtr &item, int count);
 
+    /**
+     * @brief update the watched state of the folders of a recording after its play count changed
+     * @param recording the recording
+     */
+    void OnPlayCountChanged(const CPVRRecording &recording);
+
     bool GetDirectory(const std::string& strPath, CFileItemList &items);
     CFileItemPtr GetByPath(const std::string &path);
     CPVRRecordingPtr GetById(int iClientId, const std::string &strRecordingId) const;
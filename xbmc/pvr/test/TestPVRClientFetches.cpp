@@ -0,0 +1,238 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "network/RequestWorkerPool.h"
+#include "pvr/addons/PVRClientFetches.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+
+#include "gtest/gtest.h"
+
+using namespace PVR;
+
+#define LATENCY_MS 100
+
+namespace
+{
+  /* stands in for a PVR add-on answering after a fixed latency */
+  class CStandInClient
+  {
+  public:
+    CStandInClient(int iClientId, unsigned int iLatency, PVR_ERROR error = PVR_ERROR_NO_ERROR)
+      : m_iClientId(iClientId), m_iLatency(iLatency), m_error(error)
+    { }
+
+    PVR_ERROR Get(const std::string &strKind, std::vector<std::string> &entries) const
+    {
+      m_active++;
+      unsigned int active = m_active;
+      unsigned int peak = m_peak;
+      while (active > peak && !m_peak.compare_exchange_weak(peak, active))
+        ;
+
+      XbmcThreads::ThreadSleep(m_iLatency);
+      for (unsigned int i = 0; i < 3; i++)
+        entries.push_back(StringUtils::Format("%d-%s-%u", m_iClientId, strKind.c_str(), i));
+
+      m_active--;
+      return m_error;
+    }
+
+    void AddFetch(CPVRClientFetches &fetches, const std::string &strKind, std::vector<std::string> &merged) const
+    {
+      CStandInClient client(*this);
+      std::shared_ptr<std::vector<std::string> > entries(new std::vector<std::string>);
+      fetches.Add(m_iClientId, strKind,
+                  [client, strKind, entries]() { return client.Get(strKind, *entries); },
+                  [entries, &merged]() { merged.insert(merged.end(), entries->begin(), entries->end()); });
+    }
+
+    static unsigned int GetPeak() { return m_peak; }
+    static void ResetPeak() { m_peak = 0; }
+
+  private:
+    int          m_iClientId;
+    unsigned int m_iLatency;
+    PVR_ERROR    m_error;
+
+    static std::atomic<unsigned int> m_active;
+    static std::atomic<unsigned int> m_peak;
+  };
+
+  std::atomic<unsigned int> CStandInClient::m_active(0);
+  std::atomic<unsigned int> CStandInClient::m_peak(0);
+}
+
+static const char *const kinds[] = { "channels", "groups", "timers", "recordings" };
+
+TEST(TestPVRClientFetches, Concurrent)
+{
+  CRequestWorkerPool workers("TestPVRClientFetch", 64);
+  workers.Start(7);
+
+  std::vector<CStandInClient> clients;
+  for (int i = 1; i <= 4; i++)
+    clients.push_back(CStandInClient(i, LATENCY_MS));
+
+  std::vector<std::string> merged;
+  CPVRClientFetches fetches(workers);
+  for (unsigned int kind = 0; kind < sizeof(kinds) / sizeof(kinds[0]); kind++)
+  {
+    for (std::vector<CStandInClient>::const_iterator it = clients.begin(); it != clients.end(); ++it)
+      it->AddFetch(fetches, kinds[kind], merged);
+  }
+
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, fetches.Execute());
+  EXPECT_EQ(16u * 3, merged.size());
+  ASSERT_EQ(16u, fetches.GetTimings().size());
+  double fSum = 0.0;
+  for (std::vector<CPVRClientFetches::Timing>::const_iterator it = fetches.GetTimings().begin(); it != fetches.GetTimings().end(); ++it)
+  {
+    EXPECT_GE(it->fDuration, LATENCY_MS * 0.9);
+    fSum += it->fDuration;
+  }
+
+  // 16 fetches on 8 threads take two rounds
+  EXPECT_LT(fetches.GetDuration(), fSum / 4);
+  CLog::Log(LOGNOTICE, "TestPVRClientFetches: 4 clients, 4 kinds, %u ms latency: %.1f ms fetching at once, %.1f ms one after another",
+            LATENCY_MS, fetches.GetDuration(), fSum);
+
+  workers.Stop();
+}
+
+TEST(TestPVRClientFetches, Deterministic)
+{
+  CRequestWorkerPool workers("TestPVRClientFetch", 64);
+  workers.Start(4);
+
+  // the first client is the slowest
+  std::vector<CStandInClient> clients;
+  for (int i = 1; i <= 4; i++)
+    clients.push_back(CStandInClient(i, LATENCY_MS / i));
+
+  std::vector<std::string> merged;
+  CPVRClientFetches fetches(workers);
+  for (std::vector<CStandInClient>::const_iterator it = clients.begin(); it != clients.end(); ++it)
+    it->AddFetch(fetches, "channels", merged);
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, fetches.Execute());
+
+  ASSERT_EQ(12u, merged.size());
+  for (unsigned int i = 0; i < merged.size(); i++)
+    EXPECT_EQ(StringUtils::Format("%u-channels-%u", i / 3 + 1, i % 3), merged[i]);
+  for (unsigned int i = 0; i < fetches.GetTimings().size(); i++)
+    EXPECT_EQ(static_cast<int>(i + 1), fetches.GetTimings()[i].iClientId);
+
+  workers.Stop();
+}
+
+TEST(TestPVRClientFetches, Errors)
+{
+  CRequestWorkerPool workers("TestPVRClientFetch", 64);
+  workers.Start(2);
+
+  CStandInClient failing(1, 10, PVR_ERROR_SERVER_ERROR);
+  CStandInClient unsupported(2, 10, PVR_ERROR_NOT_IMPLEMENTED);
+  CStandInClient working(3, 10);
+
+  std::vector<std::string> merged;
+  CPVRClientFetches fetches(workers);
+  failing.AddFetch(fetches, "timers", merged);
+  unsupported.AddFetch(fetches, "timers", merged);
+  working.AddFetch(fetches, "timers", merged);
+  EXPECT_EQ(PVR_ERROR_SERVER_ERROR, fetches.Execute());
+
+  // data transferred before the error is kept like before
+  EXPECT_EQ(9u, merged.size());
+  ASSERT_EQ(3u, fetches.GetTimings().size());
+  EXPECT_EQ(PVR_ERROR_SERVER_ERROR, fetches.GetTimings()[0].error);
+  EXPECT_EQ(PVR_ERROR_NOT_IMPLEMENTED, fetches.GetTimings()[1].error);
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, fetches.GetTimings()[2].error);
+
+  // the fetches are gone once they're executed
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, fetches.Execute());
+  EXPECT_TRUE(fetches.GetTimings().empty());
+
+  workers.Stop();
+}
+
+TEST(TestPVRClientFetches, Bounded)
+{
+  CRequestWorkerPool workers("TestPVRClientFetch", 64);
+  workers.Start(2);
+
+  std::vector<std::string> merged;
+  CPVRClientFetches fetches(workers);
+  for (int i = 1; i <= 8; i++)
+    CStandInClient(i, 20).AddFetch(fetches, "recordings", merged);
+
+  CStandInClient::ResetPeak();
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, fetches.Execute());
+  EXPECT_EQ(24u, merged.size());
+  // two workers and the calling thread
+  EXPECT_LE(CStandInClient::GetPeak(), 3u);
+  EXPECT_GE(CStandInClient::GetPeak(), 2u);
+
+  workers.Stop();
+}
+
+TEST(TestPVRClientFetches, NoWorkers)
+{
+  CRequestWorkerPool workers("TestPVRClientFetch", 64);
+
+  std::vector<std::string> merged;
+  CPVRClientFetches fetches(workers);
+  for (int i = 1; i <= 3; i++)
+    CStandInClient(i, 10).AddFetch(fetches, "groups", merged);
+
+  CStandInClient::ResetPeak();
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, fetches.Execute());
+  EXPECT_EQ(9u, merged.size());
+  EXPECT_EQ(1u, CStandInClient::GetPeak());
+}
+
+TEST(TestPVRClientFetches, TransferBuffer)
+{
+  int target = 0;
+  CPVRTransferBuffer buffer(&target);
+
+  ADDON_HANDLE_STRUCT handle;
+  handle.callerAddress = NULL;
+  handle.dataAddress = &target;
+  handle.dataIdentifier = 0;
+  buffer.SetupHandle(handle);
+  EXPECT_EQ(&buffer, handle.dataAddress);
+  EXPECT_EQ(CPVRTransferBuffer::HANDLE_IDENTIFIER, handle.dataIdentifier);
+
+  PVR_CHANNEL channel;
+  memset(&channel, 0, sizeof(channel));
+  PVR_TIMER timer;
+  memset(&timer, 0, sizeof(timer));
+  buffer.Add(NULL, channel);
+  buffer.Add(NULL, channel);
+  buffer.Add(NULL, timer);
+  EXPECT_EQ(3u, buffer.Size());
+}
@@ -0,0 +1,158 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "pvr/recordings/PVRRecordingFolders.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+
+#include "gtest/gtest.h"
+
+using namespace PVR;
+
+static CDateTime Day(int iDay)
+{
+  return CDateTime(2016, 1, iDay, 20, 15, 0);
+}
+
+TEST(TestPVRRecordingFolders, Folders)
+{
+  CPVRRecordingFolders folders;
+  folders.Add(1, "/Series/Doctor Who/", Day(1), false);
+  folders.Add(2, "series/doctor who", Day(3), true);
+  folders.Add(3, "Series/Sherlock", Day(2), false);
+  folders.Add(4, "", Day(4), true);
+  EXPECT_EQ(4u, folders.Size());
+
+  std::vector<CPVRRecordingFolders::Folder> result;
+  ASSERT_TRUE(folders.GetSubFolders("", result));
+  ASSERT_EQ(1u, result.size());
+  EXPECT_EQ("Series", result[0].strName);
+  EXPECT_EQ(3u, result[0].iRecordings);
+  EXPECT_EQ(1u, result[0].iUnwatched);
+  EXPECT_TRUE(result[0].newest == Day(3));
+
+  // names are matched case-insensitively and sorted
+  result.clear();
+  ASSERT_TRUE(folders.GetSubFolders("SERIES/", result));
+  ASSERT_EQ(2u, result.size());
+  EXPECT_EQ("Doctor Who", result[0].strName);
+  EXPECT_EQ(2u, result[0].iRecordings);
+  EXPECT_EQ("Sherlock", result[1].strName);
+  EXPECT_EQ(0u, result[1].iUnwatched);
+
+  std::vector<unsigned int> ids;
+  ASSERT_TRUE(folders.GetRecordings("Series/Doctor Who", ids));
+  ASSERT_EQ(2u, ids.size());
+  EXPECT_EQ(1u, ids[0]);
+  EXPECT_EQ(2u, ids[1]);
+
+  ids.clear();
+  ASSERT_TRUE(folders.GetRecordings("/", ids));
+  ASSERT_EQ(1u, ids.size());
+  EXPECT_EQ(4u, ids[0]);
+
+  result.clear();
+  EXPECT_FALSE(folders.GetSubFolders("Movies", result));
+  EXPECT_FALSE(folders.GetRecordings("Series/Doctor", ids));
+}
+
+TEST(TestPVRRecordingFolders, Update)
+{
+  CPVRRecordingFolders folders;
+  folders.Add(1, "Series/Doctor Who", Day(1), true);
+  folders.Add(2, "Series/Doctor Who", Day(3), true);
+  folders.Add(3, "Series/Sherlock", Day(2), false);
+
+  // watched
+  folders.Add(2, "Series/Doctor Who", Day(3), false);
+  std::vector<CPVRRecordingFolders::Folder> result;
+  ASSERT_TRUE(folders.GetSubFolders("Series", result));
+  ASSERT_EQ(2u, result.size());
+  EXPECT_EQ(1u, result[0].iUnwatched);
+  EXPECT_EQ(2u, result[0].iRecordings);
+
+  // moved, the newest recording of the folder it was in changes
+  folders.Add(2, "Series/Sherlock", Day(3), false);
+  result.clear();
+  ASSERT_TRUE(folders.GetSubFolders("Series", result));
+  ASSERT_EQ(2u, result.size());
+  EXPECT_EQ(1u, result[0].iRecordings);
+  EXPECT_TRUE(result[0].newest == Day(1));
+  EXPECT_EQ(2u, result[1].iRecordings);
+  EXPECT_TRUE(result[1].newest == Day(3));
+
+  // deleted, empty folders are gone
+  folders.Remove(1);
+  result.clear();
+  ASSERT_TRUE(folders.GetSubFolders("Series", result));
+  ASSERT_EQ(1u, result.size());
+  EXPECT_EQ("Sherlock", result[0].strName);
+  EXPECT_EQ(2u, folders.Size());
+
+  folders.Remove(1);
+  folders.Remove(2);
+  folders.Remove(3);
+  result.clear();
+  ASSERT_TRUE(folders.GetSubFolders("", result));
+  EXPECT_TRUE(result.empty());
+  EXPECT_EQ(0u, folders.Size());
+
+  folders.Add(4, "Movies", Day(5), true);
+  folders.Clear();
+  EXPECT_FALSE(folders.GetSubFolders("Movies", result));
+  EXPECT_EQ(0u, folders.Size());
+}
+
+TEST(TestPVRRecordingFolders, Benchmark)
+{
+  // 100 series with 50 recordings each and 1000 movies
+  CPVRRecordingFolders folders;
+  unsigned int iId = 0;
+  for (unsigned int i = 0; i < 100; i++)
+  {
+    std::string strDirectory = StringUtils::Format("Series/Show %u", i);
+    for (unsigned int j = 0; j < 50; j++)
+      folders.Add(++iId, strDirectory, Day(1 + j % 28), j % 3 == 0);
+  }
+  for (unsigned int i = 0; i < 1000; i++)
+    folders.Add(++iId, "Movies", Day(1 + i % 28), i % 2 == 0);
+  ASSERT_EQ(6000u, folders.Size());
+
+  const unsigned int iOpens = 1000;
+  int64_t start = CurrentHostCounter();
+  size_t iItems = 0;
+  for (unsigned int i = 0; i < iOpens; i++)
+  {
+    std::vector<CPVRRecordingFolders::Folder> result;
+    std::vector<unsigned int> ids;
+    folders.GetSubFolders("Series", result);
+    folders.GetRecordings(StringUtils::Format("Series/Show %u", i % 100), ids);
+    iItems += result.size() + ids.size();
+  }
+  int64_t elapsed = CurrentHostCounter() - start;
+
+  EXPECT_EQ(iOpens * 150u, iItems);
+  CLog::Log(LOGNOTICE, "TestPVRRecordingFolders: %u folder opens with %u recordings took %.2f ms",
+            iOpens, static_cast<unsigned int>(folders.Size()), 1000.0 * elapsed / CurrentHostFrequency());
+}
@@ -41,6 +41,7 @@ enum ESHADERMETHOD
   SM_TEXTURE_RGBA_BLENDCOLOR,
   SM_TEXTURE_RGBA_BOB,
   SM_TEXTURE_RGBA_BOB_OES,
+  SM_FONTS_DISTANCE_FIELD,
   SM_ESHADERCOUNT
 };
 
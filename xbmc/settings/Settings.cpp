@@ -744,6 +744,26 @@ std::vector<CVariant> CSettings::GetList(const std::string &id) const
   return CSettingUtils::GetList(static_cast<CSettingList*>(setting));
 }
 
+CSettingHandle<bool> CSettings::GetBoolHandle(const std::string &id) const
+{
+  return m_settingsManager->GetBoolHandle(id);
+}
+
+CSettingHandle<int> CSettings::GetIntHandle(const std::string &id) const
+{
+  return m_settingsManager->GetIntHandle(id);
+}
+
+CSettingHandle<double> CSettings::GetNumberHandle(const std::string &id) const
+{
+  return m_settingsManager->GetNumberHandle(id);
+}
+
+CSettingHandle<std::string> CSettings::GetStringHandle(const std::string &id) const
+{
+  return m_settingsManager->GetStringHandle(id);
+}
+
 bool CSettings::SetList(const std::string &id, const std::vector<CVariant> &value)
 {
   CSetting *setting = m_settingsManager->GetSetting(id);
@@ -28,6 +28,7 @@
 #include "settings/SettingControl.h"
 #include "settings/SettingCreator.h"
 #include "settings/lib/ISettingCallback.h"
+#include "settings/lib/SettingHandle.h"
 #include "threads/CriticalSection.h"
 
 class CSetting;
@@ -522,6 +523,36 @@ public:
    */
   std::vector<CVariant> GetList(const std::string &id) const;
 
+  /*!
+   \brief Gets a handle of the boolean setting with the given identifier
+   which reads its value without any lookup or locking.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if the setting is unknown or not a boolean setting
+   */
+  CSettingHandle<bool> GetBoolHandle(const std::string &id) const;
+  /*!
+   \brief Gets a handle of the integer setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if the setting is unknown or not an integer setting
+   */
+  CSettingHandle<int> GetIntHandle(const std::string &id) const;
+  /*!
+   \brief Gets a handle of the real number setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if the setting is unknown or not a real number setting
+   */
+  CSettingHandle<double> GetNumberHandle(const std::string &id) const;
+  /*!
+   \brief Gets a handle of the string setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting, invalid if the setting is unknown or not a string setting
+   */
+  CSettingHandle<std::string> GetStringHandle(const std::string &id) const;
+
   /*!
    \brief Sets the boolean value of the setting with the given identifier.
 
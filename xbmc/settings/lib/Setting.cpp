@@ -273,6 +273,13 @@ void CSetting::Copy(const CSetting &setting)
   m_changed = setting.m_changed;
 }
 
+void CSetting::SetSnapshot(const SettingSnapshotPtr &snapshot)
+{
+  CExclusiveLock lock(m_critical);
+  m_snapshot = snapshot;
+  Publish();
+}
+
 CSettingList::CSettingList(const std::string &id, CSetting *settingDefinition, CSettingsManager *settingsManager /* = NULL */)
   : CSetting(id, settingsManager),
     m_definition(settingDefinition),
@@ -613,7 +620,10 @@ bool CSettingBool::Deserialize(const TiXmlNode *node, bool update /* = false */)
   // get the default value
   bool value;
   if (XMLUtils::GetBoolean(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    Publish();
+  }
   else if (!update)
   {
     CLog::Log(LOGERROR, "CSettingBool: error reading the default value of \"%s\"", m_id.c_str());
@@ -672,6 +682,7 @@ bool CSettingBool::SetValue(bool value)
   }
 
   m_changed = m_value != m_default;
+  Publish();
   OnSettingChanged(this);
   return true;
 }
@@ -682,7 +693,10 @@ void CSettingBool::SetDefault(bool value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    Publish();
+  }
 }
 
 void CSettingBool::copy(const CSettingBool &setting)
@@ -692,6 +706,12 @@ void CSettingBool::copy(const CSettingBool &setting)
   m_value = setting.m_value;
   m_default = setting.m_default;
 }
+
+void CSettingBool::Publish() const
+{
+  if (m_snapshot != NULL)
+    m_snapshot->Publish(m_value);
+}
   
 bool CSettingBool::fromString(const std::string &strValue, bool &value) const
 {
@@ -771,7 +791,10 @@ bool CSettingInt::Deserialize(const TiXmlNode *node, bool update /* = false */)
   // get the default value
   int value;
   if (XMLUtils::GetInt(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    Publish();
+  }
   else if (!update)
   {
     CLog::Log(LOGERROR, "CSettingInt: error reading the default value of \"%s\"", m_id.c_str());
@@ -907,6 +930,7 @@ bool CSettingInt::SetValue(int value)
   }
 
   m_changed = m_value != m_default;
+  Publish();
   OnSettingChanged(this);
   return true;
 }
@@ -917,7 +941,10 @@ void CSettingInt::SetDefault(int value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    Publish();
+  }
 }
 
 SettingOptionsType CSettingInt::GetOptionsType() const
@@ -993,6 +1020,12 @@ void CSettingInt::copy(const CSettingInt &setting)
   m_dynamicOptions = setting.m_dynamicOptions;
 }
 
+void CSettingInt::Publish() const
+{
+  if (m_snapshot != NULL)
+    m_snapshot->Publish(m_value);
+}
+
 bool CSettingInt::fromString(const std::string &strValue, int &value)
 {
   if (strValue.empty())
@@ -1049,7 +1082,10 @@ bool CSettingNumber::Deserialize(const TiXmlNode *node, bool update /* = false *
   // get the default value
   double value;
   if (XMLUtils::GetDouble(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    Publish();
+  }
   else if (!update)
   {
     CLog::Log(LOGERROR, "CSettingNumber: error reading the default value of \"%s\"", m_id.c_str());
@@ -1139,6 +1175,7 @@ bool CSettingNumber::SetValue(double value)
   }
 
   m_changed = m_value != m_default;
+  Publish();
   OnSettingChanged(this);
   return true;
 }
@@ -1149,7 +1186,10 @@ void CSettingNumber::SetDefault(double value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    Publish();
+  }
 }
 
 void CSettingNumber::copy(const CSettingNumber &setting)
@@ -1164,6 +1204,12 @@ void CSettingNumber::copy(const CSettingNumber &setting)
   m_max = setting.m_max;
 }
 
+void CSettingNumber::Publish() const
+{
+  if (m_snapshot != NULL)
+    m_snapshot->Publish(m_value);
+}
+
 bool CSettingNumber::fromString(const std::string &strValue, double &value)
 {
   if (strValue.empty())
@@ -1239,7 +1285,10 @@ bool CSettingString::Deserialize(const TiXmlNode *node, bool update /* = false *
   std::string value;
   if (XMLUtils::GetString(node, SETTING_XML_ELM_DEFAULT, value) &&
      (!value.empty() || m_allowEmpty))
+  {
     m_value = m_default = value;
+    Publish();
+  }
   else if (!update && !m_allowEmpty)
   {
     CLog::Log(LOGERROR, "CSettingString: error reading the default value of \"%s\"", m_id.c_str());
@@ -1284,6 +1333,7 @@ bool CSettingString::SetValue(const std::string &value)
   }
 
   m_changed = m_value != m_default;
+  Publish();
   OnSettingChanged(this);
   return true;
 }
@@ -1294,7 +1344,10 @@ void CSettingString::SetDefault(const std::string &value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    Publish();
+  }
 }
 
 SettingOptionsType CSettingString::GetOptionsType() const
@@ -1364,6 +1417,12 @@ void CSettingString::copy(const CSettingString &setting)
   m_optionsFillerData = setting.m_optionsFillerData;
   m_dynamicOptions = setting.m_dynamicOptions;
 }
+
+void CSettingString::Publish() const
+{
+  if (m_snapshot != NULL)
+    m_snapshot->Publish(m_value);
+}
   
 CSettingAction::CSettingAction(const std::string &id, CSettingsManager *settingsManager /* = NULL */)
   : CSetting(id, settingsManager)
@@ -31,6 +31,7 @@
 #include "ISettingControl.h"
 #include "SettingDefinitions.h"
 #include "SettingDependency.h"
+#include "SettingHandle.h"
 #include "SettingUpdate.h"
 #include "threads/SharedSection.h"
 
@@ -109,6 +110,13 @@ public:
   const std::set<CSettingUpdate>& GetUpdates() const { return m_updates; }
 
   void SetCallback(ISettingCallback *callback) { m_callback = callback; }
+  /*!
+   \brief Sets the snapshot the value of the setting is published to and
+   publishes the current value.
+
+   \param snapshot Snapshot read by the handles of the setting
+   */
+  void SetSnapshot(const SettingSnapshotPtr &snapshot);
 
   // overrides of ISetting
   virtual bool IsVisible() const override;
@@ -122,6 +130,11 @@ protected:
   virtual void OnSettingPropertyChanged(const CSetting *setting, const char *propertyName) override;
 
   void Copy(const CSetting &setting);
+  /*!
+   \brief Publishes the current value to the snapshot of the setting. Has to
+   be called with m_critical locked whenever the value changes.
+   */
+  virtual void Publish() const { }
 
   ISettingCallback *m_callback;
   int m_label;
@@ -133,6 +146,7 @@ protected:
   SettingDependencies m_dependencies;
   std::set<CSettingUpdate> m_updates;
   bool m_changed;
+  SettingSnapshotPtr m_snapshot;
   CSharedSection m_critical;
 };
 
@@ -227,6 +241,9 @@ public:
   bool GetDefault() const { return m_default; }
   void SetDefault(bool value);
 
+protected:
+  virtual void Publish() const override;
+
 private:
   void copy(const CSettingBool &setting);
   bool fromString(const std::string &strValue, bool &value) const;
@@ -290,6 +307,9 @@ public:
   }
   DynamicIntegerSettingOptions UpdateDynamicOptions();
 
+protected:
+  virtual void Publish() const override;
+
 private:
   void copy(const CSettingInt &setting);
   static bool fromString(const std::string &strValue, int &value);
@@ -344,6 +364,9 @@ public:
   double GetMaximum() const { return m_max; }
   void SetMaximum(double maximum) { m_max = maximum; }
 
+protected:
+  virtual void Publish() const override;
+
 private:
   virtual void copy(const CSettingNumber &setting);
   static bool fromString(const std::string &strValue, double &value);
@@ -402,6 +425,7 @@ public:
   DynamicStringSettingOptions UpdateDynamicOptions();
 
 protected:
+  virtual void Publish() const override;
   virtual void copy(const CSettingString &setting);
 
   std::string m_value;
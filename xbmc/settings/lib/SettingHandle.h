@@ -0,0 +1,145 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+/*!
+ \ingroup settings
+ \brief Value of a setting published by the setting whenever it changes so
+ that it can be read without locking the setting or the settings manager.
+
+ A snapshot belongs to a setting identifier and not to a setting object so it
+ stays valid when the settings are cleared and initialized again.
+
+ Strings are published as a pointer to an immutable copy. Reading one is a
+ single atomic load without any reference counting. Copies are only released
+ with the snapshot, so every distinct value a string setting takes keeps its
+ copy until then.
+ */
+class CSettingSnapshot
+{
+public:
+  CSettingSnapshot()
+    : m_bool(false), m_int(0), m_number(0.0)
+  {
+    m_strings.push_back(std::unique_ptr<const std::string>(new std::string()));
+    m_string.store(m_strings.back().get(), std::memory_order_relaxed);
+  }
+
+  bool GetBool() const { return m_bool.load(std::memory_order_acquire); }
+  int GetInt() const { return m_int.load(std::memory_order_acquire); }
+  double GetNumber() const { return m_number.load(std::memory_order_acquire); }
+  const std::string& GetString() const { return *m_string.load(std::memory_order_acquire); }
+
+  void Publish(bool value) { m_bool.store(value, std::memory_order_release); }
+  void Publish(int value) { m_int.store(value, std::memory_order_release); }
+  void Publish(double value) { m_number.store(value, std::memory_order_release); }
+  void Publish(const std::string &value)
+  {
+    CSingleLock lock(m_stringSection);
+    if (*m_string.load(std::memory_order_relaxed) == value)
+      return;
+
+    m_strings.push_back(std::unique_ptr<const std::string>(new std::string(value)));
+    m_string.store(m_strings.back().get(), std::memory_order_release);
+  }
+
+private:
+  CSettingSnapshot(const CSettingSnapshot&) = delete;
+  CSettingSnapshot& operator=(const CSettingSnapshot&) = delete;
+
+  std::atomic<bool> m_bool;
+  std::atomic<int> m_int;
+  std::atomic<double> m_number;
+  std::atomic<const std::string*> m_string;
+  CCriticalSection m_stringSection;
+  std::vector<std::unique_ptr<const std::string> > m_strings; ///< all published strings, see above
+};
+
+typedef std::shared_ptr<CSettingSnapshot> SettingSnapshotPtr;
+
+/*!
+ \ingroup settings
+ \brief Type of the values returned by a setting handle. Strings are returned
+ by reference to the immutable copy published by the setting. The reference
+ stays valid as long as the handle.
+ */
+template<typename T>
+struct SettingHandleValue { typedef T type; };
+
+template<>
+struct SettingHandleValue<std::string> { typedef const std::string& type; };
+
+/*!
+ \ingroup settings
+ \brief Typed handle of a setting which is resolved once by identifier (see
+ CSettingsManager::GetBoolHandle() etc.) and then reads the value of the
+ setting without any lookup, locking or allocation.
+
+ A default constructed handle or a handle of an unknown setting is invalid and
+ returns false, 0, 0.0 or an empty string respectively.
+ */
+template<typename T>
+class CSettingHandle
+{
+public:
+  CSettingHandle() { }
+  explicit CSettingHandle(const SettingSnapshotPtr &snapshot)
+    : m_snapshot(snapshot)
+  { }
+
+  bool IsValid() const { return m_snapshot != nullptr; }
+  typename SettingHandleValue<T>::type Get() const;
+
+private:
+  std::shared_ptr<const CSettingSnapshot> m_snapshot;
+};
+
+template<>
+inline bool CSettingHandle<bool>::Get() const
+{
+  return m_snapshot ? m_snapshot->GetBool() : false;
+}
+
+template<>
+inline int CSettingHandle<int>::Get() const
+{
+  return m_snapshot ? m_snapshot->GetInt() : 0;
+}
+
+template<>
+inline double CSettingHandle<double>::Get() const
+{
+  return m_snapshot ? m_snapshot->GetNumber() : 0.0;
+}
+
+template<>
+inline const std::string& CSettingHandle<std::string>::Get() const
+{
+  static const std::string empty;
+  return m_snapshot ? m_snapshot->GetString() : empty;
+}
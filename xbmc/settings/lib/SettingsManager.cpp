@@ -21,6 +21,7 @@
 #include "SettingsManager.h"
 
 #include <algorithm>
+#include <memory>
 #include <utility>
 
 #include "SettingDefinitions.h"
@@ -286,6 +287,16 @@ void CSettingsManager::AddSection(CSettingSection *section)
         {
           setting->second.setting = *settingIt;
           (*settingIt)->SetCallback(this);
+
+          int settingType = (*settingIt)->GetType();
+          if (settingType == SettingTypeBool || settingType == SettingTypeInteger ||
+              settingType == SettingTypeNumber || settingType == SettingTypeString)
+          {
+            SettingSnapshotPtr &snapshot = m_snapshots[settingId];
+            if (snapshot == NULL)
+              snapshot = std::make_shared<CSettingSnapshot>();
+            (*settingIt)->SetSnapshot(snapshot);
+          }
         }
       }
     }
@@ -630,6 +641,26 @@ bool CSettingsManager::SetList(const std::string &id, const std::vector< std::sh
   return ((CSettingList*)setting)->SetValue(value);
 }
 
+CSettingHandle<bool> CSettingsManager::GetBoolHandle(const std::string &id) const
+{
+  return CSettingHandle<bool>(GetSnapshot(id, SettingTypeBool));
+}
+
+CSettingHandle<int> CSettingsManager::GetIntHandle(const std::string &id) const
+{
+  return CSettingHandle<int>(GetSnapshot(id, SettingTypeInteger));
+}
+
+CSettingHandle<double> CSettingsManager::GetNumberHandle(const std::string &id) const
+{
+  return CSettingHandle<double>(GetSnapshot(id, SettingTypeNumber));
+}
+
+CSettingHandle<std::string> CSettingsManager::GetStringHandle(const std::string &id) const
+{
+  return CSettingHandle<std::string>(GetSnapshot(id, SettingTypeString));
+}
+
 void CSettingsManager::AddCondition(const std::string &condition)
 {
   CExclusiveLock lock(m_critical);
@@ -1099,6 +1130,20 @@ void CSettingsManager::UpdateSettingByDependency(const std::string &settingId, S
   }
 }
 
+SettingSnapshotPtr CSettingsManager::GetSnapshot(const std::string &id, int settingType) const
+{
+  CSharedLock lock(m_settingsCritical);
+  CSetting *setting = GetSetting(id);
+  if (setting == NULL || setting->GetType() != settingType)
+    return SettingSnapshotPtr();
+
+  SettingSnapshotMap::const_iterator snapshot = m_snapshots.find(setting->GetId());
+  if (snapshot == m_snapshots.end())
+    return SettingSnapshotPtr();
+
+  return snapshot->second;
+}
+
 void CSettingsManager::RegisterSettingOptionsFiller(const std::string &identifier, void *filler, SettingOptionsFillerType type)
 {
   CExclusiveLock lock(m_critical);
@@ -32,6 +32,7 @@
 #include "SettingConditions.h"
 #include "SettingDefinitions.h"
 #include "SettingDependency.h"
+#include "SettingHandle.h"
 #include "threads/SharedSection.h"
 
 class CSettingSection;
@@ -319,6 +320,41 @@ public:
    */
   std::vector< std::shared_ptr<CSetting> > GetList(const std::string &id) const;
 
+  /*!
+   \brief Gets a handle of the boolean setting with the given identifier.
+
+   The handle reads the value of the setting without looking it up or locking
+   and stays valid when the settings are cleared and initialized again.
+
+   \param id Setting identifier
+   \return Handle of the setting or an invalid handle if the identifier is unknown or the setting isn't a boolean setting
+   */
+  CSettingHandle<bool> GetBoolHandle(const std::string &id) const;
+  /*!
+   \brief Gets a handle of the integer setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting or an invalid handle if the identifier is unknown or the setting isn't an integer setting
+   \sa GetBoolHandle()
+   */
+  CSettingHandle<int> GetIntHandle(const std::string &id) const;
+  /*!
+   \brief Gets a handle of the real number setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting or an invalid handle if the identifier is unknown or the setting isn't a real number setting
+   \sa GetBoolHandle()
+   */
+  CSettingHandle<double> GetNumberHandle(const std::string &id) const;
+  /*!
+   \brief Gets a handle of the string setting with the given identifier.
+
+   \param id Setting identifier
+   \return Handle of the setting or an invalid handle if the identifier is unknown or the setting isn't a string setting
+   \sa GetBoolHandle()
+   */
+  CSettingHandle<std::string> GetStringHandle(const std::string &id) const;
+
   /*!
    \brief Sets the boolean value of the setting with the given identifier.
 
@@ -420,6 +456,7 @@ private:
   bool UpdateSetting(const TiXmlNode *node, CSetting *setting, const CSettingUpdate& update);
   void UpdateSettingByDependency(const std::string &settingId, const CSettingDependency &dependency);
   void UpdateSettingByDependency(const std::string &settingId, SettingDependencyType dependencyType);
+  SettingSnapshotPtr GetSnapshot(const std::string &id, int settingType) const;
 
   typedef enum {
     SettingOptionsFillerTypeNone = 0,
@@ -442,6 +479,9 @@ private:
 
   typedef std::map<std::string, Setting> SettingMap;
   SettingMap m_settings;
+  // not cleared with the settings to keep handles valid
+  typedef std::map<std::string, SettingSnapshotPtr> SettingSnapshotMap;
+  SettingSnapshotMap m_snapshots;
   typedef std::map<std::string, CSettingSection*> SettingSectionMap;
   SettingSectionMap m_sections;
 
@@ -0,0 +1,170 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <set>
+#include <string>
+
+#include "settings/lib/Setting.h"
+#include "settings/lib/SettingSection.h"
+#include "settings/lib/SettingsManager.h"
+#include "utils/log.h"
+#include "utils/TimeUtils.h"
+
+#include "gtest/gtest.h"
+
+class TestSettingsManager : public testing::Test,
+                            protected ISettingCallback
+{
+protected:
+  TestSettingsManager()
+    : m_changed(0), m_handleValue(0)
+  {
+    Initialize();
+  }
+
+  ~TestSettingsManager()
+  {
+    m_manager.Clear();
+  }
+
+  void Initialize()
+  {
+    CSettingGroup *group = new CSettingGroup("1", &m_manager);
+    group->AddSetting(new CSettingBool("test.bool", 0, true, &m_manager));
+    group->AddSetting(new CSettingInt("test.int", 0, 42, &m_manager));
+    group->AddSetting(new CSettingNumber("test.number", 0, 0.5f, &m_manager));
+    group->AddSetting(new CSettingString("test.string", 0, "default", &m_manager));
+
+    CSettingCategory *category = new CSettingCategory("test", &m_manager);
+    category->AddGroup(group);
+    CSettingSection *section = new CSettingSection("test", &m_manager);
+    section->AddCategory(category);
+
+    m_manager.AddSection(section);
+    m_manager.SetInitialized();
+    m_manager.SetLoaded();
+  }
+
+  virtual void OnSettingChanged(const CSetting *setting) override
+  {
+    m_changed++;
+    // handles already read the new value in callbacks
+    m_handleValue = m_manager.GetIntHandle("test.int").Get();
+  }
+
+  CSettingsManager m_manager;
+  int m_changed;
+  int m_handleValue;
+};
+
+TEST_F(TestSettingsManager, Handles)
+{
+  CSettingHandle<bool> boolHandle = m_manager.GetBoolHandle("test.bool");
+  CSettingHandle<int> intHandle = m_manager.GetIntHandle("test.int");
+  CSettingHandle<double> numberHandle = m_manager.GetNumberHandle("test.number");
+  CSettingHandle<std::string> stringHandle = m_manager.GetStringHandle("test.string");
+  ASSERT_TRUE(boolHandle.IsValid());
+  ASSERT_TRUE(intHandle.IsValid());
+  ASSERT_TRUE(numberHandle.IsValid());
+  ASSERT_TRUE(stringHandle.IsValid());
+
+  EXPECT_TRUE(boolHandle.Get());
+  EXPECT_EQ(42, intHandle.Get());
+  EXPECT_EQ(0.5, numberHandle.Get());
+  EXPECT_EQ("default", stringHandle.Get());
+
+  EXPECT_TRUE(m_manager.SetBool("test.bool", false));
+  EXPECT_TRUE(m_manager.SetInt("test.int", 7));
+  EXPECT_TRUE(m_manager.SetNumber("test.number", 1.5));
+  const std::string &oldString = stringHandle.Get();
+  EXPECT_TRUE(m_manager.SetString("test.string", "changed"));
+
+  EXPECT_FALSE(boolHandle.Get());
+  EXPECT_EQ(7, intHandle.Get());
+  EXPECT_EQ(1.5, numberHandle.Get());
+  EXPECT_EQ("changed", stringHandle.Get());
+  // values read before stay valid and unchanged
+  EXPECT_EQ("default", oldString);
+
+  // identifiers are case-insensitive like for the string lookups
+  EXPECT_EQ(7, m_manager.GetIntHandle("Test.Int").Get());
+}
+
+TEST_F(TestSettingsManager, InvalidHandles)
+{
+  CSettingHandle<int> unknown = m_manager.GetIntHandle("test.unknown");
+  EXPECT_FALSE(unknown.IsValid());
+  EXPECT_EQ(0, unknown.Get());
+
+  CSettingHandle<bool> wrongType = m_manager.GetBoolHandle("test.int");
+  EXPECT_FALSE(wrongType.IsValid());
+  EXPECT_FALSE(wrongType.Get());
+
+  CSettingHandle<std::string> empty;
+  EXPECT_FALSE(empty.IsValid());
+  EXPECT_EQ("", empty.Get());
+}
+
+TEST_F(TestSettingsManager, Callbacks)
+{
+  std::set<std::string> settings;
+  settings.insert("test.int");
+  m_manager.RegisterCallback(this, settings);
+
+  EXPECT_TRUE(m_manager.SetInt("test.int", 3));
+  EXPECT_EQ(1, m_changed);
+  EXPECT_EQ(3, m_handleValue);
+
+  m_manager.UnregisterCallback(this);
+}
+
+TEST_F(TestSettingsManager, Reinitialize)
+{
+  CSettingHandle<int> intHandle = m_manager.GetIntHandle("test.int");
+  EXPECT_TRUE(m_manager.SetInt("test.int", 7));
+
+  // handles keep working with the settings created after clearing
+  m_manager.Clear();
+  Initialize();
+  EXPECT_EQ(42, intHandle.Get());
+  EXPECT_TRUE(m_manager.SetInt("test.int", 8));
+  EXPECT_EQ(8, intHandle.Get());
+}
+
+TEST_F(TestSettingsManager, Benchmark)
+{
+  const int iReads = 1000000;
+  int64_t iSum = 0;
+
+  int64_t start = CurrentHostCounter();
+  for (int i = 0; i < iReads; i++)
+    iSum += m_manager.GetInt("test.int");
+  int64_t lookups = CurrentHostCounter() - start;
+
+  CSettingHandle<int> intHandle = m_manager.GetIntHandle("test.int");
+  start = CurrentHostCounter();
+  for (int i = 0; i < iReads; i++)
+    iSum += intHandle.Get();
+  int64_t handles = CurrentHostCounter() - start;
+
+  EXPECT_EQ(2 * 42 * static_cast<int64_t>(iReads), iSum);
+  CLog::Log(LOGNOTICE, "TestSettingsManager: %d reads, string lookups: %.2f ms, handles: %.2f ms",
+            iReads, 1000.0 * lookups / CurrentHostFrequency(), 1000.0 * handles / CurrentHostFrequency());
+}
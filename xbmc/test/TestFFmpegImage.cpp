@@ -0,0 +1,217 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "filesystem/File.h"
+#include "guilib/FFmpegImage.h"
+#include "guilib/TextureFormats.h"
+#include "test/TestUtils.h"
+#include "utils/auto_buffer.h"
+#include "utils/log.h"
+#include "utils/TimeUtils.h"
+
+extern "C"
+{
+#include "libavformat/avformat.h"
+}
+
+#include "gtest/gtest.h"
+
+class TestFFmpegImage : public testing::Test
+{
+protected:
+  TestFFmpegImage()
+  {
+    av_register_all();
+  }
+
+  // encode a picture with some detail so that the encoder can't skip the work
+  static bool CreateImage(const std::string &mimeType, unsigned int width, unsigned int height, std::vector<uint8_t> &image)
+  {
+    std::vector<uint8_t> pixels(width * height * 4);
+    for (unsigned int y = 0; y < height; y++)
+    {
+      uint8_t *row = &pixels[y * width * 4];
+      for (unsigned int x = 0; x < width; x++)
+      {
+        row[x * 4 + 0] = (uint8_t)(x * 255 / width);
+        row[x * 4 + 1] = (uint8_t)(y * 255 / height);
+        row[x * 4 + 2] = (uint8_t)((x ^ y) & 0xff);
+        row[x * 4 + 3] = 0xff;
+      }
+    }
+
+    CFFmpegImage encoder(mimeType);
+    unsigned char *buffer = nullptr;
+    unsigned int size = 0;
+    if (!encoder.CreateThumbnailFromSurface(&pixels[0], width, height, XB_FMT_A8R8G8B8, width * 4,
+                                            mimeType == "image/png" ? "image.png" : "image.jpg", buffer, size))
+      return false;
+    image.assign(buffer, buffer + size);
+    encoder.ReleaseThumbnailBuffer();
+    return true;
+  }
+
+  // load the image like CBaseTexture::LoadIImage does
+  static bool LoadImage(const std::string &mimeType, std::vector<uint8_t> &image,
+                        unsigned int loadWidth, unsigned int loadHeight,
+                        unsigned int width, unsigned int height,
+                        unsigned int &decodedWidth, unsigned int &decodedHeight)
+  {
+    CFFmpegImage decoder(mimeType);
+    if (!decoder.LoadImageFromMemory(&image[0], image.size(), loadWidth, loadHeight))
+      return false;
+
+    // decode into a buffer of the output size, the way CBaseTexture does
+    IImage::FitSize(decoder.Width(), decoder.Height(), width, height, decodedWidth, decodedHeight);
+    std::vector<uint8_t> pixels(decodedWidth * decodedHeight * 4);
+    return decoder.Decode(&pixels[0], decodedWidth, decodedHeight, decodedWidth * 4, XB_FMT_A8R8G8B8);
+  }
+};
+
+TEST_F(TestFFmpegImage, JpegDimensions)
+{
+  std::vector<uint8_t> image;
+  ASSERT_TRUE(CreateImage("image/jpeg", 640, 480, image));
+
+  unsigned int width = 0, height = 0;
+  EXPECT_TRUE(CFFmpegImage::GetJpegDimensions(&image[0], image.size(), width, height));
+  EXPECT_EQ(640u, width);
+  EXPECT_EQ(480u, height);
+
+  // truncated before the start of frame
+  EXPECT_FALSE(CFFmpegImage::GetJpegDimensions(&image[0], 4, width, height));
+
+  std::vector<uint8_t> png;
+  ASSERT_TRUE(CreateImage("image/png", 64, 48, png));
+  EXPECT_FALSE(CFFmpegImage::GetJpegDimensions(&png[0], png.size(), width, height));
+}
+
+TEST_F(TestFFmpegImage, Lowres)
+{
+  // 24 megapixel photo to 1080p
+  EXPECT_EQ(1, CFFmpegImage::GetLowres(6000, 4000, 1620, 1080, 3));
+  // 4K fanart to 1080p
+  EXPECT_EQ(1, CFFmpegImage::GetLowres(3840, 2160, 1920, 1080, 3));
+  // thumbnails
+  EXPECT_EQ(3, CFFmpegImage::GetLowres(6000, 4000, 384, 256, 3));
+  EXPECT_EQ(2, CFFmpegImage::GetLowres(6000, 4000, 384, 256, 2));
+  // never smaller than the target
+  EXPECT_EQ(0, CFFmpegImage::GetLowres(3839, 2160, 1920, 1080, 3));
+  EXPECT_EQ(0, CFFmpegImage::GetLowres(3840, 2160, 0, 0, 3));
+
+  unsigned int width, height;
+  CFFmpegImage::FitSize(6000, 4000, 1920, 1080, width, height);
+  EXPECT_EQ(1620u, width);
+  EXPECT_EQ(1080u, height);
+  CFFmpegImage::FitSize(600, 400, 1920, 1080, width, height);
+  EXPECT_EQ(600u, width);
+  EXPECT_EQ(400u, height);
+  CFFmpegImage::FitSize(6000, 4000, 0, 0, width, height);
+  EXPECT_EQ(6000u, width);
+  EXPECT_EQ(4000u, height);
+}
+
+TEST_F(TestFFmpegImage, DecodeScaled)
+{
+  std::vector<uint8_t> image;
+  ASSERT_TRUE(CreateImage("image/jpeg", 4000, 3000, image));
+
+  CFFmpegImage decoder("image/jpeg");
+  ASSERT_TRUE(decoder.LoadImageFromMemory(&image[0], image.size(), 1280, 720));
+  EXPECT_EQ(4000u, decoder.originalWidth());
+  EXPECT_EQ(3000u, decoder.originalHeight());
+  EXPECT_EQ(960u, decoder.Width());
+  EXPECT_EQ(720u, decoder.Height());
+
+  std::vector<uint8_t> pixels(960 * 720 * 4);
+  ASSERT_TRUE(decoder.Decode(&pixels[0], 960, 720, 960 * 4, XB_FMT_A8R8G8B8));
+  EXPECT_EQ(960u, decoder.Width());
+  EXPECT_EQ(720u, decoder.Height());
+  // blue and green follow the horizontal and vertical gradients
+  EXPECT_LT(pixels[0], 32);
+  EXPECT_GT(pixels[(719 * 960 + 959) * 4 + 0], 192);
+  EXPECT_GT(pixels[(719 * 960 + 959) * 4 + 1], 192);
+}
+
+TEST_F(TestFFmpegImage, DecodeScaledProgressive)
+{
+  // the encoder only writes baseline jpegs, so use one of the progressive ones we ship
+  XUTILS::auto_buffer image;
+  ASSERT_GT(XFILE::CFile().LoadFile(XBMC_REF_FILE_PATH("addons/webinterface.default/images/remote.jpg"), image), 0);
+  unsigned char *buffer = reinterpret_cast<unsigned char*>(image.get());
+
+  unsigned int width = 0, height = 0;
+  EXPECT_TRUE(CFFmpegImage::GetJpegDimensions(buffer, image.size(), width, height));
+  EXPECT_EQ(659u, width);
+  EXPECT_EQ(212u, height);
+
+  // decoded at half size and scaled down the rest of the way
+  CFFmpegImage decoder("image/jpeg");
+  ASSERT_TRUE(decoder.LoadImageFromMemory(buffer, image.size(), 320, 103));
+  EXPECT_EQ(659u, decoder.originalWidth());
+  EXPECT_EQ(212u, decoder.originalHeight());
+  EXPECT_EQ(320u, decoder.Width());
+  EXPECT_EQ(103u, decoder.Height());
+
+  std::vector<uint8_t> pixels(320 * 103 * 4);
+  ASSERT_TRUE(decoder.Decode(&pixels[0], 320, 103, 320 * 4, XB_FMT_A8R8G8B8));
+  EXPECT_EQ(320u, decoder.Width());
+  EXPECT_EQ(103u, decoder.Height());
+}
+
+TEST_F(TestFFmpegImage, Benchmark)
+{
+  // a 24 megapixel photo and 4K fanart cached at 1080p
+  struct
+  {
+    const char *mimeType;
+    unsigned int width;
+    unsigned int height;
+  } corpus[] = { { "image/jpeg", 6000, 4000 },
+                 { "image/jpeg", 3840, 2160 },
+                 { "image/png",  3840, 2160 } };
+  const int iLoads = 3;
+
+  for (unsigned int i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++)
+  {
+    std::vector<uint8_t> image;
+    ASSERT_TRUE(CreateImage(corpus[i].mimeType, corpus[i].width, corpus[i].height, image));
+
+    unsigned int fullWidth = 0, fullHeight = 0, scaledWidth = 0, scaledHeight = 0;
+    int64_t start = CurrentHostCounter();
+    for (int j = 0; j < iLoads; j++)
+      ASSERT_TRUE(LoadImage(corpus[i].mimeType, image, 0, 0, 1920, 1080, fullWidth, fullHeight));
+    int64_t full = CurrentHostCounter() - start;
+
+    start = CurrentHostCounter();
+    for (int j = 0; j < iLoads; j++)
+      ASSERT_TRUE(LoadImage(corpus[i].mimeType, image, 1920, 1080, 1920, 1080, scaledWidth, scaledHeight));
+    int64_t scaled = CurrentHostCounter() - start;
+
+    EXPECT_EQ(fullWidth, scaledWidth);
+    EXPECT_EQ(fullHeight, scaledHeight);
+    CLog::Log(LOGNOTICE, "TestFFmpegImage: %s %ux%u to %ux%u, full decode: %.1f ms, scaled decode: %.1f ms",
+              corpus[i].mimeType, corpus[i].width, corpus[i].height, scaledWidth, scaledHeight,
+              1000.0 * full / iLoads / CurrentHostFrequency(), 1000.0 * scaled / iLoads / CurrentHostFrequency());
+  }
+}
@@ -21,6 +21,10 @@
 #include "FileItem.h"
 #include "URL.h"
 #include "settings/AdvancedSettings.h"
+#include "utils/AtomTable.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "video/VideoInfoTag.h"
 
 #include "gtest/gtest.h"
 
@@ -136,3 +140,81 @@ const TestFileData BaseMovies[] = {{ "c:\\dir\\filename.avi", false, "c:\\dir\\f
                                    { "/home/user/movies/movie_name/BDMV/index.bdmv", true, "/home/user/movies/movie_name/" }};
 
 INSTANTIATE_TEST_CASE_P(BaseNameMovies, TestFileItemBasePath, ValuesIn(BaseMovies));
+
+TEST(TestFileItem, PropertiesCaseInsensitive)
+{
+  CFileItem item;
+  item.SetProperty("WatchedEpisodes", 3);
+  EXPECT_TRUE(item.HasProperty("watchedepisodes"));
+  EXPECT_EQ(3, item.GetProperty("WATCHEDEPISODES").asInteger());
+
+  item.IncrementProperty("watchedEpisodes", 2);
+  EXPECT_EQ(5, item.GetProperty("WatchedEpisodes").asInteger());
+
+  EXPECT_FALSE(item.HasProperty("neverinternedpropertyname"));
+  EXPECT_TRUE(item.GetProperty("neverinternedpropertyname").isNull());
+
+  item.ClearProperty("WATCHEDepisodes");
+  EXPECT_FALSE(item.HasProperties());
+}
+
+TEST(TestFileItem, SortLabelKeepsFirstLabel)
+{
+  CFileItem item;
+  item.SetLabel("Pilot");
+  EXPECT_EQ(L"Pilot", item.GetSortLabel());
+
+  // relabelling (e.g. by a label mask) doesn't change the sort order
+  item.SetLabel("1x01. Pilot");
+  EXPECT_EQ(L"Pilot", item.GetSortLabel());
+
+  item.SetSortLabel(std::string("Ab"));
+  EXPECT_EQ(L"Ab", item.GetSortLabel());
+
+  item.SetSortLabel(std::wstring(L"Cd"));
+  EXPECT_EQ(L"Cd", item.GetSortLabel());
+
+  CFileItem copy(item);
+  EXPECT_EQ(L"Cd", copy.GetSortLabel());
+}
+
+/* Builds an episode listing with the properties and art the video database
+   sets and checks that the items share the property names. */
+TEST(TestFileItem, EpisodeListingSharesPropertyNames)
+{
+  const int numItems = 1000;
+  size_t atoms = CAtomTable::Size();
+
+  CFileItemList items;
+  items.Reserve(numItems);
+  for (int i = 0; i < numItems; i++)
+  {
+    CVideoInfoTag tag;
+    tag.m_iDbId = i + 1;
+    tag.m_type = MediaTypeEpisode;
+    tag.m_iSeason = i / 100 + 1;
+    tag.m_iEpisode = i % 100 + 1;
+    tag.m_strTitle = StringUtils::Format("Episode title %d", i);
+    tag.m_strShowTitle = StringUtils::Format("Show %d", i / 1000);
+    tag.m_strFileNameAndPath = StringUtils::Format("/media/tv/Show %d/S%02dE%02d.mkv", i / 1000, tag.m_iSeason, tag.m_iEpisode);
+
+    CFileItemPtr item(new CFileItem(tag));
+    item->SetProperty("totalseasons", 10);
+    item->SetProperty("watchedepisodes", i % 7);
+    item->SetProperty("unwatchedepisodes", i % 5);
+    item->SetProperty("numepisodes", 100);
+    item->SetProperty("original_listlabel", tag.m_strTitle);
+    item->SetArt("thumb", StringUtils::Format("image://%d.jpg/", i));
+    item->SetArt("fanart", StringUtils::Format("image://fanart%d.jpg/", i / 1000));
+    item->SetArt("tvshow.poster", StringUtils::Format("image://poster%d.jpg/", i / 1000));
+    item->SetArt("season.poster", StringUtils::Format("image://season%d.jpg/", i / 100));
+    item->SetLabel(StringUtils::Format("%dx%02d. %s", tag.m_iSeason, tag.m_iEpisode, tag.m_strTitle.c_str()));
+    items.Add(item);
+  }
+
+  ASSERT_EQ(numItems, items.Size());
+  EXPECT_EQ((numItems - 1) % 7, items[numItems - 1]->GetProperty("WatchedEpisodes").asInteger());
+  EXPECT_EQ("image://season9.jpg/", items[numItems - 1]->GetArt("season.poster"));
+  // property names are shared by all items
+  EXPECT_GE(atoms + 5, CAtomTable::Size());
+}
@@ -0,0 +1,183 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include "guilib/GUIFont.h"
+#include "guilib/GUIFontGlyphAtlas.h"
+#include "test/TestUtils.h"
+#include "utils/log.h"
+#include "utils/TimeUtils.h"
+
+#include "gtest/gtest.h"
+
+#define FONT_FILE "addons/skin.confluence/fonts/Roboto-Regular.ttf"
+#define MAX_TEXTURE_SIZE 4096
+
+TEST(TestGUIFontGlyphAtlas, DistanceField)
+{
+  // a filled 8x8 square with an anti-aliased right edge
+  const unsigned int size = 8;
+  const unsigned int spread = 4;
+  unsigned char square[size * size];
+  for (unsigned int y = 0; y < size; y++)
+  {
+    for (unsigned int x = 0; x < size; x++)
+      square[y * size + x] = x == size - 1 ? 128 : 255;
+  }
+
+  const unsigned int fieldSize = size + 2 * spread;
+  std::vector<unsigned char> field(fieldSize * fieldSize);
+  CGUIFontGlyphAtlas::GenerateDistanceField(square, size, size, size, spread, &field[0], fieldSize);
+
+  // corners of the padding are as far outside as can be, the center is inside
+  EXPECT_EQ(0, field[0]);
+  EXPECT_EQ(0, field[fieldSize * fieldSize - 1]);
+  EXPECT_GT(field[(fieldSize / 2) * fieldSize + fieldSize / 2], 200);
+
+  // the distance grows steadily from the left padding into the square
+  const unsigned char* row = &field[(fieldSize / 2) * fieldSize];
+  for (unsigned int x = 1; x < fieldSize / 2; x++)
+    EXPECT_GE(row[x], row[x - 1]) << x;
+  // the outline is halfway between the last pixel of the padding and the first of the square
+  EXPECT_LT(row[spread - 1], 128);
+  EXPECT_GT(row[spread], 128);
+  // the half covered pixel is on the outline
+  EXPECT_NEAR(128, row[spread + size - 1], 8);
+}
+
+TEST(TestGUIFontGlyphAtlas, Glyphs)
+{
+  CGUIFontGlyphAtlas atlas(XBMC_REF_FILE_PATH(FONT_FILE), 32.0f, true, false, MAX_TEXTURE_SIZE);
+  ASSERT_TRUE(atlas.Load());
+
+  const CGUIFontGlyphAtlas::Glyph* a = atlas.GetGlyph('A');
+  ASSERT_TRUE(a != NULL);
+  EXPECT_GT(a->width, 0u);
+  EXPECT_GT(a->height, 0u);
+  EXPECT_GT(a->advance, 0.0f);
+  EXPECT_LE(a->x + a->width, atlas.GetWidth());
+  EXPECT_LE(a->y + a->height, atlas.GetHeight());
+
+  // spaces don't take room in the atlas
+  const CGUIFontGlyphAtlas::Glyph* space = atlas.GetGlyph(' ');
+  ASSERT_TRUE(space != NULL);
+  EXPECT_EQ(0u, space->width);
+  EXPECT_GT(space->advance, 0.0f);
+
+  // glyphs are rendered once for every style
+  EXPECT_TRUE(a == atlas.GetGlyph('A'));
+  EXPECT_TRUE(atlas.GetGlyph((FONT_STYLE_BOLD << 16) | 'A') != NULL);
+  EXPECT_EQ(3u, atlas.GetMisses());
+  EXPECT_EQ(3u, atlas.GetGlyphCount());
+
+  unsigned int y1, y2;
+  EXPECT_TRUE(atlas.GetDirtyRows(y1, y2));
+  EXPECT_LT(y1, y2);
+  atlas.ClearDirtyRows();
+  EXPECT_FALSE(atlas.GetDirtyRows(y1, y2));
+
+  unsigned int generation = atlas.GetGeneration();
+  atlas.Reset();
+  EXPECT_NE(generation, atlas.GetGeneration());
+  EXPECT_EQ(0u, atlas.GetGlyphCount());
+  EXPECT_TRUE(atlas.GetDirtyRows(y1, y2));
+}
+
+TEST(TestGUIFontGlyphAtlas, Full)
+{
+  CGUIFontGlyphAtlas atlas(XBMC_REF_FILE_PATH(FONT_FILE), 32.0f, true, false, 128);
+  ASSERT_TRUE(atlas.Load());
+
+  // fill the atlas until it can't grow anymore
+  unsigned int letter = 'A';
+  while (atlas.GetGlyph(letter) != NULL)
+    letter++;
+  EXPECT_GT(atlas.GetGlyphCount(), 0u);
+  EXPECT_EQ(128u, atlas.GetHeight());
+
+  atlas.Reset();
+  EXPECT_TRUE(atlas.GetGlyph(letter) != NULL);
+}
+
+TEST(TestGUIFontGlyphAtlas, Benchmark)
+{
+  // a page of a skin in the scripts the font has glyphs for (latin with accents, greek
+  // and cyrillic), the same text in the font sizes of the skin
+  const float sizes[] = { 20.0f, 23.0f, 26.0f, 30.0f, 33.0f, 38.0f, 42.0f, 48.0f };
+  const unsigned int numSizes = sizeof(sizes) / sizeof(sizes[0]);
+  std::vector<uint32_t> page;
+  for (uint32_t letter = 0x20; letter < 0x7f; letter++)
+    page.push_back(letter);
+  for (uint32_t letter = 0xa1; letter < 0x180; letter++)
+    page.push_back(letter);
+  for (uint32_t letter = 0x391; letter < 0x3ca; letter++)
+  {
+    if (letter != 0x3a2) // unassigned
+      page.push_back(letter);
+  }
+  for (uint32_t letter = 0x410; letter < 0x450; letter++)
+    page.push_back(letter);
+
+  // a glyph cache per size like the fonts without distance fields keep
+  unsigned int perSizeMisses = 0;
+  size_t perSizeMemory = 0;
+  int64_t start = CurrentHostCounter();
+  for (unsigned int i = 0; i < numSizes; i++)
+  {
+    CGUIFontGlyphAtlas atlas(XBMC_REF_FILE_PATH(FONT_FILE), sizes[i], false, false, MAX_TEXTURE_SIZE);
+    ASSERT_TRUE(atlas.Load());
+    for (std::vector<uint32_t>::const_iterator it = page.begin(); it != page.end(); ++it)
+    {
+      if (!atlas.GetGlyph(*it))
+        atlas.Reset();
+    }
+    perSizeMisses += atlas.GetMisses();
+    perSizeMemory += atlas.GetMemoryUsage();
+  }
+  int64_t perSizeTime = CurrentHostCounter() - start;
+
+  // one distance field atlas for all sizes
+  start = CurrentHostCounter();
+  CGUIFontGlyphAtlas shared(XBMC_REF_FILE_PATH(FONT_FILE), 32.0f, true, false, MAX_TEXTURE_SIZE);
+  ASSERT_TRUE(shared.Load());
+  for (unsigned int i = 0; i < numSizes; i++)
+  {
+    for (std::vector<uint32_t>::const_iterator it = page.begin(); it != page.end(); ++it)
+    {
+      if (!shared.GetGlyph(*it))
+        shared.Reset();
+    }
+  }
+  int64_t sharedTime = CurrentHostCounter() - start;
+
+  EXPECT_EQ(page.size(), shared.GetMisses());
+  EXPECT_LT(shared.GetMisses(), perSizeMisses);
+  EXPECT_LT(shared.GetMemoryUsage(), perSizeMemory);
+
+  CLog::Log(LOGNOTICE, "TestGUIFontGlyphAtlas: %u characters in %u sizes, per size caches: %u misses, %u kB in %.2f ms, "
+            "shared distance field: %u misses, %u kB in %.2f ms",
+            static_cast<unsigned int>(page.size()), numSizes,
+            perSizeMisses, static_cast<unsigned int>(perSizeMemory / 1024),
+            1000.0 * perSizeTime / CurrentHostFrequency(),
+            shared.GetMisses(), static_cast<unsigned int>(shared.GetMemoryUsage() / 1024),
+            1000.0 * sharedTime / CurrentHostFrequency());
+}
@@ -0,0 +1,311 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FileItem.h"
+#include "TextureCache.h"
+#include "TextureCacheJob.h"
+#include "TextureDatabase.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "guilib/Texture.h"
+#include "pictures/Picture.h"
+#include "profiles/Profile.h"
+#include "profiles/ProfilesManager.h"
+#include "utils/FileUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+#define TEST_PROFILE_PATH "special://temp/texturecache/"
+
+class TestTextureCache : public testing::Test
+{
+protected:
+  virtual void SetUp()
+  {
+    // the texture database and the cached files live in the profile
+    CProfilesManager::GetInstance().AddProfile(CProfile(TEST_PROFILE_PATH, "TestTextureCache", 0));
+    CProfilesManager::GetInstance().CreateProfileFolders();
+    CTextureCache::GetInstance().Initialize();
+  }
+
+  virtual void TearDown()
+  {
+    CTextureCache::GetInstance().Deinitialize();
+    CProfilesManager::GetInstance().Clear();
+    CFileUtils::DeleteItem(TEST_PROFILE_PATH, true);
+  }
+
+  static bool CreateImage(const std::string &path, unsigned int width, unsigned int height)
+  {
+    std::vector<uint8_t> pixels(width * height * 4);
+    for (unsigned int y = 0; y < height; y++)
+    {
+      for (unsigned int x = 0; x < width; x++)
+      {
+        uint8_t *pixel = &pixels[(y * width + x) * 4];
+        pixel[0] = (uint8_t)(x * 255 / width);
+        pixel[1] = (uint8_t)(y * 255 / height);
+        pixel[2] = (uint8_t)((x ^ y) & 0xff);
+        pixel[3] = 0xff;
+      }
+    }
+    return CPicture::CreateThumbnailFromSurface(&pixels[0], width, height, width * 4, path);
+  }
+
+  static bool HasTemporaryFiles()
+  {
+    CFileItemList items;
+    XFILE::CDirectory::GetDirectory(CProfilesManager::GetInstance().GetThumbnailsFolder(), items, "", XFILE::DIR_FLAG_NO_FILE_DIRS);
+    for (int i = 0; i < items.Size(); i++)
+    {
+      if (items[i]->m_bIsFolder)
+      {
+        CFileItemList files;
+        XFILE::CDirectory::GetDirectory(items[i]->GetPath(), files, ".tmp", XFILE::DIR_FLAG_NO_FILE_DIRS);
+        if (!files.IsEmpty())
+          return true;
+      }
+    }
+    return false;
+  }
+
+  static bool IsIndexLoaded()
+  {
+    return CTextureCache::GetInstance().m_indexLoaded;
+  }
+
+  // looks the image up in the index, like the cache does
+  static bool GetIndexed(const std::string &url, CTextureDetails &details)
+  {
+    return CTextureCache::GetInstance().GetCachedTexture(url, details);
+  }
+
+  static bool GetStored(const std::string &url, CTextureDetails &details)
+  {
+    return CTextureCache::GetInstance().m_database.GetCachedTexture(url, details);
+  }
+
+  static bool SetCachedTextureValid(const std::string &url, bool updateable)
+  {
+    return CTextureCache::GetInstance().SetCachedTextureValid(url, updateable);
+  }
+
+  static bool ClearCachedTexture(const std::string &url, std::string &cacheFile)
+  {
+    return CTextureCache::GetInstance().ClearCachedTexture(url, cacheFile);
+  }
+
+  static bool ClearCachedTexture(int id, std::string &cacheFile)
+  {
+    return CTextureCache::GetInstance().ClearCachedTexture(id, cacheFile);
+  }
+
+  // the index has to return the same as a database query
+  static void ExpectInSync(const std::string &url)
+  {
+    CTextureDetails indexed, stored;
+    EXPECT_EQ(GetStored(url, stored), GetIndexed(url, indexed)) << url;
+    EXPECT_EQ(stored.id, indexed.id) << url;
+    EXPECT_EQ(stored.file, indexed.file) << url;
+    EXPECT_EQ(stored.hash, indexed.hash) << url;
+    EXPECT_EQ(stored.width, indexed.width) << url;
+    EXPECT_EQ(stored.height, indexed.height) << url;
+  }
+
+  static CTextureDetails Details(const std::string &file, const std::string &hash, bool updateable)
+  {
+    CTextureDetails details;
+    details.file = file;
+    details.hash = hash;
+    details.width = 1000;
+    details.height = 1500;
+    details.updateable = updateable;
+    return details;
+  }
+};
+
+TEST_F(TestTextureCache, ResizedImageIsCachedOnMiss)
+{
+  std::string original = URIUtils::AddFileToFolder(TEST_PROFILE_PATH, "original.jpg");
+  ASSERT_TRUE(CreateImage(original, 640, 480));
+
+  std::string url = CTextureUtils::GetWrappedImageURL(original, "", "width=320");
+  std::string key = "resized@" + url;
+  EXPECT_FALSE(CTextureCache::GetInstance().HasCachedImage(key));
+
+  uint8_t *result = NULL;
+  size_t resultSize = 0;
+  ASSERT_TRUE(CTextureCache::GetInstance().GetResizedImage(url, result, resultSize));
+  std::unique_ptr<uint8_t[]> resized(result);
+  ASSERT_GT(resultSize, 0u);
+
+  // the result is stored and no temporary file is left behind
+  EXPECT_TRUE(CTextureCache::GetInstance().HasCachedImage(key));
+  EXPECT_TRUE(XFILE::CFile::Exists(CTextureCache::GetCachedPath(CTextureCache::GetCacheFile(key) + ".jpg")));
+  EXPECT_FALSE(HasTemporaryFiles());
+
+  // the second request reads the stored image
+  ASSERT_TRUE(CTextureCache::GetInstance().GetResizedImage(url, result, resultSize));
+  std::unique_ptr<uint8_t[]> cached(result);
+  ASSERT_GT(resultSize, 0u);
+  EXPECT_EQ(0, memcmp(resized.get(), cached.get(), resultSize));
+}
+
+TEST_F(TestTextureCache, ResizedPngIsStoredAsPng)
+{
+  std::string original = URIUtils::AddFileToFolder(TEST_PROFILE_PATH, "original.png");
+  ASSERT_TRUE(CreateImage(original, 640, 480));
+
+  std::string url = CTextureUtils::GetWrappedImageURL(original, "", "height=240");
+  uint8_t *result = NULL;
+  size_t resultSize = 0;
+  ASSERT_TRUE(CTextureCache::GetInstance().GetResizedImage(url, result, resultSize));
+  delete[] result;
+
+  std::string cacheFile = CTextureCache::GetCacheFile("resized@" + url);
+  EXPECT_TRUE(XFILE::CFile::Exists(CTextureCache::GetCachedPath(cacheFile + ".png")));
+  EXPECT_FALSE(XFILE::CFile::Exists(CTextureCache::GetCachedPath(cacheFile + ".jpg")));
+}
+
+TEST_F(TestTextureCache, ResizedImageSizeIsLimited)
+{
+  std::string original = URIUtils::AddFileToFolder(TEST_PROFILE_PATH, "original.jpg");
+  ASSERT_TRUE(CreateImage(original, 64, 48));
+
+  std::string url = CTextureUtils::GetWrappedImageURL(original, "", StringUtils::Format("width=%u", CTextureCache::MaxResizedImageSize + 1));
+  uint8_t *result = NULL;
+  size_t resultSize = 0;
+  EXPECT_FALSE(CTextureCache::GetInstance().GetResizedImage(url, result, resultSize));
+  EXPECT_TRUE(result == NULL);
+  EXPECT_FALSE(CTextureCache::GetInstance().HasCachedImage("resized@" + url));
+}
+
+TEST_F(TestTextureCache, NearWidescreenFanartIsCachedAtFanartRes)
+{
+  // decoded at 1920x1075, which is not 16:9 any more
+  std::string original = URIUtils::AddFileToFolder(TEST_PROFILE_PATH, "fanart.jpg");
+  ASSERT_TRUE(CreateImage(original, 2000, 1120));
+
+  CTextureCacheJob job(original);
+  CBaseTexture *texture = NULL;
+  ASSERT_TRUE(job.CacheTexture(&texture));
+  std::unique_ptr<CBaseTexture> cached(texture);
+  ASSERT_TRUE(cached.get() != NULL);
+  EXPECT_EQ(1920u, job.m_details.width);
+  EXPECT_EQ(1075u, job.m_details.height);
+  EXPECT_EQ(2000u, cached->GetOriginalWidth());
+  EXPECT_EQ(1120u, cached->GetOriginalHeight());
+}
+
+TEST_F(TestTextureCache, ImageIsDecodedAtImageRes)
+{
+  std::string original = URIUtils::AddFileToFolder(TEST_PROFILE_PATH, "photo.jpg");
+  ASSERT_TRUE(CreateImage(original, 1600, 1200));
+
+  CTextureCacheJob job(original);
+  CBaseTexture *texture = NULL;
+  ASSERT_TRUE(job.CacheTexture(&texture));
+  std::unique_ptr<CBaseTexture> cached(texture);
+  ASSERT_TRUE(cached.get() != NULL);
+  EXPECT_EQ(960u, job.m_details.width);
+  EXPECT_EQ(720u, job.m_details.height);
+
+  // the texture was decoded at that size, not at fanartres first
+  EXPECT_EQ(960u, cached->GetWidth());
+  EXPECT_EQ(720u, cached->GetHeight());
+}
+
+TEST_F(TestTextureCache, IndexFollowsDatabase)
+{
+  CTextureCache &cache = CTextureCache::GetInstance();
+  ASSERT_TRUE(IsIndexLoaded());
+
+  const std::string poster = "/movies/poster.jpg";
+  const std::string fanart = "/movies/fanart.jpg";
+  CTextureDetails details;
+  EXPECT_FALSE(GetIndexed(poster, details));
+
+  ASSERT_TRUE(cache.AddCachedTexture(poster, Details("a/a1234567.jpg", "d20160101s1000", true)));
+  ASSERT_TRUE(cache.AddCachedTexture(fanart, Details("b/b1234567.jpg", "d20160101s2000", false)));
+  ExpectInSync(poster);
+  ExpectInSync(fanart);
+  ASSERT_TRUE(GetIndexed(poster, details));
+  EXPECT_EQ("a/a1234567.jpg", details.file);
+  // checked just now
+  EXPECT_EQ("", details.hash);
+
+  // due to be checked
+  ASSERT_TRUE(cache.InvalidateCachedImage(poster));
+  ExpectInSync(poster);
+  details = CTextureDetails();
+  ASSERT_TRUE(GetIndexed(poster, details));
+  EXPECT_EQ("d20160101s1000", details.hash);
+
+  // checked again, and not checked for updates at all
+  ASSERT_TRUE(SetCachedTextureValid(poster, true));
+  ExpectInSync(poster);
+  ASSERT_TRUE(cache.InvalidateCachedImage(poster));
+  ASSERT_TRUE(SetCachedTextureValid(poster, false));
+  ExpectInSync(poster);
+  details = CTextureDetails();
+  ASSERT_TRUE(GetIndexed(poster, details));
+  EXPECT_EQ("", details.hash);
+
+  // recached under a new id
+  int id = details.id;
+  ASSERT_TRUE(cache.AddCachedTexture(poster, Details("a/a1234567.png", "d20160102s1000", true)));
+  ExpectInSync(poster);
+  details = CTextureDetails();
+  ASSERT_TRUE(GetIndexed(poster, details));
+  EXPECT_NE(id, details.id);
+  EXPECT_EQ("a/a1234567.png", details.file);
+
+  // cleared by url and by id
+  std::string cacheFile;
+  EXPECT_TRUE(ClearCachedTexture(poster, cacheFile));
+  EXPECT_EQ("a/a1234567.png", cacheFile);
+  ExpectInSync(poster);
+  EXPECT_FALSE(GetIndexed(poster, details));
+
+  ASSERT_TRUE(GetIndexed(fanart, details));
+  EXPECT_TRUE(ClearCachedTexture(details.id, cacheFile));
+  EXPECT_EQ("b/b1234567.jpg", cacheFile);
+  ExpectInSync(fanart);
+  EXPECT_FALSE(GetIndexed(fanart, details));
+
+  // an index loaded from the database again has the same images
+  ASSERT_TRUE(cache.AddCachedTexture(poster, Details("a/a1234567.jpg", "d20160103s1000", true)));
+  ASSERT_TRUE(cache.InvalidateCachedImage(poster));
+  cache.Deinitialize();
+  cache.Initialize();
+  ASSERT_TRUE(IsIndexLoaded());
+  ExpectInSync(poster);
+  ExpectInSync(fanart);
+  details = CTextureDetails();
+  ASSERT_TRUE(GetIndexed(poster, details));
+  EXPECT_EQ("d20160103s1000", details.hash);
+}
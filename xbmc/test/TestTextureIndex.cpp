@@ -0,0 +1,202 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+
+#include "TextureDatabase.h"
+#include "TextureIndex.h"
+#include "XBDateTime.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+// the texture database with its real schema, created in special://temp
+class CTestTextureDatabase : public CTextureDatabase
+{
+public:
+  virtual bool Open()
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    settings.name = "TestTextureIndex";
+    return Update(settings);
+  }
+
+  void Delete()
+  {
+    std::string file = URIUtils::AddFileToFolder(m_pDB->getHostName(), m_pDB->getDatabase());
+    Close();
+    XFILE::CFile::Delete(file);
+  }
+};
+
+static CTextureDetails Details(int id, const std::string &file, const std::string &hash)
+{
+  CTextureDetails details;
+  details.id = id;
+  details.file = file;
+  details.hash = hash;
+  details.width = 1000;
+  details.height = 1500;
+  return details;
+}
+
+TEST(TestTextureIndex, Lookups)
+{
+  CTextureIndex index;
+  CDateTime now = CDateTime::GetCurrentDateTime();
+  index.Add("/movies/poster.jpg", Details(1, "a/a1234567.jpg", "d20160101s1000"), CDateTime());
+  index.Add("/movies/fanart.jpg", Details(2, "b/b1234567.jpg", "d20160101s2000"), now);
+  index.Add("/movies/old.jpg", Details(3, "c/c1234567.jpg", "d20160101s3000"), now - CDateTimeSpan(2, 0, 0, 0));
+  EXPECT_EQ(3u, index.Size());
+
+  CTextureDetails details;
+  ASSERT_TRUE(index.Get("/movies/poster.jpg", details));
+  EXPECT_EQ(1, details.id);
+  EXPECT_EQ("a/a1234567.jpg", details.file);
+  EXPECT_EQ(1000u, details.width);
+  EXPECT_EQ(1500u, details.height);
+  // not checked for updates
+  EXPECT_EQ("", details.hash);
+
+  // checked less than a day ago
+  details = CTextureDetails();
+  ASSERT_TRUE(index.Get("/movies/fanart.jpg", details));
+  EXPECT_EQ("", details.hash);
+
+  // due to be checked
+  details = CTextureDetails();
+  ASSERT_TRUE(index.Get("/movies/old.jpg", details));
+  EXPECT_EQ("d20160101s3000", details.hash);
+
+  // urls are matched exactly like in the database
+  EXPECT_FALSE(index.Get("/Movies/poster.jpg", details));
+  EXPECT_FALSE(index.Get("/movies/missing.jpg", details));
+  EXPECT_EQ(3u, index.GetHits());
+  EXPECT_EQ(2u, index.GetMisses());
+}
+
+TEST(TestTextureIndex, Updates)
+{
+  CTextureIndex index;
+  CDateTime now = CDateTime::GetCurrentDateTime();
+  index.Add("/movies/poster.jpg", Details(1, "a/a1234567.jpg", "hash1"), now);
+  index.Add("/movies/fanart.jpg", Details(2, "b/b1234567.jpg", "hash2"), now);
+
+  // invalidated
+  CTextureDetails details;
+  EXPECT_TRUE(index.SetLastHashCheck("/movies/poster.jpg", now - CDateTimeSpan(2, 0, 0, 0)));
+  ASSERT_TRUE(index.Get("/movies/poster.jpg", details));
+  EXPECT_EQ("hash1", details.hash);
+  EXPECT_FALSE(index.SetLastHashCheck("/movies/missing.jpg", now));
+
+  // recached
+  index.Add("/movies/poster.jpg", Details(3, "a/a1234567.png", "hash3"), CDateTime());
+  details = CTextureDetails();
+  ASSERT_TRUE(index.Get("/movies/poster.jpg", details));
+  EXPECT_EQ(3, details.id);
+  EXPECT_EQ("a/a1234567.png", details.file);
+  EXPECT_EQ("", details.hash);
+  EXPECT_EQ(2u, index.Size());
+
+  EXPECT_TRUE(index.Remove("/movies/poster.jpg"));
+  EXPECT_FALSE(index.Remove("/movies/poster.jpg"));
+  EXPECT_TRUE(index.Remove(2));
+  EXPECT_FALSE(index.Remove(2));
+  EXPECT_EQ(0u, index.Size());
+
+  index.Add("/movies/poster.jpg", Details(4, "a/a1234567.jpg", "hash4"), now);
+  index.Clear();
+  EXPECT_FALSE(index.Get("/movies/poster.jpg", details));
+  EXPECT_EQ(0u, index.GetHits());
+}
+
+TEST(TestTextureIndex, MemoryUsage)
+{
+  CTextureIndex index;
+  size_t empty = index.GetMemoryUsage();
+  for (int i = 0; i < 1000; i++)
+    index.Add(StringUtils::Format("smb://server/movies/Movie %d (2016)/poster.jpg", i),
+              Details(i, StringUtils::Format("%x/%08x.jpg", i % 16, i), "d20160101s1000"), CDateTime());
+
+  // at least the urls are stored outside of the index
+  size_t usage = index.GetMemoryUsage();
+  EXPECT_GT(usage, empty + 1000 * (sizeof(std::string) + 40));
+  EXPECT_LT(usage, empty + 1000 * 512);
+}
+
+// only runs with --gtest_also_run_disabled_tests
+TEST(TestTextureIndex, DISABLED_Benchmark)
+{
+  // a poster wall of 2000 movies scrolled through 5 times
+  const int iImages = 2000;
+  const int iLookups = 5 * iImages;
+
+  CTestTextureDatabase db;
+  ASSERT_TRUE(db.Open());
+  db.BeginTransaction();
+  for (int i = 0; i < iImages; i++)
+  {
+    std::string url = StringUtils::Format("smb://server/movies/Movie %d (2016)/poster.jpg", i);
+    std::string file = StringUtils::Format("%x/%08x.jpg", i % 16, i);
+    db.AddCachedTexture(url, Details(-1, file, ""));
+  }
+  db.CommitTransaction();
+
+  CTextureIndex index;
+  ASSERT_TRUE(db.GetCachedTextures(index));
+  EXPECT_EQ(static_cast<size_t>(iImages), index.Size());
+
+  int iFound = 0;
+  int64_t start = CurrentHostCounter();
+  for (int i = 0; i < iLookups; i++)
+  {
+    std::string url = StringUtils::Format("smb://server/movies/Movie %d (2016)/poster.jpg", i % iImages);
+    CTextureDetails details;
+    if (db.GetCachedTexture(url, details))
+      iFound++;
+  }
+  int64_t queries = CurrentHostCounter() - start;
+
+  start = CurrentHostCounter();
+  for (int i = 0; i < iLookups; i++)
+  {
+    std::string url = StringUtils::Format("smb://server/movies/Movie %d (2016)/poster.jpg", i % iImages);
+    CTextureDetails details;
+    if (index.Get(url, details))
+      iFound++;
+  }
+  int64_t lookups = CurrentHostCounter() - start;
+
+  EXPECT_EQ(2 * iLookups, iFound);
+  CLog::Log(LOGNOTICE, "TestTextureIndex: %d lookups of %d images, database: %.1f ms, index: %.1f ms using %u kB",
+            iLookups, iImages, 1000.0 * queries / CurrentHostFrequency(), 1000.0 * lookups / CurrentHostFrequency(),
+            static_cast<unsigned int>(index.GetMemoryUsage() / 1024));
+
+  db.Delete();
+}
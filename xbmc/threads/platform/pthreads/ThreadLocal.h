@@ -27,12 +27,17 @@ namespace XbmcThreads
   /**
    * A thin wrapper around pthreads thread specific storage
    * functionality.
+   *
+   * If ownsValues is set, the value of a thread is deleted when
+   * the thread exits.
    */
   template <typename T> class ThreadLocal
   {
     pthread_key_t key;
+
+    static void deleteValue(void* val) { delete (T*)val; }
   public:
-    inline ThreadLocal() : key(0) { pthread_key_create(&key,NULL); }
+    inline explicit ThreadLocal(bool ownsValues = false) : key(0) { pthread_key_create(&key,ownsValues ? deleteValue : NULL); }
 
     inline ~ThreadLocal() { pthread_key_delete(key); }
 
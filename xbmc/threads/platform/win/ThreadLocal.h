@@ -28,30 +28,38 @@ namespace XbmcThreads
   /**
    * A thin wrapper around windows thread specific storage
    * functionality.
+   *
+   * If ownsValues is set, the value of a thread is deleted when
+   * the thread exits. Fiber local storage is used for that as it
+   * is the only one calling back on thread exit.
    */
   template <typename T> class ThreadLocal
   {
     DWORD key;
+    bool fls;
+
+    static VOID WINAPI deleteValue(PVOID val) { delete (T*)val; }
   public:
-    inline ThreadLocal()
+    inline explicit ThreadLocal(bool ownsValues = false) : fls(ownsValues)
     {
-       if ((key = TlsAlloc()) == TLS_OUT_OF_INDEXES)
+       key = fls ? FlsAlloc(deleteValue) : TlsAlloc();
+       if (key == (fls ? FLS_OUT_OF_INDEXES : TLS_OUT_OF_INDEXES))
           throw XbmcCommons::UncheckedException("Ran out of Windows TLS Indexes. Windows Error Code %d",(int)GetLastError());
     }
 
     inline ~ThreadLocal() 
     {
-       if (!TlsFree(key))
+       if (!(fls ? FlsFree(key) : TlsFree(key)))
           throw XbmcCommons::UncheckedException("Failed to free Tls %d, Windows Error Code %d",(int)key, (int)GetLastError());
     }
 
     inline void set(T* val)
     {
-       if (!TlsSetValue(key,(LPVOID)val))
+       if (!(fls ? FlsSetValue(key,(PVOID)val) : TlsSetValue(key,(LPVOID)val)))
           throw XbmcCommons::UncheckedException("Failed to set Tls %d, Windows Error Code %d",(int)key, (int)GetLastError());
     }
 
-    inline T* get() { return (T*)TlsGetValue(key); }
+    inline T* get() { return (T*)(fls ? FlsGetValue(key) : TlsGetValue(key)); }
   };
 }
 
@@ -21,6 +21,8 @@
 #include "threads/ThreadLocal.h"
 
 #include "threads/Event.h"
+#include "threads/SystemClock.h"
+#include "threads/Thread.h"
 #include "TestHelpers.h"
 
 using namespace XbmcThreads;
@@ -166,3 +168,31 @@ TEST(TestThreadLocal, HeapDestroyed)
   cleanup();
 }
 
+
+class OwningThreadLocal : public IRunnable
+{
+public:
+  ThreadLocal<Thinggy> threadLocal;
+  inline OwningThreadLocal() : threadLocal(true) {}
+  inline void Run()
+  {
+    threadLocal.set(new Thinggy);
+  }
+};
+
+TEST(TestThreadLocal, OwnedValueDeletedOnThreadExit)
+{
+  OwningThreadLocal runnable;
+  {
+    thread t(runnable);
+    t.join();
+  }
+
+  // the value is deleted after Run() returned, when the thread really exits
+  XbmcThreads::EndTime timeout(5000);
+  while (!destructorCalled && !timeout.IsTimePast())
+    XbmcThreads::ThreadSleep(1);
+  EXPECT_TRUE(destructorCalled);
+  EXPECT_TRUE(runnable.threadLocal.get() == NULL);
+  cleanup();
+}
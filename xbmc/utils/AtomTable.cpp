@@ -0,0 +1,124 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "AtomTable.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "threads/SharedSection.h"
+#include "utils/StringUtils.h"
+
+namespace
+{
+
+struct KeyHashNoCase
+{
+  size_t operator()(const std::string &key) const
+  {
+    // FNV-1a over the lower cased key, no temporary string needed
+    uint32_t hash = 2166136261u;
+    for (std::string::const_iterator it = key.begin(); it != key.end(); ++it)
+    {
+      unsigned char c = *it;
+      if (c >= 'A' && c <= 'Z')
+        c += 'a' - 'A';
+      hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+  }
+};
+
+struct KeyEqualsNoCase
+{
+  bool operator()(const std::string &s1, const std::string &s2) const
+  {
+    return s1.size() == s2.size() && StringUtils::EqualsNoCase(s1, s2);
+  }
+};
+
+typedef std::unordered_map<std::string, CAtomTable::Atom, KeyHashNoCase, KeyEqualsNoCase> AtomMap;
+
+struct AtomTableData
+{
+  AtomTableData()
+  {
+    // atom 0 is InvalidAtom
+    strings.push_back(&empty);
+  }
+
+  CSharedSection lock;
+  AtomMap atoms;
+  std::vector<const std::string*> strings; ///< keys of atoms, pointing into the map nodes
+  const std::string empty;
+};
+
+AtomTableData& GetData()
+{
+  static AtomTableData data;
+  return data;
+}
+
+}
+
+CAtomTable::Atom CAtomTable::Intern(const std::string &key)
+{
+  AtomTableData &data = GetData();
+  {
+    CSharedLock lock(data.lock);
+    AtomMap::const_iterator it = data.atoms.find(key);
+    if (it != data.atoms.end())
+      return it->second;
+  }
+
+  CExclusiveLock lock(data.lock);
+  Atom atom = static_cast<Atom>(data.strings.size());
+  std::pair<AtomMap::iterator, bool> result = data.atoms.insert(std::make_pair(key, atom));
+  if (result.second)
+    data.strings.push_back(&result.first->first);
+  return result.first->second;
+}
+
+CAtomTable::Atom CAtomTable::Find(const std::string &key)
+{
+  AtomTableData &data = GetData();
+  CSharedLock lock(data.lock);
+  AtomMap::const_iterator it = data.atoms.find(key);
+  if (it == data.atoms.end())
+    return InvalidAtom;
+  return it->second;
+}
+
+const std::string& CAtomTable::GetString(Atom atom)
+{
+  AtomTableData &data = GetData();
+  CSharedLock lock(data.lock);
+  if (atom >= data.strings.size())
+    return data.empty;
+  // map nodes never move, so the key outlives the lock
+  return *data.strings[atom];
+}
+
+size_t CAtomTable::Size()
+{
+  AtomTableData &data = GetData();
+  CSharedLock lock(data.lock);
+  return data.strings.size() - 1;
+}
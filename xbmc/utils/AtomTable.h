@@ -0,0 +1,67 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+/*!
+ \brief Process wide table of interned, case insensitive keys.
+
+ Property names are shared by every item of a listing, so items store a small
+ integer atom instead of their own copy of the name. Keys compare case
+ insensitively; the spelling used when a key is first interned is the one
+ returned by GetString().
+
+ Atoms are never released, the table is meant for the bounded set of keys
+ used by skins, addons and the core.
+ */
+class CAtomTable
+{
+public:
+  typedef uint32_t Atom;
+
+  /*! \brief Atom value that never refers to a key. */
+  static const Atom InvalidAtom = 0;
+
+  /*!
+   \brief Get the atom for a key, adding it to the table if needed.
+   \param key the key to intern.
+   \return the atom for the key, never InvalidAtom.
+   */
+  static Atom Intern(const std::string &key);
+
+  /*!
+   \brief Get the atom for a key without adding it.
+   \param key the key to look up.
+   \return the atom for the key, InvalidAtom if the key was never interned.
+   */
+  static Atom Find(const std::string &key);
+
+  /*!
+   \brief Get the key an atom was interned from.
+   \return the key, empty for InvalidAtom or unknown atoms.
+   */
+  static const std::string& GetString(Atom atom);
+
+  /*! \brief Number of keys in the table. */
+  static size_t Size();
+};
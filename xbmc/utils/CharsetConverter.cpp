@@ -20,6 +20,7 @@
 
 #include "CharsetConverter.h"
 
+#include <atomic>
 #include <cerrno>
 #include <algorithm>
 
@@ -33,7 +34,9 @@
 #include "settings/Settings.h"
 #include "system.h"
 #include "threads/SingleLock.h"
+#include "threads/ThreadLocal.h"
 #include "utils/StringUtils.h"
+#include "utils/UnicodeTranscoder.h"
 #include "utils/Utf8Utils.h"
 #include "log.h"
 
@@ -57,6 +60,7 @@
   #define UTF16_CHARSET "UTF-16" ENDIAN_SUFFIX
   #define UTF32_CHARSET "UTF-32" ENDIAN_SUFFIX
   #define UTF8_SOURCE "UTF-8-MAC"
+  #define UTF8_SOURCE_NEEDS_ICONV 1 /* UTF-8-MAC also composes decomposed characters */
   #define WCHAR_CHARSET UTF32_CHARSET
 #elif defined(TARGET_WINDOWS)
   #define WCHAR_IS_UTF16 1
@@ -107,9 +111,19 @@ public:
   CConverterType(const std::string&  sourceCharset,        enum SpecialCharset targetSpecialCharset, unsigned int targetSingleCharMaxLen = 1);
   CConverterType(enum SpecialCharset sourceSpecialCharset, enum SpecialCharset targetSpecialCharset, unsigned int targetSingleCharMaxLen = 1);
   CConverterType(const CConverterType& other);
-  ~CConverterType();
 
-  iconv_t GetConverter(CSingleLock& converterLock);
+  /*!
+   \brief Opens a new iconv handle for the current charsets
+   \param generation the generation of the charsets the handle has been opened for
+   \param targetSingleCharMaxLen the maximum length of a single character in the target charset
+   \return the iconv handle (to be closed by the caller) or NO_ICONV on failure
+   */
+  iconv_t OpenConverter(unsigned int& generation, unsigned int& targetSingleCharMaxLen);
+
+  /*!
+   \brief The generation is increased whenever the charsets change so handles opened for older generations have to be reopened
+   */
+  unsigned int GetGeneration(void) const { return m_generation; }
 
   void Reset(void);
   void ReinitTo(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen = 1);
@@ -124,8 +138,8 @@ private:
   std::string         m_sourceCharset;
   enum SpecialCharset m_targetSpecialCharset;
   std::string         m_targetCharset;
-  iconv_t             m_iconv;
   unsigned int        m_targetSingleCharMaxLen;
+  std::atomic<unsigned int> m_generation;
 };
 
 CConverterType::CConverterType(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen /*= 1*/) : CCriticalSection(),
@@ -133,8 +147,8 @@ CConverterType::CConverterType(const std::string& sourceCharset, const std::stri
   m_sourceCharset(sourceCharset),
   m_targetSpecialCharset(NotSpecialCharset),
   m_targetCharset(targetCharset),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -143,8 +157,8 @@ CConverterType::CConverterType(enum SpecialCharset sourceSpecialCharset, const s
   m_sourceCharset(),
   m_targetSpecialCharset(NotSpecialCharset),
   m_targetCharset(targetCharset),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -153,8 +167,8 @@ CConverterType::CConverterType(const std::string& sourceCharset, enum SpecialCha
   m_sourceCharset(sourceCharset),
   m_targetSpecialCharset(targetSpecialCharset),
   m_targetCharset(),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -163,8 +177,8 @@ CConverterType::CConverterType(enum SpecialCharset sourceSpecialCharset, enum Sp
   m_sourceCharset(),
   m_targetSpecialCharset(targetSpecialCharset),
   m_targetCharset(),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
@@ -173,59 +187,41 @@ CConverterType::CConverterType(const CConverterType& other) : CCriticalSection()
   m_sourceCharset(other.m_sourceCharset),
   m_targetSpecialCharset(other.m_targetSpecialCharset),
   m_targetCharset(other.m_targetCharset),
-  m_iconv(NO_ICONV),
-  m_targetSingleCharMaxLen(other.m_targetSingleCharMaxLen)
+  m_targetSingleCharMaxLen(other.m_targetSingleCharMaxLen),
+  m_generation(1)
 {
 }
 
 
-CConverterType::~CConverterType()
+iconv_t CConverterType::OpenConverter(unsigned int& generation, unsigned int& targetSingleCharMaxLen)
 {
   CSingleLock lock(*this);
-  if (m_iconv != NO_ICONV)
-    iconv_close(m_iconv);
-  lock.Leave(); // ensure unlocking before final destruction
-}
-
-
-iconv_t CConverterType::GetConverter(CSingleLock& converterLock)
-{
-  // ensure that this unique instance is locked externally
-  if (&converterLock.get_underlying() != this)
-    return NO_ICONV;
+  if (m_sourceSpecialCharset)
+    m_sourceCharset = ResolveSpecialCharset(m_sourceSpecialCharset);
+  if (m_targetSpecialCharset)
+    m_targetCharset = ResolveSpecialCharset(m_targetSpecialCharset);
 
-  if (m_iconv == NO_ICONV)
-  {
-    if (m_sourceSpecialCharset)
-      m_sourceCharset = ResolveSpecialCharset(m_sourceSpecialCharset);
-    if (m_targetSpecialCharset)
-      m_targetCharset = ResolveSpecialCharset(m_targetSpecialCharset);
+  generation = m_generation;
+  targetSingleCharMaxLen = m_targetSingleCharMaxLen;
 
-    m_iconv = iconv_open(m_targetCharset.c_str(), m_sourceCharset.c_str());
-    
-    if (m_iconv == NO_ICONV)
-      CLog::Log(LOGERROR, "%s: iconv_open() for \"%s\" -> \"%s\" failed, errno = %d (%s)",
-                __FUNCTION__, m_sourceCharset.c_str(), m_targetCharset.c_str(), errno, strerror(errno));
-  }
+  iconv_t converter = iconv_open(m_targetCharset.c_str(), m_sourceCharset.c_str());
+  if (converter == NO_ICONV)
+    CLog::Log(LOGERROR, "%s: iconv_open() for \"%s\" -> \"%s\" failed, errno = %d (%s)",
+              __FUNCTION__, m_sourceCharset.c_str(), m_targetCharset.c_str(), errno, strerror(errno));
 
-  return m_iconv;
+  return converter;
 }
 
 
 void CConverterType::Reset(void)
 {
   CSingleLock lock(*this);
-  if (m_iconv != NO_ICONV)
-  {
-    iconv_close(m_iconv);
-    m_iconv = NO_ICONV;
-  }
-
   if (m_sourceSpecialCharset)
     m_sourceCharset.clear();
   if (m_targetSpecialCharset)
     m_targetCharset.clear();
 
+  m_generation++;
 }
 
 void CConverterType::ReinitTo(const std::string& sourceCharset, const std::string& targetCharset, unsigned int targetSingleCharMaxLen /*= 1*/)
@@ -233,17 +229,12 @@ void CConverterType::ReinitTo(const std::string& sourceCharset, const std::strin
   CSingleLock lock(*this);
   if (sourceCharset != m_sourceCharset || targetCharset != m_targetCharset)
   {
-    if (m_iconv != NO_ICONV)
-    {
-      iconv_close(m_iconv);
-      m_iconv = NO_ICONV;
-    }
-
     m_sourceSpecialCharset = NotSpecialCharset;
     m_sourceCharset = sourceCharset;
     m_targetSpecialCharset = NotSpecialCharset;
     m_targetCharset = targetCharset;
     m_targetSingleCharMaxLen = targetSingleCharMaxLen;
+    m_generation++;
   }
 }
 
@@ -268,21 +259,12 @@ enum StdConversionType /* Keep it in sync with CCharsetConverter::CInnerConverte
 {
   NoConversion = -1,
   Utf8ToUtf32 = 0,
-  Utf32ToUtf8,
-  Utf32ToW,
-  WToUtf32,
   SubtitleCharsetToUtf8,
   Utf8ToUserCharset,
   UserCharsetToUtf8,
   Utf32ToUserCharset,
-  WtoUtf8,
-  Utf16LEtoW,
-  Utf16BEtoUtf8,
-  Utf16LEtoUtf8,
-  Utf8toW,
   Utf8ToSystem,
   SystemToUtf8,
-  Ucs2CharsetToUtf8,
   NumberOfStdConversionTypes /* Dummy sentinel entry */
 };
 
@@ -296,6 +278,9 @@ public:
   
   template<class INPUT,class OUTPUT>
   static bool stdConvert(StdConversionType convertType, const INPUT& strSource, OUTPUT& strDest, bool failOnInvalidChar = false);
+  /* converts from UTF8_SOURCE to UTF-16 or UTF-32 */
+  template<class OUTPUT>
+  static bool fromUtf8(const std::string& utf8StringSrc, OUTPUT& strDest, bool failOnInvalidChar = false);
   template<class INPUT,class OUTPUT>
   static bool customConvert(const std::string& sourceCharset, const std::string& targetCharset, const INPUT& strSource, OUTPUT& strDest, bool failOnInvalidChar = false);
 
@@ -313,23 +298,71 @@ const int CCharsetConverter::m_Utf8CharMaxSize = 4;
 CConverterType CCharsetConverter::CInnerConverter::m_stdConversion[NumberOfStdConversionTypes] = /* keep it in sync with enum StdConversionType */
 {
   /* Utf8ToUtf32 */         CConverterType(UTF8_SOURCE,     UTF32_CHARSET),
-  /* Utf32ToUtf8 */         CConverterType(UTF32_CHARSET,   "UTF-8", CCharsetConverter::m_Utf8CharMaxSize),
-  /* Utf32ToW */            CConverterType(UTF32_CHARSET,   WCHAR_CHARSET),
-  /* WToUtf32 */            CConverterType(WCHAR_CHARSET,   UTF32_CHARSET),
   /* SubtitleCharsetToUtf8*/CConverterType(SubtitleCharset, "UTF-8", CCharsetConverter::m_Utf8CharMaxSize),
   /* Utf8ToUserCharset */   CConverterType(UTF8_SOURCE,     UserCharset),
   /* UserCharsetToUtf8 */   CConverterType(UserCharset,     "UTF-8", CCharsetConverter::m_Utf8CharMaxSize),
   /* Utf32ToUserCharset */  CConverterType(UTF32_CHARSET,   UserCharset),
-  /* WtoUtf8 */             CConverterType(WCHAR_CHARSET,   "UTF-8", CCharsetConverter::m_Utf8CharMaxSize),
-  /* Utf16LEtoW */          CConverterType("UTF-16LE",      WCHAR_CHARSET),
-  /* Utf16BEtoUtf8 */       CConverterType("UTF-16BE",      "UTF-8", CCharsetConverter::m_Utf8CharMaxSize),
-  /* Utf16LEtoUtf8 */       CConverterType("UTF-16LE",      "UTF-8", CCharsetConverter::m_Utf8CharMaxSize),
-  /* Utf8toW */             CConverterType(UTF8_SOURCE,     WCHAR_CHARSET),
   /* Utf8ToSystem */        CConverterType(UTF8_SOURCE,     SystemCharset),
-  /* SystemToUtf8 */        CConverterType(SystemCharset,   UTF8_SOURCE),
-  /* Ucs2CharsetToUtf8 */   CConverterType("UCS-2LE",       "UTF-8", CCharsetConverter::m_Utf8CharMaxSize)
+  /* SystemToUtf8 */        CConverterType(SystemCharset,   UTF8_SOURCE)
 };
 
+/* iconv handles can't be shared between threads, so every thread opens its own
+   handles for the standard conversions instead of serializing all conversions */
+class CThreadConverters
+{
+public:
+  CThreadConverters()
+  {
+    for (int i = 0; i < NumberOfStdConversionTypes; i++)
+    {
+      m_converters[i] = NO_ICONV;
+      m_generations[i] = 0;
+      m_targetSingleCharMaxLen[i] = 1;
+    }
+  }
+
+  ~CThreadConverters()
+  {
+    for (int i = 0; i < NumberOfStdConversionTypes; i++)
+    {
+      if (m_converters[i] != NO_ICONV)
+        iconv_close(m_converters[i]);
+    }
+  }
+
+  iconv_t Get(StdConversionType convertType, CConverterType& convType, unsigned int& targetSingleCharMaxLen)
+  {
+    if (m_converters[convertType] == NO_ICONV || m_generations[convertType] != convType.GetGeneration())
+    {
+      if (m_converters[convertType] != NO_ICONV)
+        iconv_close(m_converters[convertType]);
+      m_converters[convertType] = convType.OpenConverter(m_generations[convertType], m_targetSingleCharMaxLen[convertType]);
+    }
+
+    targetSingleCharMaxLen = m_targetSingleCharMaxLen[convertType];
+    return m_converters[convertType];
+  }
+
+private:
+  iconv_t      m_converters[NumberOfStdConversionTypes];
+  unsigned int m_generations[NumberOfStdConversionTypes];
+  unsigned int m_targetSingleCharMaxLen[NumberOfStdConversionTypes];
+};
+
+// allocated on first use and deleted when the thread exits
+static XbmcThreads::ThreadLocal<CThreadConverters> g_threadConverters(true);
+
+static CThreadConverters& GetThreadConverters()
+{
+  CThreadConverters* converters = g_threadConverters.get();
+  if (converters == NULL)
+  {
+    converters = new CThreadConverters;
+    g_threadConverters.set(converters);
+  }
+  return *converters;
+}
+
 CCriticalSection CCharsetConverter::CInnerConverter::m_critSectionFriBiDi;
 
 
@@ -344,10 +377,27 @@ bool CCharsetConverter::CInnerConverter::stdConvert(StdConversionType convertTyp
   if (convertType < 0 || convertType >= NumberOfStdConversionTypes)
     return false;
 
-  CConverterType& convType = m_stdConversion[convertType];
-  CSingleLock converterLock(convType);
+  unsigned int targetSingleCharMaxLen;
+  iconv_t converter = GetThreadConverters().Get(convertType, m_stdConversion[convertType], targetSingleCharMaxLen);
+
+  return convert(converter, targetSingleCharMaxLen, strSource, strDest, failOnInvalidChar);
+}
+
+template<class OUTPUT>
+bool CCharsetConverter::CInnerConverter::fromUtf8(const std::string& utf8StringSrc, OUTPUT& strDest, bool failOnInvalidChar /*= false*/)
+{
+#ifdef UTF8_SOURCE_NEEDS_ICONV
+  std::u32string utf32String;
+  if (!stdConvert(Utf8ToUtf32, utf8StringSrc, utf32String, failOnInvalidChar))
+  {
+    strDest.clear();
+    return false;
+  }
 
-  return convert(convType.GetConverter(converterLock), convType.GetTargetSingleCharMaxLen(), strSource, strDest, failOnInvalidChar);
+  return CUnicodeTranscoder::Convert(utf32String, strDest, false, failOnInvalidChar);
+#else
+  return CUnicodeTranscoder::FromUtf8(utf8StringSrc, strDest, failOnInvalidChar);
+#endif
 }
 
 template<class INPUT,class OUTPUT>
@@ -664,7 +714,7 @@ void CCharsetConverter::reinitCharsetsFromSettings(void)
 
 bool CCharsetConverter::utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst, bool failOnBadChar /*= true*/)
 {
-  return CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32StringDst, failOnBadChar);
+  return CInnerConverter::fromUtf8(utf8StringSrc, utf32StringDst, failOnBadChar);
 }
 
 std::u32string CCharsetConverter::utf8ToUtf32(const std::string& utf8StringSrc, bool failOnBadChar /*= true*/)
@@ -679,17 +729,17 @@ bool CCharsetConverter::utf8ToUtf32Visual(const std::string& utf8StringSrc, std:
   if (bVisualBiDiFlip)
   {
     std::u32string converted;
-    if (!CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, converted, failOnBadChar))
+    if (!CInnerConverter::fromUtf8(utf8StringSrc, converted, failOnBadChar))
       return false;
 
     return CInnerConverter::logicalToVisualBiDi(converted, utf32StringDst, forceLTRReadingOrder ? FRIBIDI_TYPE_LTR : FRIBIDI_TYPE_PDF, failOnBadChar);
   }
-  return CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32StringDst, failOnBadChar);
+  return CInnerConverter::fromUtf8(utf8StringSrc, utf32StringDst, failOnBadChar);
 }
 
 bool CCharsetConverter::utf32ToUtf8(const std::u32string& utf32StringSrc, std::string& utf8StringDst, bool failOnBadChar /*= true*/)
 {
-  return CInnerConverter::stdConvert(Utf32ToUtf8, utf32StringSrc, utf8StringDst, failOnBadChar);
+  return CUnicodeTranscoder::ToUtf8(utf32StringSrc, utf8StringDst, false, failOnBadChar);
 }
 
 std::string CCharsetConverter::utf32ToUtf8(const std::u32string& utf32StringSrc, bool failOnBadChar /*= false*/)
@@ -705,7 +755,7 @@ bool CCharsetConverter::utf32ToW(const std::u32string& utf32StringSrc, std::wstr
   wStringDst.assign((const wchar_t*)utf32StringSrc.c_str(), utf32StringSrc.length());
   return true;
 #else // !WCHAR_IS_UCS_4
-  return CInnerConverter::stdConvert(Utf32ToW, utf32StringSrc, wStringDst, failOnBadChar);
+  return CUnicodeTranscoder::Convert(utf32StringSrc, wStringDst, false, failOnBadChar);
 #endif // !WCHAR_IS_UCS_4
 }
 
@@ -720,7 +770,7 @@ bool CCharsetConverter::wToUtf32(const std::wstring& wStringSrc, std::u32string&
   /* UCS-4 is almost equal to UTF-32, but UTF-32 has strict limits on possible values, while UCS-4 is usually unchecked.
    * With this "conversion" we ensure that output will be valid UTF-32 string. */
 #endif
-  return CInnerConverter::stdConvert(WToUtf32, wStringSrc, utf32StringDst, failOnBadChar);
+  return CUnicodeTranscoder::Convert(wStringSrc, utf32StringDst, false, failOnBadChar);
 }
 
 // The bVisualBiDiFlip forces a flip of characters for hebrew/arabic languages, only set to false if the flipping
@@ -733,16 +783,16 @@ bool CCharsetConverter::utf8ToW(const std::string& utf8StringSrc, std::wstring&
   {
     wStringDst.clear();
     std::u32string utf32str;
-    if (!CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32str, failOnBadChar))
+    if (!CInnerConverter::fromUtf8(utf8StringSrc, utf32str, failOnBadChar))
       return false;
 
     std::u32string utf32flipped;
     const bool bidiResult = CInnerConverter::logicalToVisualBiDi(utf32str, utf32flipped, forceLTRReadingOrder ? FRIBIDI_TYPE_LTR : FRIBIDI_TYPE_PDF, failOnBadChar);
 
-    return CInnerConverter::stdConvert(Utf32ToW, utf32flipped, wStringDst, failOnBadChar) && bidiResult;
+    return CUnicodeTranscoder::Convert(utf32flipped, wStringDst, false, failOnBadChar) && bidiResult;
   }
   
-  return CInnerConverter::stdConvert(Utf8toW, utf8StringSrc, wStringDst, failOnBadChar);
+  return CInnerConverter::fromUtf8(utf8StringSrc, wStringDst, failOnBadChar);
 }
 
 bool CCharsetConverter::subtitleCharsetToUtf8(const std::string& stringSrc, std::string& utf8StringDst)
@@ -824,28 +874,44 @@ bool CCharsetConverter::unknownToUTF8(const std::string& stringSrc, std::string&
 
 bool CCharsetConverter::wToUTF8(const std::wstring& wStringSrc, std::string& utf8StringDst, bool failOnBadChar /*= false*/)
 {
-  return CInnerConverter::stdConvert(WtoUtf8, wStringSrc, utf8StringDst, failOnBadChar);
+  return CUnicodeTranscoder::ToUtf8(wStringSrc, utf8StringDst, false, failOnBadChar);
 }
 
 bool CCharsetConverter::utf16BEtoUTF8(const std::u16string& utf16StringSrc, std::string& utf8StringDst)
 {
-  return CInnerConverter::stdConvert(Utf16BEtoUtf8, utf16StringSrc, utf8StringDst);
+#ifdef WORDS_BIGENDIAN
+  return CUnicodeTranscoder::ToUtf8(utf16StringSrc, utf8StringDst, false);
+#else
+  return CUnicodeTranscoder::ToUtf8(utf16StringSrc, utf8StringDst, true);
+#endif
 }
 
 bool CCharsetConverter::utf16LEtoUTF8(const std::u16string& utf16StringSrc,
                                       std::string& utf8StringDst)
 {
-  return CInnerConverter::stdConvert(Utf16LEtoUtf8, utf16StringSrc, utf8StringDst);
+#ifdef WORDS_BIGENDIAN
+  return CUnicodeTranscoder::ToUtf8(utf16StringSrc, utf8StringDst, true);
+#else
+  return CUnicodeTranscoder::ToUtf8(utf16StringSrc, utf8StringDst, false);
+#endif
 }
 
 bool CCharsetConverter::ucs2ToUTF8(const std::u16string& ucs2StringSrc, std::string& utf8StringDst)
 {
-  return CInnerConverter::stdConvert(Ucs2CharsetToUtf8, ucs2StringSrc,utf8StringDst);
+#ifdef WORDS_BIGENDIAN
+  return CUnicodeTranscoder::Ucs2ToUtf8(ucs2StringSrc, utf8StringDst, true);
+#else
+  return CUnicodeTranscoder::Ucs2ToUtf8(ucs2StringSrc, utf8StringDst, false);
+#endif
 }
 
 bool CCharsetConverter::utf16LEtoW(const std::u16string& utf16String, std::wstring& wString)
 {
-  return CInnerConverter::stdConvert(Utf16LEtoW, utf16String, wString);
+#ifdef WORDS_BIGENDIAN
+  return CUnicodeTranscoder::Convert(utf16String, wString, true);
+#else
+  return CUnicodeTranscoder::Convert(utf16String, wString, false);
+#endif
 }
 
 bool CCharsetConverter::utf32ToStringCharset(const std::u32string& utf32StringSrc, std::string& stringDst)
@@ -871,7 +937,7 @@ bool CCharsetConverter::utf8logicalToVisualBiDi(const std::string& utf8StringSrc
   if (!utf8ToUtf32Visual(utf8StringSrc, utf32flipped, true, true, failOnBadString))
     return false;
 
-  return CInnerConverter::stdConvert(Utf32ToUtf8, utf32flipped, utf8StringDst, failOnBadString);
+  return CUnicodeTranscoder::ToUtf8(utf32flipped, utf8StringDst, false, failOnBadString);
 }
 
 void CCharsetConverter::SettingOptionsCharsetsFiller(const CSetting* setting, std::vector< std::pair<std::string, std::string> >& list, std::string& current, void *data)
@@ -0,0 +1,155 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+/*!
+ \brief Associative container kept as a sorted vector.
+
+ Meant for the handful of entries stored per list item: a single allocation
+ holds all entries, lookups are a binary search and iteration is in key order
+ like std::map. Inserting or erasing invalidates iterators.
+
+ Converts explicitly from and to std::map, see ToMap(), for code working with
+ plain maps.
+ */
+template<typename Key, typename Value, typename Compare = std::less<Key> >
+class CFlatMap
+{
+public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<Key, Value> value_type;
+  typedef typename std::vector<value_type>::iterator iterator;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+  typedef typename std::vector<value_type>::size_type size_type;
+
+  CFlatMap() {}
+
+  template<typename OtherCompare>
+  explicit CFlatMap(const std::map<Key, Value, OtherCompare> &map)
+  {
+    Assign(map.begin(), map.end());
+  }
+
+  std::map<Key, Value> ToMap() const
+  {
+    return std::map<Key, Value>(m_entries.begin(), m_entries.end());
+  }
+
+  iterator begin() { return m_entries.begin(); }
+  iterator end() { return m_entries.end(); }
+  const_iterator begin() const { return m_entries.begin(); }
+  const_iterator end() const { return m_entries.end(); }
+
+  bool empty() const { return m_entries.empty(); }
+  size_type size() const { return m_entries.size(); }
+  void clear() { m_entries.clear(); }
+  void reserve(size_type size) { m_entries.reserve(size); }
+
+  /*! \brief Release unused capacity, for maps that are done growing. */
+  void shrink_to_fit() { m_entries.shrink_to_fit(); }
+
+  iterator find(const Key &key)
+  {
+    iterator it = lower_bound(key);
+    return (it != end() && !m_compare(key, it->first)) ? it : end();
+  }
+
+  const_iterator find(const Key &key) const
+  {
+    const_iterator it = lower_bound(key);
+    return (it != end() && !m_compare(key, it->first)) ? it : end();
+  }
+
+  size_type count(const Key &key) const { return find(key) != end() ? 1 : 0; }
+
+  std::pair<iterator, bool> insert(const value_type &value)
+  {
+    iterator it = lower_bound(value.first);
+    if (it != end() && !m_compare(value.first, it->first))
+      return std::make_pair(it, false);
+    return std::make_pair(m_entries.insert(it, value), true);
+  }
+
+  Value& operator[](const Key &key)
+  {
+    iterator it = lower_bound(key);
+    if (it == end() || m_compare(key, it->first))
+      it = m_entries.insert(it, value_type(key, Value()));
+    return it->second;
+  }
+
+  iterator erase(iterator it) { return m_entries.erase(it); }
+
+  size_type erase(const Key &key)
+  {
+    iterator it = find(key);
+    if (it == end())
+      return 0;
+    m_entries.erase(it);
+    return 1;
+  }
+
+  bool operator==(const CFlatMap &right) const { return m_entries == right.m_entries; }
+  bool operator!=(const CFlatMap &right) const { return m_entries != right.m_entries; }
+
+private:
+  struct KeyCompare
+  {
+    explicit KeyCompare(const Compare &compare) : m_compare(compare) {}
+    bool operator()(const value_type &entry, const Key &key) const { return m_compare(entry.first, key); }
+    const Compare &m_compare;
+  };
+
+  iterator lower_bound(const Key &key)
+  {
+    return std::lower_bound(m_entries.begin(), m_entries.end(), key, KeyCompare(m_compare));
+  }
+
+  const_iterator lower_bound(const Key &key) const
+  {
+    return std::lower_bound(m_entries.begin(), m_entries.end(), key, KeyCompare(m_compare));
+  }
+
+  template<typename InputIterator>
+  void Assign(InputIterator first, InputIterator last)
+  {
+    // source is already sorted, but possibly by another predicate
+    m_entries.assign(first, last);
+    if (!std::is_sorted(m_entries.begin(), m_entries.end(), EntryCompare(m_compare)))
+      std::sort(m_entries.begin(), m_entries.end(), EntryCompare(m_compare));
+  }
+
+  struct EntryCompare
+  {
+    explicit EntryCompare(const Compare &compare) : m_compare(compare) {}
+    bool operator()(const value_type &a, const value_type &b) const { return m_compare(a.first, b.first); }
+    const Compare &m_compare;
+  };
+
+  std::vector<value_type> m_entries;
+  Compare m_compare;
+};
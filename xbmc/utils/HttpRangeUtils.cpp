@@ -301,22 +301,23 @@ bool CHttpRanges::Parse(const std::string& header, uint64_t totalLength)
     if (!hasStart && !hasEnd)
       return false;
 
-    // make sure that the end position makes sense
-    if (hasEnd)
-      end = std::min(end, lastPossiblePosition);
-
     if (!hasStart && hasEnd)
     {
       // the range is defined as the number of bytes from the end
-      start = totalLength - end;
+      // (a suffix longer than the entity selects the whole entity)
+      start = totalLength - std::min(end, totalLength);
       end = lastPossiblePosition;
     }
     else if (hasStart && !hasEnd)
       end = lastPossiblePosition;
+    // make sure that the end position makes sense
+    else
+      end = std::min(end, lastPossiblePosition);
 
-    // make sure the start position makes sense
+    // ranges starting behind the end can't be satisfied but the others
+    // still are (RFC 7233 section 4.4)
     if (start > lastPossiblePosition)
-      return false;
+      continue;
 
     // make sure that the start position is smaller or equal to the end position
     if (end < start)
@@ -777,6 +777,129 @@ bool SortUtils::SortFromDataset(const SortDescription &sortDescription, const Me
   return true;
 }
 
+std::string GetOrderLabel(const std::string &column, SortAttribute attributes)
+{
+  std::string label = "lower(" + column + ")";
+  if (!(attributes & SortAttributeIgnoreArticle))
+    return label;
+
+  // same as RemoveArticles(), the first matching sort token is removed
+  std::string orderLabel = "CASE";
+  std::set<std::string> sortTokens = g_langInfo.GetSortTokens();
+  for (std::set<std::string>::const_iterator token = sortTokens.begin(); token != sortTokens.end(); ++token)
+  {
+    std::string value = *token;
+    StringUtils::ToLower(value);
+    StringUtils::Replace(value, "'", "''");
+    orderLabel += StringUtils::Format(" WHEN length(%s) > %u AND lower(substr(%s, 1, %u)) = '%s' THEN lower(substr(%s, %u))",
+                                      column.c_str(), (unsigned int)token->size(), column.c_str(), (unsigned int)token->size(),
+                                      value.c_str(), column.c_str(), (unsigned int)token->size() + 1);
+  }
+
+  if (sortTokens.empty())
+    return label;
+
+  return orderLabel + " ELSE " + label + " END";
+}
+
+bool SortUtils::GetOrderClause(const SortDescription &sortDescription, const MediaType &mediaType, std::string &orderClause)
+{
+  // the label items with the same value are sorted by
+  Field labelField = FieldTitle;
+  if (mediaType == MediaTypeArtist)
+    labelField = FieldArtist;
+  else if (mediaType == MediaTypeAlbum)
+    labelField = FieldAlbum;
+
+  Field field;
+  bool isLabel = false;
+  bool isNumber = false;
+  bool byLabel = true;
+  DatabaseQueryPart queryPart = DatabaseQueryPartSelect;
+  switch (sortDescription.sortBy)
+  {
+    case SortByLabel:
+      // the labels of songs and episodes are formatted from several fields
+      if (mediaType == MediaTypeSong || mediaType == MediaTypeEpisode)
+        return false;
+      field = labelField;
+      isLabel = true;
+      break;
+    case SortByTitle:
+      field = FieldTitle;
+      isLabel = true;
+      break;
+    case SortBySortTitle:
+      // the title of items without a sort title
+      field = FieldTitle;
+      queryPart = DatabaseQueryPartOrderBy;
+      isLabel = true;
+      break;
+    case SortByYear:
+      // episodes are sorted by their air date and songs by their album first
+      if (mediaType == MediaTypeEpisode || mediaType == MediaTypeSong)
+        return false;
+      field = FieldYear;
+      isNumber = true;
+      break;
+    case SortByRating:
+      field = FieldRating;
+      isNumber = true;
+      break;
+    case SortByUserRating:
+      field = FieldUserRating;
+      isNumber = true;
+      break;
+    case SortByVotes:
+      field = FieldVotes;
+      isNumber = true;
+      break;
+    case SortByPlaycount:
+      field = FieldPlaycount;
+      isNumber = true;
+      break;
+    case SortByLastPlayed:
+      field = FieldLastPlayed;
+      break;
+    case SortByDateAdded:
+      field = FieldDateAdded;
+      byLabel = false;
+      break;
+    case SortByTime:
+      field = FieldTime;
+      isNumber = true;
+      byLabel = false;
+      break;
+    case SortByTrackNumber:
+      field = FieldTrackNumber;
+      isNumber = true;
+      byLabel = false;
+      break;
+    default:
+      return false;
+  }
+
+  std::string column = DatabaseUtils::GetField(field, mediaType, queryPart);
+  std::string label = DatabaseUtils::GetField(labelField, mediaType, DatabaseQueryPartSelect);
+  std::string id = DatabaseUtils::GetField(FieldId, mediaType, DatabaseQueryPartSelect);
+  if (column.empty() || label.empty() || id.empty())
+    return false;
+
+  std::string direction = sortDescription.sortOrder == SortOrderDescending ? " DESC" : " ASC";
+  if (isLabel)
+    orderClause = GetOrderLabel(column, sortDescription.sortAttributes) + direction;
+  else if (isNumber)
+    orderClause = column + "+0" + direction;
+  else
+    orderClause = column + direction;
+
+  if (byLabel && !isLabel)
+    orderClause += ", " + GetOrderLabel(label, sortDescription.sortAttributes) + direction;
+  orderClause += ", " + id + direction;
+
+  return true;
+}
+
 const SortUtils::SortPreparator& SortUtils::getPreparator(SortBy sortBy)
 {
   std::map<SortBy, SortPreparator>::const_iterator it = m_preparators.find(sortBy);
@@ -144,7 +144,15 @@ public:
   static void Sort(const SortDescription &sortDescription, DatabaseResults& items);
   static void Sort(const SortDescription &sortDescription, SortItems& items);
   static bool SortFromDataset(const SortDescription &sortDescription, const MediaType &mediaType, const std::unique_ptr<dbiplus::Dataset> &dataset, DatabaseResults &results);
-  
+  /*! \brief build an ORDER BY clause sorting the rows of a library view by the given sort method.
+   Labels are compared case insensitively but, unlike Sort(), without natural number ordering.
+   \param sortDescription the sort method, order and attributes to sort by.
+   \param mediaType the media type of the rows to sort.
+   \param orderClause the ORDER BY clause (without the keywords).
+   \return true if the sort method can be done by the database, false otherwise.
+   */
+  static bool GetOrderClause(const SortDescription &sortDescription, const MediaType &mediaType, std::string &orderClause);
+
   static const Fields& GetFieldsForSorting(SortBy sortBy);
   static std::string RemoveArticles(const std::string &label);
   
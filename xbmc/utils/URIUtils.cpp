@@ -27,6 +27,7 @@
 #include "filesystem/StackDirectory.h"
 #include "network/DNSNameCache.h"
 #include "settings/AdvancedSettings.h"
+#include "ParsedURL.h"
 #include "URL.h"
 #include "StringUtils.h"
 
@@ -1354,3 +1355,273 @@ bool URIUtils::IsUsingFastSwitch(const std::string& strFile)
 {
   return IsUDP(strFile) || IsTCP(strFile) || IsPVRChannel(strFile);
 }
+
+bool URIUtils::HasParentInHostname(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_ZIP)
+      || url.IsProtocol(CParsedURL::PROTOCOL_RAR)
+      || url.IsProtocol(CParsedURL::PROTOCOL_APK)
+      || url.IsProtocol(CParsedURL::PROTOCOL_BLURAY)
+      || url.IsProtocol(CParsedURL::PROTOCOL_UDF)
+      || url.IsProtocol(CParsedURL::PROTOCOL_XBT);
+}
+
+bool URIUtils::IsAddonsPath(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_ADDONS);
+}
+
+bool URIUtils::IsSourcesPath(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_SOURCES);
+}
+
+bool URIUtils::IsCDDA(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_CDDA);
+}
+
+bool URIUtils::IsDAV(const CParsedURL& url)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_STACK) || url.IsProtocol(CParsedURL::PROTOCOL_SPECIAL) || url.RequiresFullParse())
+    return IsDAV(url.Get());
+
+  if (HasParentInHostname(url))
+    return IsDAV(url.GetHostName());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_DAV) ||
+         url.IsProtocol(CParsedURL::PROTOCOL_DAVS);
+}
+
+bool URIUtils::IsFTP(const CParsedURL& url)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_STACK) || url.IsProtocol(CParsedURL::PROTOCOL_SPECIAL) || url.RequiresFullParse())
+    return IsFTP(url.Get());
+
+  if (HasParentInHostname(url))
+    return IsFTP(url.GetHostName());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_FTP) ||
+         url.IsProtocol(CParsedURL::PROTOCOL_FTPS);
+}
+
+bool URIUtils::IsHTTP(const CParsedURL& url)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_STACK) || url.IsProtocol(CParsedURL::PROTOCOL_SPECIAL) || url.RequiresFullParse())
+    return IsHTTP(url.Get());
+
+  if (HasParentInHostname(url))
+    return IsHTTP(url.GetHostName());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_HTTP) ||
+         url.IsProtocol(CParsedURL::PROTOCOL_HTTPS);
+}
+
+bool URIUtils::IsHD(const CParsedURL& url)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_STACK) || url.IsProtocol(CParsedURL::PROTOCOL_SPECIAL) || url.RequiresFullParse())
+    return IsHD(url.Get());
+
+  if (HasParentInHostname(url))
+    return IsHD(url.GetHostName());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_NONE) || url.IsProtocol(CParsedURL::PROTOCOL_FILE);
+}
+
+bool URIUtils::IsInArchive(const CParsedURL& url)
+{
+  return IsInZIP(url) || IsInRAR(url) || IsInAPK(url);
+}
+
+bool URIUtils::IsInRAR(const CParsedURL& url)
+{
+  if (url.RequiresFullParse())
+    return IsInRAR(url.Get());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_RAR) && url.HasFileName();
+}
+
+bool URIUtils::IsInternetStream(const CParsedURL& url, bool bStrictCheck /* = false */)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_NONE))
+    return false;
+
+  // there's nothing to stop internet streams from being stacked
+  if (url.IsProtocol(CParsedURL::PROTOCOL_STACK))
+    return IsInternetStream(CStackDirectory::GetFirstStackedFile(url.Get()));
+
+  // Special case these
+  switch (url.GetProtocol())
+  {
+  case CParsedURL::PROTOCOL_FTP:
+  case CParsedURL::PROTOCOL_FTPS:
+  case CParsedURL::PROTOCOL_DAV:
+  case CParsedURL::PROTOCOL_DAVS:
+  case CParsedURL::PROTOCOL_SFTP:
+    return bStrictCheck;
+  default:
+    break;
+  }
+
+  switch (url.GetTranslatedProtocol())
+  {
+  case CParsedURL::PROTOCOL_HTTP:
+  case CParsedURL::PROTOCOL_HTTPS:
+  case CParsedURL::PROTOCOL_TCP:
+  case CParsedURL::PROTOCOL_UDP:
+  case CParsedURL::PROTOCOL_RTP:
+  case CParsedURL::PROTOCOL_SDP:
+  case CParsedURL::PROTOCOL_MMS:
+  case CParsedURL::PROTOCOL_MMST:
+  case CParsedURL::PROTOCOL_MMSH:
+  case CParsedURL::PROTOCOL_RTSP:
+  case CParsedURL::PROTOCOL_RTMP:
+  case CParsedURL::PROTOCOL_RTMPT:
+  case CParsedURL::PROTOCOL_RTMPE:
+  case CParsedURL::PROTOCOL_RTMPTE:
+  case CParsedURL::PROTOCOL_RTMPS:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool URIUtils::IsInAPK(const CParsedURL& url)
+{
+  if (url.RequiresFullParse())
+    return IsInAPK(url.Get());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_APK) && url.HasFileName();
+}
+
+bool URIUtils::IsInZIP(const CParsedURL& url)
+{
+  if (url.RequiresFullParse())
+    return IsInZIP(url.Get());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_ZIP) && url.HasFileName();
+}
+
+bool URIUtils::IsISO9660(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_ISO9660);
+}
+
+bool URIUtils::IsMultiPath(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_MULTIPATH);
+}
+
+bool URIUtils::IsMusicDb(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_MUSICDB);
+}
+
+bool URIUtils::IsNfs(const CParsedURL& url)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_STACK) || url.IsProtocol(CParsedURL::PROTOCOL_SPECIAL) || url.RequiresFullParse())
+    return IsNfs(url.Get());
+
+  if (HasParentInHostname(url))
+    return IsNfs(url.GetHostName());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_NFS);
+}
+
+bool URIUtils::IsOnLAN(const CParsedURL& url)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_MULTIPATH) || url.IsProtocol(CParsedURL::PROTOCOL_STACK) ||
+      url.IsProtocol(CParsedURL::PROTOCOL_SPECIAL) || url.RequiresFullParse())
+    return IsOnLAN(url.Get());
+
+  if (url.IsProtocol(CParsedURL::PROTOCOL_PLUGIN))
+    return false;
+
+  if (url.IsProtocol(CParsedURL::PROTOCOL_UPNP))
+    return true;
+
+  if (HasParentInHostname(url))
+    return IsOnLAN(url.GetHostName());
+
+  if (!IsRemote(url))
+    return false;
+
+  return IsHostOnLAN(url.GetHostName());
+}
+
+bool URIUtils::IsPlugin(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_PLUGIN);
+}
+
+bool URIUtils::IsScript(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_SCRIPT);
+}
+
+bool URIUtils::IsRemote(const CParsedURL& url)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_CDDA) || url.IsProtocol(CParsedURL::PROTOCOL_ISO9660))
+    return false;
+
+  if (url.IsProtocol(CParsedURL::PROTOCOL_STACK) || url.IsProtocol(CParsedURL::PROTOCOL_SPECIAL) ||
+      url.IsProtocol(CParsedURL::PROTOCOL_MULTIPATH) || url.RequiresFullParse())
+    return IsRemote(url.Get());
+
+  if (HasParentInHostname(url))
+    return IsRemote(url.GetHostName());
+
+  if (url.IsProtocol(CParsedURL::PROTOCOL_NONE))
+    return false;
+
+  return !g_application.getNetwork().IsLocalHost(url.GetHostName());
+}
+
+bool URIUtils::IsSmb(const CParsedURL& url)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_STACK) || url.IsProtocol(CParsedURL::PROTOCOL_SPECIAL) || url.RequiresFullParse())
+    return IsSmb(url.Get());
+
+  if (HasParentInHostname(url))
+    return IsSmb(url.GetHostName());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_SMB);
+}
+
+bool URIUtils::IsSpecial(const CParsedURL& url)
+{
+  if (url.IsProtocol(CParsedURL::PROTOCOL_STACK))
+    return IsSpecial(url.Get());
+
+  return url.IsProtocol(CParsedURL::PROTOCOL_SPECIAL);
+}
+
+bool URIUtils::IsStack(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_STACK);
+}
+
+bool URIUtils::IsUPnP(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_UPNP);
+}
+
+bool URIUtils::IsVideoDb(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_VIDEODB);
+}
+
+bool URIUtils::IsBluray(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_BLURAY);
+}
+
+bool URIUtils::IsAndroidApp(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_ANDROIDAPP);
+}
+
+bool URIUtils::IsLibraryFolder(const CParsedURL& url)
+{
+  return url.IsProtocol(CParsedURL::PROTOCOL_LIBRARY);
+}
@@ -23,6 +23,7 @@
 #include <vector>
 
 class CURL;
+class CParsedURL;
 
 class URIUtils
 {
@@ -165,6 +166,40 @@ public:
   static bool IsPVRChannel(const std::string& strFile);
   static bool IsUsingFastSwitch(const std::string& strFile);
 
+  /*! \brief Overloads of the checks above for an already parsed path.
+   They behave like the ones taking a string but don't need to parse the
+   path again unless it has to be translated (e.g. stacks or special://).
+   \sa CParsedURL
+   */
+  static bool IsAddonsPath(const CParsedURL& url);
+  static bool IsSourcesPath(const CParsedURL& url);
+  static bool IsCDDA(const CParsedURL& url);
+  static bool IsDAV(const CParsedURL& url);
+  static bool IsFTP(const CParsedURL& url);
+  static bool IsHTTP(const CParsedURL& url);
+  static bool IsHD(const CParsedURL& url);
+  static bool IsInArchive(const CParsedURL& url);
+  static bool IsInRAR(const CParsedURL& url);
+  static bool IsInternetStream(const CParsedURL& url, bool bStrictCheck = false);
+  static bool IsInAPK(const CParsedURL& url);
+  static bool IsInZIP(const CParsedURL& url);
+  static bool IsISO9660(const CParsedURL& url);
+  static bool IsMultiPath(const CParsedURL& url);
+  static bool IsMusicDb(const CParsedURL& url);
+  static bool IsNfs(const CParsedURL& url);
+  static bool IsOnLAN(const CParsedURL& url);
+  static bool IsPlugin(const CParsedURL& url);
+  static bool IsScript(const CParsedURL& url);
+  static bool IsRemote(const CParsedURL& url);
+  static bool IsSmb(const CParsedURL& url);
+  static bool IsSpecial(const CParsedURL& url);
+  static bool IsStack(const CParsedURL& url);
+  static bool IsUPnP(const CParsedURL& url);
+  static bool IsVideoDb(const CParsedURL& url);
+  static bool IsBluray(const CParsedURL& url);
+  static bool IsAndroidApp(const CParsedURL& url);
+  static bool IsLibraryFolder(const CParsedURL& url);
+
   static void AddSlashAtEnd(std::string& strFolder);
   static bool HasSlashAtEnd(const std::string& strFile, bool checkURL = false);
   static void RemoveSlashAtEnd(std::string& strFolder);
@@ -191,6 +226,7 @@ public:
   static std::string AddFileToFolder(const std::string &strFolder, const std::string &strFile);
 
   static bool HasParentInHostname(const CURL& url);
+  static bool HasParentInHostname(const CParsedURL& url);
   static bool HasEncodedHostname(const CURL& url);
   static bool HasEncodedFilename(const CURL& url);
 
@@ -0,0 +1,460 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "UnicodeTranscoder.h"
+
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define UNICODE_SSE2 1
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+  #define UNICODE_NEON 1
+  #include <arm_neon.h>
+#endif
+
+#define UNICODE_MAX_CODEPOINT 0x10FFFF
+
+static inline bool IsSurrogate(uint32_t codepoint)
+{
+  return codepoint >= 0xD800 && codepoint <= 0xDFFF;
+}
+
+template<class CHAR>
+static inline uint32_t GetUnit(const CHAR* in, bool swapBytes)
+{
+  if (sizeof(CHAR) == 2)
+  {
+    uint16_t unit = static_cast<uint16_t>(*in);
+    return swapBytes ? static_cast<uint16_t>((unit >> 8) | (unit << 8)) : unit;
+  }
+
+  uint32_t unit = static_cast<uint32_t>(*in);
+  if (swapBytes)
+    unit = (unit >> 24) | ((unit >> 8) & 0xFF00) | ((unit << 8) & 0xFF0000) | (unit << 24);
+  return unit;
+}
+
+/*! \brief Decodes the UTF-8 character at the start of the buffer
+ \return the length of the character, 0 if it's invalid or -1 if it's cut off by the end of the buffer
+ */
+static inline int DecodeUtf8(const unsigned char* in, size_t length, uint32_t& codepoint)
+{
+  const unsigned char lead = in[0];
+  int size;
+  if (lead < 0x80)
+  {
+    codepoint = lead;
+    return 1;
+  }
+  else if (lead < 0xC2) // continuation byte or overlong two byte sequence
+    return 0;
+  else if (lead < 0xE0)
+  {
+    size = 2;
+    codepoint = lead & 0x1F;
+  }
+  else if (lead < 0xF0)
+  {
+    size = 3;
+    codepoint = lead & 0x0F;
+  }
+  else if (lead < 0xF5)
+  {
+    size = 4;
+    codepoint = lead & 0x07;
+  }
+  else
+    return 0;
+
+  for (int i = 1; i < size; i++)
+  {
+    if (static_cast<size_t>(i) >= length)
+      return -1;
+    if ((in[i] & 0xC0) != 0x80)
+      return 0;
+    codepoint = (codepoint << 6) | (in[i] & 0x3F);
+  }
+
+  // reject overlong sequences, surrogates and values beyond the Unicode range
+  if ((size == 3 && codepoint < 0x800) || (size == 4 && codepoint < 0x10000) ||
+      codepoint > UNICODE_MAX_CODEPOINT || IsSurrogate(codepoint))
+    return 0;
+
+  return size;
+}
+
+/*! \brief Decodes the UTF-16 or UTF-32 character at the start of the buffer
+ \return the number of code units of the character, 0 if it's invalid or -1 if it's cut off by the end of the buffer
+ */
+template<class CHAR>
+static inline int DecodeUnits(const CHAR* in, size_t length, bool swapBytes, bool allowSurrogates, uint32_t& codepoint)
+{
+  codepoint = GetUnit(in, swapBytes);
+  if (!IsSurrogate(codepoint))
+    return codepoint <= UNICODE_MAX_CODEPOINT ? 1 : 0;
+
+  // surrogates are only allowed as pairs in UTF-16
+  if (sizeof(CHAR) != 2 || !allowSurrogates || codepoint >= 0xDC00)
+    return 0;
+  if (length < 2)
+    return -1;
+
+  uint32_t low = GetUnit(in + 1, swapBytes);
+  if (low < 0xDC00 || low > 0xDFFF)
+    return 0;
+
+  codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+  return 2;
+}
+
+static inline char* EncodeUtf8(char* out, uint32_t codepoint)
+{
+  if (codepoint < 0x80)
+    *out++ = static_cast<char>(codepoint);
+  else if (codepoint < 0x800)
+  {
+    *out++ = static_cast<char>(0xC0 | (codepoint >> 6));
+    *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+  else if (codepoint < 0x10000)
+  {
+    *out++ = static_cast<char>(0xE0 | (codepoint >> 12));
+    *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+  else
+  {
+    *out++ = static_cast<char>(0xF0 | (codepoint >> 18));
+    *out++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+    *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+  return out;
+}
+
+template<class CHAR>
+static inline CHAR* EncodeUnits(CHAR* out, uint32_t codepoint)
+{
+  if (sizeof(CHAR) == 2 && codepoint >= 0x10000)
+  {
+    codepoint -= 0x10000;
+    *out++ = static_cast<CHAR>(0xD800 + (codepoint >> 10));
+    *out++ = static_cast<CHAR>(0xDC00 + (codepoint & 0x3FF));
+  }
+  else
+    *out++ = static_cast<CHAR>(codepoint);
+  return out;
+}
+
+/*! \brief Copies the ASCII characters at the start of an UTF-8 buffer into an UTF-16 or UTF-32 buffer
+ \return the number of copied characters
+ */
+template<class CHAR>
+static inline size_t WidenAscii(const unsigned char* in, size_t length, CHAR* out)
+{
+  size_t i = 0;
+#if defined(UNICODE_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= length; i += 16)
+  {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    if (_mm_movemask_epi8(bytes) != 0)
+      break;
+
+    __m128i low = _mm_unpacklo_epi8(bytes, zero);
+    __m128i high = _mm_unpackhi_epi8(bytes, zero);
+    __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+    if (sizeof(CHAR) == 2)
+    {
+      _mm_storeu_si128(dst, low);
+      _mm_storeu_si128(dst + 1, high);
+    }
+    else
+    {
+      _mm_storeu_si128(dst, _mm_unpacklo_epi16(low, zero));
+      _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(low, zero));
+      _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(high, zero));
+      _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(high, zero));
+    }
+  }
+#elif defined(UNICODE_NEON)
+  for (; i + 16 <= length; i += 16)
+  {
+    uint8x16_t bytes = vld1q_u8(in + i);
+    uint8x8_t folded = vorr_u8(vget_low_u8(bytes), vget_high_u8(bytes));
+    if (vget_lane_u64(vreinterpret_u64_u8(folded), 0) & 0x8080808080808080ULL)
+      break;
+
+    uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+    uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+    if (sizeof(CHAR) == 2)
+    {
+      uint16_t* dst = reinterpret_cast<uint16_t*>(out + i);
+      vst1q_u16(dst, low);
+      vst1q_u16(dst + 8, high);
+    }
+    else
+    {
+      uint32_t* dst = reinterpret_cast<uint32_t*>(out + i);
+      vst1q_u32(dst, vmovl_u16(vget_low_u16(low)));
+      vst1q_u32(dst + 4, vmovl_u16(vget_high_u16(low)));
+      vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(high)));
+      vst1q_u32(dst + 12, vmovl_u16(vget_high_u16(high)));
+    }
+  }
+#endif
+  for (; i < length && in[i] < 0x80; i++)
+    out[i] = static_cast<CHAR>(in[i]);
+  return i;
+}
+
+/*! \brief Copies the ASCII characters at the start of an UTF-16 or UTF-32 buffer (in host byte order) into an UTF-8 buffer
+ \return the number of copied characters
+ */
+template<class CHAR>
+static inline size_t NarrowAscii(const CHAR* in, size_t length, char* out)
+{
+  size_t i = 0;
+#if defined(UNICODE_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= length; i += 16)
+  {
+    const __m128i* src = reinterpret_cast<const __m128i*>(in + i);
+    __m128i packed;
+    if (sizeof(CHAR) == 2)
+    {
+      __m128i a = _mm_loadu_si128(src);
+      __m128i b = _mm_loadu_si128(src + 1);
+      __m128i nonAscii = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80)));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, zero)) != 0xFFFF)
+        break;
+      packed = _mm_packus_epi16(a, b);
+    }
+    else
+    {
+      __m128i a = _mm_loadu_si128(src);
+      __m128i b = _mm_loadu_si128(src + 1);
+      __m128i c = _mm_loadu_si128(src + 2);
+      __m128i d = _mm_loadu_si128(src + 3);
+      __m128i nonAscii = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), _mm_set1_epi32(static_cast<int>(0xFFFFFF80)));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(nonAscii, zero)) != 0xFFFF)
+        break;
+      packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+  }
+#elif defined(UNICODE_NEON)
+  for (; i + 16 <= length; i += 16)
+  {
+    uint16x8_t a, b;
+    uint64x2_t nonAscii;
+    if (sizeof(CHAR) == 2)
+    {
+      const uint16_t* src = reinterpret_cast<const uint16_t*>(in + i);
+      a = vld1q_u16(src);
+      b = vld1q_u16(src + 8);
+      nonAscii = vreinterpretq_u64_u16(vandq_u16(vorrq_u16(a, b), vdupq_n_u16(0xFF80)));
+    }
+    else
+    {
+      const uint32_t* src = reinterpret_cast<const uint32_t*>(in + i);
+      uint32x4_t a0 = vld1q_u32(src);
+      uint32x4_t a1 = vld1q_u32(src + 4);
+      uint32x4_t b0 = vld1q_u32(src + 8);
+      uint32x4_t b1 = vld1q_u32(src + 12);
+      nonAscii = vreinterpretq_u64_u32(vandq_u32(vorrq_u32(vorrq_u32(a0, a1), vorrq_u32(b0, b1)), vdupq_n_u32(0xFFFFFF80)));
+      a = vcombine_u16(vmovn_u32(a0), vmovn_u32(a1));
+      b = vcombine_u16(vmovn_u32(b0), vmovn_u32(b1));
+    }
+    if (vgetq_lane_u64(nonAscii, 0) | vgetq_lane_u64(nonAscii, 1))
+      break;
+    vst1q_u8(reinterpret_cast<uint8_t*>(out + i), vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+  }
+#endif
+  for (; i < length && static_cast<uint32_t>(in[i]) < 0x80; i++)
+    out[i] = static_cast<char>(in[i]);
+  return i;
+}
+
+template<class OUTPUT>
+bool CUnicodeTranscoder::FromUtf8(const std::string& utf8StringSrc, OUTPUT& stringDst, bool failOnInvalidChar /* = false */)
+{
+  typedef typename OUTPUT::value_type CHAR;
+
+  stringDst.clear();
+  if (utf8StringSrc.empty())
+    return true;
+
+  // every byte results in at most one code unit
+  stringDst.resize(utf8StringSrc.size());
+  CHAR* const outStart = &stringDst[0];
+  CHAR* out = outStart;
+  const unsigned char* in = reinterpret_cast<const unsigned char*>(utf8StringSrc.data());
+  const unsigned char* const end = in + utf8StringSrc.size();
+
+  while (in < end)
+  {
+    size_t ascii = WidenAscii(in, end - in, out);
+    in += ascii;
+    out += ascii;
+    if (in == end)
+      break;
+
+    uint32_t codepoint;
+    int size = DecodeUtf8(in, end - in, codepoint);
+    if (size > 0)
+    {
+      out = EncodeUnits(out, codepoint);
+      in += size;
+    }
+    else if (failOnInvalidChar)
+    {
+      stringDst.clear();
+      return false;
+    }
+    else if (size < 0)
+      break; // drop the incomplete character at the end
+    else
+      in++; // skip the invalid byte
+  }
+
+  stringDst.resize(out - outStart);
+  return true;
+}
+
+template<class INPUT>
+bool CUnicodeTranscoder::ToUtf8(const INPUT& stringSrc, std::string& utf8StringDst, bool swapBytes /* = false */, bool failOnInvalidChar /* = false */)
+{
+  return toUtf8(stringSrc, utf8StringDst, swapBytes, true, failOnInvalidChar);
+}
+
+bool CUnicodeTranscoder::Ucs2ToUtf8(const std::u16string& ucs2StringSrc, std::string& utf8StringDst, bool swapBytes /* = false */, bool failOnInvalidChar /* = false */)
+{
+  return toUtf8(ucs2StringSrc, utf8StringDst, swapBytes, false, failOnInvalidChar);
+}
+
+template<class INPUT>
+bool CUnicodeTranscoder::toUtf8(const INPUT& stringSrc, std::string& utf8StringDst, bool swapBytes, bool allowSurrogates, bool failOnInvalidChar)
+{
+  typedef typename INPUT::value_type CHAR;
+
+  utf8StringDst.clear();
+  if (stringSrc.empty())
+    return true;
+
+  // UTF-16 needs at most three bytes per code unit (four per surrogate pair), UTF-32 four
+  utf8StringDst.resize(stringSrc.size() * (sizeof(CHAR) == 2 ? 3 : 4));
+  char* const outStart = &utf8StringDst[0];
+  char* out = outStart;
+  const CHAR* in = stringSrc.data();
+  const CHAR* const end = in + stringSrc.size();
+
+  while (in < end)
+  {
+    if (!swapBytes)
+    {
+      size_t ascii = NarrowAscii(in, end - in, out);
+      in += ascii;
+      out += ascii;
+      if (in == end)
+        break;
+    }
+
+    uint32_t codepoint;
+    int size = DecodeUnits(in, end - in, swapBytes, allowSurrogates, codepoint);
+    if (size > 0)
+    {
+      out = EncodeUtf8(out, codepoint);
+      in += size;
+    }
+    else if (failOnInvalidChar)
+    {
+      utf8StringDst.clear();
+      return false;
+    }
+    else if (size < 0)
+      break; // drop the incomplete character at the end
+    else
+      in++; // skip the invalid code unit
+  }
+
+  utf8StringDst.resize(out - outStart);
+  return true;
+}
+
+template<class INPUT, class OUTPUT>
+bool CUnicodeTranscoder::Convert(const INPUT& stringSrc, OUTPUT& stringDst, bool swapBytes /* = false */, bool failOnInvalidChar /* = false */)
+{
+  typedef typename INPUT::value_type INCHAR;
+  typedef typename OUTPUT::value_type OUTCHAR;
+
+  stringDst.clear();
+  if (stringSrc.empty())
+    return true;
+
+  // only UTF-32 to UTF-16 may need two code units per source code unit
+  stringDst.resize(stringSrc.size() * (sizeof(INCHAR) == 4 && sizeof(OUTCHAR) == 2 ? 2 : 1));
+  OUTCHAR* const outStart = &stringDst[0];
+  OUTCHAR* out = outStart;
+  const INCHAR* in = stringSrc.data();
+  const INCHAR* const end = in + stringSrc.size();
+
+  while (in < end)
+  {
+    uint32_t codepoint;
+    int size = DecodeUnits(in, end - in, swapBytes, true, codepoint);
+    if (size > 0)
+    {
+      out = EncodeUnits(out, codepoint);
+      in += size;
+    }
+    else if (failOnInvalidChar)
+    {
+      stringDst.clear();
+      return false;
+    }
+    else if (size < 0)
+      break; // drop the incomplete character at the end
+    else
+      in++; // skip the invalid code unit
+  }
+
+  stringDst.resize(out - outStart);
+  return true;
+}
+
+template bool CUnicodeTranscoder::FromUtf8(const std::string&, std::u16string&, bool);
+template bool CUnicodeTranscoder::FromUtf8(const std::string&, std::u32string&, bool);
+template bool CUnicodeTranscoder::FromUtf8(const std::string&, std::wstring&, bool);
+
+template bool CUnicodeTranscoder::ToUtf8(const std::u16string&, std::string&, bool, bool);
+template bool CUnicodeTranscoder::ToUtf8(const std::u32string&, std::string&, bool, bool);
+template bool CUnicodeTranscoder::ToUtf8(const std::wstring&, std::string&, bool, bool);
+
+template bool CUnicodeTranscoder::Convert(const std::u16string&, std::u32string&, bool, bool);
+template bool CUnicodeTranscoder::Convert(const std::u32string&, std::u16string&, bool, bool);
+template bool CUnicodeTranscoder::Convert(const std::u16string&, std::wstring&, bool, bool);
+template bool CUnicodeTranscoder::Convert(const std::u32string&, std::wstring&, bool, bool);
+template bool CUnicodeTranscoder::Convert(const std::wstring&, std::u16string&, bool, bool);
+template bool CUnicodeTranscoder::Convert(const std::wstring&, std::u32string&, bool, bool);
+template bool CUnicodeTranscoder::Convert(const std::u16string&, std::u16string&, bool, bool);
+template bool CUnicodeTranscoder::Convert(const std::u32string&, std::u32string&, bool, bool);
+template bool CUnicodeTranscoder::Convert(const std::wstring&, std::wstring&, bool, bool);
@@ -0,0 +1,78 @@
+#pragma once
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+
+/*!
+ \brief Conversions between the Unicode encodings without going through iconv.
+
+ Whether a string holds UTF-16 or UTF-32 is determined by the size of its
+ characters so std::wstring is handled as UTF-32 or UTF-16 depending on the
+ platform. The conversions behave like iconv: invalid characters are skipped
+ unless failOnInvalidChar is set and an incomplete character at the end of
+ the source is dropped. On failure the destination is left empty.
+
+ Runs of ASCII characters are converted with SSE2 or NEON if available.
+ */
+class CUnicodeTranscoder
+{
+public:
+  /*!
+   \brief Converts an UTF-8 string to UTF-16 or UTF-32
+   \param utf8StringSrc the UTF-8 string to convert
+   \param stringDst the converted string (std::u16string, std::u32string or std::wstring)
+   \param failOnInvalidChar whether to fail on invalid characters instead of skipping them
+   \return true on success, false otherwise
+   */
+  template<class OUTPUT>
+  static bool FromUtf8(const std::string& utf8StringSrc, OUTPUT& stringDst, bool failOnInvalidChar = false);
+
+  /*!
+   \brief Converts an UTF-16 or UTF-32 string to UTF-8
+   \param stringSrc the string to convert (std::u16string, std::u32string or std::wstring)
+   \param utf8StringDst the converted UTF-8 string
+   \param swapBytes whether the source is stored in the opposite byte order of the host
+   \param failOnInvalidChar whether to fail on invalid characters instead of skipping them
+   \return true on success, false otherwise
+   */
+  template<class INPUT>
+  static bool ToUtf8(const INPUT& stringSrc, std::string& utf8StringDst, bool swapBytes = false, bool failOnInvalidChar = false);
+
+  /*!
+   \brief Converts between UTF-16 and UTF-32 (or validates a string of the same encoding)
+   \param stringSrc the string to convert
+   \param stringDst the converted string
+   \param swapBytes whether the source is stored in the opposite byte order of the host
+   \param failOnInvalidChar whether to fail on invalid characters instead of skipping them
+   \return true on success, false otherwise
+   */
+  template<class INPUT, class OUTPUT>
+  static bool Convert(const INPUT& stringSrc, OUTPUT& stringDst, bool swapBytes = false, bool failOnInvalidChar = false);
+
+  /*!
+   \brief Converts an UCS-2 string (UTF-16 without surrogate pairs) to UTF-8
+   */
+  static bool Ucs2ToUtf8(const std::u16string& ucs2StringSrc, std::string& utf8StringDst, bool swapBytes = false, bool failOnInvalidChar = false);
+
+private:
+  template<class INPUT>
+  static bool toUtf8(const INPUT& stringSrc, std::string& utf8StringDst, bool swapBytes, bool allowSurrogates, bool failOnInvalidChar);
+};
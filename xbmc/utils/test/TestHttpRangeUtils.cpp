@@ -491,6 +491,7 @@ TEST(TestHttpRanges, ParseInvalid)
 
   // too big start position
   EXPECT_FALSE(ranges.Parse(RANGES_START "10-11", 5));
+  EXPECT_FALSE(ranges.Parse(RANGES_START "10-11,-0", 5));
 
   // end position smaller than start position
   EXPECT_FALSE(ranges.Parse(RANGES_START "1-0"));
@@ -536,6 +537,20 @@ TEST(TestHttpRanges, ParseFromEnd)
   EXPECT_EQ(1, ranges_3.Size());
   EXPECT_TRUE(ranges_3.Get(0, range));
   EXPECT_EQ(range_3, range);
+
+  // a suffix covering (or exceeding) the whole entity selects all of it
+  const CHttpRange range_all(0, totalLength - 1);
+  CHttpRanges ranges_all;
+  EXPECT_TRUE(ranges_all.Parse(RANGES_START "-5", totalLength));
+  EXPECT_TRUE(ranges_all.Get(0, range));
+  EXPECT_EQ(range_all, range);
+
+  EXPECT_TRUE(ranges_all.Parse(RANGES_START "-10", totalLength));
+  EXPECT_TRUE(ranges_all.Get(0, range));
+  EXPECT_EQ(range_all, range);
+
+  // an empty suffix can't be satisfied
+  EXPECT_FALSE(ranges_all.Parse(RANGES_START "-0", totalLength));
 }
 
 TEST(TestHttpRanges, ParseSingle)
@@ -630,6 +645,14 @@ TEST(TestHttpRanges, ParseMulti)
   EXPECT_EQ(range1_3, range);
   EXPECT_TRUE(ranges.Get(1, range));
   EXPECT_EQ(range5_5, range);
+
+  // unsatisfiable ranges are skipped
+  EXPECT_TRUE(ranges.Parse(RANGES_START "0-1,10-11,5-5,-0", totalLength));
+  EXPECT_EQ(2, ranges.Size());
+  EXPECT_TRUE(ranges.Get(0, range));
+  EXPECT_EQ(range0_1, range);
+  EXPECT_TRUE(ranges.Get(1, range));
+  EXPECT_EQ(range5_5, range);
 }
 
 TEST(TestHttpRanges, ParseOrderedNotOverlapping)
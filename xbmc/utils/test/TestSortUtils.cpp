@@ -131,3 +131,38 @@ TEST(TestSortUtils, GetFieldsForSorting)
   EXPECT_EQ(FieldTrackNumber, *it);
   EXPECT_EQ((unsigned int)4, fields.size());
 }
+
+TEST(TestSortUtils, GetOrderClause)
+{
+  SortDescription sorting;
+  std::string order;
+
+  sorting.sortBy = SortByTitle;
+  EXPECT_TRUE(SortUtils::GetOrderClause(sorting, MediaTypeMovie, order));
+  EXPECT_STREQ("lower(movie_view.c00) ASC, movie_view.idMovie ASC", order.c_str());
+
+  sorting.sortBy = SortBySortTitle;
+  EXPECT_TRUE(SortUtils::GetOrderClause(sorting, MediaTypeTvShow, order));
+  EXPECT_STREQ("lower(CASE WHEN length(tvshow_view.c15) > 0 THEN tvshow_view.c15 ELSE tvshow_view.c00 END) ASC, "
+               "tvshow_view.idShow ASC", order.c_str());
+
+  // items with the same value are sorted by their label
+  sorting.sortBy = SortByYear;
+  sorting.sortOrder = SortOrderDescending;
+  EXPECT_TRUE(SortUtils::GetOrderClause(sorting, MediaTypeAlbum, order));
+  EXPECT_STREQ("albumview.iYear+0 DESC, lower(albumview.strAlbum) DESC, albumview.idAlbum DESC", order.c_str());
+
+  sorting.sortBy = SortByDateAdded;
+  EXPECT_TRUE(SortUtils::GetOrderClause(sorting, MediaTypeArtist, order));
+  EXPECT_STREQ("artistview.dateAdded DESC, artistview.idArtist DESC", order.c_str());
+
+  // sort methods combining several fields are left to Sort()
+  sorting.sortBy = SortByEpisodeNumber;
+  EXPECT_FALSE(SortUtils::GetOrderClause(sorting, MediaTypeEpisode, order));
+  sorting.sortBy = SortByLabel;
+  EXPECT_FALSE(SortUtils::GetOrderClause(sorting, MediaTypeSong, order));
+
+  // as are fields the media type doesn't have
+  sorting.sortBy = SortByRating;
+  EXPECT_FALSE(SortUtils::GetOrderClause(sorting, MediaTypeArtist, order));
+}
@@ -0,0 +1,217 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iconv.h>
+#include <string.h>
+
+#include "utils/log.h"
+#include "utils/TimeUtils.h"
+#include "utils/UnicodeTranscoder.h"
+
+#include "gtest/gtest.h"
+
+#define BENCHMARK_ITERATIONS  20000
+
+// "Kodi ❤ 日本語 🐭" followed by enough ASCII to cross several SIMD blocks
+static const char refUtf8Mixed[] = "Kodi \xe2\x9d\xa4 \xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e \xf0\x9f\x90\xad"
+                                   " - The quick brown fox jumps over the lazy dog";
+static const char32_t refUtf32Mixed[] = U"Kodi ❤ 日本語 \U0001f42d"
+                                        U" - The quick brown fox jumps over the lazy dog";
+static const char16_t refUtf16Mixed[] = u"Kodi ❤ 日本語 \U0001f42d"
+                                        u" - The quick brown fox jumps over the lazy dog";
+
+static const char refAscii[] = "The quick brown fox jumps over the lazy dog 0123456789";
+
+/* iconv may declare inbuf to be char** rather than const char** */
+struct charPtrPtrAdapter
+{
+  const char** pointer;
+  charPtrPtrAdapter(const char** p) :
+    pointer(p) { }
+  operator char**()
+  { return const_cast<char**>(pointer); }
+  operator const char**()
+  { return pointer; }
+};
+
+static std::u16string SwapBytes(const std::u16string& str)
+{
+  std::u16string swapped(str);
+  for (size_t i = 0; i < swapped.size(); i++)
+    swapped[i] = static_cast<char16_t>((swapped[i] >> 8) | (swapped[i] << 8));
+  return swapped;
+}
+
+TEST(TestUnicodeTranscoder, Ascii)
+{
+  std::string ascii(refAscii);
+  std::u16string utf16;
+  std::u32string utf32;
+  EXPECT_TRUE(CUnicodeTranscoder::FromUtf8(ascii, utf16));
+  EXPECT_TRUE(CUnicodeTranscoder::FromUtf8(ascii, utf32));
+  ASSERT_EQ(ascii.size(), utf16.size());
+  ASSERT_EQ(ascii.size(), utf32.size());
+  for (size_t i = 0; i < ascii.size(); i++)
+  {
+    EXPECT_EQ(static_cast<char16_t>(ascii[i]), utf16[i]);
+    EXPECT_EQ(static_cast<char32_t>(ascii[i]), utf32[i]);
+  }
+
+  std::string utf8;
+  EXPECT_TRUE(CUnicodeTranscoder::ToUtf8(utf16, utf8));
+  EXPECT_EQ(ascii, utf8);
+  EXPECT_TRUE(CUnicodeTranscoder::ToUtf8(utf32, utf8));
+  EXPECT_EQ(ascii, utf8);
+}
+
+TEST(TestUnicodeTranscoder, Mixed)
+{
+  std::u16string utf16;
+  std::u32string utf32;
+  EXPECT_TRUE(CUnicodeTranscoder::FromUtf8(refUtf8Mixed, utf16, true));
+  EXPECT_TRUE(std::u16string(refUtf16Mixed) == utf16);
+  EXPECT_TRUE(CUnicodeTranscoder::FromUtf8(refUtf8Mixed, utf32, true));
+  EXPECT_TRUE(std::u32string(refUtf32Mixed) == utf32);
+
+  std::string utf8;
+  EXPECT_TRUE(CUnicodeTranscoder::ToUtf8(utf16, utf8, false, true));
+  EXPECT_STREQ(refUtf8Mixed, utf8.c_str());
+  EXPECT_TRUE(CUnicodeTranscoder::ToUtf8(utf32, utf8, false, true));
+  EXPECT_STREQ(refUtf8Mixed, utf8.c_str());
+
+  std::u16string convertedUtf16;
+  std::u32string convertedUtf32;
+  EXPECT_TRUE(CUnicodeTranscoder::Convert(utf16, convertedUtf32, false, true));
+  EXPECT_TRUE(utf32 == convertedUtf32);
+  EXPECT_TRUE(CUnicodeTranscoder::Convert(utf32, convertedUtf16, false, true));
+  EXPECT_TRUE(utf16 == convertedUtf16);
+}
+
+TEST(TestUnicodeTranscoder, SwappedBytes)
+{
+  std::u16string swapped = SwapBytes(refUtf16Mixed);
+  std::string utf8;
+  EXPECT_TRUE(CUnicodeTranscoder::ToUtf8(swapped, utf8, true, true));
+  EXPECT_STREQ(refUtf8Mixed, utf8.c_str());
+
+  std::u32string utf32;
+  EXPECT_TRUE(CUnicodeTranscoder::Convert(swapped, utf32, true, true));
+  EXPECT_TRUE(std::u32string(refUtf32Mixed) == utf32);
+}
+
+TEST(TestUnicodeTranscoder, InvalidUtf8)
+{
+  // overlong encoding, lone continuation byte, encoded surrogate and truncated character
+  const std::string invalid[] = { "ab\xc0\xafgh", "ab\x80gh", "ab\xed\xa0\x80gh", "abcdefgh\xe6\x97" };
+  const std::u32string skipped[] = { U"abgh", U"abgh", U"abgh", U"abcdefgh" };
+
+  for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+  {
+    std::u32string utf32;
+    EXPECT_FALSE(CUnicodeTranscoder::FromUtf8(invalid[i], utf32, true)) << i;
+    EXPECT_TRUE(utf32.empty()) << i;
+    EXPECT_TRUE(CUnicodeTranscoder::FromUtf8(invalid[i], utf32, false)) << i;
+    EXPECT_TRUE(skipped[i] == utf32) << i;
+  }
+}
+
+TEST(TestUnicodeTranscoder, InvalidUtf16)
+{
+  // lone low surrogate and high surrogate at the end of the string
+  const std::u16string invalid[] = { u"ab\xdc00gh", u"abcdefgh\xd83d" };
+  const std::string skipped[] = { "abgh", "abcdefgh" };
+
+  for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+  {
+    std::string utf8;
+    EXPECT_FALSE(CUnicodeTranscoder::ToUtf8(invalid[i], utf8, false, true)) << i;
+    EXPECT_TRUE(utf8.empty()) << i;
+    EXPECT_TRUE(CUnicodeTranscoder::ToUtf8(invalid[i], utf8, false, false)) << i;
+    EXPECT_EQ(skipped[i], utf8) << i;
+  }
+
+  // surrogate pairs aren't valid UCS-2
+  std::string utf8;
+  EXPECT_FALSE(CUnicodeTranscoder::Ucs2ToUtf8(refUtf16Mixed, utf8, false, true));
+  EXPECT_TRUE(CUnicodeTranscoder::Ucs2ToUtf8(u"abcé", utf8, false, true));
+  EXPECT_STREQ("abc\xc3\xa9", utf8.c_str());
+}
+
+TEST(TestUnicodeTranscoder, InvalidUtf32)
+{
+  std::u32string invalid(U"abcd");
+  invalid[1] = 0x110000;
+  invalid[2] = 0xd800;
+
+  std::string utf8;
+  EXPECT_FALSE(CUnicodeTranscoder::ToUtf8(invalid, utf8, false, true));
+  EXPECT_TRUE(CUnicodeTranscoder::ToUtf8(invalid, utf8, false, false));
+  EXPECT_EQ("ad", utf8);
+}
+
+TEST(TestUnicodeTranscoder, Benchmark)
+{
+  const std::string sources[] = { refAscii, refUtf8Mixed };
+  for (size_t i = 0; i < sizeof(sources) / sizeof(sources[0]); i++)
+  {
+    std::string utf8;
+    for (int repeat = 0; repeat < 8; repeat++)
+      utf8 += sources[i];
+
+    iconv_t toUtf32 = iconv_open("UTF-32LE", "UTF-8");
+    iconv_t toUtf8 = iconv_open("UTF-8", "UTF-32LE");
+    ASSERT_TRUE(toUtf32 != (iconv_t)-1 && toUtf8 != (iconv_t)-1);
+
+    std::u32string utf32(utf8.size(), 0);
+    std::string roundtrip(utf8.size(), 0);
+    int64_t start = CurrentHostCounter();
+    for (unsigned int iteration = 0; iteration < BENCHMARK_ITERATIONS; iteration++)
+    {
+      const char* in = utf8.c_str();
+      size_t inSize = utf8.size();
+      char* out = reinterpret_cast<char*>(&utf32[0]);
+      size_t outSize = utf32.size() * sizeof(char32_t);
+      iconv(toUtf32, charPtrPtrAdapter(&in), &inSize, &out, &outSize);
+
+      size_t converted = utf32.size() * sizeof(char32_t) - outSize;
+      in = reinterpret_cast<const char*>(utf32.c_str());
+      out = &roundtrip[0];
+      outSize = roundtrip.size();
+      iconv(toUtf8, charPtrPtrAdapter(&in), &converted, &out, &outSize);
+    }
+    int64_t iconvTime = CurrentHostCounter() - start;
+    iconv_close(toUtf32);
+    iconv_close(toUtf8);
+
+    start = CurrentHostCounter();
+    for (unsigned int iteration = 0; iteration < BENCHMARK_ITERATIONS; iteration++)
+    {
+      CUnicodeTranscoder::FromUtf8(utf8, utf32);
+      CUnicodeTranscoder::ToUtf8(utf32, roundtrip);
+    }
+    int64_t nativeTime = CurrentHostCounter() - start;
+    EXPECT_EQ(utf8, roundtrip);
+
+    CLog::Log(LOGNOTICE, "TestUnicodeTranscoder: %u bytes of %s, iconv %.2f us, native %.2f us per round trip",
+              static_cast<unsigned int>(utf8.size()), i == 0 ? "ASCII" : "mixed text",
+              1000000.0 * iconvTime / CurrentHostFrequency() / BENCHMARK_ITERATIONS,
+              1000000.0 * nativeTime / CurrentHostFrequency() / BENCHMARK_ITERATIONS);
+  }
+}
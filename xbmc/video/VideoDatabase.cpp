@@ -204,6 +204,8 @@ void CVideoDatabase::CreateTables()
 
   CLog::Log(LOGINFO, "create rating table");
   m_pDS->exec("CREATE TABLE rating (rating_id INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, rating_type TEXT, rating FLOAT, votes INTEGER)");
+
+  CreateChangelogTable();
 }
 
 void CVideoDatabase::CreateLinkIndex(const char *table)
@@ -290,6 +292,7 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM art WHERE media_id=old.idMovie AND media_type='movie'; "
               "DELETE FROM tag_link WHERE media_id=old.idMovie AND media_type='movie'; "
               "DELETE FROM rating WHERE media_id=old.idMovie AND media_type='movie'; "
+              "INSERT INTO changelog (media_id, media_type, changeType) VALUES (old.idMovie, 'movie', 'removed'); "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_tvshow AFTER DELETE ON tvshow FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idShow AND media_type='tvshow'; "
@@ -302,6 +305,7 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM art WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM tag_link WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM rating WHERE media_id=old.idShow AND media_type='tvshow'; "
+              "INSERT INTO changelog (media_id, media_type, changeType) VALUES (old.idShow, 'tvshow', 'removed'); "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_musicvideo AFTER DELETE ON musicvideo FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
@@ -310,6 +314,7 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM studio_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM art WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM tag_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
+              "INSERT INTO changelog (media_id, media_type, changeType) VALUES (old.idMVideo, 'musicvideo', 'removed'); "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_episode AFTER DELETE ON episode FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idEpisode AND media_type='episode'; "
@@ -317,6 +322,7 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM writer_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM art WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM rating WHERE media_id=old.idEpisode AND media_type='episode'; "
+              "INSERT INTO changelog (media_id, media_type, changeType) VALUES (old.idEpisode, 'episode', 'removed'); "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_season AFTER DELETE ON seasons FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idSeason AND media_type='season'; "
@@ -337,6 +343,30 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
               "END");
 
+  // changes of the items themselves, their artwork, ratings and
+  // playcounts are logged to determine the library revision
+  CreateChangelogTriggers("movie", "idMovie", MediaTypeMovie);
+  CreateChangelogTriggers("tvshow", "idShow", MediaTypeTvShow);
+  CreateChangelogTriggers("musicvideo", "idMVideo", MediaTypeMusicVideo);
+  CreateChangelogTriggers("episode", "idEpisode", MediaTypeEpisode);
+  m_pDS->exec("CREATE TRIGGER changelog_art_insert AFTER INSERT ON art FOR EACH ROW BEGIN "
+              "INSERT INTO changelog (media_id, media_type, changeType) VALUES (new.media_id, new.media_type, 'changed'); "
+              "END");
+  m_pDS->exec("CREATE TRIGGER changelog_art_update AFTER UPDATE ON art FOR EACH ROW BEGIN "
+              "INSERT INTO changelog (media_id, media_type, changeType) VALUES (new.media_id, new.media_type, 'changed'); "
+              "END");
+  m_pDS->exec("CREATE TRIGGER changelog_rating_insert AFTER INSERT ON rating FOR EACH ROW BEGIN "
+              "INSERT INTO changelog (media_id, media_type, changeType) VALUES (new.media_id, new.media_type, 'changed'); "
+              "END");
+  m_pDS->exec("CREATE TRIGGER changelog_rating_update AFTER UPDATE ON rating FOR EACH ROW BEGIN "
+              "INSERT INTO changelog (media_id, media_type, changeType) VALUES (new.media_id, new.media_type, 'changed'); "
+              "END");
+  m_pDS->exec("CREATE TRIGGER changelog_files_update AFTER UPDATE ON files FOR EACH ROW BEGIN "
+              "INSERT INTO changelog (media_id, media_type, changeType) SELECT idMovie, 'movie', 'changed' FROM movie WHERE idFile=new.idFile; "
+              "INSERT INTO changelog (media_id, media_type, changeType) SELECT idEpisode, 'episode', 'changed' FROM episode WHERE idFile=new.idFile; "
+              "INSERT INTO changelog (media_id, media_type, changeType) SELECT idMVideo, 'musicvideo', 'changed' FROM musicvideo WHERE idFile=new.idFile; "
+              "END");
+
   CreateViews();
 }
 
@@ -4874,11 +4904,14 @@ void CVideoDatabase::UpdateTables(int iVersion)
     m_pDS->exec("ALTER TABLE settings ADD VideoStream integer");
     m_pDS->exec("ALTER TABLE streamdetails ADD strVideoLanguage text");
   }
+
+  if (iVersion < 104)
+    CreateChangelogTable();
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 103;
+  return 104;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -8266,6 +8299,9 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
     sql = "DELETE FROM sets WHERE NOT EXISTS (SELECT 1 FROM movie WHERE movie.idSet = sets.idSet)";
     m_pDS->exec(sql);
 
+    CLog::Log(LOGDEBUG, "%s: Cleaning changelog table", __FUNCTION__);
+    CleanChangelog();
+
     CommitTransaction();
 
     if (handle)
@@ -165,6 +165,7 @@ namespace VIDEO
         {
           if (m_handle)
             m_handle->SetTitle(g_localizeStrings.Get(331));
+          m_database.CleanChangelog();
           m_database.Compress(false);
         }
       }
@@ -1172,7 +1173,7 @@ namespace VIDEO
       GetArtwork(pItem, content, videoFolder, useLocal, showInfo ? showInfo->m_strPath : "");
 
     // ensure the art map isn't completely empty by specifying an empty thumb
-    std::map<std::string, std::string> art = pItem->GetArt();
+    std::map<std::string, std::string> art = pItem->GetArt().ToMap();
     if (art.empty())
       art["thumb"] = "";
 
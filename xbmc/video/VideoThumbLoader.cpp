@@ -23,7 +23,7 @@
 #include <cstdlib>
 #include <utility>
 
-#include "cores/VideoPlayer/DVDFileInfo.h"
+#include "cores/VideoPlayer/DVDMediaProbe.h"
 #include "FileItem.h"
 #include "filesystem/DirectoryCache.h"
 #include "filesystem/StackDirectory.h"
@@ -35,6 +35,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/VideoSettings.h"
+#include "threads/SingleLock.h"
 #include "TextureCache.h"
 #include "URL.h"
 #include "utils/log.h"
@@ -111,7 +112,7 @@ bool CThumbExtractor::DoWork()
     // construct the thumb cache file
     CTextureDetails details;
     details.file = CTextureCache::GetCacheFile(m_target) + ".jpg";
-    result = CDVDFileInfo::ExtractThumb(m_item.GetPath(), details, m_fillStreamDetails ? &m_item.GetVideoInfoTag()->m_streamDetails : NULL, (int) m_pos);
+    result = CDVDMediaProbe::GetInstance().ExtractThumb(m_item.GetPath(), details, m_fillStreamDetails ? &m_item.GetVideoInfoTag()->m_streamDetails : NULL, (int) m_pos);
     if(result)
     {
       CTextureCache::GetInstance().AddCachedTexture(m_target, details);
@@ -135,7 +136,7 @@ bool CThumbExtractor::DoWork()
   {
     // No tag or no details set, so extract them
     CLog::Log(LOGDEBUG,"%s - trying to extract filestream details from video file %s", __FUNCTION__, CURL::GetRedacted(m_item.GetPath()).c_str());
-    result = CDVDFileInfo::GetFileStreamDetails(&m_item);
+    result = CDVDMediaProbe::GetInstance().GetFileStreamDetails(&m_item);
   }
 
   if (result)
@@ -166,7 +167,7 @@ bool CThumbExtractor::DoWork()
         info->m_duration = info->GetDuration();
 
         // store the updated information in the database
-        db.SetDetailsForItem(info->m_iDbId, info->m_type, *info, m_item.GetArt());
+        db.SetDetailsForItem(info->m_iDbId, info->m_type, *info, m_item.GetArt().ToMap());
       }
 
       db.Close();
@@ -178,7 +179,8 @@ bool CThumbExtractor::DoWork()
 }
 
 CVideoThumbLoader::CVideoThumbLoader() :
-  CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
+  CThumbLoader(), CJobQueue(true, CDVDMediaProbe::GetInstance().GetMaxWorkers(), CJob::PRIORITY_LOW_PAUSABLE),
+  m_probeUser(false)
 {
   m_videoDatabase = new CVideoDatabase();
 }
@@ -186,6 +188,7 @@ CVideoThumbLoader::CVideoThumbLoader() :
 CVideoThumbLoader::~CVideoThumbLoader()
 {
   StopThread();
+  ReleaseMediaProbe(true);
   delete m_videoDatabase;
 }
 
@@ -312,7 +315,7 @@ bool CVideoThumbLoader::LoadItemCached(CFileItem* pItem)
   }
 
   // if we have no art, look for it all
-  std::map<std::string, std::string> artwork = pItem->GetArt();
+  std::map<std::string, std::string> artwork = pItem->GetArt().ToMap();
   if (artwork.empty())
   {
     std::vector<std::string> artTypes = GetArtTypes(pItem->HasVideoInfoTag() ? pItem->GetVideoInfoTag()->m_type : "");
@@ -350,7 +353,7 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
 
   m_videoDatabase->Open();
 
-  std::map<std::string, std::string> artwork = pItem->GetArt();
+  std::map<std::string, std::string> artwork = pItem->GetArt().ToMap();
   std::vector<std::string> artTypes = GetArtTypes(pItem->HasVideoInfoTag() ? pItem->GetVideoInfoTag()->m_type : "");
   if (find(artTypes.begin(), artTypes.end(), "thumb") == artTypes.end())
     artTypes.push_back("thumb"); // always look for "thumb" art for files
@@ -406,7 +409,7 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
           SetupRarOptions(item,path);
 
         CThumbExtractor* extract = new CThumbExtractor(item, path, true, thumbURL);
-        AddJob(extract);
+        AddExtractJob(extract);
 
         m_videoDatabase->Close();
         return true;
@@ -423,7 +426,7 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
       if (URIUtils::IsInRAR(item.GetPath()))
         SetupRarOptions(item,path);
       CThumbExtractor* extract = new CThumbExtractor(item,path,false);
-      AddJob(extract);
+      AddExtractJob(extract);
     }
   }
 
@@ -433,7 +436,7 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
 
 void CVideoThumbLoader::SetArt(CFileItem &item, const std::map<std::string, std::string> &artwork)
 {
-  item.SetArt(artwork);
+  item.SetArt(CGUIListItem::ArtMap(artwork));
   if (artwork.find("thumb") == artwork.end())
   { // set fallback for "thumb"
     if (artwork.find("poster") != artwork.end())
@@ -458,7 +461,7 @@ bool CVideoThumbLoader::FillLibraryArt(CFileItem &item)
       database.Open();
       int idArtist = database.GetArtistByName(item.GetLabel());
       if (database.GetArtForItem(idArtist, MediaTypeArtist, artwork))
-        item.SetArt(artwork);
+        item.SetArt(CGUIListItem::ArtMap(artwork));
     }
     else if (tag.m_type == MediaTypeAlbum)
     { // we retrieve music video art from the music database (no backward compat)
@@ -466,7 +469,7 @@ bool CVideoThumbLoader::FillLibraryArt(CFileItem &item)
       database.Open();
       int idAlbum = database.GetAlbumByName(item.GetLabel(), tag.m_artist);
       if (database.GetArtForItem(idAlbum, MediaTypeAlbum, artwork))
-        item.SetArt(artwork);
+        item.SetArt(CGUIListItem::ArtMap(artwork));
     }
 
     if (tag.m_type == MediaTypeEpisode || tag.m_type == MediaTypeSeason)
@@ -483,7 +486,7 @@ bool CVideoThumbLoader::FillLibraryArt(CFileItem &item)
         }
         if (i != m_showArt.end())
         {
-          item.AppendArt(i->second, "tvshow");
+          item.AppendArt(CGUIListItem::ArtMap(i->second), "tvshow");
           item.SetArtFallback("fanart", "tvshow.fanart");
           item.SetArtFallback("tvshow.thumb", "tvshow.poster");
         }
@@ -500,7 +503,7 @@ bool CVideoThumbLoader::FillLibraryArt(CFileItem &item)
         }
 
         if (i != m_seasonArt.end())
-          item.AppendArt(i->second, MediaTypeSeason);
+          item.AppendArt(CGUIListItem::ArtMap(i->second), MediaTypeSeason);
       }
     }
     m_videoDatabase->Close();
@@ -586,6 +589,30 @@ void CVideoThumbLoader::OnJobComplete(unsigned int jobID, bool success, CJob* jo
     g_windowManager.SendThreadMessage(msg);
   }
   CJobQueue::OnJobComplete(jobID, success, job);
+
+  ReleaseMediaProbe(false);
+}
+
+void CVideoThumbLoader::AddExtractJob(CThumbExtractor *extract)
+{
+  CSingleLock lock(m_probeSection);
+  if (!m_probeUser)
+  {
+    CDVDMediaProbe::GetInstance().AddUser();
+    m_probeUser = true;
+  }
+  AddJob(extract);
+}
+
+void CVideoThumbLoader::ReleaseMediaProbe(bool force)
+{
+  // the decoders are freed once no loader has anything left to extract
+  CSingleLock lock(m_probeSection);
+  if (m_probeUser && (force || !IsProcessing()))
+  {
+    CDVDMediaProbe::GetInstance().RemoveUser();
+    m_probeUser = false;
+  }
 }
 
 void CVideoThumbLoader::DetectAndAddMissingItemData(CFileItem &item)
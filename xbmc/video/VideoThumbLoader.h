@@ -21,6 +21,7 @@
 
 #include <map>
 #include "ThumbLoader.h"
+#include "threads/CriticalSection.h"
 #include "utils/JobManager.h"
 #include "FileItem.h"
 
@@ -136,4 +137,18 @@ protected:
    \return void
    */
   void DetectAndAddMissingItemData(CFileItem &item);
+
+  /*! \brief Queue an extraction, keeping the decoders of the media probe
+   around until all extractions of this loader are done.
+   \param extract the extraction job.
+   */
+  void AddExtractJob(CThumbExtractor *extract);
+
+  /*! \brief Stop using the media probe once nothing is left to extract.
+   \param force stop using it even if extractions are pending.
+   */
+  void ReleaseMediaProbe(bool force);
+
+  CCriticalSection m_probeSection;
+  bool m_probeUser;
 };
@@ -0,0 +1,143 @@
+/*
+ *      Copyright (C) 2016 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Kodi; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string>
+
+#include "FileItem.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "media/MediaType.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/SortUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/Variant.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoInfoTag.h"
+
+#include "gtest/gtest.h"
+
+// the video database with its real schema, created in special://temp
+class CTestVideoDatabase : public CVideoDatabase
+{
+public:
+  virtual bool Open()
+  {
+    DatabaseSettings settings;
+    settings.type = "sqlite3";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    settings.name = "TestVideoDatabase";
+    return Update(settings);
+  }
+
+  void Delete()
+  {
+    std::string file = URIUtils::AddFileToFolder(m_pDB->getHostName(), m_pDB->getDatabase());
+    Close();
+    XFILE::CFile::Delete(file);
+  }
+};
+
+class TestVideoDatabase : public testing::Test
+{
+protected:
+  TestVideoDatabase()
+  {
+    m_database.Open();
+  }
+
+  ~TestVideoDatabase()
+  {
+    m_database.Delete();
+  }
+
+  void AddMovie(const std::string &file, const std::string &title)
+  {
+    int idMovie = m_database.AddMovie(URIUtils::AddFileToFolder("/movies/", file));
+    m_database.UpdateMovieTitle(idMovie, title);
+  }
+
+  // lists a page of the movies sorted and limited by the query, like UPnP does
+  bool GetMoviesPage(const SortDescription &sorting, int start, int end, CFileItemList &items)
+  {
+    CDatabase::Filter filter;
+    if (!SortUtils::GetOrderClause(sorting, MediaTypeMovie, filter.order))
+      return false;
+
+    SortDescription limits;
+    limits.limitStart = start;
+    limits.limitEnd = end;
+
+    items.Clear();
+    return m_database.GetMoviesByWhere("videodb://movies/titles/", filter, items, limits);
+  }
+
+  static std::string GetTitle(const CFileItemList &items, int index)
+  {
+    return items.Get(index)->GetVideoInfoTag()->m_strTitle;
+  }
+
+  CTestVideoDatabase m_database;
+};
+
+TEST_F(TestVideoDatabase, GetMoviesByWherePaged)
+{
+  ASSERT_TRUE(m_database.IsOpen());
+
+  AddMovie("d.mkv", "Delta");
+  AddMovie("a.mkv", "alpha");
+  AddMovie("c.mkv", "Charlie");
+  AddMovie("e.mkv", "echo");
+  AddMovie("b.mkv", "Bravo");
+
+  SortDescription sorting;
+  sorting.sortBy = SortByTitle;
+  sorting.sortOrder = SortOrderAscending;
+
+  CFileItemList items;
+  ASSERT_TRUE(GetMoviesPage(sorting, 0, 2, items));
+  EXPECT_EQ(5, items.GetProperty("total").asInteger());
+  ASSERT_EQ(2, items.Size());
+  EXPECT_EQ("alpha", GetTitle(items, 0));
+  EXPECT_EQ("Bravo", GetTitle(items, 1));
+
+  ASSERT_TRUE(GetMoviesPage(sorting, 2, 4, items));
+  EXPECT_EQ(5, items.GetProperty("total").asInteger());
+  ASSERT_EQ(2, items.Size());
+  EXPECT_EQ("Charlie", GetTitle(items, 0));
+  EXPECT_EQ("Delta", GetTitle(items, 1));
+
+  // the last page only has the remaining movies
+  ASSERT_TRUE(GetMoviesPage(sorting, 4, 6, items));
+  EXPECT_EQ(5, items.GetProperty("total").asInteger());
+  ASSERT_EQ(1, items.Size());
+  EXPECT_EQ("echo", GetTitle(items, 0));
+
+  sorting.sortOrder = SortOrderDescending;
+  ASSERT_TRUE(GetMoviesPage(sorting, 1, 3, items));
+  EXPECT_EQ(5, items.GetProperty("total").asInteger());
+  ASSERT_EQ(2, items.Size());
+  EXPECT_EQ("Delta", GetTitle(items, 0));
+  EXPECT_EQ("Charlie", GetTitle(items, 1));
+
+  // sort methods the database can't do aren't paged
+  sorting.sortBy = SortByGenre;
+  EXPECT_FALSE(GetMoviesPage(sorting, 0, 2, items));
+}
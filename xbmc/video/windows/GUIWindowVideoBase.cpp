@@ -1497,7 +1497,7 @@ void CGUIWindowVideoBase::AddToDatabase(int iItem)
   m_database.Open();
   int idMovie = m_database.AddMovie(pItem->GetPath());
   movie.m_strIMDBNumber = StringUtils::Format("xx%08i", idMovie);
-  m_database.SetDetailsForMovie(pItem->GetPath(), movie, pItem->GetArt());
+  m_database.SetDetailsForMovie(pItem->GetPath(), movie, pItem->GetArt().ToMap());
   m_database.Close();
 
   // done...
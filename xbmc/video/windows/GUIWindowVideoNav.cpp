@@ -371,7 +371,7 @@ bool CGUIWindowVideoNav::GetDirectory(const std::string &strDirectory, CFileItem
         std::map<std::string, std::string> art;
         if (m_database.GetArtForItem(details.m_iDbId, details.m_type, art))
         {
-          items.AppendArt(art, details.m_type);
+          items.AppendArt(CGUIListItem::ArtMap(art), details.m_type);
           items.SetArtFallback("fanart", "tvshow.fanart");
           if (node == NODE_TYPE_SEASONS)
           { // set an art fallback for "thumb"
@@ -407,10 +407,10 @@ bool CGUIWindowVideoNav::GetDirectory(const std::string &strDirectory, CFileItem
           else
             seasonID = items[firstIndex]->GetVideoInfoTag()->m_iIdSeason;
 
-          CGUIListItem::ArtMap seasonArt;
+          std::map<std::string, std::string> seasonArt;
           if (seasonID > -1 && m_database.GetArtForItem(seasonID, MediaTypeSeason, seasonArt))
           {
-            items.AppendArt(seasonArt, MediaTypeSeason);
+            items.AppendArt(CGUIListItem::ArtMap(seasonArt), MediaTypeSeason);
             // set an art fallback for "thumb"
             if (items.HasArt("season.poster"))
               items.SetArtFallback("thumb", "season.poster");
@@ -426,10 +426,10 @@ bool CGUIWindowVideoNav::GetDirectory(const std::string &strDirectory, CFileItem
       {
         if (params.GetSetId() > 0)
         {
-          CGUIListItem::ArtMap setArt;
+          std::map<std::string, std::string> setArt;
           if (m_database.GetArtForItem(params.GetSetId(), MediaTypeVideoCollection, setArt))
           {
-            items.AppendArt(setArt, MediaTypeVideoCollection);
+            items.AppendArt(CGUIListItem::ArtMap(setArt), MediaTypeVideoCollection);
             items.SetArtFallback("fanart", "set.fanart");
             if (items.HasArt("set.poster"))
               items.SetArtFallback("thumb", "set.poster");
@@ -40,6 +40,7 @@
 #include "dialogs/GUIDialogOK.h"
 #include "dialogs/GUIDialogProgress.h"
 #include "dialogs/GUIDialogSmartPlaylistEditor.h"
+#include "filesystem/DirectoryCache.h"
 #include "filesystem/FavouritesDirectory.h"
 #include "filesystem/File.h"
 #include "filesystem/FileDirectoryFactory.h"
@@ -863,6 +864,11 @@ bool CGUIMediaWindow::Refresh(bool clearCache /* = false */)
   if (clearCache)
     m_vecItems->RemoveDiscCache(GetID());
 
+  // plugin listings may be served from the directory cache so make sure
+  // they are fetched again
+  if (m_vecItems->IsPlugin())
+    g_directoryCache.ClearDirectory(strCurrentDirectory);
+
   // get the original number of items
   if (!Update(strCurrentDirectory, false))
     return false;
@@ -1590,7 +1596,11 @@ bool CGUIMediaWindow::OnContextButton(int itemNumber, CONTEXT_BUTTON button)
       ADDON::AddonPtr addon;
       if (CAddonMgr::GetInstance().GetAddon(plugin.GetHostName(), addon))
         if (CGUIDialogAddonSettings::ShowAndGetInput(addon))
+        {
+          // the settings may change any of the plugin's listings
+          g_directoryCache.ClearSubPaths("plugin://" + addon->ID() + "/");
           Refresh();
+        }
       return true;
     }
   case CONTEXT_BUTTON_BROWSE_INTO: